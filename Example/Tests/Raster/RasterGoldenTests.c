@@ -0,0 +1,411 @@
+//
+//  RasterGoldenTests.c
+//  StylingKit
+//
+//  Renders the shape scenes of RasterRenderingTests with the C rasterizer alone and compares them against the expected
+//  images in Resources/Rendering, so the rasterizer can be tested on machines without UIKit or CoreGraphics.
+//
+//  Usage: RasterGoldenTests <path to Resources/Rendering>
+//
+
+#include "STKPXRaster.h"
+
+#include <png.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// the tolerances of RasterRenderingTests: pixels differing by less than this are antialiasing noise
+#define RASTER_CHANNEL_THRESHOLD 32
+#define RASTER_MAX_DIFFERING_RATIO 0.005
+
+// the expected images were captured at 2x from 100 x 100 point scenes
+#define SCENE_SIZE 100
+#define SCENE_SCALE 2
+
+// the control point distance of a cubic quarter circle, as used by CGPathAddEllipseInRect
+#define KAPPA 0.5522847498
+
+static const char *RESOURCES;
+static int failures = 0;
+
+// MARK: - Paths
+
+static void AddEllipse(STKPXRasterPath *path, double cx, double cy, double rx, double ry)
+{
+    double kx = rx * KAPPA;
+    double ky = ry * KAPPA;
+
+    STKPXRasterPathMoveTo(path, cx + rx, cy);
+    STKPXRasterPathCubicTo(path, cx + rx, cy + ky, cx + kx, cy + ry, cx, cy + ry);
+    STKPXRasterPathCubicTo(path, cx - kx, cy + ry, cx - rx, cy + ky, cx - rx, cy);
+    STKPXRasterPathCubicTo(path, cx - rx, cy - ky, cx - kx, cy - ry, cx, cy - ry);
+    STKPXRasterPathCubicTo(path, cx + kx, cy - ry, cx + rx, cy - ky, cx + rx, cy);
+    STKPXRasterPathClose(path);
+}
+
+static void AddRoundedRectangle(STKPXRasterPath *path, double x, double y, double width, double height, double radius)
+{
+    double k = radius * KAPPA;
+
+    STKPXRasterPathMoveTo(path, x + radius, y);
+    STKPXRasterPathLineTo(path, x + width - radius, y);
+    STKPXRasterPathCubicTo(path, x + width - radius + k, y, x + width, y + radius - k, x + width, y + radius);
+    STKPXRasterPathLineTo(path, x + width, y + height - radius);
+    STKPXRasterPathCubicTo(path, x + width, y + height - radius + k, x + width - radius + k, y + height,
+                           x + width - radius, y + height);
+    STKPXRasterPathLineTo(path, x + radius, y + height);
+    STKPXRasterPathCubicTo(path, x + radius - k, y + height, x, y + height - radius + k, x, y + height - radius);
+    STKPXRasterPathLineTo(path, x, y + radius);
+    STKPXRasterPathCubicTo(path, x, y + radius - k, x + radius - k, y, x + radius, y);
+    STKPXRasterPathClose(path);
+}
+
+static void AddRectangle(STKPXRasterPath *path, double x, double y, double width, double height)
+{
+    STKPXRasterPathMoveTo(path, x, y);
+    STKPXRasterPathLineTo(path, x + width, y);
+    STKPXRasterPathLineTo(path, x + width, y + height);
+    STKPXRasterPathLineTo(path, x, y + height);
+    STKPXRasterPathClose(path);
+}
+
+static STKPXRasterPath *CreateHorizontalLine(void)
+{
+    STKPXRasterPath *path = STKPXRasterPathCreate();
+
+    STKPXRasterPathMoveTo(path, 20.0, 50.0);
+    STKPXRasterPathLineTo(path, 80.0, 50.0);
+
+    return path;
+}
+
+static STKPXRasterPath *CreateCorner(void)
+{
+    STKPXRasterPath *path = STKPXRasterPathCreate();
+
+    STKPXRasterPathMoveTo(path, 20.0, 60.0);
+    STKPXRasterPathLineTo(path, 50.0, 20.0);
+    STKPXRasterPathLineTo(path, 80.0, 60.0);
+
+    return path;
+}
+
+// MARK: - Scenes
+
+static STKPXRasterTransform SceneTransform(void)
+{
+    STKPXRasterTransform transform = { SCENE_SCALE, 0.0, 0.0, SCENE_SCALE, 0.0, 0.0 };
+
+    return transform;
+}
+
+static STKPXRasterPaint SolidPaint(double r, double g, double b, double a)
+{
+    STKPXRasterPaint paint = { STKPXRasterPaintTypeSolid };
+
+    paint.r = r;
+    paint.g = g;
+    paint.b = b;
+    paint.a = a;
+
+    return paint;
+}
+
+static void FillPath(STKPXRasterSurface *surface, const STKPXRasterPath *path, STKPXRasterPaint paint)
+{
+    STKPXRasterFillPath(surface, path, SceneTransform(), STKPXRasterFillRuleNonZero, &paint, NULL, 1.0);
+}
+
+static void StrokePath(STKPXRasterSurface *surface, const STKPXRasterPath *path, const STKPXRasterStrokeStyle *style)
+{
+    // outlines are built in points, so flatten finely enough for the scale
+    STKPXRasterPath *outline = STKPXRasterPathCreateStroked(path, style, 0.1 / SCENE_SCALE);
+
+    FillPath(surface, outline, SolidPaint(1.0, 0.0, 0.0, 1.0));
+    STKPXRasterPathRelease(outline);
+}
+
+static STKPXRasterStrokeStyle StrokeStyle(double width)
+{
+    // the defaults of STKPXStroke
+    STKPXRasterStrokeStyle style = { width, STKPXRasterLineCapButt, STKPXRasterLineJoinMiter, 4.0, NULL, 0, 0.0 };
+
+    return style;
+}
+
+static void RenderEllipse(STKPXRasterSurface *surface, double rx, double ry)
+{
+    STKPXRasterPath *path = STKPXRasterPathCreate();
+
+    AddEllipse(path, 50.0, 50.0, rx, ry);
+    FillPath(surface, path, SolidPaint(1.0, 0.0, 0.0, 1.0));
+    STKPXRasterPathRelease(path);
+}
+
+static void RenderCircle(STKPXRasterSurface *surface)
+{
+    RenderEllipse(surface, 45.0, 45.0);
+}
+
+static void RenderEllipseScene(STKPXRasterSurface *surface)
+{
+    RenderEllipse(surface, 45.0, 25.0);
+}
+
+static void RenderRoundedRectangle(STKPXRasterSurface *surface)
+{
+    STKPXRasterPath *path = STKPXRasterPathCreate();
+
+    AddRoundedRectangle(path, 0.0, 0.0, 100.0, 60.0, 5.0);
+    FillPath(surface, path, SolidPaint(0.0, 0.0, 1.0, 1.0));
+    STKPXRasterPathRelease(path);
+}
+
+static void RenderLine(STKPXRasterSurface *surface, STKPXRasterStrokeStyle style)
+{
+    STKPXRasterPath *path = CreateHorizontalLine();
+
+    StrokePath(surface, path, &style);
+    STKPXRasterPathRelease(path);
+}
+
+static void RenderSolidStroke(STKPXRasterSurface *surface)
+{
+    RenderLine(surface, StrokeStyle(30.0));
+}
+
+static void RenderLineCap(STKPXRasterSurface *surface, STKPXRasterLineCap cap)
+{
+    STKPXRasterStrokeStyle style = StrokeStyle(30.0);
+
+    style.cap = cap;
+    RenderLine(surface, style);
+}
+
+static void RenderLineCapButt(STKPXRasterSurface *surface) { RenderLineCap(surface, STKPXRasterLineCapButt); }
+static void RenderLineCapRound(STKPXRasterSurface *surface) { RenderLineCap(surface, STKPXRasterLineCapRound); }
+static void RenderLineCapSquare(STKPXRasterSurface *surface) { RenderLineCap(surface, STKPXRasterLineCapSquare); }
+
+static void RenderLineJoin(STKPXRasterSurface *surface, STKPXRasterLineJoin join, double width, double miterLimit)
+{
+    STKPXRasterPath *path = CreateCorner();
+    STKPXRasterStrokeStyle style = StrokeStyle(width);
+
+    style.join = join;
+    style.miterLimit = miterLimit;
+    StrokePath(surface, path, &style);
+    STKPXRasterPathRelease(path);
+}
+
+static void RenderLineJoinBevel(STKPXRasterSurface *surface) { RenderLineJoin(surface, STKPXRasterLineJoinBevel, 30.0, 4.0); }
+static void RenderLineJoinRound(STKPXRasterSurface *surface) { RenderLineJoin(surface, STKPXRasterLineJoinRound, 30.0, 4.0); }
+static void RenderLineJoinMiter(STKPXRasterSurface *surface) { RenderLineJoin(surface, STKPXRasterLineJoinMiter, 20.0, 4.0); }
+static void RenderLineJoinMiterLimit(STKPXRasterSurface *surface) { RenderLineJoin(surface, STKPXRasterLineJoinMiter, 20.0, 1.0); }
+
+static void RenderDashes(STKPXRasterSurface *surface, double offset)
+{
+    static const double dashes[] = { 10.0, 10.0 };
+    STKPXRasterStrokeStyle style = StrokeStyle(20.0);
+
+    style.dashes = dashes;
+    style.dashCount = 2;
+    style.dashOffset = offset;
+    RenderLine(surface, style);
+}
+
+static void RenderDashArray(STKPXRasterSurface *surface) { RenderDashes(surface, 0.0); }
+static void RenderDashOffset(STKPXRasterSurface *surface) { RenderDashes(surface, 5.0); }
+
+static void RenderCenterStroke(STKPXRasterSurface *surface)
+{
+    STKPXRasterPath *path = STKPXRasterPathCreate();
+    STKPXRasterStrokeStyle style = StrokeStyle(30.0);
+
+    AddRectangle(path, 20.0, 20.0, 60.0, 60.0);
+    StrokePath(surface, path, &style);
+    STKPXRasterPathRelease(path);
+}
+
+static void RenderShadow(STKPXRasterSurface *surface)
+{
+    // what STKPXRasterBackend draws: the shadow pass fills the shape in the default black fill color, then the red
+    // fill casts the still active shadow again. Each cast is a blurred, offset mask in the one-third black of
+    // CGContextSetShadow
+    double offset = 3.0 * SCENE_SCALE;
+    double sigma = 3.0 * SCENE_SCALE * 0.5;
+    int padding = (int) (sigma * 3.0 + 0.999) + 2;
+    int width = surface->width + padding * 2;
+    int height = surface->height + padding * 2;
+    uint8_t *mask = calloc((size_t) width * height, 1);
+    STKPXRasterPath *path = STKPXRasterPathCreate();
+    STKPXRasterTransform transform = SceneTransform();
+    STKPXRasterPaint shadow = SolidPaint(0.0, 0.0, 0.0, 1.0 / 3.0);
+
+    AddEllipse(path, 50.0, 50.0, 40.0, 40.0);
+
+    transform.tx = offset + padding;
+    transform.ty = offset + padding;
+    STKPXRasterRenderMask(mask, width, height, path, transform, STKPXRasterFillRuleNonZero);
+    STKPXRasterBlurMask(mask, width, height, sigma);
+
+    STKPXRasterFillMask(surface, mask, width, height, -padding, -padding, &shadow, NULL, 1.0);
+    FillPath(surface, path, SolidPaint(0.0, 0.0, 0.0, 1.0));
+    STKPXRasterFillMask(surface, mask, width, height, -padding, -padding, &shadow, NULL, 1.0);
+    FillPath(surface, path, SolidPaint(1.0, 0.0, 0.0, 1.0));
+
+    STKPXRasterPathRelease(path);
+    free(mask);
+}
+
+// MARK: - Comparison
+
+/**
+ *  Load a PNG as premultiplied RGBA, the layout of STKPXRasterSurface
+ */
+static uint8_t *LoadExpectedImage(const char *name, int *width, int *height)
+{
+    char path[1024];
+    png_image image;
+
+    snprintf(path, sizeof(path), "%s/%s.png", RESOURCES, name);
+    memset(&image, 0, sizeof(image));
+    image.version = PNG_IMAGE_VERSION;
+
+    if (!png_image_begin_read_from_file(&image, path))
+    {
+        fprintf(stderr, "%s: %s\n", path, image.message);
+        return NULL;
+    }
+
+    image.format = PNG_FORMAT_RGBA;
+
+    uint8_t *pixels = malloc(PNG_IMAGE_SIZE(image));
+
+    if (pixels == NULL || !png_image_finish_read(&image, NULL, pixels, 0, NULL))
+    {
+        fprintf(stderr, "%s: %s\n", path, image.message);
+        png_image_free(&image);
+        free(pixels);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < (size_t) image.width * image.height * 4; i += 4)
+    {
+        unsigned alpha = pixels[i + 3];
+
+        for (int c = 0; c < 3; c++)
+        {
+            pixels[i + c] = (uint8_t) ((pixels[i + c] * alpha + 127) / 255);
+        }
+    }
+
+    *width = (int) image.width;
+    *height = (int) image.height;
+
+    return pixels;
+}
+
+static void AssertSceneEqualsImage(void (*render)(STKPXRasterSurface *), const char *name)
+{
+    int width = 0;
+    int height = 0;
+    uint8_t *expected = LoadExpectedImage(name, &width, &height);
+    STKPXRasterSurface surface;
+
+    if (expected == NULL || !STKPXRasterSurfaceInit(&surface, SCENE_SIZE * SCENE_SCALE, SCENE_SIZE * SCENE_SCALE))
+    {
+        printf("FAIL %s: unable to load the expected image\n", name);
+        failures++;
+        free(expected);
+        return;
+    }
+
+    render(&surface);
+
+    STKPXRasterComparison comparison = { 255, 1.0 };
+
+    if (width == surface.width && height == surface.height)
+    {
+        comparison = STKPXRasterCompare(surface.pixels, surface.bytesPerRow, expected, (size_t) width * 4,
+                                        width, height, RASTER_CHANNEL_THRESHOLD);
+    }
+
+    if (comparison.differingPixelRatio <= RASTER_MAX_DIFFERING_RATIO)
+    {
+        printf("ok   %s\n", name);
+    }
+    else
+    {
+        printf("FAIL %s differs in %.2f%% of its pixels, by up to %d\n",
+               name, comparison.differingPixelRatio * 100.0, comparison.maxChannelDifference);
+        failures++;
+    }
+
+    STKPXRasterSurfaceDestroy(&surface);
+    free(expected);
+}
+
+static void AssertThreadCountDoesNotChangeOutput(void)
+{
+    STKPXRasterSurface serial;
+    STKPXRasterSurface parallel;
+    STKPXRasterPath *path = STKPXRasterPathCreate();
+    STKPXRasterPaint paint = SolidPaint(1.0, 0.0, 0.0, 1.0);
+
+    AddEllipse(path, 256.0, 256.0, 240.0, 240.0);
+    STKPXRasterSurfaceInit(&serial, 512, 512);
+    STKPXRasterSurfaceInit(&parallel, 512, 512);
+
+    STKPXRasterSetThreadCount(1);
+    STKPXRasterFillPath(&serial, path, STKPXRasterTransformIdentity, STKPXRasterFillRuleNonZero, &paint, NULL, 1.0);
+    STKPXRasterSetThreadCount(4);
+    STKPXRasterFillPath(&parallel, path, STKPXRasterTransformIdentity, STKPXRasterFillRuleNonZero, &paint, NULL, 1.0);
+    STKPXRasterSetThreadCount(0);
+
+    if (memcmp(serial.pixels, parallel.pixels, serial.bytesPerRow * 512) == 0)
+    {
+        printf("ok   thread-count\n");
+    }
+    else
+    {
+        printf("FAIL thread-count changes the output\n");
+        failures++;
+    }
+
+    STKPXRasterSurfaceDestroy(&serial);
+    STKPXRasterSurfaceDestroy(&parallel);
+    STKPXRasterPathRelease(path);
+}
+
+int main(int argc, const char *argv[])
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "usage: %s <Resources/Rendering directory>\n", argv[0]);
+        return 2;
+    }
+
+    RESOURCES = argv[1];
+
+    AssertSceneEqualsImage(RenderCircle, "circle");
+    AssertSceneEqualsImage(RenderEllipseScene, "ellipse");
+    AssertSceneEqualsImage(RenderRoundedRectangle, "rectangle-rounded");
+    AssertSceneEqualsImage(RenderSolidStroke, "solid-stroke");
+    AssertSceneEqualsImage(RenderCenterStroke, "center-stroke");
+    AssertSceneEqualsImage(RenderLineCapButt, "line-cap-butt");
+    AssertSceneEqualsImage(RenderLineCapRound, "line-cap-round");
+    AssertSceneEqualsImage(RenderLineCapSquare, "line-cap-square");
+    AssertSceneEqualsImage(RenderLineJoinBevel, "line-join-bevel");
+    AssertSceneEqualsImage(RenderLineJoinRound, "line-join-round");
+    AssertSceneEqualsImage(RenderLineJoinMiter, "line-join-miter");
+    AssertSceneEqualsImage(RenderLineJoinMiterLimit, "line-join-miter-limit");
+    AssertSceneEqualsImage(RenderDashArray, "dash-array");
+    AssertSceneEqualsImage(RenderDashOffset, "dash-offset");
+    AssertSceneEqualsImage(RenderShadow, "shadow");
+    AssertThreadCountDoesNotChangeOutput();
+
+    printf("%d failure(s)\n", failures);
+
+    return (failures == 0) ? 0 : 1;
+}
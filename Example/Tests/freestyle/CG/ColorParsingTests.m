@@ -0,0 +1,543 @@
+//
+//  ColorParsingTests.m
+//  StylingKit
+//
+
+#import <XCTest/XCTest.h>
+#import "UIColor+STKPXColors.h"
+#import "STKPXValueParser.h"
+#import "STKPXStylesheetParser.h"
+#import "STKPXStylesheet.h"
+#import "STKPXRuleSet.h"
+#import "STKPXDeclaration.h"
+#import "STKBenchmarkRecorder.h"
+
+static STKBenchmarkRecorder *RECORDER;
+
+// the CSS named colors as the dictionary-based lookup defined them
+static const struct
+{
+    const char *name;
+    int red;
+    int green;
+    int blue;
+} REFERENCE_COLORS[] = {
+    { "aliceblue", 240, 248, 255 },
+    { "antiquewhite", 250, 235, 215 },
+    { "aqua", 0, 255, 255 },
+    { "aquamarine", 127, 255, 212 },
+    { "azure", 240, 255, 255 },
+    { "beige", 245, 245, 220 },
+    { "bisque", 255, 228, 196 },
+    { "black", 0, 0, 0 },
+    { "blanchedalmond", 255, 235, 205 },
+    { "blue", 0, 0, 255 },
+    { "blueviolet", 138, 43, 226 },
+    { "brown", 165, 42, 42 },
+    { "burlywood", 222, 184, 135 },
+    { "cadetblue", 95, 158, 160 },
+    { "chartreuse", 127, 255, 0 },
+    { "chocolate", 210, 105, 30 },
+    { "coral", 255, 127, 80 },
+    { "cornflowerblue", 100, 149, 237 },
+    { "cornsilk", 255, 248, 220 },
+    { "crimson", 220, 20, 60 },
+    { "cyan", 0, 255, 255 },
+    { "darkblue", 0, 0, 139 },
+    { "darkcyan", 0, 139, 139 },
+    { "darkgoldenrod", 184, 134, 11 },
+    { "darkgray", 169, 169, 169 },
+    { "darkgreen", 0, 100, 0 },
+    { "darkgrey", 169, 169, 169 },
+    { "darkkhaki", 189, 183, 107 },
+    { "darkmagenta", 139, 0, 139 },
+    { "darkolivegreen", 85, 107, 47 },
+    { "darkorange", 255, 140, 0 },
+    { "darkorchid", 153, 50, 204 },
+    { "darkred", 139, 0, 0 },
+    { "darksalmon", 233, 150, 122 },
+    { "darkseagreen", 143, 188, 143 },
+    { "darkslateblue", 72, 61, 139 },
+    { "darkslategray", 47, 79, 79 },
+    { "darkslategrey", 47, 79, 79 },
+    { "darkturquoise", 0, 206, 209 },
+    { "darkviolet", 148, 0, 211 },
+    { "deeppink", 255, 20, 147 },
+    { "deepskyblue", 0, 191, 255 },
+    { "dimgray", 105, 105, 105 },
+    { "dimgrey", 105, 105, 105 },
+    { "dodgerblue", 30, 144, 255 },
+    { "firebrick", 178, 34, 34 },
+    { "floralwhite", 255, 250, 240 },
+    { "forestgreen", 34, 139, 34 },
+    { "fuchsia", 255, 0, 255 },
+    { "gainsboro", 220, 220, 220 },
+    { "ghostwhite", 248, 248, 255 },
+    { "gold", 255, 215, 0 },
+    { "goldenrod", 218, 165, 32 },
+    { "gray", 128, 128, 128 },
+    { "green", 0, 128, 0 },
+    { "greenyellow", 173, 255, 47 },
+    { "grey", 128, 128, 128 },
+    { "honeydew", 240, 255, 240 },
+    { "hotpink", 255, 105, 180 },
+    { "indianred", 205, 92, 92 },
+    { "indigo", 75, 0, 130 },
+    { "ivory", 255, 255, 240 },
+    { "khaki", 240, 230, 140 },
+    { "lavender", 230, 230, 250 },
+    { "lavenderblush", 255, 240, 245 },
+    { "lawngreen", 124, 252, 0 },
+    { "lemonchiffon", 255, 250, 205 },
+    { "lightblue", 173, 216, 230 },
+    { "lightcoral", 240, 128, 128 },
+    { "lightcyan", 224, 255, 255 },
+    { "lightgoldenrodyellow", 250, 250, 210 },
+    { "lightgray", 211, 211, 211 },
+    { "lightgreen", 144, 238, 144 },
+    { "lightgrey", 211, 211, 211 },
+    { "lightpink", 255, 182, 193 },
+    { "lightsalmon", 255, 160, 122 },
+    { "lightseagreen", 32, 178, 170 },
+    { "lightskyblue", 135, 206, 250 },
+    { "lightslategray", 119, 136, 153 },
+    { "lightslategrey", 119, 136, 153 },
+    { "lightsteelblue", 176, 196, 222 },
+    { "lightyellow", 255, 255, 224 },
+    { "lime", 0, 255, 0 },
+    { "limegreen", 50, 205, 50 },
+    { "linen", 250, 240, 230 },
+    { "magenta", 255, 0, 255 },
+    { "maroon", 128, 0, 0 },
+    { "mediumaquamarine", 102, 205, 170 },
+    { "mediumblue", 0, 0, 205 },
+    { "mediumorchid", 186, 85, 211 },
+    { "mediumpurple", 147, 112, 219 },
+    { "mediumseagreen", 60, 179, 113 },
+    { "mediumslateblue", 123, 104, 238 },
+    { "mediumspringgreen", 0, 250, 154 },
+    { "mediumturquoise", 72, 209, 204 },
+    { "mediumvioletred", 199, 21, 133 },
+    { "midnightblue", 25, 25, 112 },
+    { "mintcream", 245, 255, 250 },
+    { "mistyrose", 255, 228, 225 },
+    { "moccasin", 255, 228, 181 },
+    { "navajowhite", 255, 222, 173 },
+    { "navy", 0, 0, 128 },
+    { "oldlace", 253, 245, 230 },
+    { "olive", 128, 128, 0 },
+    { "olivedrab", 107, 142, 35 },
+    { "orange", 255, 165, 0 },
+    { "orangered", 255, 69, 0 },
+    { "orchid", 218, 112, 214 },
+    { "palegoldenrod", 238, 232, 170 },
+    { "palegreen", 152, 251, 152 },
+    { "paleturquoise", 175, 238, 238 },
+    { "palevioletred", 219, 112, 147 },
+    { "papayawhip", 255, 239, 213 },
+    { "peachpuff", 255, 218, 185 },
+    { "peru", 205, 133, 63 },
+    { "pink", 255, 192, 203 },
+    { "plum", 221, 160, 221 },
+    { "powderblue", 176, 224, 230 },
+    { "purple", 128, 0, 128 },
+    { "red", 255, 0, 0 },
+    { "rosybrown", 188, 143, 143 },
+    { "royalblue", 65, 105, 225 },
+    { "saddlebrown", 139, 69, 19 },
+    { "salmon", 250, 128, 114 },
+    { "sandybrown", 244, 164, 96 },
+    { "seagreen", 46, 139, 87 },
+    { "seashell", 255, 245, 238 },
+    { "sienna", 160, 82, 45 },
+    { "silver", 192, 192, 192 },
+    { "skyblue", 135, 206, 235 },
+    { "slateblue", 106, 90, 205 },
+    { "slategray", 112, 128, 144 },
+    { "slategrey", 112, 128, 144 },
+    { "snow", 255, 250, 250 },
+    { "springgreen", 0, 255, 127 },
+    { "steelblue", 70, 130, 180 },
+    { "tan", 210, 180, 140 },
+    { "teal", 0, 128, 128 },
+    { "thistle", 216, 191, 216 },
+    { "tomato", 255, 99, 71 },
+    { "turquoise", 64, 224, 208 },
+    { "violet", 238, 130, 238 },
+    { "wheat", 245, 222, 179 },
+    { "white", 255, 255, 255 },
+    { "whitesmoke", 245, 245, 245 },
+    { "yellow", 255, 255, 0 },
+    { "yellowgreen", 154, 205, 50 },
+};
+
+#pragma mark - Reference implementations
+
+// +[UIColor colorFromName:] before the perfect hash table
+static UIColor *STKReferenceColorFromName(NSString *name)
+{
+    static NSDictionary *nameMap;
+    static dispatch_once_t onceToken;
+
+    dispatch_once(&onceToken, ^{
+        NSMutableDictionary *map = [[NSMutableDictionary alloc] init];
+
+        for (NSUInteger i = 0; i < sizeof(REFERENCE_COLORS) / sizeof(REFERENCE_COLORS[0]); i++)
+        {
+            map[@(REFERENCE_COLORS[i].name)] = [UIColor colorWithRed:REFERENCE_COLORS[i].red / 255.0
+                                                               green:REFERENCE_COLORS[i].green / 255.0
+                                                                blue:REFERENCE_COLORS[i].blue / 255.0
+                                                               alpha:1];
+        }
+
+        map[@"transparent"] = [UIColor clearColor];
+        nameMap = map;
+    });
+
+    UIColor *result = nil;
+
+    if (name.length > 0)
+    {
+        result = nameMap[name.lowercaseString];
+
+        if (result == nil)
+        {
+            NSRegularExpression *regex = [NSRegularExpression regularExpressionWithPattern:@"-([a-z])"
+                                                                                   options:NSRegularExpressionCaseInsensitive
+                                                                                     error:NULL];
+            NSMutableString *camelCase = [NSMutableString stringWithString:name];
+            __block NSUInteger count = 0;
+
+            [regex enumerateMatchesInString:name
+                                    options:0
+                                      range:NSMakeRange(0, name.length)
+                                 usingBlock:^(NSTextCheckingResult *match, NSMatchingFlags flags, BOOL *stop) {
+                NSString *character = [name substringWithRange:[match rangeAtIndex:1]];
+
+                [camelCase replaceCharactersInRange:NSMakeRange(match.range.location - count, match.range.length)
+                                         withString:character.uppercaseString];
+                count++;
+            }];
+
+            NSString *selectorName = ([camelCase hasSuffix:@"Color"] == NO) ? [camelCase stringByAppendingString:@"Color"] : camelCase;
+            SEL selector = NSSelectorFromString(selectorName);
+
+            if ([UIColor respondsToSelector:selector])
+            {
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Warc-performSelector-leaks"
+                id candidate = [UIColor performSelector:selector];
+#pragma clang diagnostic pop
+
+                if ([candidate isKindOfClass:[UIColor class]])
+                {
+                    result = candidate;
+                }
+            }
+        }
+    }
+
+    return (result) ? result : [UIColor blackColor];
+}
+
+// +[UIColor colorWithHexString:withAlpha:] before the table-driven decoder
+static UIColor *STKReferenceColorWithHexString(NSString *hexString, CGFloat alpha)
+{
+    uint value = 0;
+
+    if (hexString)
+    {
+        int startingIndex = ([hexString hasPrefix:@"#"]) ? 1 : 0;
+        BOOL useSuppliedAlpha = YES;
+
+        if (hexString.length - startingIndex == 3)
+        {
+            NSString *h1 = [hexString substringWithRange:NSMakeRange(0 + startingIndex, 1)];
+            NSString *h2 = [hexString substringWithRange:NSMakeRange(1 + startingIndex, 1)];
+            NSString *h3 = [hexString substringWithRange:NSMakeRange(2 + startingIndex, 1)];
+
+            hexString = [NSString stringWithFormat:@"%@%@%@%@%@%@", h1, h1, h2, h2, h3, h3];
+            startingIndex = 0;
+        }
+        else if (hexString.length - startingIndex == 4)
+        {
+            NSString *h1 = [hexString substringWithRange:NSMakeRange(0 + startingIndex, 1)];
+            NSString *h2 = [hexString substringWithRange:NSMakeRange(1 + startingIndex, 1)];
+            NSString *h3 = [hexString substringWithRange:NSMakeRange(2 + startingIndex, 1)];
+            NSString *h4 = [hexString substringWithRange:NSMakeRange(3 + startingIndex, 1)];
+
+            hexString = [NSString stringWithFormat:@"%@%@%@%@%@%@%@%@", h1, h1, h2, h2, h3, h3, h4, h4];
+            startingIndex = 0;
+            useSuppliedAlpha = NO;
+        }
+        else if (hexString.length - startingIndex == 8)
+        {
+            useSuppliedAlpha = NO;
+        }
+
+        [[NSScanner scannerWithString:[hexString substringFromIndex:startingIndex]] scanHexInt:&value];
+
+        if (useSuppliedAlpha)
+        {
+            alpha = MIN(MAX(0.0, alpha), 1.0);
+            value |= ((uint) (alpha * 255.0)) << 24;
+        }
+    }
+
+    return [UIColor colorWithARGBValue:value];
+}
+
+@interface ColorParsingTests : XCTestCase
+@end
+
+@implementation ColorParsingTests
+
++ (void)setUp
+{
+    [super setUp];
+
+    RECORDER = [[STKBenchmarkRecorder alloc] initWithSuiteName:@"ColorParsingTests"];
+}
+
++ (void)tearDown
+{
+    [RECORDER writeReport];
+    RECORDER = nil;
+
+    [super tearDown];
+}
+
+#pragma mark - Helpers
+
+- (void)assertColor:(UIColor *)actual equalsColor:(UIColor *)expected source:(NSString *)source
+{
+    CGFloat ar, ag, ab, aa;
+    CGFloat er, eg, eb, ea;
+
+    XCTAssertTrue([actual getRed:&ar green:&ag blue:&ab alpha:&aa], @"%@", source);
+    XCTAssertTrue([expected getRed:&er green:&eg blue:&eb alpha:&ea], @"%@", source);
+    XCTAssertEqual(ar, er, @"%@", source);
+    XCTAssertEqual(ag, eg, @"%@", source);
+    XCTAssertEqual(ab, eb, @"%@", source);
+    XCTAssertEqual(aa, ea, @"%@", source);
+}
+
+- (UIColor *)colorFromSource:(NSString *)source
+{
+    STKPXValueParser *parser = [[STKPXValueParser alloc] init];
+
+    return [parser parseColor:[STKPXValueParser lexemesForSource:source]];
+}
+
+- (NSString *)largeCSS
+{
+    NSString *path = [[NSBundle bundleForClass:self.class] pathForResource:@"large" ofType:@"css"];
+
+    return [NSString stringWithContentsOfFile:path encoding:NSUTF8StringEncoding error:NULL];
+}
+
+- (NSArray *)stringsInSource:(NSString *)source matchingPattern:(NSString *)pattern
+{
+    NSRegularExpression *regex = [NSRegularExpression regularExpressionWithPattern:pattern options:0 error:NULL];
+    NSMutableArray *result = [[NSMutableArray alloc] init];
+
+    for (NSTextCheckingResult *match in [regex matchesInString:source options:0 range:NSMakeRange(0, source.length)])
+    {
+        [result addObject:[source substringWithRange:[match rangeAtIndex:1]]];
+    }
+
+    return result;
+}
+
+#pragma mark - Named Colors
+
+- (void)testNamedColorsMatchReference
+{
+    for (NSUInteger i = 0; i < sizeof(REFERENCE_COLORS) / sizeof(REFERENCE_COLORS[0]); i++)
+    {
+        NSString *name = @(REFERENCE_COLORS[i].name);
+
+        for (NSString *variant in @[ name, name.uppercaseString, name.capitalizedString ])
+        {
+            UIColor *actual = [UIColor colorFromName:variant];
+
+            [self assertColor:actual equalsColor:STKReferenceColorFromName(variant) source:variant];
+
+            // each name keeps handing out one shared instance
+            XCTAssertEqual(actual, [UIColor colorFromName:name], @"%@", variant);
+        }
+    }
+
+    XCTAssertEqual([UIColor colorFromName:@"transparent"], [UIColor clearColor]);
+    XCTAssertEqual([UIColor colorFromName:@"Transparent"], [UIColor clearColor]);
+}
+
+- (void)testOtherNamesMatchReference
+{
+    NSArray *names = @[ @"light-gray", @"Light-Gray", @"clear", @"groupTableViewBackground", @"darkTextColor",
+                        @"not-a-color", @"reds", @"gree", @"lightgoldenrodyellows", @"-", @"red-", @"blü",
+                        @"Khaki", @"" ];
+
+    for (NSString *name in names)
+    {
+        // ask twice: the second answer comes from the remembered system colors
+        [self assertColor:[UIColor colorFromName:name] equalsColor:STKReferenceColorFromName(name) source:name];
+        [self assertColor:[UIColor colorFromName:name] equalsColor:STKReferenceColorFromName(name) source:name];
+    }
+
+    XCTAssertEqual([UIColor colorFromName:@"light-gray"], [UIColor lightGrayColor]);
+    XCTAssertEqual([UIColor colorFromName:nil], [UIColor blackColor]);
+}
+
+#pragma mark - Hex Colors
+
+- (void)testHexColorsMatchReference
+{
+    NSMutableArray *strings = [@[ @"", @"#", @"#f", @"#ff", @"fff", @"#FfF", @"#1234", @"#abcdef", @"ABCDEF",
+                                  @"#80ff0000", @"#12345", @"#1234567", @"#123456789", @"#12g", @"#xyz", @"#ff ",
+                                  @" #fff", @"#0x12", @"#١٢٣", @"##fff" ] mutableCopy];
+    NSString *alphabet = @"0123456789abcdefABCDEFgG#x ";
+
+    srand48(40);
+
+    for (NSUInteger i = 0; i < 2000; i++)
+    {
+        NSUInteger length = lrand48() % 10;
+        NSMutableString *string = [NSMutableString stringWithString:(lrand48() % 4) ? @"#" : @""];
+
+        for (NSUInteger j = 0; j < length; j++)
+        {
+            // mostly valid digits, with the odd stray character
+            NSUInteger limit = (lrand48() % 16) ? 22 : alphabet.length;
+
+            [string appendFormat:@"%C", [alphabet characterAtIndex:lrand48() % limit]];
+        }
+
+        [strings addObject:string];
+    }
+
+    for (NSString *string in strings)
+    {
+        for (NSNumber *alpha in @[ @1.0, @0.5, @-1.0, @2.0 ])
+        {
+            [self assertColor:[UIColor colorWithHexString:string withAlpha:alpha.floatValue]
+                  equalsColor:STKReferenceColorWithHexString(string, alpha.floatValue)
+                       source:string];
+        }
+    }
+
+    [self assertColor:[UIColor colorWithHexString:nil] equalsColor:STKReferenceColorWithHexString(nil, 1.0) source:@"nil"];
+}
+
+#pragma mark - Functional Colors
+
+- (void)testFunctionalColors
+{
+    [self assertColor:[self colorFromSource:@"rgb(255, 128, 0)"]
+          equalsColor:[UIColor colorWithRed:1.0f green:128.0f / 255.0f blue:0.0f alpha:1.0f]
+               source:@"rgb"];
+    [self assertColor:[self colorFromSource:@"rgb(100%, 50%, 0%)"]
+          equalsColor:[UIColor colorWithRed:1.0f green:0.5f blue:0.0f alpha:1.0f]
+               source:@"rgb percentages"];
+    [self assertColor:[self colorFromSource:@"rgba(255, 0, 0, 0.5)"]
+          equalsColor:[UIColor colorWithRed:1.0f green:0.0f blue:0.0f alpha:0.5f]
+               source:@"rgba"];
+    [self assertColor:[self colorFromSource:@"rgba(#00f, 0.25)"]
+          equalsColor:[UIColor colorWithRed:0.0f green:0.0f blue:1.0f alpha:0.25f]
+               source:@"rgba hex"];
+    [self assertColor:[self colorFromSource:@"rgba(green, 50%)"]
+          equalsColor:[UIColor colorWithRed:0.0f green:128.0f / 255.0f blue:0.0f alpha:0.5f]
+               source:@"rgba name"];
+    [self assertColor:[self colorFromSource:@"hsl(120, 100%, 50%)"]
+          equalsColor:[UIColor colorWithHue:120.0f / 360.0f saturation:1.0f lightness:0.5f alpha:1.0f]
+               source:@"hsl"];
+    [self assertColor:[self colorFromSource:@"hsla(90deg, 50%, 25%, 0.75)"]
+          equalsColor:[UIColor colorWithHue:0.25f saturation:0.5f lightness:0.25f alpha:0.75f]
+               source:@"hsla"];
+    [self assertColor:[self colorFromSource:@"hsb(180, 100%, 100%)"]
+          equalsColor:[UIColor colorWithHue:0.5f saturation:1.0f brightness:1.0f alpha:1.0f]
+               source:@"hsb"];
+    [self assertColor:[self colorFromSource:@"hsba(180 100% 100% 0.5)"]
+          equalsColor:[UIColor colorWithHue:0.5f saturation:1.0f brightness:1.0f alpha:0.5f]
+               source:@"hsba without commas"];
+}
+
+#pragma mark - Benchmarks
+
+- (void)testParseLargeCSSColors
+{
+    NSString *source = self.largeCSS;
+    NSArray *hexColors = [self stringsInSource:source matchingPattern:@"(#[0-9a-fA-F]{3,8})\\b"];
+    NSArray *namedColors = [self stringsInSource:source matchingPattern:@"color\\s*:\\s*([a-zA-Z-]+)\\s*;"];
+    NSUInteger count = hexColors.count + namedColors.count;
+    NSMutableArray *declarations = [[NSMutableArray alloc] init];
+
+    XCTAssertTrue(count > 0, @"Expected colors in large.css");
+
+    // the same values through the value parser, as stylers see them
+    STKPXStylesheet *stylesheet = [[[STKPXStylesheetParser alloc] init] parse:source
+                                                                   withOrigin:STKPXStylesheetOriginApplication];
+
+    for (STKPXRuleSet *ruleSet in stylesheet.ruleSets)
+    {
+        for (STKPXDeclaration *declaration in ruleSet.declarations)
+        {
+            if ([declaration.name hasSuffix:@"color"])
+            {
+                [declarations addObject:declaration];
+            }
+        }
+    }
+
+    STKBenchmarkSample *reference = [RECORDER measure:@"color.large_css.reference" iterations:50 items:count block:^{
+        for (NSString *hex in hexColors)
+        {
+            STKReferenceColorWithHexString(hex, 1.0);
+        }
+
+        for (NSString *name in namedColors)
+        {
+            STKReferenceColorFromName(name);
+        }
+    }];
+
+    STKBenchmarkSample *fast = [RECORDER measure:@"color.large_css" iterations:50 items:count block:^{
+        for (NSString *hex in hexColors)
+        {
+            [UIColor colorWithHexString:hex];
+        }
+
+        for (NSString *name in namedColors)
+        {
+            [UIColor colorFromName:name];
+        }
+    }];
+
+    STKBenchmarkSample *parsed = [RECORDER measure:@"color.large_css.declarations"
+                                        iterations:50
+                                             items:declarations.count
+                                             block:^{
+        for (STKPXDeclaration *declaration in declarations)
+        {
+            [declaration colorValue];
+        }
+    }];
+
+    reference.metrics[@"hex"] = @(hexColors.count);
+    reference.metrics[@"named"] = @(namedColors.count);
+    fast.metrics[@"hex"] = @(hexColors.count);
+    fast.metrics[@"named"] = @(namedColors.count);
+    parsed.metrics[@"declarations"] = @(declarations.count);
+
+    for (NSString *hex in hexColors)
+    {
+        [self assertColor:[UIColor colorWithHexString:hex] equalsColor:STKReferenceColorWithHexString(hex, 1.0) source:hex];
+    }
+
+    for (NSString *name in namedColors)
+    {
+        [self assertColor:[UIColor colorFromName:name] equalsColor:STKReferenceColorFromName(name) source:name];
+    }
+}
+
+@end
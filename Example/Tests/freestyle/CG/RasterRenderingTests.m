@@ -0,0 +1,358 @@
+//
+//  RasterRenderingTests.m
+//  StylingKit
+//
+
+#import "ImageBasedTests.h"
+#import "STKPXGraphics.h"
+#import "STKPXBoxModel.h"
+
+// pixels differing by less than this are antialiasing noise between the rasterizers
+static const int RASTER_CHANNEL_THRESHOLD = 32;
+static const double RASTER_MAX_DIFFERING_RATIO = 0.005;
+
+@interface RasterRenderingTests : ImageBasedTests
+@end
+
+@implementation RasterRenderingTests
+
+#pragma mark - Helpers
+
+- (void)assertRenderable:(id<STKPXRenderable>)renderable bounds:(CGRect)bounds equalsImageName:(NSString *)name
+{
+    UIImage *expected = [self getImageForName:name];
+
+    XCTAssertNotNil(expected, @"Unable to locate %@.png", name);
+
+    // render at the scale the expected image was captured at
+    CGFloat scale = CGImageGetWidth(expected.CGImage) / bounds.size.width;
+    STKPXRasterBackend *backend = [[STKPXRasterBackend alloc] initWithSize:bounds.size scale:scale];
+
+    [backend concatTransform:CGAffineTransformMakeTranslation(-bounds.origin.x, -bounds.origin.y)];
+    [renderable renderWithBackend:backend];
+
+    STKPXRasterComparison comparison = [backend compareWithImage:expected threshold:RASTER_CHANNEL_THRESHOLD];
+
+    XCTAssertLessThanOrEqual(comparison.differingPixelRatio, RASTER_MAX_DIFFERING_RATIO,
+                             @"%@ differs in %.2f%% of its pixels, by up to %d",
+                             name, comparison.differingPixelRatio * 100.0, comparison.maxChannelDifference);
+}
+
+- (void)assertShape:(STKPXShape *)shape equalsImageName:(NSString *)name
+{
+    [self assertRenderable:shape bounds:CGRectMake(0.0f, 0.0f, 100.0f, 100.0f) equalsImageName:name];
+}
+
+- (void)assertSVG:(NSString *)name
+{
+    NSString *path = [[NSBundle bundleForClass:self.class] pathForResource:name ofType:@"svg"];
+    STKPXShapeDocument *document = [STKPXSVGLoader loadFromURL:[NSURL fileURLWithPath:path]];
+    CGRect bounds = ((STKPXShapeGroup *) document.shape).viewport;
+
+    if (CGRectIsEmpty(bounds))
+    {
+        bounds = CGRectMake(0.0f, 0.0f, 100.0f, 100.0f);
+    }
+
+    [self assertRenderable:document bounds:bounds equalsImageName:name];
+}
+
+- (STKPXLine *)horizontalLineWithStroke:(id<STKPXStrokeRenderer>)stroke
+{
+    STKPXLine *shape = [[STKPXLine alloc] initX1:20.0f y1:50.0f x2:80.0f y2:50.0f];
+
+    shape.stroke = stroke;
+
+    return shape;
+}
+
+- (STKPXPath *)cornerWithStroke:(id<STKPXStrokeRenderer>)stroke
+{
+    STKPXPath *shape = [[STKPXPath alloc] init];
+
+    [shape moveToX:20.0f y:60.0f];
+    [shape lineToX:50.0f y:20.0f];
+    [shape lineToX:80.0f y:60.0f];
+    shape.stroke = stroke;
+
+    return shape;
+}
+
+- (STKPXStroke *)strokeWithWidth:(CGFloat)width color:(UIColor *)color
+{
+    STKPXStroke *stroke = [[STKPXStroke alloc] initWithStrokeWidth:width];
+
+    stroke.color = [STKPXSolidPaint paintWithColor:color];
+
+    return stroke;
+}
+
+#pragma mark - Fill Tests
+
+- (void)testCircle
+{
+    STKPXCircle *shape = [STKPXCircle circleWithCenter:CGPointMake(50.0f, 50.0f) withRadius:45.0f];
+
+    shape.fill = [STKPXSolidPaint paintWithColor:[UIColor redColor]];
+
+    [self assertShape:shape equalsImageName:@"circle"];
+}
+
+- (void)testEllipse
+{
+    STKPXEllipse *shape = [STKPXEllipse ellipseWithCenter:CGPointMake(50.0f, 50.0f) withRadiusX:45.0f withRadiusY:25.0f];
+
+    shape.fill = [STKPXSolidPaint paintWithColor:[UIColor redColor]];
+
+    [self assertShape:shape equalsImageName:@"ellipse"];
+}
+
+- (void)testRoundedRectangle
+{
+    STKPXRectangle *shape = [[STKPXRectangle alloc] initWithRect:CGRectMake(0.0f, 0.0f, 100.0f, 60.0f)];
+
+    shape.cornerRadii = CGSizeMake(5.0f, 5.0f);
+    shape.fill = [STKPXSolidPaint paintWithColor:[UIColor blueColor]];
+
+    [self assertShape:shape equalsImageName:@"rectangle-rounded"];
+}
+
+#pragma mark - Stroke Tests
+
+- (void)testSolidStroke
+{
+    STKPXStroke *stroke = [self strokeWithWidth:30.0f color:[UIColor redColor]];
+
+    [self assertShape:[self horizontalLineWithStroke:stroke] equalsImageName:@"solid-stroke"];
+}
+
+- (void)testLinearGradientStroke
+{
+    STKPXStroke *stroke = [[STKPXStroke alloc] initWithStrokeWidth:30.0f];
+    STKPXLinearGradient *gradient = [STKPXLinearGradient gradientFromStartColor:[UIColor blueColor]
+                                                                       endColor:[UIColor whiteColor]];
+
+    gradient.angle = 0.0f;
+    stroke.color = gradient;
+
+    [self assertShape:[self horizontalLineWithStroke:stroke] equalsImageName:@"linear-gradient-stroke"];
+}
+
+- (void)testRadialGradientStroke
+{
+    STKPXStroke *stroke = [[STKPXStroke alloc] initWithStrokeWidth:30.0f];
+    STKPXRadialGradient *gradient = [[STKPXRadialGradient alloc] init];
+
+    gradient.gradientUnits = STKPXGradientUnitsUserSpace;
+    gradient.startCenter = CGPointMake(50.0f, 50.0f);
+    gradient.endCenter = CGPointMake(50.0f, 50.0f);
+    gradient.radius = 30.0f;
+    [gradient addColor:[UIColor blueColor]];
+    [gradient addColor:[UIColor whiteColor]];
+    stroke.color = gradient;
+
+    [self assertShape:[self horizontalLineWithStroke:stroke] equalsImageName:@"radial-gradient-stroke"];
+}
+
+- (void)testInnerStroke
+{
+    STKPXRectangle *shape = [[STKPXRectangle alloc] initWithRect:CGRectMake(20.0f, 20.0f, 60.0f, 60.0f)];
+    STKPXStroke *stroke = [self strokeWithWidth:30.0f color:[UIColor redColor]];
+
+    stroke.type = kStrokeTypeInner;
+    shape.stroke = stroke;
+
+    [self assertShape:shape equalsImageName:@"inner-stroke"];
+}
+
+- (void)testCenteredStroke
+{
+    STKPXRectangle *shape = [[STKPXRectangle alloc] initWithRect:CGRectMake(20.0f, 20.0f, 60.0f, 60.0f)];
+
+    shape.stroke = [self strokeWithWidth:30.0f color:[UIColor redColor]];
+
+    [self assertShape:shape equalsImageName:@"center-stroke"];
+}
+
+- (void)testLineCaps
+{
+    NSDictionary *caps = @{ @"line-cap-butt" : @(kCGLineCapButt),
+                            @"line-cap-round" : @(kCGLineCapRound),
+                            @"line-cap-square" : @(kCGLineCapSquare) };
+
+    [caps enumerateKeysAndObjectsUsingBlock:^(NSString *name, NSNumber *cap, BOOL *stop) {
+        STKPXStroke *stroke = [self strokeWithWidth:30.0f color:[UIColor redColor]];
+
+        stroke.lineCap = (CGLineCap) cap.intValue;
+
+        [self assertShape:[self horizontalLineWithStroke:stroke] equalsImageName:name];
+    }];
+}
+
+- (void)testLineJoins
+{
+    NSDictionary *joins = @{ @"line-join-bevel" : @[ @(kCGLineJoinBevel), @30.0f, @4.0f ],
+                             @"line-join-round" : @[ @(kCGLineJoinRound), @30.0f, @4.0f ],
+                             @"line-join-miter" : @[ @(kCGLineJoinMiter), @20.0f, @4.0f ],
+                             @"line-join-miter-limit" : @[ @(kCGLineJoinMiter), @20.0f, @1.0f ] };
+
+    [joins enumerateKeysAndObjectsUsingBlock:^(NSString *name, NSArray *settings, BOOL *stop) {
+        STKPXStroke *stroke = [self strokeWithWidth:[settings[1] floatValue] color:[UIColor redColor]];
+
+        stroke.lineJoin = (CGLineJoin) [settings[0] intValue];
+        stroke.miterLimit = [settings[2] floatValue];
+
+        [self assertShape:[self cornerWithStroke:stroke] equalsImageName:name];
+    }];
+}
+
+- (void)testDashes
+{
+    STKPXStroke *stroke = [self strokeWithWidth:20.0f color:[UIColor redColor]];
+
+    stroke.dashArray = @[ @10.0f, @10.0f ];
+    [self assertShape:[self horizontalLineWithStroke:stroke] equalsImageName:@"dash-array"];
+
+    stroke.dashOffset = 5.0f;
+    [self assertShape:[self horizontalLineWithStroke:stroke] equalsImageName:@"dash-offset"];
+}
+
+- (void)testStrokeGroup
+{
+    STKPXLine *shape = [[STKPXLine alloc] initX1:10.0f y1:50.0f x2:90.0f y2:50.0f];
+    STKPXStrokeGroup *group = [[STKPXStrokeGroup alloc] init];
+    STKPXStroke *stripe = [self strokeWithWidth:5.0f color:[UIColor yellowColor]];
+
+    stripe.dashArray = @[ @15, @8 ];
+    [group addStroke:[self strokeWithWidth:41.0f color:[UIColor redColor]]];
+    [group addStroke:[self strokeWithWidth:35.0f color:[UIColor blackColor]]];
+    [group addStroke:stripe];
+    shape.stroke = group;
+
+    [self assertShape:shape equalsImageName:@"stroke-group"];
+}
+
+#pragma mark - Shadow Tests
+
+- (void)testShadow
+{
+    STKPXCircle *shape = [STKPXCircle circleWithCenter:CGPointMake(50.0f, 50.0f) withRadius:40.0f];
+    STKPXShadow *shadow = [[STKPXShadow alloc] init];
+
+    shadow.horizontalOffset = 3.0f;
+    shadow.verticalOffset = 3.0f;
+    shadow.blurDistance = 3.0f;
+    shape.shadow = shadow;
+    shape.fill = [STKPXSolidPaint paintWithColor:[UIColor redColor]];
+
+    [self assertShape:shape equalsImageName:@"shadow"];
+}
+
+- (void)testInnerShadowStaysInsideShape
+{
+    STKPXRectangle *shape = [[STKPXRectangle alloc] initWithRect:CGRectMake(20.0f, 20.0f, 60.0f, 60.0f)];
+    STKPXShadow *shadow = [[STKPXShadow alloc] init];
+
+    shadow.inset = YES;
+    shadow.horizontalOffset = 5.0f;
+    shadow.verticalOffset = 5.0f;
+    shadow.blurDistance = 4.0f;
+    shadow.color = [UIColor blackColor];
+    shape.shadow = shadow;
+    shape.fill = [STKPXSolidPaint paintWithColor:[UIColor whiteColor]];
+
+    STKPXRasterBackend *backend = [[STKPXRasterBackend alloc] initWithSize:CGSizeMake(100.0f, 100.0f) scale:1.0f];
+
+    [shape renderWithBackend:backend];
+
+    const STKPXRasterSurface *surface = backend.surface;
+    const uint8_t *topLeftInside = surface->pixels + 21 * surface->bytesPerRow + 21 * 4;
+    const uint8_t *center = surface->pixels + 50 * surface->bytesPerRow + 50 * 4;
+    const uint8_t *outside = surface->pixels + 10 * surface->bytesPerRow + 10 * 4;
+
+    // dark along the edges the light comes from, untouched in the middle and outside
+    XCTAssertLessThan(topLeftInside[0], 128);
+    XCTAssertEqual(center[0], 255);
+    XCTAssertEqual(outside[3], 0);
+}
+
+#pragma mark - Box Model Tests
+
+- (void)testBoxModel
+{
+    STKPXBoxModel *box = [[STKPXBoxModel alloc] initWithBounds:CGRectMake(10, 10, 80, 80)];
+
+    [box setBorderWidth:10.0f];
+    [box setBorderStyle:STKPXBorderStyleSolid];
+
+    box.borderTopPaint = [STKPXSolidPaint paintWithColor:[UIColor orangeColor]];
+    box.borderRightPaint = [STKPXSolidPaint paintWithColor:[UIColor blueColor]];
+    box.borderBottomPaint = [STKPXSolidPaint paintWithColor:[UIColor purpleColor]];
+    box.borderLeftPaint = [STKPXSolidPaint paintWithColor:[UIColor greenColor]];
+
+    box.fill = [STKPXSolidPaint paintWithColor:[UIColor redColor]];
+
+    [self assertShape:box equalsImageName:@"box-model"];
+}
+
+#pragma mark - SVG Tests
+
+- (void)testSVGShapes
+{
+    for (NSString *name in @[ @"line", @"rect", @"circlesvg", @"ellipsesvg", @"cubicBezierCommand", @"arcCommand" ])
+    {
+        [self assertSVG:name];
+    }
+}
+
+- (void)testSVGGradients
+{
+    [self assertSVG:@"linear-gradient"];
+    [self assertSVG:@"radial-gradient"];
+}
+
+- (void)testSVGOpacity
+{
+    [self assertSVG:@"opacity"];
+}
+
+#pragma mark - Backend Tests
+
+- (void)testCoreGraphicsBackendMatchesRender
+{
+    STKPXCircle *shape = [STKPXCircle circleWithCenter:CGPointMake(50.0f, 50.0f) withRadius:45.0f];
+
+    shape.fill = [STKPXSolidPaint paintWithColor:[UIColor redColor]];
+
+    UIGraphicsBeginImageContextWithOptions(CGSizeMake(100.0f, 100.0f), NO, 1.0f);
+    [shape render:UIGraphicsGetCurrentContext()];
+    UIImage *rendered = UIGraphicsGetImageFromCurrentImageContext();
+    UIGraphicsEndImageContext();
+
+    UIGraphicsBeginImageContextWithOptions(CGSizeMake(100.0f, 100.0f), NO, 1.0f);
+    [shape renderWithBackend:[[STKPXCoreGraphicsBackend alloc] initWithContext:UIGraphicsGetCurrentContext()]];
+    UIImage *backendRendered = UIGraphicsGetImageFromCurrentImageContext();
+    UIGraphicsEndImageContext();
+
+    [self assertImage:backendRendered equalsImage:rendered];
+}
+
+- (void)testThreadCountDoesNotChangeOutput
+{
+    STKPXCircle *shape = [STKPXCircle circleWithCenter:CGPointMake(256.0f, 256.0f) withRadius:240.0f];
+
+    shape.fill = [STKPXLinearGradient gradientFromStartColor:[UIColor redColor] endColor:[UIColor blueColor]];
+
+    STKPXRasterBackend *serial = [[STKPXRasterBackend alloc] initWithSize:CGSizeMake(512.0f, 512.0f) scale:1.0f];
+    STKPXRasterBackend *parallel = [[STKPXRasterBackend alloc] initWithSize:CGSizeMake(512.0f, 512.0f) scale:1.0f];
+
+    STKPXRasterSetThreadCount(1);
+    [shape renderWithBackend:serial];
+    STKPXRasterSetThreadCount(4);
+    [shape renderWithBackend:parallel];
+    STKPXRasterSetThreadCount(0);
+
+    XCTAssertEqual(memcmp(serial.surface->pixels, parallel.surface->pixels, serial.surface->bytesPerRow * 512), 0);
+}
+
+@end
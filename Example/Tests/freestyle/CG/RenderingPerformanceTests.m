@@ -0,0 +1,1299 @@
+//
+//  RenderingPerformanceTests.m
+//  StylingKit
+//
+
+#import "ImageBasedTests.h"
+#import "STKPXStylerContext.h"
+#import "STKPXSolidPaint.h"
+#import "STKPXLinearGradient.h"
+#import "STKPXCacheManager.h"
+#import "STKPXRenderPipeline.h"
+#import "STKPXDiskImageCache.h"
+#import "PixateFreestyle.h"
+#import "STKBenchmarkRecorder.h"
+#import "PXDOMElement.h"
+#import "STKPXRasterBackend.h"
+#import "STKPXCircle.h"
+#import "STKPXShapeGroup.h"
+#import "STKPXStroke.h"
+#import "STKPXRadialGradient.h"
+#import "STKPXRectangle.h"
+#import "STKPXEllipse.h"
+#import "STKPXPathCache.h"
+#import "STKPXEllipticalArc.h"
+#import "STKPXMath.h"
+#import "STKPXSVGLoader.h"
+#import "STKPXShapeDocument.h"
+#import "STKPXDisplayList.h"
+#import "STKPXArrowRectangle.h"
+#import "STKPXShadow.h"
+#import "STKPXBackgroundImageDescription.h"
+
+static STKBenchmarkRecorder *RECORDER;
+
+/**
+ *  Forwards to a raster backend, counting the graphics states saved along the way
+ */
+@interface CountingRenderBackend : NSObject <STKPXRenderBackend>
+@property (nonatomic, readonly) STKPXRasterBackend *target;
+@property (nonatomic, readonly) NSUInteger saveCount;
+- (instancetype)initWithSize:(CGSize)size;
+@end
+
+@implementation CountingRenderBackend
+
+- (instancetype)initWithSize:(CGSize)size
+{
+    if (self = [super init])
+    {
+        _target = [[STKPXRasterBackend alloc] initWithSize:size scale:1.0f];
+    }
+
+    return self;
+}
+
+- (void)saveState
+{
+    _saveCount++;
+    [_target saveState];
+}
+
+- (void)restoreState { [_target restoreState]; }
+- (void)concatTransform:(CGAffineTransform)transform { [_target concatTransform:transform]; }
+- (void)clipToPath:(CGPathRef)path { [_target clipToPath:path]; }
+- (void)beginTransparencyLayerWithOpacity:(CGFloat)opacity { [_target beginTransparencyLayerWithOpacity:opacity]; }
+- (void)endTransparencyLayer { [_target endTransparencyLayer]; }
+- (void)fillPath:(CGPathRef)path withPaint:(id<STKPXPaint>)paint { [_target fillPath:path withPaint:paint]; }
+- (void)strokePath:(CGPathRef)path withStroke:(id<STKPXStrokeRenderer>)stroke { [_target strokePath:path withStroke:stroke]; }
+- (void)applyOutsetOfShadow:(id<STKPXShadowPaint>)shadow toPath:(CGPathRef)path { [_target applyOutsetOfShadow:shadow toPath:path]; }
+- (void)applyInsetOfShadow:(id<STKPXShadowPaint>)shadow toPath:(CGPathRef)path { [_target applyInsetOfShadow:shadow toPath:path]; }
+
+@end
+
+/**
+ *  Counts how often its display list is invalidated
+ */
+@interface CountingShapeDocument : STKPXShapeDocument
+@property (nonatomic) NSUInteger invalidationCount;
+@end
+
+@implementation CountingShapeDocument
+
+- (void)invalidateDisplayList
+{
+    _invalidationCount++;
+    [super invalidateDisplayList];
+}
+
+@end
+
+@interface RenderingPerformanceTests : ImageBasedTests
+@end
+
+@implementation RenderingPerformanceTests
+{
+    NSArray *cellSizes_;
+}
+
++ (void)setUp
+{
+    [super setUp];
+
+    RECORDER = [[STKBenchmarkRecorder alloc] initWithSuiteName:@"RenderingPerformanceTests"];
+}
+
++ (void)tearDown
+{
+    [RECORDER writeReport];
+    RECORDER = nil;
+
+    [super tearDown];
+}
+
+- (void)setUp
+{
+    [super setUp];
+
+    // a list of table cells: a few widths (orientations, split views) times many content-driven heights
+    NSMutableArray *sizes = [[NSMutableArray alloc] init];
+
+    for (NSUInteger i = 0; i < 100; i++)
+    {
+        CGFloat width = 280.0f + 40.0f * (i % 4);
+        CGFloat height = 44.0f + 3.0f * (i / 4);
+
+        [sizes addObject:[NSValue valueWithCGSize:CGSizeMake(width, height)]];
+    }
+
+    cellSizes_ = sizes;
+
+    [STKPXCacheManager clearImageCache];
+}
+
+- (void)tearDown
+{
+    [STKPXCacheManager clearImageCache];
+    PixateFreestyle.configuration.resizableBackgroundImages = YES;
+    PixateFreestyle.configuration.asyncBackgroundImages = NO;
+
+    [super tearDown];
+}
+
+#pragma mark - Helpers
+
+- (STKPXStylerContext *)contextWithFill:(id<STKPXPaint>)fill size:(CGSize)size
+{
+    STKPXStylerContext *context = [[STKPXStylerContext alloc] init];
+
+    context.fill = fill;
+    context.bounds = CGRectMake(0.0f, 0.0f, size.width, size.height);
+
+    // the style hash covers the view bounds, so full size images of different cells never share a cache entry
+    context.styleHash = (NSUInteger) size.width * 10000 + (NSUInteger) size.height;
+
+    [context.boxModel setCornerRadius:8.0f];
+    [context.boxModel setBorderPaint:[STKPXSolidPaint paintWithColor:[UIColor darkGrayColor]]
+                               width:1.0f
+                               style:STKPXBorderStyleSolid];
+
+    return context;
+}
+
+- (UIImage *)image:(UIImage *)image drawnAtSize:(CGSize)size
+{
+    UIGraphicsBeginImageContextWithOptions(size, NO, 0.0f);
+    [image drawInRect:CGRectMake(0.0f, 0.0f, size.width, size.height)];
+    UIImage *result = UIGraphicsGetImageFromCurrentImageContext();
+    UIGraphicsEndImageContext();
+
+    return result;
+}
+
+- (void)measureBackgroundsWithFill:(id<STKPXPaint>)fill name:(NSString *)name
+{
+    NSArray *sizes = cellSizes_;
+    NSMutableSet *fullImages = [[NSMutableSet alloc] init];
+    NSMutableSet *sliceImages = [[NSMutableSet alloc] init];
+
+    STKBenchmarkSample *full = [RECORDER measure:[NSString stringWithFormat:@"background.%@.full", name]
+                                      iterations:10
+                                           items:sizes.count
+                                           block:^{
+        [STKPXCacheManager clearImageCache];
+        [fullImages removeAllObjects];
+
+        for (NSValue *size in sizes)
+        {
+            [fullImages addObject:[self contextWithFill:fill size:size.CGSizeValue].backgroundImage];
+        }
+    }];
+
+    STKBenchmarkSample *slice = [RECORDER measure:[NSString stringWithFormat:@"background.%@.nine_slice", name]
+                                       iterations:10
+                                            items:sizes.count
+                                            block:^{
+        [STKPXCacheManager clearImageCache];
+        [sliceImages removeAllObjects];
+
+        for (NSValue *size in sizes)
+        {
+            [sliceImages addObject:[self contextWithFill:fill size:size.CGSizeValue].resizableBackgroundImage];
+        }
+    }];
+
+    full.metrics[@"images"] = @(fullImages.count);
+    full.metrics[@"pixel_bytes"] = @([self pixelBytesOfImages:fullImages]);
+    slice.metrics[@"images"] = @(sliceImages.count);
+    slice.metrics[@"pixel_bytes"] = @([self pixelBytesOfImages:sliceImages]);
+
+    XCTAssertTrue(sliceImages.count < fullImages.count);
+}
+
+- (NSUInteger)pixelBytesOfImages:(NSSet *)images
+{
+    NSUInteger result = 0;
+
+    for (UIImage *image in images)
+    {
+        result += CGImageGetBytesPerRow(image.CGImage) * CGImageGetHeight(image.CGImage);
+    }
+
+    return result;
+}
+
+#pragma mark - Nine-slice backgrounds
+
+- (void)testSolidBackgrounds
+{
+    [self measureBackgroundsWithFill:[STKPXSolidPaint paintWithColor:[UIColor orangeColor]] name:@"solid"];
+}
+
+- (void)testGradientBackgrounds
+{
+    STKPXLinearGradient *gradient = [STKPXLinearGradient gradientFromStartColor:[UIColor whiteColor]
+                                                                       endColor:[UIColor blueColor]];
+
+    XCTAssertEqual(gradient.axis, STKPXLinearGradientAxisVertical);
+
+    [self measureBackgroundsWithFill:gradient name:@"gradient"];
+}
+
+- (void)testNineSliceMatchesFullRender
+{
+    STKPXLinearGradient *gradient = [STKPXLinearGradient gradientFromStartColor:[UIColor whiteColor]
+                                                                       endColor:[UIColor blueColor]];
+
+    for (id<STKPXPaint> fill in @[ [STKPXSolidPaint paintWithColor:[UIColor orangeColor]], gradient ])
+    {
+        for (NSValue *value in @[ cellSizes_.firstObject, cellSizes_.lastObject ])
+        {
+            CGSize size = value.CGSizeValue;
+            UIImage *full = [self contextWithFill:fill size:size].backgroundImage;
+            UIImage *slice = [self contextWithFill:fill size:size].resizableBackgroundImage;
+
+            XCTAssertFalse(UIEdgeInsetsEqualToEdgeInsets(slice.capInsets, UIEdgeInsetsZero));
+            XCTAssertTrue(slice.size.width < size.width);
+            [self assertImage:[self image:slice drawnAtSize:size] equalsImage:[self image:full drawnAtSize:size]];
+        }
+    }
+}
+
+- (void)testNineSliceFallsBackToFullRender
+{
+    CGSize size = [cellSizes_.firstObject CGSizeValue];
+    STKPXLinearGradient *diagonal = [STKPXLinearGradient gradientFromStartColor:[UIColor whiteColor]
+                                                                       endColor:[UIColor blueColor]];
+
+    diagonal.angle = 45.0f;
+
+    STKPXStylerContext *context = [self contextWithFill:diagonal size:size];
+
+    XCTAssertTrue(CGSizeEqualToSize(context.resizableBackgroundImage.size, size));
+
+    PixateFreestyle.configuration.resizableBackgroundImages = NO;
+    context = [self contextWithFill:[STKPXSolidPaint paintWithColor:[UIColor orangeColor]] size:size];
+
+    XCTAssertTrue(CGSizeEqualToSize(context.resizableBackgroundImage.size, size));
+}
+
+- (void)testNineSliceSkipsSingleSideBorders
+{
+    CGSize size = [cellSizes_.firstObject CGSizeValue];
+    STKPXSolidPaint *fill = [STKPXSolidPaint paintWithColor:[UIColor orangeColor]];
+    STKPXSolidPaint *red = [STKPXSolidPaint paintWithColor:[UIColor redColor]];
+    STKPXStylerContext *context = [self contextWithFill:fill size:size];
+    STKPXStylerContext *uniform = [self contextWithFill:fill size:size];
+
+    context.styleHash += 1;
+    [context.boxModel setBorderPaint:nil width:0.0f style:STKPXBorderStyleNone];
+    [context.boxModel setBorderBottomPaint:red width:1.0f style:STKPXBorderStyleSolid];
+
+    UIImage *image = context.resizableBackgroundImage;
+
+    // the whole background is rendered, and not mistaken for the uniform border's slice
+    XCTAssertTrue(CGSizeEqualToSize(image.size, size));
+    XCTAssertTrue(UIEdgeInsetsEqualToEdgeInsets(image.capInsets, UIEdgeInsetsZero));
+    XCTAssertNotEqual(image, uniform.resizableBackgroundImage);
+
+    CGRect bounds = CGRectMake(0.0f, 0.0f, size.width, size.height);
+
+    [self assertImage:image equalsImage:[[context backgroundImageDescriptionWithBounds:bounds] renderImage]];
+}
+
+- (void)testNineSliceSkipsDashedBorders
+{
+    CGSize size = [cellSizes_.firstObject CGSizeValue];
+    STKPXSolidPaint *fill = [STKPXSolidPaint paintWithColor:[UIColor orangeColor]];
+    STKPXStylerContext *dashed = [self contextWithFill:fill size:size];
+    STKPXStylerContext *solid = [self contextWithFill:fill size:size];
+
+    [dashed.boxModel setBorderStyle:STKPXBorderStyleDashed];
+
+    UIImage *image = dashed.resizableBackgroundImage;
+
+    XCTAssertTrue(CGSizeEqualToSize(image.size, size));
+    XCTAssertTrue(UIEdgeInsetsEqualToEdgeInsets(image.capInsets, UIEdgeInsetsZero));
+
+    // a solid border of the same width and paint still slices
+    XCTAssertTrue(solid.resizableBackgroundImage.size.width < size.width);
+}
+
+#pragma mark - Async backgrounds
+
+- (void)testAsyncBackgroundsShareOneRender
+{
+    STKPXRenderPipeline *pipeline = [STKPXRenderPipeline sharedInstance];
+    CGSize size = [cellSizes_.firstObject CGSizeValue];
+    STKPXLinearGradient *diagonal = [STKPXLinearGradient gradientFromStartColor:[UIColor whiteColor]
+                                                                       endColor:[UIColor blueColor]];
+    NSMutableArray *elements = [[NSMutableArray alloc] init];
+
+    // diagonal gradients can't be nine-sliced, so every background is a full render
+    diagonal.angle = 45.0f;
+    PixateFreestyle.configuration.asyncBackgroundImages = YES;
+
+    for (NSUInteger i = 0; i < 20; i++)
+    {
+        PXDOMElement *element = [[PXDOMElement alloc] initWithName:@"cell"];
+        STKPXStylerContext *context = [self contextWithFill:diagonal size:size];
+        __block UIImage *applied = nil;
+
+        context.styleable = element;
+        [context requestBackgroundImage:^(UIImage *image) {
+            applied = image;
+        }];
+
+        // the first frame never waits
+        XCTAssertNotNil(applied);
+
+        [elements addObject:element];
+    }
+
+    // restyle every cell with a new style that misses the cache
+    [pipeline resetCounters];
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"backgrounds applied"];
+    NSMutableArray *contexts = [[NSMutableArray alloc] init];
+    __block NSUInteger appliedCount = 0;
+
+    for (PXDOMElement *element in elements)
+    {
+        STKPXStylerContext *context = [self contextWithFill:diagonal size:size];
+
+        context.styleable = element;
+        context.styleHash += 1;
+        [contexts addObject:context];
+    }
+
+    STKBenchmarkSample *sample = [RECORDER measure:@"background.async.submit" iterations:1 items:contexts.count block:^{
+        for (STKPXStylerContext *context in contexts)
+        {
+            [context requestBackgroundImage:^(UIImage *image) {
+                XCTAssertTrue([NSThread isMainThread]);
+                XCTAssertNotNil(image);
+
+                if (++appliedCount == contexts.count)
+                {
+                    [expectation fulfill];
+                }
+            }];
+        }
+    }];
+
+    [self waitForExpectationsWithTimeout:10.0 handler:nil];
+
+    sample.metrics[@"renders"] = @(pipeline.renderCount);
+    sample.metrics[@"dedup_hits"] = @(pipeline.dedupHits);
+    sample.metrics[@"peak_queue_depth"] = @(pipeline.peakQueueDepth);
+
+    // requests either joined the single job or found its image in the cache
+    XCTAssertEqual(pipeline.renderCount, 1);
+    XCTAssertEqual(pipeline.queueDepth, 0);
+}
+
+- (void)testAsyncBackgroundDropsSupersededImage
+{
+    CGSize size = [cellSizes_.firstObject CGSizeValue];
+    STKPXLinearGradient *diagonal = [STKPXLinearGradient gradientFromStartColor:[UIColor whiteColor]
+                                                                       endColor:[UIColor blueColor]];
+    PXDOMElement *element = [[PXDOMElement alloc] initWithName:@"cell"];
+    NSMutableArray *applied = [[NSMutableArray alloc] init];
+
+    diagonal.angle = 45.0f;
+    PixateFreestyle.configuration.asyncBackgroundImages = YES;
+
+    for (NSUInteger i = 0; i < 3; i++)
+    {
+        STKPXStylerContext *context = [self contextWithFill:diagonal size:size];
+
+        context.styleable = element;
+        context.styleHash += i;
+        [context requestBackgroundImage:^(UIImage *image) {
+            [applied addObject:@(i)];
+        }];
+    }
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"render queue drained"];
+
+    // completions are queued on the main queue behind the render, so poll until the pipeline is idle
+    __block void (^poll)(void) = ^{
+        if ([STKPXRenderPipeline sharedInstance].queueDepth == 0)
+        {
+            [expectation fulfill];
+        }
+        else
+        {
+            dispatch_after(dispatch_time(DISPATCH_TIME_NOW, NSEC_PER_MSEC * 10), dispatch_get_main_queue(), poll);
+        }
+    };
+
+    poll();
+    [self waitForExpectationsWithTimeout:10.0 handler:nil];
+    poll = nil;
+
+    // the first request was synchronous and only the latest async one was applied
+    XCTAssertEqualObjects(applied, (@[ @0, @2 ]));
+}
+
+- (void)testBackgroundDescriptionIsASnapshot
+{
+    STKPXSolidPaint *red = [STKPXSolidPaint paintWithColor:[UIColor redColor]];
+    STKPXStylerContext *context = [self contextWithFill:red size:CGSizeMake(40.0f, 40.0f)];
+    STKPXShadow *inner = [[STKPXShadow alloc] init];
+
+    inner.inset = YES;
+    inner.color = [UIColor blackColor];
+    context.shadow = inner;
+
+    STKPXBackgroundImageDescription *description =
+        [context backgroundImageDescriptionWithBounds:CGRectMake(0.0f, 0.0f, 40.0f, 40.0f)];
+
+    STKPXShadowGroup *shadows = [[STKPXShadowGroup alloc] init];
+
+    [shadows addShadowPaint:inner];
+    [shadows addShadowPaint:inner];
+
+    // keep styling the context after the snapshot was taken
+    context.fill = [STKPXSolidPaint paintWithColor:[UIColor greenColor]];
+    context.shadow = shadows;
+    [context.boxModel setCornerRadius:2.0f];
+    [context.boxModel setBorderWidth:6.0f];
+    context.shape.fill = [STKPXSolidPaint paintWithColor:[UIColor blueColor]];
+
+    STKPXRectangle *shape = (STKPXRectangle *) description.shape;
+
+    XCTAssertFalse(description.sharesShape);
+    XCTAssertNotEqual(description.shape, context.shape);
+    XCTAssertTrue([shape isKindOfClass:[STKPXRectangle class]]);
+    XCTAssertEqual(shape.fill, red);
+    XCTAssertEqual(((STKPXStroke *) shape.stroke).width, 1.0f);
+    XCTAssertTrue(CGSizeEqualToSize(shape.radiusTopLeft, CGSizeMake(8.0f, 8.0f)));
+    XCTAssertTrue(CGRectEqualToRect(shape.bounds, CGRectMake(0.5f, 0.5f, 39.0f, 39.0f)));
+    XCTAssertEqual(((STKPXShadowGroup *) shape.shadow).count, 1);
+}
+
+- (void)testBackgroundDescriptionCopiesShapes
+{
+    STKPXStylerContext *context = [[STKPXStylerContext alloc] init];
+    STKPXArrowRectangle *arrow = [[STKPXArrowRectangle alloc] initWithDirection:STKPXArrowRectangleDirectionRight];
+
+    context.shape = arrow;
+
+    STKPXBackgroundImageDescription *description =
+        [context backgroundImageDescriptionWithBounds:CGRectMake(0.0f, 0.0f, 60.0f, 30.0f)];
+    STKPXArrowRectangle *copy = (STKPXArrowRectangle *) description.shape;
+
+    XCTAssertNotEqual(copy, arrow);
+    XCTAssertTrue([copy isKindOfClass:[STKPXArrowRectangle class]]);
+    XCTAssertEqual(copy.direction, STKPXArrowRectangleDirectionRight);
+
+    // the context's own shape is left as it was
+    XCTAssertTrue(CGRectEqualToRect(arrow.bounds, CGRectZero));
+
+    context.shape = [STKPXEllipse ellipseWithCenter:CGPointMake(5.0f, 5.0f) withRadiusX:5.0f withRadiusY:5.0f];
+    description = [context backgroundImageDescriptionWithBounds:CGRectMake(0.0f, 0.0f, 20.0f, 10.0f)];
+
+    XCTAssertTrue([description.shape isKindOfClass:[STKPXEllipse class]]);
+    XCTAssertEqual(((STKPXEllipse *) description.shape).radiusX, 10.0f);
+    XCTAssertEqual(((STKPXEllipse *) context.shape).radiusX, 5.0f);
+}
+
+- (void)testAsyncBackgroundRendersRequestedStyle
+{
+    CGSize size = CGSizeMake(64.0f, 32.0f);
+    STKPXLinearGradient *diagonal = [STKPXLinearGradient gradientFromStartColor:[UIColor whiteColor]
+                                                                       endColor:[UIColor redColor]];
+    PXDOMElement *element = [[PXDOMElement alloc] initWithName:@"cell"];
+    STKPXStylerContext *first = [self contextWithFill:diagonal size:size];
+
+    diagonal.angle = 45.0f;
+    PixateFreestyle.configuration.asyncBackgroundImages = YES;
+
+    // the first request is synchronous and leaves an image on screen, so the next one renders on the render queue
+    first.styleable = element;
+    [first requestBackgroundImage:^(UIImage *image) {}];
+
+    STKPXStylerContext *context = [self contextWithFill:diagonal size:size];
+    XCTestExpectation *expectation = [self expectationWithDescription:@"background applied"];
+    __block UIImage *applied = nil;
+
+    context.styleable = element;
+    context.styleHash += 1;
+    [context requestBackgroundImage:^(UIImage *image) {
+        applied = image;
+        [expectation fulfill];
+    }];
+
+    // restyling (or recycling) the context while the image renders must not leak into it
+    context.fill = [STKPXSolidPaint paintWithColor:[UIColor greenColor]];
+    [context.boxModel setBorderWidth:5.0f];
+    [STKPXStylerContext recycleContext:context];
+
+    [self waitForExpectationsWithTimeout:10.0 handler:nil];
+
+    STKPXStylerContext *expected = [self contextWithFill:diagonal size:size];
+
+    expected.styleHash += 2;
+    [self assertImage:applied equalsImage:expected.backgroundImage];
+}
+
+#pragma mark - Disk image cache
+
+- (NSString *)temporaryCacheDirectory
+{
+    return [NSTemporaryDirectory() stringByAppendingPathComponent:[NSUUID UUID].UUIDString];
+}
+
+- (uint64_t)digestOfContext:(STKPXStylerContext *)context
+{
+    return [STKPXDiskImageCache digestForStyleHash:context.styleHash
+                                              size:context.bounds.size
+                                             scale:[UIScreen mainScreen].scale];
+}
+
+- (void)testDiskImageCacheSurvivesReopening
+{
+    NSString *directory = [self temporaryCacheDirectory];
+    STKPXStylerContext *context = [self contextWithFill:[STKPXSolidPaint paintWithColor:[UIColor orangeColor]]
+                                                   size:CGSizeMake(120.0f, 44.0f)];
+    UIImage *expected = context.backgroundImage;
+    STKPXDiskImageCache *cache = [[STKPXDiskImageCache alloc] initWithDirectory:directory
+                                                                   themeVersion:@"1"
+                                                                      byteLimit:NSUIntegerMax];
+
+    [cache setImage:expected forDigest:[self digestOfContext:context]];
+    [cache synchronize];
+
+    // a new instance stands in for the next launch
+    STKPXDiskImageCache *reopened = [[STKPXDiskImageCache alloc] initWithDirectory:directory
+                                                                      themeVersion:@"1"
+                                                                         byteLimit:NSUIntegerMax];
+    UIImage *actual = [reopened imageForDigest:[self digestOfContext:context]];
+
+    XCTAssertEqual(reopened.entryCount, 1);
+    XCTAssertNotNil(actual);
+    XCTAssertTrue(CGSizeEqualToSize(actual.size, expected.size));
+    XCTAssertEqual(actual.scale, expected.scale);
+    [self assertImage:actual equalsImage:expected];
+
+    XCTAssertNil([reopened imageForDigest:[self digestOfContext:context] + 1]);
+    XCTAssertEqual(reopened.hitCount, 1);
+    XCTAssertEqual(reopened.missCount, 1);
+
+    [[NSFileManager defaultManager] removeItemAtPath:directory error:NULL];
+}
+
+- (void)testDiskImageCacheThemeVersionInvalidates
+{
+    NSString *directory = [self temporaryCacheDirectory];
+    UIImage *image = [self contextWithFill:[STKPXSolidPaint paintWithColor:[UIColor redColor]]
+                                      size:CGSizeMake(32.0f, 32.0f)].backgroundImage;
+    STKPXDiskImageCache *cache = [[STKPXDiskImageCache alloc] initWithDirectory:directory
+                                                                   themeVersion:@"1"
+                                                                      byteLimit:NSUIntegerMax];
+
+    [cache setImage:image forDigest:1];
+    [cache synchronize];
+
+    STKPXDiskImageCache *updated = [[STKPXDiskImageCache alloc] initWithDirectory:directory
+                                                                     themeVersion:@"2"
+                                                                        byteLimit:NSUIntegerMax];
+
+    XCTAssertNil([updated imageForDigest:1]);
+    XCTAssertEqual(updated.totalBytes, 0);
+
+    // changing the stamp of an open cache drops its entries as well
+    [updated setImage:image forDigest:2];
+    [updated synchronize];
+    XCTAssertNotNil([updated imageForDigest:2]);
+
+    updated.themeVersion = @"3";
+    [updated synchronize];
+
+    XCTAssertNil([updated imageForDigest:2]);
+    XCTAssertEqual([[NSFileManager defaultManager] contentsOfDirectoryAtPath:directory error:NULL].count, 1);
+
+    [[NSFileManager defaultManager] removeItemAtPath:directory error:NULL];
+}
+
+- (void)testDiskImageCacheEvictsLeastRecentlyUsed
+{
+    NSString *directory = [self temporaryCacheDirectory];
+    UIImage *image = [self contextWithFill:[STKPXSolidPaint paintWithColor:[UIColor greenColor]]
+                                      size:CGSizeMake(32.0f, 32.0f)].backgroundImage;
+    STKPXDiskImageCache *cache = [[STKPXDiskImageCache alloc] initWithDirectory:directory
+                                                                   themeVersion:@"1"
+                                                                      byteLimit:NSUIntegerMax];
+
+    [cache setImage:image forDigest:1];
+    [cache synchronize];
+
+    NSUInteger entryBytes = cache.totalBytes;
+
+    [cache setImage:image forDigest:2];
+    [cache setImage:image forDigest:3];
+    [cache synchronize];
+
+    // touch the oldest entry, then make room for only two images
+    XCTAssertNotNil([cache imageForDigest:1]);
+    cache.byteLimit = entryBytes * 2;
+    [cache synchronize];
+
+    XCTAssertEqual(cache.entryCount, 2);
+    XCTAssertEqual(cache.evictionCount, 1);
+    XCTAssertNil([cache imageForDigest:2]);
+    XCTAssertNotNil([cache imageForDigest:1]);
+    XCTAssertNotNil([cache imageForDigest:3]);
+
+    // the eviction is persisted
+    STKPXDiskImageCache *reopened = [[STKPXDiskImageCache alloc] initWithDirectory:directory
+                                                                      themeVersion:@"1"
+                                                                         byteLimit:entryBytes * 2];
+
+    XCTAssertEqual(reopened.entryCount, 2);
+    XCTAssertEqual(reopened.totalBytes, entryBytes * 2);
+
+    [[NSFileManager defaultManager] removeItemAtPath:directory error:NULL];
+}
+
+- (void)testSharedDiskImageCacheSurvivesRelaunch
+{
+    NSString *directory = [self temporaryCacheDirectory];
+    PixateFreestyleConfiguration *configuration = [[PixateFreestyleConfiguration alloc] init];
+    UIImage *image = [self contextWithFill:[STKPXSolidPaint paintWithColor:[UIColor brownColor]]
+                                      size:CGSizeMake(32.0f, 32.0f)].backgroundImage;
+
+    configuration.diskImageCacheVersion = @"7";
+
+    STKPXDiskImageCache *cache = [STKPXDiskImageCache cacheWithDirectory:directory configuration:configuration];
+
+    [cache setImage:image forDigest:1];
+    [cache synchronize];
+
+    // the next launch opens the shared cache the same way, then styling applies the configured stamp again
+    STKPXDiskImageCache *relaunched = [STKPXDiskImageCache cacheWithDirectory:directory configuration:configuration];
+
+    XCTAssertEqualObjects(relaunched.themeVersion, @"7");
+    XCTAssertEqual(relaunched.entryCount, 1);
+
+    relaunched.themeVersion = configuration.diskImageCacheVersion;
+    [relaunched synchronize];
+
+    XCTAssertNotNil([relaunched imageForDigest:1]);
+
+    // the shared instance itself is stamped with the application's configuration
+    NSString *version = PixateFreestyle.configuration.diskImageCacheVersion;
+
+    XCTAssertEqualObjects([STKPXDiskImageCache sharedInstance].themeVersion, (version) ? version : @"");
+
+    [[NSFileManager defaultManager] removeItemAtPath:directory error:NULL];
+}
+
+- (void)testDiskImageDigestCoversAssets
+{
+    NSString *path = [[self temporaryCacheDirectory] stringByAppendingPathExtension:@"png"];
+    NSURL *URL = [NSURL fileURLWithPath:path];
+    CGSize size = CGSizeMake(32.0f, 32.0f);
+    UIImage *asset = [self contextWithFill:[STKPXSolidPaint paintWithColor:[UIColor cyanColor]] size:size].backgroundImage;
+
+    [UIImagePNGRepresentation(asset) writeToFile:path atomically:YES];
+
+    uint64_t plain = [STKPXDiskImageCache digestForStyleHash:1 size:size scale:2.0f];
+    uint64_t original = [STKPXDiskImageCache digestForStyleHash:1 size:size scale:2.0f assetURLs:@[ URL ]];
+
+    XCTAssertNotEqual(plain, original);
+    XCTAssertEqual(original, [STKPXDiskImageCache digestForStyleHash:1 size:size scale:2.0f assetURLs:@[ URL ]]);
+
+    // replacing the asset file changes the key
+    [[NSData dataWithBytes:"changed" length:7] writeToFile:path atomically:YES];
+
+    XCTAssertNotEqual(original, [STKPXDiskImageCache digestForStyleHash:1 size:size scale:2.0f assetURLs:@[ URL ]]);
+
+    // long URLs that share their ends still get different keys
+    NSString *middle = [@"" stringByPaddingToLength:256 withString:@"a" startingAtIndex:0];
+    NSURL *first = [NSURL URLWithString:[NSString stringWithFormat:@"data:image/png;base64,%@A%@", middle, middle]];
+    NSURL *second = [NSURL URLWithString:[NSString stringWithFormat:@"data:image/png;base64,%@B%@", middle, middle]];
+
+    XCTAssertNotEqual([STKPXDiskImageCache digestForStyleHash:1 size:size scale:2.0f assetURLs:@[ first ]],
+                      [STKPXDiskImageCache digestForStyleHash:1 size:size scale:2.0f assetURLs:@[ second ]]);
+
+    [[NSFileManager defaultManager] removeItemAtPath:path error:NULL];
+}
+
+- (void)testDiskImageCacheBacksStylerContext
+{
+    STKPXDiskImageCache *cache = [STKPXDiskImageCache sharedInstance];
+    id<STKPXPaint> fill = [STKPXSolidPaint paintWithColor:[UIColor purpleColor]];
+    CGSize size = CGSizeMake(77.0f, 33.0f);
+
+    PixateFreestyle.configuration.diskImageCache = YES;
+    [cache removeAllImages];
+    [cache synchronize];
+    [cache resetCounters];
+
+    UIImage *rendered = [self contextWithFill:fill size:size].backgroundImage;
+
+    [cache synchronize];
+    [STKPXCacheManager clearImageCache];
+
+    UIImage *loaded = [self contextWithFill:fill size:size].backgroundImage;
+
+    XCTAssertEqual(cache.missCount, 1);
+    XCTAssertEqual(cache.hitCount, 1);
+    [self assertImage:loaded equalsImage:rendered];
+
+    PixateFreestyle.configuration.diskImageCache = NO;
+    [cache removeAllImages];
+    [cache synchronize];
+}
+
+- (void)testDiskImageCacheLaunch
+{
+    NSString *directory = [self temporaryCacheDirectory];
+    NSArray *sizes = cellSizes_;
+    STKPXLinearGradient *diagonal = [STKPXLinearGradient gradientFromStartColor:[UIColor whiteColor]
+                                                                       endColor:[UIColor blueColor]];
+    __block NSUInteger warmImages = 0;
+    __block NSUInteger mappedBytes = 0;
+
+    diagonal.angle = 45.0f;
+
+    // a cold launch renders every background and fills the disk cache
+    STKBenchmarkSample *cold = [RECORDER measure:@"background.launch.cold" iterations:5 items:sizes.count block:^{
+        STKPXDiskImageCache *cache = [[STKPXDiskImageCache alloc] initWithDirectory:directory
+                                                                       themeVersion:@"1"
+                                                                          byteLimit:NSUIntegerMax];
+
+        [cache removeAllImages];
+        [STKPXCacheManager clearImageCache];
+
+        for (NSValue *size in sizes)
+        {
+            STKPXStylerContext *context = [self contextWithFill:diagonal size:size.CGSizeValue];
+
+            [cache setImage:context.backgroundImage forDigest:[self digestOfContext:context]];
+        }
+
+        [cache synchronize];
+    }];
+
+    // a warm launch opens the index and maps every background back in
+    STKBenchmarkSample *warm = [RECORDER measure:@"background.launch.warm" iterations:5 items:sizes.count block:^{
+        STKPXDiskImageCache *cache = [[STKPXDiskImageCache alloc] initWithDirectory:directory
+                                                                       themeVersion:@"1"
+                                                                          byteLimit:NSUIntegerMax];
+
+        warmImages = 0;
+        mappedBytes = 0;
+
+        for (NSValue *size in sizes)
+        {
+            STKPXStylerContext *context = [self contextWithFill:diagonal size:size.CGSizeValue];
+            UIImage *image = [cache imageForDigest:[self digestOfContext:context]];
+
+            if (image)
+            {
+                warmImages++;
+                mappedBytes += CGImageGetBytesPerRow(image.CGImage) * CGImageGetHeight(image.CGImage);
+            }
+        }
+    }];
+
+    cold.metrics[@"renders"] = @(sizes.count);
+    warm.metrics[@"renders"] = @(sizes.count - warmImages);
+    warm.metrics[@"mapped_bytes"] = @(mappedBytes);
+
+    XCTAssertEqual(warmImages, sizes.count);
+
+    [[NSFileManager defaultManager] removeItemAtPath:directory error:NULL];
+}
+
+#pragma mark - Raster backend
+
+- (STKPXShapeGroup *)rasterScene
+{
+    STKPXShapeGroup *scene = [[STKPXShapeGroup alloc] init];
+
+    for (NSUInteger i = 0; i < 16; i++)
+    {
+        CGPoint center = CGPointMake(128.0f + 256.0f * (i % 4), 128.0f + 256.0f * (i / 4));
+        STKPXCircle *circle = [STKPXCircle circleWithCenter:center withRadius:120.0f];
+        STKPXStroke *stroke = [[STKPXStroke alloc] initWithStrokeWidth:8.0f];
+        STKPXRadialGradient *gradient = [[STKPXRadialGradient alloc] init];
+
+        [gradient addColor:[UIColor whiteColor]];
+        [gradient addColor:[UIColor colorWithHue:i / 16.0f saturation:1.0f brightness:1.0f alpha:1.0f]];
+        stroke.color = [STKPXSolidPaint paintWithColor:[UIColor blackColor]];
+        circle.fill = gradient;
+        circle.stroke = stroke;
+
+        [scene addShape:circle];
+    }
+
+    return scene;
+}
+
+- (void)testRasterBackendThreads
+{
+    STKPXShapeGroup *scene = [self rasterScene];
+    CGSize size = CGSizeMake(1024.0f, 1024.0f);
+
+    [RECORDER measure:@"raster.coregraphics" iterations:5 items:1 block:^{
+        UIGraphicsBeginImageContextWithOptions(size, NO, 1.0f);
+        [scene render:UIGraphicsGetCurrentContext()];
+        UIGraphicsEndImageContext();
+    }];
+
+    STKPXRasterSetThreadCount(1);
+
+    STKBenchmarkSample *serial = [RECORDER measure:@"raster.one_thread" iterations:5 items:1 block:^{
+        [scene renderWithBackend:[[STKPXRasterBackend alloc] initWithSize:size scale:1.0f]];
+    }];
+
+    STKPXRasterSetThreadCount(0);
+
+    STKBenchmarkSample *parallel = [RECORDER measure:@"raster.all_threads" iterations:5 items:1 block:^{
+        [scene renderWithBackend:[[STKPXRasterBackend alloc] initWithSize:size scale:1.0f]];
+    }];
+
+    parallel.metrics[@"cpus"] = @([NSProcessInfo processInfo].activeProcessorCount);
+    parallel.metrics[@"speedup"] = @(serial.meanMilliseconds / MAX(parallel.meanMilliseconds, 0.001));
+}
+
+#pragma mark - Path cache
+
+- (void)testPathCacheSharesGeometryAcrossOrigins
+{
+    STKPXPathCache *cache = [STKPXPathCache sharedInstance];
+    STKPXRectangle *first = [[STKPXRectangle alloc] initWithRect:CGRectMake(0.0f, 0.0f, 120.0f, 44.0f)];
+    STKPXRectangle *second = [[STKPXRectangle alloc] initWithRect:CGRectMake(10.0f, 20.0f, 120.0f, 44.0f)];
+
+    [first setCornerRadius:8.0f];
+    [second setCornerRadius:8.0f];
+
+    [cache removeAllPaths];
+    [cache resetCounters];
+
+    XCTAssertTrue(CGRectEqualToRect(CGPathGetBoundingBox(first.path), first.bounds));
+    XCTAssertTrue(CGRectEqualToRect(CGPathGetBoundingBox(second.path), second.bounds));
+    XCTAssertEqual(cache.buildCount, 1);
+    XCTAssertEqual(cache.buildsAvoided, 1);
+
+    // the second path is the first one moved to its origin
+    CGAffineTransform translation = CGAffineTransformMakeTranslation(10.0f, 20.0f);
+    CGPathRef expected = CGPathCreateCopyByTransformingPath(first.path, &translation);
+
+    XCTAssertTrue(CGPathEqualToPath(expected, second.path));
+    CGPathRelease(expected);
+
+    // a different radius is different geometry
+    second.radiusTopLeft = CGSizeMake(4.0f, 4.0f);
+
+    XCTAssertTrue(CGRectEqualToRect(CGPathGetBoundingBox(second.path), second.bounds));
+    XCTAssertEqual(cache.buildCount, 2);
+}
+
+- (void)testPathCacheNormalizesCollapsedCorners
+{
+    STKPXPathCache *cache = [STKPXPathCache sharedInstance];
+    STKPXRectangle *square = [[STKPXRectangle alloc] initWithRect:CGRectMake(0.0f, 0.0f, 50.0f, 50.0f)];
+    STKPXRectangle *collapsed = [[STKPXRectangle alloc] initWithRect:CGRectMake(5.0f, 5.0f, 50.0f, 50.0f)];
+    STKPXEllipse *ellipse = [STKPXEllipse ellipseWithCenter:CGPointMake(25.0f, 25.0f) withRadiusX:25.0f withRadiusY:25.0f];
+
+    // a corner with no height is drawn square, so it shares the plain rectangle's path
+    collapsed.radiusTopLeft = CGSizeMake(6.0f, 0.0f);
+
+    [cache removeAllPaths];
+    [cache resetCounters];
+
+    XCTAssertTrue(square.path != NULL);
+    XCTAssertTrue(collapsed.path != NULL);
+    XCTAssertTrue(ellipse.path != NULL);
+    XCTAssertEqual(cache.buildCount, 2);
+    XCTAssertEqual(cache.buildsAvoided, 1);
+}
+
+- (void)testPathCacheBackgroundBuildsAvoided
+{
+    STKPXPathCache *cache = [STKPXPathCache sharedInstance];
+    NSArray *widths = @[ @320.0f, @375.0f, @414.0f, @768.0f ];
+
+    [cache removeAllPaths];
+    [cache resetCounters];
+
+    // many cells of a few sizes, as in a table of single-line rows
+    for (NSUInteger i = 0; i < 100; i++)
+    {
+        CGSize size = CGSizeMake([widths[i % widths.count] floatValue], 44.0f);
+
+        [STKPXCacheManager clearImageCache];
+        XCTAssertNotNil([self contextWithFill:[STKPXSolidPaint paintWithColor:[UIColor whiteColor]] size:size].backgroundImage);
+    }
+
+    XCTAssertEqual(cache.buildCount + cache.buildsAvoided, 100);
+    XCTAssertEqual(cache.buildCount, widths.count);
+}
+
+- (void)testPathCacheRoundedRectangles
+{
+    STKPXPathCache *cache = [STKPXPathCache sharedInstance];
+    NSArray *sizes = cellSizes_;
+    STKPXRectangle *rectangle = [[STKPXRectangle alloc] init];
+
+    [rectangle setCornerRadius:8.0f];
+
+    void (^buildPaths)(void) = ^{
+        for (NSUInteger i = 0; i < 1000; i++)
+        {
+            // the half-stroke inset moves the origin but keeps the geometry of each cell size
+            CGSize size = [sizes[i % 8] CGSizeValue];
+
+            rectangle.bounds = CGRectMake(0.5f, 0.5f + (i % 3), size.width - 1.0f, size.height - 1.0f);
+            CGPathGetBoundingBox(rectangle.path);
+        }
+    };
+
+    cache.enabled = NO;
+    [cache resetCounters];
+
+    STKBenchmarkSample *uncached = [RECORDER measure:@"path.rounded_rect.uncached" iterations:10 items:1000 block:buildPaths];
+
+    uncached.metrics[@"builds"] = @(cache.buildCount);
+
+    cache.enabled = YES;
+    [cache removeAllPaths];
+    [cache resetCounters];
+
+    STKBenchmarkSample *cached = [RECORDER measure:@"path.rounded_rect.cached" iterations:10 items:1000 block:buildPaths];
+
+    cached.metrics[@"builds"] = @(cache.buildCount);
+    cached.metrics[@"builds_avoided"] = @(cache.buildsAvoided);
+
+    XCTAssertEqual(cache.buildCount, 8);
+}
+
+#pragma mark - Arc flattening
+
+static void collectCurveEndPoints(void *info, const CGPathElement *element)
+{
+    NSMutableArray *points = (__bridge NSMutableArray *) info;
+
+    if (element->type == kCGPathElementAddCurveToPoint)
+    {
+        [points addObject:[NSValue valueWithCGPoint:element->points[2]]];
+    }
+}
+
+- (NSArray *)curveEndPointsOfArcWithRadiusX:(CGFloat)a radiusY:(CGFloat)b start:(CGFloat)start end:(CGFloat)end
+{
+    CGMutablePathRef path = CGPathCreateMutable();
+    NSMutableArray *points = [[NSMutableArray alloc] init];
+
+    CGPathMoveToPoint(path, NULL, 0.0f, 0.0f);
+    CGPathAddEllipticalArc(path, NULL, 0.0f, 0.0f, a, b, start, end);
+    CGPathApply(path, (__bridge void *) points, collectCurveEndPoints);
+    CGPathRelease(path);
+
+    return points;
+}
+
+- (void)testArcFlatteningStaysOnEllipse
+{
+    NSArray *ratios = @[ @1.0f, @0.5f, @0.1f, @0.02f ];
+    NSArray *sweeps = @[ @(M_PI_2), @(M_PI), @(2.0 * M_PI), @(-M_PI_2) ];
+
+    for (NSNumber *ratio in ratios)
+    {
+        for (NSNumber *sweep in sweeps)
+        {
+            CGFloat a = 200.0f;
+            CGFloat b = a * ratio.floatValue;
+            CGFloat end = 0.25f + sweep.floatValue;
+            NSArray *points = [self curveEndPointsOfArcWithRadiusX:a radiusY:b start:0.25f end:end];
+
+            XCTAssertTrue(points.count >= 1);
+
+            // every segment ends on the ellipse and the last one ends where the arc does
+            for (NSValue *value in points)
+            {
+                CGPoint point = value.CGPointValue;
+                CGFloat distance = (point.x * point.x) / (a * a) + (point.y * point.y) / (b * b);
+
+                XCTAssertEqualWithAccuracy(distance, 1.0f, 1e-3, @"ratio %@, sweep %@", ratio, sweep);
+            }
+
+            // angles are polar angles, so the last point lies along the end angle's direction
+            CGPoint last = [points.lastObject CGPointValue];
+            CGFloat length = SQRT(last.x * last.x + last.y * last.y);
+
+            XCTAssertEqualWithAccuracy(last.x / length, COS(end), 1e-3, @"ratio %@, sweep %@", ratio, sweep);
+            XCTAssertEqualWithAccuracy(last.y / length, SIN(end), 1e-3, @"ratio %@, sweep %@", ratio, sweep);
+        }
+    }
+}
+
+- (void)testArcFlattening
+{
+    __block NSUInteger segments = 0;
+
+    // the corner, pill and circle arcs of an icon set, at a range of sizes and aspect ratios
+    STKBenchmarkSample *sample = [RECORDER measure:@"path.arc.flatten" iterations:10 items:1000 block:^{
+        segments = 0;
+
+        for (NSUInteger i = 0; i < 1000; i++)
+        {
+            CGFloat a = 2.0f + (i % 50) * 4.0f;
+            CGFloat b = a * (1.0f - (i % 10) * 0.09f);
+            CGFloat start = (i % 4) * M_PI_2;
+            CGFloat sweep = ((i % 3) + 1) * M_PI_2;
+
+            segments += [self curveEndPointsOfArcWithRadiusX:a radiusY:b start:start end:start + sweep].count;
+        }
+    }];
+
+    sample.metrics[@"segments"] = @(segments);
+
+    XCTAssertTrue(segments >= 1000);
+}
+
+#pragma mark - Display lists
+
+- (NSArray *)svgDocuments
+{
+    NSMutableArray *documents = [[NSMutableArray alloc] init];
+    NSArray *paths = [[NSBundle bundleForClass:self.class] pathsForResourcesOfType:@"svg" inDirectory:nil];
+
+    for (NSString *path in [paths sortedArrayUsingSelector:@selector(compare:)])
+    {
+        STKPXShapeDocument *document = [STKPXSVGLoader loadFromURL:[NSURL fileURLWithPath:path]];
+
+        if (document.shape)
+        {
+            document.bounds = CGRectMake(0.0f, 0.0f, 128.0f, 128.0f);
+            [documents addObject:document];
+        }
+    }
+
+    return documents;
+}
+
+- (NSUInteger)differingPixelsOfSurface:(const STKPXRasterSurface *)a surface:(const STKPXRasterSurface *)b
+{
+    NSUInteger count = 0;
+
+    for (int y = 0; y < a->height; y++)
+    {
+        const uint8_t *rowA = a->pixels + y * a->bytesPerRow;
+        const uint8_t *rowB = b->pixels + y * b->bytesPerRow;
+
+        for (int x = 0; x < a->width * 4; x += 4)
+        {
+            for (int c = 0; c < 4; c++)
+            {
+                if (abs(rowA[x + c] - rowB[x + c]) > 2)
+                {
+                    count++;
+                    break;
+                }
+            }
+        }
+    }
+
+    return count;
+}
+
+- (void)testDisplayListMatchesTreeRendering
+{
+    CGSize size = CGSizeMake(128.0f, 128.0f);
+
+    for (STKPXShapeDocument *document in [self svgDocuments])
+    {
+        STKPXRasterBackend *tree = [[STKPXRasterBackend alloc] initWithSize:size scale:1.0f];
+        STKPXRasterBackend *list = [[STKPXRasterBackend alloc] initWithSize:size scale:1.0f];
+
+        document.usesDisplayList = NO;
+        [document renderWithBackend:tree];
+        document.usesDisplayList = YES;
+        [document renderWithBackend:list];
+
+        // pre-multiplied transforms may round differently along antialiased edges
+        XCTAssertLessThanOrEqual([self differingPixelsOfSurface:tree.surface surface:list.surface], 16);
+    }
+}
+
+- (void)testDisplayListCullsAndRebuilds
+{
+    STKPXShapeDocument *document = [[STKPXShapeDocument alloc] init];
+    STKPXShapeGroup *group = [[STKPXShapeGroup alloc] init];
+    STKPXRectangle *rectangle = [[STKPXRectangle alloc] initWithRect:CGRectMake(0.0f, 0.0f, 10.0f, 10.0f)];
+    STKPXCircle *hidden = [STKPXCircle circleWithCenter:CGPointMake(5.0f, 5.0f) withRadius:5.0f];
+
+    rectangle.fill = [STKPXSolidPaint paintWithColor:[UIColor redColor]];
+    hidden.fill = [STKPXSolidPaint paintWithColor:[UIColor greenColor]];
+    hidden.opacity = 0.0f;
+    [group addShape:rectangle];
+    [group addShape:hidden];
+    document.shape = group;
+
+    STKPXDisplayList *list = [[STKPXDisplayList alloc] initWithRenderable:group transform:CGAffineTransformIdentity];
+
+    XCTAssertEqual(list.operationCount, 1);
+    XCTAssertEqual(list.culledCount, 1);
+
+    // changing a shape rebuilds the document's display list
+    STKPXRasterBackend *before = [[STKPXRasterBackend alloc] initWithSize:CGSizeMake(10.0f, 10.0f) scale:1.0f];
+    STKPXRasterBackend *after = [[STKPXRasterBackend alloc] initWithSize:CGSizeMake(10.0f, 10.0f) scale:1.0f];
+
+    [document renderWithBackend:before];
+    rectangle.fill = [STKPXSolidPaint paintWithColor:[UIColor blueColor]];
+    [document renderWithBackend:after];
+
+    const uint8_t *red = before.surface->pixels + 5 * before.surface->bytesPerRow + 5 * 4;
+    const uint8_t *blue = after.surface->pixels + 5 * after.surface->bytesPerRow + 5 * 4;
+
+    XCTAssertEqual(red[0], 255);
+    XCTAssertEqual(red[2], 0);
+    XCTAssertEqual(blue[0], 0);
+    XCTAssertEqual(blue[2], 255);
+}
+
+- (void)testShapeGroupSettersInvalidateDisplayList
+{
+    CountingShapeDocument *document = [[CountingShapeDocument alloc] init];
+    STKPXShapeGroup *group = [[STKPXShapeGroup alloc] init];
+    NSDictionary *setters = @{
+        @"width" : ^{ group.width = 20.0f; },
+        @"height" : ^{ group.height = 20.0f; },
+        @"viewport" : ^{ group.viewport = CGRectMake(0.0f, 0.0f, 5.0f, 5.0f); },
+        @"viewportAlignment" : ^{ group.viewportAlignment = kAlignViewPortXMinYMin; },
+        @"viewportCrop" : ^{ group.viewportCrop = kCropTypeSlice; },
+    };
+
+    document.shape = group;
+
+    for (NSString *name in setters)
+    {
+        void (^setter)(void) = setters[name];
+
+        document.invalidationCount = 0;
+        setter();
+        XCTAssertGreaterThan(document.invalidationCount, 0, @"%@", name);
+
+        // assigning the same value again leaves the list alone
+        document.invalidationCount = 0;
+        setter();
+        XCTAssertEqual(document.invalidationCount, 0, @"%@", name);
+    }
+}
+
+- (void)testViewportChangeRebuildsDisplayList
+{
+    STKPXShapeDocument *document = [[STKPXShapeDocument alloc] init];
+    STKPXShapeGroup *group = [[STKPXShapeGroup alloc] init];
+    STKPXRectangle *rectangle = [[STKPXRectangle alloc] initWithRect:CGRectMake(0.0f, 0.0f, 10.0f, 10.0f)];
+    STKPXRasterBackend *before = [[STKPXRasterBackend alloc] initWithSize:CGSizeMake(20.0f, 20.0f) scale:1.0f];
+    STKPXRasterBackend *after = [[STKPXRasterBackend alloc] initWithSize:CGSizeMake(20.0f, 20.0f) scale:1.0f];
+
+    rectangle.fill = [STKPXSolidPaint paintWithColor:[UIColor redColor]];
+    [group addShape:rectangle];
+    group.width = 20.0f;
+    group.height = 20.0f;
+    group.viewport = CGRectMake(0.0f, 0.0f, 20.0f, 20.0f);
+    document.shape = group;
+
+    [document renderWithBackend:before];
+
+    // zooming into the rectangle's corner has to fill the whole surface
+    group.viewport = CGRectMake(0.0f, 0.0f, 10.0f, 10.0f);
+    [document renderWithBackend:after];
+
+    const uint8_t *beforePixel = before.surface->pixels + 15 * before.surface->bytesPerRow + 15 * 4;
+    const uint8_t *afterPixel = after.surface->pixels + 15 * after.surface->bytesPerRow + 15 * 4;
+
+    XCTAssertEqual(beforePixel[3], 0);
+    XCTAssertEqual(afterPixel[3], 255);
+}
+
+- (void)testClippingPathChangesInvalidateDisplayList
+{
+    CountingShapeDocument *document = [[CountingShapeDocument alloc] init];
+    STKPXRectangle *rectangle = [[STKPXRectangle alloc] initWithRect:CGRectMake(0.0f, 0.0f, 10.0f, 10.0f)];
+    STKPXRectangle *clip = [[STKPXRectangle alloc] initWithRect:CGRectMake(0.0f, 0.0f, 5.0f, 5.0f)];
+    STKPXShapeGroup *clipGroup = [[STKPXShapeGroup alloc] init];
+    STKPXRectangle *clipChild = [[STKPXRectangle alloc] initWithRect:CGRectMake(0.0f, 0.0f, 5.0f, 5.0f)];
+
+    document.shape = rectangle;
+    rectangle.clippingPath = clip;
+
+    // the clip is not part of the tree, yet editing its geometry has to reach the document
+    document.invalidationCount = 0;
+    clip.size = CGSizeMake(8.0f, 8.0f);
+    XCTAssertGreaterThan(document.invalidationCount, 0);
+
+    document.invalidationCount = 0;
+    [clip clearPath];
+    XCTAssertGreaterThan(document.invalidationCount, 0);
+
+    // as does editing the descendants of a clipping group
+    [clipGroup addShape:clipChild];
+    rectangle.clippingPath = clipGroup;
+
+    document.invalidationCount = 0;
+    clipChild.size = CGSizeMake(2.0f, 2.0f);
+    XCTAssertGreaterThan(document.invalidationCount, 0);
+
+    // a clip that was replaced no longer affects the shape
+    document.invalidationCount = 0;
+    clip.size = CGSizeMake(3.0f, 3.0f);
+    XCTAssertEqual(document.invalidationCount, 0);
+}
+
+- (void)testDisplayListReplay
+{
+    NSArray *documents = [self svgDocuments];
+    CGSize size = CGSizeMake(128.0f, 128.0f);
+    __block NSUInteger treeSaves = 0;
+    __block NSUInteger listSaves = 0;
+
+    for (STKPXShapeDocument *document in documents)
+    {
+        document.usesDisplayList = NO;
+    }
+
+    STKBenchmarkSample *tree = [RECORDER measure:@"render.document.tree" iterations:10 items:documents.count block:^{
+        treeSaves = 0;
+
+        for (STKPXShapeDocument *document in documents)
+        {
+            CountingRenderBackend *backend = [[CountingRenderBackend alloc] initWithSize:size];
+
+            [document renderWithBackend:backend];
+            treeSaves += backend.saveCount;
+        }
+    }];
+
+    for (STKPXShapeDocument *document in documents)
+    {
+        document.usesDisplayList = YES;
+    }
+
+    STKBenchmarkSample *list = [RECORDER measure:@"render.document.display_list" iterations:10 items:documents.count block:^{
+        listSaves = 0;
+
+        for (STKPXShapeDocument *document in documents)
+        {
+            CountingRenderBackend *backend = [[CountingRenderBackend alloc] initWithSize:size];
+
+            [document renderWithBackend:backend];
+            listSaves += backend.saveCount;
+        }
+    }];
+
+    tree.metrics[@"state_saves"] = @(treeSaves);
+    list.metrics[@"state_saves"] = @(listSaves);
+
+    XCTAssertTrue(listSaves < treeSaves);
+}
+
+@end
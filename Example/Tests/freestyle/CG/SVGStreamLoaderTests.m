@@ -0,0 +1,325 @@
+//
+//  SVGStreamLoaderTests.m
+//  StylingKit
+//
+
+#import <XCTest/XCTest.h>
+#import "STKPXGraphics.h"
+#import "STKBenchmarkRecorder.h"
+#import "STKPXTransformParser.h"
+
+static STKBenchmarkRecorder *RECORDER;
+
+@interface SVGStreamLoaderTests : XCTestCase
+@end
+
+@implementation SVGStreamLoaderTests
+
++ (void)setUp
+{
+    [super setUp];
+
+    RECORDER = [[STKBenchmarkRecorder alloc] initWithSuiteName:@"SVGStreamLoaderTests"];
+}
+
++ (void)tearDown
+{
+    [RECORDER writeReport];
+    RECORDER = nil;
+
+    [super tearDown];
+}
+
+#pragma mark - Helpers
+
+- (NSArray *)svgPaths
+{
+    NSArray *paths = [[NSBundle bundleForClass:self.class] pathsForResourcesOfType:@"svg" inDirectory:nil];
+
+    return [paths sortedArrayUsingSelector:@selector(compare:)];
+}
+
+- (STKPXRasterBackend *)renderDocument:(STKPXShapeDocument *)document
+{
+    CGRect bounds = ((STKPXShapeGroup *) document.shape).viewport;
+
+    if (CGRectIsEmpty(bounds) || bounds.size.width > 1024.0f || bounds.size.height > 1024.0f)
+    {
+        bounds = CGRectMake(0.0f, 0.0f, 100.0f, 100.0f);
+    }
+
+    STKPXRasterBackend *backend = [[STKPXRasterBackend alloc] initWithSize:bounds.size scale:1.0f];
+
+    [backend concatTransform:CGAffineTransformMakeTranslation(-bounds.origin.x, -bounds.origin.y)];
+    [document renderWithBackend:backend];
+
+    return backend;
+}
+
+- (BOOL)strokeDraws:(id<STKPXStrokeRenderer>)renderer
+{
+    STKPXStroke *stroke = (STKPXStroke *) renderer;
+
+    return stroke != nil && stroke.color != nil && stroke.width > 0.0f;
+}
+
+- (void)assertShape:(id<STKPXRenderable>)actual matchesShape:(id<STKPXRenderable>)expected path:(NSString *)path
+{
+    XCTAssertEqualObjects([(NSObject *) actual class], [(NSObject *) expected class], @"%@", path);
+
+    if ([expected isKindOfClass:[STKPXShape class]])
+    {
+        STKPXShape *a = (STKPXShape *) actual;
+        STKPXShape *e = (STKPXShape *) expected;
+
+        XCTAssertEqualWithAccuracy(a.opacity, e.opacity, 1e-6, @"%@", path);
+        XCTAssertEqual(a.visible, e.visible, @"%@", path);
+        XCTAssertTrue(CGAffineTransformEqualToTransform(a.transform, e.transform), @"%@", path);
+        XCTAssertEqualObjects(a.fill, e.fill, @"%@", path);
+
+        // STKPXSVGLoader gives every shape a stroke, even those that never draw
+        if ([self strokeDraws:e.stroke])
+        {
+            STKPXStroke *as = (STKPXStroke *) a.stroke;
+            STKPXStroke *es = (STKPXStroke *) e.stroke;
+
+            XCTAssertEqualObjects(as.color, es.color, @"%@", path);
+            XCTAssertEqual(as.width, es.width, @"%@", path);
+            XCTAssertEqual(as.type, es.type, @"%@", path);
+            XCTAssertEqual(as.lineCap, es.lineCap, @"%@", path);
+            XCTAssertEqual(as.lineJoin, es.lineJoin, @"%@", path);
+            XCTAssertEqual(as.miterLimit, es.miterLimit, @"%@", path);
+            XCTAssertEqual(as.dashOffset, es.dashOffset, @"%@", path);
+            XCTAssertEqualObjects(as.dashArray, es.dashArray, @"%@", path);
+        }
+        else
+        {
+            XCTAssertFalse([self strokeDraws:a.stroke], @"%@", path);
+        }
+    }
+
+    if ([expected isKindOfClass:[STKPXShapeGroup class]])
+    {
+        STKPXShapeGroup *a = (STKPXShapeGroup *) actual;
+        STKPXShapeGroup *e = (STKPXShapeGroup *) expected;
+
+        XCTAssertTrue(CGRectEqualToRect(a.viewport, e.viewport), @"%@", path);
+        XCTAssertEqual(a.viewportAlignment, e.viewportAlignment, @"%@", path);
+        XCTAssertEqual(a.viewportCrop, e.viewportCrop, @"%@", path);
+        XCTAssertEqual(a.shapeCount, e.shapeCount, @"%@", path);
+
+        for (NSUInteger i = 0; i < MIN(a.shapeCount, e.shapeCount); i++)
+        {
+            [self assertShape:[a shapeAtIndex:i]
+                 matchesShape:[e shapeAtIndex:i]
+                         path:[NSString stringWithFormat:@"%@/%lu", path, (unsigned long) i]];
+        }
+    }
+}
+
+#pragma mark - Conformance Tests
+
+- (void)testMatchesSVGLoaderStructure
+{
+    for (NSString *path in self.svgPaths)
+    {
+        NSURL *URL = [NSURL fileURLWithPath:path];
+        STKPXShapeDocument *expected = [STKPXSVGLoader loadFromURL:URL];
+        STKPXShapeDocument *actual = [STKPXSVGStreamLoader loadFromURL:URL];
+
+        if (expected.shape == nil)
+        {
+            XCTAssertNil(actual.shape, @"%@", path.lastPathComponent);
+            continue;
+        }
+
+        [self assertShape:actual.shape matchesShape:expected.shape path:path.lastPathComponent];
+    }
+}
+
+- (void)testMatchesSVGLoaderPixels
+{
+    NSArray *paths = self.svgPaths;
+
+    XCTAssertTrue(paths.count > 0);
+
+    for (NSString *path in paths)
+    {
+        NSURL *URL = [NSURL fileURLWithPath:path];
+        STKPXShapeDocument *expectedDocument = [STKPXSVGLoader loadFromURL:URL];
+        STKPXShapeDocument *actualDocument = [STKPXSVGStreamLoader loadFromURL:URL];
+
+        if (expectedDocument.shape == nil)
+        {
+            continue;
+        }
+
+        STKPXRasterBackend *expected = [self renderDocument:expectedDocument];
+        STKPXRasterBackend *actual = [self renderDocument:actualDocument];
+
+        XCTAssertEqual(actual.surface->height, expected.surface->height, @"%@", path.lastPathComponent);
+        XCTAssertEqual(memcmp(actual.surface->pixels,
+                              expected.surface->pixels,
+                              expected.surface->bytesPerRow * expected.surface->height), 0,
+                       @"%@ renders differently", path.lastPathComponent);
+    }
+}
+
+#pragma mark - Decoding Tests
+
+- (NSData *)dataForSVG:(NSString *)content
+{
+    NSString *source = [NSString stringWithFormat:@"<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"100\" height=\"100\">%@</svg>", content];
+
+    return [source dataUsingEncoding:NSUTF8StringEncoding];
+}
+
+- (STKPXShape *)firstShapeOfSVG:(NSString *)content
+{
+    STKPXShapeDocument *document = [STKPXSVGStreamLoader loadFromData:[self dataForSVG:content]];
+
+    return (STKPXShape *) [(STKPXShapeGroup *) document.shape shapeAtIndex:0];
+}
+
+- (void)testOnlyCreatesStrokesThatDraw
+{
+    XCTAssertNil([self firstShapeOfSVG:@"<rect width=\"10\" height=\"10\"/>"].stroke);
+    XCTAssertNil([self firstShapeOfSVG:@"<rect width=\"10\" height=\"10\" stroke=\"red\"/>"].stroke);
+    XCTAssertNil([self firstShapeOfSVG:@"<rect width=\"10\" height=\"10\" stroke-width=\"2\"/>"].stroke);
+
+    STKPXStroke *stroke = (STKPXStroke *) [self firstShapeOfSVG:@"<rect width=\"10\" height=\"10\" style=\"stroke: #f00; stroke-width: 2; stroke-linecap: round\"/>"].stroke;
+
+    XCTAssertEqualObjects(stroke.color, [STKPXSolidPaint paintWithColor:[UIColor redColor]]);
+    XCTAssertEqual(stroke.width, 2.0f);
+    XCTAssertEqual(stroke.lineCap, kCGLineCapRound);
+    XCTAssertEqual(stroke.miterLimit, 4.0f);
+}
+
+- (void)testStyleOverridesAttributes
+{
+    STKPXShape *shape = [self firstShapeOfSVG:@"<circle r=\"5\" fill=\"blue\" opacity=\"1\" style=\"fill:#00ff00;opacity:0.5\"/>"];
+
+    XCTAssertEqualObjects(shape.fill, [STKPXSolidPaint paintWithColor:[UIColor colorWithRed:0.0 green:1.0 blue:0.0 alpha:1.0]]);
+    XCTAssertEqualWithAccuracy(shape.opacity, 0.5f, 1e-6);
+}
+
+- (void)testTransformsMatchTransformParser
+{
+    STKPXTransformParser *parser = [[STKPXTransformParser alloc] init];
+
+    for (NSString *transform in @[ @"translate(10,20) scale(2)",
+                                   @"matrix(1 0 0 1 5.5 -6)",
+                                   @"rotate(30 10 10) skewX(15)",
+                                   @"skewY(-20)",
+                                   @"translate(10px, 2em)",
+                                   @"scale(1e1)" ])
+    {
+        NSString *content = [NSString stringWithFormat:@"<rect width=\"10\" height=\"10\" transform=\"%@\"/>", transform];
+        CGAffineTransform expected = [parser parse:transform];
+        CGAffineTransform actual = [self firstShapeOfSVG:content].transform;
+
+        XCTAssertTrue(CGAffineTransformEqualToTransform(actual, expected), @"%@", transform);
+    }
+}
+
+- (void)testUnsupportedElementsAreSkipped
+{
+    STKPXShapeDocument *document = [STKPXSVGStreamLoader loadFromData:[self dataForSVG:@"<desc>x</desc><foo/><rect width=\"1\" height=\"1\"/>"]];
+
+    XCTAssertEqual(((STKPXShapeGroup *) document.shape).shapeCount, 1);
+}
+
+- (void)testTextElementsAreIgnored
+{
+    STKPXShapeDocument *document = [STKPXSVGStreamLoader loadFromData:[self dataForSVG:@"<text x=\"1\" y=\"2\">x</text><rect width=\"1\" height=\"1\"/>"]];
+
+    XCTAssertEqual(((STKPXShapeGroup *) document.shape).shapeCount, 1);
+    XCTAssertTrue([[(STKPXShapeGroup *) document.shape shapeAtIndex:0] isKindOfClass:[STKPXRectangle class]]);
+}
+
+- (void)testLoadsConcurrently
+{
+    NSData *data = [self dataForSVG:@"<g><rect width=\"10\" height=\"10\" fill=\"red\"/><circle r=\"5\"/></g>"];
+    NSUInteger count = 64;
+    __block NSUInteger loaded = 0;
+    NSLock *lock = [[NSLock alloc] init];
+
+    // the first document may well be parsed off the main thread, by several threads at once
+    dispatch_apply(count, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t i) {
+        STKPXShapeDocument *document = [STKPXSVGStreamLoader loadFromData:data];
+        STKPXShapeGroup *group = (STKPXShapeGroup *) [(STKPXShapeGroup *) document.shape shapeAtIndex:0];
+
+        if (group.shapeCount == 2)
+        {
+            [lock lock];
+            loaded++;
+            [lock unlock];
+        }
+    });
+
+    XCTAssertEqual(loaded, count);
+}
+
+#pragma mark - Benchmarks
+
+- (void)testLoadThroughput
+{
+    NSMutableArray *documents = [[NSMutableArray alloc] init];
+
+    for (NSString *path in self.svgPaths)
+    {
+        [documents addObject:[NSData dataWithContentsOfFile:path]];
+    }
+
+    __block NSUInteger xmlStrokes = 0;
+    __block NSUInteger streamStrokes = 0;
+
+    STKBenchmarkSample *xml = [RECORDER measure:@"svg.load.nsxmlparser" iterations:20 items:documents.count block:^{
+        for (NSData *data in documents)
+        {
+            [STKPXSVGLoader loadFromData:data];
+        }
+    }];
+
+    STKBenchmarkSample *stream = [RECORDER measure:@"svg.load.libxml2" iterations:20 items:documents.count block:^{
+        for (NSData *data in documents)
+        {
+            [STKPXSVGStreamLoader loadFromData:data];
+        }
+    }];
+
+    for (NSData *data in documents)
+    {
+        xmlStrokes += [self strokeCountOfRenderable:[STKPXSVGLoader loadFromData:data].shape];
+        streamStrokes += [self strokeCountOfRenderable:[STKPXSVGStreamLoader loadFromData:data].shape];
+    }
+
+    xml.metrics[@"strokes"] = @(xmlStrokes);
+    stream.metrics[@"strokes"] = @(streamStrokes);
+
+    XCTAssertTrue(streamStrokes <= xmlStrokes);
+}
+
+- (NSUInteger)strokeCountOfRenderable:(id<STKPXRenderable>)renderable
+{
+    NSUInteger count = 0;
+
+    if ([renderable isKindOfClass:[STKPXShape class]] && ((STKPXShape *) renderable).stroke)
+    {
+        count++;
+    }
+
+    if ([renderable isKindOfClass:[STKPXShapeGroup class]])
+    {
+        STKPXShapeGroup *group = (STKPXShapeGroup *) renderable;
+
+        for (NSUInteger i = 0; i < group.shapeCount; i++)
+        {
+            count += [self strokeCountOfRenderable:[group shapeAtIndex:i]];
+        }
+    }
+
+    return count;
+}
+
+@end
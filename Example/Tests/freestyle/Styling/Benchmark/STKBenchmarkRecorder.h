@@ -0,0 +1,99 @@
+/****************************************************************************
+ *
+ * Copyright 2015-present StylingKit Development Team. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ****************************************************************************/
+//
+//  STKBenchmarkRecorder.h
+//  StylingKit
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ *  Name of the environment variable pointing to the directory benchmark results are written to. When it is not set,
+ *  results go to NSTemporaryDirectory()
+ */
+extern NSString *const STKBenchmarkOutputDirectoryEnvironmentKey;
+
+/**
+ *  The result of a single measurement
+ */
+@interface STKBenchmarkSample : NSObject
+
+@property (nonatomic, readonly) NSString *name;
+@property (nonatomic, readonly) NSUInteger iterations;
+@property (nonatomic, readonly) double totalMilliseconds;
+@property (nonatomic, readonly) uint64_t allocations;
+@property (nonatomic, readonly) int64_t heapBytes;
+
+/**
+ *  Number of items processed per iteration. Used to derive per-item timings. Defaults to 1
+ */
+@property (nonatomic) NSUInteger itemsPerIteration;
+
+/**
+ *  Extra values that are reported along with the timings
+ */
+@property (nonatomic, readonly) NSMutableDictionary *metrics;
+
+@property (nonatomic, readonly) double meanMilliseconds;
+@property (nonatomic, readonly) double microsecondsPerItem;
+
+@end
+
+/**
+ *  STKBenchmarkRecorder measures blocks of code for wall time, heap allocation count and heap growth, and writes all
+ *  samples of a suite as a single JSON document so results can be tracked between runs.
+ */
+@interface STKBenchmarkRecorder : NSObject
+
+@property (nonatomic, readonly) NSString *suiteName;
+@property (nonatomic, readonly) NSArray *samples;
+
+- (instancetype)init NS_UNAVAILABLE;
+- (instancetype)initWithSuiteName:(NSString *)suiteName NS_DESIGNATED_INITIALIZER;
+
+/**
+ *  Run a block the specified number of times and record a sample for it. One untimed warm-up run is made first.
+ *
+ *  @param name The name of the sample
+ *  @param iterations The number of timed runs
+ *  @param items The number of items processed by each run
+ *  @param block The code to measure
+ */
+- (STKBenchmarkSample *)measure:(NSString *)name
+                     iterations:(NSUInteger)iterations
+                          items:(NSUInteger)items
+                          block:(void (^)(void))block;
+
+/**
+ *  Count heap allocations made while running a block. Returns 0 where allocation tracking is not available
+ *
+ *  @param block The code to inspect
+ */
++ (uint64_t)allocationsDuringBlock:(void (^)(void))block;
+
+/**
+ *  Return a JSON-compatible dictionary describing all samples
+ */
+- (NSDictionary *)report;
+
+/**
+ *  Write the report as JSON to the output directory. Returns the path written, or nil on failure
+ */
+- (NSString *)writeReport;
+
+@end
@@ -0,0 +1,273 @@
+/****************************************************************************
+ *
+ * Copyright 2015-present StylingKit Development Team. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ****************************************************************************/
+//
+//  STKBenchmarkRecorder.m
+//  StylingKit
+//
+
+#import "STKBenchmarkRecorder.h"
+
+#import <mach/mach_time.h>
+#import <malloc/malloc.h>
+#import <stdatomic.h>
+
+NSString *const STKBenchmarkOutputDirectoryEnvironmentKey = @"STK_BENCHMARK_OUTPUT_DIR";
+
+// libmalloc calls this hook for every allocation when it is set. It is what stack logging uses.
+typedef void (malloc_logger_t)(uint32_t type, uintptr_t arg1, uintptr_t arg2, uintptr_t arg3, uintptr_t result, uint32_t num_hot_frames_to_skip);
+extern malloc_logger_t *malloc_logger;
+
+#define STK_MALLOC_LOG_TYPE_ALLOCATE 2
+
+static _Atomic uint64_t ALLOCATION_COUNT;
+
+static void STKCountingMallocLogger(uint32_t type, uintptr_t arg1, uintptr_t arg2, uintptr_t arg3, uintptr_t result, uint32_t num_hot_frames_to_skip)
+{
+    if (type & STK_MALLOC_LOG_TYPE_ALLOCATE)
+    {
+        atomic_fetch_add_explicit(&ALLOCATION_COUNT, 1, memory_order_relaxed);
+    }
+}
+
+static double STKMillisecondsFromMachTime(uint64_t elapsed)
+{
+    static mach_timebase_info_data_t timebase;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        mach_timebase_info(&timebase);
+    });
+
+    return (double)elapsed * timebase.numer / timebase.denom / 1e6;
+}
+
+static int64_t STKHeapBytesInUse()
+{
+    malloc_statistics_t stats;
+
+    malloc_zone_statistics(NULL, &stats);
+
+    return (int64_t)stats.size_in_use;
+}
+
+#pragma mark - STKBenchmarkSample
+
+@interface STKBenchmarkSample ()
+@property (nonatomic, readwrite) NSString *name;
+@property (nonatomic, readwrite) NSUInteger iterations;
+@property (nonatomic, readwrite) double totalMilliseconds;
+@property (nonatomic, readwrite) uint64_t allocations;
+@property (nonatomic, readwrite) int64_t heapBytes;
+@end
+
+@implementation STKBenchmarkSample
+
+- (instancetype)init
+{
+    if (self = [super init])
+    {
+        _itemsPerIteration = 1;
+        _metrics = [[NSMutableDictionary alloc] init];
+    }
+
+    return self;
+}
+
+- (double)meanMilliseconds
+{
+    return (_iterations > 0) ? _totalMilliseconds / _iterations : 0.0;
+}
+
+- (double)microsecondsPerItem
+{
+    return (_itemsPerIteration > 0) ? self.meanMilliseconds * 1000.0 / _itemsPerIteration : 0.0;
+}
+
+- (NSDictionary *)dictionaryValue
+{
+    NSMutableDictionary *result = [@{
+        @"name" : _name,
+        @"iterations" : @(_iterations),
+        @"items" : @(_itemsPerIteration),
+        @"total_ms" : @(_totalMilliseconds),
+        @"mean_ms" : @(self.meanMilliseconds),
+        @"per_item_us" : @(self.microsecondsPerItem),
+        @"allocations_per_iteration" : @((_iterations > 0) ? _allocations / _iterations : 0),
+        @"heap_growth_bytes" : @(_heapBytes),
+    } mutableCopy];
+
+    if (_metrics.count > 0)
+    {
+        result[@"metrics"] = [_metrics copy];
+    }
+
+    return result;
+}
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"%@: %.3f ms/iter, %.3f us/item, %llu allocs/iter, %lld heap bytes",
+            _name, self.meanMilliseconds, self.microsecondsPerItem,
+            (unsigned long long) ((_iterations > 0) ? _allocations / _iterations : 0), (long long) _heapBytes];
+}
+
+@end
+
+#pragma mark - STKBenchmarkRecorder
+
+@implementation STKBenchmarkRecorder
+{
+    NSMutableArray *samples_;
+}
+
+- (instancetype)initWithSuiteName:(NSString *)suiteName
+{
+    if (self = [super init])
+    {
+        _suiteName = [suiteName copy];
+        samples_ = [[NSMutableArray alloc] init];
+    }
+
+    return self;
+}
+
+- (NSArray *)samples
+{
+    return samples_;
+}
+
++ (uint64_t)allocationsDuringBlock:(void (^)(void))block
+{
+    if (block == nil)
+    {
+        return 0;
+    }
+
+    // NOTE: the hook is process wide, so allocations made by other threads at the same time are counted too
+    malloc_logger_t *previousLogger = malloc_logger;
+    uint64_t start = atomic_load(&ALLOCATION_COUNT);
+
+    malloc_logger = STKCountingMallocLogger;
+    block();
+    malloc_logger = previousLogger;
+
+    return atomic_load(&ALLOCATION_COUNT) - start;
+}
+
+- (STKBenchmarkSample *)measure:(NSString *)name
+                     iterations:(NSUInteger)iterations
+                          items:(NSUInteger)items
+                          block:(void (^)(void))block
+{
+    STKBenchmarkSample *sample = [[STKBenchmarkSample alloc] init];
+
+    sample.name = name;
+    sample.iterations = MAX(iterations, 1);
+    sample.itemsPerIteration = MAX(items, 1);
+
+    // warm up caches and lazily created singletons so they don't skew the first iteration
+    @autoreleasepool
+    {
+        block();
+    }
+
+    // time without the allocation hook installed, since the hook itself costs time
+    uint64_t elapsed = 0;
+
+    for (NSUInteger i = 0; i < sample.iterations; i++)
+    {
+        @autoreleasepool
+        {
+            uint64_t start = mach_absolute_time();
+
+            block();
+
+            elapsed += mach_absolute_time() - start;
+        }
+    }
+
+    sample.totalMilliseconds = STKMillisecondsFromMachTime(elapsed);
+
+    // count allocations and heap growth on a separate pass
+    int64_t heapBefore = STKHeapBytesInUse();
+
+    sample.allocations = [STKBenchmarkRecorder allocationsDuringBlock:^{
+        for (NSUInteger i = 0; i < sample.iterations; i++)
+        {
+            @autoreleasepool
+            {
+                block();
+            }
+        }
+    }];
+
+    sample.heapBytes = STKHeapBytesInUse() - heapBefore;
+
+    [samples_ addObject:sample];
+
+    NSLog(@"[%@] %@", _suiteName, sample);
+
+    return sample;
+}
+
+- (NSDictionary *)report
+{
+    NSMutableArray *samples = [[NSMutableArray alloc] initWithCapacity:samples_.count];
+
+    for (STKBenchmarkSample *sample in samples_)
+    {
+        [samples addObject:[sample dictionaryValue]];
+    }
+
+    NSProcessInfo *processInfo = [NSProcessInfo processInfo];
+
+    return @{
+        @"suite" : _suiteName,
+        @"timestamp" : @([NSDate date].timeIntervalSince1970),
+        @"os" : processInfo.operatingSystemVersionString,
+        @"processors" : @(processInfo.activeProcessorCount),
+        @"samples" : samples,
+    };
+}
+
+- (NSString *)writeReport
+{
+    NSString *directory = [NSProcessInfo processInfo].environment[STKBenchmarkOutputDirectoryEnvironmentKey];
+
+    if (directory.length == 0)
+    {
+        directory = NSTemporaryDirectory();
+    }
+
+    NSError *error = nil;
+    NSData *data = [NSJSONSerialization dataWithJSONObject:[self report] options:NSJSONWritingPrettyPrinted error:&error];
+    NSString *path = [directory stringByAppendingPathComponent:[_suiteName stringByAppendingPathExtension:@"json"]];
+
+    [[NSFileManager defaultManager] createDirectoryAtPath:directory withIntermediateDirectories:YES attributes:nil error:NULL];
+
+    if (data == nil || ![data writeToFile:path options:NSDataWritingAtomic error:&error])
+    {
+        NSLog(@"[%@] Unable to write benchmark report: %@", _suiteName, error);
+        return nil;
+    }
+
+    NSLog(@"[%@] Benchmark report written to %@", _suiteName, path);
+
+    return path;
+}
+
+@end
@@ -0,0 +1,127 @@
+/****************************************************************************
+ *
+ * Copyright 2015-present StylingKit Development Team. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ****************************************************************************/
+//
+//  STKBenchmarkTreeBuilder.h
+//  StylingKit
+//
+
+#import <Foundation/Foundation.h>
+#import "PXDOMElement.h"
+
+/**
+ *  Selector families used when generating synthetic stylesheets. Each family exercises a different lookup path of
+ *  STKPXMediaGroup.
+ */
+typedef NS_OPTIONS(NSUInteger, STKBenchmarkSelectorKind)
+{
+    STKBenchmarkSelectorKindElement         = 1 << 0, // button
+    STKBenchmarkSelectorKindId              = 1 << 1, // #node-12
+    STKBenchmarkSelectorKindClass           = 1 << 2, // .class-3
+    STKBenchmarkSelectorKindElementAndId    = 1 << 3, // button#node-12
+    STKBenchmarkSelectorKindElementAndClass = 1 << 4, // button.class-3
+    STKBenchmarkSelectorKindUncategorized   = 1 << 5, // [name], :first-child, *
+    STKBenchmarkSelectorKindCombinator      = 1 << 6, // view > button .class-3
+
+    STKBenchmarkSelectorKindAll = 0x7F
+};
+
+/**
+ *  An element reporting pseudo-class states, the way controls do
+ */
+@interface STKBenchmarkStatefulElement : PXDOMElement
+
+@property (nonatomic, copy) NSArray *supportedPseudoClasses;
+@property (nonatomic, copy) NSString *defaultPseudoClass;
+
+@end
+
+/**
+ *  STKBenchmarkTreeBuilder generates deterministic synthetic styleable trees and stylesheets so that selector
+ *  matching and cascade can be measured without a running application. Trees are made of PXDOMElement instances,
+ *  which only depend on Foundation.
+ */
+@interface STKBenchmarkTreeBuilder : NSObject
+
+/**
+ *  Number of levels below the root. Defaults to 4
+ */
+@property (nonatomic) NSUInteger depth;
+
+/**
+ *  Number of children per element. Defaults to 4
+ */
+@property (nonatomic) NSUInteger fanOut;
+
+/**
+ *  Element names to pick from when creating elements
+ */
+@property (nonatomic, copy) NSArray *elementNames;
+
+/**
+ *  Number of distinct style classes in the generated tree and stylesheets. Defaults to 32
+ */
+@property (nonatomic) NSUInteger classCount;
+
+/**
+ *  Maximum number of style classes assigned to each element. Defaults to 2
+ */
+@property (nonatomic) NSUInteger classesPerElement;
+
+/**
+ *  Exponent used to skew the class distribution. 0 picks classes uniformly, larger values favor low class indexes
+ *  the way real themes reuse a handful of classes heavily. Defaults to 1
+ */
+@property (nonatomic) double classSkew;
+
+/**
+ *  Probability, between 0 and 1, that an element receives a style id. Defaults to 0.25
+ */
+@property (nonatomic) double idRatio;
+
+/**
+ *  Pseudo-class states supported by every element of the tree, the first one being the default state. Generated
+ *  selectors get one of these states half of the time. Defaults to none
+ */
+@property (nonatomic, copy) NSArray *stateNames;
+
+/**
+ *  Seed for the pseudo-random generator. Equal seeds produce identical trees and stylesheets
+ */
+@property (nonatomic) uint32_t seed;
+
+/**
+ *  Build a new tree using the current settings
+ */
+- (PXDOMElement *)buildTree;
+
+/**
+ *  Return the root and all of its descendants in document order
+ *
+ *  @param root The root of the tree to flatten
+ */
++ (NSArray *)flattenTree:(PXDOMElement *)root;
+
+/**
+ *  Generate stylesheet source with the specified number of rule sets
+ *
+ *  @param ruleCount The number of rule sets to emit
+ *  @param kinds A mask of the selector families to use
+ */
+- (NSString *)stylesheetSourceWithRuleCount:(NSUInteger)ruleCount selectorKinds:(STKBenchmarkSelectorKind)kinds;
+
+@end
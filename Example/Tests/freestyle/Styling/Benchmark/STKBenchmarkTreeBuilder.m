@@ -0,0 +1,277 @@
+/****************************************************************************
+ *
+ * Copyright 2015-present StylingKit Development Team. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ****************************************************************************/
+//
+//  STKBenchmarkTreeBuilder.m
+//  StylingKit
+//
+
+#import "STKBenchmarkTreeBuilder.h"
+
+@implementation STKBenchmarkStatefulElement
+@end
+
+@implementation STKBenchmarkTreeBuilder
+{
+    uint32_t state_;
+    NSUInteger elementCount_;
+}
+
+#pragma mark - Initializers
+
+- (instancetype)init
+{
+    if (self = [super init])
+    {
+        _depth = 4;
+        _fanOut = 4;
+        _elementNames = @[ @"view", @"button", @"label", @"image-view", @"text-field", @"table-view-cell" ];
+        _classCount = 32;
+        _classesPerElement = 2;
+        _classSkew = 1.0;
+        _idRatio = 0.25;
+        _seed = 1;
+    }
+
+    return self;
+}
+
+#pragma mark - Random numbers
+
+- (void)resetRandom
+{
+    state_ = (_seed != 0) ? _seed : 1;
+}
+
+- (uint32_t)nextRandom
+{
+    // xorshift32: fast, deterministic and good enough for picking names
+    state_ ^= state_ << 13;
+    state_ ^= state_ >> 17;
+    state_ ^= state_ << 5;
+
+    return state_;
+}
+
+- (double)nextUnit
+{
+    return (double)[self nextRandom] / (double)UINT32_MAX;
+}
+
+- (NSUInteger)nextIndexBelow:(NSUInteger)count
+{
+    return (count > 0) ? [self nextRandom] % count : 0;
+}
+
+- (NSUInteger)nextClassIndex
+{
+    double unit = [self nextUnit];
+
+    if (_classSkew > 0.0)
+    {
+        unit = pow(unit, 1.0 + _classSkew);
+    }
+
+    return MIN((NSUInteger)(unit * _classCount), _classCount - 1);
+}
+
+#pragma mark - Trees
+
+- (PXDOMElement *)buildTree
+{
+    [self resetRandom];
+    elementCount_ = 0;
+
+    return [self elementAtLevel:0];
+}
+
+- (PXDOMElement *)elementAtLevel:(NSUInteger)level
+{
+    NSString *name = (level == 0) ? @"window" : _elementNames[[self nextIndexBelow:_elementNames.count]];
+    NSUInteger index = elementCount_++;
+    PXDOMElement *element;
+
+    if (_stateNames.count > 0)
+    {
+        STKBenchmarkStatefulElement *statefulElement = [[STKBenchmarkStatefulElement alloc] initWithName:name];
+
+        statefulElement.supportedPseudoClasses = _stateNames;
+        statefulElement.defaultPseudoClass = _stateNames.firstObject;
+        element = statefulElement;
+    }
+    else
+    {
+        element = [[PXDOMElement alloc] initWithName:name];
+    }
+
+    if (level > 0 && [self nextUnit] < _idRatio)
+    {
+        [element setAttributeValue:[NSString stringWithFormat:@"node-%lu", (unsigned long) index] forName:@"id"];
+    }
+
+    NSUInteger classes = (_classCount > 0) ? [self nextIndexBelow:_classesPerElement + 1] : 0;
+
+    if (classes > 0)
+    {
+        NSMutableOrderedSet *names = [[NSMutableOrderedSet alloc] initWithCapacity:classes];
+
+        for (NSUInteger i = 0; i < classes; i++)
+        {
+            [names addObject:[NSString stringWithFormat:@"class-%lu", (unsigned long) [self nextClassIndex]]];
+        }
+
+        [element setAttributeValue:[names.array componentsJoinedByString:@" "] forName:@"class"];
+    }
+
+    if (level < _depth)
+    {
+        for (NSUInteger i = 0; i < _fanOut; i++)
+        {
+            [element addChild:[self elementAtLevel:level + 1]];
+        }
+    }
+
+    return element;
+}
+
++ (NSArray *)flattenTree:(PXDOMElement *)root
+{
+    NSMutableArray *result = [[NSMutableArray alloc] init];
+    NSMutableArray *stack = [[NSMutableArray alloc] init];
+
+    if (root)
+    {
+        [stack addObject:root];
+    }
+
+    while (stack.count > 0)
+    {
+        PXDOMElement *current = stack.lastObject;
+
+        [stack removeLastObject];
+        [result addObject:current];
+
+        // push in reverse so children come out in document order
+        for (id child in current.children.reverseObjectEnumerator)
+        {
+            if ([child isKindOfClass:[PXDOMElement class]])
+            {
+                [stack addObject:child];
+            }
+        }
+    }
+
+    return result;
+}
+
+#pragma mark - Stylesheets
+
+- (NSString *)selectorOfKind:(STKBenchmarkSelectorKind)kind
+{
+    NSString *element = _elementNames[[self nextIndexBelow:_elementNames.count]];
+    NSString *styleClass = [NSString stringWithFormat:@"class-%lu", (unsigned long) [self nextClassIndex]];
+    NSString *styleId = [NSString stringWithFormat:@"node-%lu", (unsigned long) [self nextIndexBelow:MAX(elementCount_, 64)]];
+
+    switch (kind)
+    {
+        case STKBenchmarkSelectorKindElement:
+            return element;
+
+        case STKBenchmarkSelectorKindId:
+            return [@"#" stringByAppendingString:styleId];
+
+        case STKBenchmarkSelectorKindClass:
+            return [@"." stringByAppendingString:styleClass];
+
+        case STKBenchmarkSelectorKindElementAndId:
+            return [NSString stringWithFormat:@"%@#%@", element, styleId];
+
+        case STKBenchmarkSelectorKindElementAndClass:
+            return [NSString stringWithFormat:@"%@.%@", element, styleClass];
+
+        case STKBenchmarkSelectorKindUncategorized:
+        {
+            switch ([self nextIndexBelow:4])
+            {
+                case 0: return @"[class]";
+                case 1: return @":first-child";
+                case 2: return [NSString stringWithFormat:@"[id^=\"node-%lu\"]", (unsigned long) [self nextIndexBelow:10]];
+                default: return @"*";
+            }
+        }
+
+        case STKBenchmarkSelectorKindCombinator:
+        default:
+        {
+            NSString *parent = _elementNames[[self nextIndexBelow:_elementNames.count]];
+
+            return ([self nextIndexBelow:2] == 0)
+                ? [NSString stringWithFormat:@"%@ > %@", parent, element]
+                : [NSString stringWithFormat:@"%@ .%@", parent, styleClass];
+        }
+    }
+}
+
+- (NSString *)stylesheetSourceWithRuleCount:(NSUInteger)ruleCount selectorKinds:(STKBenchmarkSelectorKind)kinds
+{
+    // make sure ids line up with the ones a tree built with the same settings would use
+    if (elementCount_ == 0)
+    {
+        [self buildTree];
+    }
+
+    [self resetRandom];
+
+    NSMutableArray *enabledKinds = [[NSMutableArray alloc] init];
+
+    for (NSUInteger bit = 0; bit < 7; bit++)
+    {
+        if (kinds & (1 << bit))
+        {
+            [enabledKinds addObject:@(1 << bit)];
+        }
+    }
+
+    if (enabledKinds.count == 0)
+    {
+        return @"";
+    }
+
+    NSMutableString *source = [[NSMutableString alloc] initWithCapacity:ruleCount * 96];
+
+    for (NSUInteger i = 0; i < ruleCount; i++)
+    {
+        STKBenchmarkSelectorKind kind = [enabledKinds[[self nextIndexBelow:enabledKinds.count]] unsignedIntegerValue];
+
+        NSString *selector = [self selectorOfKind:kind];
+
+        if (_stateNames.count > 0 && [self nextIndexBelow:2] == 0)
+        {
+            selector = [selector stringByAppendingFormat:@":%@", _stateNames[[self nextIndexBelow:_stateNames.count]]];
+        }
+
+        [source appendFormat:@"%@ {\n", selector];
+        [source appendFormat:@"    color: #%06x;\n", [self nextRandom] & 0xFFFFFF];
+        [source appendFormat:@"    opacity: %.2f;\n", [self nextUnit]];
+        [source appendFormat:@"    border-radius: %lupx;\n", (unsigned long) [self nextIndexBelow:12]];
+        [source appendString:@"}\n"];
+    }
+
+    return source;
+}
+
+@end
@@ -0,0 +1,464 @@
+//
+//  DeclarationValueCacheTests.m
+//  StylingKit
+//
+
+#import <XCTest/XCTest.h>
+#import "STKPXDeclaration.h"
+#import "STKPXValueParser.h"
+#import "STKPXTransformParser.h"
+#import "STKPXAnimationInfo.h"
+#import "STKPXShadow.h"
+#import "STKPXShadowGroup.h"
+#import "STKPXBorderInfo.h"
+#import "STKPXOffsets.h"
+#import "STKPXDimension.h"
+#import "STKPXStylesheet.h"
+#import "STKPXStylesheet-Private.h"
+#import "STKPXStylesheetParser.h"
+#import "STKPXRuleSet.h"
+#import "STKBenchmarkRecorder.h"
+
+typedef id (^DeclarationAccessor)(STKPXDeclaration *declaration);
+typedef id (^DeclarationReference)(STKPXValueParser *parser, NSArray *lexemes);
+
+static STKBenchmarkRecorder *RECORDER;
+
+@interface DeclarationValueCacheTests : XCTestCase
+@end
+
+@implementation DeclarationValueCacheTests
+
++ (void)setUp
+{
+    [super setUp];
+
+    RECORDER = [[STKBenchmarkRecorder alloc] initWithSuiteName:@"DeclarationValueCacheTests"];
+}
+
++ (void)tearDown
+{
+    [RECORDER writeReport];
+    RECORDER = nil;
+
+    [super tearDown];
+}
+
+#pragma mark - Helpers
+
+- (id)fingerprintOfValue:(id)value
+{
+    if (value == nil)
+    {
+        return [NSNull null];
+    }
+
+    if ([value isKindOfClass:[NSArray class]])
+    {
+        NSMutableArray *result = [NSMutableArray array];
+
+        for (id item in value)
+        {
+            [result addObject:[self fingerprintOfValue:item]];
+        }
+
+        return result;
+    }
+
+    NSArray *keys = nil;
+
+    if ([value isKindOfClass:[STKPXAnimationInfo class]])
+    {
+        keys = @[ @"animationName", @"animationDuration", @"animationTimingFunction", @"animationIterationCount",
+                  @"animationDirection", @"animationPlayState", @"animationDelay", @"animationFillMode" ];
+    }
+    else if ([value isKindOfClass:[STKPXShadowGroup class]])
+    {
+        return [self fingerprintOfValue:((STKPXShadowGroup *) value).shadows];
+    }
+    else if ([value isKindOfClass:[STKPXShadow class]])
+    {
+        keys = @[ @"inset", @"horizontalOffset", @"verticalOffset", @"blurDistance", @"spreadDistance", @"color", @"blendMode" ];
+    }
+    else if ([value isKindOfClass:[STKPXBorderInfo class]])
+    {
+        keys = @[ @"paint", @"style", @"width" ];
+    }
+    else if ([value isKindOfClass:[STKPXOffsets class]])
+    {
+        keys = @[ @"top", @"right", @"bottom", @"left" ];
+    }
+    else if ([value isKindOfClass:[STKPXDimension class]])
+    {
+        keys = @[ @"number", @"dimension" ];
+    }
+
+    return (keys) ? [value dictionaryWithValuesForKeys:keys] : value;
+}
+
+- (void)assertAccessor:(NSString *)name
+                source:(NSString *)source
+                shared:(BOOL)shared
+              accessor:(DeclarationAccessor)accessor
+             reference:(DeclarationReference)reference
+{
+    STKPXDeclaration *declaration = [[STKPXDeclaration alloc] initWithName:@"test" value:source];
+    NSArray *lexemes = [STKPXValueParser lexemesForSource:source];
+    id expected = [self fingerprintOfValue:reference([[STKPXValueParser alloc] init], lexemes)];
+
+    id uncached = accessor(declaration);
+    id cached = accessor(declaration);
+
+    XCTAssertEqualObjects([self fingerprintOfValue:uncached], expected, @"%@: %@", name, source);
+    XCTAssertEqualObjects([self fingerprintOfValue:cached], expected, @"%@: %@", name, source);
+
+    if (shared)
+    {
+        XCTAssertTrue(cached == uncached, @"%@ was parsed twice", name);
+    }
+
+    // reading other kinds of values must not evict this one
+    (void) declaration.stringValue;
+    (void) declaration.floatValue;
+    (void) declaration.colorValue;
+
+    id afterOtherKinds = accessor(declaration);
+
+    XCTAssertEqualObjects([self fingerprintOfValue:afterOtherKinds], expected, @"%@: %@", name, source);
+
+    if (shared)
+    {
+        XCTAssertTrue(afterOtherKinds == uncached, @"%@ was evicted by another kind", name);
+    }
+}
+
+#pragma mark - Parity Tests
+
+- (void)testObjectAccessorsMatchParser
+{
+    [self assertAccessor:@"colorValue" source:@"#336699" shared:YES
+                accessor:^id(STKPXDeclaration *d) { return d.colorValue; }
+               reference:^id(STKPXValueParser *p, NSArray *l) { return [p parseColor:l]; }];
+
+    [self assertAccessor:@"paintValue" source:@"linear-gradient(red, blue)" shared:YES
+                accessor:^id(STKPXDeclaration *d) { return d.paintValue; }
+               reference:^id(STKPXValueParser *p, NSArray *l) { return [p parsePaint:l]; }];
+
+    [self assertAccessor:@"paintList" source:@"red green blue yellow" shared:YES
+                accessor:^id(STKPXDeclaration *d) { return d.paintList; }
+               reference:^id(STKPXValueParser *p, NSArray *l) { return [p parsePaints:l]; }];
+
+    [self assertAccessor:@"borderValue" source:@"2px solid red" shared:YES
+                accessor:^id(STKPXDeclaration *d) { return d.borderValue; }
+               reference:^id(STKPXValueParser *p, NSArray *l) { return [p parseBorder:l]; }];
+
+    [self assertAccessor:@"borderRadiiList" source:@"5px 10px / 3px" shared:YES
+                accessor:^id(STKPXDeclaration *d) { return d.borderRadiiList; }
+               reference:^id(STKPXValueParser *p, NSArray *l) { return [p parseBorderRadiusList:l]; }];
+
+    [self assertAccessor:@"borderStyleList" source:@"solid dashed none dotted" shared:YES
+                accessor:^id(STKPXDeclaration *d) { return d.borderStyleList; }
+               reference:^id(STKPXValueParser *p, NSArray *l) { return [p parseBorderStyleList:l]; }];
+
+    [self assertAccessor:@"offsetsValue" source:@"1px 2px 3px 4px" shared:YES
+                accessor:^id(STKPXDeclaration *d) { return d.offsetsValue; }
+               reference:^id(STKPXValueParser *p, NSArray *l) { return [p parseOffsets:l]; }];
+
+    [self assertAccessor:@"shadowValue" source:@"1px 2px 3px red, inset 0 0 4px blue" shared:YES
+                accessor:^id(STKPXDeclaration *d) { return d.shadowValue; }
+               reference:^id(STKPXValueParser *p, NSArray *l) { return [p parseShadow:l]; }];
+
+    [self assertAccessor:@"nameListValue" source:@"fade, slide, spin" shared:YES
+                accessor:^id(STKPXDeclaration *d) { return d.nameListValue; }
+               reference:^id(STKPXValueParser *p, NSArray *l) { return [p parseNameList:l]; }];
+
+    [self assertAccessor:@"floatListValue" source:@"1, 2.5, 3" shared:YES
+                accessor:^id(STKPXDeclaration *d) { return d.floatListValue; }
+               reference:^id(STKPXValueParser *p, NSArray *l) { return [p parseFloatList:l]; }];
+
+    [self assertAccessor:@"secondsListValue" source:@"1s, 250ms" shared:YES
+                accessor:^id(STKPXDeclaration *d) { return d.secondsListValue; }
+               reference:^id(STKPXValueParser *p, NSArray *l) { return [p parseSecondsList:l]; }];
+
+    [self assertAccessor:@"animationDirectionList" source:@"normal, reverse, alternate" shared:YES
+                accessor:^id(STKPXDeclaration *d) { return d.animationDirectionList; }
+               reference:^id(STKPXValueParser *p, NSArray *l) { return [p parseAnimationDirectionList:l]; }];
+
+    [self assertAccessor:@"animationFillModeList" source:@"forwards, both" shared:YES
+                accessor:^id(STKPXDeclaration *d) { return d.animationFillModeList; }
+               reference:^id(STKPXValueParser *p, NSArray *l) { return [p parseAnimationFillModeList:l]; }];
+
+    [self assertAccessor:@"animationPlayStateList" source:@"running, paused" shared:YES
+                accessor:^id(STKPXDeclaration *d) { return d.animationPlayStateList; }
+               reference:^id(STKPXValueParser *p, NSArray *l) { return [p parseAnimationPlayStateList:l]; }];
+
+    [self assertAccessor:@"animationTimingFunctionList" source:@"ease-in, linear" shared:YES
+                accessor:^id(STKPXDeclaration *d) { return d.animationTimingFunctionList; }
+               reference:^id(STKPXValueParser *p, NSArray *l) { return [p parseAnimationTimingFunctionList:l]; }];
+
+    [self assertAccessor:@"lengthValue" source:@"12pt" shared:YES
+                accessor:^id(STKPXDeclaration *d) { return d.lengthValue; }
+               reference:^id(STKPXValueParser *p, NSArray *l) { return [[STKPXDimension alloc] initWithNumber:12.0f withDimension:@"pt"]; }];
+
+    [self assertAccessor:@"letterSpacingValue" source:@"0.5em" shared:YES
+                accessor:^id(STKPXDeclaration *d) { return d.letterSpacingValue; }
+               reference:^id(STKPXValueParser *p, NSArray *l) { return [[STKPXDimension alloc] initWithNumber:0.5f withDimension:@"em"]; }];
+
+    [self assertAccessor:@"stringValue" source:@"\"Helvetica Neue\" bold" shared:YES
+                accessor:^id(STKPXDeclaration *d) { return d.stringValue; }
+               reference:^id(STKPXValueParser *p, NSArray *l) { return @"Helvetica Neue bold"; }];
+}
+
+- (void)testInfoListsMatchParser
+{
+    [self assertAccessor:@"animationInfoList" source:@"fade 1s ease-in 2 alternate, spin 250ms linear" shared:NO
+                accessor:^id(STKPXDeclaration *d) { return d.animationInfoList; }
+               reference:^id(STKPXValueParser *p, NSArray *l) { return [p parseAnimationInfos:l]; }];
+
+    [self assertAccessor:@"transitionInfoList" source:@"opacity 1s ease-out 0.5s, color 2s" shared:NO
+                accessor:^id(STKPXDeclaration *d) { return d.transitionInfoList; }
+               reference:^id(STKPXValueParser *p, NSArray *l) { return [p parseTransitionInfos:l]; }];
+}
+
+- (void)testScalarAccessorsMatchParser
+{
+    [self assertAccessor:@"floatValue" source:@"0.75" shared:NO
+                accessor:^id(STKPXDeclaration *d) { return @(d.floatValue); }
+               reference:^id(STKPXValueParser *p, NSArray *l) { return @([p parseFloat:l]); }];
+
+    [self assertAccessor:@"secondsValue" source:@"750ms" shared:NO
+                accessor:^id(STKPXDeclaration *d) { return @(d.secondsValue); }
+               reference:^id(STKPXValueParser *p, NSArray *l) { return @([p parseSeconds:l]); }];
+
+    [self assertAccessor:@"sizeValue" source:@"10px 20px" shared:NO
+                accessor:^id(STKPXDeclaration *d) { return [NSValue valueWithCGSize:d.sizeValue]; }
+               reference:^id(STKPXValueParser *p, NSArray *l) { return [NSValue valueWithCGSize:[p parseSize:l]]; }];
+
+    [self assertAccessor:@"insetsValue" source:@"1 2 3 4" shared:NO
+                accessor:^id(STKPXDeclaration *d) { return [NSValue valueWithUIEdgeInsets:d.insetsValue]; }
+               reference:^id(STKPXValueParser *p, NSArray *l) { return [NSValue valueWithUIEdgeInsets:[p parseInsets:l]]; }];
+
+    [self assertAccessor:@"borderStyleValue" source:@"dashed" shared:NO
+                accessor:^id(STKPXDeclaration *d) { return @(d.borderStyleValue); }
+               reference:^id(STKPXValueParser *p, NSArray *l) { return @([p parseBorderStyle:l]); }];
+
+    [self assertAccessor:@"affineTransformValue" source:@"rotate(45) translate(10, 20)" shared:NO
+                accessor:^id(STKPXDeclaration *d) { return [NSValue valueWithCGAffineTransform:d.affineTransformValue]; }
+               reference:^id(STKPXValueParser *p, NSArray *l) {
+                   return [NSValue valueWithCGAffineTransform:[[[STKPXTransformParser alloc] init] parse:@"rotate(45) translate(10, 20)"]];
+               }];
+
+    [self assertAccessor:@"booleanValue" source:@"yes" shared:NO
+                accessor:^id(STKPXDeclaration *d) { return @(d.booleanValue); }
+               reference:^id(STKPXValueParser *p, NSArray *l) { return @YES; }];
+
+    [self assertAccessor:@"textAlignmentValue" source:@"right" shared:NO
+                accessor:^id(STKPXDeclaration *d) { return @(d.textAlignmentValue); }
+               reference:^id(STKPXValueParser *p, NSArray *l) { return @(NSTextAlignmentRight); }];
+
+    [self assertAccessor:@"lineBreakModeValue" source:@"word-wrap" shared:NO
+                accessor:^id(STKPXDeclaration *d) { return @(d.lineBreakModeValue); }
+               reference:^id(STKPXValueParser *p, NSArray *l) { return @(NSLineBreakByWordWrapping); }];
+
+    [self assertAccessor:@"textBorderStyleValue" source:@"rounded-rect" shared:NO
+                accessor:^id(STKPXDeclaration *d) { return @(d.textBorderStyleValue); }
+               reference:^id(STKPXValueParser *p, NSArray *l) { return @(UITextBorderStyleRoundedRect); }];
+
+    [self assertAccessor:@"cacheStylesTypeValue" source:@"minimize-styling cache-images" shared:NO
+                accessor:^id(STKPXDeclaration *d) { return @(d.cacheStylesTypeValue); }
+               reference:^id(STKPXValueParser *p, NSArray *l) { return @(STKPXCacheStylesTypeStyleOnce | STKPXCacheStylesTypeImages); }];
+
+    [self assertAccessor:@"parseErrorDestinationValue" source:@"console" shared:NO
+                accessor:^id(STKPXDeclaration *d) { return @(d.parseErrorDestinationValue); }
+               reference:^id(STKPXValueParser *p, NSArray *l) { return @(STKPXParseErrorDestinationConsole); }];
+}
+
+- (void)testInvalidValuesAreRememberedAsNil
+{
+    STKPXDeclaration *declaration = [[STKPXDeclaration alloc] initWithName:@"color" value:@"not-a-color("];
+
+    XCTAssertNil(declaration.colorValue);
+    XCTAssertNil(declaration.colorValue);
+    XCTAssertNil(declaration.lengthValue);
+    XCTAssertEqualObjects(declaration.stringValue, declaration.stringValue);
+}
+
+#pragma mark - Invalidation Tests
+
+- (void)testSettingSourceDiscardsValues
+{
+    STKPXDeclaration *declaration = [[STKPXDeclaration alloc] initWithName:@"color" value:@"red"];
+
+    XCTAssertEqualObjects(declaration.colorValue, [UIColor colorWithRed:1.0 green:0.0 blue:0.0 alpha:1.0]);
+    XCTAssertEqualObjects(declaration.stringValue, @"red");
+
+    NSString *source = @"blue";
+
+    [declaration setSource:source filename:nil lexemes:[STKPXValueParser lexemesForSource:source]];
+
+    XCTAssertEqualObjects(declaration.colorValue, [UIColor colorWithRed:0.0 green:0.0 blue:1.0 alpha:1.0]);
+    XCTAssertEqualObjects(declaration.stringValue, @"blue");
+}
+
+- (void)testInfoListsAreCopiedForEachCaller
+{
+    STKPXDeclaration *declaration = [[STKPXDeclaration alloc] initWithName:@"animation" value:@"fade 1s"];
+    STKPXAnimationInfo *first = declaration.animationInfoList.firstObject;
+
+    first.animationName = @"changed";
+    first.animationDuration = 5.0f;
+
+    STKPXAnimationInfo *second = declaration.animationInfoList.firstObject;
+
+    XCTAssertTrue(first != second);
+    XCTAssertEqualObjects(second.animationName, @"fade");
+    XCTAssertEqualWithAccuracy(second.animationDuration, 1.0f, 1e-6);
+}
+
+- (void)testTransformStringIsCachedPerInput
+{
+    STKPXDeclaration *declaration = [[STKPXDeclaration alloc] initWithName:@"text-transform" value:@"uppercase"];
+
+    for (NSUInteger pass = 0; pass < 2; pass++)
+    {
+        for (NSUInteger i = 0; i < 40; i++)
+        {
+            NSString *input = [NSString stringWithFormat:@"label %lu", (unsigned long) i];
+
+            XCTAssertEqualObjects([declaration transformString:input], input.uppercaseString);
+        }
+    }
+
+    XCTAssertEqualObjects([declaration transformString:nil], @"");
+}
+
+#pragma mark - Benchmarks
+
+- (NSDictionary *)accessorsByProperty
+{
+    return @{
+        @"color" : ^id(STKPXDeclaration *d) { return d.colorValue; },
+        @"background-color" : ^id(STKPXDeclaration *d) { return d.paintValue; },
+        @"background-size" : ^id(STKPXDeclaration *d) { return [NSValue valueWithCGSize:d.sizeValue]; },
+        @"border" : ^id(STKPXDeclaration *d) { return d.borderValue; },
+        @"border-radius" : ^id(STKPXDeclaration *d) { return d.borderRadiiList; },
+        @"border-width" : ^id(STKPXDeclaration *d) { return d.offsetsValue; },
+        @"border-color" : ^id(STKPXDeclaration *d) { return d.paintList; },
+        @"border-style" : ^id(STKPXDeclaration *d) { return d.borderStyleList; },
+        @"box-shadow" : ^id(STKPXDeclaration *d) { return d.shadowValue; },
+        @"text-shadow" : ^id(STKPXDeclaration *d) { return d.shadowValue; },
+        @"padding" : ^id(STKPXDeclaration *d) { return d.offsetsValue; },
+        @"opacity" : ^id(STKPXDeclaration *d) { return @(d.floatValue); },
+        @"font-size" : ^id(STKPXDeclaration *d) { return @(d.floatValue); },
+        @"font-family" : ^id(STKPXDeclaration *d) { return d.stringValue; },
+        @"text-align" : ^id(STKPXDeclaration *d) { return @(d.textAlignmentValue); },
+        @"text-transform" : ^id(STKPXDeclaration *d) { return [d transformString:@"Title"]; },
+        @"letter-spacing" : ^id(STKPXDeclaration *d) { return d.letterSpacingValue; },
+        @"transform" : ^id(STKPXDeclaration *d) { return [NSValue valueWithCGAffineTransform:d.affineTransformValue]; },
+        @"animation" : ^id(STKPXDeclaration *d) { return d.animationInfoList; },
+        @"animation-name" : ^id(STKPXDeclaration *d) { return d.nameListValue; },
+        @"animation-duration" : ^id(STKPXDeclaration *d) { return d.secondsListValue; },
+        @"animation-timing-function" : ^id(STKPXDeclaration *d) { return d.animationTimingFunctionList; },
+        @"animation-iteration-count" : ^id(STKPXDeclaration *d) { return d.floatListValue; },
+        @"animation-direction" : ^id(STKPXDeclaration *d) { return d.animationDirectionList; },
+        @"animation-play-state" : ^id(STKPXDeclaration *d) { return d.animationPlayStateList; },
+        @"animation-fill-mode" : ^id(STKPXDeclaration *d) { return d.animationFillModeList; },
+        @"transition" : ^id(STKPXDeclaration *d) { return d.transitionInfoList; },
+    };
+}
+
+- (NSString *)declarationHeavySourceWithRuleCount:(NSUInteger)count
+{
+    NSMutableString *source = [NSMutableString string];
+
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        [source appendFormat:@".item%lu {\n", (unsigned long) i];
+        [source appendFormat:@"  color: #%06lx;\n", (unsigned long) (i * 2654435761u) & 0xFFFFFF];
+        [source appendString:@"  background-color: linear-gradient(#fff, #ccc);\n"];
+        [source appendString:@"  background-size: 100px 40px;\n"];
+        [source appendString:@"  border: 1px solid #999;\n"];
+        [source appendFormat:@"  border-radius: %lupx 4px / 2px;\n", (unsigned long) (i % 8)];
+        [source appendString:@"  border-width: 1px 2px 1px 2px;\n"];
+        [source appendString:@"  border-color: red green blue yellow;\n"];
+        [source appendString:@"  border-style: solid dashed solid dotted;\n"];
+        [source appendString:@"  box-shadow: 0 1px 2px rgba(0, 0, 0, 0.5), inset 0 0 3px white;\n"];
+        [source appendString:@"  text-shadow: 0 1px 0 #fff;\n"];
+        [source appendString:@"  padding: 4px 8px;\n"];
+        [source appendString:@"  opacity: 0.9;\n"];
+        [source appendFormat:@"  font-size: %lu;\n", (unsigned long) (10 + i % 10)];
+        [source appendString:@"  font-family: \"Helvetica Neue\";\n"];
+        [source appendString:@"  text-align: center;\n"];
+        [source appendString:@"  text-transform: uppercase;\n"];
+        [source appendString:@"  letter-spacing: 0.1em;\n"];
+        [source appendString:@"  transform: rotate(5) scale(1.1);\n"];
+        [source appendString:@"  animation: fade 1s ease-in 2 alternate, spin 2s linear;\n"];
+        [source appendString:@"  animation-name: fade, spin;\n"];
+        [source appendString:@"  animation-duration: 1s, 2s;\n"];
+        [source appendString:@"  animation-timing-function: ease-in, linear;\n"];
+        [source appendString:@"  animation-iteration-count: 2, 1;\n"];
+        [source appendString:@"  animation-direction: alternate, normal;\n"];
+        [source appendString:@"  animation-play-state: running, paused;\n"];
+        [source appendString:@"  animation-fill-mode: forwards, none;\n"];
+        [source appendString:@"  transition: opacity 250ms ease-out;\n"];
+        [source appendString:@"}\n"];
+    }
+
+    return source;
+}
+
+- (void)testStylerAccessorThroughput
+{
+    NSDictionary *accessors = self.accessorsByProperty;
+    NSString *source = [self declarationHeavySourceWithRuleCount:50];
+    STKPXStylesheet *stylesheet = [[[STKPXStylesheetParser alloc] init] parse:source withOrigin:STKPXStylesheetOriginApplication];
+    NSMutableArray *declarations = [NSMutableArray array];
+
+    for (STKPXRuleSet *ruleSet in stylesheet.ruleSets)
+    {
+        for (STKPXDeclaration *declaration in ruleSet.declarations)
+        {
+            if (accessors[declaration.name])
+            {
+                [declarations addObject:declaration];
+            }
+        }
+    }
+
+    XCTAssertEqual(declarations.count, 50 * accessors.count);
+
+    NSUInteger passes = 5;
+    NSArray *lexemes = [declarations valueForKey:@"lexemes"];
+    NSArray *sources = [declarations valueForKey:@"source"];
+
+    // resetting the source discards parsed values, so every pass re-parses like the old accessors did
+    STKBenchmarkSample *uncached = [RECORDER measure:@"declaration.accessors.uncached" iterations:5 items:declarations.count * passes block:^{
+        for (NSUInteger pass = 0; pass < passes; pass++)
+        {
+            [declarations enumerateObjectsUsingBlock:^(STKPXDeclaration *declaration, NSUInteger index, BOOL *stop) {
+                [declaration setSource:sources[index] filename:nil lexemes:lexemes[index]];
+
+                DeclarationAccessor accessor = accessors[declaration.name];
+
+                accessor(declaration);
+            }];
+        }
+    }];
+
+    STKBenchmarkSample *cached = [RECORDER measure:@"declaration.accessors.cached" iterations:5 items:declarations.count * passes block:^{
+        for (NSUInteger pass = 0; pass < passes; pass++)
+        {
+            for (STKPXDeclaration *declaration in declarations)
+            {
+                DeclarationAccessor accessor = accessors[declaration.name];
+
+                accessor(declaration);
+            }
+        }
+    }];
+
+    uncached.metrics[@"declarations"] = @(declarations.count);
+    cached.metrics[@"declarations"] = @(declarations.count);
+}
+
+@end
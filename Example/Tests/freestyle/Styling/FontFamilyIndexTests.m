@@ -0,0 +1,270 @@
+//
+//  FontFamilyIndexTests.m
+//  StylingKit
+//
+
+#import <XCTest/XCTest.h>
+#import "STKPXFontFamilyIndex.h"
+#import "STKPXFontRegistry.h"
+#import "STKPXStylesheet.h"
+#import "STKPXStylesheetParser.h"
+#import "STKPXStyleUtils.h"
+#import "UIView+STKPXStyling.h"
+#import "PixateFreestyle.h"
+#import "STKBenchmarkRecorder.h"
+
+static STKBenchmarkRecorder *RECORDER;
+
+@interface FontFamilyIndexTests : XCTestCase
+@end
+
+@implementation FontFamilyIndexTests
+
++ (void)setUp
+{
+    [super setUp];
+
+    RECORDER = [[STKBenchmarkRecorder alloc] initWithSuiteName:@"FontFamilyIndexTests"];
+}
+
++ (void)tearDown
+{
+    [RECORDER writeReport];
+    RECORDER = nil;
+
+    [super tearDown];
+}
+
+#pragma mark - Helpers
+
+- (NSArray *)entriesForFamily:(NSString *)family suffixes:(NSArray *)suffixes
+{
+    NSMutableArray *entries = [[NSMutableArray alloc] initWithCapacity:suffixes.count];
+
+    for (NSString *suffix in suffixes)
+    {
+        NSString *name = (suffix.length) ? [NSString stringWithFormat:@"%@-%@", family, suffix] : family;
+
+        [entries addObject:[[STKPXFontEntry alloc] initWithFontFamily:family fontName:name]];
+    }
+
+    return entries;
+}
+
+/**
+ *  A family with every weight in upright and italic, plus condensed and expanded cuts: 24 faces
+ */
+- (NSArray *)largeFamilyEntries
+{
+    return [self entriesForFamily:@"Large" suffixes:@[ @"Thin", @"ThinItalic", @"UltraLight", @"UltraLightItalic",
+                                                       @"Light", @"LightItalic", @"", @"Italic",
+                                                       @"Medium", @"MediumItalic", @"SemiBold", @"SemiBoldItalic",
+                                                       @"Bold", @"BoldItalic", @"ExtraBold", @"ExtraBoldItalic",
+                                                       @"Black", @"BlackItalic", @"Condensed", @"CondensedBold",
+                                                       @"CondensedOblique", @"Expanded", @"ExpandedLight", @"UltraExpandedBlack" ]];
+}
+
+/**
+ *  The lookup STKPXFontRegistry performed before families were indexed
+ */
+- (STKPXFontEntry *)filteredEntryFromEntries:(NSArray *)entries stretch:(NSString *)stretch style:(NSString *)style weight:(NSString *)weight
+{
+    NSArray *infos = [STKPXFontEntry filterEntries:entries byStretch:[STKPXFontEntry indexFromStretchName:stretch]];
+    infos = [STKPXFontEntry filterEntries:infos byStyle:style];
+    infos = [STKPXFontEntry filterEntries:infos byWeight:[STKPXFontEntry indexFromWeightName:weight]];
+
+    return infos.firstObject;
+}
+
+- (NSArray *)stretchNames
+{
+    return @[ @"ultra-condensed", @"extra-condensed", @"condensed", @"semi-condensed", @"normal",
+              @"semi-expanded", @"expanded", @"extra-expanded", @"ultra-expanded", @"bogus" ];
+}
+
+- (NSArray *)styleNames
+{
+    return @[ @"normal", @"italic", @"oblique", @"bogus" ];
+}
+
+- (NSArray *)weightNames
+{
+    return @[ @"100", @"200", @"300", @"400", @"500", @"600", @"700", @"800", @"900",
+              @"thin", @"light", @"normal", @"bold", @"black", @"450", @"50", @"1000", @"bogus" ];
+}
+
+- (void)assertIndexMatchesFiltersForEntries:(NSArray *)entries
+{
+    STKPXFontFamilyIndex *index = [[STKPXFontFamilyIndex alloc] initWithFamily:@"Test" entries:entries];
+
+    for (NSString *stretch in self.stretchNames)
+    {
+        for (NSString *style in self.styleNames)
+        {
+            for (NSString *weight in self.weightNames)
+            {
+                STKPXFontEntry *expected = [self filteredEntryFromEntries:entries stretch:stretch style:style weight:weight];
+                STKPXFontEntry *actual = [index entryForStretch:[STKPXFontEntry indexFromStretchName:stretch]
+                                                          style:style
+                                                         weight:[STKPXFontEntry indexFromWeightName:weight]];
+
+                XCTAssertEqualObjects(actual.name, expected.name, @"%@ %@ %@", stretch, style, weight);
+            }
+        }
+    }
+}
+
+#pragma mark - Matching Tests
+
+- (void)testIndexMatchesFiltersForLargeFamily
+{
+    [self assertIndexMatchesFiltersForEntries:self.largeFamilyEntries];
+}
+
+- (void)testIndexMatchesFiltersForSparseFamilies
+{
+    [self assertIndexMatchesFiltersForEntries:[self entriesForFamily:@"Sparse" suffixes:@[ @"Light", @"Bold" ]]];
+    [self assertIndexMatchesFiltersForEntries:[self entriesForFamily:@"Sparse" suffixes:@[ @"Italic" ]]];
+    [self assertIndexMatchesFiltersForEntries:[self entriesForFamily:@"Sparse" suffixes:@[ @"Condensed", @"Expanded", @"Oblique-300" ]]];
+    [self assertIndexMatchesFiltersForEntries:[self entriesForFamily:@"Sparse" suffixes:@[ @"W-100", @"W-500", @"W-900", @"BoldItalic" ]]];
+}
+
+- (void)testEmptyFamilyHasNoMatch
+{
+    STKPXFontFamilyIndex *index = [[STKPXFontFamilyIndex alloc] initWithFamily:@"Empty" entries:@[]];
+
+    XCTAssertNil([index entryForStretch:4 style:@"normal" weight:400]);
+}
+
+- (void)testRegistryResolvesInstalledFamilies
+{
+    [STKPXFontRegistry clearRegistry];
+
+    for (NSString *family in @[ @"Helvetica Neue", @"Avenir Next", @"Courier" ])
+    {
+        NSArray *entries = [STKPXFontEntry fontEntriesForFamily:family];
+
+        for (NSString *weight in @[ @"300", @"normal", @"bold" ])
+        {
+            for (NSString *style in @[ @"normal", @"italic" ])
+            {
+                STKPXFontEntry *expected = [self filteredEntryFromEntries:entries stretch:@"normal" style:style weight:weight];
+                UIFont *font = [STKPXFontRegistry fontWithFamily:family
+                                                     fontStretch:@"normal"
+                                                      fontWeight:weight
+                                                       fontStyle:style
+                                                            size:12.0f
+                                                   isDefaultFont:NO];
+
+                XCTAssertEqualObjects(font.fontName, expected.name, @"%@ %@ %@", family, weight, style);
+            }
+        }
+    }
+}
+
+#pragma mark - Loading Tests
+
+- (void)testLoadedFontRestylesWaitingLabel
+{
+    PixateFreestyleConfiguration *configuration = PixateFreestyle.configuration;
+    STKPXCacheStylesType cacheStylesType = configuration.cacheStylesType;
+
+    // the default settings, which skip styling passes whose declarations did not change
+    configuration.cacheStylesType = STKPXCacheStylesTypeStyleOnce | STKPXCacheStylesTypeImages;
+
+    // keep a reference, the parser registers it as the current application stylesheet
+    STKPXStylesheet *stylesheet = [[[STKPXStylesheetParser alloc] init] parse:@"#fontLoadLabel { font-family: STKTestFont; font-size: 20px; }"
+                                                                   withOrigin:STKPXStylesheetOriginApplication];
+    UILabel *label = [[UILabel alloc] initWithFrame:CGRectMake(0, 0, 200, 40)];
+    NSURL *URL = [[NSBundle bundleForClass:self.class] URLForResource:@"STKTestFont" withExtension:@"ttf"];
+
+    XCTAssertNotNil(stylesheet);
+    XCTAssertNotNil(URL);
+
+    // index the family while it is missing, so styling before the load completes gets the fallback even if the
+    // background queue already registered the font
+    [STKPXFontRegistry clearRegistry];
+    XCTAssertNil([STKPXFontRegistry fontWithFamily:@"STKTestFont" fontStretch:@"normal" fontWeight:@"normal" fontStyle:@"normal" size:20.0f isDefaultFont:NO]);
+
+    [self expectationForNotification:STKPXFontRegistryDidLoadFontNotification object:nil handler:^BOOL(NSNotification *notification) {
+        return [notification.userInfo[STKPXFontRegistryFamilyKey] isEqualToString:@"STKTestFont"];
+    }];
+
+    [STKPXFontRegistry loadFontFromURL:URL];
+    XCTAssertTrue([STKPXFontRegistry isLoadingFonts]);
+
+    label.styleId = @"fontLoadLabel";
+    [STKPXStyleUtils updateStylesForStyleable:label andDescendants:NO];
+
+    UIFont *fallback = label.font;
+
+    XCTAssertNotEqualObjects(fallback.familyName, @"STKTestFont");
+
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+
+    XCTAssertFalse([STKPXFontRegistry isLoadingFonts]);
+    XCTAssertEqualObjects(label.font.familyName, @"STKTestFont");
+    XCTAssertEqualObjects(label.font.fontName, @"STKTestFont-Regular");
+    XCTAssertNotEqualObjects(label.font, fallback);
+    XCTAssertEqual(label.font.pointSize, 20.0f);
+
+    configuration.cacheStylesType = cacheStylesType;
+}
+
+#pragma mark - Benchmarks
+
+- (void)testLookupThroughput
+{
+    NSArray *entries = self.largeFamilyEntries;
+    NSArray *weights = @[ @"100", @"300", @"normal", @"500", @"bold", @"900" ];
+    NSArray *styles = @[ @"normal", @"italic" ];
+    NSArray *stretches = @[ @"normal", @"condensed", @"expanded" ];
+    NSUInteger lookups = weights.count * styles.count * stretches.count;
+    NSUInteger passes = 50;
+
+    STKBenchmarkSample *filtered = [RECORDER measure:@"font.resolve.filters" iterations:10 items:lookups * passes block:^{
+        for (NSUInteger pass = 0; pass < passes; pass++)
+        {
+            for (NSString *stretch in stretches)
+            {
+                for (NSString *style in styles)
+                {
+                    for (NSString *weight in weights)
+                    {
+                        [self filteredEntryFromEntries:entries stretch:stretch style:style weight:weight];
+                    }
+                }
+            }
+        }
+    }];
+
+    __block STKPXFontFamilyIndex *index;
+
+    STKBenchmarkSample *build = [RECORDER measure:@"font.index.build" iterations:10 items:1 block:^{
+        index = [[STKPXFontFamilyIndex alloc] initWithFamily:@"Large" entries:entries];
+    }];
+
+    STKBenchmarkSample *indexed = [RECORDER measure:@"font.resolve.index" iterations:10 items:lookups * passes block:^{
+        for (NSUInteger pass = 0; pass < passes; pass++)
+        {
+            for (NSString *stretch in stretches)
+            {
+                for (NSString *style in styles)
+                {
+                    for (NSString *weight in weights)
+                    {
+                        [index entryForStretch:[STKPXFontEntry indexFromStretchName:stretch]
+                                         style:style
+                                        weight:[STKPXFontEntry indexFromWeightName:weight]];
+                    }
+                }
+            }
+        }
+    }];
+
+    filtered.metrics[@"faces"] = @(entries.count);
+    build.metrics[@"faces"] = @(entries.count);
+    indexed.metrics[@"faces"] = @(entries.count);
+}
+
+@end
@@ -0,0 +1,194 @@
+//
+//  InlineStyleTests.m
+//  StylingKit
+//
+
+#import <XCTest/XCTest.h>
+#import "StyleableView.h"
+#import "UIView+STKPXStyling.h"
+#import "STKPXStylesheet.h"
+#import "STKPXStylesheetParser.h"
+#import "STKPXRuleSet.h"
+#import "STKPXStyleUtils.h"
+#import "STKBenchmarkRecorder.h"
+
+static STKBenchmarkRecorder *RECORDER;
+
+@interface InlineStyleTests : XCTestCase
+@end
+
+@implementation InlineStyleTests
+
++ (void)setUp
+{
+    [super setUp];
+
+    RECORDER = [[STKBenchmarkRecorder alloc] initWithSuiteName:@"InlineStyleTests"];
+}
+
++ (void)tearDown
+{
+    [RECORDER writeReport];
+    RECORDER = nil;
+
+    [super tearDown];
+}
+
+#pragma mark - Helpers
+
+- (STKPXRuleSet *)ruleSetFromStyleCSSOfView:(UIView *)view
+{
+    NSString *source = view.styleCSS;
+
+    if (source.length == 0)
+    {
+        return nil;
+    }
+
+    return [[[STKPXStylesheetParser alloc] init] parseInlineCSS:source].ruleSets.firstObject;
+}
+
+- (void)assertInlineRuleSetOfView:(UIView *)view matchesStringPath:(NSString *)step
+{
+    STKPXRuleSet *expected = [self ruleSetFromStyleCSSOfView:view];
+    STKPXRuleSet *actual = view.inlineRuleSet;
+
+    if (expected == nil)
+    {
+        XCTAssertNil(actual, @"%@", step);
+        return;
+    }
+
+    XCTAssertEqualObjects([actual.declarations valueForKey:@"description"],
+                          [expected.declarations valueForKey:@"description"],
+                          @"%@", step);
+    XCTAssertEqualObjects(actual.specificity.description, expected.specificity.description, @"%@", step);
+    XCTAssertEqual(actual.stateMask, expected.stateMask, @"%@", step);
+}
+
+#pragma mark - Tests
+
+- (void)testKVCPropertiesMatchStringPath
+{
+    StyleableView *view = [[StyleableView alloc] initWithElementName:@"view"];
+    NSArray *steps = @[ @[ @"background-color", @"red" ],
+                        @[ @"border-width", @"2px" ],
+                        @[ @"+opacity", @"0.5" ],
+                        @[ @"background-color", @"linear-gradient(red, blue)" ],
+                        @[ @"color", @"#336699 !important" ],
+                        @[ @"border-width", [NSNull null] ],
+                        @[ @"transform", @"rotate(30deg) scale(2)" ],
+                        @[ @"border-width", @"1px" ],
+                        @[ @"opacity", [NSNull null] ] ];
+
+    [self assertInlineRuleSetOfView:view matchesStringPath:@"empty"];
+
+    for (NSArray *step in steps)
+    {
+        id value = (step[1] == [NSNull null]) ? nil : step[1];
+
+        [view setValue:value forKey:step[0]];
+        [self assertInlineRuleSetOfView:view matchesStringPath:[step componentsJoinedByString:@"="]];
+    }
+}
+
+- (void)testClearedKVCPropertiesProduceNoRuleSet
+{
+    StyleableView *view = [[StyleableView alloc] initWithElementName:@"view"];
+
+    [view setValue:@"red" forKey:@"color"];
+    XCTAssertNotNil(view.inlineRuleSet);
+
+    [view setValue:nil forKey:@"color"];
+    XCTAssertNil(view.inlineRuleSet);
+    [self assertInlineRuleSetOfView:view matchesStringPath:@"cleared"];
+}
+
+- (void)testStyleCSSMatchesStringPath
+{
+    StyleableView *view = [[StyleableView alloc] initWithElementName:@"view"];
+
+    view.styleCSS = @"background-color: red; border-radius: 4px";
+    [self assertInlineRuleSetOfView:view matchesStringPath:@"first"];
+
+    STKPXRuleSet *first = view.inlineRuleSet;
+
+    XCTAssertEqual(view.inlineRuleSet, first);
+
+    view.styleCSS = @"opacity: 0.25";
+    [self assertInlineRuleSetOfView:view matchesStringPath:@"second"];
+    XCTAssertNotEqual(view.inlineRuleSet, first);
+
+    view.styleCSS = nil;
+    XCTAssertNil(view.inlineRuleSet);
+}
+
+- (void)testInlineRuleSetJoinsCascade
+{
+    StyleableView *view = [[StyleableView alloc] initWithElementName:@"view"];
+
+    [view setValue:@"blue" forKey:@"color"];
+
+    XCTAssertEqual([STKPXStyleUtils matchingRuleSetsForStyleable:view].lastObject, view.inlineRuleSet);
+}
+
+#pragma mark - Benchmarks
+
+- (void)testKVCStyledViews
+{
+    NSUInteger count = 1000;
+    NSMutableArray *views = [[NSMutableArray alloc] initWithCapacity:count];
+    NSArray *properties = @[ @"background-color", @"border-width", @"border-color", @"opacity", @"corner-radius", @"color" ];
+    NSArray *values = @[ @"#ff8800", @"1px", @"rgba(0, 0, 0, 0.5)", @"0.75", @"6px", @"red" ];
+
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        StyleableView *view = [[StyleableView alloc] initWithElementName:@"view"];
+
+        for (NSUInteger p = 0; p < properties.count; p++)
+        {
+            [view setValue:values[(i + p) % values.count] forKey:properties[p]];
+        }
+
+        [views addObject:view];
+    }
+
+    __block NSUInteger declarations = 0;
+
+    STKBenchmarkSample *string = [RECORDER measure:@"inline.kvc.string" iterations:10 items:count block:^{
+        declarations = 0;
+
+        for (UIView *view in views)
+        {
+            declarations += [self ruleSetFromStyleCSSOfView:view].declarations.count;
+        }
+    }];
+
+    STKBenchmarkSample *parsed = [RECORDER measure:@"inline.kvc.declarations" iterations:10 items:count block:^{
+        declarations = 0;
+
+        for (UIView *view in views)
+        {
+            declarations += view.inlineRuleSet.declarations.count;
+        }
+    }];
+
+    // one property changing on every view between passes
+    STKBenchmarkSample *updated = [RECORDER measure:@"inline.kvc.update_one" iterations:10 items:count block:^{
+        declarations = 0;
+
+        for (UIView *view in views)
+        {
+            [view setValue:@"0.5" forKey:@"opacity"];
+            declarations += view.inlineRuleSet.declarations.count;
+        }
+    }];
+
+    string.metrics[@"properties_per_view"] = @(properties.count);
+    parsed.metrics[@"properties_per_view"] = @(properties.count);
+    updated.metrics[@"properties_per_view"] = @(properties.count);
+
+    XCTAssertEqual(declarations, count * properties.count);
+}
+
+@end
@@ -0,0 +1,286 @@
+//
+//  KeyframeTemplateTests.m
+//  StylingKit
+//
+
+#import <XCTest/XCTest.h>
+#import "STKPXKeyframeTemplate.h"
+#import "STKPXAnimationSpec.h"
+#import "STKPXAnimationInfo.h"
+#import "STKPXAnimationPropertyHandler.h"
+#import "STKBenchmarkRecorder.h"
+
+static STKBenchmarkRecorder *RECORDER;
+
+@interface KeyframeTemplateTests : XCTestCase
+@end
+
+@implementation KeyframeTemplateTests
+{
+    NSDictionary *handlers_;
+}
+
++ (void)setUp
+{
+    [super setUp];
+
+    RECORDER = [[STKBenchmarkRecorder alloc] initWithSuiteName:@"KeyframeTemplateTests"];
+}
+
++ (void)tearDown
+{
+    [RECORDER writeReport];
+    RECORDER = nil;
+
+    [super tearDown];
+}
+
+- (void)setUp
+{
+    [super setUp];
+
+    handlers_ = @{
+        @"opacity": [[STKPXAnimationPropertyHandler alloc] initWithKeyPath:@"opacity" block:STKPXAnimationPropertyHandler.FloatValueBlock],
+        @"left": [[STKPXAnimationPropertyHandler alloc] initWithKeyPath:@"position.x" block:STKPXAnimationPropertyHandler.FloatValueBlock],
+    };
+}
+
+#pragma mark - Helpers
+
+/**
+ *  Build a keyframe from offset -> CSS declarations, adding the blocks in the given order
+ */
+- (STKPXKeyframe *)keyframeNamed:(NSString *)name blocks:(NSArray *)blocks
+{
+    STKPXKeyframe *keyframe = [[STKPXKeyframe alloc] initWithName:name];
+
+    for (NSArray *entry in blocks)
+    {
+        STKPXKeyframeBlock *block = [[STKPXKeyframeBlock alloc] initWithOffset:[entry[0] floatValue]];
+        NSDictionary *declarations = entry[1];
+
+        for (NSString *property in [declarations.allKeys sortedArrayUsingSelector:@selector(compare:)])
+        {
+            [block addDeclaration:[[STKPXDeclaration alloc] initWithName:property value:declarations[property]]];
+        }
+
+        [keyframe addKeyframeBlock:block];
+    }
+
+    return keyframe;
+}
+
+- (STKPXAnimationInfo *)infoWithDuration:(CGFloat)duration
+{
+    STKPXAnimationInfo *info = [[STKPXAnimationInfo alloc] initWithCSSDefaults];
+
+    info.animationName = @"fade";
+    info.animationDuration = duration;
+
+    return info;
+}
+
+- (NSArray *)specsForTemplate:(STKPXKeyframeTemplate *)template info:(STKPXAnimationInfo *)info
+{
+    NSMutableArray *specs = [[NSMutableArray alloc] init];
+
+    for (STKPXKeyframeTrack *track in template.tracks)
+    {
+        [specs addObject:[[STKPXAnimationSpec alloc] initWithTrack:track info:info]];
+    }
+
+    return specs;
+}
+
+- (NSDictionary *)attachedFromSpecs:(NSArray *)specs
+{
+    NSMutableDictionary *attached = [[NSMutableDictionary alloc] init];
+
+    for (STKPXAnimationSpec *spec in specs)
+    {
+        attached[spec.key] = spec;
+    }
+
+    return attached;
+}
+
+#pragma mark - Compilation Tests
+
+- (void)testCompilationSortsKeyTimes
+{
+    STKPXKeyframe *keyframe = [self keyframeNamed:@"fade" blocks:@[ @[ @1.0, @{ @"opacity": @"1" } ],
+                                                                     @[ @0.0, @{ @"opacity": @"0", @"left": @"10" } ],
+                                                                     @[ @0.5, @{ @"opacity": @"0.25", @"color": @"red" } ] ]];
+    STKPXKeyframeTemplate *template = [[STKPXKeyframeTemplate alloc] initWithKeyframe:keyframe propertyHandlers:handlers_];
+    STKPXKeyframeTrack *opacity = [template trackForKeyPath:@"opacity"];
+    STKPXKeyframeTrack *left = [template trackForKeyPath:@"position.x"];
+
+    XCTAssertEqualObjects(template.name, @"fade");
+    XCTAssertEqual(template.tracks.count, 2);
+    XCTAssertEqualObjects(opacity.keyTimes, (@[ @0.0f, @0.5f, @1.0f ]));
+    XCTAssertEqualObjects(opacity.values, (@[ @0.0f, @0.25f, @1.0f ]));
+    XCTAssertEqualObjects(left.keyTimes, @[ @0.0f ]);
+    XCTAssertEqualObjects(left.values, @[ @10.0f ]);
+
+    // properties without a handler are dropped at compile time
+    XCTAssertNil([template trackForKeyPath:@"color"]);
+}
+
+- (void)testTemplatesAreCompiledOncePerKeyframe
+{
+    STKPXKeyframe *keyframe = [self keyframeNamed:@"fade" blocks:@[ @[ @0.0, @{ @"opacity": @"0" } ],
+                                                                     @[ @1.0, @{ @"opacity": @"1" } ] ]];
+    STKPXKeyframeTemplate *first = [STKPXKeyframeTemplate templateForKeyframe:keyframe propertyHandlers:handlers_];
+
+    XCTAssertEqual([STKPXKeyframeTemplate templateForKeyframe:keyframe propertyHandlers:handlers_], first);
+
+    // a different handler dictionary compiles its own template
+    NSDictionary *otherHandlers = [handlers_ mutableCopy];
+
+    XCTAssertNotEqual([STKPXKeyframeTemplate templateForKeyframe:keyframe propertyHandlers:otherHandlers], first);
+
+    // so does the same block in a reloaded stylesheet
+    STKPXKeyframe *reloaded = [self keyframeNamed:@"fade" blocks:@[ @[ @0.0, @{ @"opacity": @"0" } ],
+                                                                     @[ @1.0, @{ @"opacity": @"1" } ] ]];
+    STKPXKeyframeTemplate *recompiled = [STKPXKeyframeTemplate templateForKeyframe:reloaded propertyHandlers:handlers_];
+
+    XCTAssertNotEqual(recompiled, first);
+    XCTAssertEqualObjects(recompiled.tracks, first.tracks);
+}
+
+#pragma mark - Diff Tests
+
+- (void)testUnchangedSpecsAreNoOps
+{
+    STKPXKeyframe *keyframe = [self keyframeNamed:@"fade" blocks:@[ @[ @0.0, @{ @"opacity": @"0", @"left": @"0" } ],
+                                                                     @[ @1.0, @{ @"opacity": @"1", @"left": @"50" } ] ]];
+    STKPXKeyframeTemplate *template = [STKPXKeyframeTemplate templateForKeyframe:keyframe propertyHandlers:handlers_];
+    NSDictionary *attached = [self attachedFromSpecs:[self specsForTemplate:template info:[self infoWithDuration:1.0f]]];
+
+    // a second styling pass builds new spec objects from fresh infos
+    NSArray *restyled = [self specsForTemplate:template info:[self infoWithDuration:1.0f]];
+    NSMutableArray *removed = [[NSMutableArray alloc] init];
+    NSMutableArray *added = [[NSMutableArray alloc] init];
+
+    [STKPXAnimationSpec diffAttachedSpecs:attached withSpecs:restyled removedKeys:removed addedSpecs:added];
+
+    XCTAssertEqual(removed.count, 0);
+    XCTAssertEqual(added.count, 0);
+}
+
+- (void)testChangedSpecsAreReplaced
+{
+    STKPXKeyframe *keyframe = [self keyframeNamed:@"fade" blocks:@[ @[ @0.0, @{ @"opacity": @"0", @"left": @"0" } ],
+                                                                     @[ @1.0, @{ @"opacity": @"1", @"left": @"50" } ] ]];
+    STKPXKeyframeTemplate *template = [STKPXKeyframeTemplate templateForKeyframe:keyframe propertyHandlers:handlers_];
+    NSDictionary *attached = [self attachedFromSpecs:[self specsForTemplate:template info:[self infoWithDuration:1.0f]]];
+    NSMutableArray *removed = [[NSMutableArray alloc] init];
+    NSMutableArray *added = [[NSMutableArray alloc] init];
+
+    [STKPXAnimationSpec diffAttachedSpecs:attached
+                                withSpecs:[self specsForTemplate:template info:[self infoWithDuration:2.0f]]
+                              removedKeys:removed
+                               addedSpecs:added];
+
+    XCTAssertEqualObjects([NSSet setWithArray:removed], [NSSet setWithArray:attached.allKeys]);
+    XCTAssertEqual(added.count, 2);
+}
+
+- (void)testDroppedSpecsAreRemoved
+{
+    STKPXKeyframe *both = [self keyframeNamed:@"slide" blocks:@[ @[ @0.0, @{ @"opacity": @"0", @"left": @"0" } ],
+                                                                  @[ @1.0, @{ @"opacity": @"1", @"left": @"50" } ] ]];
+    STKPXKeyframe *opacityOnly = [self keyframeNamed:@"fade" blocks:@[ @[ @0.0, @{ @"opacity": @"0" } ],
+                                                                        @[ @1.0, @{ @"opacity": @"1" } ] ]];
+    STKPXAnimationInfo *info = [self infoWithDuration:1.0f];
+    NSDictionary *attached = [self attachedFromSpecs:[self specsForTemplate:[STKPXKeyframeTemplate templateForKeyframe:both propertyHandlers:handlers_] info:info]];
+    NSArray *specs = [self specsForTemplate:[STKPXKeyframeTemplate templateForKeyframe:opacityOnly propertyHandlers:handlers_] info:info];
+    NSMutableArray *removed = [[NSMutableArray alloc] init];
+    NSMutableArray *added = [[NSMutableArray alloc] init];
+
+    [STKPXAnimationSpec diffAttachedSpecs:attached withSpecs:specs removedKeys:removed addedSpecs:added];
+
+    // the opacity track has the same key times and values, so only position.x goes away
+    XCTAssertEqualObjects(removed, @[ @"stk-animation:position.x" ]);
+    XCTAssertEqual(added.count, 0);
+}
+
+- (void)testInvalidAndDuplicateSpecsAreSkipped
+{
+    STKPXKeyframe *keyframe = [self keyframeNamed:@"fade" blocks:@[ @[ @0.0, @{ @"opacity": @"0" } ],
+                                                                     @[ @1.0, @{ @"opacity": @"1" } ] ]];
+    STKPXKeyframeTrack *track = [[STKPXKeyframeTemplate templateForKeyframe:keyframe propertyHandlers:handlers_] trackForKeyPath:@"opacity"];
+    STKPXAnimationSpec *zeroDuration = [[STKPXAnimationSpec alloc] initWithTrack:track info:[self infoWithDuration:0.0f]];
+    STKPXAnimationSpec *first = [[STKPXAnimationSpec alloc] initWithTrack:track info:[self infoWithDuration:1.0f]];
+    STKPXAnimationSpec *second = [[STKPXAnimationSpec alloc] initWithTrack:track info:[self infoWithDuration:3.0f]];
+    NSMutableArray *removed = [[NSMutableArray alloc] init];
+    NSMutableArray *added = [[NSMutableArray alloc] init];
+
+    XCTAssertFalse(zeroDuration.isValid);
+
+    [STKPXAnimationSpec diffAttachedSpecs:nil withSpecs:@[ zeroDuration, first, second ] removedKeys:removed addedSpecs:added];
+
+    XCTAssertEqual(removed.count, 0);
+    XCTAssertEqualObjects(added, @[ first ]);
+}
+
+#pragma mark - Benchmarks
+
+- (void)testRestyleThroughput
+{
+    NSUInteger views = 500;
+    NSMutableArray *blocks = [[NSMutableArray alloc] init];
+
+    for (NSUInteger i = 0; i <= 10; i++)
+    {
+        [blocks addObject:@[ @(i / 10.0), @{ @"opacity": [NSString stringWithFormat:@"%f", i / 10.0],
+                                             @"left": [NSString stringWithFormat:@"%lu", (unsigned long) i * 5] } ]];
+    }
+
+    STKPXKeyframe *keyframe = [self keyframeNamed:@"pulse" blocks:blocks];
+    NSMutableArray *attached = [[NSMutableArray alloc] initWithCapacity:views];
+
+    for (NSUInteger i = 0; i < views; i++)
+    {
+        STKPXKeyframeTemplate *template = [STKPXKeyframeTemplate templateForKeyframe:keyframe propertyHandlers:handlers_];
+
+        [attached addObject:[self attachedFromSpecs:[self specsForTemplate:template info:[self infoWithDuration:1.0f]]]];
+    }
+
+    __block NSUInteger changes = 0;
+
+    // what every layout-triggered restyle used to do: recompile the keyframes and attach everything again
+    STKBenchmarkSample *recompiled = [RECORDER measure:@"animation.restyle.recompile" iterations:10 items:views block:^{
+        changes = 0;
+
+        for (NSUInteger i = 0; i < views; i++)
+        {
+            STKPXKeyframeTemplate *template = [[STKPXKeyframeTemplate alloc] initWithKeyframe:keyframe propertyHandlers:handlers_];
+
+            changes += [self specsForTemplate:template info:[self infoWithDuration:1.0f]].count;
+        }
+    }];
+
+    STKBenchmarkSample *diffed = [RECORDER measure:@"animation.restyle.template_diff" iterations:10 items:views block:^{
+        changes = 0;
+
+        for (NSUInteger i = 0; i < views; i++)
+        {
+            STKPXKeyframeTemplate *template = [STKPXKeyframeTemplate templateForKeyframe:keyframe propertyHandlers:handlers_];
+            NSArray *specs = [self specsForTemplate:template info:[self infoWithDuration:1.0f]];
+            NSMutableArray *removed = [[NSMutableArray alloc] init];
+            NSMutableArray *added = [[NSMutableArray alloc] init];
+
+            [STKPXAnimationSpec diffAttachedSpecs:attached[i] withSpecs:specs removedKeys:removed addedSpecs:added];
+            changes += removed.count + added.count;
+        }
+    }];
+
+    recompiled.metrics[@"keyframe_blocks"] = @(blocks.count);
+    diffed.metrics[@"keyframe_blocks"] = @(blocks.count);
+    diffed.metrics[@"animations_changed"] = @(changes);
+
+    XCTAssertEqual(changes, 0);
+}
+
+@end
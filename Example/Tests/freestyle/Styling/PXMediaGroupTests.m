@@ -0,0 +1,120 @@
+//
+//  PXMediaGroupTests.m
+//  StylingKit
+//
+
+#import <XCTest/XCTest.h>
+#import "STKPXStylesheet.h"
+#import "STKPXStylesheet-Private.h"
+#import "STKPXStylesheetParser.h"
+#import "STKPXMediaGroup.h"
+#import "PXDOMElement.h"
+#import "STKBenchmarkTreeBuilder.h"
+
+@interface PXMediaGroupTests : XCTestCase
+@end
+
+@implementation PXMediaGroupTests
+
+#pragma mark - Helpers
+
+- (STKPXMediaGroup *)mediaGroupFromSource:(NSString *)source
+{
+    STKPXStylesheetParser *parser = [[STKPXStylesheetParser alloc] init];
+    STKPXStylesheet *stylesheet = [parser parse:source withOrigin:STKPXStylesheetOriginApplication];
+
+    XCTAssertEqual(parser.errors.count, 0, @"Unexpected parse errors: %@", parser.errors);
+    XCTAssertEqual(stylesheet.mediaGroups.count, 1, @"Expected a single media group");
+
+    return stylesheet.mediaGroups.firstObject;
+}
+
+- (NSArray *)indexesOfRuleSets:(NSArray *)ruleSets inGroup:(STKPXMediaGroup *)group
+{
+    NSMutableArray *result = [[NSMutableArray alloc] init];
+
+    for (STKPXRuleSet *ruleSet in ruleSets)
+    {
+        [result addObject:@([group.ruleSets indexOfObjectIdenticalTo:ruleSet])];
+    }
+
+    return result;
+}
+
+#pragma mark - Tests
+
+- (void)testCandidatesAreInSourceOrderWithoutDuplicates
+{
+    STKPXMediaGroup *group = [self mediaGroupFromSource:@"button.a.b { color: red; } #x { color: red; } .b { color: red; } * { color: red; } button { color: red; } .a { color: red; }"];
+    PXDOMElement *element = [[PXDOMElement alloc] initWithName:@"button"];
+
+    [element setAttributeValue:@"x" forName:@"id"];
+    [element setAttributeValue:@"a b" forName:@"class"];
+
+    NSArray *candidates = [self indexesOfRuleSets:[group ruleSetsForStyleable:element] inGroup:group];
+    NSArray *expected = @[ @0, @1, @2, @3, @4, @5 ];
+
+    XCTAssertEqualObjects(candidates, expected);
+}
+
+- (void)testAttributeRuleSetsRequireAttribute
+{
+    STKPXMediaGroup *group = [self mediaGroupFromSource:@"[title] { color: red; } [title=\"x\"] { color: red; } * { color: red; }"];
+    PXDOMElement *withoutTitle = [[PXDOMElement alloc] initWithName:@"view"];
+    PXDOMElement *withTitle = [[PXDOMElement alloc] initWithName:@"view"];
+
+    [withTitle setAttributeValue:@"y" forName:@"title"];
+
+    XCTAssertEqualObjects([self indexesOfRuleSets:[group ruleSetsForStyleable:withoutTitle] inGroup:group], @[ @2 ]);
+    XCTAssertEqualObjects([self indexesOfRuleSets:[group ruleSetsForStyleable:withTitle] inGroup:group], (@[ @0, @1, @2 ]));
+}
+
+- (void)testStructuralPseudoClassRuleSetsRequirePosition
+{
+    STKPXMediaGroup *group = [self mediaGroupFromSource:@":first-child { color: red; } view { color: red; }"];
+    PXDOMElement *parent = [[PXDOMElement alloc] initWithName:@"window"];
+    PXDOMElement *first = [[PXDOMElement alloc] initWithName:@"view"];
+    PXDOMElement *second = [[PXDOMElement alloc] initWithName:@"view"];
+
+    [parent addChild:first];
+    [parent addChild:second];
+
+    XCTAssertEqualObjects([self indexesOfRuleSets:[group ruleSetsForStyleable:first] inGroup:group], (@[ @0, @1 ]));
+    XCTAssertEqualObjects([self indexesOfRuleSets:[group ruleSetsForStyleable:second] inGroup:group], @[ @1 ]);
+}
+
+- (void)testCandidatesMatchFullScan
+{
+    STKBenchmarkTreeBuilder *builder = [[STKBenchmarkTreeBuilder alloc] init];
+    NSArray *nodes = [STKBenchmarkTreeBuilder flattenTree:[builder buildTree]];
+    STKPXMediaGroup *group = [self mediaGroupFromSource:[builder stylesheetSourceWithRuleCount:500
+                                                                               selectorKinds:STKBenchmarkSelectorKindAll]];
+
+    for (PXDOMElement *node in nodes)
+    {
+        NSMutableArray *expected = [[NSMutableArray alloc] init];
+        NSMutableArray *actual = [[NSMutableArray alloc] init];
+
+        for (STKPXRuleSet *ruleSet in group.ruleSets)
+        {
+            if ([ruleSet matches:node])
+            {
+                [expected addObject:ruleSet];
+            }
+        }
+
+        for (STKPXRuleSet *ruleSet in [group ruleSetsForStyleable:node])
+        {
+            if ([ruleSet matches:node])
+            {
+                [actual addObject:ruleSet];
+            }
+        }
+
+        XCTAssertEqualObjects([self indexesOfRuleSets:actual inGroup:group],
+                              [self indexesOfRuleSets:expected inGroup:group],
+                              @"Candidate lookup lost matches for %@", node);
+    }
+}
+
+@end
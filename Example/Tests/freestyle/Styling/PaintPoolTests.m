@@ -0,0 +1,143 @@
+//
+//  PaintPoolTests.m
+//  StylingKit
+//
+
+#import <XCTest/XCTest.h>
+#import "STKPXValueParser.h"
+#import "STKPXPaintPool.h"
+#import "STKPXLinearGradient.h"
+#import "STKPXRadialGradient.h"
+#import "STKPXSolidPaint.h"
+
+@interface PaintPoolTests : XCTestCase
+@end
+
+@implementation PaintPoolTests
+
+- (void)setUp
+{
+    [super setUp];
+
+    [STKPXPaintPool sharedInstance].enabled = YES;
+    [[STKPXPaintPool sharedInstance] removeAllObjects];
+    [[STKPXPaintPool sharedInstance] resetCounters];
+}
+
+- (void)tearDown
+{
+    [STKPXPaintPool sharedInstance].enabled = YES;
+
+    [super tearDown];
+}
+
+#pragma mark - Helpers
+
+- (UIColor *)colorFromSource:(NSString *)source
+{
+    STKPXValueParser *parser = [[STKPXValueParser alloc] init];
+
+    return [parser parseColor:[STKPXValueParser lexemesForSource:source]];
+}
+
+- (id<STKPXPaint>)paintFromSource:(NSString *)source
+{
+    STKPXValueParser *parser = [[STKPXValueParser alloc] init];
+
+    return [parser parsePaint:[STKPXValueParser lexemesForSource:source]];
+}
+
+#pragma mark - Colors
+
+- (void)testEqualColorsShareOneInstance
+{
+    UIColor *hex = [self colorFromSource:@"#336699"];
+    UIColor *again = [self colorFromSource:@"#336699"];
+    UIColor *shorthand = [self colorFromSource:@"#369"];
+
+    XCTAssertEqual(hex, again);
+    XCTAssertEqual(hex, shorthand);
+    XCTAssertEqual([STKPXPaintPool sharedInstance].colorHits, 2);
+}
+
+- (void)testDifferentColorsStayDistinct
+{
+    UIColor *opaque = [self colorFromSource:@"#336699"];
+    UIColor *translucent = [self colorFromSource:@"rgba(51, 102, 153, 0.5)"];
+
+    XCTAssertNotEqual(opaque, translucent);
+    XCTAssertFalse([opaque isEqual:translucent]);
+    XCTAssertEqual([STKPXPaintPool sharedInstance].colorCount, 2);
+}
+
+- (void)testPooledColorsMatchUnpooledColors
+{
+    NSArray *sources = @[ @"#f00", @"#00ff0080", @"rgba(10%, 20%, 30%, 0.4)", @"hsl(120, 50%, 50%)", @"red" ];
+    NSMutableArray *unpooled = [[NSMutableArray alloc] init];
+
+    [STKPXPaintPool sharedInstance].enabled = NO;
+
+    for (NSString *source in sources)
+    {
+        [unpooled addObject:[self colorFromSource:source]];
+    }
+
+    [STKPXPaintPool sharedInstance].enabled = YES;
+
+    [sources enumerateObjectsUsingBlock:^(NSString *source, NSUInteger i, BOOL *stop) {
+        XCTAssertEqualObjects([self colorFromSource:source], unpooled[i], @"%@", source);
+    }];
+}
+
+- (void)testDisabledPoolReturnsNewInstances
+{
+    [STKPXPaintPool sharedInstance].enabled = NO;
+
+    XCTAssertNotEqual([self colorFromSource:@"#336699"], [self colorFromSource:@"#336699"]);
+}
+
+#pragma mark - Gradients
+
+- (void)testEqualGradientsShareOneCGGradient
+{
+    STKPXLinearGradient *first = (STKPXLinearGradient *) [self paintFromSource:@"linear-gradient(to bottom, #fff, #336699)"];
+    STKPXLinearGradient *second = (STKPXLinearGradient *) [self paintFromSource:@"linear-gradient(to bottom, #fff, #336699)"];
+
+    XCTAssertTrue([first isKindOfClass:[STKPXLinearGradient class]]);
+    XCTAssertEqual(first, second);
+    XCTAssertTrue(first.gradient != NULL);
+    XCTAssertEqual([STKPXPaintPool sharedInstance].gradientHits, 1);
+
+    // stops shared with plain colors resolve to the same instances
+    XCTAssertEqual(first.colors[1], [self colorFromSource:@"#336699"]);
+
+    // interning leaves the parsed stop list alone
+    XCTAssertEqual(first.offsets.count, 0);
+}
+
+- (void)testDifferentGradientsStayDistinct
+{
+    id<STKPXPaint> linear = [self paintFromSource:@"linear-gradient(#fff, #336699)"];
+    id<STKPXPaint> angled = [self paintFromSource:@"linear-gradient(45deg, #fff, #336699)"];
+    id<STKPXPaint> blended = [self paintFromSource:@"linear-gradient(#fff, #336699) multiply"];
+    id<STKPXPaint> radial = [self paintFromSource:@"radial-gradient(#fff, #336699)"];
+
+    XCTAssertNotEqual(linear, angled);
+    XCTAssertNotEqual(linear, blended);
+    XCTAssertNotEqual(linear, radial);
+    XCTAssertEqual(blended.blendMode, kCGBlendModeMultiply);
+    XCTAssertTrue([radial isKindOfClass:[STKPXRadialGradient class]]);
+    XCTAssertEqual([STKPXPaintPool sharedInstance].gradientCount, 4);
+}
+
+- (void)testGradientEqualityIgnoresCGGradient
+{
+    STKPXLinearGradient *rendered = [STKPXLinearGradient gradientFromStartColor:[UIColor whiteColor] endColor:[UIColor blackColor]];
+    STKPXLinearGradient *fresh = [STKPXLinearGradient gradientFromStartColor:[UIColor whiteColor] endColor:[UIColor blackColor]];
+
+    XCTAssertTrue(rendered.gradient != NULL);
+    XCTAssertEqualObjects(rendered, fresh);
+    XCTAssertEqual(rendered.hash, fresh.hash);
+}
+
+@end
@@ -0,0 +1,352 @@
+//
+//  RestyleSchedulerTests.m
+//  StylingKit
+//
+
+#import <XCTest/XCTest.h>
+#import "StyleableView.h"
+#import "STKPXRestyleScheduler.h"
+#import "STKBenchmarkRecorder.h"
+
+static STKBenchmarkRecorder *RECORDER;
+
+@interface RestyleSchedulerTests : XCTestCase
+@end
+
+@implementation RestyleSchedulerTests
+{
+    STKPXRestyleScheduler *scheduler_;
+    NSMutableArray *turns_;
+    NSMutableArray *styled_;
+    NSMutableArray *recursiveFlags_;
+    NSTimeInterval now_;
+    NSTimeInterval styleCost_;
+}
+
++ (void)setUp
+{
+    [super setUp];
+
+    RECORDER = [[STKBenchmarkRecorder alloc] initWithSuiteName:@"RestyleSchedulerTests"];
+}
+
++ (void)tearDown
+{
+    [RECORDER writeReport];
+    RECORDER = nil;
+
+    [super tearDown];
+}
+
+- (void)setUp
+{
+    [super setUp];
+
+    turns_ = [NSMutableArray array];
+    styled_ = [NSMutableArray array];
+    recursiveFlags_ = [NSMutableArray array];
+    now_ = 0;
+    styleCost_ = 0;
+
+    __weak RestyleSchedulerTests *weakSelf = self;
+
+    scheduler_ = [[STKPXRestyleScheduler alloc] init];
+    scheduler_.clock = ^NSTimeInterval {
+        return weakSelf->now_;
+    };
+    scheduler_.turn = ^(dispatch_block_t pass) {
+        [weakSelf->turns_ addObject:pass];
+    };
+    scheduler_.styler = ^(id<STKPXStyleable> styleable, BOOL recursive) {
+        RestyleSchedulerTests *test = weakSelf;
+
+        [test->styled_ addObject:styleable];
+        [test->recursiveFlags_ addObject:@(recursive)];
+        test->now_ += test->styleCost_;
+    };
+}
+
+- (void)tearDown
+{
+    scheduler_ = nil;
+    turns_ = nil;
+    styled_ = nil;
+    recursiveFlags_ = nil;
+
+    [super tearDown];
+}
+
+#pragma mark - Helpers
+
+- (void)runTurn
+{
+    XCTAssertTrue(turns_.count > 0);
+
+    dispatch_block_t pass = turns_.firstObject;
+
+    [turns_ removeObjectAtIndex:0];
+    pass();
+}
+
+- (StyleableView *)viewNamed:(NSString *)name inView:(UIView *)parent
+{
+    StyleableView *view = [[StyleableView alloc] initWithElementName:name];
+
+    [parent addSubview:view];
+
+    return view;
+}
+
+- (void)assertEachStyledOnce
+{
+    NSCountedSet *counts = [[NSCountedSet alloc] initWithArray:styled_];
+
+    for (id styleable in counts)
+    {
+        XCTAssertEqual([counts countForObject:styleable], 1, @"%@", styleable);
+    }
+}
+
+#pragma mark - Coalescing Tests
+
+- (void)testCoalescesRequestsUntilNextTurn
+{
+    StyleableView *view = [self viewNamed:@"view" inView:nil];
+
+    [scheduler_ scheduleStyleable:view recursive:NO];
+    [scheduler_ scheduleStyleable:view recursive:NO];
+    [scheduler_ scheduleStyleable:view recursive:NO];
+
+    XCTAssertEqual(styled_.count, 0);
+    XCTAssertEqual(turns_.count, 1);
+    XCTAssertEqual(scheduler_.pendingCount, 1);
+    XCTAssertTrue([scheduler_ isStyleableScheduled:view]);
+
+    [self runTurn];
+
+    XCTAssertEqualObjects(styled_, @[ view ]);
+    XCTAssertEqual(scheduler_.pendingCount, 0);
+    XCTAssertFalse([scheduler_ isStyleableScheduled:view]);
+    XCTAssertEqual(turns_.count, 0);
+}
+
+- (void)testRecursiveRequestWins
+{
+    StyleableView *view = [self viewNamed:@"view" inView:nil];
+
+    [scheduler_ scheduleStyleable:view recursive:NO];
+    [scheduler_ scheduleStyleable:view recursive:YES];
+    [scheduler_ scheduleStyleable:view recursive:NO];
+    [self runTurn];
+
+    XCTAssertEqualObjects(styled_, @[ view ]);
+    XCTAssertEqualObjects(recursiveFlags_, @[ @YES ]);
+}
+
+- (void)testDropsDescendantsOfRecursiveAncestor
+{
+    StyleableView *root = [self viewNamed:@"root" inView:nil];
+    StyleableView *child = [self viewNamed:@"child" inView:root];
+    StyleableView *leaf = [self viewNamed:@"leaf" inView:child];
+    StyleableView *sibling = [self viewNamed:@"sibling" inView:nil];
+
+    [scheduler_ scheduleStyleable:leaf recursive:YES];
+    [scheduler_ scheduleStyleable:child recursive:NO];
+    [scheduler_ scheduleStyleable:sibling recursive:NO];
+    [scheduler_ scheduleStyleable:root recursive:YES];
+    [self runTurn];
+
+    XCTAssertEqualObjects(styled_, (@[ sibling, root ]));
+}
+
+- (void)testKeepsDescendantsOfNonRecursiveAncestor
+{
+    StyleableView *root = [self viewNamed:@"root" inView:nil];
+    StyleableView *child = [self viewNamed:@"child" inView:root];
+    StyleableView *leaf = [self viewNamed:@"leaf" inView:child];
+
+    [scheduler_ scheduleStyleable:leaf recursive:YES];
+    [scheduler_ scheduleStyleable:root recursive:NO];
+    [self runTurn];
+
+    XCTAssertEqualObjects(styled_, (@[ root, leaf ]));
+    XCTAssertEqualObjects(recursiveFlags_, (@[ @NO, @YES ]));
+}
+
+- (void)testOrdersWorkTopDown
+{
+    StyleableView *root = [self viewNamed:@"root" inView:nil];
+    StyleableView *a = [self viewNamed:@"a" inView:root];
+    StyleableView *b = [self viewNamed:@"b" inView:root];
+    StyleableView *a1 = [self viewNamed:@"a1" inView:a];
+    StyleableView *b1 = [self viewNamed:@"b1" inView:b];
+
+    for (StyleableView *view in @[ b1, a1, b, root, a ])
+    {
+        [scheduler_ scheduleStyleable:view recursive:NO];
+    }
+
+    [self runTurn];
+
+    XCTAssertEqualObjects(styled_, (@[ root, b, a, b1, a1 ]));
+}
+
+- (void)testRequestsMadeWhileStylingRunNextTurn
+{
+    StyleableView *root = [self viewNamed:@"root" inView:nil];
+    StyleableView *child = [self viewNamed:@"child" inView:root];
+    STKPXRestyleScheduler *scheduler = scheduler_;
+    __weak RestyleSchedulerTests *weakSelf = self;
+
+    scheduler_.styler = ^(id<STKPXStyleable> styleable, BOOL recursive) {
+        [weakSelf->styled_ addObject:styleable];
+
+        // styling the parent dirties the child and the parent itself again
+        if (styleable == root)
+        {
+            [scheduler scheduleStyleable:child recursive:NO];
+            [scheduler scheduleStyleable:root recursive:NO];
+        }
+    };
+
+    [scheduler_ scheduleStyleable:root recursive:NO];
+    [scheduler_ scheduleStyleable:child recursive:NO];
+    [self runTurn];
+
+    XCTAssertEqualObjects(styled_, (@[ root, child ]));
+    XCTAssertEqual(scheduler_.pendingCount, 2);
+    XCTAssertEqual(turns_.count, 1);
+}
+
+#pragma mark - Time Budget Tests
+
+- (void)testTimeBudgetSpillsOverToNextTurn
+{
+    StyleableView *root = [self viewNamed:@"root" inView:nil];
+    NSMutableArray *children = [NSMutableArray array];
+
+    for (NSUInteger i = 0; i < 10; i++)
+    {
+        StyleableView *child = [self viewNamed:[NSString stringWithFormat:@"child%lu", (unsigned long) i] inView:root];
+
+        [children addObject:child];
+        [scheduler_ scheduleStyleable:child recursive:NO];
+    }
+
+    scheduler_.timeBudget = 0.005;
+    styleCost_ = 0.002;
+
+    [self runTurn];
+
+    XCTAssertEqual(styled_.count, 3);
+    XCTAssertEqual(scheduler_.pendingCount, 7);
+    XCTAssertEqual(turns_.count, 1);
+
+    // work carried over keeps its place ahead of newer requests
+    StyleableView *late = [self viewNamed:@"late" inView:root];
+
+    [scheduler_ scheduleStyleable:late recursive:NO];
+    [scheduler_ scheduleStyleable:children[9] recursive:NO];
+
+    XCTAssertEqual(turns_.count, 1);
+
+    while (turns_.count)
+    {
+        [self runTurn];
+    }
+
+    NSMutableArray *expected = [children mutableCopy];
+    [expected addObject:late];
+
+    XCTAssertEqualObjects(styled_, expected);
+    [self assertEachStyledOnce];
+}
+
+- (void)testSlowStyleableStillMakesProgress
+{
+    StyleableView *a = [self viewNamed:@"a" inView:nil];
+    StyleableView *b = [self viewNamed:@"b" inView:nil];
+
+    scheduler_.timeBudget = 0.001;
+    styleCost_ = 1.0;
+
+    [scheduler_ scheduleStyleable:a recursive:NO];
+    [scheduler_ scheduleStyleable:b recursive:NO];
+    [self runTurn];
+
+    XCTAssertEqualObjects(styled_, @[ a ]);
+
+    [self runTurn];
+
+    XCTAssertEqualObjects(styled_, (@[ a, b ]));
+    XCTAssertEqual(turns_.count, 0);
+}
+
+- (void)testFlushIgnoresTimeBudget
+{
+    scheduler_.timeBudget = 0.001;
+    styleCost_ = 1.0;
+
+    for (NSUInteger i = 0; i < 5; i++)
+    {
+        [scheduler_ scheduleStyleable:[self viewNamed:@"view" inView:nil] recursive:NO];
+    }
+
+    [scheduler_ flush];
+
+    XCTAssertEqual(styled_.count, 5);
+    XCTAssertEqual(scheduler_.pendingCount, 0);
+
+    // the pass already requested finds nothing left to do
+    [self runTurn];
+
+    XCTAssertEqual(styled_.count, 5);
+}
+
+#pragma mark - Benchmarks
+
+- (void)testBurstThroughput
+{
+    StyleableView *root = [self viewNamed:@"root" inView:nil];
+    NSMutableArray *views = [NSMutableArray arrayWithObject:root];
+
+    for (NSUInteger i = 0; i < 20; i++)
+    {
+        StyleableView *row = [self viewNamed:@"row" inView:root];
+
+        [views addObject:row];
+
+        for (NSUInteger j = 0; j < 5; j++)
+        {
+            [views addObject:[self viewNamed:@"label" inView:row]];
+        }
+    }
+
+    // every view changes its class and id, then the whole tree is refreshed
+    __block NSUInteger styles = 0;
+    __block NSUInteger batches = 0;
+
+    scheduler_.styler = ^(id<STKPXStyleable> styleable, BOOL recursive) {
+        styles++;
+    };
+
+    STKBenchmarkSample *sample = [RECORDER measure:@"restyle.burst" iterations:50 items:views.count block:^{
+        for (StyleableView *view in views)
+        {
+            [scheduler_ scheduleStyleable:view recursive:NO];
+            [scheduler_ scheduleStyleable:view recursive:YES];
+        }
+
+        [scheduler_ scheduleStyleable:root recursive:YES];
+        [self runTurn];
+        batches++;
+    }];
+
+    sample.metrics[@"requests"] = @(views.count * 2 + 1);
+    sample.metrics[@"stylesPerBatch"] = @(styles / batches);
+
+    // the root subsumes every other request in the batch
+    XCTAssertEqual(styles, batches);
+}
+
+@end
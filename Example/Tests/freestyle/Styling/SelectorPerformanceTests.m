@@ -7,58 +7,712 @@
 //
 
 #import <XCTest/XCTest.h>
+#import <malloc/malloc.h>
+#import <objc/runtime.h>
+#import "STKPXStylesheet.h"
+#import "STKPXStylesheet-Private.h"
+#import "STKPXStylesheetParser.h"
+#import "STKPXStyleInfo.h"
+#import "STKPXRuleSet.h"
+#import "STKPXDeclaration.h"
+#import "STKPXPaintPool.h"
+#import "STKPXStyleUtils.h"
+#import "STKPXStyler.h"
+#import "STKPXTransformStyler.h"
+#import "STKPXOpacityStyler.h"
+#import "STKPXShapeStyler.h"
+#import "STKPXFillStyler.h"
+#import "STKPXBorderStyler.h"
+#import "STKPXBoxShadowStyler.h"
+#import "STKPXAnimationStyler.h"
+#import "PXDOMElement.h"
+#import "StyleableView.h"
+#import "UIView+STKPXStyling.h"
+#import "STKBenchmarkTreeBuilder.h"
+#import "STKBenchmarkRecorder.h"
+
+// Tree and stylesheet sizes may be overridden from the environment, e.g. STK_BENCHMARK_DEPTH=6
+static NSUInteger STKBenchmarkSetting(NSString *name, NSUInteger defaultValue)
+{
+    NSString *value = [NSProcessInfo processInfo].environment[name];
+
+    return (value.length > 0) ? (NSUInteger) value.integerValue : defaultValue;
+}
+
+static STKBenchmarkRecorder *RECORDER;
+
+/**
+ *  A styler that claims the properties of a real styler but only counts calls, so applying a style measures dispatch
+ *  rather than rendering
+ */
+@interface STKBenchmarkCountingStyler : NSObject <STKPXStyler>
+
+@property (nonatomic, readonly) NSArray *supportedProperties;
+@property (nonatomic) NSUInteger processedCount;
+@property (nonatomic) NSUInteger appliedCount;
+
+- (instancetype)initWithStyler:(id<STKPXStyler>)styler;
+
+@end
+
+@implementation STKBenchmarkCountingStyler
+
+- (instancetype)initWithStyler:(id<STKPXStyler>)styler
+{
+    if (self = [super init])
+    {
+        _supportedProperties = styler.supportedProperties;
+    }
+
+    return self;
+}
+
+- (void)processDeclaration:(STKPXDeclaration *)declaration withContext:(STKPXStylerContext *)context
+{
+    _processedCount++;
+}
+
+- (void)applyStylesWithContext:(STKPXStylerContext *)context
+{
+    _appliedCount++;
+}
+
+@end
+
+/**
+ *  An element with the styler list of a table view cell
+ */
+@interface STKBenchmarkStyledCell : PXDOMElement
+
+@property (nonatomic, copy) NSArray *viewStylers;
+
+@end
+
+@implementation STKBenchmarkStyledCell
+
+- (NSDictionary *)viewStylersByProperty
+{
+    return [STKPXStyleUtils viewStylerPropertyMapForStyleable:self];
+}
+
+- (void)updateStyleWithRuleSet:(STKPXRuleSet *)ruleSet context:(STKPXStylerContext *)context
+{
+    // no-op, keep the element unchanged between runs
+}
+
+@end
+
+/**
+ *  Views whose class a test can swap in, as dynamic subclassing does
+ */
+@interface STKBenchmarkSwappedView : StyleableView
+@end
+
+@implementation STKBenchmarkSwappedView
+@end
+
+@interface STKBenchmarkRegisteredView : UIView
+@end
+
+@implementation STKBenchmarkRegisteredView
+@end
 
 @interface SelectorPerformanceTests : XCTestCase
 @end
 
 @implementation SelectorPerformanceTests
+{
+    STKBenchmarkTreeBuilder *builder_;
+    NSArray *nodes_;
+    NSUInteger ruleCount_;
+    NSUInteger iterations_;
+}
+
++ (void)setUp
+{
+    [super setUp];
+
+    RECORDER = [[STKBenchmarkRecorder alloc] initWithSuiteName:@"SelectorPerformanceTests"];
+}
+
++ (void)tearDown
+{
+    [RECORDER writeReport];
+    RECORDER = nil;
+
+    [super tearDown];
+}
 
 - (void)setUp
 {
     [super setUp];
-    // Put setup code here; it will be run once, before the first test case.
+
+    builder_ = [[STKBenchmarkTreeBuilder alloc] init];
+    builder_.depth = STKBenchmarkSetting(@"STK_BENCHMARK_DEPTH", 4);
+    builder_.fanOut = STKBenchmarkSetting(@"STK_BENCHMARK_FANOUT", 4);
+    builder_.classCount = STKBenchmarkSetting(@"STK_BENCHMARK_CLASSES", 32);
+    builder_.seed = (uint32_t) STKBenchmarkSetting(@"STK_BENCHMARK_SEED", 1);
+
+    nodes_ = [STKBenchmarkTreeBuilder flattenTree:[builder_ buildTree]];
+    ruleCount_ = STKBenchmarkSetting(@"STK_BENCHMARK_RULES", 2000);
+    iterations_ = STKBenchmarkSetting(@"STK_BENCHMARK_ITERATIONS", 10);
 }
 
 - (void)tearDown
 {
-    // Put teardown code here; it will be run once, after the last test case.
+    nodes_ = nil;
+    builder_ = nil;
+
     [super tearDown];
 }
 
+#pragma mark - Helpers
+
+- (STKPXStylesheet *)stylesheetWithKinds:(STKBenchmarkSelectorKind)kinds
+{
+    NSString *source = [builder_ stylesheetSourceWithRuleCount:ruleCount_ selectorKinds:kinds];
+    STKPXStylesheetParser *parser = [[STKPXStylesheetParser alloc] init];
+    STKPXStylesheet *stylesheet = [parser parse:source withOrigin:STKPXStylesheetOriginApplication];
+
+    XCTAssertEqual(parser.errors.count, 0, @"Unexpected parse errors: %@", parser.errors);
+
+    return stylesheet;
+}
+
+- (void)measureMatchingWithKinds:(STKBenchmarkSelectorKind)kinds name:(NSString *)name
+{
+    STKPXStylesheet *stylesheet = [self stylesheetWithKinds:kinds];
+    NSArray *nodes = nodes_;
+    __block NSUInteger matches = 0;
+
+    STKBenchmarkSample *sample = [RECORDER measure:[@"match." stringByAppendingString:name]
+                                        iterations:iterations_
+                                             items:nodes.count
+                                             block:^{
+        matches = 0;
+
+        for (PXDOMElement *node in nodes)
+        {
+            matches += [stylesheet ruleSetsMatchingStyleable:node].count;
+        }
+    }];
+
+    sample.metrics[@"rules"] = @(ruleCount_);
+    sample.metrics[@"matches_per_node"] = @((double) matches / nodes.count);
+
+    XCTAssertTrue(sample.iterations > 0);
+}
+
+#pragma mark - Parsing
+
+- (void)testParseLargeCSS
+{
+    NSString *path = [[NSBundle bundleForClass:self.class] pathForResource:@"large" ofType:@"css"];
+    NSString *source = [NSString stringWithContentsOfFile:path encoding:NSUTF8StringEncoding error:NULL];
+
+    XCTAssertTrue(source.length > 0, @"Expected large.css in the test bundle");
+
+    STKBenchmarkSample *sample = [RECORDER measure:@"parse.large_css" iterations:iterations_ items:1 block:^{
+        STKPXStylesheetParser *parser = [[STKPXStylesheetParser alloc] init];
+
+        [parser parse:source withOrigin:STKPXStylesheetOriginApplication];
+    }];
+
+    sample.metrics[@"bytes"] = @(source.length);
+}
+
+- (void)testParseLargeCSSPaints
+{
+    NSString *path = [[NSBundle bundleForClass:self.class] pathForResource:@"large" ofType:@"css"];
+    NSString *source = [NSString stringWithContentsOfFile:path encoding:NSUTF8StringEncoding error:NULL];
+    STKPXPaintPool *pool = [STKPXPaintPool sharedInstance];
+
+    // parse and resolve every color declaration, returning the distinct objects the declarations hold
+    NSHashTable *(^resolveColors)(NSUInteger *) = ^NSHashTable *(NSUInteger *resolved) {
+        STKPXStylesheetParser *parser = [[STKPXStylesheetParser alloc] init];
+        STKPXStylesheet *stylesheet = [parser parse:source withOrigin:STKPXStylesheetOriginApplication];
+        NSHashTable *values = [NSHashTable hashTableWithOptions:NSPointerFunctionsObjectPointerPersonality];
+
+        *resolved = 0;
+
+        for (STKPXRuleSet *ruleSet in stylesheet.ruleSets)
+        {
+            for (STKPXDeclaration *declaration in ruleSet.declarations)
+            {
+                if ([declaration.name hasSuffix:@"color"] && declaration.colorValue)
+                {
+                    [values addObject:declaration.colorValue];
+                    (*resolved)++;
+                }
+            }
+        }
+
+        return values;
+    };
+
+    NSUInteger (^retainedBytes)(NSHashTable *) = ^NSUInteger(NSHashTable *values) {
+        NSUInteger result = 0;
+
+        for (id value in values)
+        {
+            result += malloc_size((__bridge const void *) value);
+        }
+
+        return result;
+    };
+
+    __block NSHashTable *unpooledValues;
+    __block NSHashTable *pooledValues;
+    __block NSUInteger resolved;
+
+    pool.enabled = NO;
+
+    STKBenchmarkSample *unpooled = [RECORDER measure:@"parse.large_css.colors.unpooled" iterations:iterations_ items:1 block:^{
+        unpooledValues = resolveColors(&resolved);
+    }];
+
+    pool.enabled = YES;
+    [pool removeAllObjects];
+    [pool resetCounters];
+
+    STKBenchmarkSample *pooled = [RECORDER measure:@"parse.large_css.colors.pooled" iterations:iterations_ items:1 block:^{
+        pooledValues = resolveColors(&resolved);
+    }];
+
+    unpooled.metrics[@"declarations"] = @(resolved);
+    unpooled.metrics[@"color_objects"] = @(unpooledValues.count);
+    unpooled.metrics[@"retained_bytes"] = @(retainedBytes(unpooledValues));
+    pooled.metrics[@"declarations"] = @(resolved);
+    pooled.metrics[@"color_objects"] = @(pooledValues.count);
+    pooled.metrics[@"retained_bytes"] = @(retainedBytes(pooledValues));
+    pooled.metrics[@"allocations_avoided"] = @(pool.colorHits);
+
+    XCTAssertTrue(resolved > 0);
+    XCTAssertEqual(pooledValues.count, pool.colorCount);
+    XCTAssertTrue(pooledValues.count < unpooledValues.count);
+}
+
+- (void)testParseGeneratedStylesheet
+{
+    NSString *source = [builder_ stylesheetSourceWithRuleCount:ruleCount_ selectorKinds:STKBenchmarkSelectorKindAll];
+
+    STKBenchmarkSample *sample = [RECORDER measure:@"parse.generated" iterations:iterations_ items:ruleCount_ block:^{
+        STKPXStylesheetParser *parser = [[STKPXStylesheetParser alloc] init];
+
+        [parser parse:source withOrigin:STKPXStylesheetOriginApplication];
+    }];
+
+    sample.metrics[@"bytes"] = @(source.length);
+}
+
+#pragma mark - Matching
+
 - (void)testElementName
 {
+    [self measureMatchingWithKinds:STKBenchmarkSelectorKindElement name:@"element"];
 }
 
 - (void)testId
 {
+    [self measureMatchingWithKinds:STKBenchmarkSelectorKindId name:@"id"];
 }
 
 - (void)testClass
 {
+    [self measureMatchingWithKinds:STKBenchmarkSelectorKindClass name:@"class"];
 }
 
 - (void)testNonCategorizedSelector
 {
+    [self measureMatchingWithKinds:STKBenchmarkSelectorKindUncategorized name:@"uncategorized"];
 }
 
 - (void)testElementNameAndId
 {
+    [self measureMatchingWithKinds:STKBenchmarkSelectorKindElementAndId name:@"element_id"];
 }
 
 - (void)testElementNameAndClass
 {
+    [self measureMatchingWithKinds:STKBenchmarkSelectorKindElementAndClass name:@"element_class"];
 }
 
 - (void)testElementNameWithNonCategorizedSelector
 {
+    [self measureMatchingWithKinds:STKBenchmarkSelectorKindElement | STKBenchmarkSelectorKindUncategorized
+                              name:@"element+uncategorized"];
 }
 
 - (void)testIdWithNonCategorizedSelector
 {
+    [self measureMatchingWithKinds:STKBenchmarkSelectorKindId | STKBenchmarkSelectorKindUncategorized
+                              name:@"id+uncategorized"];
 }
 
 - (void)testClassWithNonCategorizedSelector
 {
+    [self measureMatchingWithKinds:STKBenchmarkSelectorKindClass | STKBenchmarkSelectorKindUncategorized
+                              name:@"class+uncategorized"];
+}
+
+- (void)testCombinators
+{
+    [self measureMatchingWithKinds:STKBenchmarkSelectorKindCombinator name:@"combinator"];
+}
+
+#pragma mark - Candidate collection
+
+// The collection pipeline as it was before rule sets were gathered into a per-thread scratch: one array per media
+// group, one per stylesheet for the candidates, one for the matches and a copy to merge the origins. Only the
+// application stylesheet is set here, the other origins were messages to nil
+static NSMutableArray *STKBenchmarkLegacyMatchingRuleSets(STKPXStylesheet *stylesheet, id<STKPXStyleable> styleable)
+{
+    NSMutableArray *matches = [NSMutableArray array];
+
+    for (STKPXRuleSet *ruleSet in [stylesheet ruleSetsForStyleable:styleable])
+    {
+        if ([ruleSet matches:styleable])
+        {
+            [matches addObject:ruleSet];
+        }
+    }
+
+    return matches.mutableCopy;
+}
+
+- (void)testCandidateCollectionAllocations
+{
+    // keep a reference, the parser registers it as the current application stylesheet
+    STKPXStylesheet *stylesheet = [self stylesheetWithKinds:STKBenchmarkSelectorKindAll];
+    NSArray *nodes = nodes_;
+
+    for (PXDOMElement *node in nodes)
+    {
+        XCTAssertEqualObjects([STKPXStyleUtils matchingRuleSetsForStyleable:node],
+                              STKBenchmarkLegacyMatchingRuleSets(stylesheet, node));
+    }
+
+    STKBenchmarkSample *before = [RECORDER measure:@"collect.legacy" iterations:iterations_ items:nodes.count block:^{
+        for (PXDOMElement *node in nodes)
+        {
+            STKBenchmarkLegacyMatchingRuleSets(stylesheet, node);
+        }
+    }];
+
+    STKBenchmarkSample *after = [RECORDER measure:@"collect.scratch" iterations:iterations_ items:nodes.count block:^{
+        for (PXDOMElement *node in nodes)
+        {
+            [STKPXStyleUtils matchingRuleSetsForStyleable:node];
+        }
+    }];
+
+    before.metrics[@"allocations_per_node"] = @((double) before.allocations / (before.iterations * nodes.count));
+    after.metrics[@"allocations_per_node"] = @((double) after.allocations / (after.iterations * nodes.count));
+
+    XCTAssertLessThanOrEqual(after.allocations, before.allocations);
+}
+
+- (void)testScratchKeepsRuleSetsOfReplacedStylesheet
+{
+    PXDOMElement *node = [[PXDOMElement alloc] initWithName:@"button"];
+    STKPXRuleSetScratch *scratch = STKPXRuleSetScratchAcquire();
+    __weak STKPXStylesheet *weakStylesheet = nil;
+    __weak STKPXRuleSet *weakRuleSet = nil;
+
+    @autoreleasepool
+    {
+        STKPXStylesheetParser *parser = [[STKPXStylesheetParser alloc] init];
+        STKPXStylesheet *stylesheet = [parser parse:@"button { opacity: 0.5; }"
+                                         withOrigin:STKPXStylesheetOriginApplication];
+
+        weakStylesheet = stylesheet;
+        [stylesheet appendRuleSetsMatchingStyleable:node toScratch:scratch];
+
+        // swap the stylesheet out while the scratch still holds its matches
+        [parser parse:@"label { opacity: 0.5; }" withOrigin:STKPXStylesheetOriginApplication];
+        stylesheet = nil;
+    }
+
+    XCTAssertNil(weakStylesheet);
+    XCTAssertEqual(scratch->ruleSetCount, 1);
+
+    @autoreleasepool
+    {
+        weakRuleSet = scratch->ruleSets[0];
+
+        XCTAssertNotNil(weakRuleSet);
+        XCTAssertTrue([weakRuleSet matches:node]);
+    }
+
+    STKPXRuleSetScratchRelinquish(scratch);
+
+    XCTAssertNil(weakRuleSet);
+}
+
+#pragma mark - Cascade
+
+- (void)testCascade
+{
+    // keep a reference, the parser registers it as the current application stylesheet
+    STKPXStylesheet *stylesheet = [self stylesheetWithKinds:STKBenchmarkSelectorKindAll];
+    NSArray *nodes = nodes_;
+    __block NSUInteger styled = 0;
+
+    STKBenchmarkSample *sample = [RECORDER measure:@"cascade.all" iterations:iterations_ items:nodes.count block:^{
+        styled = 0;
+
+        for (PXDOMElement *node in nodes)
+        {
+            if ([STKPXStyleInfo styleInfoForStyleable:node] != nil)
+            {
+                styled++;
+            }
+        }
+    }];
+
+    sample.metrics[@"rules"] = @(stylesheet.ruleSets.count);
+    sample.metrics[@"styled_nodes"] = @(styled);
+}
+
+- (void)testCascadeWithStates
+{
+    NSArray *states = @[ @"normal", @"highlighted", @"selected", @"disabled", @"focused" ];
+
+    builder_.stateNames = states;
+
+    NSArray *nodes = [STKBenchmarkTreeBuilder flattenTree:[builder_ buildTree]];
+    STKPXStylesheet *stylesheet = [self stylesheetWithKinds:STKBenchmarkSelectorKindAll];
+
+    // the single-pass partition has to agree with filtering by each state on its own
+    for (STKBenchmarkStatefulElement *node in nodes)
+    {
+        NSArray *ruleSets = [STKPXStyleUtils matchingRuleSetsForStyleable:node];
+        NSArray *ruleSetsByState = [STKPXStyleUtils partitionRuleSets:ruleSets forStyleable:node byStates:states];
+
+        for (NSUInteger i = 0; i < states.count; i++)
+        {
+            XCTAssertEqualObjects(ruleSetsByState[i],
+                                  [STKPXStyleUtils filterRuleSets:ruleSets forStyleable:node byState:states[i]]);
+        }
+    }
+
+    STKBenchmarkSample *sample = [RECORDER measure:@"cascade.states" iterations:iterations_ items:nodes.count block:^{
+        for (PXDOMElement *node in nodes)
+        {
+            [STKPXStyleInfo styleInfoForStyleable:node];
+        }
+    }];
+
+    sample.metrics[@"rules"] = @(stylesheet.ruleSets.count);
+    sample.metrics[@"states"] = @(states.count);
+}
+
+#pragma mark - Apply
+
+- (void)testApplyWithAllStylersActive
+{
+    NSMutableArray *stylers = [[NSMutableArray alloc] init];
+    NSMutableString *source = [[NSMutableString alloc] initWithString:@"table-view-cell {\n"];
+
+    for (id<STKPXStyler> styler in @[ STKPXTransformStyler.sharedInstance,
+                                      STKPXOpacityStyler.sharedInstance,
+                                      STKPXShapeStyler.sharedInstance,
+                                      STKPXFillStyler.sharedInstance,
+                                      STKPXBorderStyler.sharedInstance,
+                                      STKPXBoxShadowStyler.sharedInstance,
+                                      STKPXAnimationStyler.sharedInstance ])
+    {
+        [stylers addObject:[[STKBenchmarkCountingStyler alloc] initWithStyler:styler]];
+
+        // one declaration per supported property, so every styler has work to do
+        for (NSString *property in styler.supportedProperties)
+        {
+            [source appendFormat:@"    %@: 1px;\n", property];
+        }
+    }
+
+    [source appendString:@"}\n"];
+
+    STKBenchmarkStyledCell *cell = [[STKBenchmarkStyledCell alloc] initWithName:@"table-view-cell"];
+    cell.viewStylers = stylers;
+
+    // keep a reference, the parser registers it as the current application stylesheet
+    STKPXStylesheet *stylesheet = [[[STKPXStylesheetParser alloc] init] parse:source
+                                                                   withOrigin:STKPXStylesheetOriginApplication];
+    STKPXStyleInfo *styleInfo = [STKPXStyleInfo styleInfoForStyleable:cell];
+
+    XCTAssertNotNil(styleInfo);
+    styleInfo.forceInvalidation = YES;
+
+    NSUInteger declarationCount = [styleInfo declarationsForState:@""].count;
+
+    STKBenchmarkSample *sample = [RECORDER measure:@"apply.all_stylers" iterations:iterations_ * 100 items:1 block:^{
+        [styleInfo applyToStyleable:cell];
+    }];
+
+    sample.metrics[@"stylers"] = @(stylers.count);
+    sample.metrics[@"declarations"] = @(declarationCount);
+    sample.metrics[@"rules"] = @(stylesheet.ruleSets.count);
+
+    // every styler processed its declarations and was applied once per run
+    for (STKBenchmarkCountingStyler *styler in stylers)
+    {
+        XCTAssertTrue(styler.appliedCount > 0);
+        XCTAssertEqual(styler.processedCount % styler.appliedCount, 0);
+    }
+}
+
+#pragma mark - Style keys
+
+- (void)assertCachedStyleKeyOfView:(UIView *)view
+{
+    XCTAssertEqualObjects(view.styleKey, [STKPXStyleUtils styleKeyFromStyleable:view]);
+}
+
+- (void)testCachedStyleKeyTracksMutations
+{
+    NSArray *ids = @[ @"header", @"footer", @"row" ];
+    NSArray *classes = @[ @"a", @"b", @"c", @"d" ];
+    StyleableView *view = [[StyleableView alloc] initWithElementName:@"cell"];
+
+    srand48(41);
+    [self assertCachedStyleKeyOfView:view];
+
+    for (NSUInteger i = 0; i < 500; i++)
+    {
+        switch (lrand48() % 5)
+        {
+            case 0:
+                view.styleId = ids[lrand48() % ids.count];
+                break;
+
+            case 1:
+                view.styleId = nil;
+                break;
+
+            case 2:
+                view.styleClass = [NSString stringWithFormat:@"%@ %@", classes[lrand48() % classes.count], classes[lrand48() % classes.count]];
+                break;
+
+            case 3:
+                [view addStyleClass:classes[lrand48() % classes.count]];
+                break;
+
+            case 4:
+                [view removeStyleClass:classes[lrand48() % classes.count]];
+                break;
+        }
+
+        // ask twice: once to build the key, once to read it back
+        [self assertCachedStyleKeyOfView:view];
+        [self assertCachedStyleKeyOfView:view];
+    }
+}
+
+- (void)testCachedStyleKeyFollowsClassAndElementName
+{
+    StyleableView *view = [[StyleableView alloc] initWithElementName:@"cell"];
+    NSString *before = view.styleKey;
+
+    // swapping the class, as dynamic subclassing does, changes the key without a setter being called
+    object_setClass(view, [STKBenchmarkSwappedView class]);
+
+    XCTAssertNotEqualObjects(view.styleKey, before);
+    [self assertCachedStyleKeyOfView:view];
+
+    STKBenchmarkRegisteredView *registered = [[STKBenchmarkRegisteredView alloc] init];
+    NSString *name = [NSString stringWithFormat:@"registered-%u", arc4random()];
+
+    [registered styleKey];
+    [UIView setElementName:name forClass:[STKBenchmarkRegisteredView class]];
+
+    XCTAssertTrue([registered.styleKey rangeOfString:name].location != NSNotFound);
+    [self assertCachedStyleKeyOfView:registered];
+}
+
+- (void)testCachedStyleKeysAreShared
+{
+    StyleableView *first = [[StyleableView alloc] initWithElementName:@"cell"];
+    StyleableView *second = [[StyleableView alloc] initWithElementName:@"cell"];
+
+    first.styleId = second.styleId = @"shared";
+    first.styleClass = second.styleClass = @"one";
+
+    XCTAssertEqual(first.styleKey, second.styleKey);
+}
+
+- (void)testStyleKeys
+{
+    NSUInteger count = STKBenchmarkSetting(@"STK_BENCHMARK_STYLEABLES", 4000);
+    NSMutableArray *views = [[NSMutableArray alloc] initWithCapacity:count];
+    __block NSUInteger length = 0;
+
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        StyleableView *view = [[StyleableView alloc] initWithElementName:(i % 2) ? @"cell" : @"label"];
+
+        view.styleId = [NSString stringWithFormat:@"item-%lu", (unsigned long) (i % 50)];
+        view.styleClass = [NSString stringWithFormat:@"row row-%lu %@", (unsigned long) (i % 7), (i % 3) ? @"odd" : @"even"];
+        [views addObject:view];
+    }
+
+    // a styling pass asks for the key when creating the style info, when applying it and for the style tree
+    STKBenchmarkSample *fresh = [RECORDER measure:@"style_key.fresh" iterations:iterations_ items:count block:^{
+        length = 0;
+
+        for (UIView *view in views)
+        {
+            for (NSUInteger i = 0; i < 3; i++)
+            {
+                length += [STKPXStyleUtils styleKeyFromStyleable:view].length;
+            }
+        }
+    }];
+
+    STKBenchmarkSample *cached = [RECORDER measure:@"style_key.cached" iterations:iterations_ items:count block:^{
+        length = 0;
+
+        for (UIView *view in views)
+        {
+            for (NSUInteger i = 0; i < 3; i++)
+            {
+                length += view.styleKey.length;
+            }
+        }
+    }];
+
+    NSMutableSet *distinct = [[NSMutableSet alloc] init];
+
+    for (UIView *view in views)
+    {
+        [distinct addObject:[NSValue valueWithNonretainedObject:view.styleKey]];
+    }
+
+    fresh.metrics[@"styleables"] = @(count);
+    cached.metrics[@"styleables"] = @(count);
+    cached.metrics[@"key_instances"] = @(distinct.count);
+
+    XCTAssertTrue(length > 0);
+    XCTAssertTrue(distinct.count < count);
+}
+
+#pragma mark - Memory
+
+- (void)testStylesheetMemory
+{
+    NSString *source = [builder_ stylesheetSourceWithRuleCount:ruleCount_ selectorKinds:STKBenchmarkSelectorKindAll];
+    NSMutableArray *retained = [[NSMutableArray alloc] init];
+
+    // every run keeps its stylesheet alive, so heap growth of the sample is what one parsed stylesheet costs
+    STKBenchmarkSample *sample = [RECORDER measure:@"memory.generated_stylesheet" iterations:1 items:ruleCount_ block:^{
+        STKPXStylesheetParser *parser = [[STKPXStylesheetParser alloc] init];
+
+        [retained addObject:[parser parse:source withOrigin:STKPXStylesheetOriginApplication]];
+    }];
+
+    sample.metrics[@"bytes_per_rule"] = @((double) sample.heapBytes / ruleCount_);
+
+    XCTAssertTrue(retained.count > 0);
 }
 
 @end
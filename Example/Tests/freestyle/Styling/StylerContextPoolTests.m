@@ -0,0 +1,326 @@
+//
+//  StylerContextPoolTests.m
+//  StylingKit
+//
+
+#import <XCTest/XCTest.h>
+#import <objc/runtime.h>
+#import "StyleableView.h"
+#import "STKPXStylerContext.h"
+#import "STKPXShape.h"
+#import "STKPXBoxModel.h"
+#import "STKPXOffsets.h"
+#import "STKPXShadow.h"
+#import "STKPXSolidPaint.h"
+#import "STKPXDimension.h"
+#import "STKBenchmarkRecorder.h"
+
+static STKBenchmarkRecorder *RECORDER;
+
+@interface StylerContextPoolTests : XCTestCase
+@end
+
+@implementation StylerContextPoolTests
+
++ (void)setUp
+{
+    [super setUp];
+
+    RECORDER = [[STKBenchmarkRecorder alloc] initWithSuiteName:@"StylerContextPoolTests"];
+}
+
++ (void)tearDown
+{
+    [RECORDER writeReport];
+    RECORDER = nil;
+
+    [super tearDown];
+}
+
+- (void)setUp
+{
+    [super setUp];
+
+    // start every test with an empty pool on this thread
+    [[NSThread currentThread].threadDictionary removeObjectForKey:@"STKPXStylerContextPool"];
+}
+
+#pragma mark - Helpers
+
+- (NSArray *)comparablePropertyNames
+{
+    // these are computed on demand: the lazy ones are checked through their ivars, and the rest render or hit the font
+    // registry
+    NSSet *excluded = [NSSet setWithArray:@[ @"shape", @"boxModel", @"backgroundImage", @"font" ]];
+    NSMutableArray *names = [[NSMutableArray alloc] init];
+    unsigned int count = 0;
+    objc_property_t *properties = class_copyPropertyList([STKPXStylerContext class], &count);
+
+    for (unsigned int i = 0; i < count; i++)
+    {
+        NSString *name = @(property_getName(properties[i]));
+
+        if (![excluded containsObject:name])
+        {
+            [names addObject:name];
+        }
+    }
+
+    free(properties);
+
+    return names;
+}
+
+- (void)dirtyContext:(STKPXStylerContext *)context withStyleable:(id<STKPXStyleable>)styleable
+{
+    STKPXShadow *inner = [[STKPXShadow alloc] init];
+    STKPXShadow *outer = [[STKPXShadow alloc] init];
+
+    inner.inset = YES;
+    inner.color = [UIColor blackColor];
+    outer.color = [UIColor blackColor];
+
+    context.styleable = styleable;
+    context.activeStateName = @"highlighted";
+    context.styleHash = 42;
+
+    context.shape.fill = [STKPXSolidPaint paintWithColor:[UIColor redColor]];
+    context.top = 1.0f;
+    context.left = 2.0f;
+    context.width = 3.0f;
+    context.height = 4.0f;
+    context.bounds = CGRectMake(1.0f, 2.0f, 3.0f, 4.0f);
+    context.padding = [[STKPXOffsets alloc] initWithTop:1.0f right:2.0f bottom:3.0f left:4.0f];
+    context.transform = CGAffineTransformMakeScale(2.0f, 2.0f);
+
+    [context.boxModel setBorderPaint:[STKPXSolidPaint paintWithColor:[UIColor blueColor]] width:2.0f style:STKPXBorderStyleSolid];
+    [context.boxModel setCornerRadius:5.0f];
+
+    context.fill = [STKPXSolidPaint paintWithColor:[UIColor greenColor]];
+    context.imageFill = [STKPXSolidPaint paintWithColor:[UIColor whiteColor]];
+    context.shadow = inner;
+    context.shadow = outer;
+    context.textShadow = outer;
+    context.opacity = 0.5f;
+    context.imageSize = CGSizeMake(10.0f, 10.0f);
+    context.insets = UIEdgeInsetsMake(1.0f, 1.0f, 1.0f, 1.0f);
+    context.barMetricsVerticalOffset = [[STKPXDimension alloc] initWithNumber:3 withDimension:@"pt"];
+
+    context.fontName = @"Courier";
+    context.fontStyle = @"italic";
+    context.fontWeight = @"bold";
+    context.fontStretch = @"condensed";
+    context.fontSize = 30.0f;
+    context.text = @"text";
+    context.transformedText = @"TEXT";
+    context.letterSpacing = [[STKPXDimension alloc] initWithNumber:2 withDimension:@"pt"];
+    context.textTransform = @"uppercase";
+    context.textDecoration = @"underline";
+
+    context.shadowBounds = CGRectMake(0.0f, 0.0f, 5.0f, 5.0f);
+    context.shadowUrl = [NSURL URLWithString:@"bundle://shadow.png"];
+    context.shadowImage = [[UIImage alloc] init];
+    context.shadowInsets = UIEdgeInsetsMake(2.0f, 2.0f, 2.0f, 2.0f);
+    context.shadowPadding = 3.0f;
+
+    context.animationInfos = [@[ @"animation" ] mutableCopy];
+    context.transitionInfos = [@[ @"transition" ] mutableCopy];
+
+    for (NSString *name in @[ @"color", @"paint", @"text-attributes", @"frame", @"text-attributes-normal" ])
+    {
+        [context setPropertyValue:@"value" forName:name];
+    }
+}
+
+#pragma mark - Pool Tests
+
+- (void)testDequeueReusesRecycledContext
+{
+    STKPXStylerContext *context = [STKPXStylerContext dequeueReusableContext];
+
+    [STKPXStylerContext recycleContext:context];
+
+    XCTAssertEqual([STKPXStylerContext dequeueReusableContext], context);
+    XCTAssertNotEqual([STKPXStylerContext dequeueReusableContext], context);
+}
+
+- (void)testNestedDequeuesGetDistinctContexts
+{
+    STKPXStylerContext *outer = [STKPXStylerContext dequeueReusableContext];
+    STKPXStylerContext *inner = [STKPXStylerContext dequeueReusableContext];
+
+    XCTAssertNotEqual(outer, inner);
+
+    [STKPXStylerContext recycleContext:inner];
+    [STKPXStylerContext recycleContext:outer];
+
+    // last in, first out
+    XCTAssertEqual([STKPXStylerContext dequeueReusableContext], outer);
+    XCTAssertEqual([STKPXStylerContext dequeueReusableContext], inner);
+}
+
+- (void)testPoolIsBounded
+{
+    NSMutableArray *contexts = [[NSMutableArray alloc] init];
+
+    for (NSUInteger i = 0; i < 20; i++)
+    {
+        [contexts addObject:[STKPXStylerContext dequeueReusableContext]];
+    }
+
+    [STKPXStylerContext recycleContext:nil];
+
+    for (STKPXStylerContext *context in contexts)
+    {
+        [STKPXStylerContext recycleContext:context];
+    }
+
+    NSArray *pool = [NSThread currentThread].threadDictionary[@"STKPXStylerContextPool"];
+
+    XCTAssertEqual(pool.count, 8);
+}
+
+- (void)testPoolsArePerThread
+{
+    STKPXStylerContext *context = [STKPXStylerContext dequeueReusableContext];
+    __block STKPXStylerContext *other = nil;
+
+    [STKPXStylerContext recycleContext:context];
+
+    dispatch_sync(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        other = [STKPXStylerContext dequeueReusableContext];
+    });
+
+    XCTAssertNotNil(other);
+    XCTAssertNotEqual(other, context);
+    XCTAssertEqual([STKPXStylerContext dequeueReusableContext], context);
+}
+
+#pragma mark - Reset Tests
+
+- (void)testReusedContextMatchesNewContext
+{
+    StyleableView *view = [[StyleableView alloc] initWithElementName:@"button"];
+    STKPXStylerContext *expected = [[STKPXStylerContext alloc] init];
+    STKPXStylerContext *context = [STKPXStylerContext dequeueReusableContext];
+
+    [self dirtyContext:context withStyleable:view];
+    [STKPXStylerContext recycleContext:context];
+
+    STKPXStylerContext *reused = [STKPXStylerContext dequeueReusableContext];
+
+    XCTAssertEqual(reused, context);
+
+    for (NSString *name in self.comparablePropertyNames)
+    {
+        XCTAssertEqualObjects([reused valueForKey:name], [expected valueForKey:name], @"%@", name);
+    }
+
+    for (NSString *name in @[ @"color", @"paint", @"text-attributes", @"frame", @"text-attributes-normal" ])
+    {
+        XCTAssertNil([reused propertyValueForName:name], @"%@", name);
+    }
+
+    XCTAssertNil([reused valueForKey:@"_shape"]);
+    XCTAssertNil([reused valueForKey:@"_boxModel"]);
+    XCTAssertNil(reused.shape.fill);
+    XCTAssertFalse(reused.boxModel.hasBorder);
+    XCTAssertFalse(reused.boxModel.hasCornerRadius);
+}
+
+- (void)testReusedContextDoesNotLeakStateBetweenStyleables
+{
+    StyleableView *root = [[StyleableView alloc] initWithElementName:@"view"];
+    __weak StyleableView *weakFirst = nil;
+    STKPXStylerContext *context;
+
+    @autoreleasepool
+    {
+        StyleableView *first = [[StyleableView alloc] initWithElementName:@"button"];
+
+        weakFirst = first;
+        context = [STKPXStylerContext dequeueReusableContext];
+        [self dirtyContext:context withStyleable:first];
+        [STKPXStylerContext recycleContext:context];
+        first = nil;
+    }
+
+    // the pooled context must not keep the last styleable alive
+    XCTAssertNil(weakFirst);
+
+    STKPXStylerContext *second = [STKPXStylerContext dequeueReusableContext];
+
+    second.styleable = root;
+
+    XCTAssertEqual(second, context);
+    XCTAssertEqual(second.styleable, root);
+    XCTAssertNil(second.fill);
+    XCTAssertNil(second.color);
+    XCTAssertNil(second.animationInfos);
+    XCTAssertNil(second.outerShadow);
+    XCTAssertEqual(second.opacity, 1.0f);
+    XCTAssertFalse(second.usesImage);
+    XCTAssertEqualObjects(second.fontName, [[STKPXStylerContext alloc] init].fontName);
+}
+
+- (void)testSharedDefaultsAreNotMutatedAcrossContexts
+{
+    STKPXStylerContext *first = [[STKPXStylerContext alloc] init];
+    STKPXStylerContext *second = [[STKPXStylerContext alloc] init];
+
+    XCTAssertEqual(first.letterSpacing, second.letterSpacing);
+
+    first.letterSpacing = [[STKPXDimension alloc] initWithNumber:4 withDimension:@"pt"];
+
+    XCTAssertEqual(second.letterSpacing.number, 0.0f);
+}
+
+#pragma mark - Benchmarks
+
+- (void)testStylingLargeTreeAllocations
+{
+    NSUInteger viewCount = 2000;
+    NSMutableArray *views = [[NSMutableArray alloc] initWithCapacity:viewCount];
+    StyleableView *root = [[StyleableView alloc] initWithElementName:@"view"];
+    id<STKPXPaint> fill = [STKPXSolidPaint paintWithColor:[UIColor redColor]];
+
+    for (NSUInteger i = 0; i < viewCount; i++)
+    {
+        StyleableView *view = [[StyleableView alloc] initWithElementName:(i % 2) ? @"button" : @"label"];
+
+        // a shallow but wide tree: every tenth view starts a new branch
+        [((i % 10 == 0) ? root : views.lastObject) addSubview:view];
+        [views addObject:view];
+    }
+
+    void (^style)(STKPXStylerContext *, StyleableView *) = ^(STKPXStylerContext *context, StyleableView *view) {
+        context.styleable = view;
+        context.fill = fill;
+        context.fontSize = 12.0f;
+        [context setPropertyValue:fill forName:@"color"];
+        (void) context.usesColorOnly;
+    };
+
+    STKBenchmarkSample *fresh = [RECORDER measure:@"context.tree.new" iterations:10 items:viewCount block:^{
+        for (StyleableView *view in views)
+        {
+            style([[STKPXStylerContext alloc] init], view);
+        }
+    }];
+
+    STKBenchmarkSample *pooled = [RECORDER measure:@"context.tree.pooled" iterations:10 items:viewCount block:^{
+        for (StyleableView *view in views)
+        {
+            STKPXStylerContext *context = [STKPXStylerContext dequeueReusableContext];
+
+            style(context, view);
+            [STKPXStylerContext recycleContext:context];
+        }
+    }];
+
+    pooled.metrics[@"allocationRatio"] = @((fresh.allocations > 0) ? (double) pooled.allocations / fresh.allocations : 0.0);
+
+    XCTAssertTrue(pooled.allocations <= fresh.allocations);
+}
+
+@end
@@ -0,0 +1,304 @@
+//
+//  StylesheetDiffTests.m
+//  StylingKit
+//
+
+#import <XCTest/XCTest.h>
+#import "StyleableView.h"
+#import "STKPXStylesheet.h"
+#import "STKPXStylesheet-Private.h"
+#import "STKPXStylesheetParser.h"
+#import "STKPXStylesheetDiff.h"
+#import "STKPXRuleSet.h"
+#import "STKPXStyleTreeInfo.h"
+#import "STKPXCacheManager.h"
+#import "STKBenchmarkRecorder.h"
+
+static STKBenchmarkRecorder *RECORDER;
+
+@interface StylesheetDiffTests : XCTestCase
+@end
+
+@implementation StylesheetDiffTests
+
++ (void)setUp
+{
+    [super setUp];
+
+    RECORDER = [[STKBenchmarkRecorder alloc] initWithSuiteName:@"StylesheetDiffTests"];
+}
+
++ (void)tearDown
+{
+    [RECORDER writeReport];
+    RECORDER = nil;
+
+    [super tearDown];
+}
+
+#pragma mark - Helpers
+
+- (STKPXStylesheet *)stylesheetFromSource:(NSString *)source
+{
+    return [[[STKPXStylesheetParser alloc] init] parse:source withOrigin:STKPXStylesheetOriginApplication];
+}
+
+- (STKPXStylesheetDiff *)diffFromSource:(NSString *)oldSource toSource:(NSString *)newSource
+{
+    return [[STKPXStylesheetDiff alloc] initWithStylesheet:[self stylesheetFromSource:oldSource]
+                                                stylesheet:[self stylesheetFromSource:newSource]];
+}
+
+- (NSArray *)selectorsOfRuleSets:(NSArray *)ruleSets
+{
+    NSMutableArray *result = [NSMutableArray array];
+
+    for (STKPXRuleSet *ruleSet in ruleSets)
+    {
+        [result addObject:[[ruleSet.selectors valueForKey:@"description"] componentsJoinedByString:@" "]];
+    }
+
+    return result;
+}
+
+- (NSString *)sourceWithRuleCount:(NSUInteger)count changedIndex:(NSUInteger)changedIndex
+{
+    NSMutableString *source = [NSMutableString string];
+
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        [source appendFormat:@"#item%lu .label { color: %@; border-width: %lupx; }\n",
+                             (unsigned long) i, (i == changedIndex) ? @"blue" : @"red", (unsigned long) (i % 4)];
+    }
+
+    return source;
+}
+
+#pragma mark - Rule Set Tests
+
+- (void)testIdenticalSourcesAreEmpty
+{
+    NSString *source = @"button { color: red; } #title { font-size: 12px; }";
+    STKPXStylesheetDiff *diff = [self diffFromSource:source toSource:source];
+
+    XCTAssertTrue(diff.isEmpty);
+    XCTAssertFalse(diff.requiresFullRestyle);
+    XCTAssertEqual(diff.unchangedCount, 2);
+}
+
+- (void)testFormattingAndCommentsAreIgnored
+{
+    STKPXStylesheetDiff *diff = [self diffFromSource:@"button{color:red}"
+                                            toSource:@"/* primary */\nbutton {\n    color: red;\n}\n"];
+
+    XCTAssertTrue(diff.isEmpty);
+}
+
+- (void)testChangedDeclarationReplacesOnlyItsRuleSet
+{
+    STKPXStylesheetDiff *diff = [self diffFromSource:@"button { color: red; } label { color: red; } #title { font-size: 12px; }"
+                                            toSource:@"button { color: red; } label { color: blue; } #title { font-size: 12px; }"];
+
+    XCTAssertFalse(diff.requiresFullRestyle);
+    XCTAssertEqual(diff.unchangedCount, 2);
+    XCTAssertEqual(diff.removedRuleSets.count, 1);
+    XCTAssertEqual(diff.addedRuleSets.count, 1);
+    XCTAssertEqualObjects([self selectorsOfRuleSets:diff.removedRuleSets], [self selectorsOfRuleSets:diff.addedRuleSets]);
+}
+
+- (void)testImportanceIsPartOfTheDeclaration
+{
+    STKPXStylesheetDiff *diff = [self diffFromSource:@"button { color: red; }"
+                                            toSource:@"button { color: red !important; }"];
+
+    XCTAssertEqual(diff.removedRuleSets.count, 1);
+    XCTAssertEqual(diff.addedRuleSets.count, 1);
+}
+
+- (void)testChangedSelectorReplacesOnlyItsRuleSet
+{
+    STKPXStylesheetDiff *diff = [self diffFromSource:@"button { color: red; } label { color: red; }"
+                                            toSource:@"button { color: red; } label.title { color: red; }"];
+
+    XCTAssertFalse(diff.requiresFullRestyle);
+    XCTAssertEqual(diff.unchangedCount, 1);
+    XCTAssertEqual(diff.removedRuleSets.count, 1);
+    XCTAssertEqual(diff.addedRuleSets.count, 1);
+}
+
+- (void)testAddedAndRemovedRuleSets
+{
+    STKPXStylesheetDiff *diff = [self diffFromSource:@"button { color: red; } label { color: red; }"
+                                            toSource:@"label { color: red; } slider { color: red; } switch { color: red; }"];
+
+    XCTAssertFalse(diff.requiresFullRestyle);
+    XCTAssertEqual(diff.unchangedCount, 1);
+    XCTAssertEqual(diff.removedRuleSets.count, 1);
+    XCTAssertEqual(diff.addedRuleSets.count, 2);
+}
+
+- (void)testRepeatedRuleSetsAreCounted
+{
+    STKPXStylesheetDiff *diff = [self diffFromSource:@"button { color: red; } button { color: red; }"
+                                            toSource:@"button { color: red; }"];
+
+    XCTAssertFalse(diff.requiresFullRestyle);
+    XCTAssertEqual(diff.unchangedCount, 1);
+    XCTAssertEqual(diff.removedRuleSets.count, 1);
+    XCTAssertEqual(diff.addedRuleSets.count, 0);
+}
+
+- (void)testMediaQueryIsPartOfTheRuleSet
+{
+    STKPXStylesheetDiff *diff = [self diffFromSource:@"button { color: red; } label { color: red; }"
+                                            toSource:@"button { color: red; } @media (orientation:landscape) { label { color: red; } }"];
+
+    XCTAssertFalse(diff.requiresFullRestyle);
+    XCTAssertEqual(diff.unchangedCount, 1);
+    XCTAssertEqual(diff.removedRuleSets.count, 1);
+    XCTAssertEqual(diff.addedRuleSets.count, 1);
+}
+
+#pragma mark - Full Restyle Tests
+
+- (void)testReorderRequiresFullRestyle
+{
+    STKPXStylesheetDiff *diff = [self diffFromSource:@"button { color: red; } .primary { color: blue; }"
+                                            toSource:@".primary { color: blue; } button { color: red; }"];
+
+    XCTAssertTrue(diff.requiresFullRestyle);
+    XCTAssertEqual(diff.unchangedCount, 2);
+    XCTAssertFalse(diff.isEmpty);
+}
+
+- (void)testKeyframesChangeRequiresFullRestyle
+{
+    STKPXStylesheetDiff *same = [self diffFromSource:@"@keyframes pulse { from { opacity: 0; } to { opacity: 1; } } button { color: red; }"
+                                            toSource:@"@keyframes pulse { from { opacity: 0; } to { opacity: 1; } } button { color: red; }"];
+    STKPXStylesheetDiff *changed = [self diffFromSource:@"@keyframes pulse { from { opacity: 0; } to { opacity: 1; } } button { color: red; }"
+                                               toSource:@"@keyframes pulse { from { opacity: 0; } to { opacity: 0.5; } } button { color: red; }"];
+
+    XCTAssertTrue(same.isEmpty);
+    XCTAssertTrue(changed.requiresFullRestyle);
+}
+
+- (void)testNamespaceChangeRequiresFullRestyle
+{
+    STKPXStylesheetDiff *diff = [self diffFromSource:@"@namespace svg \"http://www.w3.org/2000/svg\"; svg|rect { color: red; }"
+                                            toSource:@"@namespace svg \"http://www.w3.org/1999/xhtml\"; svg|rect { color: red; }"];
+
+    XCTAssertTrue(diff.requiresFullRestyle);
+}
+
+- (void)testMissingOldStylesheetRequiresFullRestyle
+{
+    STKPXStylesheetDiff *diff = [[STKPXStylesheetDiff alloc] initWithStylesheet:nil
+                                                                    stylesheet:[self stylesheetFromSource:@"button { color: red; }"]];
+
+    XCTAssertTrue(diff.requiresFullRestyle);
+    XCTAssertEqual(diff.addedRuleSets.count, 1);
+}
+
+#pragma mark - Styleable Tests
+
+- (void)testOnlyMatchedStyleablesAreRestyled
+{
+    StyleableView *root = [[StyleableView alloc] initWithElementName:@"view"];
+    StyleableView *button = [[StyleableView alloc] initWithElementName:@"button"];
+    StyleableView *label = [[StyleableView alloc] initWithElementName:@"label"];
+    StyleableView *nested = [[StyleableView alloc] initWithElementName:@"label"];
+
+    [root addSubview:button];
+    [root addSubview:label];
+    [button addSubview:nested];
+
+    STKPXStylesheetDiff *diff = [self diffFromSource:@"button { color: red; } button label { color: red; } view > label { color: red; }"
+                                            toSource:@"button { color: red; } button label { color: blue; } view > label { color: red; }"];
+
+    XCTAssertFalse([diff affectsStyleable:root]);
+    XCTAssertFalse([diff affectsStyleable:button]);
+    XCTAssertFalse([diff affectsStyleable:label]);
+    XCTAssertTrue([diff affectsStyleable:nested]);
+    XCTAssertEqualObjects([diff styleablesToRestyleInStyleable:root], @[ nested ]);
+}
+
+- (void)testRemovedRuleSetsRestyleTheirFormerMatches
+{
+    StyleableView *root = [[StyleableView alloc] initWithElementName:@"view"];
+    StyleableView *button = [[StyleableView alloc] initWithElementName:@"button"];
+
+    [root addSubview:button];
+
+    STKPXStylesheetDiff *diff = [self diffFromSource:@"button { color: red; } label { color: red; }"
+                                            toSource:@"label { color: red; }"];
+
+    XCTAssertEqualObjects([diff styleablesToRestyleInStyleable:root], @[ button ]);
+}
+
+- (void)testEmptyDiffRestylesNothing
+{
+    StyleableView *root = [[StyleableView alloc] initWithElementName:@"button"];
+    STKPXStylesheetDiff *diff = [self diffFromSource:@"button { color: red; }" toSource:@"button { color: red; }"];
+
+    XCTAssertEqual([diff styleablesToRestyleInStyleable:root].count, 0);
+}
+
+- (void)testReloadDropsCachedStylesOfCellsOutsideWindows
+{
+    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:@"StylesheetDiffTests-reload.css"];
+    StyleableView *queuedCell = [[StyleableView alloc] initWithElementName:@"button"];
+    NSString *key = @"StylesheetDiffTests-queued-cell";
+
+    [@"button { color: red; }" writeToFile:path atomically:YES encoding:NSUTF8StringEncoding error:NULL];
+    [STKPXStylesheet styleSheetFromFilePath:path withOrigin:STKPXStylesheetOriginApplication];
+
+    // a cell waiting in a reuse queue is in no window, so the restyle never reaches it
+    [STKPXCacheManager setStyleTreeInfo:[[STKPXStyleTreeInfo alloc] initWithStyleable:queuedCell] forKey:key];
+
+    [@"button { color: blue; }" writeToFile:path atomically:YES encoding:NSUTF8StringEncoding error:NULL];
+
+    STKPXStylesheetDiff *diff = [STKPXStylesheet reloadStyleSheetFromFilePath:path
+                                                                   withOrigin:STKPXStylesheetOriginApplication];
+
+    XCTAssertFalse(diff.requiresFullRestyle);
+    XCTAssertFalse(diff.isEmpty);
+    XCTAssertNil([STKPXCacheManager styleTreeInfoForKey:key]);
+
+    // an unchanged reload keeps the cache
+    [STKPXCacheManager setStyleTreeInfo:[[STKPXStyleTreeInfo alloc] initWithStyleable:queuedCell] forKey:key];
+
+    XCTAssertTrue([STKPXStylesheet reloadStyleSheetFromFilePath:path withOrigin:STKPXStylesheetOriginApplication].isEmpty);
+    XCTAssertNotNil([STKPXCacheManager styleTreeInfoForKey:key]);
+
+    [STKPXCacheManager clearStyleCache];
+    [[NSFileManager defaultManager] removeItemAtPath:path error:NULL];
+}
+
+#pragma mark - Benchmarks
+
+- (void)testDiffAgainstReparse
+{
+    NSUInteger count = 2000;
+    NSString *oldSource = [self sourceWithRuleCount:count changedIndex:NSNotFound];
+    NSString *newSource = [self sourceWithRuleCount:count changedIndex:count / 2];
+    STKPXStylesheet *oldSheet = [self stylesheetFromSource:oldSource];
+    STKPXStylesheet *newSheet = [self stylesheetFromSource:newSource];
+    __block STKPXStylesheetDiff *diff;
+
+    [RECORDER measure:@"stylesheet.reparse" iterations:5 items:count block:^{
+        [self stylesheetFromSource:newSource];
+    }];
+
+    STKBenchmarkSample *sample = [RECORDER measure:@"stylesheet.diff" iterations:5 items:count block:^{
+        diff = [[STKPXStylesheetDiff alloc] initWithStylesheet:oldSheet stylesheet:newSheet];
+    }];
+
+    sample.metrics[@"changed"] = @(diff.removedRuleSets.count + diff.addedRuleSets.count);
+
+    XCTAssertFalse(diff.requiresFullRestyle);
+    XCTAssertEqual(diff.unchangedCount, count - 1);
+    XCTAssertEqual(diff.removedRuleSets.count, 1);
+    XCTAssertEqual(diff.addedRuleSets.count, 1);
+}
+
+@end
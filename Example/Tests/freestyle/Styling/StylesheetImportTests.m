@@ -0,0 +1,320 @@
+//
+//  StylesheetImportTests.m
+//  StylingKit
+//
+
+#import <XCTest/XCTest.h>
+#import "STKPXStylesheet.h"
+#import "STKPXStylesheet-Private.h"
+#import "STKPXStylesheetParser.h"
+#import "STKPXStylesheetFragment.h"
+#import "STKPXMediaGroup.h"
+#import "STKPXRuleSet.h"
+#import "STKBenchmarkRecorder.h"
+
+static STKBenchmarkRecorder *RECORDER;
+
+@interface StylesheetImportTests : XCTestCase
+@end
+
+@implementation StylesheetImportTests
+{
+    NSString *directory_;
+}
+
++ (void)setUp
+{
+    [super setUp];
+
+    RECORDER = [[STKBenchmarkRecorder alloc] initWithSuiteName:@"StylesheetImportTests"];
+}
+
++ (void)tearDown
+{
+    [RECORDER writeReport];
+    RECORDER = nil;
+
+    [super tearDown];
+}
+
+- (void)setUp
+{
+    [super setUp];
+
+    // import paths are standardized, so the fixture paths are too
+    directory_ = [NSTemporaryDirectory() stringByAppendingPathComponent:[NSUUID UUID].UUIDString].stringByStandardizingPath;
+    [[NSFileManager defaultManager] createDirectoryAtPath:directory_ withIntermediateDirectories:YES attributes:nil error:NULL];
+
+    [STKPXStylesheetFragment clearCache];
+}
+
+- (void)tearDown
+{
+    [[NSFileManager defaultManager] removeItemAtPath:directory_ error:NULL];
+    [STKPXStylesheetFragment clearCache];
+
+    [super tearDown];
+}
+
+#pragma mark - Helpers
+
+- (NSString *)writeFile:(NSString *)name source:(NSString *)source
+{
+    NSString *path = [directory_ stringByAppendingPathComponent:name];
+
+    [source writeToFile:path atomically:NO encoding:NSUTF8StringEncoding error:NULL];
+
+    return path;
+}
+
+- (void)touchFile:(NSString *)path
+{
+    // move the modification date well past the file system's timestamp resolution
+    NSDate *date = [[[NSFileManager defaultManager] attributesOfItemAtPath:path error:NULL].fileModificationDate dateByAddingTimeInterval:10.0];
+
+    [[NSFileManager defaultManager] setAttributes:@{ NSFileModificationDate: date } ofItemAtPath:path error:NULL];
+}
+
+- (STKPXStylesheetParser *)parser
+{
+    return [[STKPXStylesheetParser alloc] init];
+}
+
+- (STKPXStylesheet *)stylesheetFromFile:(NSString *)path parser:(STKPXStylesheetParser *)parser
+{
+    NSString *source = [NSString stringWithContentsOfFile:path encoding:NSUTF8StringEncoding error:NULL];
+
+    return [parser parse:source withOrigin:STKPXStylesheetOriginApplication filename:path];
+}
+
+- (NSArray *)elementNamesOfStylesheet:(STKPXStylesheet *)stylesheet
+{
+    NSMutableArray *result = [NSMutableArray array];
+
+    for (STKPXMediaGroup *group in stylesheet.mediaGroups)
+    {
+        for (STKPXRuleSet *ruleSet in group.ruleSets)
+        {
+            [result addObject:ruleSet.targetTypeSelector.typeName ?: @"*"];
+        }
+    }
+
+    return result;
+}
+
+#pragma mark - Ordering Tests
+
+- (void)testImportsAreMergedInSourceOrder
+{
+    [self writeFile:@"a.css" source:@"a1 { color: red; } a2 { color: red; }"];
+    [self writeFile:@"b.css" source:@"b1 { color: red; }"];
+    [self writeFile:@"c.css" source:@"c1 { color: red; }"];
+    NSString *main = [self writeFile:@"main.css" source:@"@import \"a.css\"; @import \"b.css\"; @import \"c.css\"; main1 { color: red; }"];
+
+    STKPXStylesheet *stylesheet = [self stylesheetFromFile:main parser:self.parser];
+
+    XCTAssertEqualObjects([self elementNamesOfStylesheet:stylesheet], (@[ @"a1", @"a2", @"b1", @"c1", @"main1" ]));
+}
+
+- (void)testNestedImportsWithSharedLeaf
+{
+    [self writeFile:@"leaf.css" source:@"leaf { color: red; }"];
+    [self writeFile:@"a.css" source:@"@import \"leaf.css\"; a { color: red; }"];
+    [self writeFile:@"b.css" source:@"@import \"leaf.css\"; b { color: red; }"];
+    [self writeFile:@"c.css" source:@"@import \"a.css\"; @import \"b.css\"; c { color: red; }"];
+    NSString *main = [self writeFile:@"main.css" source:@"@import \"c.css\"; @import \"leaf.css\"; main { color: red; }"];
+
+    STKPXStylesheet *stylesheet = [self stylesheetFromFile:main parser:self.parser];
+
+    XCTAssertEqualObjects([self elementNamesOfStylesheet:stylesheet], (@[ @"leaf", @"a", @"leaf", @"b", @"c", @"leaf", @"main" ]));
+}
+
+- (void)testLateImportsAreMergedWhereTheyAppear
+{
+    [self writeFile:@"a.css" source:@"a { color: red; }"];
+    NSString *main = [self writeFile:@"main.css" source:@"before { color: red; } @import \"a.css\"; after { color: red; }"];
+
+    STKPXStylesheet *stylesheet = [self stylesheetFromFile:main parser:self.parser];
+
+    XCTAssertEqualObjects([self elementNamesOfStylesheet:stylesheet], (@[ @"before", @"a", @"after" ]));
+}
+
+- (void)testMediaQueriesOfImportsArePreserved
+{
+    [self writeFile:@"a.css" source:@"a1 { color: red; } @media (orientation:landscape) { a2 { color: red; } } a3 { color: red; }"];
+    NSString *main = [self writeFile:@"main.css" source:@"@import \"a.css\"; main { color: red; }"];
+
+    STKPXStylesheet *stylesheet = [self stylesheetFromFile:main parser:self.parser];
+    NSMutableArray *queries = [NSMutableArray array];
+
+    for (STKPXMediaGroup *group in stylesheet.mediaGroups)
+    {
+        [queries addObject:(group.query != nil) ? @YES : @NO];
+    }
+
+    XCTAssertEqualObjects([self elementNamesOfStylesheet:stylesheet], (@[ @"a1", @"a2", @"a3", @"main" ]));
+    XCTAssertEqualObjects(queries, (@[ @NO, @YES, @NO, @NO ]));
+}
+
+- (void)testKeyframesAndNamespacesOfImportsAreMerged
+{
+    [self writeFile:@"a.css" source:@"@namespace svg \"http://www.w3.org/2000/svg\"; @keyframes pulse { from { opacity: 0; } to { opacity: 1; } }"];
+    NSString *main = [self writeFile:@"main.css" source:@"@import \"a.css\"; main { color: red; }"];
+
+    STKPXStylesheet *stylesheet = [self stylesheetFromFile:main parser:self.parser];
+
+    XCTAssertNotNil([stylesheet keyframeForName:@"pulse"]);
+    XCTAssertEqualObjects([stylesheet namespaceForPrefix:@"svg"], @"http://www.w3.org/2000/svg");
+}
+
+- (void)testImportedRuleSetsTakeTheImportersOrigin
+{
+    [self writeFile:@"a.css" source:@"a { color: red; }"];
+    NSString *main = [self writeFile:@"main.css" source:@"@import \"a.css\";"];
+    NSString *source = [NSString stringWithContentsOfFile:main encoding:NSUTF8StringEncoding error:NULL];
+
+    STKPXStylesheet *application = [self.parser parse:source withOrigin:STKPXStylesheetOriginApplication filename:main];
+    STKPXStylesheet *view = [self.parser parse:source withOrigin:STKPXStylesheetOriginView filename:main];
+    STKPXRuleSet *applicationRuleSet = application.ruleSets.firstObject;
+    STKPXRuleSet *viewRuleSet = view.ruleSets.firstObject;
+
+    XCTAssertNotEqual(applicationRuleSet, viewRuleSet);
+    XCTAssertEqual([applicationRuleSet.specificity compareSpecificity:viewRuleSet.specificity], NSOrderedAscending);
+}
+
+#pragma mark - Cache Tests
+
+- (void)testSharedLeafIsParsedOnce
+{
+    NSString *leaf = [self writeFile:@"leaf.css" source:@"leaf { color: red; }"];
+    [self writeFile:@"a.css" source:@"@import \"leaf.css\"; a { color: red; }"];
+    NSString *b = [self writeFile:@"b.css" source:@"@import \"leaf.css\"; b { color: red; }"];
+    NSString *first = [self writeFile:@"first.css" source:@"@import \"a.css\"; first { color: red; }"];
+
+    [self stylesheetFromFile:first parser:self.parser];
+
+    STKPXStylesheetFragment *cached = [STKPXStylesheetFragment fragmentForPath:leaf importChain:nil];
+    STKPXStylesheetFragment *fromB = [STKPXStylesheetFragment fragmentForPath:b importChain:nil];
+
+    XCTAssertEqual([STKPXStylesheetFragment fragmentForPath:leaf importChain:nil], cached);
+    XCTAssertEqual([STKPXStylesheetFragment fragmentForPath:b importChain:nil], fromB);
+    XCTAssertNotNil(fromB.dependencies[leaf]);
+    XCTAssertFalse(fromB.hasImportCycle);
+}
+
+- (void)testChangedImportIsParsedAgain
+{
+    NSString *leaf = [self writeFile:@"leaf.css" source:@"leaf { color: red; }"];
+    NSString *a = [self writeFile:@"a.css" source:@"@import \"leaf.css\"; a { color: red; }"];
+    NSString *main = [self writeFile:@"main.css" source:@"@import \"a.css\"; main { color: red; }"];
+
+    [self stylesheetFromFile:main parser:self.parser];
+
+    STKPXStylesheetFragment *before = [STKPXStylesheetFragment fragmentForPath:a importChain:nil];
+
+    [self writeFile:@"leaf.css" source:@"changed { color: red; }"];
+    [self touchFile:leaf];
+
+    STKPXStylesheet *stylesheet = [self stylesheetFromFile:main parser:self.parser];
+
+    XCTAssertEqualObjects([self elementNamesOfStylesheet:stylesheet], (@[ @"changed", @"a", @"main" ]));
+    XCTAssertNotEqual([STKPXStylesheetFragment fragmentForPath:a importChain:nil], before);
+}
+
+#pragma mark - Cycle Tests
+
+- (void)testImportCycleIsReported
+{
+    NSString *a = [self writeFile:@"a.css" source:@"@import \"b.css\"; a { color: red; }"];
+    NSString *b = [self writeFile:@"b.css" source:@"@import \"a.css\"; b { color: red; }"];
+    STKPXStylesheetParser *parser = self.parser;
+
+    STKPXStylesheet *stylesheet = [self stylesheetFromFile:a parser:parser];
+
+    XCTAssertEqualObjects([self elementNamesOfStylesheet:stylesheet], (@[ @"b", @"a" ]));
+    XCTAssertEqual(parser.errors.count, 1);
+    XCTAssertTrue([parser.errors.firstObject rangeOfString:@"@import cycle detected"].location != NSNotFound);
+
+    // what b contains depends on who imports it, so it must not be cached
+    STKPXStylesheetFragment *fragment = [STKPXStylesheetFragment fragmentForPath:b importChain:nil];
+
+    XCTAssertTrue(fragment.hasImportCycle);
+    XCTAssertNotEqual([STKPXStylesheetFragment fragmentForPath:b importChain:nil], fragment);
+}
+
+- (void)testSelfImportIsReported
+{
+    NSString *main = [self writeFile:@"main.css" source:@"@import \"main.css\"; main { color: red; }"];
+    STKPXStylesheetParser *parser = self.parser;
+
+    STKPXStylesheet *stylesheet = [self stylesheetFromFile:main parser:parser];
+
+    XCTAssertEqualObjects([self elementNamesOfStylesheet:stylesheet], @[ @"main" ]);
+    XCTAssertEqual(parser.errors.count, 1);
+}
+
+- (void)testCachedFragmentDoesNotHideCycle
+{
+    NSString *leaf = [self writeFile:@"leaf.css" source:@"@import \"top.css\"; leaf { color: red; }"];
+    [self writeFile:@"top.css" source:@"top { color: red; }"];
+    NSString *other = [self writeFile:@"other.css" source:@"@import \"leaf.css\";"];
+
+    // cache leaf, including top.css, while nothing imports top.css
+    [self stylesheetFromFile:other parser:self.parser];
+    XCTAssertFalse([STKPXStylesheetFragment fragmentForPath:leaf importChain:nil].hasImportCycle);
+
+    // now top.css imports leaf.css, so the cached leaf would import top.css into itself
+    NSString *top = [self writeFile:@"top.css" source:@"@import \"leaf.css\"; top { color: red; }"];
+    STKPXStylesheetParser *parser = self.parser;
+
+    STKPXStylesheet *stylesheet = [self stylesheetFromFile:top parser:parser];
+
+    XCTAssertEqualObjects([self elementNamesOfStylesheet:stylesheet], (@[ @"leaf", @"top" ]));
+    XCTAssertEqual(parser.errors.count, 1);
+}
+
+#pragma mark - Benchmarks
+
+- (void)testParseWithImports
+{
+    NSMutableString *mainSource = [NSMutableString string];
+    NSMutableString *baseSource = [NSMutableString string];
+
+    for (NSUInteger i = 0; i < 200; i++)
+    {
+        [baseSource appendFormat:@"#base%lu .label { color: red; border-width: 1px; }\n", (unsigned long) i];
+    }
+
+    [self writeFile:@"base.css" source:baseSource];
+
+    for (NSUInteger i = 0; i < 8; i++)
+    {
+        NSMutableString *source = [NSMutableString stringWithString:@"@import \"base.css\";\n"];
+
+        for (NSUInteger j = 0; j < 100; j++)
+        {
+            [source appendFormat:@"#theme%lu-%lu { color: blue; }\n", (unsigned long) i, (unsigned long) j];
+        }
+
+        [self writeFile:[NSString stringWithFormat:@"theme%lu.css", (unsigned long) i] source:source];
+        [mainSource appendFormat:@"@import \"theme%lu.css\";\n", (unsigned long) i];
+    }
+
+    NSString *main = [self writeFile:@"main.css" source:mainSource];
+    __block STKPXStylesheet *stylesheet;
+
+    [RECORDER measure:@"import.cold" iterations:5 items:8 block:^{
+        [STKPXStylesheetFragment clearCache];
+        stylesheet = [self stylesheetFromFile:main parser:self.parser];
+    }];
+
+    STKBenchmarkSample *warm = [RECORDER measure:@"import.warm" iterations:5 items:8 block:^{
+        stylesheet = [self stylesheetFromFile:main parser:self.parser];
+    }];
+
+    warm.metrics[@"rule_sets"] = @([self elementNamesOfStylesheet:stylesheet].count);
+
+    XCTAssertEqual([self elementNamesOfStylesheet:stylesheet].count, 8 * (200 + 100));
+}
+
+@end
@@ -0,0 +1,286 @@
+//
+//  StylingSubclassTests.m
+//  StylingKit
+//
+
+#import <XCTest/XCTest.h>
+#import <objc/runtime.h>
+#import "UIView+STKPXStyling-Private.h"
+#import "STKBenchmarkRecorder.h"
+
+static STKBenchmarkRecorder *RECORDER;
+
+static Class STKTargetSuperclassOfStylingSubclass(Class self, SEL _cmd)
+{
+    return objc_getAssociatedObject(self, _cmd);
+}
+
+@interface StylingSubclassTests : XCTestCase
+@end
+
+@implementation StylingSubclassTests
+{
+    NSMutableArray *classes_;
+    NSMutableArray *stylingSubclasses_;
+}
+
++ (void)setUp
+{
+    [super setUp];
+
+    RECORDER = [[STKBenchmarkRecorder alloc] initWithSuiteName:@"StylingSubclassTests"];
+}
+
++ (void)tearDown
+{
+    [RECORDER writeReport];
+    RECORDER = nil;
+
+    [super tearDown];
+}
+
+- (void)setUp
+{
+    [super setUp];
+
+    classes_ = [[NSMutableArray alloc] initWithArray:@[ [UIView class],
+                                                        [UILabel class],
+                                                        [UIButton class],
+                                                        [UIImageView class],
+                                                        [UIScrollView class],
+                                                        [UITableView class],
+                                                        [UITableViewCell class],
+                                                        [UITextField class],
+                                                        [UISwitch class] ]];
+    stylingSubclasses_ = [[NSMutableArray alloc] init];
+
+    [self buildHierarchyUnder:[UIView class] depth:4 fanOut:3 path:[NSString stringWithFormat:@"STKSynthetic%u", arc4random()]];
+    [self buildHierarchyUnder:[UIButton class] depth:3 fanOut:2 path:[NSString stringWithFormat:@"STKSyntheticButton%u", arc4random()]];
+}
+
+- (void)tearDown
+{
+    for (Class c in stylingSubclasses_)
+    {
+        [UIView removeStylingSubclass:NSStringFromClass(c)];
+    }
+
+    [super tearDown];
+}
+
+#pragma mark - Helpers
+
+- (Class)createClassNamed:(NSString *)name superclass:(Class)superclass
+{
+    Class result = objc_allocateClassPair(superclass, name.UTF8String, 0);
+
+    objc_registerClassPair(result);
+
+    return result;
+}
+
+/**
+ *  Builds a synthetic class tree. Every third class gets a styling subclass, alternating between one that is a
+ *  direct subclass and one that names its target through +targetSuperclass
+ */
+- (void)buildHierarchyUnder:(Class)root depth:(NSUInteger)depth fanOut:(NSUInteger)fanOut path:(NSString *)path
+{
+    if (depth == 0)
+    {
+        return;
+    }
+
+    for (NSUInteger i = 0; i < fanOut; i++)
+    {
+        NSString *name = [NSString stringWithFormat:@"%@_%lu", path, (unsigned long) i];
+        Class c = [self createClassNamed:name superclass:root];
+
+        [classes_ addObject:c];
+
+        if (classes_.count % 3 == 0)
+        {
+            Class styling;
+
+            if (classes_.count % 2 == 0)
+            {
+                styling = [self createClassNamed:[@"STKPX" stringByAppendingString:name] superclass:c];
+            }
+            else
+            {
+                styling = [self createClassNamed:[@"STKPXTarget" stringByAppendingString:name] superclass:root];
+
+                class_addMethod(object_getClass(styling), @selector(targetSuperclass), (IMP) STKTargetSuperclassOfStylingSubclass, "#@:");
+                objc_setAssociatedObject(styling, @selector(targetSuperclass), c, OBJC_ASSOCIATION_ASSIGN);
+            }
+
+            [UIView addStylingSubclass:NSStringFromClass(styling)];
+            [stylingSubclasses_ addObject:styling];
+            [classes_ addObject:styling];
+        }
+
+        [self buildHierarchyUnder:c depth:depth - 1 fanOut:fanOut path:name];
+    }
+}
+
+- (void)assertCacheMatchesResolution
+{
+    for (Class c in classes_)
+    {
+        // twice, so the second lookup is served from the cache
+        XCTAssertEqual([UIView stylingSubclassForClass:c], [UIView resolveStylingSubclassForClass:c], @"%@", c);
+        XCTAssertEqual([UIView stylingSubclassForClass:c], [UIView resolveStylingSubclassForClass:c], @"%@", c);
+    }
+}
+
+#pragma mark - Tests
+
+- (void)testCachedResolutionMatchesWalk
+{
+    NSUInteger resolved = 0;
+
+    [self assertCacheMatchesResolution];
+
+    for (Class c in classes_)
+    {
+        if ([UIView stylingSubclassForClass:c])
+        {
+            resolved++;
+        }
+    }
+
+    // the synthetic tree must exercise hits as well as misses
+    XCTAssertTrue(resolved > 0);
+    XCTAssertTrue(resolved < classes_.count);
+}
+
+- (void)testRegistrationInvalidatesCache
+{
+    [self assertCacheMatchesResolution];
+
+    Class removed = stylingSubclasses_.firstObject;
+
+    [UIView removeStylingSubclass:NSStringFromClass(removed)];
+    [self assertCacheMatchesResolution];
+
+    [UIView addStylingSubclass:NSStringFromClass(removed)];
+    [self assertCacheMatchesResolution];
+}
+
+- (void)testConcurrentLookups
+{
+    NSArray *classes = [classes_ copy];
+    NSMutableArray *expected = [[NSMutableArray alloc] initWithCapacity:classes.count];
+
+    for (Class c in classes)
+    {
+        Class styling = [UIView resolveStylingSubclassForClass:c];
+
+        [expected addObject:styling ?: [NSNull null]];
+    }
+
+    __block NSUInteger mismatches = 0;
+
+    dispatch_apply(64, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t pass) {
+        for (NSUInteger i = 0; i < classes.count; i++)
+        {
+            Class c = classes[(i + pass) % classes.count];
+            id styling = [UIView stylingSubclassForClass:c] ?: [NSNull null];
+
+            if (styling != expected[(i + pass) % classes.count])
+            {
+                @synchronized(expected)
+                {
+                    mismatches++;
+                }
+            }
+        }
+    });
+
+    XCTAssertEqual(mismatches, 0);
+}
+
+- (void)testLookupsDuringRegistration
+{
+    NSArray *classes = [classes_ copy];
+    NSMutableArray *expected = [[NSMutableArray alloc] initWithCapacity:classes.count];
+    NSString *path = [NSString stringWithFormat:@"STKSyntheticToggled%u", arc4random()];
+    Class target = [self createClassNamed:path superclass:[UIView class]];
+    NSString *toggled = NSStringFromClass([self createClassNamed:[@"STKPX" stringByAppendingString:path] superclass:target]);
+
+    for (Class c in classes)
+    {
+        Class styling = [UIView resolveStylingSubclassForClass:c];
+
+        [expected addObject:styling ?: [NSNull null]];
+    }
+
+    __block NSUInteger mismatches = 0;
+
+    // the toggled subclass styles an unrelated class, so every lookup must keep its answer while the list mutates
+    dispatch_apply(64, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t pass) {
+        if (pass % 4 == 0)
+        {
+            for (NSUInteger i = 0; i < 100; i++)
+            {
+                [UIView addStylingSubclass:toggled];
+                [UIView removeStylingSubclass:toggled];
+            }
+
+            return;
+        }
+
+        for (NSUInteger i = 0; i < classes.count; i++)
+        {
+            Class c = classes[(i + pass) % classes.count];
+            id styling = [UIView stylingSubclassForClass:c] ?: [NSNull null];
+            id resolved = [UIView resolveStylingSubclassForClass:c] ?: [NSNull null];
+
+            if (styling != expected[(i + pass) % classes.count] || resolved != styling)
+            {
+                @synchronized(expected)
+                {
+                    mismatches++;
+                }
+            }
+        }
+    });
+
+    XCTAssertEqual(mismatches, 0);
+    XCTAssertFalse([UIView hasStylingSubclass:toggled]);
+}
+
+#pragma mark - Benchmarks
+
+- (void)testResolutionThroughput
+{
+    NSArray *classes = [classes_ copy];
+    NSUInteger passes = 100;
+
+    // warm the cache so the cached sample measures lookups only
+    [self assertCacheMatchesResolution];
+
+    STKBenchmarkSample *walk = [RECORDER measure:@"subclass.resolve.walk" iterations:10 items:classes.count * passes block:^{
+        for (NSUInteger pass = 0; pass < passes; pass++)
+        {
+            for (Class c in classes)
+            {
+                [UIView resolveStylingSubclassForClass:c];
+            }
+        }
+    }];
+
+    STKBenchmarkSample *cached = [RECORDER measure:@"subclass.resolve.cached" iterations:10 items:classes.count * passes block:^{
+        for (NSUInteger pass = 0; pass < passes; pass++)
+        {
+            for (Class c in classes)
+            {
+                [UIView stylingSubclassForClass:c];
+            }
+        }
+    }];
+
+    walk.metrics[@"classes"] = @(classes.count);
+    cached.metrics[@"classes"] = @(classes.count);
+}
+
+@end
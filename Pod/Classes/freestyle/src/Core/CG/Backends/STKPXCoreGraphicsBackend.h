@@ -0,0 +1,47 @@
+/****************************************************************************
+ *
+ * Copyright 2015-present StylingKit Development Team. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ****************************************************************************/
+
+//
+//  STKPXCoreGraphicsBackend.h
+//  StylingKit
+//
+
+#import <Foundation/Foundation.h>
+#import "STKPXRenderBackend.h"
+
+/**
+ *  STKPXCoreGraphicsBackend renders into a CGContext using the CoreGraphics implementations of paints, strokes and
+ *  shadows. This is the backend STKPXRenderable's render: method uses.
+ */
+@interface STKPXCoreGraphicsBackend : NSObject <STKPXRenderBackend>
+
+/**
+ *  The context this backend renders into
+ */
+@property (nonatomic, readonly) CGContextRef context;
+
+/**
+ *  Initialize a new backend rendering into the specified context
+ *
+ *  @param context The context to render into
+ */
+- (instancetype)initWithContext:(CGContextRef)context NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
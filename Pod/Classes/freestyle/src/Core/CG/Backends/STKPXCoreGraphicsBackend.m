@@ -0,0 +1,94 @@
+/****************************************************************************
+ *
+ * Copyright 2015-present StylingKit Development Team. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ****************************************************************************/
+
+//
+//  STKPXCoreGraphicsBackend.m
+//  StylingKit
+//
+
+#import "STKPXCoreGraphicsBackend.h"
+
+@implementation STKPXCoreGraphicsBackend
+
+#pragma mark - Initializers
+
+- (instancetype)initWithContext:(CGContextRef)context
+{
+    if (self = [super init])
+    {
+        _context = context;
+    }
+
+    return self;
+}
+
+#pragma mark - STKPXRenderBackend implementation
+
+- (void)saveState
+{
+    CGContextSaveGState(_context);
+}
+
+- (void)restoreState
+{
+    CGContextRestoreGState(_context);
+}
+
+- (void)concatTransform:(CGAffineTransform)transform
+{
+    CGContextConcatCTM(_context, transform);
+}
+
+- (void)clipToPath:(CGPathRef)path
+{
+    CGContextAddPath(_context, path);
+    CGContextClip(_context);
+}
+
+- (void)beginTransparencyLayerWithOpacity:(CGFloat)opacity
+{
+    CGContextSetAlpha(_context, opacity);
+    CGContextBeginTransparencyLayer(_context, NULL);
+}
+
+- (void)endTransparencyLayer
+{
+    CGContextEndTransparencyLayer(_context);
+}
+
+- (void)fillPath:(CGPathRef)path withPaint:(id<STKPXPaint>)paint
+{
+    [paint applyFillToPath:path withContext:_context];
+}
+
+- (void)strokePath:(CGPathRef)path withStroke:(id<STKPXStrokeRenderer>)stroke
+{
+    [stroke applyStrokeToPath:path withContext:_context];
+}
+
+- (void)applyOutsetOfShadow:(id<STKPXShadowPaint>)shadow toPath:(CGPathRef)path
+{
+    [shadow applyOutsetToPath:path withContext:_context];
+}
+
+- (void)applyInsetOfShadow:(id<STKPXShadowPaint>)shadow toPath:(CGPathRef)path
+{
+    [shadow applyInsetToPath:path withContext:_context];
+}
+
+@end
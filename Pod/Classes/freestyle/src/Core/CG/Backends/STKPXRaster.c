@@ -0,0 +1,1724 @@
+/****************************************************************************
+ *
+ * Copyright 2015-present StylingKit Development Team. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ****************************************************************************/
+
+//
+//  STKPXRaster.c
+//  StylingKit
+//
+
+#include "STKPXRaster.h"
+
+#include <math.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define STKPX_RASTER_BAND_HEIGHT 16
+#define STKPX_RASTER_PARALLEL_AREA (128 * 128)
+#define STKPX_RASTER_FLATTEN_TOLERANCE 0.1
+#define STKPX_RASTER_MAX_SEGMENTS 1024
+
+// M_PI is not part of ISO C
+#define STKPX_RASTER_PI 3.14159265358979323846
+
+const STKPXRasterTransform STKPXRasterTransformIdentity = { 1.0, 0.0, 0.0, 1.0, 0.0, 0.0 };
+
+// MARK: - Transforms
+
+STKPXRasterTransform STKPXRasterTransformConcat(STKPXRasterTransform t1, STKPXRasterTransform t2)
+{
+    STKPXRasterTransform result;
+
+    result.a = t1.a * t2.a + t1.b * t2.c;
+    result.b = t1.a * t2.b + t1.b * t2.d;
+    result.c = t1.c * t2.a + t1.d * t2.c;
+    result.d = t1.c * t2.b + t1.d * t2.d;
+    result.tx = t1.tx * t2.a + t1.ty * t2.c + t2.tx;
+    result.ty = t1.tx * t2.b + t1.ty * t2.d + t2.ty;
+
+    return result;
+}
+
+static bool TransformInvert(STKPXRasterTransform t, STKPXRasterTransform *result)
+{
+    double determinant = t.a * t.d - t.b * t.c;
+
+    if (fabs(determinant) < 1e-12)
+    {
+        return false;
+    }
+
+    result->a = t.d / determinant;
+    result->b = -t.b / determinant;
+    result->c = -t.c / determinant;
+    result->d = t.a / determinant;
+    result->tx = (t.c * t.ty - t.d * t.tx) / determinant;
+    result->ty = (t.b * t.tx - t.a * t.ty) / determinant;
+
+    return true;
+}
+
+static inline void TransformPoint(STKPXRasterTransform t, double x, double y, double *outX, double *outY)
+{
+    *outX = t.a * x + t.c * y + t.tx;
+    *outY = t.b * x + t.d * y + t.ty;
+}
+
+// MARK: - Paths
+
+typedef enum
+{
+    VerbMove,
+    VerbLine,
+    VerbQuad,
+    VerbCubic,
+    VerbClose
+} Verb;
+
+struct STKPXRasterPath
+{
+    uint8_t *verbs;
+    size_t verbCount;
+    size_t verbCapacity;
+    double *coordinates;
+    size_t coordinateCount;
+    size_t coordinateCapacity;
+};
+
+static bool Reserve(void **buffer, size_t *capacity, size_t needed, size_t elementSize)
+{
+    if (needed <= *capacity)
+    {
+        return true;
+    }
+
+    size_t newCapacity = (*capacity) ? *capacity * 2 : 16;
+
+    while (newCapacity < needed)
+    {
+        newCapacity *= 2;
+    }
+
+    void *newBuffer = realloc(*buffer, newCapacity * elementSize);
+
+    if (newBuffer == NULL)
+    {
+        return false;
+    }
+
+    *buffer = newBuffer;
+    *capacity = newCapacity;
+
+    return true;
+}
+
+STKPXRasterPath *STKPXRasterPathCreate(void)
+{
+    return calloc(1, sizeof(STKPXRasterPath));
+}
+
+void STKPXRasterPathRelease(STKPXRasterPath *path)
+{
+    if (path)
+    {
+        free(path->verbs);
+        free(path->coordinates);
+        free(path);
+    }
+}
+
+static void PathAdd(STKPXRasterPath *path, Verb verb, const double *coordinates, size_t count)
+{
+    if (!Reserve((void **) &path->verbs, &path->verbCapacity, path->verbCount + 1, sizeof(uint8_t))
+        || !Reserve((void **) &path->coordinates, &path->coordinateCapacity, path->coordinateCount + count, sizeof(double)))
+    {
+        return;
+    }
+
+    path->verbs[path->verbCount++] = (uint8_t) verb;
+    memcpy(path->coordinates + path->coordinateCount, coordinates, count * sizeof(double));
+    path->coordinateCount += count;
+}
+
+void STKPXRasterPathMoveTo(STKPXRasterPath *path, double x, double y)
+{
+    double coordinates[] = { x, y };
+    PathAdd(path, VerbMove, coordinates, 2);
+}
+
+void STKPXRasterPathLineTo(STKPXRasterPath *path, double x, double y)
+{
+    double coordinates[] = { x, y };
+    PathAdd(path, VerbLine, coordinates, 2);
+}
+
+void STKPXRasterPathQuadTo(STKPXRasterPath *path, double cx, double cy, double x, double y)
+{
+    double coordinates[] = { cx, cy, x, y };
+    PathAdd(path, VerbQuad, coordinates, 4);
+}
+
+void STKPXRasterPathCubicTo(STKPXRasterPath *path, double c1x, double c1y, double c2x, double c2y, double x, double y)
+{
+    double coordinates[] = { c1x, c1y, c2x, c2y, x, y };
+    PathAdd(path, VerbCubic, coordinates, 6);
+}
+
+void STKPXRasterPathClose(STKPXRasterPath *path)
+{
+    PathAdd(path, VerbClose, NULL, 0);
+}
+
+void STKPXRasterPathApply(const STKPXRasterPath *path, void *info, STKPXRasterPathApplier applier)
+{
+    static const size_t coordinateCounts[] = { 2, 2, 4, 6, 0 };
+    const double *coordinates = path->coordinates;
+
+    for (size_t i = 0; i < path->verbCount; i++)
+    {
+        Verb verb = (Verb) path->verbs[i];
+
+        applier(info, (STKPXRasterPathElementType) verb, coordinates);
+        coordinates += coordinateCounts[verb];
+    }
+}
+
+bool STKPXRasterPathGetBounds(const STKPXRasterPath *path, double *minX, double *minY, double *maxX, double *maxY)
+{
+    if (path == NULL || path->coordinateCount < 2)
+    {
+        return false;
+    }
+
+    *minX = *maxX = path->coordinates[0];
+    *minY = *maxY = path->coordinates[1];
+
+    for (size_t i = 2; i + 1 < path->coordinateCount; i += 2)
+    {
+        *minX = fmin(*minX, path->coordinates[i]);
+        *maxX = fmax(*maxX, path->coordinates[i]);
+        *minY = fmin(*minY, path->coordinates[i + 1]);
+        *maxY = fmax(*maxY, path->coordinates[i + 1]);
+    }
+
+    return true;
+}
+
+// MARK: - Flattening
+
+typedef struct
+{
+    size_t start;
+    size_t count;
+    bool closed;
+} Contour;
+
+typedef struct
+{
+    double *points;
+    size_t pointCount;
+    size_t pointCapacity;
+    Contour *contours;
+    size_t contourCount;
+    size_t contourCapacity;
+} Polylines;
+
+static void PolylinesDestroy(Polylines *polylines)
+{
+    free(polylines->points);
+    free(polylines->contours);
+}
+
+static void PolylinesBeginContour(Polylines *polylines)
+{
+    Contour *last = (polylines->contourCount) ? &polylines->contours[polylines->contourCount - 1] : NULL;
+
+    // reuse an empty trailing contour
+    if (last && last->count == 0)
+    {
+        last->closed = false;
+        return;
+    }
+
+    if (Reserve((void **) &polylines->contours, &polylines->contourCapacity, polylines->contourCount + 1, sizeof(Contour)))
+    {
+        polylines->contours[polylines->contourCount++] = (Contour) { polylines->pointCount, 0, false };
+    }
+}
+
+static void PolylinesAddPoint(Polylines *polylines, double x, double y)
+{
+    if (polylines->contourCount == 0)
+    {
+        PolylinesBeginContour(polylines);
+    }
+
+    if (Reserve((void **) &polylines->points, &polylines->pointCapacity, (polylines->pointCount + 1) * 2, sizeof(double)))
+    {
+        polylines->points[polylines->pointCount * 2] = x;
+        polylines->points[polylines->pointCount * 2 + 1] = y;
+        polylines->pointCount++;
+        polylines->contours[polylines->contourCount - 1].count++;
+    }
+}
+
+/**
+ *  Wang's formula: the number of line segments needed to keep a Bezier curve with the given largest second difference
+ *  within tolerance
+ */
+static int SegmentCount(double factor, double secondDifference, double tolerance)
+{
+    double count = ceil(sqrt(factor * secondDifference / tolerance));
+
+    return (int) fmax(1.0, fmin(count, STKPX_RASTER_MAX_SEGMENTS));
+}
+
+static void Flatten(const STKPXRasterPath *path, STKPXRasterTransform transform, double tolerance, Polylines *result)
+{
+    const double *coordinates = path->coordinates;
+    double startX = 0.0, startY = 0.0;
+    double currentX = 0.0, currentY = 0.0;
+    bool hasCurrentPoint = false;
+
+    memset(result, 0, sizeof(Polylines));
+
+    for (size_t i = 0; i < path->verbCount; i++)
+    {
+        Verb verb = (Verb) path->verbs[i];
+
+        // segments without a preceding move continue from the last subpath's start
+        if (verb != VerbMove && verb != VerbClose && !hasCurrentPoint)
+        {
+            PolylinesBeginContour(result);
+            PolylinesAddPoint(result, startX, startY);
+            currentX = startX;
+            currentY = startY;
+            hasCurrentPoint = true;
+        }
+
+        switch (verb)
+        {
+            case VerbMove:
+                TransformPoint(transform, coordinates[0], coordinates[1], &startX, &startY);
+                PolylinesBeginContour(result);
+                PolylinesAddPoint(result, startX, startY);
+                currentX = startX;
+                currentY = startY;
+                hasCurrentPoint = true;
+                coordinates += 2;
+                break;
+
+            case VerbLine:
+                TransformPoint(transform, coordinates[0], coordinates[1], &currentX, &currentY);
+                PolylinesAddPoint(result, currentX, currentY);
+                coordinates += 2;
+                break;
+
+            case VerbQuad:
+            {
+                double x1, y1, x2, y2;
+
+                TransformPoint(transform, coordinates[0], coordinates[1], &x1, &y1);
+                TransformPoint(transform, coordinates[2], coordinates[3], &x2, &y2);
+
+                double ddx = currentX - 2.0 * x1 + x2;
+                double ddy = currentY - 2.0 * y1 + y2;
+                int count = SegmentCount(0.25, hypot(ddx, ddy), tolerance);
+
+                for (int s = 1; s <= count; s++)
+                {
+                    double t = (double) s / count;
+                    double mt = 1.0 - t;
+
+                    PolylinesAddPoint(result,
+                                      mt * mt * currentX + 2.0 * mt * t * x1 + t * t * x2,
+                                      mt * mt * currentY + 2.0 * mt * t * y1 + t * t * y2);
+                }
+
+                currentX = x2;
+                currentY = y2;
+                coordinates += 4;
+                break;
+            }
+
+            case VerbCubic:
+            {
+                double x1, y1, x2, y2, x3, y3;
+
+                TransformPoint(transform, coordinates[0], coordinates[1], &x1, &y1);
+                TransformPoint(transform, coordinates[2], coordinates[3], &x2, &y2);
+                TransformPoint(transform, coordinates[4], coordinates[5], &x3, &y3);
+
+                double dd1 = hypot(currentX - 2.0 * x1 + x2, currentY - 2.0 * y1 + y2);
+                double dd2 = hypot(x1 - 2.0 * x2 + x3, y1 - 2.0 * y2 + y3);
+                int count = SegmentCount(0.75, fmax(dd1, dd2), tolerance);
+
+                for (int s = 1; s <= count; s++)
+                {
+                    double t = (double) s / count;
+                    double mt = 1.0 - t;
+                    double c0 = mt * mt * mt;
+                    double c1 = 3.0 * mt * mt * t;
+                    double c2 = 3.0 * mt * t * t;
+                    double c3 = t * t * t;
+
+                    PolylinesAddPoint(result,
+                                      c0 * currentX + c1 * x1 + c2 * x2 + c3 * x3,
+                                      c0 * currentY + c1 * y1 + c2 * y2 + c3 * y3);
+                }
+
+                currentX = x3;
+                currentY = y3;
+                coordinates += 6;
+                break;
+            }
+
+            case VerbClose:
+                if (result->contourCount)
+                {
+                    result->contours[result->contourCount - 1].closed = true;
+                }
+
+                currentX = startX;
+                currentY = startY;
+                hasCurrentPoint = false;
+                break;
+        }
+    }
+}
+
+// MARK: - Stroking
+
+typedef struct
+{
+    STKPXRasterPath *output;
+    double halfWidth;
+    const STKPXRasterStrokeStyle *style;
+    double tolerance;
+} Stroker;
+
+static void StrokerAddPolygon(Stroker *stroker, const double *points, size_t count)
+{
+    double area = 0.0;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        size_t j = (i + 1) % count;
+
+        area += points[i * 2] * points[j * 2 + 1] - points[j * 2] * points[i * 2 + 1];
+    }
+
+    if (fabs(area) < 1e-12)
+    {
+        return;
+    }
+
+    // emit every polygon with the same orientation so their non-zero union covers overlaps
+    for (size_t n = 0; n < count; n++)
+    {
+        size_t i = (area > 0.0) ? n : count - 1 - n;
+
+        if (n == 0)
+        {
+            STKPXRasterPathMoveTo(stroker->output, points[i * 2], points[i * 2 + 1]);
+        }
+        else
+        {
+            STKPXRasterPathLineTo(stroker->output, points[i * 2], points[i * 2 + 1]);
+        }
+    }
+
+    STKPXRasterPathClose(stroker->output);
+}
+
+static void StrokerAddCircle(Stroker *stroker, double x, double y)
+{
+    double radius = stroker->halfWidth;
+    double step = (radius > stroker->tolerance) ? 2.0 * acos(1.0 - stroker->tolerance / radius) : STKPX_RASTER_PI / 4.0;
+    int count = (int) fmax(8.0, fmin(256.0, ceil(2.0 * STKPX_RASTER_PI / step)));
+    double points[256 * 2];
+
+    for (int i = 0; i < count; i++)
+    {
+        double angle = 2.0 * STKPX_RASTER_PI * i / count;
+
+        points[i * 2] = x + radius * cos(angle);
+        points[i * 2 + 1] = y + radius * sin(angle);
+    }
+
+    StrokerAddPolygon(stroker, points, (size_t) count);
+}
+
+static void StrokerAddSegment(Stroker *stroker, const double *p0, const double *p1)
+{
+    double dx = p1[0] - p0[0];
+    double dy = p1[1] - p0[1];
+    double length = hypot(dx, dy);
+    double nx = -dy / length * stroker->halfWidth;
+    double ny = dx / length * stroker->halfWidth;
+    double quad[] = {
+        p0[0] + nx, p0[1] + ny,
+        p1[0] + nx, p1[1] + ny,
+        p1[0] - nx, p1[1] - ny,
+        p0[0] - nx, p0[1] - ny
+    };
+
+    StrokerAddPolygon(stroker, quad, 4);
+}
+
+static void StrokerAddJoin(Stroker *stroker, const double *previous, const double *point, const double *next)
+{
+    double d0x = point[0] - previous[0], d0y = point[1] - previous[1];
+    double d1x = next[0] - point[0], d1y = next[1] - point[1];
+    double l0 = hypot(d0x, d0y), l1 = hypot(d1x, d1y);
+
+    d0x /= l0; d0y /= l0;
+    d1x /= l1; d1y /= l1;
+
+    double cross = d0x * d1y - d0y * d1x;
+    double cosine = d0x * d1x + d0y * d1y;
+
+    if (fabs(cross) < 1e-9 && cosine > 0.0)
+    {
+        return;
+    }
+
+    if (stroker->style->join == STKPXRasterLineJoinRound)
+    {
+        StrokerAddCircle(stroker, point[0], point[1]);
+        return;
+    }
+
+    // the outer side of the turn is opposite the direction the path turns to
+    double side = (cross > 0.0) ? -1.0 : 1.0;
+    double hw = stroker->halfWidth;
+    double n0x = -d0y * hw * side, n0y = d0x * hw * side;
+    double n1x = -d1y * hw * side, n1y = d1x * hw * side;
+    double miterLimit = (stroker->style->miterLimit > 0.0) ? stroker->style->miterLimit : 10.0;
+
+    if (stroker->style->join == STKPXRasterLineJoinMiter && 1.0 + cosine > 1e-9
+        && 1.0 / sqrt((1.0 + cosine) / 2.0) <= miterLimit)
+    {
+        double tipX = point[0] + (n0x + n1x) / (1.0 + cosine);
+        double tipY = point[1] + (n0y + n1y) / (1.0 + cosine);
+        double miter[] = {
+            point[0], point[1],
+            point[0] + n0x, point[1] + n0y,
+            tipX, tipY,
+            point[0] + n1x, point[1] + n1y
+        };
+
+        StrokerAddPolygon(stroker, miter, 4);
+    }
+    else
+    {
+        double bevel[] = {
+            point[0], point[1],
+            point[0] + n0x, point[1] + n0y,
+            point[0] + n1x, point[1] + n1y
+        };
+
+        StrokerAddPolygon(stroker, bevel, 3);
+    }
+}
+
+static void StrokerAddCap(Stroker *stroker, const double *point, const double *neighbor)
+{
+    switch (stroker->style->cap)
+    {
+        case STKPXRasterLineCapButt:
+            break;
+
+        case STKPXRasterLineCapRound:
+            StrokerAddCircle(stroker, point[0], point[1]);
+            break;
+
+        case STKPXRasterLineCapSquare:
+        {
+            double hw = stroker->halfWidth;
+            double dx = point[0] - neighbor[0];
+            double dy = point[1] - neighbor[1];
+            double length = hypot(dx, dy);
+
+            dx = dx / length * hw;
+            dy = dy / length * hw;
+
+            double square[] = {
+                point[0] - dy, point[1] + dx,
+                point[0] - dy + dx, point[1] + dx + dy,
+                point[0] + dy + dx, point[1] - dx + dy,
+                point[0] + dy, point[1] - dx
+            };
+
+            StrokerAddPolygon(stroker, square, 4);
+            break;
+        }
+    }
+}
+
+static void StrokerAddDot(Stroker *stroker, const double *point)
+{
+    double hw = stroker->halfWidth;
+
+    if (stroker->style->cap == STKPXRasterLineCapRound)
+    {
+        StrokerAddCircle(stroker, point[0], point[1]);
+    }
+    else if (stroker->style->cap == STKPXRasterLineCapSquare)
+    {
+        double square[] = {
+            point[0] - hw, point[1] - hw,
+            point[0] + hw, point[1] - hw,
+            point[0] + hw, point[1] + hw,
+            point[0] - hw, point[1] + hw
+        };
+
+        StrokerAddPolygon(stroker, square, 4);
+    }
+}
+
+/**
+ *  Stroke a polyline whose consecutive points are distinct
+ */
+static void StrokerAddPolyline(Stroker *stroker, const double *points, size_t count, bool closed)
+{
+    if (count == 1)
+    {
+        if (!closed)
+        {
+            StrokerAddDot(stroker, points);
+        }
+
+        return;
+    }
+
+    size_t segmentCount = closed ? count : count - 1;
+
+    for (size_t i = 0; i < segmentCount; i++)
+    {
+        StrokerAddSegment(stroker, points + i * 2, points + ((i + 1) % count) * 2);
+    }
+
+    if (closed)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            StrokerAddJoin(stroker,
+                           points + ((i + count - 1) % count) * 2,
+                           points + i * 2,
+                           points + ((i + 1) % count) * 2);
+        }
+    }
+    else
+    {
+        for (size_t i = 1; i + 1 < count; i++)
+        {
+            StrokerAddJoin(stroker, points + (i - 1) * 2, points + i * 2, points + (i + 1) * 2);
+        }
+
+        StrokerAddCap(stroker, points, points + 2);
+        StrokerAddCap(stroker, points + (count - 1) * 2, points + (count - 2) * 2);
+    }
+}
+
+/**
+ *  Remove repeated points and hand the contour to the stroker, cutting it into dashes first when a pattern is set
+ */
+static void StrokerAddContour(Stroker *stroker, const double *source, size_t sourceCount, bool closed)
+{
+    double *points = malloc((sourceCount + 1) * 2 * sizeof(double));
+    size_t count = 0;
+
+    if (points == NULL)
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < sourceCount; i++)
+    {
+        if (count == 0 || source[i * 2] != points[(count - 1) * 2] || source[i * 2 + 1] != points[(count - 1) * 2 + 1])
+        {
+            points[count * 2] = source[i * 2];
+            points[count * 2 + 1] = source[i * 2 + 1];
+            count++;
+        }
+    }
+
+    if (closed && count > 1 && points[0] == points[(count - 1) * 2] && points[1] == points[(count - 1) * 2 + 1])
+    {
+        count--;
+    }
+
+    const STKPXRasterStrokeStyle *style = stroker->style;
+    double patternLength = 0.0;
+
+    for (size_t i = 0; i < style->dashCount; i++)
+    {
+        patternLength += fmax(0.0, style->dashes[i]);
+    }
+
+    if (style->dashCount == 0 || patternLength <= 0.0 || count < 2)
+    {
+        StrokerAddPolyline(stroker, points, count, closed);
+        free(points);
+        return;
+    }
+
+    // odd patterns repeat to an even number of entries
+    size_t dashCount = (style->dashCount % 2) ? style->dashCount * 2 : style->dashCount;
+
+    if (style->dashCount % 2)
+    {
+        patternLength *= 2.0;
+    }
+
+    // walk the contour, closing segment included, emitting the "on" intervals
+    if (closed)
+    {
+        points[count * 2] = points[0];
+        points[count * 2 + 1] = points[1];
+        count++;
+    }
+
+    double *dash = malloc(count * 2 * sizeof(double));
+    size_t dashPoints = 0;
+    size_t index = 0;
+    double phase = fmod(style->dashOffset, patternLength);
+
+    if (phase < 0.0)
+    {
+        phase += patternLength;
+    }
+
+    double remaining = fmax(0.0, style->dashes[0]);
+
+    while (phase > 0.0 && phase >= remaining)
+    {
+        phase -= remaining;
+        index = (index + 1) % dashCount;
+        remaining = fmax(0.0, style->dashes[index % style->dashCount]);
+    }
+
+    remaining -= phase;
+
+    if (dash == NULL)
+    {
+        free(points);
+        return;
+    }
+
+    if (index % 2 == 0)
+    {
+        dash[0] = points[0];
+        dash[1] = points[1];
+        dashPoints = 1;
+    }
+
+    for (size_t i = 0; i + 1 < count; i++)
+    {
+        double x = points[i * 2], y = points[i * 2 + 1];
+        double dx = points[(i + 1) * 2] - x, dy = points[(i + 1) * 2 + 1] - y;
+        double length = hypot(dx, dy);
+        double travelled = 0.0;
+
+        while (length - travelled > remaining)
+        {
+            travelled += remaining;
+
+            double px = x + dx * travelled / length;
+            double py = y + dy * travelled / length;
+
+            if (index % 2 == 0)
+            {
+                dash[dashPoints * 2] = px;
+                dash[dashPoints * 2 + 1] = py;
+                StrokerAddPolyline(stroker, dash, dashPoints + 1, false);
+                dashPoints = 0;
+            }
+            else
+            {
+                dash[0] = px;
+                dash[1] = py;
+                dashPoints = 1;
+            }
+
+            index = (index + 1) % dashCount;
+            remaining = fmax(0.0, style->dashes[index % style->dashCount]);
+
+            // zero length dashes still get their caps
+            if (remaining == 0.0 && index % 2 == 0)
+            {
+                StrokerAddPolyline(stroker, dash, 1, false);
+            }
+        }
+
+        remaining -= length - travelled;
+
+        if (index % 2 == 0)
+        {
+            dash[dashPoints * 2] = points[(i + 1) * 2];
+            dash[dashPoints * 2 + 1] = points[(i + 1) * 2 + 1];
+            dashPoints++;
+        }
+    }
+
+    if (index % 2 == 0 && dashPoints > 1)
+    {
+        StrokerAddPolyline(stroker, dash, dashPoints, false);
+    }
+
+    free(dash);
+    free(points);
+}
+
+STKPXRasterPath *STKPXRasterPathCreateStroked(const STKPXRasterPath *path,
+                                              const STKPXRasterStrokeStyle *style,
+                                              double tolerance)
+{
+    STKPXRasterPath *result = STKPXRasterPathCreate();
+
+    if (result == NULL || path == NULL || style->width <= 0.0)
+    {
+        return result;
+    }
+
+    Polylines polylines;
+    Stroker stroker = { result, style->width * 0.5, style, fmax(tolerance, 1e-3) };
+
+    Flatten(path, STKPXRasterTransformIdentity, stroker.tolerance, &polylines);
+
+    for (size_t i = 0; i < polylines.contourCount; i++)
+    {
+        Contour contour = polylines.contours[i];
+
+        if (contour.count)
+        {
+            StrokerAddContour(&stroker, polylines.points + contour.start * 2, contour.count, contour.closed);
+        }
+    }
+
+    PolylinesDestroy(&polylines);
+
+    return result;
+}
+
+// MARK: - Threading
+
+static atomic_uint threadCount_ = 0;
+
+void STKPXRasterSetThreadCount(unsigned count)
+{
+    atomic_store(&threadCount_, count);
+}
+
+static unsigned ThreadCount(void)
+{
+    unsigned count = atomic_load(&threadCount_);
+
+    if (count == 0)
+    {
+        long processors = sysconf(_SC_NPROCESSORS_ONLN);
+
+        count = (processors > 0) ? (unsigned) processors : 1;
+    }
+
+    return count;
+}
+
+typedef void (*BandFunction)(void *context, int band);
+
+typedef struct
+{
+    BandFunction function;
+    void *context;
+    int count;
+    atomic_int next;
+} BandQueue;
+
+static void *BandWorker(void *argument)
+{
+    BandQueue *queue = argument;
+    int band;
+
+    while ((band = atomic_fetch_add(&queue->next, 1)) < queue->count)
+    {
+        queue->function(queue->context, band);
+    }
+
+    return NULL;
+}
+
+/**
+ *  Run function for every band, spreading the bands over worker threads when parallel is set
+ */
+static void ParallelFor(int count, bool parallel, BandFunction function, void *context)
+{
+    BandQueue queue = { function, context, count, 0 };
+    unsigned threads = parallel ? ThreadCount() : 1;
+    pthread_t workers[32];
+    unsigned started = 0;
+
+    if (threads > (unsigned) count)
+    {
+        threads = (unsigned) count;
+    }
+
+    for (unsigned i = 1; i < threads && i <= 32; i++)
+    {
+        if (pthread_create(&workers[started], NULL, BandWorker, &queue) == 0)
+        {
+            started++;
+        }
+    }
+
+    BandWorker(&queue);
+
+    for (unsigned i = 0; i < started; i++)
+    {
+        pthread_join(workers[i], NULL);
+    }
+}
+
+// MARK: - Coverage
+
+typedef struct
+{
+    double x0, y0, x1, y1;
+} Line;
+
+typedef struct
+{
+    Line *lines;
+    size_t count;
+    size_t capacity;
+    double minX, minY, maxX, maxY;
+} LineList;
+
+static void LineListAppend(LineList *list, double x0, double y0, double x1, double y1)
+{
+    if (y0 == y1 || !Reserve((void **) &list->lines, &list->capacity, list->count + 1, sizeof(Line)))
+    {
+        return;
+    }
+
+    list->lines[list->count++] = (Line) { x0, y0, x1, y1 };
+    list->minX = fmin(list->minX, fmin(x0, x1));
+    list->maxX = fmax(list->maxX, fmax(x0, x1));
+    list->minY = fmin(list->minY, fmin(y0, y1));
+    list->maxY = fmax(list->maxY, fmax(y0, y1));
+}
+
+/**
+ *  Add an edge, splitting it where it leaves the surface horizontally. Parts left of the surface collapse onto x = 0
+ *  where they still contribute their winding to every pixel of the row; parts right of it collapse onto x = width
+ */
+static void LineListAdd(LineList *list, double x0, double y0, double x1, double y1, int width)
+{
+    double splits[2];
+    int splitCount = 0;
+
+    if ((x0 < 0.0) != (x1 < 0.0))
+    {
+        splits[splitCount++] = (0.0 - x0) / (x1 - x0);
+    }
+
+    if ((x0 < width) != (x1 < width))
+    {
+        splits[splitCount++] = (width - x0) / (x1 - x0);
+    }
+
+    if (splitCount == 2 && splits[0] > splits[1])
+    {
+        double swap = splits[0];
+
+        splits[0] = splits[1];
+        splits[1] = swap;
+    }
+
+    double startX = x0, startY = y0;
+
+    for (int i = 0; i <= splitCount; i++)
+    {
+        double t = (i < splitCount) ? splits[i] : 1.0;
+        double endX = (i < splitCount) ? x0 + (x1 - x0) * t : x1;
+        double endY = (i < splitCount) ? y0 + (y1 - y0) * t : y1;
+
+        LineListAppend(list,
+                       fmin(fmax(startX, 0.0), width), startY,
+                       fmin(fmax(endX, 0.0), width), endY);
+        startX = endX;
+        startY = endY;
+    }
+}
+
+static bool LineListInit(LineList *list, const STKPXRasterPath *path, STKPXRasterTransform transform, int width)
+{
+    Polylines polylines;
+
+    memset(list, 0, sizeof(LineList));
+    list->minX = list->minY = INFINITY;
+    list->maxX = list->maxY = -INFINITY;
+
+    if (path == NULL)
+    {
+        return false;
+    }
+
+    Flatten(path, transform, STKPX_RASTER_FLATTEN_TOLERANCE, &polylines);
+
+    for (size_t c = 0; c < polylines.contourCount; c++)
+    {
+        Contour contour = polylines.contours[c];
+        const double *points = polylines.points + contour.start * 2;
+
+        // filled subpaths are closed implicitly
+        for (size_t i = 0; i < contour.count; i++)
+        {
+            size_t j = (i + 1) % contour.count;
+
+            LineListAdd(list, points[i * 2], points[i * 2 + 1], points[j * 2], points[j * 2 + 1], width);
+        }
+    }
+
+    PolylinesDestroy(&polylines);
+
+    return list->count > 0;
+}
+
+typedef void (*RowFunction)(void *context, int y, int x, int count, const uint8_t *coverage, uint8_t *scratch);
+
+typedef struct
+{
+    const LineList *lines;
+    STKPXRasterFillRule rule;
+    int left;
+    int top;
+    int width;
+    int height;
+    RowFunction rowFunction;
+    void *rowContext;
+} CoverageJob;
+
+/**
+ *  Accumulate the signed area each edge covers in each cell of the band
+ */
+static void AccumulateLine(float *accumulation, int stride, int bandTop, int bandHeight, int left, const Line *line)
+{
+    double direction = 1.0;
+    double x0 = line->x0 - left, y0 = line->y0 - bandTop;
+    double x1 = line->x1 - left, y1 = line->y1 - bandTop;
+
+    if (y0 > y1)
+    {
+        double swap;
+
+        swap = x0; x0 = x1; x1 = swap;
+        swap = y0; y0 = y1; y1 = swap;
+        direction = -1.0;
+    }
+
+    if (y1 <= 0.0 || y0 >= bandHeight)
+    {
+        return;
+    }
+
+    double dxdy = (x1 - x0) / (y1 - y0);
+    double x = x0;
+    int rowStart = 0;
+    int rowEnd = (int) fmin(bandHeight, ceil(y1));
+    double maxX = stride - 2;
+
+    if (y0 < 0.0)
+    {
+        x -= y0 * dxdy;
+    }
+    else
+    {
+        rowStart = (int) y0;
+    }
+
+    for (int row = rowStart; row < rowEnd; row++)
+    {
+        float *cells = accumulation + row * stride;
+        double dy = fmin(row + 1.0, y1) - fmax(row, y0);
+        double xNext = fmin(fmax(x + dxdy * dy, 0.0), maxX);
+        double d = dy * direction;
+        double xa = fmin(x, xNext);
+        double xb = fmax(x, xNext);
+        double xaFloor = floor(xa);
+        int xai = (int) xaFloor;
+        int xbi = (int) ceil(xb);
+
+        if (xbi <= xai + 1)
+        {
+            double xmf = 0.5 * (x + xNext) - xaFloor;
+
+            cells[xai] += (float) (d - d * xmf);
+            cells[xai + 1] += (float) (d * xmf);
+        }
+        else
+        {
+            double s = 1.0 / (xb - xa);
+            double xaf = xa - xaFloor;
+            double a0 = 0.5 * s * (1.0 - xaf) * (1.0 - xaf);
+            double xbf = xb - xbi + 1.0;
+            double am = 0.5 * s * xbf * xbf;
+
+            cells[xai] += (float) (d * a0);
+
+            if (xbi == xai + 2)
+            {
+                cells[xai + 1] += (float) (d * (1.0 - a0 - am));
+            }
+            else
+            {
+                double a1 = s * (1.5 - xaf);
+
+                cells[xai + 1] += (float) (d * (a1 - a0));
+
+                for (int xi = xai + 2; xi < xbi - 1; xi++)
+                {
+                    cells[xi] += (float) (d * s);
+                }
+
+                double a2 = a1 + (xbi - xai - 3) * s;
+
+                cells[xbi - 1] += (float) (d * (1.0 - a2 - am));
+            }
+
+            cells[xbi] += (float) (d * am);
+        }
+
+        x = xNext;
+    }
+}
+
+static void CoverageBand(void *context, int band)
+{
+    CoverageJob *job = context;
+    int bandTop = job->top + band * STKPX_RASTER_BAND_HEIGHT;
+    int bandHeight = (int) fmin(STKPX_RASTER_BAND_HEIGHT, job->top + job->height - bandTop);
+    int stride = job->width + 2;
+    float *accumulation = calloc((size_t) stride * bandHeight, sizeof(float));
+    uint8_t *coverage = malloc((size_t) job->width * 5);
+
+    if (accumulation == NULL || coverage == NULL)
+    {
+        free(accumulation);
+        free(coverage);
+        return;
+    }
+
+    for (size_t i = 0; i < job->lines->count; i++)
+    {
+        AccumulateLine(accumulation, stride, bandTop, bandHeight, job->left, &job->lines->lines[i]);
+    }
+
+    for (int row = 0; row < bandHeight; row++)
+    {
+        const float *cells = accumulation + row * stride;
+        float winding = 0.0f;
+        bool empty = true;
+
+        for (int x = 0; x < job->width; x++)
+        {
+            float value;
+
+            winding += cells[x];
+            value = fabsf(winding);
+
+            if (job->rule == STKPXRasterFillRuleEvenOdd)
+            {
+                value = fmodf(value, 2.0f);
+                value = (value > 1.0f) ? 2.0f - value : value;
+            }
+            else if (value > 1.0f)
+            {
+                value = 1.0f;
+            }
+
+            coverage[x] = (uint8_t) (value * 255.0f + 0.5f);
+            empty = empty && coverage[x] == 0;
+        }
+
+        if (!empty)
+        {
+            job->rowFunction(job->rowContext, bandTop + row, job->left, job->width, coverage, coverage + job->width);
+        }
+    }
+
+    free(accumulation);
+    free(coverage);
+}
+
+/**
+ *  Compute the coverage of a path row by row, handing each non-empty row to rowFunction. Rows are processed in bands
+ *  of STKPX_RASTER_BAND_HEIGHT that run in parallel for large areas. rowFunction receives 4 * count bytes of scratch
+ */
+static void RenderCoverage(const STKPXRasterPath *path,
+                           STKPXRasterTransform transform,
+                           STKPXRasterFillRule rule,
+                           int width,
+                           int height,
+                           RowFunction rowFunction,
+                           void *rowContext)
+{
+    LineList lines = { NULL, 0, 0, 0.0, 0.0, 0.0, 0.0 };
+
+    if (width > 0 && height > 0 && LineListInit(&lines, path, transform, width))
+    {
+        int left = (int) fmax(0.0, floor(lines.minX));
+        int right = (int) fmin(width, ceil(lines.maxX) + 1.0);
+        int top = (int) fmax(0.0, floor(lines.minY));
+        int bottom = (int) fmin(height, ceil(lines.maxY));
+
+        if (left < right && top < bottom)
+        {
+            CoverageJob job = { &lines, rule, left, top, right - left, bottom - top, rowFunction, rowContext };
+            int bands = (job.height + STKPX_RASTER_BAND_HEIGHT - 1) / STKPX_RASTER_BAND_HEIGHT;
+
+            ParallelFor(bands, job.width * job.height >= STKPX_RASTER_PARALLEL_AREA, CoverageBand, &job);
+        }
+    }
+
+    free(lines.lines);
+}
+
+// MARK: - Paints
+
+static inline uint8_t Multiply255(unsigned value1, unsigned value2)
+{
+    unsigned product = value1 * value2 + 128;
+
+    return (uint8_t) ((product + (product >> 8)) >> 8);
+}
+
+static inline uint8_t ClampByte(double value)
+{
+    return (uint8_t) fmin(255.0, fmax(0.0, value * 255.0 + 0.5));
+}
+
+typedef struct
+{
+    STKPXRasterPaintType type;
+    uint8_t color[4];
+    uint8_t table[256][4];
+    STKPXRasterTransform inverse;
+    const STKPXRasterPaint *paint;
+    bool valid;
+} Shader;
+
+static void PremultipliedColor(double r, double g, double b, double a, uint8_t *result)
+{
+    a = fmin(1.0, fmax(0.0, a));
+    result[0] = ClampByte(r * a);
+    result[1] = ClampByte(g * a);
+    result[2] = ClampByte(b * a);
+    result[3] = ClampByte(a);
+}
+
+static void ShaderInit(Shader *shader, const STKPXRasterPaint *paint)
+{
+    shader->type = paint->type;
+    shader->paint = paint;
+    shader->valid = true;
+
+    if (paint->type == STKPXRasterPaintTypeSolid)
+    {
+        PremultipliedColor(paint->r, paint->g, paint->b, paint->a, shader->color);
+        return;
+    }
+
+    if (paint->stopCount == 0 || !TransformInvert(paint->transform, &shader->inverse))
+    {
+        shader->valid = false;
+        return;
+    }
+
+    // colors are interpolated unpremultiplied and premultiplied afterwards
+    for (int i = 0; i < 256; i++)
+    {
+        double t = i / 255.0;
+        const STKPXRasterColorStop *stops = paint->stops;
+        size_t last = paint->stopCount - 1;
+
+        if (t <= stops[0].offset)
+        {
+            PremultipliedColor(stops[0].r, stops[0].g, stops[0].b, stops[0].a, shader->table[i]);
+        }
+        else if (t >= stops[last].offset)
+        {
+            PremultipliedColor(stops[last].r, stops[last].g, stops[last].b, stops[last].a, shader->table[i]);
+        }
+        else
+        {
+            size_t s = 0;
+
+            while (s < last && stops[s + 1].offset < t)
+            {
+                s++;
+            }
+
+            const STKPXRasterColorStop *from = &stops[s];
+            const STKPXRasterColorStop *to = &stops[s + 1];
+            double span = to->offset - from->offset;
+            double f = (span > 0.0) ? (t - from->offset) / span : 1.0;
+
+            PremultipliedColor(from->r + (to->r - from->r) * f,
+                               from->g + (to->g - from->g) * f,
+                               from->b + (to->b - from->b) * f,
+                               from->a + (to->a - from->a) * f,
+                               shader->table[i]);
+        }
+    }
+}
+
+/**
+ *  Return the gradient parameter of a point in paint space, or NAN when the gradient does not cover it
+ */
+static double GradientParameter(const STKPXRasterPaint *paint, double x, double y)
+{
+    if (paint->type == STKPXRasterPaintTypeLinearGradient)
+    {
+        double dx = paint->x1 - paint->x0;
+        double dy = paint->y1 - paint->y0;
+        double lengthSquared = dx * dx + dy * dy;
+
+        if (lengthSquared == 0.0)
+        {
+            return 1.0;
+        }
+
+        return ((x - paint->x0) * dx + (y - paint->y0) * dy) / lengthSquared;
+    }
+
+    // two point conical: find the largest t where the point lies on the circle interpolated between both circles
+    double cdx = paint->x1 - paint->x0;
+    double cdy = paint->y1 - paint->y0;
+    double dr = paint->r1 - paint->r0;
+    double pdx = x - paint->x0;
+    double pdy = y - paint->y0;
+    double a = cdx * cdx + cdy * cdy - dr * dr;
+    double b = pdx * cdx + pdy * cdy + paint->r0 * dr;
+    double c = pdx * pdx + pdy * pdy - paint->r0 * paint->r0;
+
+    if (fabs(a) < 1e-9)
+    {
+        if (fabs(b) < 1e-9)
+        {
+            return NAN;
+        }
+
+        double t = c / (2.0 * b);
+
+        return (paint->r0 + t * dr >= 0.0) ? t : NAN;
+    }
+
+    double discriminant = b * b - a * c;
+
+    if (discriminant < 0.0)
+    {
+        return NAN;
+    }
+
+    double root = sqrt(discriminant);
+    double t1 = (b + root) / a;
+    double t2 = (b - root) / a;
+    double larger = fmax(t1, t2);
+    double smaller = fmin(t1, t2);
+
+    if (paint->r0 + larger * dr >= 0.0)
+    {
+        return larger;
+    }
+
+    return (paint->r0 + smaller * dr >= 0.0) ? smaller : NAN;
+}
+
+static void ShadeSpan(const Shader *shader, int x, int y, int count, uint8_t *result)
+{
+    if (shader->type == STKPXRasterPaintTypeSolid)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            memcpy(result + i * 4, shader->color, 4);
+        }
+
+        return;
+    }
+
+    const STKPXRasterTransform m = shader->inverse;
+
+    for (int i = 0; i < count; i++)
+    {
+        double px, py;
+
+        TransformPoint(m, x + i + 0.5, y + 0.5, &px, &py);
+
+        double t = GradientParameter(shader->paint, px, py);
+
+        if (isnan(t))
+        {
+            memset(result + i * 4, 0, 4);
+        }
+        else
+        {
+            int index = (int) (fmin(1.0, fmax(0.0, t)) * 255.0 + 0.5);
+
+            memcpy(result + i * 4, shader->table[index], 4);
+        }
+    }
+}
+
+static inline void BlendPixel(uint8_t *destination, const uint8_t *source, unsigned coverage)
+{
+    if (coverage == 0)
+    {
+        return;
+    }
+
+    uint8_t r = Multiply255(source[0], coverage);
+    uint8_t g = Multiply255(source[1], coverage);
+    uint8_t b = Multiply255(source[2], coverage);
+    uint8_t a = Multiply255(source[3], coverage);
+    unsigned inverse = 255 - a;
+
+    destination[0] = (uint8_t) (r + Multiply255(destination[0], inverse));
+    destination[1] = (uint8_t) (g + Multiply255(destination[1], inverse));
+    destination[2] = (uint8_t) (b + Multiply255(destination[2], inverse));
+    destination[3] = (uint8_t) (a + Multiply255(destination[3], inverse));
+}
+
+// MARK: - Surfaces
+
+bool STKPXRasterSurfaceInit(STKPXRasterSurface *surface, int width, int height)
+{
+    memset(surface, 0, sizeof(STKPXRasterSurface));
+
+    if (width <= 0 || height <= 0)
+    {
+        return false;
+    }
+
+    surface->pixels = calloc((size_t) width * height, 4);
+
+    if (surface->pixels == NULL)
+    {
+        return false;
+    }
+
+    surface->width = width;
+    surface->height = height;
+    surface->bytesPerRow = (size_t) width * 4;
+
+    return true;
+}
+
+void STKPXRasterSurfaceDestroy(STKPXRasterSurface *surface)
+{
+    free(surface->pixels);
+    memset(surface, 0, sizeof(STKPXRasterSurface));
+}
+
+// MARK: - Rendering
+
+typedef struct
+{
+    STKPXRasterSurface *surface;
+    const Shader *shader;
+    const uint8_t *clip;
+    unsigned opacity;
+} FillContext;
+
+static void FillRow(void *context, int y, int x, int count, const uint8_t *coverage, uint8_t *scratch)
+{
+    FillContext *fill = context;
+    uint8_t *row = fill->surface->pixels + y * fill->surface->bytesPerRow + x * 4;
+    const uint8_t *clip = (fill->clip) ? fill->clip + (size_t) y * fill->surface->width + x : NULL;
+
+    ShadeSpan(fill->shader, x, y, count, scratch);
+
+    for (int i = 0; i < count; i++)
+    {
+        unsigned alpha = Multiply255(coverage[i], fill->opacity);
+
+        if (clip)
+        {
+            alpha = Multiply255(alpha, clip[i]);
+        }
+
+        BlendPixel(row + i * 4, scratch + i * 4, alpha);
+    }
+}
+
+void STKPXRasterFillPath(STKPXRasterSurface *surface,
+                         const STKPXRasterPath *path,
+                         STKPXRasterTransform transform,
+                         STKPXRasterFillRule rule,
+                         const STKPXRasterPaint *paint,
+                         const uint8_t *clip,
+                         double opacity)
+{
+    Shader *shader = malloc(sizeof(Shader));
+
+    if (shader == NULL || surface->pixels == NULL)
+    {
+        free(shader);
+        return;
+    }
+
+    ShaderInit(shader, paint);
+
+    if (shader->valid)
+    {
+        FillContext context = { surface, shader, clip, ClampByte(opacity) };
+
+        RenderCoverage(path, transform, rule, surface->width, surface->height, FillRow, &context);
+    }
+
+    free(shader);
+}
+
+typedef struct
+{
+    uint8_t *mask;
+    int width;
+} MaskContext;
+
+static void MaskRow(void *context, int y, int x, int count, const uint8_t *coverage, uint8_t *scratch)
+{
+    MaskContext *mask = context;
+
+    (void) scratch;
+    memcpy(mask->mask + (size_t) y * mask->width + x, coverage, (size_t) count);
+}
+
+void STKPXRasterRenderMask(uint8_t *mask,
+                           int width,
+                           int height,
+                           const STKPXRasterPath *path,
+                           STKPXRasterTransform transform,
+                           STKPXRasterFillRule rule)
+{
+    MaskContext context = { mask, width };
+
+    memset(mask, 0, (size_t) width * height);
+    RenderCoverage(path, transform, rule, width, height, MaskRow, &context);
+}
+
+static void BoxBlur(const uint8_t *source, uint8_t *destination, int length, int stride, int radius)
+{
+    int window = radius * 2 + 1;
+    unsigned sum = 0;
+
+    // values outside the mask count as zero
+    for (int i = 0; i < radius && i < length; i++)
+    {
+        sum += source[i * stride];
+    }
+
+    for (int i = 0; i < length; i++)
+    {
+        int entering = i + radius;
+        int leaving = i - radius - 1;
+
+        if (entering < length)
+        {
+            sum += source[entering * stride];
+        }
+
+        if (leaving >= 0)
+        {
+            sum -= source[leaving * stride];
+        }
+
+        destination[i * stride] = (uint8_t) ((sum + window / 2) / window);
+    }
+}
+
+void STKPXRasterBlurMask(uint8_t *mask, int width, int height, double sigma)
+{
+    if (sigma <= 0.0 || width <= 0 || height <= 0)
+    {
+        return;
+    }
+
+    // box sizes for a three pass approximation of a Gaussian
+    const int passes = 3;
+    double ideal = sqrt(12.0 * sigma * sigma / passes + 1.0);
+    int lower = (int) floor(ideal);
+
+    if (lower % 2 == 0)
+    {
+        lower--;
+    }
+
+    int upper = lower + 2;
+    double idealCount = (12.0 * sigma * sigma - passes * lower * lower - 4.0 * passes * lower - 3.0 * passes)
+                        / (-4.0 * lower - 4.0);
+    int lowerCount = (int) round(idealCount);
+    uint8_t *scratch = malloc((size_t) width * height);
+
+    if (scratch == NULL)
+    {
+        return;
+    }
+
+    for (int pass = 0; pass < passes; pass++)
+    {
+        int radius = (((pass < lowerCount) ? lower : upper) - 1) / 2;
+
+        if (radius <= 0)
+        {
+            continue;
+        }
+
+        for (int y = 0; y < height; y++)
+        {
+            BoxBlur(mask + (size_t) y * width, scratch + (size_t) y * width, width, 1, radius);
+        }
+
+        for (int x = 0; x < width; x++)
+        {
+            BoxBlur(scratch + x, mask + x, height, width, radius);
+        }
+    }
+
+    free(scratch);
+}
+
+void STKPXRasterFillMask(STKPXRasterSurface *surface,
+                         const uint8_t *mask,
+                         int maskWidth,
+                         int maskHeight,
+                         int originX,
+                         int originY,
+                         const STKPXRasterPaint *paint,
+                         const uint8_t *clip,
+                         double opacity)
+{
+    Shader *shader = malloc(sizeof(Shader));
+    int left = (originX > 0) ? originX : 0;
+    int top = (originY > 0) ? originY : 0;
+    int right = (int) fmin(surface->width, originX + maskWidth);
+    int bottom = (int) fmin(surface->height, originY + maskHeight);
+    uint8_t *scratch = malloc((size_t) (right > left ? right - left : 1) * 4);
+
+    if (shader && scratch && surface->pixels && left < right && top < bottom)
+    {
+        ShaderInit(shader, paint);
+
+        if (shader->valid)
+        {
+            unsigned alpha = ClampByte(opacity);
+
+            for (int y = top; y < bottom; y++)
+            {
+                const uint8_t *coverage = mask + (size_t) (y - originY) * maskWidth + (left - originX);
+                const uint8_t *clipRow = (clip) ? clip + (size_t) y * surface->width : NULL;
+                uint8_t *row = surface->pixels + y * surface->bytesPerRow;
+
+                ShadeSpan(shader, left, y, right - left, scratch);
+
+                for (int x = left; x < right; x++)
+                {
+                    unsigned value = Multiply255(coverage[x - left], alpha);
+
+                    if (clipRow)
+                    {
+                        value = Multiply255(value, clipRow[x]);
+                    }
+
+                    BlendPixel(row + x * 4, scratch + (x - left) * 4, value);
+                }
+            }
+        }
+    }
+
+    free(shader);
+    free(scratch);
+}
+
+void STKPXRasterCompositeSurface(STKPXRasterSurface *destination, const STKPXRasterSurface *source, double opacity)
+{
+    unsigned alpha = ClampByte(opacity);
+    int width = (int) fmin(destination->width, source->width);
+    int height = (int) fmin(destination->height, source->height);
+
+    for (int y = 0; y < height; y++)
+    {
+        uint8_t *row = destination->pixels + y * destination->bytesPerRow;
+        const uint8_t *sourceRow = source->pixels + y * source->bytesPerRow;
+
+        for (int x = 0; x < width; x++)
+        {
+            BlendPixel(row + x * 4, sourceRow + x * 4, alpha);
+        }
+    }
+}
+
+// MARK: - Comparison
+
+STKPXRasterComparison STKPXRasterCompare(const uint8_t *pixels1,
+                                         size_t bytesPerRow1,
+                                         const uint8_t *pixels2,
+                                         size_t bytesPerRow2,
+                                         int width,
+                                         int height,
+                                         int threshold)
+{
+    STKPXRasterComparison result = { 0, 0.0 };
+    size_t differing = 0;
+
+    for (int y = 0; y < height; y++)
+    {
+        const uint8_t *row1 = pixels1 + y * bytesPerRow1;
+        const uint8_t *row2 = pixels2 + y * bytesPerRow2;
+
+        for (int x = 0; x < width * 4; x += 4)
+        {
+            int pixelDifference = 0;
+
+            for (int channel = 0; channel < 4; channel++)
+            {
+                int difference = abs((int) row1[x + channel] - (int) row2[x + channel]);
+
+                pixelDifference = (difference > pixelDifference) ? difference : pixelDifference;
+            }
+
+            if (pixelDifference > threshold)
+            {
+                differing++;
+            }
+
+            if (pixelDifference > result.maxChannelDifference)
+            {
+                result.maxChannelDifference = pixelDifference;
+            }
+        }
+    }
+
+    if (width > 0 && height > 0)
+    {
+        result.differingPixelRatio = (double) differing / ((double) width * height);
+    }
+
+    return result;
+}
@@ -0,0 +1,260 @@
+/****************************************************************************
+ *
+ * Copyright 2015-present StylingKit Development Team. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ****************************************************************************/
+
+//
+//  STKPXRaster.h
+//  StylingKit
+//
+//  A portable CPU rasterizer. It only depends on the C standard library and POSIX threads so shape rendering can be
+//  exercised and compared against expected images on machines without CoreGraphics.
+//
+
+#ifndef STKPXRaster_h
+#define STKPXRaster_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// MARK: - Transforms
+
+/**
+ *  An affine transform with the same layout and meaning as CGAffineTransform:
+ *  x' = a * x + c * y + tx, y' = b * x + d * y + ty
+ */
+typedef struct
+{
+    double a, b, c, d, tx, ty;
+} STKPXRasterTransform;
+
+extern const STKPXRasterTransform STKPXRasterTransformIdentity;
+
+/**
+ *  Return the transform that applies t1 and then t2
+ */
+STKPXRasterTransform STKPXRasterTransformConcat(STKPXRasterTransform t1, STKPXRasterTransform t2);
+
+// MARK: - Paths
+
+typedef struct STKPXRasterPath STKPXRasterPath;
+
+STKPXRasterPath *STKPXRasterPathCreate(void);
+void STKPXRasterPathRelease(STKPXRasterPath *path);
+
+void STKPXRasterPathMoveTo(STKPXRasterPath *path, double x, double y);
+void STKPXRasterPathLineTo(STKPXRasterPath *path, double x, double y);
+void STKPXRasterPathQuadTo(STKPXRasterPath *path, double cx, double cy, double x, double y);
+void STKPXRasterPathCubicTo(STKPXRasterPath *path, double c1x, double c1y, double c2x, double c2y, double x, double y);
+void STKPXRasterPathClose(STKPXRasterPath *path);
+
+typedef enum
+{
+    STKPXRasterPathElementMoveTo,
+    STKPXRasterPathElementLineTo,
+    STKPXRasterPathElementQuadTo,
+    STKPXRasterPathElementCubicTo,
+    STKPXRasterPathElementClose
+} STKPXRasterPathElementType;
+
+typedef void (*STKPXRasterPathApplier)(void *info, STKPXRasterPathElementType type, const double *points);
+
+/**
+ *  Call applier for each element of the path, in the manner of CGPathApply. points holds the x and y of each point the
+ *  element adds
+ */
+void STKPXRasterPathApply(const STKPXRasterPath *path, void *info, STKPXRasterPathApplier applier);
+
+/**
+ *  Return the bounds of all points of the path, control points included. Returns false for an empty path
+ */
+bool STKPXRasterPathGetBounds(const STKPXRasterPath *path, double *minX, double *minY, double *maxX, double *maxY);
+
+typedef enum
+{
+    STKPXRasterLineCapButt,
+    STKPXRasterLineCapRound,
+    STKPXRasterLineCapSquare
+} STKPXRasterLineCap;
+
+typedef enum
+{
+    STKPXRasterLineJoinMiter,
+    STKPXRasterLineJoinRound,
+    STKPXRasterLineJoinBevel
+} STKPXRasterLineJoin;
+
+typedef struct
+{
+    double width;
+    STKPXRasterLineCap cap;
+    STKPXRasterLineJoin join;
+    double miterLimit;
+    const double *dashes;
+    size_t dashCount;
+    double dashOffset;
+} STKPXRasterStrokeStyle;
+
+/**
+ *  Return the outline of the stroked path as a set of closed polygons that must be filled with the non-zero rule.
+ *  Curves are flattened to within tolerance, in path units
+ */
+STKPXRasterPath *STKPXRasterPathCreateStroked(const STKPXRasterPath *path,
+                                              const STKPXRasterStrokeStyle *style,
+                                              double tolerance);
+
+// MARK: - Paints
+
+typedef enum
+{
+    STKPXRasterFillRuleNonZero,
+    STKPXRasterFillRuleEvenOdd
+} STKPXRasterFillRule;
+
+typedef enum
+{
+    STKPXRasterPaintTypeSolid,
+    STKPXRasterPaintTypeLinearGradient,
+    STKPXRasterPaintTypeRadialGradient
+} STKPXRasterPaintType;
+
+/**
+ *  A gradient stop. Components are not premultiplied and range from 0 to 1
+ */
+typedef struct
+{
+    double offset;
+    double r, g, b, a;
+} STKPXRasterColorStop;
+
+/**
+ *  Solid colors use r, g, b, a (not premultiplied). Linear gradients run from (x0, y0) to (x1, y1); radial gradients
+ *  from the circle (x0, y0, r0) to the circle (x1, y1, r1). Gradients extend past both ends and are defined in paint
+ *  space, which transform maps to device space
+ */
+typedef struct
+{
+    STKPXRasterPaintType type;
+    double r, g, b, a;
+    const STKPXRasterColorStop *stops;
+    size_t stopCount;
+    double x0, y0, r0;
+    double x1, y1, r1;
+    STKPXRasterTransform transform;
+} STKPXRasterPaint;
+
+// MARK: - Surfaces
+
+/**
+ *  A premultiplied RGBA buffer with 8 bits per channel
+ */
+typedef struct
+{
+    uint8_t *pixels;
+    int width;
+    int height;
+    size_t bytesPerRow;
+} STKPXRasterSurface;
+
+/**
+ *  Allocate a cleared surface. Returns false when the size is invalid or memory is exhausted
+ */
+bool STKPXRasterSurfaceInit(STKPXRasterSurface *surface, int width, int height);
+void STKPXRasterSurfaceDestroy(STKPXRasterSurface *surface);
+
+// MARK: - Rendering
+
+/**
+ *  Fill a path, transformed to device space, with source-over compositing. clip is an optional width * height coverage
+ *  mask the result is multiplied with
+ */
+void STKPXRasterFillPath(STKPXRasterSurface *surface,
+                         const STKPXRasterPath *path,
+                         STKPXRasterTransform transform,
+                         STKPXRasterFillRule rule,
+                         const STKPXRasterPaint *paint,
+                         const uint8_t *clip,
+                         double opacity);
+
+/**
+ *  Render the anti-aliased coverage of a path into a width * height mask
+ */
+void STKPXRasterRenderMask(uint8_t *mask,
+                           int width,
+                           int height,
+                           const STKPXRasterPath *path,
+                           STKPXRasterTransform transform,
+                           STKPXRasterFillRule rule);
+
+/**
+ *  Approximate a Gaussian blur of a mask with three box blurs
+ */
+void STKPXRasterBlurMask(uint8_t *mask, int width, int height, double sigma);
+
+/**
+ *  Paint through a mask whose top-left pixel lies at (originX, originY) on the surface
+ */
+void STKPXRasterFillMask(STKPXRasterSurface *surface,
+                         const uint8_t *mask,
+                         int maskWidth,
+                         int maskHeight,
+                         int originX,
+                         int originY,
+                         const STKPXRasterPaint *paint,
+                         const uint8_t *clip,
+                         double opacity);
+
+/**
+ *  Composite one surface of the same size over another
+ */
+void STKPXRasterCompositeSurface(STKPXRasterSurface *destination, const STKPXRasterSurface *source, double opacity);
+
+// MARK: - Comparison
+
+typedef struct
+{
+    int maxChannelDifference;
+    double differingPixelRatio;
+} STKPXRasterComparison;
+
+/**
+ *  Compare two RGBA buffers. A pixel differs when any of its channels differs by more than threshold
+ */
+STKPXRasterComparison STKPXRasterCompare(const uint8_t *pixels1,
+                                         size_t bytesPerRow1,
+                                         const uint8_t *pixels2,
+                                         size_t bytesPerRow2,
+                                         int width,
+                                         int height,
+                                         int threshold);
+
+// MARK: - Threading
+
+/**
+ *  Set the number of threads large surfaces are rendered with. 0, the default, uses one thread per CPU
+ */
+void STKPXRasterSetThreadCount(unsigned count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,77 @@
+/****************************************************************************
+ *
+ * Copyright 2015-present StylingKit Development Team. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ****************************************************************************/
+
+//
+//  STKPXRasterBackend.h
+//  StylingKit
+//
+
+#import <Foundation/Foundation.h>
+#import "STKPXRenderBackend.h"
+#import "STKPXRaster.h"
+
+/**
+ *  STKPXRasterBackend renders into a premultiplied RGBA buffer using the portable rasterizer in STKPXRaster.h instead of
+ *  CoreGraphics. Fills, strokes, linear and radial gradients, transparency layers and outer and inner shadows are
+ *  supported; image paints are skipped and all drawing uses the normal blend mode.
+ *
+ *  A backend instance must only be used from one thread at a time. Large fills are split across worker threads
+ *  internally.
+ */
+@interface STKPXRasterBackend : NSObject <STKPXRenderBackend>
+
+/**
+ *  The size of the rendered area in points
+ */
+@property (nonatomic, readonly) CGSize size;
+
+/**
+ *  The number of pixels per point
+ */
+@property (nonatomic, readonly) CGFloat scale;
+
+/**
+ *  The buffer this backend renders into. Its size is the backend's size multiplied by its scale
+ */
+@property (nonatomic, readonly) const STKPXRasterSurface *surface;
+
+/**
+ *  A UIImage with the current contents of the buffer
+ */
+@property (nonatomic, readonly) UIImage *image;
+
+/**
+ *  Initialize a new backend with a cleared buffer
+ *
+ *  @param size The size of the rendered area in points
+ *  @param scale The number of pixels per point. A scale of 0 uses the main screen's scale
+ */
+- (instancetype)initWithSize:(CGSize)size scale:(CGFloat)scale NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ *  Compare the buffer with the pixels of an image. Images whose pixel size differs from the buffer's compare as
+ *  entirely different
+ *
+ *  @param image The image to compare with
+ *  @param threshold The largest channel difference for which pixels are considered equal
+ */
+- (STKPXRasterComparison)compareWithImage:(UIImage *)image threshold:(int)threshold;
+
+@end
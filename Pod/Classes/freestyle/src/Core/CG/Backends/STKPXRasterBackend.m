@@ -0,0 +1,726 @@
+/****************************************************************************
+ *
+ * Copyright 2015-present StylingKit Development Team. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ****************************************************************************/
+
+//
+//  STKPXRasterBackend.m
+//  StylingKit
+//
+
+#import "STKPXRasterBackend.h"
+#import "STKPXSolidPaint.h"
+#import "STKPXLinearGradient.h"
+#import "STKPXRadialGradient.h"
+#import "STKPXPaintGroup.h"
+#import "STKPXShadow.h"
+#import "STKPXShadowGroup.h"
+#import "STKPXStroke.h"
+#import "STKPXNonScalingStroke.h"
+#import "STKPXStrokeGroup.h"
+#import "STKPXStrokeStroke.h"
+
+static const double STKPXRasterStrokeTolerance = 0.1;
+
+static inline STKPXRasterTransform STKPXRasterTransformFromCGAffineTransform(CGAffineTransform transform)
+{
+    return (STKPXRasterTransform) { transform.a, transform.b, transform.c, transform.d, transform.tx, transform.ty };
+}
+
+static void STKPXRasterPathAddCGPathElement(void *info, const CGPathElement *element)
+{
+    STKPXRasterPath *path = info;
+    const CGPoint *points = element->points;
+
+    switch (element->type)
+    {
+        case kCGPathElementMoveToPoint:
+            STKPXRasterPathMoveTo(path, points[0].x, points[0].y);
+            break;
+
+        case kCGPathElementAddLineToPoint:
+            STKPXRasterPathLineTo(path, points[0].x, points[0].y);
+            break;
+
+        case kCGPathElementAddQuadCurveToPoint:
+            STKPXRasterPathQuadTo(path, points[0].x, points[0].y, points[1].x, points[1].y);
+            break;
+
+        case kCGPathElementAddCurveToPoint:
+            STKPXRasterPathCubicTo(path, points[0].x, points[0].y, points[1].x, points[1].y, points[2].x, points[2].y);
+            break;
+
+        case kCGPathElementCloseSubpath:
+            STKPXRasterPathClose(path);
+            break;
+    }
+}
+
+static void STKPXCGPathAddRasterPathElement(void *info, STKPXRasterPathElementType type, const double *points)
+{
+    CGMutablePathRef path = info;
+
+    switch (type)
+    {
+        case STKPXRasterPathElementMoveTo:
+            CGPathMoveToPoint(path, NULL, points[0], points[1]);
+            break;
+
+        case STKPXRasterPathElementLineTo:
+            CGPathAddLineToPoint(path, NULL, points[0], points[1]);
+            break;
+
+        case STKPXRasterPathElementQuadTo:
+            CGPathAddQuadCurveToPoint(path, NULL, points[0], points[1], points[2], points[3]);
+            break;
+
+        case STKPXRasterPathElementCubicTo:
+            CGPathAddCurveToPoint(path, NULL, points[0], points[1], points[2], points[3], points[4], points[5]);
+            break;
+
+        case STKPXRasterPathElementClose:
+            CGPathCloseSubpath(path);
+            break;
+    }
+}
+
+static STKPXRasterPath *STKPXRasterPathCreateWithCGPath(CGPathRef path)
+{
+    STKPXRasterPath *result = STKPXRasterPathCreate();
+
+    if (result && path)
+    {
+        CGPathApply(path, result, STKPXRasterPathAddCGPathElement);
+    }
+
+    return result;
+}
+
+static CGPathRef STKPXCGPathCreateWithRasterPath(const STKPXRasterPath *path) CF_RETURNS_RETAINED;
+static CGPathRef STKPXCGPathCreateWithRasterPath(const STKPXRasterPath *path)
+{
+    CGMutablePathRef result = CGPathCreateMutable();
+
+    STKPXRasterPathApply(path, result, STKPXCGPathAddRasterPathElement);
+
+    return result;
+}
+
+static void STKPXRasterColorFromUIColor(UIColor *color, double *r, double *g, double *b, double *a)
+{
+    CGFloat red = 0.0f, green = 0.0f, blue = 0.0f, alpha = 0.0f;
+
+    if (![color getRed:&red green:&green blue:&blue alpha:&alpha])
+    {
+        CGFloat white = 0.0f;
+
+        if ([color getWhite:&white alpha:&alpha])
+        {
+            red = green = blue = white;
+        }
+    }
+
+    *r = red;
+    *g = green;
+    *b = blue;
+    *a = alpha;
+}
+
+#pragma mark - STKPXRasterState
+
+/**
+ *  A graphics state of the raster backend
+ */
+@interface STKPXRasterState : NSObject <NSCopying>
+
+@property (nonatomic) CGAffineTransform transform;
+@property (nonatomic, strong) NSData *clip;
+@property (nonatomic, strong) UIColor *fillColor;
+@property (nonatomic, strong) STKPXShadow *shadow;
+
+@end
+
+@implementation STKPXRasterState
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    STKPXRasterState *result = [[STKPXRasterState alloc] init];
+
+    // clip masks are never modified once created, so they can be shared
+    result.transform = _transform;
+    result.clip = _clip;
+    result.fillColor = _fillColor;
+    result.shadow = _shadow;
+
+    return result;
+}
+
+@end
+
+#pragma mark - STKPXRasterLayer
+
+/**
+ *  A transparency layer of the raster backend
+ */
+@interface STKPXRasterLayer : NSObject
+{
+@public
+    STKPXRasterSurface surface_;
+    CGFloat opacity_;
+}
+@end
+
+@implementation STKPXRasterLayer
+
+- (void)dealloc
+{
+    STKPXRasterSurfaceDestroy(&surface_);
+}
+
+@end
+
+#pragma mark - STKPXRasterBackend
+
+@implementation STKPXRasterBackend
+{
+    STKPXRasterSurface surface_;
+    STKPXRasterState *state_;
+    NSMutableArray *states_;
+    NSMutableArray *layers_;
+}
+
+#pragma mark - Initializers
+
+- (instancetype)initWithSize:(CGSize)size scale:(CGFloat)scale
+{
+    if (self = [super init])
+    {
+        _size = size;
+        _scale = (scale > 0.0f) ? scale : [UIScreen mainScreen].scale;
+
+        STKPXRasterSurfaceInit(&surface_, (int) ceil(size.width * _scale), (int) ceil(size.height * _scale));
+
+        state_ = [[STKPXRasterState alloc] init];
+        state_.transform = CGAffineTransformMakeScale(_scale, _scale);
+        state_.fillColor = [UIColor blackColor];
+        states_ = [NSMutableArray array];
+        layers_ = [NSMutableArray array];
+    }
+
+    return self;
+}
+
+#pragma mark - Getters
+
+- (const STKPXRasterSurface *)surface
+{
+    return &surface_;
+}
+
+- (UIImage *)image
+{
+    if (surface_.pixels == NULL)
+    {
+        return nil;
+    }
+
+    NSData *data = [NSData dataWithBytes:surface_.pixels length:surface_.bytesPerRow * surface_.height];
+    CGDataProviderRef provider = CGDataProviderCreateWithCFData((__bridge CFDataRef) data);
+    CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+    CGImageRef imageRef = CGImageCreate(surface_.width,
+                                        surface_.height,
+                                        8,
+                                        32,
+                                        surface_.bytesPerRow,
+                                        colorSpace,
+                                        kCGBitmapByteOrder32Big | kCGImageAlphaPremultipliedLast,
+                                        provider,
+                                        NULL,
+                                        false,
+                                        kCGRenderingIntentDefault);
+    UIImage *result = [UIImage imageWithCGImage:imageRef scale:_scale orientation:UIImageOrientationUp];
+
+    CGImageRelease(imageRef);
+    CGColorSpaceRelease(colorSpace);
+    CGDataProviderRelease(provider);
+
+    return result;
+}
+
+#pragma mark - Methods
+
+- (STKPXRasterComparison)compareWithImage:(UIImage *)image threshold:(int)threshold
+{
+    STKPXRasterComparison result = { 255, 1.0 };
+    CGImageRef imageRef = image.CGImage;
+
+    if (imageRef == NULL
+        || CGImageGetWidth(imageRef) != surface_.width
+        || CGImageGetHeight(imageRef) != surface_.height)
+    {
+        return result;
+    }
+
+    NSMutableData *pixels = [NSMutableData dataWithLength:surface_.bytesPerRow * surface_.height];
+    CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+    CGContextRef context = CGBitmapContextCreate(pixels.mutableBytes,
+                                                 surface_.width,
+                                                 surface_.height,
+                                                 8,
+                                                 surface_.bytesPerRow,
+                                                 colorSpace,
+                                                 kCGBitmapByteOrder32Big | kCGImageAlphaPremultipliedLast);
+
+    if (context)
+    {
+        CGContextDrawImage(context, CGRectMake(0, 0, surface_.width, surface_.height), imageRef);
+        CGContextRelease(context);
+
+        result = STKPXRasterCompare(surface_.pixels,
+                                    surface_.bytesPerRow,
+                                    pixels.bytes,
+                                    surface_.bytesPerRow,
+                                    surface_.width,
+                                    surface_.height,
+                                    threshold);
+    }
+
+    CGColorSpaceRelease(colorSpace);
+
+    return result;
+}
+
+#pragma mark - STKPXRenderBackend implementation
+
+- (void)saveState
+{
+    [states_ addObject:state_];
+    state_ = [state_ copy];
+}
+
+- (void)restoreState
+{
+    if (states_.count)
+    {
+        state_ = states_.lastObject;
+        [states_ removeLastObject];
+    }
+}
+
+- (void)concatTransform:(CGAffineTransform)transform
+{
+    state_.transform = CGAffineTransformConcat(transform, state_.transform);
+}
+
+- (void)clipToPath:(CGPathRef)path
+{
+    STKPXRasterPath *rasterPath = STKPXRasterPathCreateWithCGPath(path);
+
+    state_.clip = [self newMaskForRasterPath:rasterPath
+                                   transform:state_.transform
+                                    fillRule:STKPXRasterFillRuleNonZero];
+
+    STKPXRasterPathRelease(rasterPath);
+}
+
+- (void)beginTransparencyLayerWithOpacity:(CGFloat)opacity
+{
+    STKPXRasterLayer *layer = [[STKPXRasterLayer alloc] init];
+
+    STKPXRasterSurfaceInit(&layer->surface_, surface_.width, surface_.height);
+    layer->opacity_ = opacity;
+
+    // layers start without a shadow and are composited as a whole
+    [self saveState];
+    state_.shadow = nil;
+
+    [layers_ addObject:layer];
+}
+
+- (void)endTransparencyLayer
+{
+    STKPXRasterLayer *layer = layers_.lastObject;
+
+    if (layer)
+    {
+        [layers_ removeLastObject];
+        [self restoreState];
+
+        STKPXRasterCompositeSurface([self currentSurface], &layer->surface_, layer->opacity_);
+    }
+}
+
+- (void)fillPath:(CGPathRef)path withPaint:(id<STKPXPaint>)paint
+{
+    if (path && paint)
+    {
+        STKPXRasterPath *rasterPath = STKPXRasterPathCreateWithCGPath(path);
+
+        [self fillRasterPath:rasterPath path:path withPaint:paint];
+
+        STKPXRasterPathRelease(rasterPath);
+    }
+}
+
+- (void)strokePath:(CGPathRef)path withStroke:(id<STKPXStrokeRenderer>)stroke
+{
+    if (path == NULL || stroke == nil)
+    {
+        return;
+    }
+
+    if ([stroke isKindOfClass:[STKPXStrokeGroup class]])
+    {
+        for (id<STKPXStrokeRenderer> member in ((STKPXStrokeGroup *) stroke).strokes)
+        {
+            [self strokePath:path withStroke:member];
+        }
+    }
+    else if ([stroke isKindOfClass:[STKPXStrokeStroke class]])
+    {
+        STKPXStrokeStroke *strokeStroke = (STKPXStrokeStroke *) stroke;
+        STKPXStroke *effect = strokeStroke.strokeEffect;
+        STKPXRasterPath *outline = [self newOutlineOfPath:path withStroke:effect width:effect.width];
+        CGPathRef outlinePath = STKPXCGPathCreateWithRasterPath(outline);
+
+        [self strokePath:outlinePath withStroke:strokeStroke.strokeToApply];
+
+        CGPathRelease(outlinePath);
+        STKPXRasterPathRelease(outline);
+    }
+    else if ([stroke isKindOfClass:[STKPXStroke class]])
+    {
+        STKPXStroke *simpleStroke = (STKPXStroke *) stroke;
+        CGFloat width = simpleStroke.width;
+
+        if (simpleStroke.color == nil || width <= 0.0f)
+        {
+            return;
+        }
+
+        if ([stroke isKindOfClass:[STKPXNonScalingStroke class]])
+        {
+            // keep the width constant in device space, using the largest scale like STKPXNonScalingStroke
+            CGAffineTransform transform = state_.transform;
+            CGFloat sx = sqrt(transform.a * transform.a + transform.c * transform.c);
+            CGFloat sy = sqrt(transform.b * transform.b + transform.d * transform.d);
+
+            width /= MAX(sx, sy);
+        }
+
+        STKPXRasterPath *outline = [self newOutlineOfPath:path withStroke:simpleStroke width:width];
+        CGPathRef outlinePath = STKPXCGPathCreateWithRasterPath(outline);
+
+        if (simpleStroke.type == kStrokeTypeInner)
+        {
+            [self saveState];
+            [self clipToPath:path];
+        }
+
+        [self fillRasterPath:outline path:outlinePath withPaint:simpleStroke.color];
+
+        if (simpleStroke.type == kStrokeTypeInner)
+        {
+            [self restoreState];
+        }
+
+        CGPathRelease(outlinePath);
+        STKPXRasterPathRelease(outline);
+    }
+}
+
+- (void)applyOutsetOfShadow:(id<STKPXShadowPaint>)shadow toPath:(CGPathRef)path
+{
+    if ([shadow isKindOfClass:[STKPXShadowGroup class]])
+    {
+        for (id<STKPXShadowPaint> member in ((STKPXShadowGroup *) shadow).shadows)
+        {
+            [self applyOutsetOfShadow:member toPath:path];
+        }
+    }
+    else if ([shadow isKindOfClass:[STKPXShadow class]] && !((STKPXShadow *) shadow).inset && path)
+    {
+        // like CGContextSetShadow, the shadow stays active for everything drawn until the state is restored
+        state_.shadow = (STKPXShadow *) shadow;
+
+        STKPXRasterPath *rasterPath = STKPXRasterPathCreateWithCGPath(path);
+        STKPXRasterPaint paint = { STKPXRasterPaintTypeSolid };
+
+        STKPXRasterColorFromUIColor(state_.fillColor, &paint.r, &paint.g, &paint.b, &paint.a);
+        [self drawRasterPath:rasterPath paint:&paint];
+
+        STKPXRasterPathRelease(rasterPath);
+    }
+}
+
+- (void)applyInsetOfShadow:(id<STKPXShadowPaint>)shadow toPath:(CGPathRef)path
+{
+    if ([shadow isKindOfClass:[STKPXShadowGroup class]])
+    {
+        for (id<STKPXShadowPaint> member in ((STKPXShadowGroup *) shadow).shadows)
+        {
+            [self applyInsetOfShadow:member toPath:path];
+        }
+    }
+    else if ([shadow isKindOfClass:[STKPXShadow class]] && ((STKPXShadow *) shadow).inset && path)
+    {
+        STKPXRasterPath *rasterPath = STKPXRasterPathCreateWithCGPath(path);
+        NSData *clip = [self newMaskForRasterPath:rasterPath
+                                        transform:state_.transform
+                                         fillRule:STKPXRasterFillRuleNonZero];
+
+        // the shadow of everything outside the path, visible only inside of it
+        [self drawShadow:(STKPXShadow *) shadow ofRasterPath:rasterPath inverted:YES clip:clip opacity:1.0];
+
+        STKPXRasterPathRelease(rasterPath);
+    }
+}
+
+#pragma mark - Private Methods
+
+- (STKPXRasterSurface *)currentSurface
+{
+    STKPXRasterLayer *layer = layers_.lastObject;
+
+    return (layer) ? &layer->surface_ : &surface_;
+}
+
+/**
+ *  Render the coverage of a path in device space, intersected with the current clip
+ */
+- (NSData *)newMaskForRasterPath:(STKPXRasterPath *)path
+                       transform:(CGAffineTransform)transform
+                        fillRule:(STKPXRasterFillRule)fillRule
+{
+    NSUInteger length = (NSUInteger) surface_.width * surface_.height;
+    NSMutableData *result = [[NSMutableData alloc] initWithLength:length];
+    uint8_t *mask = result.mutableBytes;
+
+    STKPXRasterRenderMask(mask,
+                          surface_.width,
+                          surface_.height,
+                          path,
+                          STKPXRasterTransformFromCGAffineTransform(transform),
+                          fillRule);
+
+    if (state_.clip)
+    {
+        const uint8_t *clip = state_.clip.bytes;
+
+        for (NSUInteger i = 0; i < length; i++)
+        {
+            mask[i] = (uint8_t) ((mask[i] * clip[i] + 127) / 255);
+        }
+    }
+
+    return result;
+}
+
+- (STKPXRasterPath *)newOutlineOfPath:(CGPathRef)path withStroke:(STKPXStroke *)stroke width:(CGFloat)width
+{
+    STKPXRasterPath *rasterPath = STKPXRasterPathCreateWithCGPath(path);
+    NSUInteger dashCount = stroke.dashArray.count;
+    double dashes[MAX(dashCount, 1)];
+
+    for (NSUInteger i = 0; i < dashCount; i++)
+    {
+        dashes[i] = [stroke.dashArray[i] doubleValue];
+    }
+
+    STKPXRasterStrokeStyle style = {
+        .width = width,
+        .cap = (stroke.lineCap == kCGLineCapRound) ? STKPXRasterLineCapRound
+                : (stroke.lineCap == kCGLineCapSquare) ? STKPXRasterLineCapSquare : STKPXRasterLineCapButt,
+        .join = (stroke.lineJoin == kCGLineJoinRound) ? STKPXRasterLineJoinRound
+                : (stroke.lineJoin == kCGLineJoinBevel) ? STKPXRasterLineJoinBevel : STKPXRasterLineJoinMiter,
+        .miterLimit = stroke.miterLimit,
+        .dashes = dashes,
+        .dashCount = dashCount,
+        .dashOffset = stroke.dashOffset
+    };
+
+    // flatten finely enough for the current scale, since outlines are built in user space
+    CGAffineTransform transform = state_.transform;
+    double scale = sqrt(fabs(transform.a * transform.d - transform.b * transform.c));
+    STKPXRasterPath *result = STKPXRasterPathCreateStroked(rasterPath,
+                                                           &style,
+                                                           STKPXRasterStrokeTolerance / MAX(scale, 1e-3));
+
+    STKPXRasterPathRelease(rasterPath);
+
+    return result;
+}
+
+- (void)fillRasterPath:(STKPXRasterPath *)rasterPath path:(CGPathRef)path withPaint:(id<STKPXPaint>)paint
+{
+    if ([paint isKindOfClass:[STKPXPaintGroup class]])
+    {
+        for (id<STKPXPaint> member in ((STKPXPaintGroup *) paint).paints)
+        {
+            [self fillRasterPath:rasterPath path:path withPaint:member];
+        }
+    }
+    else if ([paint isKindOfClass:[STKPXSolidPaint class]])
+    {
+        UIColor *color = ((STKPXSolidPaint *) paint).color ?: [UIColor clearColor];
+        STKPXRasterPaint rasterPaint = { STKPXRasterPaintTypeSolid };
+
+        // solid paints leave their color behind for outer shadows, like CGContextSetFillColorWithColor
+        state_.fillColor = color;
+
+        STKPXRasterColorFromUIColor(color, &rasterPaint.r, &rasterPaint.g, &rasterPaint.b, &rasterPaint.a);
+        [self drawRasterPath:rasterPath paint:&rasterPaint];
+    }
+    else if ([paint isKindOfClass:[STKPXGradient class]])
+    {
+        STKPXGradient *gradient = (STKPXGradient *) paint;
+
+        if (gradient.gradient == NULL || gradient.colors.count == 0)
+        {
+            return;
+        }
+
+        // like the CGGradient, colors without a matching list of offsets are evenly distributed from 0 to 1
+        NSUInteger stopCount = gradient.colors.count;
+        BOOL distribute = (stopCount != gradient.offsets.count);
+        STKPXRasterColorStop stops[MAX(stopCount, 1)];
+        STKPXRasterPaint rasterPaint = { STKPXRasterPaintTypeLinearGradient };
+
+        for (NSUInteger i = 0; i < stopCount; i++)
+        {
+            STKPXRasterColorStop *stop = &stops[i];
+
+            stop->offset = (distribute) ? (double) i / MAX(stopCount - 1, 1) : [gradient.offsets[i] doubleValue];
+            STKPXRasterColorFromUIColor(gradient.colors[i], &stop->r, &stop->g, &stop->b, &stop->a);
+        }
+
+        rasterPaint.stops = stops;
+        rasterPaint.stopCount = stopCount;
+        rasterPaint.transform =
+            STKPXRasterTransformFromCGAffineTransform(CGAffineTransformConcat(gradient.transform, state_.transform));
+
+        if ([gradient isKindOfClass:[STKPXLinearGradient class]])
+        {
+            CGPoint start, end;
+
+            [(STKPXLinearGradient *) gradient getStartPoint:&start endPoint:&end forPath:path];
+
+            rasterPaint.x0 = start.x;
+            rasterPaint.y0 = start.y;
+            rasterPaint.x1 = end.x;
+            rasterPaint.y1 = end.y;
+        }
+        else if ([gradient isKindOfClass:[STKPXRadialGradient class]])
+        {
+            CGPoint start, end;
+            CGFloat radius;
+
+            [(STKPXRadialGradient *) gradient getStartCenter:&start endCenter:&end radius:&radius forPath:path];
+
+            rasterPaint.type = STKPXRasterPaintTypeRadialGradient;
+            rasterPaint.x0 = start.x;
+            rasterPaint.y0 = start.y;
+            rasterPaint.x1 = end.x;
+            rasterPaint.y1 = end.y;
+            rasterPaint.r1 = radius;
+        }
+        else
+        {
+            return;
+        }
+
+        [self drawRasterPath:rasterPath paint:&rasterPaint];
+    }
+}
+
+/**
+ *  Fill a path with the non-zero rule, casting the active shadow first
+ */
+- (void)drawRasterPath:(STKPXRasterPath *)rasterPath paint:(const STKPXRasterPaint *)paint
+{
+    if (state_.shadow)
+    {
+        double opacity = (paint->type == STKPXRasterPaintTypeSolid) ? paint->a : 1.0;
+
+        [self drawShadow:state_.shadow ofRasterPath:rasterPath inverted:NO clip:state_.clip opacity:opacity];
+    }
+
+    STKPXRasterFillPath([self currentSurface],
+                        rasterPath,
+                        STKPXRasterTransformFromCGAffineTransform(state_.transform),
+                        STKPXRasterFillRuleNonZero,
+                        paint,
+                        state_.clip.bytes,
+                        1.0);
+}
+
+/**
+ *  Render a blurred, offset copy of a path's coverage. Shadow offsets and blur are in points and, as with
+ *  CGContextSetShadow, are not affected by the current transform
+ */
+- (void)drawShadow:(STKPXShadow *)shadow
+      ofRasterPath:(STKPXRasterPath *)rasterPath
+          inverted:(BOOL)inverted
+              clip:(NSData *)clip
+           opacity:(double)opacity
+{
+    double sigma = MAX(0.0, shadow.blurDistance) * _scale * 0.5;
+    int padding = (int) ceil(sigma * 3.0) + 2;
+    int width = surface_.width + padding * 2;
+    int height = surface_.height + padding * 2;
+    NSMutableData *maskData = [NSMutableData dataWithLength:(NSUInteger) width * height];
+    uint8_t *mask = maskData.mutableBytes;
+    CGAffineTransform offset = CGAffineTransformMakeTranslation(shadow.horizontalOffset * _scale + padding,
+                                                                shadow.verticalOffset * _scale + padding);
+
+    if (mask == NULL)
+    {
+        return;
+    }
+
+    STKPXRasterRenderMask(mask,
+                          width,
+                          height,
+                          rasterPath,
+                          STKPXRasterTransformFromCGAffineTransform(CGAffineTransformConcat(state_.transform, offset)),
+                          STKPXRasterFillRuleNonZero);
+
+    if (inverted)
+    {
+        for (NSUInteger i = 0; i < maskData.length; i++)
+        {
+            mask[i] = 255 - mask[i];
+        }
+    }
+
+    STKPXRasterBlurMask(mask, width, height, sigma);
+
+    // without a color, CGContextSetShadow uses black at one-third alpha
+    UIColor *color = shadow.color ?: [UIColor colorWithWhite:0.0f alpha:1.0f / 3.0f];
+    STKPXRasterPaint paint = { STKPXRasterPaintTypeSolid };
+
+    STKPXRasterColorFromUIColor(color, &paint.r, &paint.g, &paint.b, &paint.a);
+    STKPXRasterFillMask([self currentSurface], mask, width, height, -padding, -padding, &paint, clip.bytes, opacity);
+}
+
+#pragma mark - Overrides
+
+- (void)dealloc
+{
+    STKPXRasterSurfaceDestroy(&surface_);
+}
+
+@end
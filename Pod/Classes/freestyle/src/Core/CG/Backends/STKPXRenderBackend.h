@@ -0,0 +1,104 @@
+/****************************************************************************
+ *
+ * Copyright 2015-present StylingKit Development Team. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ****************************************************************************/
+
+//
+//  STKPXRenderBackend.h
+//  StylingKit
+//
+
+#import <Foundation/Foundation.h>
+#import <UIKit/UIKit.h>
+#import "STKPXPaint.h"
+#import "STKPXShadowPaint.h"
+#import "STKPXStrokeRenderer.h"
+
+/**
+ *  The STKPXRenderBackend protocol declares the drawing operations STKPXRenderables are rendered with. Backends keep a
+ *  stack of graphics states, in the manner of a CGContext, holding the current transform and clipping region.
+ */
+@protocol STKPXRenderBackend <NSObject>
+
+/**
+ *  Push a copy of the current graphics state
+ */
+- (void)saveState;
+
+/**
+ *  Pop the graphics state pushed by the matching saveState
+ */
+- (void)restoreState;
+
+/**
+ *  Apply the specified transform before the current transform
+ *
+ *  @param transform The transform to concatenate
+ */
+- (void)concatTransform:(CGAffineTransform)transform;
+
+/**
+ *  Intersect the current clipping region with the interior of the specified path
+ *
+ *  @param path The path to clip to
+ */
+- (void)clipToPath:(CGPathRef)path;
+
+/**
+ *  Direct drawing to an offscreen layer until the matching endTransparencyLayer
+ *
+ *  @param opacity The opacity the layer is composited with
+ */
+- (void)beginTransparencyLayerWithOpacity:(CGFloat)opacity;
+
+/**
+ *  Composite the current transparency layer
+ */
+- (void)endTransparencyLayer;
+
+/**
+ *  Fill the specified path
+ *
+ *  @param path The path to fill
+ *  @param paint The paint to fill the path with
+ */
+- (void)fillPath:(CGPathRef)path withPaint:(id<STKPXPaint>)paint;
+
+/**
+ *  Stroke the specified path
+ *
+ *  @param path The path to stroke
+ *  @param stroke The stroke to apply to the path
+ */
+- (void)strokePath:(CGPathRef)path withStroke:(id<STKPXStrokeRenderer>)stroke;
+
+/**
+ *  Render the outer shadows of the specified shadow paint
+ *
+ *  @param shadow The shadow paint
+ *  @param path The path casting the shadow
+ */
+- (void)applyOutsetOfShadow:(id<STKPXShadowPaint>)shadow toPath:(CGPathRef)path;
+
+/**
+ *  Render the inner shadows of the specified shadow paint
+ *
+ *  @param shadow The shadow paint
+ *  @param path The path casting the shadow
+ */
+- (void)applyInsetOfShadow:(id<STKPXShadowPaint>)shadow toPath:(CGPathRef)path;
+
+@end
@@ -32,7 +32,8 @@
 @interface UIColor (STKPXColors)
 
 /**
- *  Return a UIColor from an SVG color name
+ *  Return a UIColor from an SVG color name, ignoring case. Other names resolve to UIColor class methods, so
+ *  "light-gray" returns +lightGrayColor. Unknown names return black
  *
  *  @param name The color name
  */
@@ -58,14 +59,15 @@
 + (UIColor *)colorWithHue:(CGFloat)hue saturation:(CGFloat)saturation lightness:(CGFloat)lightness alpha:(CGFloat)alpha;
 
 /**
- *  Return a UIColor from a 3- or 6-digit hex string
+ *  Return a UIColor from a 3-, 4-, 6- or 8-digit hex string. The 4- and 8-digit forms lead with alpha
  *
  *  @param hexString The hex color string value
  */
 + (UIColor *)colorWithHexString:(NSString *)hexString;
 
 /**
- *  Return a UIColor from a 3- or 6-digit hex string and an alpha value
+ *  Return a UIColor from a 3-, 4-, 6- or 8-digit hex string and an alpha value. The alpha value is ignored by the
+ *  4- and 8-digit forms, which carry their own
  *
  *  @param hexString The hex color string value
  *  @param alpha The color's alpha value
@@ -27,230 +27,442 @@
 
 void STKPXForceLoadUIColorPXColor() {}
 
-@implementation UIColor (STKPXColors)
+#define NAME_MAX_LENGTH 20
+#define NAME_BUCKET_COUNT 64
+#define NAME_SLOT_COUNT 256
+#define NAME_HASH_SEED 1U
 
-#pragma mark - Static Methods
+typedef struct
+{
+    const char *name;
+    uint32_t argb;
+} STKPXNamedColor;
+
+// the CSS named colors as ARGB values, sorted by name. transparent maps to +[UIColor clearColor]
+static const STKPXNamedColor NAMED_COLORS[] = {
+    { "aliceblue", 0xFFF0F8FF },
+    { "antiquewhite", 0xFFFAEBD7 },
+    { "aqua", 0xFF00FFFF },
+    { "aquamarine", 0xFF7FFFD4 },
+    { "azure", 0xFFF0FFFF },
+    { "beige", 0xFFF5F5DC },
+    { "bisque", 0xFFFFE4C4 },
+    { "black", 0xFF000000 },
+    { "blanchedalmond", 0xFFFFEBCD },
+    { "blue", 0xFF0000FF },
+    { "blueviolet", 0xFF8A2BE2 },
+    { "brown", 0xFFA52A2A },
+    { "burlywood", 0xFFDEB887 },
+    { "cadetblue", 0xFF5F9EA0 },
+    { "chartreuse", 0xFF7FFF00 },
+    { "chocolate", 0xFFD2691E },
+    { "coral", 0xFFFF7F50 },
+    { "cornflowerblue", 0xFF6495ED },
+    { "cornsilk", 0xFFFFF8DC },
+    { "crimson", 0xFFDC143C },
+    { "cyan", 0xFF00FFFF },
+    { "darkblue", 0xFF00008B },
+    { "darkcyan", 0xFF008B8B },
+    { "darkgoldenrod", 0xFFB8860B },
+    { "darkgray", 0xFFA9A9A9 },
+    { "darkgreen", 0xFF006400 },
+    { "darkgrey", 0xFFA9A9A9 },
+    { "darkkhaki", 0xFFBDB76B },
+    { "darkmagenta", 0xFF8B008B },
+    { "darkolivegreen", 0xFF556B2F },
+    { "darkorange", 0xFFFF8C00 },
+    { "darkorchid", 0xFF9932CC },
+    { "darkred", 0xFF8B0000 },
+    { "darksalmon", 0xFFE9967A },
+    { "darkseagreen", 0xFF8FBC8F },
+    { "darkslateblue", 0xFF483D8B },
+    { "darkslategray", 0xFF2F4F4F },
+    { "darkslategrey", 0xFF2F4F4F },
+    { "darkturquoise", 0xFF00CED1 },
+    { "darkviolet", 0xFF9400D3 },
+    { "deeppink", 0xFFFF1493 },
+    { "deepskyblue", 0xFF00BFFF },
+    { "dimgray", 0xFF696969 },
+    { "dimgrey", 0xFF696969 },
+    { "dodgerblue", 0xFF1E90FF },
+    { "firebrick", 0xFFB22222 },
+    { "floralwhite", 0xFFFFFAF0 },
+    { "forestgreen", 0xFF228B22 },
+    { "fuchsia", 0xFFFF00FF },
+    { "gainsboro", 0xFFDCDCDC },
+    { "ghostwhite", 0xFFF8F8FF },
+    { "gold", 0xFFFFD700 },
+    { "goldenrod", 0xFFDAA520 },
+    { "gray", 0xFF808080 },
+    { "green", 0xFF008000 },
+    { "greenyellow", 0xFFADFF2F },
+    { "grey", 0xFF808080 },
+    { "honeydew", 0xFFF0FFF0 },
+    { "hotpink", 0xFFFF69B4 },
+    { "indianred", 0xFFCD5C5C },
+    { "indigo", 0xFF4B0082 },
+    { "ivory", 0xFFFFFFF0 },
+    { "khaki", 0xFFF0E68C },
+    { "lavender", 0xFFE6E6FA },
+    { "lavenderblush", 0xFFFFF0F5 },
+    { "lawngreen", 0xFF7CFC00 },
+    { "lemonchiffon", 0xFFFFFACD },
+    { "lightblue", 0xFFADD8E6 },
+    { "lightcoral", 0xFFF08080 },
+    { "lightcyan", 0xFFE0FFFF },
+    { "lightgoldenrodyellow", 0xFFFAFAD2 },
+    { "lightgray", 0xFFD3D3D3 },
+    { "lightgreen", 0xFF90EE90 },
+    { "lightgrey", 0xFFD3D3D3 },
+    { "lightpink", 0xFFFFB6C1 },
+    { "lightsalmon", 0xFFFFA07A },
+    { "lightseagreen", 0xFF20B2AA },
+    { "lightskyblue", 0xFF87CEFA },
+    { "lightslategray", 0xFF778899 },
+    { "lightslategrey", 0xFF778899 },
+    { "lightsteelblue", 0xFFB0C4DE },
+    { "lightyellow", 0xFFFFFFE0 },
+    { "lime", 0xFF00FF00 },
+    { "limegreen", 0xFF32CD32 },
+    { "linen", 0xFFFAF0E6 },
+    { "magenta", 0xFFFF00FF },
+    { "maroon", 0xFF800000 },
+    { "mediumaquamarine", 0xFF66CDAA },
+    { "mediumblue", 0xFF0000CD },
+    { "mediumorchid", 0xFFBA55D3 },
+    { "mediumpurple", 0xFF9370DB },
+    { "mediumseagreen", 0xFF3CB371 },
+    { "mediumslateblue", 0xFF7B68EE },
+    { "mediumspringgreen", 0xFF00FA9A },
+    { "mediumturquoise", 0xFF48D1CC },
+    { "mediumvioletred", 0xFFC71585 },
+    { "midnightblue", 0xFF191970 },
+    { "mintcream", 0xFFF5FFFA },
+    { "mistyrose", 0xFFFFE4E1 },
+    { "moccasin", 0xFFFFE4B5 },
+    { "navajowhite", 0xFFFFDEAD },
+    { "navy", 0xFF000080 },
+    { "oldlace", 0xFFFDF5E6 },
+    { "olive", 0xFF808000 },
+    { "olivedrab", 0xFF6B8E23 },
+    { "orange", 0xFFFFA500 },
+    { "orangered", 0xFFFF4500 },
+    { "orchid", 0xFFDA70D6 },
+    { "palegoldenrod", 0xFFEEE8AA },
+    { "palegreen", 0xFF98FB98 },
+    { "paleturquoise", 0xFFAFEEEE },
+    { "palevioletred", 0xFFDB7093 },
+    { "papayawhip", 0xFFFFEFD5 },
+    { "peachpuff", 0xFFFFDAB9 },
+    { "peru", 0xFFCD853F },
+    { "pink", 0xFFFFC0CB },
+    { "plum", 0xFFDDA0DD },
+    { "powderblue", 0xFFB0E0E6 },
+    { "purple", 0xFF800080 },
+    { "red", 0xFFFF0000 },
+    { "rosybrown", 0xFFBC8F8F },
+    { "royalblue", 0xFF4169E1 },
+    { "saddlebrown", 0xFF8B4513 },
+    { "salmon", 0xFFFA8072 },
+    { "sandybrown", 0xFFF4A460 },
+    { "seagreen", 0xFF2E8B57 },
+    { "seashell", 0xFFFFF5EE },
+    { "sienna", 0xFFA0522D },
+    { "silver", 0xFFC0C0C0 },
+    { "skyblue", 0xFF87CEEB },
+    { "slateblue", 0xFF6A5ACD },
+    { "slategray", 0xFF708090 },
+    { "slategrey", 0xFF708090 },
+    { "snow", 0xFFFFFAFA },
+    { "springgreen", 0xFF00FF7F },
+    { "steelblue", 0xFF4682B4 },
+    { "tan", 0xFFD2B48C },
+    { "teal", 0xFF008080 },
+    { "thistle", 0xFFD8BFD8 },
+    { "tomato", 0xFFFF6347 },
+    { "transparent", 0x00000000 },
+    { "turquoise", 0xFF40E0D0 },
+    { "violet", 0xFFEE82EE },
+    { "wheat", 0xFFF5DEB3 },
+    { "white", 0xFFFFFFFF },
+    { "whitesmoke", 0xFFF5F5F5 },
+    { "yellow", 0xFFFFFF00 },
+    { "yellowgreen", 0xFF9ACD32 },
+};
+
+// perfect hash of the names: a name's bucket supplies the displacement that moves it into its own slot. Slots hold
+// an index into NAMED_COLORS plus one, or zero when empty
+static const uint8_t NAME_DISPLACEMENTS[NAME_BUCKET_COUNT] = {
+      0,   3,   6,   2,   0,   0,   1,   2,   3,   3,   0,   0,   4,   2,   4,   0,
+      1,   0,   2,   0,   2,   0,   2,   2,   1,   2,   0,   1,   3,   2,   5,   2,
+      3,   0,   0,   4,   1,   1,   0,   0,   7,   2,   0,   0,   3,   5,   2,   0,
+      0,   1,   0,   5,  21,  10,   0,   0,   0,   5,   1,   0,  24,   0,   1,   1,
+};
+
+static const uint8_t NAME_SLOTS[NAME_SLOT_COUNT] = {
+      0,  81,  58,   0,   0,   0,   0,  47, 141,  65, 112,   0,  99,   0,   0, 135,
+      0, 148,   0,  34,  29,  83,  49,  96,  22,  17,   0,  24, 137, 139,  93,  14,
+     19, 138,  10,   0,   0,   0,  67,  84, 118,  53, 108,  35,  61,   0,   0,  98,
+    105,  87, 106,  64, 123,  68,   9,  78,   0,   0,   0,  79,  92,   0,   0, 103,
+      0,   0,   7,  36,  20,   0,   0,  86,  48,   2,   0,  73,   0,   0,   0,   0,
+     18, 130,  82, 121, 142,  43,   0,   0,  39,  31,  70,   0,   8,   0, 110,  60,
+      0,   0, 127,   0, 134,  38,  89,  42,  11,  13, 126,  63, 119,  51,  85,  16,
+     46,  40,   0,   0,   0,  69, 147,   0,   0,  66,   0, 115,   0,   0, 128,   0,
+     32, 116,   0,   3,   0,   0,   0,  97,   0,   0,   0,   0,   0, 124,   0,   0,
+      0,   0,   0,   0,   0,  77,  52,   0,   0,   0,  95,  30,  62,  12, 122,   0,
+      0,   0,  80,   0,   0,   0,   6,   0,   0, 100,  27,  90,  94, 132,  25,   0,
+     15,   0, 133,   0, 111,   1,  74,  91,  23,  75, 104,  72, 143,  41,   5,   0,
+     33,  28, 129,  56,   0,  59,  55,   0,  54,  26, 102,  88, 101, 140, 145, 146,
+     45,  57, 125, 131,   0,   0,   0,   0,   0,  44, 136,   0,   0, 109,   0,   0,
+     76,  50, 113,   0, 144,   0,   0,   0,   0,   0,   0,   0, 107, 120,  21, 117,
+      0,   0,   0, 114,   0,   0,  71,   0,   0,   0,   0,   4,   0,   0,   0,  37,
+};
+
+// hex digit values by character. 0x10 marks characters that are not hex digits
+static const uint8_t HEX_VALUES[256] = {
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+    0x10, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+    0x10, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+};
+
+/**
+ *  Return the index of a lowercase ASCII name in NAMED_COLORS, or -1
+ */
+static NSInteger STKPXNamedColorIndex(const char *name, NSUInteger length)
+{
+    // 32-bit FNV-1a
+    uint32_t hash = 2166136261U ^ NAME_HASH_SEED;
+
+    for (NSUInteger i = 0; i < length; i++)
+    {
+        hash ^= (uint8_t) name[i];
+        hash *= 16777619U;
+    }
+
+    uint8_t slot = NAME_SLOTS[((hash >> 8) + NAME_DISPLACEMENTS[hash % NAME_BUCKET_COUNT]) % NAME_SLOT_COUNT];
+
+    if (slot == 0)
+    {
+        return -1;
+    }
+
+    // every string hashes to some slot, so confirm it holds this name
+    const char *candidate = NAMED_COLORS[slot - 1].name;
 
-+(NSDictionary *)nameMap
+    return (strncmp(candidate, name, length) == 0 && candidate[length] == '\0') ? slot - 1 : -1;
+}
+
+/**
+ *  Look up a CSS named color, ignoring ASCII case. Returns nil for anything else
+ */
+static UIColor *STKPXNamedColorForString(NSString *string)
 {
-    static NSDictionary *nameMap;
+    static const NSUInteger count = sizeof(NAMED_COLORS) / sizeof(NAMED_COLORS[0]);
+    static __strong UIColor *colors[sizeof(NAMED_COLORS) / sizeof(NAMED_COLORS[0])];
     static dispatch_once_t onceToken;
-    
+
     dispatch_once(&onceToken, ^{
-        nameMap = @{@"aliceblue": [UIColor colorWithRed:240.0/255.0 green:248.0/255.0 blue:255.0/255.0 alpha:1],
-           @"antiquewhite": [UIColor colorWithRed:250.0/255.0 green:235.0/255.0 blue:215.0/255.0 alpha:1],
-           @"aqua": [UIColor colorWithRed:0.0/255.0 green:255.0/255.0 blue:255.0/255.0 alpha:1],
-           @"aquamarine": [UIColor colorWithRed:127.0/255.0 green:255.0/255.0 blue:212.0/255.0 alpha:1],
-           @"azure": [UIColor colorWithRed:240.0/255.0 green:255.0/255.0 blue:255.0/255.0 alpha:1],
-           @"beige": [UIColor colorWithRed:245.0/255.0 green:245.0/255.0 blue:220.0/255.0 alpha:1],
-           @"bisque": [UIColor colorWithRed:255.0/255.0 green:228.0/255.0 blue:196.0/255.0 alpha:1],
-           @"black": [UIColor colorWithRed:0.0/255.0 green:0.0/255.0 blue:0.0/255.0 alpha:1],
-           @"blanchedalmond": [UIColor colorWithRed:255.0/255.0 green:235.0/255.0 blue:205.0/255.0 alpha:1],
-           @"blue": [UIColor colorWithRed:0.0/255.0 green:0.0/255.0 blue:255.0/255.0 alpha:1],
-           @"blueviolet": [UIColor colorWithRed:138.0/255.0 green:43.0/255.0 blue:226.0/255.0 alpha:1],
-           @"brown": [UIColor colorWithRed:165.0/255.0 green:42.0/255.0 blue:42.0/255.0 alpha:1],
-           @"burlywood": [UIColor colorWithRed:222.0/255.0 green:184.0/255.0 blue:135.0/255.0 alpha:1],
-           @"cadetblue": [UIColor colorWithRed:95.0/255.0 green:158.0/255.0 blue:160.0/255.0 alpha:1],
-           @"chartreuse": [UIColor colorWithRed:127.0/255.0 green:255.0/255.0 blue:0.0/255.0 alpha:1],
-           @"chocolate": [UIColor colorWithRed:210.0/255.0 green:105.0/255.0 blue:30.0/255.0 alpha:1],
-           @"coral": [UIColor colorWithRed:255.0/255.0 green:127.0/255.0 blue:80.0/255.0 alpha:1],
-           @"cornflowerblue": [UIColor colorWithRed:100.0/255.0 green:149.0/255.0 blue:237.0/255.0 alpha:1],
-           @"cornsilk": [UIColor colorWithRed:255.0/255.0 green:248.0/255.0 blue:220.0/255.0 alpha:1],
-           @"crimson": [UIColor colorWithRed:220.0/255.0 green:20.0/255.0 blue:60.0/255.0 alpha:1],
-           @"cyan": [UIColor colorWithRed:0.0/255.0 green:255.0/255.0 blue:255.0/255.0 alpha:1],
-           @"darkblue": [UIColor colorWithRed:0.0/255.0 green:0.0/255.0 blue:139.0/255.0 alpha:1],
-           @"darkcyan": [UIColor colorWithRed:0.0/255.0 green:139.0/255.0 blue:139.0/255.0 alpha:1],
-           @"darkgoldenrod": [UIColor colorWithRed:184.0/255.0 green:134.0/255.0 blue:11.0/255.0 alpha:1],
-           @"darkgray": [UIColor colorWithRed:169.0/255.0 green:169.0/255.0 blue:169.0/255.0 alpha:1],
-           @"darkgreen": [UIColor colorWithRed:0.0/255.0 green:100.0/255.0 blue:0.0/255.0 alpha:1],
-           @"darkgrey": [UIColor colorWithRed:169.0/255.0 green:169.0/255.0 blue:169.0/255.0 alpha:1],
-           @"darkkhaki": [UIColor colorWithRed:189.0/255.0 green:183.0/255.0 blue:107.0/255.0 alpha:1],
-           @"darkmagenta": [UIColor colorWithRed:139.0/255.0 green:0.0/255.0 blue:139.0/255.0 alpha:1],
-           @"darkolivegreen": [UIColor colorWithRed:85.0/255.0 green:107.0/255.0 blue:47.0/255.0 alpha:1],
-           @"darkorange": [UIColor colorWithRed:255.0/255.0 green:140.0/255.0 blue:0.0/255.0 alpha:1],
-           @"darkorchid": [UIColor colorWithRed:153.0/255.0 green:50.0/255.0 blue:204.0/255.0 alpha:1],
-           @"darkred": [UIColor colorWithRed:139.0/255.0 green:0.0/255.0 blue:0.0/255.0 alpha:1],
-           @"darksalmon": [UIColor colorWithRed:233.0/255.0 green:150.0/255.0 blue:122.0/255.0 alpha:1],
-           @"darkseagreen": [UIColor colorWithRed:143.0/255.0 green:188.0/255.0 blue:143.0/255.0 alpha:1],
-           @"darkslateblue": [UIColor colorWithRed:72.0/255.0 green:61.0/255.0 blue:139.0/255.0 alpha:1],
-           @"darkslategray": [UIColor colorWithRed:47.0/255.0 green:79.0/255.0 blue:79.0/255.0 alpha:1],
-           @"darkslategrey": [UIColor colorWithRed:47.0/255.0 green:79.0/255.0 blue:79.0/255.0 alpha:1],
-           @"darkturquoise": [UIColor colorWithRed:0.0/255.0 green:206.0/255.0 blue:209.0/255.0 alpha:1],
-           @"darkviolet": [UIColor colorWithRed:148.0/255.0 green:0.0/255.0 blue:211.0/255.0 alpha:1],
-           @"deeppink": [UIColor colorWithRed:255.0/255.0 green:20.0/255.0 blue:147.0/255.0 alpha:1],
-           @"deepskyblue": [UIColor colorWithRed:0.0/255.0 green:191.0/255.0 blue:255.0/255.0 alpha:1],
-           @"dimgray": [UIColor colorWithRed:105.0/255.0 green:105.0/255.0 blue:105.0/255.0 alpha:1],
-           @"dimgrey": [UIColor colorWithRed:105.0/255.0 green:105.0/255.0 blue:105.0/255.0 alpha:1],
-           @"dodgerblue": [UIColor colorWithRed:30.0/255.0 green:144.0/255.0 blue:255.0/255.0 alpha:1],
-           @"firebrick": [UIColor colorWithRed:178.0/255.0 green:34.0/255.0 blue:34.0/255.0 alpha:1],
-           @"floralwhite": [UIColor colorWithRed:255.0/255.0 green:250.0/255.0 blue:240.0/255.0 alpha:1],
-           @"forestgreen": [UIColor colorWithRed:34.0/255.0 green:139.0/255.0 blue:34.0/255.0 alpha:1],
-           @"fuchsia": [UIColor colorWithRed:255.0/255.0 green:0.0/255.0 blue:255.0/255.0 alpha:1],
-           @"gainsboro": [UIColor colorWithRed:220.0/255.0 green:220.0/255.0 blue:220.0/255.0 alpha:1],
-           @"ghostwhite": [UIColor colorWithRed:248.0/255.0 green:248.0/255.0 blue:255.0/255.0 alpha:1],
-           @"gold": [UIColor colorWithRed:255.0/255.0 green:215.0/255.0 blue:0.0/255.0 alpha:1],
-           @"goldenrod": [UIColor colorWithRed:218.0/255.0 green:165.0/255.0 blue:32.0/255.0 alpha:1],
-           @"gray": [UIColor colorWithRed:128.0/255.0 green:128.0/255.0 blue:128.0/255.0 alpha:1],
-           @"green": [UIColor colorWithRed:0.0/255.0 green:128.0/255.0 blue:0.0/255.0 alpha:1],
-           @"greenyellow": [UIColor colorWithRed:173.0/255.0 green:255.0/255.0 blue:47.0/255.0 alpha:1],
-           @"grey": [UIColor colorWithRed:128.0/255.0 green:128.0/255.0 blue:128.0/255.0 alpha:1],
-           @"honeydew": [UIColor colorWithRed:240.0/255.0 green:255.0/255.0 blue:240.0/255.0 alpha:1],
-           @"hotpink": [UIColor colorWithRed:255.0/255.0 green:105.0/255.0 blue:180.0/255.0 alpha:1],
-           @"indianred": [UIColor colorWithRed:205.0/255.0 green:92.0/255.0 blue:92.0/255.0 alpha:1],
-           @"indigo": [UIColor colorWithRed:75.0/255.0 green:0.0/255.0 blue:130.0/255.0 alpha:1],
-           @"ivory": [UIColor colorWithRed:255.0/255.0 green:255.0/255.0 blue:240.0/255.0 alpha:1],
-           @"khaki": [UIColor colorWithRed:240.0/255.0 green:230.0/255.0 blue:140.0/255.0 alpha:1],
-           @"lavender": [UIColor colorWithRed:230.0/255.0 green:230.0/255.0 blue:250.0/255.0 alpha:1],
-           @"lavenderblush": [UIColor colorWithRed:255.0/255.0 green:240.0/255.0 blue:245.0/255.0 alpha:1],
-           @"lawngreen": [UIColor colorWithRed:124.0/255.0 green:252.0/255.0 blue:0.0/255.0 alpha:1],
-           @"lemonchiffon": [UIColor colorWithRed:255.0/255.0 green:250.0/255.0 blue:205.0/255.0 alpha:1],
-           @"lightblue": [UIColor colorWithRed:173.0/255.0 green:216.0/255.0 blue:230.0/255.0 alpha:1],
-           @"lightcoral": [UIColor colorWithRed:240.0/255.0 green:128.0/255.0 blue:128.0/255.0 alpha:1],
-           @"lightcyan": [UIColor colorWithRed:224.0/255.0 green:255.0/255.0 blue:255.0/255.0 alpha:1],
-           @"lightgoldenrodyellow": [UIColor colorWithRed:250.0/255.0 green:250.0/255.0 blue:210.0/255.0 alpha:1],
-           @"lightgray": [UIColor colorWithRed:211.0/255.0 green:211.0/255.0 blue:211.0/255.0 alpha:1],
-           @"lightgreen": [UIColor colorWithRed:144.0/255.0 green:238.0/255.0 blue:144.0/255.0 alpha:1],
-           @"lightgrey": [UIColor colorWithRed:211.0/255.0 green:211.0/255.0 blue:211.0/255.0 alpha:1],
-           @"lightpink": [UIColor colorWithRed:255.0/255.0 green:182.0/255.0 blue:193.0/255.0 alpha:1],
-           @"lightsalmon": [UIColor colorWithRed:255.0/255.0 green:160.0/255.0 blue:122.0/255.0 alpha:1],
-           @"lightseagreen": [UIColor colorWithRed:32.0/255.0 green:178.0/255.0 blue:170.0/255.0 alpha:1],
-           @"lightskyblue": [UIColor colorWithRed:135.0/255.0 green:206.0/255.0 blue:250.0/255.0 alpha:1],
-           @"lightslategray": [UIColor colorWithRed:119.0/255.0 green:136.0/255.0 blue:153.0/255.0 alpha:1],
-           @"lightslategrey": [UIColor colorWithRed:119.0/255.0 green:136.0/255.0 blue:153.0/255.0 alpha:1],
-           @"lightsteelblue": [UIColor colorWithRed:176.0/255.0 green:196.0/255.0 blue:222.0/255.0 alpha:1],
-           @"lightyellow": [UIColor colorWithRed:255.0/255.0 green:255.0/255.0 blue:224.0/255.0 alpha:1],
-           @"lime": [UIColor colorWithRed:0.0/255.0 green:255.0/255.0 blue:0.0/255.0 alpha:1],
-           @"limegreen": [UIColor colorWithRed:50.0/255.0 green:205.0/255.0 blue:50.0/255.0 alpha:1],
-           @"linen": [UIColor colorWithRed:250.0/255.0 green:240.0/255.0 blue:230.0/255.0 alpha:1],
-           @"magenta": [UIColor colorWithRed:255.0/255.0 green:0.0/255.0 blue:255.0/255.0 alpha:1],
-           @"maroon": [UIColor colorWithRed:128.0/255.0 green:0.0/255.0 blue:0.0/255.0 alpha:1],
-           @"mediumaquamarine": [UIColor colorWithRed:102.0/255.0 green:205.0/255.0 blue:170.0/255.0 alpha:1],
-           @"mediumblue": [UIColor colorWithRed:0.0/255.0 green:0.0/255.0 blue:205.0/255.0 alpha:1],
-           @"mediumorchid": [UIColor colorWithRed:186.0/255.0 green:85.0/255.0 blue:211.0/255.0 alpha:1],
-           @"mediumpurple": [UIColor colorWithRed:147.0/255.0 green:112.0/255.0 blue:219.0/255.0 alpha:1],
-           @"mediumseagreen": [UIColor colorWithRed:60.0/255.0 green:179.0/255.0 blue:113.0/255.0 alpha:1],
-           @"mediumslateblue": [UIColor colorWithRed:123.0/255.0 green:104.0/255.0 blue:238.0/255.0 alpha:1],
-           @"mediumspringgreen": [UIColor colorWithRed:0.0/255.0 green:250.0/255.0 blue:154.0/255.0 alpha:1],
-           @"mediumturquoise": [UIColor colorWithRed:72.0/255.0 green:209.0/255.0 blue:204.0/255.0 alpha:1],
-           @"mediumvioletred": [UIColor colorWithRed:199.0/255.0 green:21.0/255.0 blue:133.0/255.0 alpha:1],
-           @"midnightblue": [UIColor colorWithRed:25.0/255.0 green:25.0/255.0 blue:112.0/255.0 alpha:1],
-           @"mintcream": [UIColor colorWithRed:245.0/255.0 green:255.0/255.0 blue:250.0/255.0 alpha:1],
-           @"mistyrose": [UIColor colorWithRed:255.0/255.0 green:228.0/255.0 blue:225.0/255.0 alpha:1],
-           @"moccasin": [UIColor colorWithRed:255.0/255.0 green:228.0/255.0 blue:181.0/255.0 alpha:1],
-           @"navajowhite": [UIColor colorWithRed:255.0/255.0 green:222.0/255.0 blue:173.0/255.0 alpha:1],
-           @"navy": [UIColor colorWithRed:0.0/255.0 green:0.0/255.0 blue:128.0/255.0 alpha:1],
-           @"oldlace": [UIColor colorWithRed:253.0/255.0 green:245.0/255.0 blue:230.0/255.0 alpha:1],
-           @"olive": [UIColor colorWithRed:128.0/255.0 green:128.0/255.0 blue:0.0/255.0 alpha:1],
-           @"olivedrab": [UIColor colorWithRed:107.0/255.0 green:142.0/255.0 blue:35.0/255.0 alpha:1],
-           @"orange": [UIColor colorWithRed:255.0/255.0 green:165.0/255.0 blue:0.0/255.0 alpha:1],
-           @"orangered": [UIColor colorWithRed:255.0/255.0 green:69.0/255.0 blue:0.0/255.0 alpha:1],
-           @"orchid": [UIColor colorWithRed:218.0/255.0 green:112.0/255.0 blue:214.0/255.0 alpha:1],
-           @"palegoldenrod": [UIColor colorWithRed:238.0/255.0 green:232.0/255.0 blue:170.0/255.0 alpha:1],
-           @"palegreen": [UIColor colorWithRed:152.0/255.0 green:251.0/255.0 blue:152.0/255.0 alpha:1],
-           @"paleturquoise": [UIColor colorWithRed:175.0/255.0 green:238.0/255.0 blue:238.0/255.0 alpha:1],
-           @"palevioletred": [UIColor colorWithRed:219.0/255.0 green:112.0/255.0 blue:147.0/255.0 alpha:1],
-           @"papayawhip": [UIColor colorWithRed:255.0/255.0 green:239.0/255.0 blue:213.0/255.0 alpha:1],
-           @"peachpuff": [UIColor colorWithRed:255.0/255.0 green:218.0/255.0 blue:185.0/255.0 alpha:1],
-           @"peru": [UIColor colorWithRed:205.0/255.0 green:133.0/255.0 blue:63.0/255.0 alpha:1],
-           @"pink": [UIColor colorWithRed:255.0/255.0 green:192.0/255.0 blue:203.0/255.0 alpha:1],
-           @"plum": [UIColor colorWithRed:221.0/255.0 green:160.0/255.0 blue:221.0/255.0 alpha:1],
-           @"powderblue": [UIColor colorWithRed:176.0/255.0 green:224.0/255.0 blue:230.0/255.0 alpha:1],
-           @"purple": [UIColor colorWithRed:128.0/255.0 green:0.0/255.0 blue:128.0/255.0 alpha:1],
-           @"red": [UIColor colorWithRed:255.0/255.0 green:0.0/255.0 blue:0.0/255.0 alpha:1],
-           @"rosybrown": [UIColor colorWithRed:188.0/255.0 green:143.0/255.0 blue:143.0/255.0 alpha:1],
-           @"royalblue": [UIColor colorWithRed:65.0/255.0 green:105.0/255.0 blue:225.0/255.0 alpha:1],
-           @"saddlebrown": [UIColor colorWithRed:139.0/255.0 green:69.0/255.0 blue:19.0/255.0 alpha:1],
-           @"salmon": [UIColor colorWithRed:250.0/255.0 green:128.0/255.0 blue:114.0/255.0 alpha:1],
-           @"sandybrown": [UIColor colorWithRed:244.0/255.0 green:164.0/255.0 blue:96.0/255.0 alpha:1],
-           @"seagreen": [UIColor colorWithRed:46.0/255.0 green:139.0/255.0 blue:87.0/255.0 alpha:1],
-           @"seashell": [UIColor colorWithRed:255.0/255.0 green:245.0/255.0 blue:238.0/255.0 alpha:1],
-           @"sienna": [UIColor colorWithRed:160.0/255.0 green:82.0/255.0 blue:45.0/255.0 alpha:1],
-           @"silver": [UIColor colorWithRed:192.0/255.0 green:192.0/255.0 blue:192.0/255.0 alpha:1],
-           @"skyblue": [UIColor colorWithRed:135.0/255.0 green:206.0/255.0 blue:235.0/255.0 alpha:1],
-           @"slateblue": [UIColor colorWithRed:106.0/255.0 green:90.0/255.0 blue:205.0/255.0 alpha:1],
-           @"slategray": [UIColor colorWithRed:112.0/255.0 green:128.0/255.0 blue:144.0/255.0 alpha:1],
-           @"slategrey": [UIColor colorWithRed:112.0/255.0 green:128.0/255.0 blue:144.0/255.0 alpha:1],
-           @"snow": [UIColor colorWithRed:255.0/255.0 green:250.0/255.0 blue:250.0/255.0 alpha:1],
-           @"springgreen": [UIColor colorWithRed:0.0/255.0 green:255.0/255.0 blue:127.0/255.0 alpha:1],
-           @"steelblue": [UIColor colorWithRed:70.0/255.0 green:130.0/255.0 blue:180.0/255.0 alpha:1],
-           @"tan": [UIColor colorWithRed:210.0/255.0 green:180.0/255.0 blue:140.0/255.0 alpha:1],
-           @"teal": [UIColor colorWithRed:0.0/255.0 green:128.0/255.0 blue:128.0/255.0 alpha:1],
-           @"thistle": [UIColor colorWithRed:216.0/255.0 green:191.0/255.0 blue:216.0/255.0 alpha:1],
-           @"tomato": [UIColor colorWithRed:255.0/255.0 green:99.0/255.0 blue:71.0/255.0 alpha:1],
-           @"transparent": [UIColor clearColor],
-           @"turquoise": [UIColor colorWithRed:64.0/255.0 green:224.0/255.0 blue:208.0/255.0 alpha:1],
-           @"violet": [UIColor colorWithRed:238.0/255.0 green:130.0/255.0 blue:238.0/255.0 alpha:1],
-           @"wheat": [UIColor colorWithRed:245.0/255.0 green:222.0/255.0 blue:179.0/255.0 alpha:1],
-           @"white": [UIColor colorWithRed:255.0/255.0 green:255.0/255.0 blue:255.0/255.0 alpha:1],
-           @"whitesmoke": [UIColor colorWithRed:245.0/255.0 green:245.0/255.0 blue:245.0/255.0 alpha:1],
-           @"yellow": [UIColor colorWithRed:255.0/255.0 green:255.0/255.0 blue:0.0/255.0 alpha:1],
-           @"yellowgreen": [UIColor colorWithRed:154.0/255.0 green:205.0/255.0 blue:50.0/255.0 alpha:1]};
+        for (NSUInteger i = 0; i < count; i++)
+        {
+            uint32_t argb = NAMED_COLORS[i].argb;
+
+            colors[i] = (argb == 0) ? [UIColor clearColor] : [UIColor colorWithARGBValue:argb];
+        }
     });
 
-    return nameMap;
+    NSUInteger length = string.length;
+
+    if (length == 0 || length > NAME_MAX_LENGTH)
+    {
+        return nil;
+    }
+
+    unichar characters[NAME_MAX_LENGTH];
+    char name[NAME_MAX_LENGTH];
+
+    [string getCharacters:characters range:NSMakeRange(0, length)];
+
+    for (NSUInteger i = 0; i < length; i++)
+    {
+        unichar c = characters[i];
+
+        if (c >= 128)
+        {
+            // a few non-ASCII characters lowercase to ASCII ones, so let Foundation decide
+            NSString *lowercase = string.lowercaseString;
+
+            return ([lowercase isEqualToString:string]) ? nil : STKPXNamedColorForString(lowercase);
+        }
+
+        name[i] = (char) ((c >= 'A' && c <= 'Z') ? c + ('a' - 'A') : c);
+    }
+
+    NSInteger index = STKPXNamedColorIndex(name, length);
+
+    return (index >= 0) ? colors[index] : nil;
 }
 
+/**
+ *  Decode a #rgb, #argb, #rrggbb or #aarrggbb string. Returns NO for any other form
+ */
+static BOOL STKPXHexColorValue(NSString *hexString, CGFloat alpha, uint *argb)
+{
+    NSUInteger length = hexString.length;
+    NSUInteger start = (length > 0 && [hexString characterAtIndex:0] == '#') ? 1 : 0;
+    NSUInteger count = length - start;
+
+    if (count != 3 && count != 4 && count != 6 && count != 8)
+    {
+        return NO;
+    }
+
+    unichar characters[8];
+
+    [hexString getCharacters:characters range:NSMakeRange(start, count)];
+
+    // short forms repeat every digit
+    BOOL shortForm = (count <= 4);
+    uint shift = (shortForm) ? 8 : 4;
+    uint scale = (shortForm) ? 0x11 : 0x1;
+    uint value = 0;
+    uint invalid = 0;
+
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        unichar c = characters[i];
+        uint digit = HEX_VALUES[c & 0xFF];
+
+        invalid |= (digit >> 4) | (c >> 8);
+        value = (value << shift) | ((digit & 0xF) * scale);
+    }
+
+    if (invalid)
+    {
+        return NO;
+    }
+
+    // the four and eight digit forms carry their own alpha
+    if (count == 3 || count == 6)
+    {
+        alpha = MIN(MAX(0.0, alpha), 1.0);
+        value |= ((uint) (alpha * 255.0)) << 24;
+    }
+
+    *argb = value;
+
+    return YES;
+}
+
+@implementation UIColor (STKPXColors)
+
+#pragma mark - Static Methods
+
 + (UIColor *)colorFromName:(NSString *)name
 {
     UIColor *result = nil;
 
     if (name.length > 0)
     {
-        result = [UIColor nameMap][name.lowercaseString];
+        result = STKPXNamedColorForString(name);
 
         if (result == nil)
         {
-            // convert to camel case
-            name = [self toCamelCase:name];
+            result = [self systemColorFromName:name];
+        }
+    }
+
+    return (result) ? result : [UIColor blackColor];
+}
 
-            Class colorClass = [UIColor class];
-            NSString *selectorName = ([name hasSuffix:@"Color"] == NO) ? [NSString stringWithFormat:@"%@Color", name] : name;
-            SEL selector = NSSelectorFromString(selectorName);
+/**
+ *  Resolve a name like "light-gray" to a UIColor class method like +lightGrayColor. Results are remembered, since the
+ *  same few names show up again and again in a stylesheet
+ */
++ (UIColor *)systemColorFromName:(NSString *)name
+{
+    static NSMutableDictionary *systemColors;
+    static dispatch_once_t onceToken;
 
-            if ([colorClass respondsToSelector:selector])
-            {
+    dispatch_once(&onceToken, ^{
+        systemColors = [[NSMutableDictionary alloc] init];
+    });
+
+    id result;
+
+    @synchronized(systemColors)
+    {
+        result = systemColors[name];
+    }
+
+    if (result == nil)
+    {
+        // convert to camel case
+        NSString *camelCaseName = [self toCamelCase:name];
+
+        Class colorClass = [UIColor class];
+        NSString *selectorName = ([camelCaseName hasSuffix:@"Color"] == NO) ? [NSString stringWithFormat:@"%@Color", camelCaseName] : camelCaseName;
+        SEL selector = NSSelectorFromString(selectorName);
+
+        result = [NSNull null];
+
+        if ([colorClass respondsToSelector:selector])
+        {
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Warc-performSelector-leaks"
-                id candidate = [colorClass performSelector:selector];
+            id candidate = [colorClass performSelector:selector];
 #pragma clang diagnostic pop
 
-                if ([candidate isKindOfClass:colorClass])
-                {
-                    result = candidate;
-                }
+            if ([candidate isKindOfClass:colorClass])
+            {
+                result = candidate;
             }
         }
+
+        @synchronized(systemColors)
+        {
+            systemColors[[name copy]] = result;
+        }
     }
 
-    return (result) ? result : [UIColor blackColor];
+    return (result != [NSNull null]) ? result : nil;
 }
 
 + (NSString *)toCamelCase:(NSString *)source
 {
-    NSError *error = NULL;
-    NSRegularExpression *regex = [NSRegularExpression
-                                  regularExpressionWithPattern:@"-([a-z])"
-                                  options:NSRegularExpressionCaseInsensitive
-                                  error:&error];
-    NSMutableString *result = [NSMutableString stringWithString:source];
-
-    // keep track of how many additional characters we've added (1 per iteration)
-    __block NSUInteger count = 0;
-
-    [regex enumerateMatchesInString:source
-                            options:0
-                              range:NSMakeRange(0, source.length)
-                         usingBlock:^(NSTextCheckingResult *match, NSMatchingFlags flags, BOOL *stop) {
-                             NSString *character = [source substringWithRange:[match rangeAtIndex:1]];
-                             NSString *upperCharacter = character.uppercaseString;
-
-                             // every iteration, the output string is getting longer
-                             // so we need to adjust the range that we are editing
-                             NSRange updateRange = NSMakeRange(match.range.location - count, match.range.length);
-                             [result replaceCharactersInRange:updateRange withString:upperCharacter];
-
-                             count++;
-                         }];
+    NSUInteger length = source.length;
+    NSMutableString *result = [NSMutableString stringWithCapacity:length];
+
+    // drop each hyphen that precedes a letter and uppercase the letter
+    for (NSUInteger i = 0; i < length; i++)
+    {
+        unichar c = [source characterAtIndex:i];
+
+        if (c == '-' && i + 1 < length)
+        {
+            unichar next = [source characterAtIndex:i + 1];
+
+            if ((next >= 'a' && next <= 'z') || (next >= 'A' && next <= 'Z'))
+            {
+                c = (next >= 'a') ? next - ('a' - 'A') : next;
+                i++;
+            }
+        }
+
+        [result appendFormat:@"%C", c];
+    }
 
     return result;
 }
@@ -286,6 +498,12 @@ void STKPXForceLoadUIColorPXColor() {}
 {
     uint value = 0;
 
+    if (STKPXHexColorValue(hexString, alpha, &value))
+    {
+        return [UIColor colorWithARGBValue:value];
+    }
+
+    // malformed strings keep the lenient scanning they have always had
     if (hexString)
     {
         int startingIndex = ([hexString hasPrefix:@"#"]) ? 1 : 0;
@@ -27,6 +27,7 @@
 #import "STKPXMath.h"
 
 #define THRESHOLD 0.25
+#define MAX_SEGMENTS 1024
 #define RATIONAL_FUNCTION(x,c) ((x * (x * c[0] + c[1]) + c[2]) / (x + c[3]))
 #define LOG_VAR(v) NSLog(@""#v" = %f", v)
 
@@ -82,6 +83,9 @@ void CGPathAddEllipticalArc(CGMutablePathRef path, const CGAffineTransform *m, C
     CGFloat eta2_;
     CGFloat sinTheta_;
     CGFloat cosTheta_;
+    CGFloat errorScale_;
+    CGFloat c0_[4];
+    CGFloat c1_[4];
 }
 
 #pragma mark - Initializers
@@ -131,121 +135,153 @@ void CGPathAddEllipticalArc(CGMutablePathRef path, const CGAffineTransform *m, C
 {
     CGAffineTransform *pTransform = (CGAffineTransformIsIdentity(transform)) ? NULL : &transform;
 
-    BOOL found = NO;
-    NSUInteger n = 1;
+    NSUInteger n = [self segmentCount];
+    CGFloat dEta = (eta2_ - eta1_) / n;
+    CGFloat t = TAN(0.5f * dEta);
+    CGFloat alpha = SIN(dEta) * (SQRT(4.0f + 3.0f * t * t) - 1.0f) / 3.0f;
 
-    while (found == NO && (n < 1024))
+    // evaluate every segment end point and its tangent in one pass, then emit the curves
+    CGFloat cosEta[n + 1];
+    CGFloat sinEta[n + 1];
+    CGPoint points[n + 1];
+    CGPoint tangents[n + 1];
+    CGFloat eta = eta1_;
+
+    for (NSUInteger i = 0; i <= n; ++i)
     {
-        CGFloat dEta = (eta2_ - eta1_) / n;
+        cosEta[i] = COS(eta);
+        sinEta[i] = SIN(eta);
+        eta += dEta;
+    }
 
-        if (dEta <= M_PI_2)
-        {
-            CGFloat etaB = eta1_;
+    for (NSUInteger i = 0; i <= n; ++i)
+    {
+        CGFloat aCosEta = a_ * cosEta[i];
+        CGFloat bSinEta = b_ * sinEta[i];
+        CGFloat aSinEta = a_ * sinEta[i];
+        CGFloat bCosEta = b_ * cosEta[i];
+
+        points[i].x = cx_ + aCosEta * cosTheta_ - bSinEta * sinTheta_;
+        points[i].y = cy_ + aCosEta * sinTheta_ + bSinEta * cosTheta_;
+        tangents[i].x = -aSinEta * cosTheta_ - bCosEta * sinTheta_;
+        tangents[i].y = -aSinEta * sinTheta_ + bCosEta * cosTheta_;
+    }
 
-            found = YES;
+    for (NSUInteger i = 0; i < n; ++i)
+    {
+        CGPoint pA = points[i];
+        CGPoint pB = points[i + 1];
 
-            for (NSUInteger i = 0; found && (i < n); ++i)
-            {
-                CGFloat etaA = etaB;
+        CGFloat c1x = (pA.x + alpha * tangents[i].x);
+        CGFloat c1y = (pA.y + alpha * tangents[i].y);
+        CGFloat c2x = (pB.x - alpha * tangents[i + 1].x);
+        CGFloat c2y = (pB.y - alpha * tangents[i + 1].y);
 
-                etaB += dEta;
+        CGPathAddCurveToPoint(path, pTransform, c1x, c1y, c2x, c2y, pB.x, pB.y);
+    }
+}
 
-                CGFloat error = [self estimateErrorForStartingAngle:etaA endingAngle:etaB];
+#pragma mark - Helper Methods
+
+- (NSUInteger)segmentCount
+{
+    [self prepareErrorModel];
+
+    CGFloat sweep = eta2_ - eta1_;
+    NSUInteger n = 1;
+
+    // c0 and c1 vary with the segment's position on the ellipse through cos(2 eta), cos(4 eta) and cos(6 eta) only, so
+    // they are bounded by their constant term plus or minus the magnitude of the other three
+    CGFloat c0Spread = ABS(c0_[1]) + ABS(c0_[2]) + ABS(c0_[3]);
+    CGFloat c1Spread = ABS(c1_[1]) + ABS(c1_[2]) + ABS(c1_[3]);
+    CGFloat c0Min = c0_[0] - c0Spread;
+    CGFloat c0Max = c0_[0] + c0Spread;
+    CGFloat c1Min = c1_[0] - c1Spread;
+    CGFloat c1Max = c1_[0] + c1Spread;
+
+    // segments spanning more than a quarter turn are never accepted
+    while (n < MAX_SEGMENTS && sweep / n > M_PI_2)
+    {
+        n <<= 1;
+    }
+
+    while (n < MAX_SEGMENTS)
+    {
+        CGFloat dEta = sweep / n;
+
+        if (dEta <= M_PI_2)
+        {
+            CGFloat highestExponent = c0Max + MAX(c1Min * dEta, c1Max * dEta);
+            CGFloat lowestExponent = c0Min + MIN(c1Min * dEta, c1Max * dEta);
 
-                found = (error <= THRESHOLD);
+            // accept or reject the whole count from the bounds, only measuring segments when the bounds straddle the
+            // threshold. NaNs fall through to the segment test, which rejects them
+            if (errorScale_ * EXP(highestExponent) <= THRESHOLD)
+            {
+                break;
+            }
+            else if (!(errorScale_ * EXP(lowestExponent) > THRESHOLD) && [self segmentsFitThresholdWithCount:n])
+            {
+                break;
             }
         }
 
         n <<= 1;
     }
 
+    // the count that fits is doubled once more, as the original search always did before emitting curves
+    return MIN(n << 1, MAX_SEGMENTS);
+}
+
+- (BOOL)segmentsFitThresholdWithCount:(NSUInteger)n
+{
     CGFloat dEta = (eta2_ - eta1_) / n;
     CGFloat etaB = eta1_;
 
-    CGFloat cosEtaB = COS(etaB);
-    CGFloat sinEtaB = SIN(etaB);
-    CGFloat aCosEtaB = a_ * cosEtaB;
-    CGFloat bSinEtaB = b_ * sinEtaB;
-    CGFloat aSinEtaB = a_ * sinEtaB;
-    CGFloat bCosEtaB = b_ * cosEtaB;
-    CGFloat xB = cx_ + aCosEtaB * cosTheta_ - bSinEtaB * sinTheta_;
-    CGFloat yB = cy_ + aCosEtaB * sinTheta_ + bSinEtaB * cosTheta_;
-    CGFloat xBDot = -aSinEtaB * cosTheta_ - bCosEtaB * sinTheta_;
-    CGFloat yBDot = -aSinEtaB * sinTheta_ + bCosEtaB * cosTheta_;
-
-    CGFloat t = TAN(0.5f * dEta);
-    CGFloat alpha = SIN(dEta) * (SQRT(4.0f + 3.0f * t * t) - 1.0f) / 3.0f;
-
     for (NSUInteger i = 0; i < n; ++i)
     {
-        //CGFloat etaA = etaB;
-        CGFloat xA = xB;
-        CGFloat yA = yB;
-        CGFloat xADot = xBDot;
-        CGFloat yADot = yBDot;
+        CGFloat etaA = etaB;
 
         etaB += dEta;
 
-        cosEtaB = COS(etaB);
-        sinEtaB = SIN(etaB);
-        aCosEtaB = a_ * cosEtaB;
-        bSinEtaB = b_ * sinEtaB;
-        aSinEtaB = a_ * sinEtaB;
-        bCosEtaB = b_ * cosEtaB;
-        xB = cx_ + aCosEtaB * cosTheta_ - bSinEtaB * sinTheta_;
-        yB = cy_ + aCosEtaB * sinTheta_ + bSinEtaB * cosTheta_;
-        xBDot = -aSinEtaB * cosTheta_ - bCosEtaB * sinTheta_;
-        yBDot = -aSinEtaB * sinTheta_ + bCosEtaB * cosTheta_;
-
-        CGFloat c1x = (xA + alpha * xADot);
-        CGFloat c1y = (yA + alpha * yADot);
-        CGFloat c2x = (xB - alpha * xBDot);
-        CGFloat c2y = (yB - alpha * yBDot);
-
-        CGPathAddCurveToPoint(path, pTransform, c1x, c1y, c2x, c2y, xB, yB);
+        if (!([self estimateErrorForStartingAngle:etaA endingAngle:etaB] <= THRESHOLD))
+        {
+            return NO;
+        }
     }
+
+    return YES;
 }
 
-#pragma mark - Helper Methods
+- (void)prepareErrorModel
+{
+    CGFloat safety[] = { 0.001f, 4.98f, 0.207f, 0.0067f };
+    CGFloat x = b_ / a_;
+    CGFloat (*coeffs)[4][4] = (x < 0.25f) ? coeffs3Low : coeffs3High;
+
+    // the rational functions only depend on the axis ratio, so evaluate them once per arc
+    for (NSUInteger i = 0; i < 4; ++i)
+    {
+        c0_[i] = RATIONAL_FUNCTION(x, coeffs[0][i]);
+        c1_[i] = RATIONAL_FUNCTION(x, coeffs[1][i]);
+    }
+
+    errorScale_ = RATIONAL_FUNCTION(x, safety) * a_;
+}
 
 - (CGFloat)estimateErrorForStartingAngle:(CGFloat)etaA endingAngle:(CGFloat)etaB
 {
-    CGFloat eta = (etaA + etaB) * 0.5f;
-    CGFloat x = b_ / a_;
     CGFloat dEta = etaB - etaA;
-    CGFloat cos2 = COS(2.0f * eta);
-    CGFloat cos4 = COS(4.0f * eta);
-    CGFloat cos6 = COS(6.0f * eta);
 
-    CGFloat safety[] = { 0.001f, 4.98f, 0.207f, 0.0067f };
-    CGFloat c0, c1;
+    // cos(4 eta) and cos(6 eta) follow from cos(2 eta) by the double and triple angle identities
+    CGFloat cos2 = COS(etaA + etaB);
+    CGFloat cos4 = 2.0f * cos2 * cos2 - 1.0f;
+    CGFloat cos6 = cos2 * (2.0f * cos4 - 1.0f);
 
-    if (x < 0.25f)
-    {
-        c0 = RATIONAL_FUNCTION(x, coeffs3Low[0][0])
-            + cos2 * RATIONAL_FUNCTION(x, coeffs3Low[0][1])
-            + cos4 * RATIONAL_FUNCTION(x, coeffs3Low[0][2])
-            + cos6 * RATIONAL_FUNCTION(x, coeffs3Low[0][3]);
-
-        c1 = RATIONAL_FUNCTION(x, coeffs3Low[1][0])
-            + cos2 * RATIONAL_FUNCTION(x, coeffs3Low[1][1])
-            + cos4 * RATIONAL_FUNCTION(x, coeffs3Low[1][2])
-            + cos6 * RATIONAL_FUNCTION(x, coeffs3Low[1][3]);
-    }
-    else
-    {
-        c0 = RATIONAL_FUNCTION(x, coeffs3High[0][0])
-            + cos2 * RATIONAL_FUNCTION(x, coeffs3High[0][1])
-            + cos4 * RATIONAL_FUNCTION(x, coeffs3High[0][2])
-            + cos6 * RATIONAL_FUNCTION(x, coeffs3High[0][3]);
-
-        c1 = RATIONAL_FUNCTION(x, coeffs3High[1][0])
-            + cos2 * RATIONAL_FUNCTION(x, coeffs3High[1][1])
-            + cos4 * RATIONAL_FUNCTION(x, coeffs3High[1][2])
-            + cos6 * RATIONAL_FUNCTION(x, coeffs3High[1][3]);
-    }
+    CGFloat c0 = c0_[0] + cos2 * c0_[1] + cos4 * c0_[2] + cos6 * c0_[3];
+    CGFloat c1 = c1_[0] + cos2 * c1_[1] + cos4 * c1_[2] + cos6 * c1_[3];
 
-    return RATIONAL_FUNCTION(x, safety) * a_ * EXP(c0 + c1 * dEta);
+    return errorScale_ * EXP(c0 + c1 * dEta);
 }
 
 @end
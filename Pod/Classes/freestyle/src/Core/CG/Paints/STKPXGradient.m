@@ -26,6 +26,19 @@
 #import "STKPXGradient.h"
 #import "UIColor+STKPXColors.h"
 
+static CGColorSpaceRef STKPXGradientColorSpace()
+{
+    static CGColorSpaceRef colorSpace;
+    static dispatch_once_t onceToken;
+
+    // every gradient draws in device RGB, so they can all share one color space
+    dispatch_once(&onceToken, ^{
+        colorSpace = CGColorSpaceCreateDeviceRGB();
+    });
+
+    return colorSpace;
+}
+
 @implementation STKPXGradient
 
 @synthesize gradient = _gradient;
@@ -107,24 +120,15 @@
 {
     if (!_gradient)
     {
-        // if color count and offset count don't match, then evenly distribute all colors from 0 to 1
-        if (_colors.count != self.offsets.count)
-        {
-            [_offsets removeAllObjects];
-
-            for (int i = 0; i < _colors.count; i++)
-            {
-                [_offsets addObject:@((CGFloat) i / (_colors.count - 1))];
-            }
-        }
-
-        // convert locations
-        NSUInteger locationCount = _offsets.count;
-        CGFloat locations[locationCount];
+        // convert locations. If color count and offset count don't match, then evenly distribute all colors from 0 to
+        // 1. The offsets themselves are left alone so creating the gradient doesn't change its value
+        NSUInteger locationCount = _colors.count;
+        BOOL distribute = (locationCount != _offsets.count);
+        CGFloat locations[MAX(locationCount, 1)];
 
         for (int i = 0; i < locationCount; i++)
         {
-            locations[i] = [_offsets[i] floatValue];
+            locations[i] = (distribute) ? (CGFloat) i / MAX(locationCount - 1, 1) : [_offsets[i] floatValue];
         }
 
         // convert colors
@@ -137,14 +141,8 @@
             [cgColorArray addObject:(__bridge id)cref];
         }
 
-        // create color space
-        CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
-
         // create gradient
-        _gradient = CGGradientCreateWithColors(colorSpace, (__bridge CFArrayRef) cgColorArray, locations);
-
-        // release color space
-        CGColorSpaceRelease(colorSpace);
+        _gradient = CGGradientCreateWithColors(STKPXGradientColorSpace(), (__bridge CFArrayRef) cgColorArray, locations);
     }
 
     // return gradient
@@ -191,18 +189,37 @@
 {
     BOOL result = NO;
 
-    if ([object isKindOfClass:[STKPXGradient class]])
+    // compare values only, so gradients with the same stops are equal whether or not their CGGradient exists yet
+    if ([object class] == [self class])
     {
         STKPXGradient *that = object;
 
         result = [self->_offsets isEqualToArray:that->_offsets]
             &&  [self->_colors isEqualToArray:that->_colors]
             &&  CGAffineTransformEqualToTransform(self->_transform, that->_transform)
-            &&  (self->_gradient == that->_gradient)
+            &&  (self->_gradientUnits == that->_gradientUnits)
             &&  (self->_blendMode == that->_blendMode);
     }
 
     return result;
 }
 
+- (NSUInteger)hash
+{
+    // NSArray only hashes its count, so fold in the stops
+    NSUInteger result = _blendMode;
+
+    for (NSNumber *offset in _offsets)
+    {
+        result = result * 31 + offset.hash;
+    }
+
+    for (UIColor *color in _colors)
+    {
+        result = result * 31 + color.hash;
+    }
+
+    return result;
+}
+
 @end
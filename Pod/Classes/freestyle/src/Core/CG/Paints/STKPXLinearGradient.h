@@ -37,6 +37,12 @@ typedef enum {
     STKPXLinearGradientDirectionToTopLeft
 } STKPXLinearGradientDirection;
 
+typedef enum {
+    STKPXLinearGradientAxisNone,        // the gradient runs diagonally or has a transform
+    STKPXLinearGradientAxisHorizontal,  // colors only vary along x
+    STKPXLinearGradientAxisVertical     // colors only vary along y
+} STKPXLinearGradientAxis;
+
 /**
  *  STKPXLinearGradient is an implementation of a linear gradient. Linear gradients may be specified by an angle, or by two
  *  user-defined points.
@@ -78,6 +84,12 @@ typedef enum {
  */
 @property (nonatomic) STKPXLinearGradientDirection gradientDirection;
 
+/**
+ *  The axis colors vary along when the gradient fills a rectangle. Shapes filled with a gradient that has an axis can
+ *  be stretched along the other axis without changing their appearance
+ */
+@property (nonatomic, readonly) STKPXLinearGradientAxis axis;
+
 /**
  *  Allocate and initialize a new linear gradient using the specified starting and ending colors
  *
@@ -86,4 +98,14 @@ typedef enum {
  */
 + (STKPXLinearGradient *)gradientFromStartColor:(UIColor *)startColor endColor:(UIColor *)endColor;
 
+/**
+ *  Calculate the points the gradient runs between when filling the specified path. The points are in gradient space,
+ *  before this gradient's transform is applied
+ *
+ *  @param startPoint Receives the point where the first color is rendered
+ *  @param endPoint Receives the point where the last color is rendered
+ *  @param path The path being filled
+ */
+- (void)getStartPoint:(CGPoint *)startPoint endPoint:(CGPoint *)endPoint forPath:(CGPathRef)path;
+
 @end
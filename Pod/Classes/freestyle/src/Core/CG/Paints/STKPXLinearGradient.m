@@ -80,6 +80,71 @@ STK_DEFINE_CLASS_LOG_LEVEL;
     return -self.angle;
 }
 
+- (STKPXLinearGradientAxis)axis
+{
+    if (!CGAffineTransformIsIdentity(self.transform))
+    {
+        return STKPXLinearGradientAxisNone;
+    }
+
+    switch (angleType_)
+    {
+        case STKPXAngleTypeDirection:
+            switch (_gradientDirection)
+            {
+                case STKPXLinearGradientDirectionToTop:
+                case STKPXLinearGradientDirectionToBottom:
+                    return STKPXLinearGradientAxisVertical;
+
+                case STKPXLinearGradientDirectionToLeft:
+                case STKPXLinearGradientDirectionToRight:
+                    return STKPXLinearGradientAxisHorizontal;
+
+                default:
+                    return STKPXLinearGradientAxisNone;
+            }
+
+        case STKPXAngleTypePoints:
+            // user space points don't scale with the shape, so they can't be stretched
+            if (self.gradientUnits == STKPXGradientUnitsUserSpace)
+            {
+                return STKPXLinearGradientAxisNone;
+            }
+            else if (_p1.x == _p2.x)
+            {
+                return STKPXLinearGradientAxisVertical;
+            }
+            else if (_p1.y == _p2.y)
+            {
+                return STKPXLinearGradientAxisHorizontal;
+            }
+
+            return STKPXLinearGradientAxisNone;
+
+        case STKPXAngleTypeAngle:
+        default:
+        {
+            CGFloat angle = fmod(_angle, 180.0f);
+
+            if (angle < 0.0f)
+            {
+                angle += 180.0f;
+            }
+
+            if (angle == 0.0f)
+            {
+                return STKPXLinearGradientAxisHorizontal;
+            }
+            else if (angle == 90.0f)
+            {
+                return STKPXLinearGradientAxisVertical;
+            }
+
+            return STKPXLinearGradientAxisNone;
+        }
+    }
+}
+
 #pragma mark - Setters
 
 - (void)setAngle:(CGFloat)anAngle
@@ -132,6 +197,22 @@ STK_DEFINE_CLASS_LOG_LEVEL;
     // placeholders for gradient points
     CGPoint point1, point2;
 
+    [self getStartPoint:&point1 endPoint:&point2 forPath:path];
+
+    // set blending mode
+    CGContextSetBlendMode(context, self.blendMode);
+
+    // do the gradient
+    CGContextDrawLinearGradient(context, self.gradient, point1, point2, kCGGradientDrawsBeforeStartLocation | kCGGradientDrawsAfterEndLocation);
+
+    // restore coordinate system
+    CGContextRestoreGState(context);
+}
+
+- (void)getStartPoint:(CGPoint *)startPoint endPoint:(CGPoint *)endPoint forPath:(CGPathRef)path
+{
+    CGPoint point1, point2;
+
     if (angleType_ == STKPXAngleTypePoints)
     {
         if (self.gradientUnits == STKPXGradientUnitsUserSpace)
@@ -300,14 +381,8 @@ STK_DEFINE_CLASS_LOG_LEVEL;
         }
     }
 
-    // set blending mode
-    CGContextSetBlendMode(context, self.blendMode);
-
-    // do the gradient
-    CGContextDrawLinearGradient(context, self.gradient, point1, point2, kCGGradientDrawsBeforeStartLocation | kCGGradientDrawsAfterEndLocation);
-
-    // restore coordinate system
-    CGContextRestoreGState(context);
+    *startPoint = point1;
+    *endPoint = point2;
 }
 
 - (id<STKPXPaint>)lightenByPercent:(CGFloat)percent
@@ -406,4 +481,29 @@ STK_DEFINE_CLASS_LOG_LEVEL;
     return result;
 }
 
+- (NSUInteger)hash
+{
+    NSUInteger result = super.hash * 31 + angleType_;
+
+    switch (angleType_)
+    {
+        case STKPXAngleTypeAngle:
+            result = result * 31 + @(_angle).hash;
+            break;
+
+        case STKPXAngleTypeDirection:
+            result = result * 31 + _gradientDirection;
+            break;
+
+        case STKPXAngleTypePoints:
+            result = result * 31 + @(_p1.x).hash;
+            result = result * 31 + @(_p1.y).hash;
+            result = result * 31 + @(_p2.x).hash;
+            result = result * 31 + @(_p2.y).hash;
+            break;
+    }
+
+    return result;
+}
+
 @end
@@ -0,0 +1,93 @@
+/****************************************************************************
+ *
+ * Copyright 2015-present StylingKit Development Team. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ****************************************************************************/
+
+//
+//  STKPXPaintPool.h
+//  StylingKit
+//
+
+#import <UIKit/UIKit.h>
+
+@class STKPXGradient;
+
+/**
+ *  STKPXPaintPool interns the colors and gradients produced by the value parser. Equal values resolve to one shared
+ *  object: colors are matched by color space and components (RGBA for RGB colors), and gradients by class, geometry
+ *  and stop list. An interned gradient creates its CGGradient once, up front, so every declaration using it shares that
+ *  CGGradient. The pool only holds weak references and an entry goes away with the last declaration using it.
+ *
+ *  Interned objects are shared and must not be mutated.
+ */
+@interface STKPXPaintPool : NSObject
+
+/**
+ *  The shared pool used by STKPXValueParser
+ */
++ (instancetype)sharedInstance;
+
+/**
+ *  Determines if values are interned. When NO, every value is returned unchanged. Defaults to YES
+ */
+@property (nonatomic) BOOL enabled;
+
+/**
+ *  The number of distinct colors currently in the pool
+ */
+@property (nonatomic, readonly) NSUInteger colorCount;
+
+/**
+ *  The number of distinct gradients currently in the pool
+ */
+@property (nonatomic, readonly) NSUInteger gradientCount;
+
+/**
+ *  The number of colors answered with an existing instance since the counters were last reset
+ */
+@property (nonatomic, readonly) NSUInteger colorHits;
+
+/**
+ *  The number of gradients answered with an existing instance since the counters were last reset
+ */
+@property (nonatomic, readonly) NSUInteger gradientHits;
+
+/**
+ *  Return the pooled color equal to the specified color, adding it to the pool if it is the first of its value
+ *
+ *  @param color The color to intern
+ */
+- (UIColor *)internColor:(UIColor *)color;
+
+/**
+ *  Return the pooled gradient equal to the specified gradient, adding it to the pool if it is the first of its value.
+ *  The colors of a gradient added to the pool are interned as well
+ *
+ *  @param gradient The gradient to intern
+ */
+- (STKPXGradient *)internGradient:(STKPXGradient *)gradient;
+
+/**
+ *  Forget all pooled values. Objects already handed out stay valid
+ */
+- (void)removeAllObjects;
+
+/**
+ *  Reset colorHits and gradientHits
+ */
+- (void)resetCounters;
+
+@end
@@ -0,0 +1,165 @@
+/****************************************************************************
+ *
+ * Copyright 2015-present StylingKit Development Team. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ****************************************************************************/
+
+//
+//  STKPXPaintPool.m
+//  StylingKit
+//
+
+#import "STKPXPaintPool.h"
+#import "STKPXGradient.h"
+
+@implementation STKPXPaintPool
+{
+    NSHashTable *colors_;
+    NSHashTable *gradients_;
+}
+
+#pragma mark - Static Methods
+
++ (instancetype)sharedInstance
+{
+    static STKPXPaintPool *sharedInstance;
+    static dispatch_once_t onceToken;
+
+    dispatch_once(&onceToken, ^{
+        sharedInstance = [[STKPXPaintPool alloc] init];
+    });
+
+    return sharedInstance;
+}
+
+#pragma mark - Initializers
+
+- (instancetype)init
+{
+    if (self = [super init])
+    {
+        colors_ = [NSHashTable weakObjectsHashTable];
+        gradients_ = [NSHashTable weakObjectsHashTable];
+        _enabled = YES;
+    }
+
+    return self;
+}
+
+#pragma mark - Getters
+
+- (NSUInteger)colorCount
+{
+    @synchronized(self)
+    {
+        // weak tables purge lazily, so count only the entries still alive
+        return colors_.allObjects.count;
+    }
+}
+
+- (NSUInteger)gradientCount
+{
+    @synchronized(self)
+    {
+        return gradients_.allObjects.count;
+    }
+}
+
+#pragma mark - Methods
+
+- (UIColor *)internColor:(UIColor *)color
+{
+    if (color == nil || _enabled == NO)
+    {
+        return color;
+    }
+
+    @synchronized(self)
+    {
+        return [self internColorLocked:color];
+    }
+}
+
+- (STKPXGradient *)internGradient:(STKPXGradient *)gradient
+{
+    if (gradient == nil || _enabled == NO)
+    {
+        return gradient;
+    }
+
+    @synchronized(self)
+    {
+        STKPXGradient *result = [gradients_ member:gradient];
+
+        if (result)
+        {
+            _gradientHits++;
+        }
+        else
+        {
+            for (NSUInteger i = 0; i < gradient.colors.count; i++)
+            {
+                gradient.colors[i] = [self internColorLocked:gradient.colors[i]];
+            }
+
+            // create the one CGGradient every user of this gradient shares
+            (void) gradient.gradient;
+
+            [gradients_ addObject:gradient];
+            result = gradient;
+        }
+
+        return result;
+    }
+}
+
+- (void)removeAllObjects
+{
+    @synchronized(self)
+    {
+        [colors_ removeAllObjects];
+        [gradients_ removeAllObjects];
+    }
+}
+
+- (void)resetCounters
+{
+    @synchronized(self)
+    {
+        _colorHits = 0;
+        _gradientHits = 0;
+    }
+}
+
+#pragma mark - Private Methods
+
+- (UIColor *)internColorLocked:(UIColor *)color
+{
+    UIColor *result = [colors_ member:color];
+
+    if (result)
+    {
+        _colorHits++;
+    }
+    else
+    {
+        [colors_ addObject:color];
+        result = color;
+    }
+
+    return result;
+}
+
+@end
@@ -47,4 +47,15 @@
  */
 @property (nonatomic) CGFloat radius;
 
+/**
+ *  Calculate the circles the gradient runs between when filling the specified path. The gradient starts as a point at
+ *  startCenter and ends with a circle of the returned radius around endCenter, in gradient space
+ *
+ *  @param startCenter Receives the center of the first color
+ *  @param endCenter Receives the center of the last color
+ *  @param radius Receives the radius of the last color
+ *  @param path The path being filled
+ */
+- (void)getStartCenter:(CGPoint *)startCenter endCenter:(CGPoint *)endCenter radius:(CGFloat *)radius forPath:(CGPathRef)path;
+
 @end
@@ -59,6 +59,24 @@
     CGPoint center2;
     CGFloat r;
 
+    [self getStartCenter:&center1 endCenter:&center2 radius:&r forPath:path];
+
+    // set blending mode
+    CGContextSetBlendMode(context, self.blendMode);
+
+    // do the gradient
+    CGContextDrawRadialGradient(context, self.gradient, center1, 0, center2, r, kCGGradientDrawsBeforeStartLocation | kCGGradientDrawsAfterEndLocation);
+
+    // restore coordinate system
+    CGContextRestoreGState(context);
+}
+
+- (void)getStartCenter:(CGPoint *)startCenter endCenter:(CGPoint *)endCenter radius:(CGFloat *)radius forPath:(CGPathRef)path
+{
+    CGPoint center1;
+    CGPoint center2;
+    CGFloat r;
+
     if (_radius == 0)
     {
         CGRect bounds = CGPathGetPathBoundingBox(path);
@@ -95,14 +113,9 @@
         r = pathBounds.size.width * _radius;
     }
 
-    // set blending mode
-    CGContextSetBlendMode(context, self.blendMode);
-
-    // do the gradient
-    CGContextDrawRadialGradient(context, self.gradient, center1, 0, center2, r, kCGGradientDrawsBeforeStartLocation | kCGGradientDrawsAfterEndLocation);
-
-    // restore coordinate system
-    CGContextRestoreGState(context);
+    *startCenter = center1;
+    *endCenter = center2;
+    *radius = r;
 }
 
 - (id<STKPXPaint>)lightenByPercent:(CGFloat)percent
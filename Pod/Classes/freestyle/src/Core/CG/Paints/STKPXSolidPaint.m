@@ -83,6 +83,11 @@
     return result;
 }
 
+- (NSUInteger)hash
+{
+    return _color.hash * 31 + _blendMode;
+}
+
 #pragma mark - STKPXPaint implementation
 
 - (void)applyFillToPath:(CGPathRef)path withContext:(CGContextRef)context
@@ -0,0 +1,58 @@
+/****************************************************************************
+ *
+ * Copyright 2015-present StylingKit Development Team. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ****************************************************************************/
+
+//
+//  STKPXSVGStreamLoader.h
+//  StylingKit
+//
+
+#import <UIKit/UIKit.h>
+
+@class STKPXShapeDocument;
+
+/**
+ *  STKPXSVGStreamLoader is a libxml2 SAX2 front-end for the SVG subset understood by STKPXSVGLoader. It builds the same
+ *  STKPXShapeDocument, but decodes attribute values straight from the parser's byte ranges into numbers, colors,
+ *  transforms and enumerations instead of collecting a dictionary of strings for every element, and it only creates a
+ *  stroke for shapes that have one.
+ *
+ *  STKPXSVGLoader remains the extension point for custom element types. STKPXShapeView only uses this loader when the
+ *  streamingSVGLoader configuration setting is on and no custom loader class has been registered.
+ */
+@interface STKPXSVGStreamLoader : NSObject
+
+/**
+ *  The URL being loaded, used when reporting errors
+ */
+@property (nonatomic) NSURL *URL;
+
+/**
+ *  Create a STKPXShapeDocument by loading the SVG file specified by the given URL
+ *
+ *  @param URL The URL to load
+ */
++ (STKPXShapeDocument *)loadFromURL:(NSURL *)URL;
+
+/**
+ *  Create a STKPXShapeDocument by loading the SVG file contained in the given NSData
+ *
+ *  @param data The NSData to load
+ */
++ (STKPXShapeDocument *)loadFromData:(NSData *)data;
+
+@end
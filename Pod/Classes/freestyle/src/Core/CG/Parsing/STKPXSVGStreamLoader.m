@@ -0,0 +1,1337 @@
+/****************************************************************************
+ *
+ * Copyright 2015-present StylingKit Development Team. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ****************************************************************************/
+
+//
+//  STKPXSVGStreamLoader.m
+//  StylingKit
+//
+
+#import "STKPXSVGStreamLoader.h"
+#import "STKPXTransformParser.h"
+#import "STKPXValueParser.h"
+#import "STKPXGraphics.h"
+#import "PixateFreestyle.h"
+
+#include <libxml/parser.h>
+
+#pragma mark - Attribute Decoding
+
+/**
+ *  A range of bytes in an attribute value. Ranges point into libxml2's buffers and are only valid during the start
+ *  element callback that produced them. begin is NULL when the attribute is absent
+ */
+typedef struct
+{
+    const char *begin;
+    const char *end;
+} STKPXSVGRange;
+
+static inline BOOL STKPXSVGRangeIsPresent(STKPXSVGRange range)
+{
+    return range.begin != NULL;
+}
+
+static inline BOOL STKPXSVGRangeEquals(STKPXSVGRange range, const char *text)
+{
+    size_t length = strlen(text);
+
+    return range.begin != NULL && (size_t) (range.end - range.begin) == length && memcmp(range.begin, text, length) == 0;
+}
+
+static inline BOOL STKPXSVGIsDigit(char c)
+{
+    return '0' <= c && c <= '9';
+}
+
+static inline BOOL STKPXSVGIsSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+static inline int STKPXSVGHexDigit(char c)
+{
+    if ('0' <= c && c <= '9') return c - '0';
+    if ('a' <= c && c <= 'f') return c - 'a' + 10;
+    if ('A' <= c && c <= 'F') return c - 'A' + 10;
+
+    return -1;
+}
+
+/**
+ *  Scan a decimal number ([sign] digits [. digits] [exponent]) at p. Returns the position following the number, or p
+ *  when there is no number there
+ */
+static const char *STKPXSVGScanNumber(const char *p, const char *end, BOOL allowExponent, double *result)
+{
+    const char *start = p;
+    BOOL negative = NO;
+    BOOL sawDigit = NO;
+    uint64_t mantissa = 0;
+    int significantDigits = 0;
+    int scale = 0;
+
+    if (p < end && (*p == '+' || *p == '-'))
+    {
+        negative = (*p == '-');
+        p++;
+    }
+
+    // integer part. Digits past what the mantissa can hold only shift the scale
+    for (; p < end && STKPXSVGIsDigit(*p); p++)
+    {
+        if (significantDigits < 18)
+        {
+            mantissa = mantissa * 10 + (*p - '0');
+            significantDigits += (mantissa != 0);
+        }
+        else
+        {
+            scale++;
+        }
+
+        sawDigit = YES;
+    }
+
+    // fraction
+    if (p < end && *p == '.')
+    {
+        for (p++; p < end && STKPXSVGIsDigit(*p); p++)
+        {
+            if (significantDigits < 18)
+            {
+                mantissa = mantissa * 10 + (*p - '0');
+                significantDigits += (mantissa != 0);
+                scale--;
+            }
+
+            sawDigit = YES;
+        }
+    }
+
+    if (!sawDigit)
+    {
+        *result = 0.0;
+        return start;
+    }
+
+    // exponent, only consumed when it has digits
+    if (allowExponent && p < end && (*p == 'e' || *p == 'E'))
+    {
+        const char *q = p + 1;
+        BOOL negativeExponent = NO;
+        BOOL sawExponentDigit = NO;
+        int exponent = 0;
+
+        if (q < end && (*q == '+' || *q == '-'))
+        {
+            negativeExponent = (*q == '-');
+            q++;
+        }
+
+        for (; q < end && STKPXSVGIsDigit(*q); q++)
+        {
+            exponent = MIN(exponent * 10 + (*q - '0'), 1000);
+            sawExponentDigit = YES;
+        }
+
+        if (sawExponentDigit)
+        {
+            scale += (negativeExponent) ? -exponent : exponent;
+            p = q;
+        }
+    }
+
+    double value = (double) mantissa;
+
+    if (scale > 0)
+    {
+        value *= pow(10.0, scale);
+    }
+    else if (scale < 0)
+    {
+        value /= pow(10.0, -scale);
+    }
+
+    *result = (negative) ? -value : value;
+
+    return p;
+}
+
+/**
+ *  Decode a number the way -[NSString floatValue] does: leading whitespace is skipped, trailing text is ignored and a
+ *  missing number is zero. Single precision, as with floatValue
+ */
+static float STKPXSVGFloatValue(STKPXSVGRange range)
+{
+    const char *p = range.begin;
+    double value = 0.0;
+
+    while (p < range.end && STKPXSVGIsSpace(*p))
+    {
+        p++;
+    }
+
+    STKPXSVGScanNumber(p, range.end, YES, &value);
+
+    return (float) value;
+}
+
+/**
+ *  Decode a number attribute, where a trailing % divides by 100. Absent attributes are zero
+ */
+static CGFloat STKPXSVGNumber(STKPXSVGRange range)
+{
+    CGFloat number = 0.0;
+
+    if (STKPXSVGRangeIsPresent(range))
+    {
+        number = STKPXSVGFloatValue(range);
+
+        if (range.end > range.begin && range.end[-1] == '%')
+        {
+            number = STKPXSVGFloatValue(range) / 100.0;
+        }
+    }
+
+    return number;
+}
+
+/**
+ *  Decode an opacity attribute. Absent attributes are fully opaque
+ */
+static CGFloat STKPXSVGOpacity(STKPXSVGRange range)
+{
+    return (STKPXSVGRangeIsPresent(range)) ? STKPXSVGFloatValue(range) : 1.0;
+}
+
+/**
+ *  Decode a list of numbers separated by spaces, line breaks and commas. Decoding stops at the first item that is not
+ *  a number
+ */
+static NSMutableArray *STKPXSVGNumberArray(STKPXSVGRange range)
+{
+    NSMutableArray *numbers = [NSMutableArray array];
+    const char *p = range.begin;
+
+    while (p < range.end)
+    {
+        double value;
+
+        while (p < range.end && (*p == ' ' || *p == '\r' || *p == '\n' || *p == ','))
+        {
+            p++;
+        }
+
+        const char *next = STKPXSVGScanNumber(p, range.end, YES, &value);
+
+        if (next == p)
+        {
+            break;
+        }
+
+        [numbers addObject:@((CGFloat) value)];
+        p = next;
+    }
+
+    return numbers;
+}
+
+/**
+ *  Decode a #rgb, #argb, #rrggbb or #aarrggbb color as +[UIColor colorWithHexString:withAlpha:] does. Returns NO for
+ *  any other form
+ */
+static BOOL STKPXSVGHexColor(STKPXSVGRange range, CGFloat alpha, uint *argb)
+{
+    const char *digits = range.begin + 1;
+    size_t count = range.end - digits;
+    uint value = 0;
+
+    if (count != 3 && count != 4 && count != 6 && count != 8)
+    {
+        return NO;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        int digit = STKPXSVGHexDigit(digits[i]);
+
+        if (digit < 0)
+        {
+            return NO;
+        }
+
+        // short forms repeat every digit
+        value = (count <= 4) ? (value << 8) | (uint) (digit * 0x11) : (value << 4) | (uint) digit;
+    }
+
+    // the four and eight digit forms carry their own alpha
+    if (count == 3 || count == 6)
+    {
+        alpha = MIN(MAX(0.0, alpha), 1.0);
+        value |= ((uint) (alpha * 255.0)) << 24;
+    }
+
+    *argb = value;
+
+    return YES;
+}
+
+/**
+ *  Decode a transform list made of plain numbers. Returns NO when the list uses anything else (units, exponents,
+ *  other functions), in which case it goes through STKPXTransformParser
+ */
+static BOOL STKPXSVGTransform(STKPXSVGRange range, CGAffineTransform *result)
+{
+    static const struct
+    {
+        const char *name;
+        int minArgs;
+        int maxArgs;
+    } FUNCTIONS[] = {
+        { "matrix", 6, 6 },
+        { "translate", 1, 2 },
+        { "scale", 1, 2 },
+        { "rotate", 1, 3 },
+        { "skewX", 1, 1 },
+        { "skewY", 1, 1 }
+    };
+    static const int FUNCTION_COUNT = sizeof(FUNCTIONS) / sizeof(FUNCTIONS[0]);
+
+    CGAffineTransform transform = CGAffineTransformIdentity;
+    const char *p = range.begin;
+
+    while (YES)
+    {
+        while (p < range.end && (STKPXSVGIsSpace(*p) || *p == ','))
+        {
+            p++;
+        }
+
+        if (p == range.end)
+        {
+            break;
+        }
+
+        // function name
+        const char *name = p;
+
+        while (p < range.end && (('a' <= *p && *p <= 'z') || ('A' <= *p && *p <= 'Z')))
+        {
+            p++;
+        }
+
+        int function = -1;
+
+        for (int i = 0; i < FUNCTION_COUNT; i++)
+        {
+            if (strlen(FUNCTIONS[i].name) == (size_t) (p - name) && memcmp(FUNCTIONS[i].name, name, p - name) == 0)
+            {
+                function = i;
+                break;
+            }
+        }
+
+        while (p < range.end && STKPXSVGIsSpace(*p))
+        {
+            p++;
+        }
+
+        if (function < 0 || p == range.end || *p != '(')
+        {
+            return NO;
+        }
+
+        // arguments
+        CGFloat args[6];
+        int argCount = 0;
+
+        for (p++; ; )
+        {
+            while (p < range.end && (STKPXSVGIsSpace(*p) || *p == ','))
+            {
+                p++;
+            }
+
+            if (p < range.end && *p == ')')
+            {
+                p++;
+                break;
+            }
+
+            double value;
+            const char *next = STKPXSVGScanNumber(p, range.end, NO, &value);
+
+            // units or exponents are left to the full parser
+            if (next == p || *p == '+' || argCount == 6 || (next < range.end && (('a' <= *next && *next <= 'z') || ('A' <= *next && *next <= 'Z') || *next == '%')))
+            {
+                return NO;
+            }
+
+            args[argCount++] = (float) value;
+            p = next;
+        }
+
+        if (argCount < FUNCTIONS[function].minArgs || argCount > FUNCTIONS[function].maxArgs || (function == 3 && argCount == 2))
+        {
+            return NO;
+        }
+
+        CGAffineTransform step;
+
+        switch (function)
+        {
+            case 0:
+                step = CGAffineTransformMake(args[0], args[1], args[2], args[3], args[4], args[5]);
+                break;
+
+            case 1:
+                step = CGAffineTransformMakeTranslation(args[0], (argCount == 2) ? args[1] : 0.0f);
+                break;
+
+            case 2:
+                step = CGAffineTransformMakeScale(args[0], (argCount == 2) ? args[1] : args[0]);
+                break;
+
+            case 3:
+                if (argCount == 3)
+                {
+                    step = CGAffineTransformMakeTranslation(args[1], args[2]);
+                    step = CGAffineTransformRotate(step, DEGREES_TO_RADIANS(args[0]));
+                    step = CGAffineTransformTranslate(step, -args[1], -args[2]);
+                }
+                else
+                {
+                    step = CGAffineTransformMakeRotation(DEGREES_TO_RADIANS(args[0]));
+                }
+                break;
+
+            case 4:
+                step = CGAffineTransformMake(1.0f, 0.0f, TAN(DEGREES_TO_RADIANS(args[0])), 1.0f, 0.0f, 0.0f);
+                break;
+
+            default:
+                step = CGAffineTransformMake(1.0f, TAN(DEGREES_TO_RADIANS(args[0])), 0.0f, 1.0f, 0.0f, 0.0f);
+                break;
+        }
+
+        // as in STKPXTransformParser, each transform applies before the ones preceding it
+        transform = CGAffineTransformConcat(step, transform);
+    }
+
+    *result = transform;
+
+    return YES;
+}
+
+#pragma mark - Element and Attribute Names
+
+typedef NS_ENUM(NSInteger, STKPXSVGElement)
+{
+    STKPXSVGElementUnknown = -1,
+    STKPXSVGElementSVG,
+    STKPXSVGElementG,
+    STKPXSVGElementPath,
+    STKPXSVGElementRect,
+    STKPXSVGElementLine,
+    STKPXSVGElementCircle,
+    STKPXSVGElementEllipse,
+    STKPXSVGElementLinearGradient,
+    STKPXSVGElementRadialGradient,
+    STKPXSVGElementStop,
+    STKPXSVGElementPolygon,
+    STKPXSVGElementPolyline,
+    STKPXSVGElementText,
+    STKPXSVGElementArc,
+    STKPXSVGElementPie,
+    STKPXSVGElementDesc,
+    STKPXSVGElementDefs,
+    STKPXSVGElementCount
+};
+
+static const char *ELEMENT_NAMES[STKPXSVGElementCount] = {
+    "svg", "g", "path", "rect", "line", "circle", "ellipse", "linearGradient", "radialGradient", "stop", "polygon",
+    "polyline", "text", "arc", "pie", "desc", "defs"
+};
+
+typedef NS_ENUM(NSInteger, STKPXSVGAttribute)
+{
+    STKPXSVGAttributeUnknown = -1,
+    STKPXSVGAttributeD,
+    STKPXSVGAttributeX,
+    STKPXSVGAttributeY,
+    STKPXSVGAttributeR,
+    STKPXSVGAttributeRX,
+    STKPXSVGAttributeRY,
+    STKPXSVGAttributeX1,
+    STKPXSVGAttributeY1,
+    STKPXSVGAttributeX2,
+    STKPXSVGAttributeY2,
+    STKPXSVGAttributeCX,
+    STKPXSVGAttributeCY,
+    STKPXSVGAttributeFX,
+    STKPXSVGAttributeFY,
+    STKPXSVGAttributeID,
+    STKPXSVGAttributeFill,
+    STKPXSVGAttributeWidth,
+    STKPXSVGAttributeHeight,
+    STKPXSVGAttributeStroke,
+    STKPXSVGAttributeOffset,
+    STKPXSVGAttributePoints,
+    STKPXSVGAttributeOpacity,
+    STKPXSVGAttributeViewBox,
+    STKPXSVGAttributeTransform,
+    STKPXSVGAttributeVisibility,
+    STKPXSVGAttributeStopColor,
+    STKPXSVGAttributeEndAngle,
+    STKPXSVGAttributeStartAngle,
+    STKPXSVGAttributeStrokeType,
+    STKPXSVGAttributeFillOpacity,
+    STKPXSVGAttributeStopOpacity,
+    STKPXSVGAttributeStrokeWidth,
+    STKPXSVGAttributeGradientUnits,
+    STKPXSVGAttributeStrokeOpacity,
+    STKPXSVGAttributeStrokeLinecap,
+    STKPXSVGAttributeStrokeLinejoin,
+    STKPXSVGAttributeStrokeDasharray,
+    STKPXSVGAttributeStrokeDashoffset,
+    STKPXSVGAttributeStrokeMiterlimit,
+    STKPXSVGAttributeGradientTransform,
+    STKPXSVGAttributePreserveAspectRatio,
+    STKPXSVGAttributeCount
+};
+
+static const char *ATTRIBUTE_NAMES[STKPXSVGAttributeCount] = {
+    "d", "x", "y", "r", "rx", "ry", "x1", "y1", "x2", "y2", "cx", "cy", "fx", "fy", "id", "fill", "width", "height",
+    "stroke", "offset", "points", "opacity", "viewBox", "transform", "visibility", "stop-color", "end-angle",
+    "start-angle", "stroke-type", "fill-opacity", "stop-opacity", "stroke-width", "gradientUnits", "stroke-opacity",
+    "stroke-linecap", "stroke-linejoin", "stroke-dasharray", "stroke-dashoffset", "stroke-miterlimit",
+    "gradientTransform", "preserveAspectRatio"
+};
+
+static NSInteger STKPXSVGNameIndex(const char **names, NSInteger count, const char *name, size_t length)
+{
+    for (NSInteger i = 0; i < count; i++)
+    {
+        if (names[i][0] == name[0] && strlen(names[i]) == length && memcmp(names[i], name, length) == 0)
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+#pragma mark - Loader
+
+static STKPXTransformParser *TRANSFORM_PARSER;
+static STKPXValueParser *VALUE_PARSER;
+static NSDictionary *ALIGN_TYPES;
+
+@implementation STKPXSVGStreamLoader
+{
+    STKPXShapeDocument *document_;
+    STKPXShapeGroup *result_;
+    NSMutableArray *stack_;
+    STKPXGradient *currentGradient_;
+    NSMutableDictionary *gradients_;
+    STKPXSVGRange attributes_[STKPXSVGAttributeCount];
+}
+
+#pragma mark - Static Methods
+
++ (void)initialize
+{
+    if (self == [STKPXSVGStreamLoader class])
+    {
+        TRANSFORM_PARSER = [[STKPXTransformParser alloc] init];
+        VALUE_PARSER = [[STKPXValueParser alloc] init];
+        ALIGN_TYPES = @{
+            @"none"     : @(kAlignViewPortNone),
+            @"xMinYMin" : @(kAlignViewPortXMinYMin),
+            @"xMinYMid" : @(kAlignViewPortXMinYMid),
+            @"xMinYMax" : @(kAlignViewPortXMinYMax),
+            @"xMidYMin" : @(kAlignViewPortXMidYMin),
+            @"xMidYMid" : @(kAlignViewPortXMidYMid),
+            @"xMidYMax" : @(kAlignViewPortXMidYMax),
+            @"xMaxYMin" : @(kAlignViewPortXMaxYMin),
+            @"xMaxYMid" : @(kAlignViewPortXMaxYMid),
+            @"xMaxYMax" : @(kAlignViewPortXMaxYMax)
+        };
+    }
+}
+
++ (STKPXShapeDocument *)loadFromURL:(NSURL *)URL
+{
+    STKPXSVGStreamLoader *loader = [[STKPXSVGStreamLoader alloc] init];
+
+    loader.URL = URL;
+
+    return [loader loadData:[NSData dataWithContentsOfURL:URL]];
+}
+
++ (STKPXShapeDocument *)loadFromData:(NSData *)data
+{
+    return [[[STKPXSVGStreamLoader alloc] init] loadData:data];
+}
+
+#pragma mark - Initializers
+
+- (instancetype)init
+{
+    if (self = [super init])
+    {
+        document_ = [[STKPXShapeDocument alloc] init];
+        stack_ = [[NSMutableArray alloc] init];
+        gradients_ = [[NSMutableDictionary alloc] init];
+    }
+
+    return self;
+}
+
+#pragma mark - SAX Callbacks
+
+static void STKPXSVGStartElement(void *context,
+                                 const xmlChar *localname,
+                                 const xmlChar *prefix,
+                                 const xmlChar *URI,
+                                 int namespaceCount,
+                                 const xmlChar **namespaces,
+                                 int attributeCount,
+                                 int defaultedCount,
+                                 const xmlChar **attributes)
+{
+    STKPXSVGStreamLoader *loader = (__bridge STKPXSVGStreamLoader *) context;
+
+    [loader startElement:(const char *) localname
+                  prefix:(const char *) prefix
+              attributes:(const char **) attributes
+                   count:attributeCount];
+}
+
+static void STKPXSVGEndElement(void *context, const xmlChar *localname, const xmlChar *prefix, const xmlChar *URI)
+{
+    STKPXSVGStreamLoader *loader = (__bridge STKPXSVGStreamLoader *) context;
+
+    // prefixed elements were reported as unsupported when they started
+    if (prefix == NULL)
+    {
+        [loader endElement:(const char *) localname];
+    }
+}
+
+#pragma mark - Parsing Methods
+
+- (STKPXShapeDocument *)loadData:(NSData *)data
+{
+    if (data.length > 0 && data.length <= INT_MAX)
+    {
+        static dispatch_once_t onceToken;
+
+        // libxml2 sets up its global state lazily, which is not thread-safe. Documents may be loaded from any thread
+        dispatch_once(&onceToken, ^{
+            xmlInitParser();
+        });
+
+        xmlSAXHandler handler;
+
+        memset(&handler, 0, sizeof(handler));
+        handler.initialized = XML_SAX2_MAGIC;
+        handler.startElementNs = STKPXSVGStartElement;
+        handler.endElementNs = STKPXSVGEndElement;
+
+        // like NSXMLParser, a malformed document keeps whatever was built before the error
+        xmlSAXUserParseMemory(&handler, (__bridge void *) self, data.bytes, (int) data.length);
+    }
+
+    document_.shape = result_;
+
+    return document_;
+}
+
+- (void)startElement:(const char *)name prefix:(const char *)prefix attributes:(const char **)attributes count:(int)count
+{
+    STKPXSVGElement element = (prefix == NULL)
+        ? STKPXSVGNameIndex(ELEMENT_NAMES, STKPXSVGElementCount, name, strlen(name))
+        : STKPXSVGElementUnknown;
+
+    if (element == STKPXSVGElementUnknown)
+    {
+        NSString *elementName = (prefix)
+            ? [NSString stringWithFormat:@"%s:%s", prefix, name]
+            : @(name);
+
+        [self logErrorMessageWithFormat:@"An error was encountered while loading '%@'\n  Unsupported element type: '%@'", self.URL, elementName];
+
+        return;
+    }
+
+    [self collectAttributes:attributes count:count];
+
+    switch (element)
+    {
+        case STKPXSVGElementSVG:            [self startSVGElement]; break;
+        case STKPXSVGElementG:              [self startGElement]; break;
+        case STKPXSVGElementPath:           [self startPathElement]; break;
+        case STKPXSVGElementRect:           [self startRectElement]; break;
+        case STKPXSVGElementLine:           [self startLineElement]; break;
+        case STKPXSVGElementCircle:         [self startCircleElement]; break;
+        case STKPXSVGElementEllipse:        [self startEllipseElement]; break;
+        case STKPXSVGElementLinearGradient: [self startLinearGradientElement]; break;
+        case STKPXSVGElementRadialGradient: [self startRadialGradientElement]; break;
+        case STKPXSVGElementStop:           [self startStopElement]; break;
+        case STKPXSVGElementPolygon:        [self startPolygonElement:YES]; break;
+        case STKPXSVGElementPolyline:       [self startPolygonElement:NO]; break;
+        case STKPXSVGElementArc:            [self startArcElement]; break;
+        case STKPXSVGElementPie:            [self startPieElement]; break;
+
+        default:
+            // desc, defs and text aren't implemented but they are so common, we accept them to prevent warnings
+            break;
+    }
+}
+
+- (void)endElement:(const char *)name
+{
+    switch (STKPXSVGNameIndex(ELEMENT_NAMES, STKPXSVGElementCount, name, strlen(name)))
+    {
+        case STKPXSVGElementSVG:
+            result_ = stack_.firstObject;
+
+            if (stack_.count > 0)
+            {
+                [stack_ removeObjectAtIndex:0];
+            }
+            break;
+
+        case STKPXSVGElementG:
+            [stack_ removeLastObject];
+            break;
+
+        case STKPXSVGElementLinearGradient:
+        case STKPXSVGElementRadialGradient:
+            currentGradient_ = nil;
+            break;
+
+        default:
+            break;
+    }
+}
+
+- (void)collectAttributes:(const char **)attributes count:(int)count
+{
+    STKPXSVGRange style = { NULL, NULL };
+
+    memset(attributes_, 0, sizeof(attributes_));
+
+    // SAX2 reports each attribute as localname, prefix, URI, value and value end
+    for (int i = 0; i < count; i++)
+    {
+        const char **attribute = &attributes[i * 5];
+
+        if (attribute[1] != NULL)
+        {
+            continue;
+        }
+
+        STKPXSVGRange value = { attribute[3], attribute[4] };
+
+        if (strcmp(attribute[0], "style") == 0)
+        {
+            style = value;
+        }
+        else
+        {
+            NSInteger index = STKPXSVGNameIndex(ATTRIBUTE_NAMES, STKPXSVGAttributeCount, attribute[0], strlen(attribute[0]));
+
+            if (index >= 0)
+            {
+                attributes_[index] = value;
+            }
+        }
+    }
+
+    // style declarations override attributes. Only declarations with exactly one colon count
+    const char *p = style.begin;
+
+    while (p < style.end)
+    {
+        const char *declarationEnd = memchr(p, ';', style.end - p) ?: style.end;
+        const char *colon = memchr(p, ':', declarationEnd - p);
+
+        if (colon && memchr(colon + 1, ':', declarationEnd - colon - 1) == NULL)
+        {
+            STKPXSVGRange name = [self trimmedRangeFrom:p to:colon];
+            STKPXSVGRange value = [self trimmedRangeFrom:colon + 1 to:declarationEnd];
+            NSInteger index = STKPXSVGNameIndex(ATTRIBUTE_NAMES, STKPXSVGAttributeCount, name.begin, name.end - name.begin);
+
+            if (name.end > name.begin && index >= 0)
+            {
+                attributes_[index] = value;
+            }
+        }
+
+        p = declarationEnd + 1;
+    }
+}
+
+- (STKPXSVGRange)trimmedRangeFrom:(const char *)begin to:(const char *)end
+{
+    // matches NSCharacterSet's whitespaceCharacterSet, which doesn't include line breaks
+    while (begin < end && (*begin == ' ' || *begin == '\t'))
+    {
+        begin++;
+    }
+
+    while (end > begin && (end[-1] == ' ' || end[-1] == '\t'))
+    {
+        end--;
+    }
+
+    return (STKPXSVGRange) { begin, end };
+}
+
+#pragma mark - Start Handlers
+
+- (void)startSVGElement
+{
+    STKPXShapeGroup *newGroup = [[STKPXShapeGroup alloc] init];
+    STKPXSVGRange viewBox = attributes_[STKPXSVGAttributeViewBox];
+    CGFloat x = 0.0;
+    CGFloat y = 0.0;
+    CGFloat width;
+    CGFloat height;
+
+    // the viewBox is used when it is four items separated by single spaces
+    const char *separators[3];
+    int separatorCount = 0;
+
+    for (const char *p = viewBox.begin; p < viewBox.end; p++)
+    {
+        if (*p == ' ')
+        {
+            if (separatorCount < 3)
+            {
+                separators[separatorCount] = p;
+            }
+
+            separatorCount++;
+        }
+    }
+
+    if (separatorCount == 3)
+    {
+        x = STKPXSVGFloatValue((STKPXSVGRange) { viewBox.begin, separators[0] });
+        y = STKPXSVGFloatValue((STKPXSVGRange) { separators[0] + 1, separators[1] });
+        width = STKPXSVGFloatValue((STKPXSVGRange) { separators[1] + 1, separators[2] });
+        height = STKPXSVGFloatValue((STKPXSVGRange) { separators[2] + 1, viewBox.end });
+    }
+    else
+    {
+        // default to specified width and height. X and Y will be zero in this case
+        width = STKPXSVGNumber(attributes_[STKPXSVGAttributeWidth]);
+        height = STKPXSVGNumber(attributes_[STKPXSVGAttributeHeight]);
+    }
+
+    newGroup.viewport = CGRectMake(x, y, width, height);
+
+    [self applyViewportToGroup:newGroup];
+
+    // create top-level group
+    [stack_ addObject:newGroup];
+}
+
+- (void)startGElement
+{
+    STKPXShapeGroup *newGroup = [[STKPXShapeGroup alloc] init];
+    NSString *ident = [self stringForAttribute:STKPXSVGAttributeID];
+
+    newGroup.opacity = STKPXSVGOpacity(attributes_[STKPXSVGAttributeOpacity]);
+
+    if (ident)
+    {
+        [document_ addShape:newGroup forName:ident];
+    }
+
+    newGroup.transform = [self transformForAttribute:STKPXSVGAttributeTransform];
+
+    [self applyViewportToGroup:newGroup];
+    [self addShape:newGroup];
+
+    // push new group as active group
+    [stack_ addObject:newGroup];
+}
+
+- (void)startPathElement
+{
+    NSString *d = [self stringForAttribute:STKPXSVGAttributeD];
+
+    if (d)
+    {
+        STKPXPath *path = [STKPXPath createPathFromPathData:d];
+
+        [self applyStylesToShape:path];
+        [self addShape:path];
+    }
+}
+
+- (void)startRectElement
+{
+    CGFloat x = STKPXSVGNumber(attributes_[STKPXSVGAttributeX]);
+    CGFloat y = STKPXSVGNumber(attributes_[STKPXSVGAttributeY]);
+    CGFloat width = STKPXSVGNumber(attributes_[STKPXSVGAttributeWidth]);
+    CGFloat height = STKPXSVGNumber(attributes_[STKPXSVGAttributeHeight]);
+    CGFloat rx = STKPXSVGNumber(attributes_[STKPXSVGAttributeRX]);
+    CGFloat ry = STKPXSVGNumber(attributes_[STKPXSVGAttributeRY]);
+
+    STKPXRectangle *rectangle = [[STKPXRectangle alloc] initWithRect:CGRectMake(x, y, width, height)];
+    rectangle.cornerRadii = CGSizeMake(rx, ry);
+
+    [self applyStylesToShape:rectangle];
+    [self addShape:rectangle];
+}
+
+- (void)startLineElement
+{
+    STKPXLine *line = [[STKPXLine alloc] initX1:STKPXSVGNumber(attributes_[STKPXSVGAttributeX1])
+                                             y1:STKPXSVGNumber(attributes_[STKPXSVGAttributeY1])
+                                             x2:STKPXSVGNumber(attributes_[STKPXSVGAttributeX2])
+                                             y2:STKPXSVGNumber(attributes_[STKPXSVGAttributeY2])];
+
+    [self applyStylesToShape:line];
+    [self addShape:line];
+}
+
+- (void)startCircleElement
+{
+    CGPoint center = CGPointMake(STKPXSVGNumber(attributes_[STKPXSVGAttributeCX]), STKPXSVGNumber(attributes_[STKPXSVGAttributeCY]));
+    STKPXCircle *circle = [[STKPXCircle alloc] initCenter:center radius:STKPXSVGNumber(attributes_[STKPXSVGAttributeR])];
+
+    [self applyStylesToShape:circle];
+    [self addShape:circle];
+}
+
+- (void)startEllipseElement
+{
+    CGPoint center = CGPointMake(STKPXSVGNumber(attributes_[STKPXSVGAttributeCX]), STKPXSVGNumber(attributes_[STKPXSVGAttributeCY]));
+    STKPXEllipse *ellipse = [[STKPXEllipse alloc] initCenter:center
+                                                     radiusX:STKPXSVGNumber(attributes_[STKPXSVGAttributeRX])
+                                                     radiusY:STKPXSVGNumber(attributes_[STKPXSVGAttributeRY])];
+
+    [self applyStylesToShape:ellipse];
+    [self addShape:ellipse];
+}
+
+- (void)startLinearGradientElement
+{
+    NSString *name = [self stringForAttribute:STKPXSVGAttributeID];
+
+    if (name)
+    {
+        STKPXLinearGradient *gradient = [[STKPXLinearGradient alloc] init];
+
+        gradient.p1 = CGPointMake(STKPXSVGNumber(attributes_[STKPXSVGAttributeX1]), STKPXSVGNumber(attributes_[STKPXSVGAttributeY1]));
+        gradient.p2 = CGPointMake(STKPXSVGNumber(attributes_[STKPXSVGAttributeX2]), STKPXSVGNumber(attributes_[STKPXSVGAttributeY2]));
+
+        [self startGradient:gradient withName:name];
+    }
+    else
+    {
+        [self logErrorMessageWithFormat:@"Skipping unnamed linear gradient"];
+    }
+}
+
+- (void)startRadialGradientElement
+{
+    NSString *name = [self stringForAttribute:STKPXSVGAttributeID];
+
+    if (name)
+    {
+        STKPXRadialGradient *gradient = [[STKPXRadialGradient alloc] init];
+
+        gradient.endCenter = CGPointMake(STKPXSVGNumber(attributes_[STKPXSVGAttributeCX]), STKPXSVGNumber(attributes_[STKPXSVGAttributeCY]));
+        gradient.radius = STKPXSVGNumber(attributes_[STKPXSVGAttributeR]);
+
+        if (STKPXSVGRangeIsPresent(attributes_[STKPXSVGAttributeFX]) && STKPXSVGRangeIsPresent(attributes_[STKPXSVGAttributeFY]))
+        {
+            gradient.startCenter = CGPointMake(STKPXSVGNumber(attributes_[STKPXSVGAttributeFX]), STKPXSVGNumber(attributes_[STKPXSVGAttributeFY]));
+        }
+        else
+        {
+            gradient.startCenter = gradient.endCenter;
+        }
+
+        [self startGradient:gradient withName:name];
+    }
+    else
+    {
+        [self logErrorMessageWithFormat:@"Skipping unnamed radial gradient"];
+    }
+}
+
+- (void)startGradient:(STKPXGradient *)gradient withName:(NSString *)name
+{
+    gradient.transform = [self transformForAttribute:STKPXSVGAttributeGradientTransform];
+
+    // assume all non-valid values in addition to "objectBoundingBox" mean bounding box
+    gradient.gradientUnits = (STKPXSVGRangeEquals(attributes_[STKPXSVGAttributeGradientUnits], "userSpaceOnUse"))
+        ? STKPXGradientUnitsUserSpace
+        : STKPXGradientUnitsBoundingBox;
+
+    currentGradient_ = gradient;
+    gradients_[name] = gradient;
+}
+
+- (void)startStopElement
+{
+    if (currentGradient_)
+    {
+        STKPXSVGRange stopColor = attributes_[STKPXSVGAttributeStopColor];
+
+        if (STKPXSVGRangeIsPresent(stopColor))
+        {
+            UIColor *color = [self colorFromRange:stopColor];
+            STKPXSVGRange stopOpacity = attributes_[STKPXSVGAttributeStopOpacity];
+
+            if (STKPXSVGRangeIsPresent(stopOpacity) && color != nil)
+            {
+                color = [color colorWithAlphaComponent:STKPXSVGNumber(stopOpacity)];
+            }
+
+            [currentGradient_ addColor:color withOffset:STKPXSVGNumber(attributes_[STKPXSVGAttributeOffset])];
+        }
+        else
+        {
+            [self logErrorMessageWithFormat:@"Stop element is missing a stop-color"];
+        }
+    }
+    else
+    {
+        [self logErrorMessageWithFormat:@"Skipping stop element since it is not contained within a gradient element"];
+    }
+}
+
+- (void)startPolygonElement:(BOOL)closed
+{
+    NSMutableArray *coords = STKPXSVGNumberArray(attributes_[STKPXSVGAttributePoints]);
+    NSUInteger length = coords.count & ~1UL;
+    NSMutableArray *points = [NSMutableArray arrayWithCapacity:length / 2];
+
+    for (NSUInteger i = 0; i < length; i += 2)
+    {
+        CGPoint point = CGPointMake([coords[i] floatValue], [coords[i + 1] floatValue]);
+
+        [points addObject:[NSValue valueWithCGPoint:point]];
+    }
+
+    STKPXPolygon *polygon = [[STKPXPolygon alloc] initWithPoints:points];
+
+    polygon.closed = closed;
+
+    [self applyStylesToShape:polygon];
+    [self addShape:polygon];
+}
+
+- (void)startArcElement
+{
+    STKPXArc *arc = [[STKPXArc alloc] init];
+
+    [self applyArcAttributes:arc];
+    [self applyStylesToShape:arc];
+    [self addShape:arc];
+}
+
+- (void)startPieElement
+{
+    STKPXPie *pie = [[STKPXPie alloc] init];
+
+    [self applyArcAttributes:pie];
+    [self applyStylesToShape:pie];
+    [self addShape:pie];
+}
+
+#pragma mark - Supporting Methods
+
+- (void)addShape:(STKPXShape *)shape
+{
+    [(STKPXShapeGroup *) stack_.lastObject addShape:shape];
+}
+
+- (void)applyArcAttributes:(STKPXArc *)arc
+{
+    arc.center = CGPointMake(STKPXSVGNumber(attributes_[STKPXSVGAttributeCX]), STKPXSVGNumber(attributes_[STKPXSVGAttributeCY]));
+    arc.radius = STKPXSVGNumber(attributes_[STKPXSVGAttributeR]);
+    arc.startingAngle = STKPXSVGNumber(attributes_[STKPXSVGAttributeStartAngle]);
+    arc.endingAngle = STKPXSVGNumber(attributes_[STKPXSVGAttributeEndAngle]);
+}
+
+- (void)applyStylesToShape:(STKPXShape *)shape
+{
+    static const char BLACK[] = "#000000";
+
+    shape.opacity = STKPXSVGOpacity(attributes_[STKPXSVGAttributeOpacity]);
+
+    // fill
+    STKPXSVGRange fill = attributes_[STKPXSVGAttributeFill];
+
+    if (!STKPXSVGRangeIsPresent(fill))
+    {
+        fill = (STKPXSVGRange) { BLACK, BLACK + sizeof(BLACK) - 1 };
+    }
+
+    shape.fill = [self paintFromRange:fill opacity:attributes_[STKPXSVGAttributeFillOpacity]];
+
+    // stroke. A stroke without a paint or width never draws, so skip it
+    id<STKPXPaint> strokePaint = [self paintFromRange:attributes_[STKPXSVGAttributeStroke]
+                                              opacity:attributes_[STKPXSVGAttributeStrokeOpacity]];
+    CGFloat strokeWidth = STKPXSVGNumber(attributes_[STKPXSVGAttributeStrokeWidth]);
+
+    if (strokePaint && strokeWidth > 0.0)
+    {
+        STKPXStroke *stroke = [[STKPXStroke alloc] init];
+        STKPXSVGRange strokeType = attributes_[STKPXSVGAttributeStrokeType];
+        STKPXSVGRange dashArray = attributes_[STKPXSVGAttributeStrokeDasharray];
+        STKPXSVGRange miterLimit = attributes_[STKPXSVGAttributeStrokeMiterlimit];
+
+        if (STKPXSVGRangeEquals(strokeType, "inner"))
+        {
+            stroke.type = kStrokeTypeInner;
+        }
+        else if (STKPXSVGRangeEquals(strokeType, "outer"))
+        {
+            stroke.type = kStrokeTypeOuter;
+        }
+
+        stroke.color = strokePaint;
+        stroke.width = strokeWidth;
+
+        if (STKPXSVGRangeIsPresent(dashArray))
+        {
+            stroke.dashArray = STKPXSVGNumberArray(dashArray);
+        }
+
+        stroke.dashOffset = STKPXSVGNumber(attributes_[STKPXSVGAttributeStrokeDashoffset]);
+        stroke.lineCap = [self lineCapForAttribute:STKPXSVGAttributeStrokeLinecap];
+        stroke.lineJoin = [self lineJoinForAttribute:STKPXSVGAttributeStrokeLinejoin];
+        stroke.miterLimit = (STKPXSVGRangeIsPresent(miterLimit)) ? STKPXSVGNumber(miterLimit) : 4.0f;
+
+        shape.stroke = stroke;
+    }
+
+    // visibility
+    STKPXSVGRange visibility = attributes_[STKPXSVGAttributeVisibility];
+
+    if (STKPXSVGRangeIsPresent(visibility))
+    {
+        shape.visible = STKPXSVGRangeEquals(visibility, "visible");
+    }
+
+    // id
+    NSString *ident = [self stringForAttribute:STKPXSVGAttributeID];
+
+    if (ident)
+    {
+        [document_ addShape:shape forName:ident];
+    }
+
+    shape.transform = [self transformForAttribute:STKPXSVGAttributeTransform];
+}
+
+- (void)applyViewportToGroup:(STKPXShapeGroup *)group
+{
+    NSString *par = [self stringForAttribute:STKPXSVGAttributePreserveAspectRatio];
+
+    if (par)
+    {
+        NSArray *parts = [par componentsSeparatedByString:@" "];
+        NSUInteger partCount = parts.count;
+        AlignViewPortType alignment = kAlignViewPortXMidYMid;
+        CropType crop = kCropTypeMeet;
+
+        if (1 <= partCount && partCount <= 2)
+        {
+            NSNumber *typeNumber = ALIGN_TYPES[parts[0]];
+
+            if (typeNumber)
+            {
+                alignment = typeNumber.intValue;
+            }
+            else
+            {
+                [self logErrorMessageWithFormat:@"Unrecognized aspect ratio crop setting: %@", parts[0]];
+            }
+
+            if (partCount == 2)
+            {
+                if ([@"meet" isEqualToString:parts[1]])
+                {
+                    crop = kCropTypeMeet;
+                }
+                else if ([@"slice" isEqualToString:parts[1]])
+                {
+                    crop = kCropTypeSlice;
+                }
+                else
+                {
+                    [self logErrorMessageWithFormat:@"Unrecognized crop type: %@", parts[1]];
+                }
+            }
+        }
+        else
+        {
+            [self logErrorMessageWithFormat:@"Unrecognized preserveAspectRatio value: %@", par];
+        }
+
+        group.viewportAlignment = alignment;
+        group.viewportCrop = crop;
+    }
+}
+
+- (CGLineCap)lineCapForAttribute:(STKPXSVGAttribute)attribute
+{
+    STKPXSVGRange value = attributes_[attribute];
+
+    if (!STKPXSVGRangeIsPresent(value) || STKPXSVGRangeEquals(value, "butt"))
+    {
+        return kCGLineCapButt;
+    }
+    else if (STKPXSVGRangeEquals(value, "round"))
+    {
+        return kCGLineCapRound;
+    }
+    else if (STKPXSVGRangeEquals(value, "square"))
+    {
+        return kCGLineCapSquare;
+    }
+
+    [self logErrorMessageWithFormat:@"Unrecognized line cap: %@", [self stringForAttribute:attribute]];
+
+    return kCGLineCapButt;
+}
+
+- (CGLineJoin)lineJoinForAttribute:(STKPXSVGAttribute)attribute
+{
+    STKPXSVGRange value = attributes_[attribute];
+
+    if (!STKPXSVGRangeIsPresent(value) || STKPXSVGRangeEquals(value, "miter"))
+    {
+        return kCGLineJoinMiter;
+    }
+    else if (STKPXSVGRangeEquals(value, "round"))
+    {
+        return kCGLineJoinRound;
+    }
+    else if (STKPXSVGRangeEquals(value, "bevel"))
+    {
+        return kCGLineJoinBevel;
+    }
+
+    [self logErrorMessageWithFormat:@"Unrecognized line join: %@", [self stringForAttribute:attribute]];
+
+    return kCGLineJoinMiter;
+}
+
+- (id<STKPXPaint>)paintFromRange:(STKPXSVGRange)value opacity:(STKPXSVGRange)opacity
+{
+    id<STKPXPaint> paint = nil;
+
+    if (STKPXSVGRangeIsPresent(value))
+    {
+        uint argb;
+
+        if (STKPXSVGRangeEquals(value, "none"))
+        {
+            paint = [[STKPXSolidPaint alloc] initWithColor:[UIColor clearColor]];
+        }
+        else if (value.end > value.begin && value.begin[0] == '#')
+        {
+            UIColor *color = (STKPXSVGHexColor(value, STKPXSVGOpacity(opacity), &argb))
+                ? [UIColor colorWithARGBValue:argb]
+                : [UIColor colorWithHexString:[self stringFromRange:value] withAlpha:STKPXSVGOpacity(opacity)];
+
+            paint = [[STKPXSolidPaint alloc] initWithColor:color];
+        }
+        else if (value.end - value.begin >= 5 && memcmp(value.begin, "url(#", 5) == 0)
+        {
+            // the name runs up to, but not including, the last character
+            NSString *name = [self stringFromRange:(STKPXSVGRange) { value.begin + 5, MAX(value.end - 1, value.begin + 5) }];
+
+            paint = gradients_[name];
+        }
+        else
+        {
+            paint = [VALUE_PARSER parsePaint:[STKPXValueParser lexemesForSource:[self stringFromRange:value]]];
+        }
+    }
+
+    return paint;
+}
+
+- (UIColor *)colorFromRange:(STKPXSVGRange)value
+{
+    uint argb;
+
+    if (value.end > value.begin && value.begin[0] == '#' && STKPXSVGHexColor(value, 1.0, &argb))
+    {
+        return [UIColor colorWithARGBValue:argb];
+    }
+
+    return [VALUE_PARSER parseColor:[STKPXValueParser lexemesForSource:[self stringFromRange:value]]];
+}
+
+- (CGAffineTransform)transformForAttribute:(STKPXSVGAttribute)attribute
+{
+    STKPXSVGRange value = attributes_[attribute];
+    CGAffineTransform transform = CGAffineTransformIdentity;
+
+    if (STKPXSVGRangeIsPresent(value) && !STKPXSVGTransform(value, &transform))
+    {
+        transform = [TRANSFORM_PARSER parse:[self stringFromRange:value]];
+    }
+
+    return transform;
+}
+
+- (NSString *)stringForAttribute:(STKPXSVGAttribute)attribute
+{
+    return [self stringFromRange:attributes_[attribute]];
+}
+
+- (NSString *)stringFromRange:(STKPXSVGRange)range
+{
+    return (STKPXSVGRangeIsPresent(range))
+        ? [[NSString alloc] initWithBytes:range.begin length:range.end - range.begin encoding:NSUTF8StringEncoding]
+        : nil;
+}
+
+- (void)logErrorMessageWithFormat:(NSString *)format, ...
+{
+    va_list args;
+
+    if (format)
+    {
+        va_start(args, format);
+
+        NSString *message = [[NSString alloc] initWithFormat:format arguments:args];
+
+        [PixateFreestyle.configuration sendParseMessage:message];
+
+        va_end(args);
+    }
+}
+
+@end
@@ -21,6 +21,11 @@
 //  Copyright (c) 2012 Pixate, Inc. All rights reserved.
 //
 
+// backends
+#import "STKPXCoreGraphicsBackend.h"
+#import "STKPXRasterBackend.h"
+#import "STKPXRenderBackend.h"
+
 // categories
 #import "UIColor+STKPXColors.h"
 
@@ -34,11 +39,13 @@
 #import "STKPXLinearGradient.h"
 #import "STKPXPaint.h"
 #import "STKPXPaintGroup.h"
+#import "STKPXPaintPool.h"
 #import "STKPXRadialGradient.h"
 #import "STKPXSolidPaint.h"
 
 // parsing
 #import "STKPXSVGLoader.h"
+#import "STKPXSVGStreamLoader.h"
 
 // shadows
 #import "STKPXShadow.h"
@@ -49,10 +56,12 @@
 #import "STKPXArc.h"
 #import "STKPXBoundable.h"
 #import "STKPXCircle.h"
+#import "STKPXDisplayList.h"
 #import "STKPXEllipse.h"
 #import "STKPXLine.h"
 #import "STKPXPaintable.h"
 #import "STKPXPath.h"
+#import "STKPXPathCache.h"
 #import "STKPXPie.h"
 #import "STKPXPolygon.h"
 #import "STKPXRectangle.h"
@@ -190,4 +190,15 @@
     return resultPath;
 }
 
+#pragma mark - NSCopying
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    STKPXArrowRectangle *result = [super copyWithZone:zone];
+
+    result.direction = _direction;
+
+    return result;
+}
+
 @end
@@ -24,6 +24,7 @@
 //
 
 #import "STKPXCircle.h"
+#import "STKPXPathCache.h"
 
 @implementation STKPXCircle
 
@@ -85,16 +86,10 @@
 
 - (CGPathRef)newPath
 {
-    CGMutablePathRef path = CGPathCreateMutable();
     CGFloat diameter = self.radius * 2.0f;
     CGRect rect = CGRectMake(self.center.x - self.radius, self.center.y - self.radius, diameter, diameter);
 
-    CGPathAddEllipseInRect(path, NULL, rect);
-
-    CGPathRef resultPath = CGPathCreateCopy(path);
-    CGPathRelease(path);
-
-    return resultPath;
+    return [[STKPXPathCache sharedInstance] newEllipsePathInRect:rect];
 }
 
 @end
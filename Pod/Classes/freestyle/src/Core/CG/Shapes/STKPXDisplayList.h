@@ -0,0 +1,67 @@
+/****************************************************************************
+ *
+ * Copyright 2015-present StylingKit Development Team. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ****************************************************************************/
+
+//
+//  STKPXDisplayList.h
+//  StylingKit
+//
+
+#import <UIKit/UIKit.h>
+#import "STKPXRenderable.h"
+
+/**
+ *  STKPXDisplayList is a flattened, linear form of a tree of STKPXRenderables. Compiling a tree resolves each shape's
+ *  path, paints, stroke and shadow, pre-multiplies the shape, group and viewport transforms down the tree, and culls
+ *  invisible and fully transparent subtrees. Graphics state is only saved where a clip or transparency layer needs it,
+ *  or where consecutive shapes are drawn with different transforms.
+ *
+ *  A display list references the paths and paints of the shapes it was compiled from, so it has to be recompiled when
+ *  the tree's structure, transforms or bounds change. Renderables that draw themselves in a custom way are recorded as
+ *  a single operation that calls back into them.
+ */
+@interface STKPXDisplayList : NSObject
+
+/**
+ *  The number of operations in this display list
+ */
+@property (nonatomic, readonly) NSUInteger operationCount;
+
+/**
+ *  The number of shapes, counting their descendants, left out of this display list because they would not draw
+ */
+@property (nonatomic, readonly) NSUInteger culledCount;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ *  Compile the specified renderable and its descendants
+ *
+ *  @param renderable The root of the tree to compile
+ *  @param transform A transform applied before the root's own transform
+ */
+- (instancetype)initWithRenderable:(id<STKPXRenderable>)renderable
+                         transform:(CGAffineTransform)transform NS_DESIGNATED_INITIALIZER;
+
+/**
+ *  Draw the contents of this display list with the specified backend
+ *
+ *  @param backend The backend to render with
+ */
+- (void)replayWithBackend:(id<STKPXRenderBackend>)backend;
+
+@end
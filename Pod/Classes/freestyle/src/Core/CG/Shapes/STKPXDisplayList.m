@@ -0,0 +1,334 @@
+/****************************************************************************
+ *
+ * Copyright 2015-present StylingKit Development Team. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ****************************************************************************/
+
+//
+//  STKPXDisplayList.m
+//  StylingKit
+//
+
+#import "STKPXDisplayList.h"
+#import "STKPXShape.h"
+#import "STKPXShapeGroup.h"
+
+typedef NS_ENUM(NSUInteger, STKPXDisplayOperationType)
+{
+    STKPXDisplayOperationDraw,
+    STKPXDisplayOperationRender,
+    STKPXDisplayOperationPushScope,
+    STKPXDisplayOperationPopScope
+};
+
+/**
+ *  A single display list operation. Transforms are relative to the enclosing scope. The paths and objects an operation
+ *  refers to are retained by the display list's objects_ array
+ */
+typedef struct
+{
+    STKPXDisplayOperationType type;
+    CGAffineTransform transform;
+    CGPathRef path;
+    BOOL transparencyLayer;
+    CGFloat opacity;
+    __unsafe_unretained id<STKPXPaint> fill;
+    __unsafe_unretained id<STKPXStrokeRenderer> stroke;
+    __unsafe_unretained id<STKPXShadowPaint> shadow;
+    __unsafe_unretained id<STKPXRenderable> renderable;
+} STKPXDisplayOperation;
+
+@interface STKPXShape (STKPXDisplayList)
+- (BOOL)needsTransparencyLayer;
+@end
+
+static IMP SHAPE_RENDER;
+static IMP SHAPE_RENDER_CHILDREN;
+static IMP GROUP_RENDER_CHILDREN;
+
+@implementation STKPXDisplayList
+{
+    NSMutableData *operations_;
+    NSMutableArray *objects_;
+}
+
+#pragma mark - Static Methods
+
++ (void)initialize
+{
+    if (self == [STKPXDisplayList class])
+    {
+        SHAPE_RENDER = [STKPXShape instanceMethodForSelector:@selector(renderWithBackend:)];
+        SHAPE_RENDER_CHILDREN = [STKPXShape instanceMethodForSelector:@selector(renderChildrenWithBackend:)];
+        GROUP_RENDER_CHILDREN = [STKPXShapeGroup instanceMethodForSelector:@selector(renderChildrenWithBackend:)];
+    }
+}
+
+#pragma mark - Initializers
+
+- (instancetype)initWithRenderable:(id<STKPXRenderable>)renderable transform:(CGAffineTransform)transform
+{
+    if (self = [super init])
+    {
+        operations_ = [[NSMutableData alloc] init];
+        objects_ = [[NSMutableArray alloc] init];
+
+        if (renderable)
+        {
+            [self compileRenderable:renderable transform:transform];
+        }
+    }
+
+    return self;
+}
+
+#pragma mark - Getters
+
+- (NSUInteger)operationCount
+{
+    return operations_.length / sizeof(STKPXDisplayOperation);
+}
+
+#pragma mark - Methods
+
+- (void)replayWithBackend:(id<STKPXRenderBackend>)backend
+{
+    const STKPXDisplayOperation *operations = operations_.bytes;
+    NSUInteger count = self.operationCount;
+
+    // the transform concatenated on top of the current scope, with the state saved for it
+    CGAffineTransform current = CGAffineTransformIdentity;
+    BOOL pushed = NO;
+
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        const STKPXDisplayOperation *operation = &operations[i];
+
+        switch (operation->type)
+        {
+            case STKPXDisplayOperationDraw:
+            case STKPXDisplayOperationRender:
+                // consecutive operations with the same transform share a single saved state
+                if (!CGAffineTransformEqualToTransform(operation->transform, current))
+                {
+                    if (pushed)
+                    {
+                        [backend restoreState];
+                        pushed = NO;
+                    }
+
+                    if (!CGAffineTransformIsIdentity(operation->transform))
+                    {
+                        [backend saveState];
+                        [backend concatTransform:operation->transform];
+                        pushed = YES;
+                    }
+
+                    current = operation->transform;
+                }
+
+                if (operation->type == STKPXDisplayOperationRender)
+                {
+                    [operation->renderable renderWithBackend:backend];
+                }
+                else
+                {
+                    [backend applyOutsetOfShadow:operation->shadow toPath:operation->path];
+                    [backend fillPath:operation->path withPaint:operation->fill];
+                    [backend applyInsetOfShadow:operation->shadow toPath:operation->path];
+                    [backend strokePath:operation->path withStroke:operation->stroke];
+                }
+                break;
+
+            case STKPXDisplayOperationPushScope:
+                if (pushed)
+                {
+                    [backend restoreState];
+                    pushed = NO;
+                }
+
+                [backend saveState];
+
+                if (!CGAffineTransformIsIdentity(operation->transform))
+                {
+                    [backend concatTransform:operation->transform];
+                }
+
+                if (operation->path)
+                {
+                    [backend clipToPath:operation->path];
+                }
+
+                if (operation->transparencyLayer)
+                {
+                    [backend beginTransparencyLayerWithOpacity:operation->opacity];
+                }
+
+                current = CGAffineTransformIdentity;
+                break;
+
+            case STKPXDisplayOperationPopScope:
+                if (pushed)
+                {
+                    [backend restoreState];
+                    pushed = NO;
+                }
+
+                if (operation->transparencyLayer)
+                {
+                    [backend endTransparencyLayer];
+                }
+
+                [backend restoreState];
+
+                current = CGAffineTransformIdentity;
+                break;
+        }
+    }
+
+    if (pushed)
+    {
+        [backend restoreState];
+    }
+}
+
+#pragma mark - Compilation
+
+- (BOOL)rendersAsShape:(id<STKPXRenderable>)renderable
+{
+    if (![renderable isKindOfClass:[STKPXShape class]])
+    {
+        return NO;
+    }
+
+    NSObject *object = renderable;
+    IMP renderChildren = [object methodForSelector:@selector(renderChildrenWithBackend:)];
+
+    // shapes that override how they or their children render are replayed by calling them
+    return [object methodForSelector:@selector(renderWithBackend:)] == SHAPE_RENDER
+        && (renderChildren == SHAPE_RENDER_CHILDREN
+            || (renderChildren == GROUP_RENDER_CHILDREN && [renderable isKindOfClass:[STKPXShapeGroup class]]));
+}
+
+- (void)compileRenderable:(id<STKPXRenderable>)renderable transform:(CGAffineTransform)transform
+{
+    if (![self rendersAsShape:renderable])
+    {
+        STKPXDisplayOperation operation = { .type = STKPXDisplayOperationRender, .transform = transform };
+
+        operation.renderable = [self retainObject:renderable];
+        [operations_ appendBytes:&operation length:sizeof(operation)];
+
+        return;
+    }
+
+    STKPXShape *shape = (STKPXShape *) renderable;
+
+    // nothing below an invisible or fully transparent shape can show
+    if (!shape.visible || shape.opacity <= 0.0f)
+    {
+        _culledCount += [self countOfRenderable:shape];
+        return;
+    }
+
+    CGAffineTransform local = CGAffineTransformConcat(shape.transform, transform);
+    CGPathRef clippingPath = shape.clippingPath.path;
+    BOOL transparencyLayer = [shape needsTransparencyLayer];
+    BOOL scoped = (clippingPath != NULL || transparencyLayer);
+
+    if (scoped)
+    {
+        STKPXDisplayOperation push = {
+            .type = STKPXDisplayOperationPushScope,
+            .transform = local,
+            .path = [self retainPath:clippingPath],
+            .transparencyLayer = transparencyLayer,
+            .opacity = shape.opacity
+        };
+
+        [operations_ appendBytes:&push length:sizeof(push)];
+
+        local = CGAffineTransformIdentity;
+    }
+
+    CGPathRef path = shape.path;
+
+    if (path && (shape.fill || shape.stroke || shape.shadow))
+    {
+        STKPXDisplayOperation draw = { .type = STKPXDisplayOperationDraw, .transform = local, .path = [self retainPath:path] };
+
+        draw.fill = [self retainObject:shape.fill];
+        draw.stroke = [self retainObject:shape.stroke];
+        draw.shadow = [self retainObject:shape.shadow];
+        [operations_ appendBytes:&draw length:sizeof(draw)];
+    }
+
+    if ([shape isKindOfClass:[STKPXShapeGroup class]])
+    {
+        STKPXShapeGroup *group = (STKPXShapeGroup *) shape;
+        CGAffineTransform childTransform = CGAffineTransformConcat(group.viewPortTransform, local);
+
+        for (NSUInteger i = 0; i < group.shapeCount; i++)
+        {
+            [self compileRenderable:[group shapeAtIndex:i] transform:childTransform];
+        }
+    }
+
+    if (scoped)
+    {
+        STKPXDisplayOperation pop = { .type = STKPXDisplayOperationPopScope, .transparencyLayer = transparencyLayer };
+
+        [operations_ appendBytes:&pop length:sizeof(pop)];
+    }
+}
+
+- (NSUInteger)countOfRenderable:(id<STKPXRenderable>)renderable
+{
+    NSUInteger count = 1;
+
+    if ([renderable isKindOfClass:[STKPXShapeGroup class]])
+    {
+        STKPXShapeGroup *group = (STKPXShapeGroup *) renderable;
+
+        for (NSUInteger i = 0; i < group.shapeCount; i++)
+        {
+            count += [self countOfRenderable:[group shapeAtIndex:i]];
+        }
+    }
+
+    return count;
+}
+
+- (id)retainObject:(id)object
+{
+    if (object)
+    {
+        [objects_ addObject:object];
+    }
+
+    return object;
+}
+
+- (CGPathRef)retainPath:(CGPathRef)path
+{
+    if (path)
+    {
+        [objects_ addObject:(__bridge id) path];
+    }
+
+    return path;
+}
+
+@end
@@ -28,7 +28,7 @@
 /**
  *  A STKPXShape sub-class used to render ellipses
  */
-@interface STKPXEllipse : STKPXShape <STKPXBoundable>
+@interface STKPXEllipse : STKPXShape <STKPXBoundable, NSCopying>
 
 /**
  *  A point indicating the location of the center of this ellipse.
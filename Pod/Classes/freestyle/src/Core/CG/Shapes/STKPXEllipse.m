@@ -24,6 +24,7 @@
 //
 
 #import "STKPXEllipse.h"
+#import "STKPXPathCache.h"
 
 @implementation STKPXEllipse
 
@@ -115,15 +116,20 @@
 
 - (CGPathRef)newPath
 {
-    CGMutablePathRef path = CGPathCreateMutable();
     CGRect rect = CGRectMake(self.center.x - self.radiusX, self.center.y - self.radiusY, self.radiusX * 2.0, self.radiusY * 2.0);
 
-    CGPathAddEllipseInRect(path, NULL, rect);
+    return [[STKPXPathCache sharedInstance] newEllipsePathInRect:rect];
+}
+
+#pragma mark - NSCopying
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    STKPXEllipse *result = [[[self class] allocWithZone:zone] initCenter:_center radiusX:_radiusX radiusY:_radiusY];
 
-    CGPathRef resultPath = CGPathCreateCopy(path);
-    CGPathRelease(path);
+    [self copyPaintPropertiesToShape:result];
 
-    return resultPath;
+    return result;
 }
 
 @end
@@ -0,0 +1,87 @@
+/****************************************************************************
+ *
+ * Copyright 2015-present StylingKit Development Team. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ****************************************************************************/
+
+//
+//  STKPXPathCache.h
+//  StylingKit
+//
+
+#import <UIKit/UIKit.h>
+
+/**
+ *  STKPXPathCache shares immutable paths between shapes with the same geometry. Paths are keyed by their normalized
+ *  geometry (shape kind, size and corner radii) and stored relative to the origin, so a rectangle inset by half of its
+ *  stroke width, or a cell's background at a different position, reuses the path built for the first shape of that
+ *  size. The origin is applied as a translation when a shape asks for its path.
+ */
+@interface STKPXPathCache : NSObject
+
+/**
+ *  The shared cache used by STKPXRectangle, STKPXEllipse and STKPXCircle
+ */
++ (instancetype)sharedInstance;
+
+/**
+ *  Determines if paths are shared. When NO, every request builds a new path. Defaults to YES
+ */
+@property (nonatomic) BOOL enabled;
+
+/**
+ *  The number of paths built since the counters were last reset
+ */
+@property (nonatomic, readonly) NSUInteger buildCount;
+
+/**
+ *  The number of requests answered from the cache, and so the number of path builds avoided
+ */
+@property (nonatomic, readonly) NSUInteger buildsAvoided;
+
+/**
+ *  Return a rectangle path with the specified bounds and corner radii. Corners with a zero width or height are square.
+ *  The caller owns the returned path
+ *
+ *  @param bounds The bounds of the rectangle
+ *  @param topLeft The radii of the top-left corner
+ *  @param topRight The radii of the top-right corner
+ *  @param bottomRight The radii of the bottom-right corner
+ *  @param bottomLeft The radii of the bottom-left corner
+ */
+- (CGPathRef)newRectanglePathWithBounds:(CGRect)bounds
+                          radiusTopLeft:(CGSize)topLeft
+                         radiusTopRight:(CGSize)topRight
+                      radiusBottomRight:(CGSize)bottomRight
+                       radiusBottomLeft:(CGSize)bottomLeft CF_RETURNS_RETAINED;
+
+/**
+ *  Return an ellipse path inscribed in the specified rectangle. The caller owns the returned path
+ *
+ *  @param rect The bounds of the ellipse
+ */
+- (CGPathRef)newEllipsePathInRect:(CGRect)rect CF_RETURNS_RETAINED;
+
+/**
+ *  Remove all cached paths
+ */
+- (void)removeAllPaths;
+
+/**
+ *  Reset buildCount and buildsAvoided
+ */
+- (void)resetCounters;
+
+@end
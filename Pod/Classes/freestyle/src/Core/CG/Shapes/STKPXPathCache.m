@@ -0,0 +1,279 @@
+/****************************************************************************
+ *
+ * Copyright 2015-present StylingKit Development Team. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ****************************************************************************/
+
+//
+//  STKPXPathCache.m
+//  StylingKit
+//
+
+#import "STKPXPathCache.h"
+#import "STKPXEllipticalArc.h"
+
+typedef NS_ENUM(NSInteger, STKPXPathKind)
+{
+    STKPXPathKindRectangle,
+    STKPXPathKindEllipse
+};
+
+typedef struct
+{
+    STKPXPathKind kind;
+    CGSize size;
+    CGSize radii[4];    // top-left, top-right, bottom-right, bottom-left
+} STKPXPathGeometry;
+
+static const NSUInteger STKPXPathCacheCountLimit = 256;
+
+static inline CGSize STKPXNormalizedRadius(CGSize radius)
+{
+    // corners with a collapsed radius are drawn square. Adding zero folds -0.0 into 0.0 so both hash the same
+    return (radius.width > 0.0f && radius.height > 0.0f)
+        ? CGSizeMake(radius.width + 0.0f, radius.height + 0.0f)
+        : CGSizeZero;
+}
+
+@implementation STKPXPathCache
+{
+    NSCache *paths_;
+}
+
+#pragma mark - Static Methods
+
++ (instancetype)sharedInstance
+{
+    static STKPXPathCache *sharedInstance;
+    static dispatch_once_t onceToken;
+
+    dispatch_once(&onceToken, ^{
+        sharedInstance = [[STKPXPathCache alloc] init];
+    });
+
+    return sharedInstance;
+}
+
+#pragma mark - Initializers
+
+- (instancetype)init
+{
+    if (self = [super init])
+    {
+        paths_ = [[NSCache alloc] init];
+        paths_.name = @"StylingKit Path Cache";
+        paths_.countLimit = STKPXPathCacheCountLimit;
+        _enabled = YES;
+    }
+
+    return self;
+}
+
+#pragma mark - Methods
+
+- (CGPathRef)newRectanglePathWithBounds:(CGRect)bounds
+                          radiusTopLeft:(CGSize)topLeft
+                         radiusTopRight:(CGSize)topRight
+                      radiusBottomRight:(CGSize)bottomRight
+                       radiusBottomLeft:(CGSize)bottomLeft
+{
+    STKPXPathGeometry geometry;
+
+    memset(&geometry, 0, sizeof(geometry));
+    geometry.kind = STKPXPathKindRectangle;
+    geometry.size = CGSizeMake(bounds.size.width + 0.0f, bounds.size.height + 0.0f);
+    geometry.radii[0] = STKPXNormalizedRadius(topLeft);
+    geometry.radii[1] = STKPXNormalizedRadius(topRight);
+    geometry.radii[2] = STKPXNormalizedRadius(bottomRight);
+    geometry.radii[3] = STKPXNormalizedRadius(bottomLeft);
+
+    return [self newPathWithGeometry:&geometry origin:bounds.origin];
+}
+
+- (CGPathRef)newEllipsePathInRect:(CGRect)rect
+{
+    STKPXPathGeometry geometry;
+
+    memset(&geometry, 0, sizeof(geometry));
+    geometry.kind = STKPXPathKindEllipse;
+    geometry.size = CGSizeMake(rect.size.width + 0.0f, rect.size.height + 0.0f);
+
+    return [self newPathWithGeometry:&geometry origin:rect.origin];
+}
+
+- (void)removeAllPaths
+{
+    @synchronized(self)
+    {
+        [paths_ removeAllObjects];
+    }
+}
+
+- (void)resetCounters
+{
+    @synchronized(self)
+    {
+        _buildCount = 0;
+        _buildsAvoided = 0;
+    }
+}
+
+#pragma mark - Private Methods
+
+- (CGPathRef)newPathWithGeometry:(const STKPXPathGeometry *)geometry origin:(CGPoint)origin
+{
+    CGPathRef path = NULL;
+
+    @synchronized(self)
+    {
+        if (_enabled)
+        {
+            NSData *key = [[NSData alloc] initWithBytes:geometry length:sizeof(STKPXPathGeometry)];
+
+            path = (__bridge CGPathRef) [paths_ objectForKey:key];
+
+            if (path)
+            {
+                CGPathRetain(path);
+                _buildsAvoided++;
+            }
+            else
+            {
+                path = [self newPathForGeometry:geometry];
+                _buildCount++;
+                [paths_ setObject:(__bridge id) path forKey:key];
+            }
+        }
+        else
+        {
+            path = [self newPathForGeometry:geometry];
+            _buildCount++;
+        }
+    }
+
+    if (origin.x != 0.0f || origin.y != 0.0f)
+    {
+        CGAffineTransform translation = CGAffineTransformMakeTranslation(origin.x, origin.y);
+        CGPathRef translated = CGPathCreateCopyByTransformingPath(path, &translation);
+
+        CGPathRelease(path);
+        path = translated;
+    }
+
+    return path;
+}
+
+- (CGPathRef)newPathForGeometry:(const STKPXPathGeometry *)geometry
+{
+    CGMutablePathRef path = CGPathCreateMutable();
+    CGFloat right = geometry->size.width;
+    CGFloat bottom = geometry->size.height;
+
+    if (geometry->kind == STKPXPathKindEllipse)
+    {
+        CGPathAddEllipseInRect(path, NULL, CGRectMake(0.0f, 0.0f, right, bottom));
+    }
+    else
+    {
+        CGSize radiusTopLeft = geometry->radii[0];
+        CGSize radiusTopRight = geometry->radii[1];
+        CGSize radiusBottomRight = geometry->radii[2];
+        CGSize radiusBottomLeft = geometry->radii[3];
+
+        if (CGSizeEqualToSize(radiusTopLeft, CGSizeZero)
+        &&  CGSizeEqualToSize(radiusTopRight, CGSizeZero)
+        &&  CGSizeEqualToSize(radiusBottomRight, CGSizeZero)
+        &&  CGSizeEqualToSize(radiusBottomLeft, CGSizeZero))
+        {
+            CGPathAddRect(path, NULL, CGRectMake(0.0f, 0.0f, right, bottom));
+        }
+        else
+        {
+            // top points
+            CGFloat topLeftX = radiusTopLeft.width;
+            CGFloat topRightX = right - radiusTopRight.width;
+
+            // right points
+            CGFloat rightTopY = radiusTopRight.height;
+            CGFloat rightBottomY = bottom - radiusBottomRight.height;
+
+            // bottom points
+            CGFloat bottomLeftX = radiusBottomLeft.width;
+            CGFloat bottomRightX = right - radiusBottomRight.width;
+
+            // left points
+            CGFloat leftTopY = radiusTopLeft.height;
+            CGFloat leftBottomY = bottom - radiusBottomLeft.height;
+
+            // move to starting point
+            CGPathMoveToPoint(path, NULL, topLeftX, 0.0f);
+
+            // add top and top-right corner
+            if (radiusTopRight.width > 0.0f)
+            {
+                CGPathAddLineToPoint(path, NULL, topRightX, 0.0f);
+                CGPathAddEllipticalArc(path, NULL, topRightX, rightTopY, radiusTopRight.width, radiusTopRight.height, -M_PI_2, 0.0f);
+            }
+            else
+            {
+                CGPathAddLineToPoint(path, NULL, right, 0.0f);
+            }
+
+            // add right and bottom-right corner
+            if (radiusBottomRight.width > 0.0f)
+            {
+                CGPathAddLineToPoint(path, NULL, right, rightBottomY);
+                CGPathAddEllipticalArc(path, NULL, bottomRightX, rightBottomY, radiusBottomRight.width, radiusBottomRight.height, 0.0f, M_PI_2);
+            }
+            else
+            {
+                CGPathAddLineToPoint(path, NULL, right, bottom);
+            }
+
+            // add bottom and bottom-left corner
+            if (radiusBottomLeft.width > 0.0f)
+            {
+                CGPathAddLineToPoint(path, NULL, bottomLeftX, bottom);
+                CGPathAddEllipticalArc(path, NULL, bottomLeftX, leftBottomY, radiusBottomLeft.width, radiusBottomLeft.height, M_PI_2, M_PI);
+            }
+            else
+            {
+                CGPathAddLineToPoint(path, NULL, 0.0f, bottom);
+            }
+
+            // add left and top-left corner
+            if (radiusTopLeft.width > 0.0f)
+            {
+                CGPathAddLineToPoint(path, NULL, 0.0f, leftTopY);
+                CGPathAddEllipticalArc(path, NULL, topLeftX, leftTopY, radiusTopLeft.width, radiusTopLeft.height, M_PI, 3.0f * M_PI_2);
+            }
+            else
+            {
+                CGPathAddLineToPoint(path, NULL, 0.0f, 0.0f);
+            }
+
+            // close path
+            CGPathCloseSubpath(path);
+        }
+    }
+
+    CGPathRef result = CGPathCreateCopy(path);
+
+    CGPathRelease(path);
+
+    return result;
+}
+
+@end
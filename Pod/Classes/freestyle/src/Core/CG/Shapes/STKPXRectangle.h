@@ -29,7 +29,7 @@
 /**
  *  A STKPXShape sub-class used to render rectangles
  */
-@interface STKPXRectangle : STKPXShape <STKPXBoundable>
+@interface STKPXRectangle : STKPXShape <STKPXBoundable, NSCopying>
 
 /**
  *  The size (width and height) of this rectangle
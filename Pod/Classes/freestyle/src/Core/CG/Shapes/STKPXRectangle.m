@@ -24,7 +24,7 @@
 //
 
 #import "STKPXRectangle.h"
-#import "STKPXEllipticalArc.h"
+#import "STKPXPathCache.h"
 
 @implementation STKPXRectangle
 
@@ -189,99 +189,28 @@
 
 - (CGPathRef)newPath
 {
-    CGPathRef resultPath;
+    // rectangles of the same size and radii share one origin-relative path
+    return [[STKPXPathCache sharedInstance] newRectanglePathWithBounds:_bounds
+                                                         radiusTopLeft:_radiusTopLeft
+                                                        radiusTopRight:_radiusTopRight
+                                                     radiusBottomRight:_radiusBottomRight
+                                                      radiusBottomLeft:_radiusBottomLeft];
+}
 
-    if (self.hasRoundedCorners == NO)
-    {
-        CGMutablePathRef path = CGPathCreateMutable();
-        CGPathAddRect(path, NULL, self.bounds);
+#pragma mark - NSCopying
 
-        resultPath = CGPathCreateCopy(path);
+- (id)copyWithZone:(NSZone *)zone
+{
+    STKPXRectangle *result = [[[self class] allocWithZone:zone] initWithRect:_bounds];
 
-        CGPathRelease(path);
-    }
-    else
-    {
-        CGFloat left = self.bounds.origin.x;
-        CGFloat top = self.bounds.origin.y;
-        CGFloat right = left + self.bounds.size.width;
-        CGFloat bottom = top + self.bounds.size.height;
-
-        // top points
-        CGFloat topLeftX = left + _radiusTopLeft.width;
-        CGFloat topRightX = right - _radiusTopRight.width;
-
-        // right points
-        CGFloat rightTopY = top + _radiusTopRight.height;
-        CGFloat rightBottomY = bottom - _radiusBottomRight.height;
-
-        // bottom points
-        CGFloat bottomLeftX = left + _radiusBottomLeft.width;
-        CGFloat bottomRightX = right - _radiusBottomRight.width;
-
-        // left points
-        CGFloat leftTopY = top + _radiusTopLeft.height;
-        CGFloat leftBottomY = bottom - _radiusBottomLeft.height;
-
-        // create path
-        CGMutablePathRef path = CGPathCreateMutable();
-
-        // move to starting point
-        CGPathMoveToPoint(path, NULL, topLeftX, top);
-
-        // add top and top-right corner
-        if (_radiusTopRight.width > 0.0f && _radiusTopRight.height > 0.0f)
-        {
-            CGPathAddLineToPoint(path, NULL, topRightX, top);
-            CGPathAddEllipticalArc(path, NULL, topRightX, rightTopY, _radiusTopRight.width, _radiusTopRight.height, -M_PI_2, 0.0f);
-        }
-        else
-        {
-            CGPathAddLineToPoint(path, NULL, right, top);
-        }
-
-        // add right and bottom-right corner
-        if (_radiusBottomRight.width > 0.0f && _radiusBottomRight.height > 0.0f)
-        {
-            CGPathAddLineToPoint(path, NULL, right, rightBottomY);
-            CGPathAddEllipticalArc(path, NULL, bottomRightX, rightBottomY, _radiusBottomRight.width, _radiusBottomRight.height, 0.0f, M_PI_2);
-        }
-        else
-        {
-            CGPathAddLineToPoint(path, NULL, right, bottom);
-        }
-
-        // add bottom and bottom-left corner
-        if (_radiusBottomLeft.width > 0.0f && _radiusBottomLeft.height > 0.0f)
-        {
-            CGPathAddLineToPoint(path, NULL, bottomLeftX, bottom);
-            CGPathAddEllipticalArc(path, NULL, bottomLeftX, leftBottomY, _radiusBottomLeft.width, _radiusBottomLeft.height, M_PI_2, M_PI);
-        }
-        else
-        {
-            CGPathAddLineToPoint(path, NULL, left, bottom);
-        }
-
-        // add left and top-left corner
-        if (_radiusTopLeft.width > 0.0f && _radiusTopLeft.height > 0.0f)
-        {
-            CGPathAddLineToPoint(path, NULL, left, leftTopY);
-            CGPathAddEllipticalArc(path, NULL, topLeftX, leftTopY, _radiusTopLeft.width, _radiusTopLeft.height, M_PI, 3.0f * M_PI_2);
-        }
-        else
-        {
-            CGPathAddLineToPoint(path, NULL, left, top);
-        }
-
-        // close path
-        CGPathCloseSubpath(path);
-
-        resultPath = CGPathCreateCopy(path);
-
-        CGPathRelease(path);
-    }
+    [self copyPaintPropertiesToShape:result];
+
+    result.radiusTopLeft = _radiusTopLeft;
+    result.radiusTopRight = _radiusTopRight;
+    result.radiusBottomRight = _radiusBottomRight;
+    result.radiusBottomLeft = _radiusBottomLeft;
 
-    return resultPath;
+    return result;
 }
 
 @end
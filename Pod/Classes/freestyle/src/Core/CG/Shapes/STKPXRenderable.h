@@ -24,6 +24,7 @@
 
 #import <Foundation/Foundation.h>
 #import "STKPXOffsets.h"
+#import "STKPXRenderBackend.h"
 
 /**
  *  The STKPXRenderable protocol declares properties needed when describing the structure of content rendered to a
@@ -53,6 +54,14 @@
  */
 - (void)render:(CGContextRef)context;
 
+/**
+ *  The method responsible for painting this shape with the specified backend. render: renders through a CoreGraphics
+ *  backend, so both produce the same drawing operations
+ *
+ *  @param backend the backend with which to render
+ */
+- (void)renderWithBackend:(id<STKPXRenderBackend>)backend;
+
 /**
  *  Render this shape within the specified bounds and return that as a UIImage
  *
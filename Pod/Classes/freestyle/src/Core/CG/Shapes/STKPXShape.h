@@ -77,6 +77,15 @@
  */
 - (void)renderChildren:(CGContextRef)context;
 
+/**
+ *  Render any children associated with this shape with the specified backend.
+ *
+ *  Container classes override this method rather than renderChildren:, which renders through a CoreGraphics backend.
+ *
+ *  @param backend The backend with which children of this shape should be rendered.
+ */
+- (void)renderChildrenWithBackend:(id<STKPXRenderBackend>)backend;
+
 /**
  *  Indicate that this shape needs to be redrawn.
  *
@@ -87,4 +96,14 @@
  */
 - (void)setNeedsDisplay;
 
+/**
+ *  Copy the paints, shadow, opacity, visibility, transform and clipping path of this shape onto another shape.
+ *
+ *  Subclasses implementing NSCopying use this to copy everything but their geometry, which is not shared with the
+ *  copy. The paints themselves are shared.
+ *
+ *  @param shape The shape to copy to
+ */
+- (void)copyPaintPropertiesToShape:(STKPXShape *)shape;
+
 @end
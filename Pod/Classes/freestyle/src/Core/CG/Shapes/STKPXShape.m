@@ -26,8 +26,13 @@
 #import "STKPXShape.h"
 #import "STKPXShapeView.h"
 #import "STKPXShadow.h"
+#import "STKPXCoreGraphicsBackend.h"
 
 @implementation STKPXShape
+{
+    // the shapes using this one as their clipping path
+    NSHashTable *clippedShapes_;
+}
 
 @synthesize parent = _parent;
 @synthesize owningDocument = _owningDocument;
@@ -107,6 +112,8 @@
     }
 
     self->_path = aPath;
+
+    [self setNeedsDisplay];
 }
 
 - (void)setStroke:(id<STKPXStrokeRenderer>)stroke
@@ -161,7 +168,20 @@
 {
     if (self->_clippingPath != clippingPath)
     {
+        [self->_clippingPath->clippedShapes_ removeObject:self];
+
         self->_clippingPath = clippingPath;
+
+        if (clippingPath)
+        {
+            if (clippingPath->clippedShapes_ == nil)
+            {
+                clippingPath->clippedShapes_ = [NSHashTable weakObjectsHashTable];
+            }
+
+            [clippingPath->clippedShapes_ addObject:self];
+        }
+
         [self setNeedsDisplay];
     }
 }
@@ -180,58 +200,62 @@
 - (void)clearPath
 {
     self.path = nil;
-
-    [self setNeedsDisplay];
 }
 
 - (void)render:(CGContextRef)context
+{
+    if (context != nil)
+    {
+        [self renderWithBackend:[[STKPXCoreGraphicsBackend alloc] initWithContext:context]];
+    }
+}
+
+- (void)renderWithBackend:(id<STKPXRenderBackend>)backend
 {
     // Don't draw if we're not visible
-    if (context != nil && self.visible == YES)
+    if (backend != nil && self.visible == YES)
     {
         // push context
-        CGContextSaveGState(context);
+        [backend saveState];
 
         // apply transform
         if (CGAffineTransformEqualToTransform(self.transform, CGAffineTransformIdentity) == NO)
         {
-            CGContextConcatCTM(context, self.transform);
+            [backend concatTransform:self.transform];
         }
 
         // apply clipping path
         if (self.clippingPath)
         {
-            CGContextAddPath(context, self.clippingPath.path);
-            CGContextClip(context);
+            [backend clipToPath:self.clippingPath.path];
         }
 
         // setup transparency layer
         if ([self needsTransparencyLayer])
         {
-            CGContextSetAlpha(context, self.opacity);
-            CGContextBeginTransparencyLayer(context, NULL);
+            [backend beginTransparencyLayerWithOpacity:self.opacity];
         }
 
         // render content
         if (self.path)
         {
-            [self.shadow applyOutsetToPath:self.path withContext:context];
-            [self.fill applyFillToPath:self.path withContext:context];
-            [self.shadow applyInsetToPath:self.path withContext:context];
-            [self.stroke applyStrokeToPath:self.path withContext:context];
+            [backend applyOutsetOfShadow:self.shadow toPath:self.path];
+            [backend fillPath:self.path withPaint:self.fill];
+            [backend applyInsetOfShadow:self.shadow toPath:self.path];
+            [backend strokePath:self.path withStroke:self.stroke];
         }
 
         // render children
-        [self renderChildren:context];
+        [self renderChildrenWithBackend:backend];
 
         // tear down transparency layer
         if ([self needsTransparencyLayer])
         {
-            CGContextEndTransparencyLayer(context);
+            [backend endTransparencyLayer];
         }
 
         // restore context
-        CGContextRestoreGState(context);
+        [backend restoreState];
     }
 }
 
@@ -270,7 +294,35 @@
 
 - (void)setNeedsDisplay
 {
-    [self.owningDocument.parentView setNeedsDisplay];
+    STKPXShapeDocument *document = self.owningDocument;
+
+    [document invalidateDisplayList];
+    [document.parentView setNeedsDisplay];
+
+    // clipping paths live outside of the tree, so pass changes to them, or to their descendants, on to the shapes they
+    // clip
+    for (id<STKPXRenderable> current = self; current != nil; current = current.parent)
+    {
+        if ([current isKindOfClass:[STKPXShape class]])
+        {
+            for (STKPXShape *shape in ((STKPXShape *)current)->clippedShapes_.allObjects)
+            {
+                [shape setNeedsDisplay];
+            }
+        }
+    }
+}
+
+- (void)copyPaintPropertiesToShape:(STKPXShape *)shape
+{
+    shape.stroke = _stroke;
+    shape.fill = _fill;
+    shape.opacity = _opacity;
+    shape.visible = _visible;
+    shape.transform = _transform;
+    shape.clippingPath = _clippingPath;
+    shape.shadow = _shadow;
+    shape.padding = _padding;
 }
 
 #pragma mark - Abstract Methods
@@ -281,6 +333,14 @@
 }
 
 - (void)renderChildren:(CGContextRef)context
+{
+    if (context != nil)
+    {
+        [self renderChildrenWithBackend:[[STKPXCoreGraphicsBackend alloc] initWithContext:context]];
+    }
+}
+
+- (void)renderChildrenWithBackend:(id<STKPXRenderBackend>)backend
 {
 }
 
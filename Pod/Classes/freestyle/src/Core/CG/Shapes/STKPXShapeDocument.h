@@ -50,6 +50,12 @@
  */
 @property (nonatomic, strong) STKPXShapeView *parentView;
 
+/**
+ *  Determine if this document renders by replaying a display list compiled from its shapes. The display list is
+ *  rebuilt after the document's shape or bounds change, or after any of its shapes requests a redisplay. On by default
+ */
+@property (nonatomic) BOOL usesDisplayList;
+
 /**
  *  Return the shape in this scene with the specfied name.
  *
@@ -66,4 +72,9 @@
  */
 - (void)addShape:(id<STKPXRenderable>)shape forName:(NSString *)name;
 
+/**
+ *  Discard the compiled display list so that it is rebuilt the next time this document renders
+ */
+- (void)invalidateDisplayList;
+
 @end
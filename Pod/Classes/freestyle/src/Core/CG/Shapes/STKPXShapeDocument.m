@@ -25,10 +25,13 @@
 
 #import "STKPXShapeDocument.h"
 #import "STKPXShapeGroup.h"
+#import "STKPXCoreGraphicsBackend.h"
+#import "STKPXDisplayList.h"
 
 @implementation STKPXShapeDocument
 {
     NSMutableDictionary *nameDictionary;
+    STKPXDisplayList *displayList_;
 }
 
 @synthesize shape = _shape;
@@ -47,6 +50,7 @@
     {
         self.shape = nil;
         self.transform = CGAffineTransformIdentity;
+        _usesDisplayList = YES;
     }
 
     return self;
@@ -74,6 +78,8 @@
         group.width = size.width;
         group.height = size.height;
     }
+
+    [self invalidateDisplayList];
 }
 
 - (void)setParent:(id<STKPXRenderable>)parent
@@ -98,9 +104,18 @@
         {
             _shape.parent = self;
         }
+
+        [self invalidateDisplayList];
     }
 }
 
+- (void)setTransform:(CGAffineTransform)transform
+{
+    _transform = transform;
+
+    [self invalidateDisplayList];
+}
+
 #pragma mark - Methods
 
 - (id<STKPXRenderable>)shapeForName:(NSString *)name
@@ -128,14 +143,46 @@
     }
 }
 
+- (void)invalidateDisplayList
+{
+    @synchronized(self)
+    {
+        displayList_ = nil;
+    }
+}
+
 #pragma mark - STKPXRenderable Methods
 
 - (void)render:(CGContextRef)context
 {
-    if (self->_shape)
+    if (context != nil)
+    {
+        [self renderWithBackend:[[STKPXCoreGraphicsBackend alloc] initWithContext:context]];
+    }
+}
+
+- (void)renderWithBackend:(id<STKPXRenderBackend>)backend
+{
+    if (self->_shape && _usesDisplayList)
+    {
+        STKPXDisplayList *displayList;
+
+        @synchronized(self)
+        {
+            if (displayList_ == nil)
+            {
+                displayList_ = [[STKPXDisplayList alloc] initWithRenderable:self->_shape transform:self.transform];
+            }
+
+            displayList = displayList_;
+        }
+
+        [displayList replayWithBackend:backend];
+    }
+    else if (self->_shape)
     {
-        CGContextConcatCTM(context, self.transform);
-        [self->_shape render:context];
+        [backend concatTransform:self.transform];
+        [self->_shape renderWithBackend:backend];
     }
 }
 
@@ -56,6 +56,53 @@
     return (shapes_) ? shapes_.count : 0;
 }
 
+#pragma mark - Setters
+
+- (void)setWidth:(CGFloat)width
+{
+    if (_width != width)
+    {
+        _width = width;
+        [self setNeedsDisplay];
+    }
+}
+
+- (void)setHeight:(CGFloat)height
+{
+    if (_height != height)
+    {
+        _height = height;
+        [self setNeedsDisplay];
+    }
+}
+
+- (void)setViewport:(CGRect)viewport
+{
+    if (!CGRectEqualToRect(_viewport, viewport))
+    {
+        _viewport = viewport;
+        [self setNeedsDisplay];
+    }
+}
+
+- (void)setViewportAlignment:(AlignViewPortType)viewportAlignment
+{
+    if (_viewportAlignment != viewportAlignment)
+    {
+        _viewportAlignment = viewportAlignment;
+        [self setNeedsDisplay];
+    }
+}
+
+- (void)setViewportCrop:(CropType)viewportCrop
+{
+    if (_viewportCrop != viewportCrop)
+    {
+        _viewportCrop = viewportCrop;
+        [self setNeedsDisplay];
+    }
+}
+
 #pragma mark - Methods
 
 - (void)addShape:(id<STKPXRenderable>)shape
@@ -67,6 +114,8 @@
 
         // set child's parent
         shape.parent = self;
+
+        [self setNeedsDisplay];
     }
 }
 
@@ -78,6 +127,8 @@
 
         // TODO: verify this is in this group
         shape.parent = nil;
+
+        [self setNeedsDisplay];
     }
 }
 
@@ -172,16 +223,16 @@
     return matrix;
 }
 
-- (void) renderChildren:(CGContextRef)context
+- (void)renderChildrenWithBackend:(id<STKPXRenderBackend>)backend
 {
 
     CGAffineTransform matrix = self.viewPortTransform;
 
-    CGContextConcatCTM(context, matrix);
+    [backend concatTransform:matrix];
 
     for (id<STKPXRenderable> shape in shapes_)
     {
-        [shape render:context];
+        [shape renderWithBackend:backend];
     }
 }
 
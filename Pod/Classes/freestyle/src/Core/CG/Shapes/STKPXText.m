@@ -107,15 +107,15 @@
     return resultPath;
 }
 
-- (void)render:(CGContextRef)context
+- (void)renderWithBackend:(id<STKPXRenderBackend>)backend
 {
-    CGContextSaveGState(context);
+    [backend saveState];
 
-    CGContextTranslateCTM(context, self.origin.x, self.origin.y + self.fontSize);
+    [backend concatTransform:CGAffineTransformMakeTranslation(self.origin.x, self.origin.y + self.fontSize)];
 
-    [super render:context];
+    [super renderWithBackend:backend];
 
-    CGContextRestoreGState(context);
+    [backend restoreState];
 }
 
 - (void)dealloc
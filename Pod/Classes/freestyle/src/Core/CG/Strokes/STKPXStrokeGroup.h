@@ -32,6 +32,11 @@
  */
 @interface STKPXStrokeGroup : NSObject <STKPXStrokeRenderer>
 
+/**
+ *  The strokes in this group, in the order they are applied
+ */
+@property (nonatomic, readonly) NSArray *strokes;
+
 /**
  *  Add the specified stroke to this instance's list of strokes
  *
@@ -46,6 +46,11 @@
 
 #pragma mark - Getters
 
+- (NSArray *)strokes
+{
+    return strokes_;
+}
+
 - (BOOL)isOpaque
 {
     BOOL result = YES;
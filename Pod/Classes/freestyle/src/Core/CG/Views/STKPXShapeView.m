@@ -25,6 +25,8 @@
 #import "STKPXShapeView.h"
 #import "STKPXShapeGroup.h"
 #import "STKPXSVGLoader.h"
+#import "STKPXSVGStreamLoader.h"
+#import "PixateFreestyle.h"
 
 @implementation STKPXShapeView
 
@@ -106,7 +108,14 @@
 - (void)loadSceneFromURL:(NSURL *)URL
 {
     // TODO: this has been exposed and when used directly, resourcePath will keep it's old value
-    self.document = [STKPXSVGLoader loadFromURL:URL];
+    if (PixateFreestyle.configuration.streamingSVGLoader && [STKPXSVGLoader loaderClass] == nil)
+    {
+        self.document = [STKPXSVGStreamLoader loadFromURL:URL];
+    }
+    else
+    {
+        self.document = [STKPXSVGLoader loadFromURL:URL];
+    }
 }
 
 - (void)applyBoundsToScene
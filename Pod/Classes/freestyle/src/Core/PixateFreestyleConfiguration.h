@@ -82,6 +82,41 @@ typedef enum {
 - (BOOL)cacheStyles;
 - (BOOL)preventRedundantStyling;
 
+/**
+ *  Determine if stretchable backgrounds (rectangles with solid or single-axis gradient fills) are rendered once at
+ *  their minimal size and handed out as cap-inset images rather than being rendered at every view size
+ */
+@property (nonatomic) BOOL resizableBackgroundImages;
+
+/**
+ *  Determine if background images that miss the image cache are rendered on a background queue and applied once they
+ *  are ready. A view's first background is always rendered synchronously. Off by default
+ */
+@property (nonatomic) BOOL asyncBackgroundImages;
+
+/**
+ *  Determine if SVG files loaded by STKPXShapeView are read with the libxml2-based STKPXSVGStreamLoader instead of
+ *  STKPXSVGLoader. Ignored when a custom SVG loader class has been registered. Off by default
+ */
+@property (nonatomic) BOOL streamingSVGLoader;
+
+/**
+ *  Determine if rendered background images are also kept in STKPXDiskImageCache so they survive across launches. Off
+ *  by default
+ */
+@property (nonatomic) BOOL diskImageCache;
+
+/**
+ *  Set the number of bytes allowed in the disk image cache
+ */
+@property (nonatomic) NSUInteger diskImageCacheSize;
+
+/**
+ *  Set the theme version stamp of the disk image cache. Changing it discards every image on disk. Defaults to the
+ *  application's bundle version
+ */
+@property (nonatomic, copy) NSString *diskImageCacheVersion;
+
 /**
  *  Set the number of images allowed in the image cache
  */
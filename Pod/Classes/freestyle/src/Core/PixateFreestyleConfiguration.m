@@ -54,6 +54,14 @@ STK_DEFINE_CLASS_LOG_LEVEL
         _imageCacheSize = 0;
         _styleCacheCount = 10;
 
+        _resizableBackgroundImages = YES;
+        _asyncBackgroundImages = NO;
+        _streamingSVGLoader = NO;
+
+        _diskImageCache = NO;
+        _diskImageCacheSize = 32 * 1024 * 1024;
+        _diskImageCacheVersion = [[NSBundle mainBundle] objectForInfoDictionaryKey:@"CFBundleVersion"];
+
         _styleMode = STKPXStylingNormal;
     }
 
@@ -213,6 +221,26 @@ STK_DEFINE_CLASS_LOG_LEVEL
                         [PixateFreestyle clearStyleCache];
                     }
                 },
+                @"resizable-background-images" : ^(STKPXDeclaration *declaration, STKPXStylerContext *context) {
+                    PixateFreestyle.configuration.resizableBackgroundImages = declaration.booleanValue;
+                },
+                @"async-background-images" : ^(STKPXDeclaration *declaration, STKPXStylerContext *context) {
+                    PixateFreestyle.configuration.asyncBackgroundImages = declaration.booleanValue;
+                },
+                @"streaming-svg-loader" : ^(STKPXDeclaration *declaration, STKPXStylerContext *context) {
+                    PixateFreestyle.configuration.streamingSVGLoader = declaration.booleanValue;
+                },
+                @"disk-image-cache" : ^(STKPXDeclaration *declaration, STKPXStylerContext *context) {
+                    PixateFreestyle.configuration.diskImageCache = declaration.booleanValue;
+                },
+                @"disk-image-cache-size" : ^(STKPXDeclaration *declaration, STKPXStylerContext *context) {
+                    NSString *value = declaration.stringValue;
+
+                    PixateFreestyle.configuration.diskImageCacheSize = value.integerValue;
+                },
+                @"disk-image-cache-version" : ^(STKPXDeclaration *declaration, STKPXStylerContext *context) {
+                    PixateFreestyle.configuration.diskImageCacheVersion = declaration.stringValue;
+                },
                 @"image-cache-count" : ^(STKPXDeclaration *declaration, STKPXStylerContext *context) {
                     NSString *value = declaration.stringValue;
 
@@ -37,6 +37,7 @@
 
 + (STKPXStyleTreeInfo *)styleTreeInfoForKey:(NSString *)key;
 + (void)setStyleTreeInfo:(STKPXStyleTreeInfo *)styleTreeInfo forKey:(NSString *)key;
++ (void)removeStyleTreeInfoForKey:(NSString *)key;
 + (void)clearStyleCache;
 + (NSUInteger)styleCacheCount;
 + (void)setStyleCacheCount:(NSUInteger)count;
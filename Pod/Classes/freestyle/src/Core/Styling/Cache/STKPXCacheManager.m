@@ -70,6 +70,14 @@ static NSCache *STYLE_CACHE;
     }
 }
 
++ (void)removeStyleTreeInfoForKey:(NSString *)key
+{
+    if (key.length > 0)
+    {
+        [STYLE_CACHE removeObjectForKey:key];
+    }
+}
+
 + (NSUInteger)imageCacheCount
 {
     return IMAGE_CACHE.countLimit;
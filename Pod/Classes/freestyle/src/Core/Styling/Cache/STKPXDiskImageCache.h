@@ -0,0 +1,158 @@
+/****************************************************************************
+ *
+ * Copyright 2015-present StylingKit Development Team. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ****************************************************************************/
+
+//
+//  STKPXDiskImageCache.h
+//  StylingKit
+//
+
+#import <UIKit/UIKit.h>
+
+@class PixateFreestyleConfiguration;
+
+/**
+ *  STKPXDiskImageCache keeps rendered background images on disk so they survive across launches. Images are keyed by a
+ *  64-bit digest of their style inputs and stored as raw premultiplied bitmaps, which are memory-mapped back in on a
+ *  lookup instead of being decoded. A compact index file tracks entry sizes and recency: the least recently used
+ *  entries are evicted once the cache grows past its byte limit, and the whole cache is dropped when the theme version
+ *  it was written under changes.
+ */
+@interface STKPXDiskImageCache : NSObject
+
+/**
+ *  The shared cache used by STKPXStylerContext. It lives in the application's caches directory and is opened with the
+ *  configured diskImageCacheVersion and diskImageCacheSize
+ */
++ (instancetype)sharedInstance;
+
+/**
+ *  Open, or create, a cache in the specified directory, stamped with the configuration's disk image cache version and
+ *  limited to its disk image cache size
+ *
+ *  @param directory The directory holding the cache
+ *  @param configuration The configuration to read the version stamp and byte limit from
+ */
++ (instancetype)cacheWithDirectory:(NSString *)directory configuration:(PixateFreestyleConfiguration *)configuration;
+
+/**
+ *  Compute the cache key of a rendered image that references no image assets
+ *
+ *  @param styleHash The content hash of the declarations the image was rendered from
+ *  @param size The size of the image in points
+ *  @param scale The scale the image was rendered at
+ */
++ (uint64_t)digestForStyleHash:(NSUInteger)styleHash size:(CGSize)size scale:(CGFloat)scale;
+
+/**
+ *  Compute the cache key of a rendered image. The full URL of every asset is part of the key, as are the modification
+ *  date and size of assets that are local files, so editing such a file invalidates its renderings. Other assets, such
+ *  as asset catalog images, are only covered by the theme version, which has to be bumped when they change. As with
+ *  any 64-bit key, distinct styles may collide; bumping the theme version also clears such an entry
+ *
+ *  @param styleHash The content hash of the declarations the image was rendered from
+ *  @param size The size of the image in points
+ *  @param scale The scale the image was rendered at
+ *  @param assetURLs The URLs of the images the background was rendered from, or nil
+ */
++ (uint64_t)digestForStyleHash:(NSUInteger)styleHash
+                          size:(CGSize)size
+                         scale:(CGFloat)scale
+                     assetURLs:(NSArray *)assetURLs;
+
+/**
+ *  The directory holding the index and the bitmap files
+ */
+@property (nonatomic, readonly) NSString *directory;
+
+/**
+ *  The version stamp of the theme the cached images were rendered from. Setting a different value empties the cache
+ */
+@property (nonatomic, copy) NSString *themeVersion;
+
+/**
+ *  The number of bitmap bytes the cache may hold before it evicts its least recently used entries
+ */
+@property (nonatomic) NSUInteger byteLimit;
+
+/**
+ *  The number of bitmap bytes currently on disk
+ */
+@property (nonatomic, readonly) NSUInteger totalBytes;
+
+/**
+ *  The number of images currently on disk
+ */
+@property (nonatomic, readonly) NSUInteger entryCount;
+
+/**
+ *  The number of lookups that found an image since the counters were last reset
+ */
+@property (nonatomic, readonly) NSUInteger hitCount;
+
+/**
+ *  The number of lookups that did not find an image since the counters were last reset
+ */
+@property (nonatomic, readonly) NSUInteger missCount;
+
+/**
+ *  The number of entries evicted to stay within byteLimit since the counters were last reset
+ */
+@property (nonatomic, readonly) NSUInteger evictionCount;
+
+/**
+ *  Open, or create, a cache in the specified directory. Entries written under a different theme version are removed
+ *
+ *  @param directory The directory holding the cache
+ *  @param themeVersion The version stamp of the current theme
+ *  @param byteLimit The number of bitmap bytes the cache may hold
+ */
+- (instancetype)initWithDirectory:(NSString *)directory
+                     themeVersion:(NSString *)themeVersion
+                        byteLimit:(NSUInteger)byteLimit;
+
+/**
+ *  Return the image stored for the specified digest, or nil. The image's pixels are mapped from disk
+ *
+ *  @param digest The key of the image
+ */
+- (UIImage *)imageForDigest:(uint64_t)digest;
+
+/**
+ *  Store an image for the specified digest. The bitmap is written on a background queue
+ *
+ *  @param image The image to store
+ *  @param digest The key of the image
+ */
+- (void)setImage:(UIImage *)image forDigest:(uint64_t)digest;
+
+/**
+ *  Remove every image from disk
+ */
+- (void)removeAllImages;
+
+/**
+ *  Wait for pending writes and save the index
+ */
+- (void)synchronize;
+
+/**
+ *  Reset hitCount, missCount and evictionCount
+ */
+- (void)resetCounters;
+
+@end
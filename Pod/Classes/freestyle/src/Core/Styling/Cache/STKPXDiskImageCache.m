@@ -0,0 +1,648 @@
+/****************************************************************************
+ *
+ * Copyright 2015-present StylingKit Development Team. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ****************************************************************************/
+
+//
+//  STKPXDiskImageCache.m
+//  StylingKit
+//
+
+#import "STKPXDiskImageCache.h"
+#import "PixateFreestyle.h"
+
+static const uint32_t STKPXDiskImageMagic = 'STKB';
+static const uint32_t STKPXDiskIndexMagic = 'STKI';
+static const uint32_t STKPXDiskIndexVersion = 1;
+static const CGBitmapInfo STKPXDiskBitmapInfo = kCGImageAlphaPremultipliedFirst | kCGBitmapByteOrder32Little;
+static NSString *const STKPXDiskIndexName = @"index";
+
+// header of a bitmap file. It is followed by bytesPerRow * height bytes of pixels in STKPXDiskBitmapInfo layout. The
+// header is 32 bytes so the pixel rows stay aligned in the mapped file
+typedef struct
+{
+    uint32_t magic;
+    uint32_t width;
+    uint32_t height;
+    uint32_t bytesPerRow;
+    float scale;
+    uint32_t reserved[3];
+} STKPXDiskImageHeader;
+
+// header of the index file. It is followed by themeVersionLength bytes of UTF-8 and entryCount index entries
+typedef struct
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t themeVersionLength;
+} STKPXDiskIndexHeader;
+
+typedef struct
+{
+    uint64_t digest;
+    uint64_t lastAccess;
+    uint32_t bytes;
+    uint32_t reserved;
+} STKPXDiskIndexEntry;
+
+#pragma mark - Functions
+
+static uint64_t STKPXDigestBytes(uint64_t hash, const void *bytes, size_t length)
+{
+    const uint8_t *p = bytes;
+
+    // 64-bit FNV-1a
+    for (size_t i = 0; i < length; i++)
+    {
+        hash ^= p[i];
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+static void STKPXReleaseMappedData(void *info, const void *data, size_t size)
+{
+    CFRelease(info);
+}
+
+static UIImage *STKPXImageFromBitmapData(NSData *data)
+{
+    STKPXDiskImageHeader header;
+
+    if (data.length < sizeof(header))
+    {
+        return nil;
+    }
+
+    memcpy(&header, data.bytes, sizeof(header));
+
+    size_t pixelBytes = (size_t) header.bytesPerRow * header.height;
+
+    if (header.magic != STKPXDiskImageMagic
+        || header.width == 0
+        || header.bytesPerRow < header.width * 4
+        || header.scale <= 0.0f
+        || data.length < sizeof(header) + pixelBytes)
+    {
+        return nil;
+    }
+
+    // the provider keeps the mapping alive for as long as the image needs its pixels
+    CGDataProviderRef provider = CGDataProviderCreateWithData((void *) CFBridgingRetain(data),
+                                                              (const uint8_t *) data.bytes + sizeof(header),
+                                                              pixelBytes,
+                                                              STKPXReleaseMappedData);
+    CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+    CGImageRef image = CGImageCreate(header.width, header.height, 8, 32, header.bytesPerRow, colorSpace,
+                                     STKPXDiskBitmapInfo, provider, NULL, false, kCGRenderingIntentDefault);
+    UIImage *result = (image) ? [UIImage imageWithCGImage:image scale:header.scale orientation:UIImageOrientationUp] : nil;
+
+    CGImageRelease(image);
+    CGColorSpaceRelease(colorSpace);
+    CGDataProviderRelease(provider);
+
+    return result;
+}
+
+static NSData *STKPXBitmapDataFromImage(CGImageRef image, CGFloat scale)
+{
+    size_t width = CGImageGetWidth(image);
+    size_t height = CGImageGetHeight(image);
+    size_t bytesPerRow = width * 4;
+
+    if (width == 0 || height == 0 || width > UINT32_MAX / 4 || height > UINT32_MAX)
+    {
+        return nil;
+    }
+
+    NSMutableData *result = [[NSMutableData alloc] initWithLength:sizeof(STKPXDiskImageHeader) + bytesPerRow * height];
+    STKPXDiskImageHeader *header = result.mutableBytes;
+    CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+    CGContextRef context = CGBitmapContextCreate((uint8_t *) result.mutableBytes + sizeof(STKPXDiskImageHeader),
+                                                 width, height, 8, bytesPerRow, colorSpace, STKPXDiskBitmapInfo);
+
+    CGColorSpaceRelease(colorSpace);
+
+    if (context == NULL)
+    {
+        return nil;
+    }
+
+    CGContextSetBlendMode(context, kCGBlendModeCopy);
+    CGContextDrawImage(context, CGRectMake(0.0f, 0.0f, width, height), image);
+    CGContextRelease(context);
+
+    header->magic = STKPXDiskImageMagic;
+    header->width = (uint32_t) width;
+    header->height = (uint32_t) height;
+    header->bytesPerRow = (uint32_t) bytesPerRow;
+    header->scale = (float) scale;
+
+    return result;
+}
+
+@implementation STKPXDiskImageCache
+{
+    dispatch_queue_t ioQueue_;
+    NSMutableDictionary *entries_;
+    uint64_t clock_;
+    BOOL indexDirty_;
+    BOOL indexSaveScheduled_;
+}
+
+#pragma mark - Static Methods
+
++ (instancetype)sharedInstance
+{
+    static STKPXDiskImageCache *sharedInstance;
+    static dispatch_once_t onceToken;
+
+    dispatch_once(&onceToken, ^{
+        NSString *caches = NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES).firstObject;
+        NSString *directory = [caches stringByAppendingPathComponent:@"StylingKit/Images"];
+
+        sharedInstance = [self cacheWithDirectory:directory configuration:PixateFreestyle.configuration];
+    });
+
+    return sharedInstance;
+}
+
++ (instancetype)cacheWithDirectory:(NSString *)directory configuration:(PixateFreestyleConfiguration *)configuration
+{
+    // open the index under the configured stamp, so entries from the previous launch are kept when it hasn't changed
+    return [[self alloc] initWithDirectory:directory
+                              themeVersion:configuration.diskImageCacheVersion
+                                 byteLimit:configuration.diskImageCacheSize];
+}
+
++ (uint64_t)digestForStyleHash:(NSUInteger)styleHash size:(CGSize)size scale:(CGFloat)scale
+{
+    return [self digestForStyleHash:styleHash size:size scale:scale assetURLs:nil];
+}
+
++ (uint64_t)digestForStyleHash:(NSUInteger)styleHash
+                          size:(CGSize)size
+                         scale:(CGFloat)scale
+                     assetURLs:(NSArray *)assetURLs
+{
+    uint64_t hash = 14695981039346656037ULL;
+    uint64_t style = styleHash;
+    double inputs[3] = { size.width, size.height, scale };
+
+    hash = STKPXDigestBytes(hash, &style, sizeof(style));
+    hash = STKPXDigestBytes(hash, inputs, sizeof(inputs));
+
+    for (NSURL *URL in assetURLs)
+    {
+        // the whole URL, since NSString hashes only sample long strings such as data URLs
+        NSData *name = [URL.absoluteString dataUsingEncoding:NSUTF8StringEncoding];
+
+        hash = STKPXDigestBytes(hash, name.bytes, name.length);
+
+        // an edited file gets a new key rather than its stale rendering
+        if (URL.isFileURL)
+        {
+            NSDictionary *attributes = [[NSFileManager defaultManager] attributesOfItemAtPath:URL.path error:NULL];
+            double stamp[2] = {
+                [attributes fileModificationDate].timeIntervalSinceReferenceDate,
+                (double) [attributes fileSize]
+            };
+
+            hash = STKPXDigestBytes(hash, stamp, sizeof(stamp));
+        }
+    }
+
+    return hash;
+}
+
+#pragma mark - Initializers
+
+- (instancetype)initWithDirectory:(NSString *)directory
+                     themeVersion:(NSString *)themeVersion
+                        byteLimit:(NSUInteger)byteLimit
+{
+    if (self = [super init])
+    {
+        _directory = [directory copy];
+        _themeVersion = (themeVersion) ? [themeVersion copy] : @"";
+        _byteLimit = byteLimit;
+
+        ioQueue_ = dispatch_queue_create("com.stylingkit.disk-image-cache", DISPATCH_QUEUE_SERIAL);
+        entries_ = [[NSMutableDictionary alloc] init];
+
+        [[NSFileManager defaultManager] createDirectoryAtPath:_directory
+                                  withIntermediateDirectories:YES
+                                                   attributes:nil
+                                                        error:NULL];
+
+        if (![self loadIndex])
+        {
+            // the index is missing, unreadable or stamped with another theme version, so nothing on disk is trusted
+            [self removeAllImages];
+        }
+
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(applicationDidEnterBackground:)
+                                                     name:UIApplicationDidEnterBackgroundNotification
+                                                   object:nil];
+    }
+
+    return self;
+}
+
+- (void)dealloc
+{
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+}
+
+#pragma mark - Getters
+
+- (NSUInteger)entryCount
+{
+    @synchronized(self)
+    {
+        return entries_.count;
+    }
+}
+
+#pragma mark - Setters
+
+- (void)setThemeVersion:(NSString *)themeVersion
+{
+    themeVersion = (themeVersion) ? themeVersion : @"";
+
+    @synchronized(self)
+    {
+        if ([_themeVersion isEqualToString:themeVersion])
+        {
+            return;
+        }
+
+        _themeVersion = [themeVersion copy];
+    }
+
+    [self removeAllImages];
+}
+
+- (void)setByteLimit:(NSUInteger)byteLimit
+{
+    NSArray *evicted;
+
+    @synchronized(self)
+    {
+        if (_byteLimit == byteLimit)
+        {
+            return;
+        }
+
+        _byteLimit = byteLimit;
+        evicted = [self evictEntries];
+    }
+
+    if (evicted.count > 0)
+    {
+        dispatch_async(ioQueue_, ^{
+            [self removeFilesForDigests:evicted];
+        });
+
+        [self scheduleIndexSave];
+    }
+}
+
+#pragma mark - Methods
+
+- (UIImage *)imageForDigest:(uint64_t)digest
+{
+    NSNumber *key = @(digest);
+
+    @synchronized(self)
+    {
+        NSValue *value = entries_[key];
+
+        if (value == nil)
+        {
+            _missCount++;
+
+            return nil;
+        }
+
+        // recency is only persisted with the next index save, so a hit never writes to disk
+        STKPXDiskIndexEntry entry;
+
+        [value getValue:&entry];
+        entry.lastAccess = ++clock_;
+        entries_[key] = [NSValue valueWithBytes:&entry objCType:@encode(STKPXDiskIndexEntry)];
+        indexDirty_ = YES;
+    }
+
+    NSData *data = [NSData dataWithContentsOfFile:[self pathForDigest:digest]
+                                          options:NSDataReadingMappedAlways
+                                            error:NULL];
+    UIImage *result = STKPXImageFromBitmapData(data);
+
+    @synchronized(self)
+    {
+        if (result)
+        {
+            _hitCount++;
+        }
+        else
+        {
+            // the file went missing or is damaged, so forget about it
+            [self removeEntryForKey:key];
+            _missCount++;
+        }
+    }
+
+    return result;
+}
+
+- (void)setImage:(UIImage *)image forDigest:(uint64_t)digest
+{
+    CGImageRef cgImage = image.CGImage;
+
+    if (cgImage == NULL)
+    {
+        return;
+    }
+
+    CGFloat scale = image.scale;
+
+    CGImageRetain(cgImage);
+
+    dispatch_async(ioQueue_, ^{
+        NSData *data = STKPXBitmapDataFromImage(cgImage, scale);
+
+        CGImageRelease(cgImage);
+
+        if (data == nil || ![data writeToFile:[self pathForDigest:digest] atomically:YES])
+        {
+            return;
+        }
+
+        NSArray *evicted;
+
+        @synchronized(self)
+        {
+            NSNumber *key = @(digest);
+            STKPXDiskIndexEntry entry = { digest, ++clock_, (uint32_t) data.length, 0 };
+
+            [self removeEntryForKey:key];
+            entries_[key] = [NSValue valueWithBytes:&entry objCType:@encode(STKPXDiskIndexEntry)];
+            _totalBytes += entry.bytes;
+            indexDirty_ = YES;
+
+            evicted = [self evictEntries];
+        }
+
+        [self removeFilesForDigests:evicted];
+        [self scheduleIndexSave];
+    });
+}
+
+- (void)removeAllImages
+{
+    // forget the entries right away so lookups miss while the files are being removed
+    @synchronized(self)
+    {
+        [entries_ removeAllObjects];
+        _totalBytes = 0;
+    }
+
+    dispatch_async(ioQueue_, ^{
+        NSFileManager *fileManager = [NSFileManager defaultManager];
+
+        // writes queued before this call may have registered entries since
+        @synchronized(self)
+        {
+            [entries_ removeAllObjects];
+            _totalBytes = 0;
+            indexDirty_ = YES;
+        }
+
+        for (NSString *name in [fileManager contentsOfDirectoryAtPath:_directory error:NULL])
+        {
+            if ([name.pathExtension isEqualToString:@"bitmap"])
+            {
+                [fileManager removeItemAtPath:[_directory stringByAppendingPathComponent:name] error:NULL];
+            }
+        }
+
+        [self scheduleIndexSave];
+    });
+}
+
+- (void)synchronize
+{
+    dispatch_sync(ioQueue_, ^{
+        [self saveIndex];
+    });
+}
+
+- (void)resetCounters
+{
+    @synchronized(self)
+    {
+        _hitCount = 0;
+        _missCount = 0;
+        _evictionCount = 0;
+    }
+}
+
+#pragma mark - Private Methods
+
+- (NSString *)pathForDigest:(uint64_t)digest
+{
+    return [_directory stringByAppendingPathComponent:[NSString stringWithFormat:@"%016llx.bitmap", digest]];
+}
+
+- (void)removeEntryForKey:(NSNumber *)key
+{
+    NSValue *value = entries_[key];
+
+    if (value)
+    {
+        STKPXDiskIndexEntry entry;
+
+        [value getValue:&entry];
+        _totalBytes -= entry.bytes;
+        [entries_ removeObjectForKey:key];
+        indexDirty_ = YES;
+    }
+}
+
+// must be called while synchronized on self. Returns the digests whose files should be removed
+- (NSArray *)evictEntries
+{
+    if (_totalBytes <= _byteLimit)
+    {
+        return nil;
+    }
+
+    NSArray *keys = [entries_ keysSortedByValueUsingComparator:^NSComparisonResult(NSValue *a, NSValue *b) {
+        STKPXDiskIndexEntry entryA;
+        STKPXDiskIndexEntry entryB;
+
+        [a getValue:&entryA];
+        [b getValue:&entryB];
+
+        if (entryA.lastAccess == entryB.lastAccess)
+        {
+            return NSOrderedSame;
+        }
+
+        return (entryA.lastAccess < entryB.lastAccess) ? NSOrderedAscending : NSOrderedDescending;
+    }];
+    NSMutableArray *result = [[NSMutableArray alloc] init];
+
+    for (NSNumber *key in keys)
+    {
+        if (_totalBytes <= _byteLimit)
+        {
+            break;
+        }
+
+        [self removeEntryForKey:key];
+        [result addObject:key];
+        _evictionCount++;
+    }
+
+    return result;
+}
+
+// must be called on the io queue
+- (void)removeFilesForDigests:(NSArray *)digests
+{
+    NSFileManager *fileManager = [NSFileManager defaultManager];
+
+    for (NSNumber *digest in digests)
+    {
+        [fileManager removeItemAtPath:[self pathForDigest:digest.unsignedLongLongValue] error:NULL];
+    }
+}
+
+- (void)scheduleIndexSave
+{
+    @synchronized(self)
+    {
+        if (indexSaveScheduled_)
+        {
+            return;
+        }
+
+        indexSaveScheduled_ = YES;
+    }
+
+    // the queue is serial, so a burst of writes shares the save queued behind them
+    dispatch_async(ioQueue_, ^{
+        [self saveIndex];
+    });
+}
+
+// must be called on the io queue
+- (void)saveIndex
+{
+    NSMutableData *data;
+
+    @synchronized(self)
+    {
+        indexSaveScheduled_ = NO;
+
+        if (!indexDirty_)
+        {
+            return;
+        }
+
+        NSData *themeVersion = [_themeVersion dataUsingEncoding:NSUTF8StringEncoding];
+        STKPXDiskIndexHeader header = {
+            STKPXDiskIndexMagic,
+            STKPXDiskIndexVersion,
+            (uint32_t) entries_.count,
+            (uint32_t) themeVersion.length
+        };
+
+        data = [[NSMutableData alloc] initWithCapacity:sizeof(header) + header.themeVersionLength
+                                                       + header.entryCount * sizeof(STKPXDiskIndexEntry)];
+        [data appendBytes:&header length:sizeof(header)];
+        [data appendData:themeVersion];
+
+        for (NSValue *value in entries_.objectEnumerator)
+        {
+            STKPXDiskIndexEntry entry;
+
+            [value getValue:&entry];
+            [data appendBytes:&entry length:sizeof(entry)];
+        }
+
+        indexDirty_ = NO;
+    }
+
+    [data writeToFile:[_directory stringByAppendingPathComponent:STKPXDiskIndexName] atomically:YES];
+}
+
+- (BOOL)loadIndex
+{
+    NSData *data = [NSData dataWithContentsOfFile:[_directory stringByAppendingPathComponent:STKPXDiskIndexName]];
+    STKPXDiskIndexHeader header;
+
+    if (data.length < sizeof(header))
+    {
+        return NO;
+    }
+
+    [data getBytes:&header length:sizeof(header)];
+
+    NSUInteger entriesOffset = sizeof(header) + header.themeVersionLength;
+
+    if (header.magic != STKPXDiskIndexMagic
+        || header.version != STKPXDiskIndexVersion
+        || data.length != entriesOffset + (NSUInteger) header.entryCount * sizeof(STKPXDiskIndexEntry))
+    {
+        return NO;
+    }
+
+    NSString *themeVersion = [[NSString alloc] initWithBytes:(const uint8_t *) data.bytes + sizeof(header)
+                                                      length:header.themeVersionLength
+                                                    encoding:NSUTF8StringEncoding];
+
+    if (![themeVersion isEqualToString:_themeVersion])
+    {
+        return NO;
+    }
+
+    const uint8_t *bytes = (const uint8_t *) data.bytes + entriesOffset;
+
+    for (uint32_t i = 0; i < header.entryCount; i++)
+    {
+        STKPXDiskIndexEntry entry;
+
+        memcpy(&entry, bytes + i * sizeof(entry), sizeof(entry));
+        entries_[@(entry.digest)] = [NSValue valueWithBytes:&entry objCType:@encode(STKPXDiskIndexEntry)];
+        _totalBytes += entry.bytes;
+        clock_ = MAX(clock_, entry.lastAccess);
+    }
+
+    return YES;
+}
+
+- (void)applicationDidEnterBackground:(NSNotification *)notification
+{
+    [self scheduleIndexSave];
+}
+
+@end
@@ -0,0 +1,77 @@
+/****************************************************************************
+ *
+ * Copyright 2015-present StylingKit Development Team. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ****************************************************************************/
+
+//
+//  STKPXRenderPipeline.h
+//  StylingKit
+//
+
+#import <UIKit/UIKit.h>
+
+typedef UIImage *(^STKPXRenderBlock)(void);
+typedef void (^STKPXRenderCompletionBlock)(UIImage *image);
+
+/**
+ *  STKPXRenderPipeline renders background images off the main thread. Jobs are keyed by their image cache key: a request
+ *  for a key that is already being rendered joins that job instead of rendering the image again. Finished images are
+ *  stored in the image cache and handed to every waiting completion block on the main queue.
+ */
+@interface STKPXRenderPipeline : NSObject
+
+/**
+ *  The shared pipeline used by STKPXStylerContext
+ */
++ (instancetype)sharedInstance;
+
+/**
+ *  The number of jobs currently queued or rendering
+ */
+@property (nonatomic, readonly) NSUInteger queueDepth;
+
+/**
+ *  The largest queueDepth seen since the counters were last reset
+ */
+@property (nonatomic, readonly) NSUInteger peakQueueDepth;
+
+/**
+ *  The number of requests that joined a job already in flight
+ */
+@property (nonatomic, readonly) NSUInteger dedupHits;
+
+/**
+ *  The number of jobs rendered
+ */
+@property (nonatomic, readonly) NSUInteger renderCount;
+
+/**
+ *  Render an image on a background queue unless a job for the same key is already in flight
+ *
+ *  @param key The image cache key of the image
+ *  @param render The block producing the image. It runs on a background queue and must not touch UIKit views
+ *  @param completion Called on the main queue with the rendered image
+ */
+- (void)renderImageForKey:(NSNumber *)key
+                withBlock:(STKPXRenderBlock)render
+               completion:(STKPXRenderCompletionBlock)completion;
+
+/**
+ *  Reset peakQueueDepth, dedupHits and renderCount
+ */
+- (void)resetCounters;
+
+@end
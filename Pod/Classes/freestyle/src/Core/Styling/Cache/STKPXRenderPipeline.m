@@ -0,0 +1,124 @@
+/****************************************************************************
+ *
+ * Copyright 2015-present StylingKit Development Team. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ****************************************************************************/
+
+//
+//  STKPXRenderPipeline.m
+//  StylingKit
+//
+
+#import "STKPXRenderPipeline.h"
+#import "STKPXCacheManager.h"
+#import "PixateFreestyle.h"
+
+@implementation STKPXRenderPipeline
+{
+    dispatch_queue_t renderQueue_;
+    NSMutableDictionary *jobs_;
+}
+
+#pragma mark - Static Methods
+
++ (instancetype)sharedInstance
+{
+    static STKPXRenderPipeline *sharedInstance;
+    static dispatch_once_t onceToken;
+
+    dispatch_once(&onceToken, ^{
+        sharedInstance = [[STKPXRenderPipeline alloc] init];
+    });
+
+    return sharedInstance;
+}
+
+#pragma mark - Initializers
+
+- (instancetype)init
+{
+    if (self = [super init])
+    {
+        renderQueue_ = dispatch_queue_create("com.stylingkit.render", DISPATCH_QUEUE_CONCURRENT);
+        jobs_ = [[NSMutableDictionary alloc] init];
+    }
+
+    return self;
+}
+
+#pragma mark - Methods
+
+- (void)renderImageForKey:(NSNumber *)key
+                withBlock:(STKPXRenderBlock)render
+               completion:(STKPXRenderCompletionBlock)completion
+{
+    @synchronized(self)
+    {
+        NSMutableArray *waiters = jobs_[key];
+
+        if (waiters)
+        {
+            [waiters addObject:[completion copy]];
+            _dedupHits++;
+
+            return;
+        }
+
+        jobs_[key] = [[NSMutableArray alloc] initWithObjects:[completion copy], nil];
+        _queueDepth++;
+        _peakQueueDepth = MAX(_peakQueueDepth, _queueDepth);
+    }
+
+    dispatch_async(renderQueue_, ^{
+        UIImage *image = render();
+
+        if (image && PixateFreestyle.configuration.cacheImages)
+        {
+            // estimate cost as number of pixels times 4 bytes per pixel. This is probably lower than actual
+            NSUInteger cost = image.size.width * image.size.height * 4;
+
+            [STKPXCacheManager setImage:image forKey:key cost:cost];
+        }
+
+        dispatch_async(dispatch_get_main_queue(), ^{
+            NSArray *waiters;
+
+            @synchronized(self)
+            {
+                waiters = jobs_[key];
+                [jobs_ removeObjectForKey:key];
+                _queueDepth--;
+                _renderCount++;
+            }
+
+            for (STKPXRenderCompletionBlock waiter in waiters)
+            {
+                waiter(image);
+            }
+        });
+    });
+}
+
+- (void)resetCounters
+{
+    @synchronized(self)
+    {
+        _peakQueueDepth = _queueDepth;
+        _dedupHits = 0;
+        _renderCount = 0;
+    }
+}
+
+@end
@@ -39,9 +39,9 @@
 - (id)initWithStyleKey:(NSString *)styleKey;
 
 - (void)addDeclarations:(NSArray *)declarations forState:(NSString *)stateName;
-- (void)addStylers:(NSSet *)stylers forState:(NSString *)stateName;
+- (void)addStylerBuckets:(NSArray *)buckets forState:(NSString *)stateName;
 - (NSArray *)declarationsForState:(NSString *)stateName;
-- (NSSet *)stylersForState:(NSString *)stateName;
+- (NSArray *)stylerBucketsForState:(NSString *)stateName;
 
 - (void)applyToStyleable:(id<STKPXStyleable>)styleable;
 
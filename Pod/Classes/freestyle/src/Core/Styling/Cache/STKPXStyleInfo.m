@@ -30,13 +30,14 @@
 #import "STKPXRuleSet.h"
 #import "STKPXTypeSelector.h"
 #import "STKPXStyler.h"
+#import "STKPXStylerDispatchTable.h"
 #import "NSObject+STKPXStyling.h"
 #import "STKPXPseudoClassFunction.h"
 
 @implementation STKPXStyleInfo
 {
     NSMutableDictionary *declarationsByState_;
-    NSMutableDictionary *stylersByState_;
+    NSMutableDictionary *stylerBucketsByState_;
 }
 
 STK_DEFINE_CLASS_LOG_LEVEL;
@@ -120,23 +121,30 @@ STK_DEFINE_CLASS_LOG_LEVEL;
             ? styleable.supportedPseudoClasses
             : nil;
 
+        // order by specificity once. Each state's bucket keeps that order, so merging a state doesn't sort again
+        NSArray *sortedRuleSets = [STKPXRuleSet sortRuleSetsBySpecificity:ruleSets];
+
         // style pseudo-classes
         if (pseudoClasses.count > 0)
         {
-            for (NSString *pseudoClass in pseudoClasses)
+            // split the rule sets into the states they specify in a single pass
+            NSArray *ruleSetsByState = [STKPXStyleUtils partitionRuleSets:sortedRuleSets
+                                                             forStyleable:styleable
+                                                                 byStates:pseudoClasses];
+
+            for (NSUInteger i = 0; i < pseudoClasses.count; i++)
             {
-                // filter the list of rule sets to only those that specify the current state
-                NSArray *ruleSetsForState = [STKPXStyleUtils filterRuleSets:ruleSets forStyleable:styleable byState:pseudoClass];
+                NSArray *ruleSetsForState = ruleSetsByState[i];
 
                 if (ruleSetsForState.count > 0)
                 {
-                    [self setStyleInfo:result withRuleSets:ruleSetsForState styleable:styleable stateName:pseudoClass];
+                    [self setStyleInfo:result withSortedRuleSets:ruleSetsForState styleable:styleable stateName:pseudoClasses[i]];
                 }
             }
         }
         else
         {
-            [self setStyleInfo:result withRuleSets:ruleSets styleable:styleable stateName:@""];
+            [self setStyleInfo:result withSortedRuleSets:sortedRuleSets styleable:styleable stateName:@""];
         }
     }
 
@@ -148,44 +156,37 @@ STK_DEFINE_CLASS_LOG_LEVEL;
            styleable:(id<STKPXStyleable>)styleable
            stateName:(NSString *)stateName
 {
-    // merge all rule sets into a single rule set based on origin and weight/specificity
-    STKPXRuleSet *mergedRuleSet = [STKPXRuleSet ruleSetWithMergedRuleSets:ruleSets];
+    [self setStyleInfo:styleInfo
+    withSortedRuleSets:[STKPXRuleSet sortRuleSetsBySpecificity:ruleSets]
+             styleable:styleable
+             stateName:stateName];
+}
 
-    NSArray *stylers = ([styleable respondsToSelector:@selector(viewStylers)])
-        ? ((NSObject *)styleable).viewStylers
-        : nil;
-    NSDictionary *stylersByProperty = ([styleable respondsToSelector:@selector(viewStylersByProperty)])
-        ? ((NSObject *)styleable).viewStylersByProperty
-        : nil;
++ (void)setStyleInfo:(STKPXStyleInfo *)styleInfo
+  withSortedRuleSets:(NSArray *)ruleSets
+           styleable:(id<STKPXStyleable>)styleable
+           stateName:(NSString *)stateName
+{
+    // merge all rule sets into a single rule set based on origin and weight/specificity
+    STKPXRuleSet *mergedRuleSet = [STKPXRuleSet ruleSetWithMergedSortedRuleSets:ruleSets];
 
-    // build a set of stylers that are active based on the property names we have in the merged rule set
-    NSMutableSet *activeStylers = [[NSMutableSet alloc] init];
+    STKPXStylerDispatchTable *dispatchTable = [STKPXStylerDispatchTable dispatchTableForStyleable:styleable];
 
     // keep track of active declarations
     NSMutableArray *activeDeclarations = [[NSMutableArray alloc] init];
-    // NSMutableArray *inactiveDeclarations = [[NSMutableArray alloc] init];
 
     for (STKPXDeclaration *declaration in mergedRuleSet.declarations)
     {
-        id<STKPXStyler> styler = stylersByProperty[declaration.name];
-
-        if (styler)
+        if (dispatchTable == nil || [dispatchTable slotForProperty:declaration.name] != NSNotFound)
         {
             [activeDeclarations addObject:declaration];
-            [activeStylers addObject:NSStringFromClass(styler.class)];
         }
-        else if (stylers == nil)
-        {
-            [activeDeclarations addObject:declaration];
-        }
-        // else
-        // {
-        //     [inactiveDeclarations addObject:declaration];
-        // }
     }
 
     [styleInfo addDeclarations:activeDeclarations forState:stateName];
-    [styleInfo addStylers:activeStylers forState:stateName];
+
+    // bucket the declarations by the styler that processes them, so applying a state is a single pass over stylers
+    [styleInfo addStylerBuckets:[dispatchTable bucketsForDeclarations:activeDeclarations] forState:stateName];
 }
 
 #pragma mark - Initializers
@@ -224,16 +225,16 @@ STK_DEFINE_CLASS_LOG_LEVEL;
     }
 }
 
-- (void)addStylers:(NSSet *)stylers forState:(NSString *)stateName
+- (void)addStylerBuckets:(NSArray *)buckets forState:(NSString *)stateName
 {
-    if (stylers.count > 0 && stateName != nil)
+    if (buckets.count > 0 && stateName != nil)
     {
-        if (stylersByState_ == nil)
+        if (stylerBucketsByState_ == nil)
         {
-            stylersByState_ = [NSMutableDictionary dictionary];
+            stylerBucketsByState_ = [NSMutableDictionary dictionary];
         }
 
-        stylersByState_[stateName] = stylers;
+        stylerBucketsByState_[stateName] = buckets;
     }
 }
 
@@ -242,9 +243,9 @@ STK_DEFINE_CLASS_LOG_LEVEL;
     return (declarationsByState_ != nil) ? declarationsByState_[stateName] : nil;
 }
 
-- (NSSet *)stylersForState:(NSString *)stateName
+- (NSArray *)stylerBucketsForState:(NSString *)stateName
 {
-    return (stylersByState_ != nil) ? stylersByState_[stateName] : nil;
+    return (stylerBucketsByState_ != nil) ? stylerBucketsByState_[stateName] : nil;
 }
 
 - (void)applyToStyleable:(id<STKPXStyleable>)styleable
@@ -256,12 +257,7 @@ STK_DEFINE_CLASS_LOG_LEVEL;
         return;
     }
 
-    NSArray *stylers = ([styleable respondsToSelector:@selector(viewStylers)])
-        ? ((NSObject *)styleable).viewStylers
-        : nil;
-    NSDictionary *stylersByProperty = ([styleable respondsToSelector:@selector(viewStylersByProperty)])
-        ? ((NSObject *)styleable).viewStylersByProperty
-        : nil;
+    STKPXStylerDispatchTable *dispatchTable = [STKPXStylerDispatchTable dispatchTableForStyleable:styleable];
 
     for (NSString *stateName in self.states)
     {
@@ -286,34 +282,39 @@ STK_DEFINE_CLASS_LOG_LEVEL;
                            matchDeclarations:activeDeclarations
                                        state:stateName])
         {
-            NSSet *activeStylers = [self stylersForState:stateName];
+            NSArray *buckets = [self stylerBucketsForState:stateName];
 
-            // create context and store styleable and state name there
-            STKPXStylerContext *context = [[STKPXStylerContext alloc] init];
+            // grab a context and store styleable and state name there
+            STKPXStylerContext *context = [STKPXStylerContext dequeueReusableContext];
 
             context.styleable = styleable;
             context.activeStateName = stateName;
             context.styleHash = [STKPXStyleUtils hashValueForStyleable:styleable state:stateName];
 
-            // process declarations in styler order
-            for (id<STKPXStyler> currentStyler in stylers)
+            // style infos are shared by styleables with the same style key. If this one was built against a different
+            // list of stylers, re-bucket its declarations for ours
+            for (STKPXStylerBucket *bucket in buckets)
             {
-                if ([activeStylers containsObject:NSStringFromClass(currentStyler.class)])
+                if ([dispatchTable stylerForBucket:bucket] == nil)
                 {
-                    // process the declarations, in order
-                    for (STKPXDeclaration *declaration in activeDeclarations)
-                    {
-                        id<STKPXStyler> styler = stylersByProperty[declaration.name];
-
-                        if (styler == currentStyler)
-                        {
-                            [styler processDeclaration:declaration withContext:context];
-                        }
-                    }
+                    buckets = [dispatchTable bucketsForDeclarations:activeDeclarations];
+                    break;
+                }
+            }
 
-                    // apply styler completion block
-                    [currentStyler applyStylesWithContext:context];
+            // process declarations in styler order
+            for (STKPXStylerBucket *bucket in buckets)
+            {
+                id<STKPXStyler> styler = [dispatchTable stylerForBucket:bucket];
+
+                // process the declarations, in order
+                for (STKPXDeclaration *declaration in bucket.declarations)
+                {
+                    [styler processDeclaration:declaration withContext:context];
                 }
+
+                // apply styler completion block
+                [styler applyStylesWithContext:context];
             }
 
             // see if there's a catch-all 'updateStyleWithRuleSet:context:' method to call
@@ -334,6 +335,8 @@ STK_DEFINE_CLASS_LOG_LEVEL;
             {
                 [STKPXStyleUtils stylesOfStyleable:styleable matchDeclarations:activeDeclarations state:stateName];
             }
+
+            [STKPXStylerContext recycleContext:context];
         }
     }
 }
@@ -31,6 +31,17 @@
 + (void)addStylingSubclass:(NSString *)className;
 + (BOOL)hasStylingSubclass:(NSString *)className;
 + (void)removeStylingSubclass:(NSString *)className;
+
+/**
+ *  Returns the styling subclass used for instances of viewClass, or nil. Results, including misses, are cached per
+ *  class until a styling subclass is added or removed
+ */
++ (Class)stylingSubclassForClass:(Class)viewClass;
+
+/**
+ *  Resolves the styling subclass for viewClass by walking the registered subclasses, bypassing the cache
+ */
++ (Class)resolveStylingSubclassForClass:(Class)viewClass;
 + (void)registerDynamicSubclass:(Class)subclass withElementName:(NSString *)elementName;
 + (void)registerDynamicSubclass:(Class)subclass forClass:(Class)superClass withElementName:(NSString *)elementName;
 
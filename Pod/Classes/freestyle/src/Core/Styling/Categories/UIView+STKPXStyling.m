@@ -36,6 +36,8 @@
 #import "NSDictionary+STKPXCSSEncoding.h"
 #import "STKPXRuntimeUtils.h"
 #import "STKPXUtils.h"
+#import "STKPXStylesheetParser.h"
+#import "STKPXRuleSet.h"
 #import "NSMutableArray+QueueAdditions.h"
 #import "NSObject+STKPXClass.h"
 #import "NSObject+STKPXStyling.h"
@@ -43,6 +45,7 @@
 #import "UIView+STKPXStyling-Private.h"
 #import "NSObject+STKPXSwizzle.h"
 #import "STK_UIAlertControllerView.h"
+#import "STKPXRestyleScheduler.h"
 
 static const char STYLE_ELEMENT_NAME_KEY;
 static const char STYLE_CLASS_KEY;
@@ -53,8 +56,15 @@ static const char STYLE_CSS_KEY;
 static const char STYLE_MODE_KEY;
 static const char KVC_DICTIONARY;
 static const char KVC_SET;
+static const char KVC_DECLARATIONS;
+static const char INLINE_RULE_SET_KEY;
 
-static Class SubclassForViewWithClass(UIView *view, Class viewClass);
+static Class SubclassForView(UIView *view);
+static Class CachedSubclassForClass(Class viewClass);
+static Class SubclassForViewWithClass(Class viewClass);
+static Class SubclassForViewWithClassInSubclasses(Class viewClass, NSArray *subclasses);
+static void InitializeSubclassCache(void);
+static void InvalidateSubclassCache(void);
 
 void STKPXForceLoadUIViewPXStyling() {}
 
@@ -66,15 +76,24 @@ void STKPXForceLoadUIViewPXStyling() {}
 STK_DEFINE_CLASS_LOG_LEVEL;
 
 
+// Guarded by SUBCLASS_CACHE_LOCK
 static NSMutableArray *DYNAMIC_SUBCLASSES;
 
+// Class -> styling subclass, or kCFNull when a class has none. Guarded by SUBCLASS_CACHE_LOCK
+static CFMutableDictionaryRef SUBCLASS_CACHE;
+static NSUInteger SUBCLASS_CACHE_GENERATION;
+static NSObject *SUBCLASS_CACHE_LOCK;
+
 #pragma mark - Static Methods
 
 + (void)setElementName:(NSString *)elementName forClass:(Class)class
 {
-    if (elementName && class)
+    if (elementName && class && ![[self elementNameForClass:class] isEqualToString:elementName])
     {
         objc_setAssociatedObject(class, &STYLE_ELEMENT_NAME_KEY, elementName, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+
+        // element names are part of every style key
+        [STKPXStyleUtils invalidateStyleKeys];
     }
 }
 
@@ -90,20 +109,30 @@ static NSMutableArray *DYNAMIC_SUBCLASSES;
 
 + (void)addStylingSubclass:(NSString *)className
 {
-    if(DYNAMIC_SUBCLASSES == nil)
-    {
-        DYNAMIC_SUBCLASSES = [[NSMutableArray alloc] init];
-    }
+    InitializeSubclassCache();
 
     if (className)
     {
-        [DYNAMIC_SUBCLASSES addObject:NSClassFromString(className)];
+        Class class = NSClassFromString(className);
+
+        @synchronized(SUBCLASS_CACHE_LOCK)
+        {
+            [DYNAMIC_SUBCLASSES addObject:class];
+            InvalidateSubclassCache();
+        }
     }
 }
 
 + (BOOL)hasStylingSubclass:(NSString *)className
 {
-    return ([DYNAMIC_SUBCLASSES indexOfObject:NSClassFromString(className)] != NSNotFound);
+    InitializeSubclassCache();
+
+    Class class = NSClassFromString(className);
+
+    @synchronized(SUBCLASS_CACHE_LOCK)
+    {
+        return ([DYNAMIC_SUBCLASSES indexOfObject:class] != NSNotFound);
+    }
 }
 
 - (BOOL)isSubclassable
@@ -113,7 +142,25 @@ static NSMutableArray *DYNAMIC_SUBCLASSES;
 
 + (void)removeStylingSubclass:(NSString *)className
 {
-    [DYNAMIC_SUBCLASSES removeObject:NSClassFromString(className)];
+    InitializeSubclassCache();
+
+    Class class = NSClassFromString(className);
+
+    @synchronized(SUBCLASS_CACHE_LOCK)
+    {
+        [DYNAMIC_SUBCLASSES removeObject:class];
+        InvalidateSubclassCache();
+    }
+}
+
++ (Class)stylingSubclassForClass:(Class)viewClass
+{
+    return CachedSubclassForClass(viewClass);
+}
+
++ (Class)resolveStylingSubclassForClass:(Class)viewClass
+{
+    return SubclassForViewWithClass(viewClass);
 }
 
 + (void)registerDynamicSubclass:(Class)subclass forClass:(Class)superClass withElementName:(NSString *)elementName
@@ -173,7 +220,7 @@ static NSMutableArray *DYNAMIC_SUBCLASSES;
     }
 
     // Grabbing Pixate's subclass of this instance
-    Class viewDynamicSubclass = SubclassForViewWithClass(self, nil);
+    Class viewDynamicSubclass = SubclassForView(self);
 
     if(viewDynamicSubclass)
     {
@@ -282,7 +329,8 @@ static NSMutableArray *DYNAMIC_SUBCLASSES;
 
         if (name)
         {
-            [UIView setElementName:name forClass:self.class];
+            // remembering the inherited name doesn't change any style key, so skip the invalidation
+            objc_setAssociatedObject(self.class, &STYLE_ELEMENT_NAME_KEY, name, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
         }
     }
 
@@ -338,7 +386,66 @@ static NSMutableArray *DYNAMIC_SUBCLASSES;
 
 - (NSString *)styleKey
 {
-    return [STKPXStyleUtils styleKeyFromStyleable:self];
+    return [STKPXStyleUtils cachedStyleKeyForStyleable:self];
+}
+
+- (STKPXRuleSet *)inlineRuleSet
+{
+    STKPXRuleSet *ruleSet = objc_getAssociatedObject(self, &INLINE_RULE_SET_KEY);
+
+    if (ruleSet == nil)
+    {
+        NSMutableDictionary *declarations = objc_getAssociatedObject(self, &KVC_DECLARATIONS);
+
+        if (declarations != nil)
+        {
+            // KVC properties were parsed one at a time as they were set, so only assemble them in the order of
+            // their first assignment, as styleCSS would list them
+            NSMutableOrderedSet *set = objc_getAssociatedObject(self, &KVC_SET);
+            BOOL hasValues = NO;
+
+            ruleSet = [[STKPXRuleSet alloc] init];
+
+            for (NSString *key in set)
+            {
+                NSArray *keyDeclarations = declarations[key];
+
+                if (keyDeclarations != nil)
+                {
+                    hasValues = YES;
+
+                    for (STKPXDeclaration *declaration in keyDeclarations)
+                    {
+                        [ruleSet addDeclaration:declaration];
+                    }
+                }
+            }
+
+            if (hasValues == NO)
+            {
+                return nil;
+            }
+        }
+        else
+        {
+            NSString *source = objc_getAssociatedObject(self, &STYLE_CSS_KEY);
+
+            if (source.length == 0)
+            {
+                return nil;
+            }
+
+            ruleSet = [[[STKPXStylesheetParser alloc] init] parseInlineCSS:source].ruleSets.firstObject;
+        }
+
+        // match what adding the rule set to an inline stylesheet would have done
+        [ruleSet.specificity setSpecificity:kSpecificityTypeOrigin toValue:STKPXStylesheetOriginInline];
+        [ruleSet updateStateMask];
+
+        objc_setAssociatedObject(self, &INLINE_RULE_SET_KEY, ruleSet, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+    }
+
+    return ruleSet;
 }
 
 - (void)setStyleClass:(NSString *)aClass
@@ -359,6 +466,8 @@ static NSMutableArray *DYNAMIC_SUBCLASSES;
     NSMutableSet *styleClasses = [NSMutableSet setWithArray:classes];
     objc_setAssociatedObject(self, &STYLE_CLASSES_KEY, styleClasses, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
 
+    [STKPXStyleUtils invalidateStyleKeyForStyleable:self];
+
 //
 //	// reduce white spaces and duplicates
 //	NSMutableSet *mutSet = [NSMutableSet setWithArray:[aClass componentsSeparatedByCharactersInSet:[NSCharacterSet whitespaceCharacterSet]]];
@@ -397,6 +506,8 @@ static NSMutableArray *DYNAMIC_SUBCLASSES;
 
     objc_setAssociatedObject(self, &STYLE_ID_KEY, anId, OBJC_ASSOCIATION_COPY_NONATOMIC);
 
+    [STKPXStyleUtils invalidateStyleKeyForStyleable:self];
+
     if (anId.length)
     {
         self.styleMode = STKPXStylingNormal;
@@ -416,6 +527,7 @@ static NSMutableArray *DYNAMIC_SUBCLASSES;
     css = css.description;
 
     objc_setAssociatedObject(self, &STYLE_CSS_KEY, css, OBJC_ASSOCIATION_COPY_NONATOMIC);
+    objc_setAssociatedObject(self, &INLINE_RULE_SET_KEY, nil, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
 
     if (css.length)
     {
@@ -499,16 +611,12 @@ static NSMutableArray *DYNAMIC_SUBCLASSES;
 
 - (void)updateStylesAsync
 {
-    dispatch_async(dispatch_get_main_queue(), ^{
-        [self updateStyles];
-    });
+    [[STKPXRestyleScheduler sharedScheduler] scheduleStyleable:self recursive:YES];
 }
 
 -(void)updateStylesNonRecursivelyAsync
 {
-    dispatch_async(dispatch_get_main_queue(), ^{
-        [self updateStylesNonRecursively];
-    });
+    [[STKPXRestyleScheduler sharedScheduler] scheduleStyleable:self recursive:NO];
 }
 
 - (void)setValue:(id)value forUndefinedKey:(NSString *)key
@@ -541,6 +649,29 @@ static NSMutableArray *DYNAMIC_SUBCLASSES;
         }
 
         [properties setValue:value forKey:key];
+
+        // parse just the property that changed, so styling never has to format and reparse the whole set
+        NSMutableDictionary *declarations = objc_getAssociatedObject(self, &KVC_DECLARATIONS);
+
+        if (declarations == nil)
+        {
+            declarations = [[NSMutableDictionary alloc] init];
+            objc_setAssociatedObject(self, &KVC_DECLARATIONS, declarations, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+        }
+
+        if (value != nil)
+        {
+            NSString *source = [NSString stringWithFormat:@"%@:%@;", key, value];
+            STKPXStylesheet *stylesheet = [[[STKPXStylesheetParser alloc] init] parseInlineCSS:source];
+
+            declarations[key] = ((STKPXRuleSet *) stylesheet.ruleSets.firstObject).declarations ?: @[];
+        }
+        else
+        {
+            [declarations removeObjectForKey:key];
+        }
+
+        objc_setAssociatedObject(self, &INLINE_RULE_SET_KEY, nil, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
     }
 }
 
@@ -598,32 +729,111 @@ static NSMutableArray *DYNAMIC_SUBCLASSES;
 #pragma mark - Static Functions
 
 
-static Class SubclassForViewWithClass(UIView *view, Class viewClass)
+static Class SubclassForView(UIView *view)
 {
-	if (viewClass == nil)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wundeclared-selector"
+    // dynamic subclasses answer respondsToSelector: themselves, so this stays a per-instance check
+	if ([view respondsToSelector:@selector(STKPXClass)])
     {
-		viewClass = object_getClass(view);
+        return nil;
 	}
+#pragma clang diagnostic pop
+
+    return CachedSubclassForClass(object_getClass(view));
+}
+
+static void InitializeSubclassCache(void)
+{
+    static dispatch_once_t onceToken;
+
+    dispatch_once(&onceToken, ^{
+        DYNAMIC_SUBCLASSES = [[NSMutableArray alloc] init];
+        SUBCLASS_CACHE = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, NULL);
+        SUBCLASS_CACHE_LOCK = [[NSObject alloc] init];
+    });
+}
+
+static Class CachedSubclassForClass(Class viewClass)
+{
+    InitializeSubclassCache();
+
+    if (viewClass == nil)
+    {
+        return nil;
+    }
+
+    const void *cached = NULL;
+    NSUInteger generation;
+
+    @synchronized(SUBCLASS_CACHE_LOCK)
+    {
+        cached = CFDictionaryGetValue(SUBCLASS_CACHE, (__bridge const void *) viewClass);
+        generation = SUBCLASS_CACHE_GENERATION;
+    }
+
+    if (cached)
+    {
+        return (cached == kCFNull) ? nil : (__bridge Class) cached;
+    }
+
+    // resolve outside of the lock: +initialize of a candidate class may register more subclasses
+    Class result = SubclassForViewWithClass(viewClass);
+
+    @synchronized(SUBCLASS_CACHE_LOCK)
+    {
+        // a registration during the walk makes the result stale, so only remember it if nothing changed
+        if (generation == SUBCLASS_CACHE_GENERATION)
+        {
+            CFDictionarySetValue(SUBCLASS_CACHE,
+                                 (__bridge const void *) viewClass,
+                                 result ? (__bridge const void *) result : kCFNull);
+        }
+    }
+
+    return result;
+}
+
+static void InvalidateSubclassCache(void)
+{
+    @synchronized(SUBCLASS_CACHE_LOCK)
+    {
+        CFDictionaryRemoveAllValues(SUBCLASS_CACHE);
+        SUBCLASS_CACHE_GENERATION++;
+    }
+}
+
+static Class SubclassForViewWithClass(Class viewClass)
+{
+    NSArray *subclasses;
+
+    InitializeSubclassCache();
 
-	if ([UIResponder class] == viewClass)
+    // walk a snapshot: the walk runs outside of the lock while other threads may register subclasses
+    @synchronized(SUBCLASS_CACHE_LOCK)
+    {
+        subclasses = [DYNAMIC_SUBCLASSES copy];
+    }
+
+    return SubclassForViewWithClassInSubclasses(viewClass, subclasses);
+}
+
+static Class SubclassForViewWithClassInSubclasses(Class viewClass, NSArray *subclasses)
+{
+	if (viewClass == nil || [UIResponder class] == viewClass)
     {
 		return nil;
 	}
 
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wundeclared-selector"
-	if ([view respondsToSelector:@selector(STKPXClass)])
-    {
-        return nil;
-	}
-
     if (class_getInstanceMethod(viewClass, @selector(STKPXClass)) != NULL)
     {
         return nil;
     }
 #pragma clang diagnostic pop
 
-	for (Class c in DYNAMIC_SUBCLASSES)
+	for (Class c in subclasses)
     {
 		if (c == viewClass)
         {
@@ -648,11 +858,5 @@ static Class SubclassForViewWithClass(UIView *view, Class viewClass)
 		}
 	}
 
-	return SubclassForViewWithClass(view, class_getSuperclass(viewClass));
+	return SubclassForViewWithClassInSubclasses(class_getSuperclass(viewClass), subclasses);
 }
-
-
-
-
-
-
@@ -0,0 +1,64 @@
+/****************************************************************************
+ *
+ * Copyright 2015-present StylingKit Development Team. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ****************************************************************************/
+
+//
+//  STKPXFontFamilyIndex.h
+//  StylingKit
+//
+
+#import <Foundation/Foundation.h>
+#import "STKPXFontEntry.h"
+
+/**
+ *  STKPXFontFamilyIndex precomputes the CSS font matching of STKPXFontEntry's filters for one font family. Faces are
+ *  bucketed by stretch and style once, and the nearest face for every stretch, style, and weight from 100 to 900 is
+ *  stored in a table, so a lookup is an array access. Other weights are matched against the small bucket for their
+ *  stretch and style
+ */
+@interface STKPXFontFamilyIndex : NSObject
+
+@property (readonly, nonatomic, copy) NSString *family;
+@property (readonly, nonatomic, copy) NSArray *entries;
+
+/**
+ *  Build an index over the faces that UIFont knows for a family
+ *
+ *  @param family The font family name
+ */
++ (instancetype)indexForFamily:(NSString *)family;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ *  Build an index over the given faces
+ *
+ *  @param family The font family name
+ *  @param entries The STKPXFontEntry instances of the family
+ */
+- (instancetype)initWithFamily:(NSString *)family entries:(NSArray *)entries NS_DESIGNATED_INITIALIZER;
+
+/**
+ *  Return the face that best matches the given settings, or nil if the family has no faces
+ *
+ *  @param stretch The stretch index, see [STKPXFontEntry indexFromStretchName:]
+ *  @param style The style name. Anything other than "italic" or "oblique" is treated as "normal"
+ *  @param weight The weight, see [STKPXFontEntry indexFromWeightName:]
+ */
+- (STKPXFontEntry *)entryForStretch:(NSInteger)stretch style:(NSString *)style weight:(NSInteger)weight;
+
+@end
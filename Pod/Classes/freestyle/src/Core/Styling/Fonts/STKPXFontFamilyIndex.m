@@ -0,0 +1,128 @@
+/****************************************************************************
+ *
+ * Copyright 2015-present StylingKit Development Team. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ****************************************************************************/
+
+//
+//  STKPXFontFamilyIndex.m
+//  StylingKit
+//
+
+#import "STKPXFontFamilyIndex.h"
+
+#define STRETCH_COUNT 9
+#define STYLE_COUNT 3
+#define WEIGHT_COUNT 9
+
+static NSString *const STYLE_NAMES[STYLE_COUNT] = { @"normal", @"italic", @"oblique" };
+
+static NSUInteger STKPXFontStyleIndex(NSString *style)
+{
+    if ([@"italic" isEqualToString:style])
+    {
+        return 1;
+    }
+    else if ([@"oblique" isEqualToString:style])
+    {
+        return 2;
+    }
+
+    return 0;
+}
+
+@implementation STKPXFontFamilyIndex
+{
+    // faces left after the stretch and style filters, indexed by [stretch * STYLE_COUNT + style]
+    NSArray *candidates_;
+
+    // nearest face for weights 100 through 900. The entries are retained by _entries
+    __unsafe_unretained STKPXFontEntry *table_[STRETCH_COUNT][STYLE_COUNT][WEIGHT_COUNT];
+}
+
+#pragma mark - Static Methods
+
++ (instancetype)indexForFamily:(NSString *)family
+{
+    return [[STKPXFontFamilyIndex alloc] initWithFamily:family entries:[STKPXFontEntry fontEntriesForFamily:family]];
+}
+
+#pragma mark - Initializers
+
+- (instancetype)initWithFamily:(NSString *)family entries:(NSArray *)entries
+{
+    if (self = [super init])
+    {
+        _family = [family copy];
+        _entries = [entries copy];
+
+        NSMutableArray *candidates = [[NSMutableArray alloc] initWithCapacity:STRETCH_COUNT * STYLE_COUNT];
+
+        // run the same filters, in the same order, as a lookup without the index would. Each stage only depends on
+        // the stage before it, so the filters run 9 + 27 + 243 times over ever smaller lists
+        for (NSInteger stretch = 0; stretch < STRETCH_COUNT; stretch++)
+        {
+            NSArray *byStretch = [STKPXFontEntry filterEntries:_entries byStretch:stretch];
+
+            for (NSUInteger style = 0; style < STYLE_COUNT; style++)
+            {
+                NSArray *byStyle = [STKPXFontEntry filterEntries:byStretch byStyle:STYLE_NAMES[style]];
+
+                [candidates addObject:byStyle];
+
+                for (NSUInteger weight = 0; weight < WEIGHT_COUNT; weight++)
+                {
+                    NSArray *byWeight = [STKPXFontEntry filterEntries:byStyle byWeight:(weight + 1) * 100];
+
+                    table_[stretch][style][weight] = byWeight.firstObject;
+                }
+            }
+        }
+
+        candidates_ = candidates;
+    }
+
+    return self;
+}
+
+#pragma mark - Methods
+
+- (STKPXFontEntry *)entryForStretch:(NSInteger)stretch style:(NSString *)style weight:(NSInteger)weight
+{
+    if (_entries.count == 0)
+    {
+        return nil;
+    }
+
+    NSUInteger styleIndex = STKPXFontStyleIndex(style);
+
+    if (stretch < 0 || stretch >= STRETCH_COUNT)
+    {
+        // not a stretch index can produce, so match the slow way
+        NSArray *infos = [STKPXFontEntry filterEntries:_entries byStretch:stretch];
+        infos = [STKPXFontEntry filterEntries:infos byStyle:STYLE_NAMES[styleIndex]];
+
+        return [STKPXFontEntry filterEntries:infos byWeight:weight].firstObject;
+    }
+
+    if (weight >= 100 && weight <= 900 && weight % 100 == 0)
+    {
+        return table_[stretch][styleIndex][weight / 100 - 1];
+    }
+
+    return [STKPXFontEntry filterEntries:candidates_[stretch * STYLE_COUNT + styleIndex] byWeight:weight].firstObject;
+}
+
+@end
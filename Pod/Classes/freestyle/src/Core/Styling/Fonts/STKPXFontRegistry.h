@@ -30,6 +30,13 @@
  *  UIFont. Fallback mechnanisms are used when a specific configuration is not available. All lookups are cached, so
  *  future lookups are quite fast.
  */
+/**
+ *  Posted on the main queue after a font loaded with loadFontFromURL: has been registered. The userInfo contains the
+ *  font's family name under STKPXFontRegistryFamilyKey
+ */
+extern NSString *const STKPXFontRegistryDidLoadFontNotification;
+extern NSString *const STKPXFontRegistryFamilyKey;
+
 @interface STKPXFontRegistry : NSObject
 
 /**
@@ -55,7 +62,27 @@
                       size:(CGFloat)size
              isDefaultFont:(BOOL)isDefaultFont;
 
-
+/**
+ *  Load and register the font at the specified URL. The font is read and registered on a background queue; styleables
+ *  that asked for its family while the load was pending are restyled on the main queue once it is available, and
+ *  STKPXFontRegistryDidLoadFontNotification is posted.
+ *
+ *  @param URL The URL of the font file. URLs that were loaded before are ignored
+ */
 + (void)loadFontFromURL:(NSURL *)URL;
 
+/**
+ *  Return a boolean indicating if any font loads are still pending
+ */
++ (BOOL)isLoadingFonts;
+
+/**
+ *  Restyle the specified styleable once a font of the given family finishes loading. This is a no-op when no loads
+ *  are pending. Styleables are held weakly
+ *
+ *  @param styleable The styleable to restyle
+ *  @param family The font family the styleable asked for
+ */
++ (void)restyleStyleable:(id)styleable whenFamilyLoads:(NSString *)family;
+
 @end
@@ -25,28 +25,61 @@
 
 #import "STKPXFontRegistry.h"
 #import "STKPXFontEntry.h"
+#import "STKPXFontFamilyIndex.h"
+#import "STKPXStyleUtils.h"
+#import <CoreText/CoreText.h>
 #import <CoreText/CTFontManager.h>
 #import <UIKit/UIKit.h>
 
+NSString *const STKPXFontRegistryDidLoadFontNotification = @"STKPXFontRegistryDidLoadFontNotification";
+NSString *const STKPXFontRegistryFamilyKey = @"family";
+
 @implementation STKPXFontRegistry
 
 STK_DEFINE_CLASS_LOG_LEVEL;
 
-static NSMutableDictionary *REGISTRY;
+static NSMutableDictionary *FAMILY_INDEXES;
 static NSMutableSet *LOADED_FONTS;
+static NSUInteger PENDING_LOADS;
+static NSMutableDictionary *WAITING_STYLEABLES;
+static dispatch_queue_t FONT_LOADING_QUEUE;
 
 + (void)initialize
 {
-    if (!REGISTRY)
+    if (!FAMILY_INDEXES)
     {
-        REGISTRY = [[NSMutableDictionary alloc] init];
+        FAMILY_INDEXES = [[NSMutableDictionary alloc] init];
         LOADED_FONTS = [[NSMutableSet alloc] init];
+        WAITING_STYLEABLES = [[NSMutableDictionary alloc] init];
+        FONT_LOADING_QUEUE = dispatch_queue_create("com.stylingkit.fonts", DISPATCH_QUEUE_SERIAL);
     }
 }
 
 + (void)clearRegistry
 {
-    [REGISTRY removeAllObjects];
+    @synchronized(FAMILY_INDEXES)
+    {
+        [FAMILY_INDEXES removeAllObjects];
+    }
+}
+
++ (STKPXFontFamilyIndex *)indexForFamily:(NSString *)family
+{
+    STKPXFontFamilyIndex *result;
+
+    @synchronized(FAMILY_INDEXES)
+    {
+        result = FAMILY_INDEXES[family];
+
+        if (result == nil)
+        {
+            // the index is built once per family, so no lookup has to enumerate and sort the family's faces again
+            result = [STKPXFontFamilyIndex indexForFamily:family];
+            FAMILY_INDEXES[family] = result;
+        }
+    }
+
+    return result;
 }
 
 + (UIFont*)fontWithFamily:(NSString*)family
@@ -56,100 +89,200 @@ static NSMutableSet *LOADED_FONTS;
                      size:(CGFloat)size
             isDefaultFont:(BOOL)isDefaultFont
 {
-    NSString *key = [self keyFromFamily:family stretch:stretch weight:weight style:style];
-
     UIFont *result;
 
-    id resultingFontName = REGISTRY[key];
+    STKPXFontFamilyIndex *index = (family) ? [self indexForFamily:family] : nil;
+    STKPXFontEntry *entry = [index entryForStretch:[STKPXFontEntry indexFromStretchName:stretch]
+                                             style:style
+                                            weight:[STKPXFontEntry indexFromWeightName:weight]];
 
-    if (!resultingFontName)
+    if (entry)
+    {
+        // Fonts are cached by iOS, no need for extra caching
+        result = [UIFont fontWithName:entry.name size:size];
+    }
+    else if (isDefaultFont)
     {
-        NSArray *infos = [STKPXFontEntry fontEntriesForFamily:family];
-        infos = [STKPXFontEntry filterEntries:infos byStretch:[STKPXFontEntry indexFromStretchName:stretch]];
-        infos = [STKPXFontEntry filterEntries:infos byStyle:style];
-        infos = [STKPXFontEntry filterEntries:infos byWeight:[STKPXFontEntry indexFromWeightName:weight]];
+//        UIKIT_EXTERN const CGFloat UIFontWeightUltraLight NS_AVAILABLE_IOS(8_2);
+//        UIKIT_EXTERN const CGFloat UIFontWeightThin NS_AVAILABLE_IOS(8_2);
+//        UIKIT_EXTERN const CGFloat UIFontWeightLight NS_AVAILABLE_IOS(8_2);
+//        UIKIT_EXTERN const CGFloat UIFontWeightRegular NS_AVAILABLE_IOS(8_2);
+//        UIKIT_EXTERN const CGFloat UIFontWeightMedium NS_AVAILABLE_IOS(8_2);
+//        UIKIT_EXTERN const CGFloat UIFontWeightSemibold NS_AVAILABLE_IOS(8_2);
+//        UIKIT_EXTERN const CGFloat UIFontWeightBold NS_AVAILABLE_IOS(8_2);
+//        UIKIT_EXTERN const CGFloat UIFontWeightHeavy NS_AVAILABLE_IOS(8_2);
+//        UIKIT_EXTERN const CGFloat UIFontWeightBlack NS_AVAILABLE_IOS(8_2);
 
-        // save result so won't do the rather expensive lookup process again
-        if (infos.count > 0)
+        if (![@"italic" isEqualToString:style] ||
+            [@"oblique" isEqualToString:style])
         {
-            STKPXFontEntry *info = infos[0];
+            result = [UIFont italicSystemFontOfSize:size];
 
-            resultingFontName = info.name;
+            id fd = [result.fontDescriptor fontDescriptorWithSymbolicTraits:UIFontDescriptorTraitItalic ];
+            result = [UIFont fontWithDescriptor:fd
+                                           size:size];
         }
-        else if (isDefaultFont)
+        else
         {
-//            UIKIT_EXTERN const CGFloat UIFontWeightUltraLight NS_AVAILABLE_IOS(8_2);
-//            UIKIT_EXTERN const CGFloat UIFontWeightThin NS_AVAILABLE_IOS(8_2);
-//            UIKIT_EXTERN const CGFloat UIFontWeightLight NS_AVAILABLE_IOS(8_2);
-//            UIKIT_EXTERN const CGFloat UIFontWeightRegular NS_AVAILABLE_IOS(8_2);
-//            UIKIT_EXTERN const CGFloat UIFontWeightMedium NS_AVAILABLE_IOS(8_2);
-//            UIKIT_EXTERN const CGFloat UIFontWeightSemibold NS_AVAILABLE_IOS(8_2);
-//            UIKIT_EXTERN const CGFloat UIFontWeightBold NS_AVAILABLE_IOS(8_2);
-//            UIKIT_EXTERN const CGFloat UIFontWeightHeavy NS_AVAILABLE_IOS(8_2);
-//            UIKIT_EXTERN const CGFloat UIFontWeightBlack NS_AVAILABLE_IOS(8_2);
-
-            if (![@"italic" isEqualToString:style] ||
-                [@"oblique" isEqualToString:style])
-            {
-                result = [UIFont italicSystemFontOfSize:size];
-
-                id fd = [result.fontDescriptor fontDescriptorWithSymbolicTraits:UIFontDescriptorTraitItalic ];
-                result = [UIFont fontWithDescriptor:fd
-                                               size:size];
-            }
-            else
-            {
-                result = [UIFont systemFontOfSize:size];
-            }
+            result = [UIFont systemFontOfSize:size];
         }
-        else
+    }
+
+    return result;
+}
+
++ (void)loadFontFromURL:(NSURL *)URL
+{
+    if (URL == nil)
+    {
+        return;
+    }
+
+    @synchronized(LOADED_FONTS)
+    {
+        if ([LOADED_FONTS containsObject:URL])
         {
-            // store an NSNull as a surrogate for nil
-            resultingFontName = [NSNull null];
+            return;
         }
 
-        REGISTRY[key] = resultingFontName;
+        [LOADED_FONTS addObject:URL];
+        PENDING_LOADS++;
     }
 
-    if (resultingFontName &&
-        resultingFontName != [NSNull null])
+    // reading and registering a font can take a while, so keep it off the thread that is parsing or styling
+    dispatch_async(FONT_LOADING_QUEUE, ^{
+        NSString *family = [self registerFontFromURL:URL];
+
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self didLoadFontFamily:family];
+        });
+    });
+}
+
++ (BOOL)isLoadingFonts
+{
+    @synchronized(LOADED_FONTS)
     {
-        // Fonts are cached by iOS, no need for extra caching
-        result = [UIFont fontWithName:resultingFontName size:size];
+        return PENDING_LOADS > 0;
     }
-    return result;
 }
 
-+ (NSString *)keyFromFamily:(NSString *)family stretch:(NSString *)stretch weight:(NSString *)weight style:(NSString *)style
++ (void)restyleStyleable:(id)styleable whenFamilyLoads:(NSString *)family
 {
-    return [NSString stringWithFormat:@"%@:%@:%@:%@", family, stretch, weight, style];
+    if (styleable == nil || family == nil || ![self isLoadingFonts])
+    {
+        return;
+    }
+
+    @synchronized(LOADED_FONTS)
+    {
+        NSString *key = family.lowercaseString;
+        NSHashTable *styleables = WAITING_STYLEABLES[key];
+
+        if (styleables == nil)
+        {
+            styleables = [NSHashTable weakObjectsHashTable];
+            WAITING_STYLEABLES[key] = styleables;
+        }
+
+        [styleables addObject:styleable];
+    }
 }
 
-+ (void)loadFontFromURL:(NSURL *)URL
+#pragma mark - Font loading
+
++ (NSString *)registerFontFromURL:(NSURL *)URL
 {
-    if (URL != nil && ![LOADED_FONTS containsObject:URL])
+    NSString *family = nil;
+    NSData *data = [NSData dataWithContentsOfURL:URL];
+
+    if (data != nil)
     {
-        [LOADED_FONTS addObject:URL];
+        CFErrorRef error;
+        CGDataProviderRef provider = CGDataProviderCreateWithCFData((__bridge CFDataRef)data);
+        CGFontRef font = CGFontCreateWithDataProvider(provider);
+
+        if (font == NULL)
+        {
+            NSLog(@"Failed to load font: %@", URL);
+        }
+        else if (!CTFontManagerRegisterGraphicsFont(font, &error))
+        {
+            CFStringRef errorDescription = CFErrorCopyDescription(error);
+            NSLog(@"Failed to load font: %@", errorDescription);
+            CFRelease(errorDescription);
+            CFRelease(error);
+        }
+        else
+        {
+            CTFontRef ctFont = CTFontCreateWithGraphicsFont(font, 0.0f, NULL, NULL);
+
+            family = CFBridgingRelease(CTFontCopyFamilyName(ctFont));
+            CFRelease(ctFont);
+        }
+
+        if (font != NULL)
+        {
+            CFRelease(font);
+        }
+
+        CFRelease(provider);
+    }
+
+    return family;
+}
+
++ (void)didLoadFontFamily:(NSString *)family
+{
+    NSArray *styleables = nil;
+
+    @synchronized(LOADED_FONTS)
+    {
+        PENDING_LOADS--;
+
+        if (family)
+        {
+            NSString *key = family.lowercaseString;
 
-        NSData *data = [NSData dataWithContentsOfURL:URL];
+            styleables = [WAITING_STYLEABLES[key] allObjects];
+            [WAITING_STYLEABLES removeObjectForKey:key];
+        }
 
-        if (data != nil)
+        // families nobody loaded won't show up anymore, so stop tracking their styleables
+        if (PENDING_LOADS == 0)
         {
-            CFErrorRef error;
-            CGDataProviderRef provider = CGDataProviderCreateWithCFData((__bridge CFDataRef)data);
-            CGFontRef font = CGFontCreateWithDataProvider(provider);
+            [WAITING_STYLEABLES removeAllObjects];
+        }
+    }
 
-            if (!CTFontManagerRegisterGraphicsFont(font, &error))
+    if (family == nil)
+    {
+        return;
+    }
+
+    // the family gained a face, so its index has to be rebuilt
+    @synchronized(FAMILY_INDEXES)
+    {
+        for (NSString *indexedFamily in FAMILY_INDEXES.allKeys)
+        {
+            if ([indexedFamily caseInsensitiveCompare:family] == NSOrderedSame)
             {
-                CFStringRef errorDescription = CFErrorCopyDescription(error);
-                NSLog(@"Failed to load font: %@", errorDescription);
-                CFRelease(errorDescription);
+                [FAMILY_INDEXES removeObjectForKey:indexedFamily];
             }
-
-            CFRelease(font);
-            CFRelease(provider);
         }
     }
+
+    // nothing about these styleables changed but the font, so without invalidating them first redundant styling
+    // prevention would skip the pass and keep the fallback font
+    for (id<STKPXStyleable> styleable in styleables)
+    {
+        [STKPXStyleUtils invalidateStyleable:styleable];
+        [STKPXStyleUtils updateStylesForStyleable:styleable andDescendants:NO];
+    }
+
+    [[NSNotificationCenter defaultCenter] postNotificationName:STKPXFontRegistryDidLoadFontNotification
+                                                        object:self
+                                                      userInfo:@{ STKPXFontRegistryFamilyKey : family }];
 }
 
 @end
@@ -77,7 +77,7 @@ typedef NS_ENUM(int, STKPXAnimationFillMode)
     STKPXAnimationFillModeBoth                 // both
 };
 
-@interface STKPXAnimationInfo : NSObject
+@interface STKPXAnimationInfo : NSObject <NSCopying>
 
 @property (nonatomic, strong) NSString *animationName;
 @property (nonatomic) CGFloat animationDuration;
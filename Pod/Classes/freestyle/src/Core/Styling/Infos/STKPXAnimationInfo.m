@@ -140,4 +140,22 @@
     }
 }
 
+#pragma mark - NSCopying
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    STKPXAnimationInfo *copy = [[[self class] allocWithZone:zone] init];
+
+    copy->_animationName = _animationName;
+    copy->_animationDuration = _animationDuration;
+    copy->_animationTimingFunction = _animationTimingFunction;
+    copy->_animationIterationCount = _animationIterationCount;
+    copy->_animationDirection = _animationDirection;
+    copy->_animationPlayState = _animationPlayState;
+    copy->_animationDelay = _animationDelay;
+    copy->_animationFillMode = _animationFillMode;
+
+    return copy;
+}
+
 @end
@@ -49,7 +49,7 @@
         // extract any transition delcarations we might have
         STKPXTransitionStyler *styler = [[STKPXTransitionStyler alloc] init];
         NSSet *stylerProperties = [[NSSet alloc] initWithArray:styler.supportedProperties];
-        STKPXStylerContext *context = [[STKPXStylerContext alloc] init];
+        STKPXStylerContext *context = [STKPXStylerContext dequeueReusableContext];
         context.styleable = styleable;
         context.activeStateName = stateName;
 
@@ -62,6 +62,8 @@
         }
 
         _transitions = context.transitionInfos;
+        [STKPXStylerContext recycleContext:context];
+
         NSMutableSet *animationProperties = [[NSMutableSet alloc] init];
 
         for (STKPXAnimationInfo *info in _transitions)
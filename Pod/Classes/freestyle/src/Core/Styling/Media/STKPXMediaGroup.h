@@ -26,6 +26,7 @@
 #import "STKPXMediaExpression.h"
 #import "STKPXStylesheet.h"
 #import "STKPXRuleSet.h"
+#import "STKPXRuleSetScratch.h"
 
 @interface STKPXMediaGroup : NSObject <STKPXMediaExpression>
 
@@ -61,10 +62,21 @@
 - (void)addRuleSet:(STKPXRuleSet *)ruleSet;
 
 /**
- *  Return a list of rule sets that could apply to the given styleable
+ *  Return a list of rule sets that could apply to the given styleable. Candidates come from the element name, id and
+ *  class partitions, from the attribute and structural pseudo-class partitions whose test passes for the styleable,
+ *  and from the universal partition. The list is in source order and contains each rule set once.
  *
  *  @param styleable The element to match
  */
 - (NSArray *)ruleSetsForStyleable:(id<STKPXStyleable>)styleable;
 
+/**
+ *  Append the rule sets of this group that match the given styleable to the span of a scratch, in source order. No
+ *  containers are allocated along the way.
+ *
+ *  @param styleable The element to match
+ *  @param scratch The scratch collecting matches, see STKPXRuleSetScratchAcquire
+ */
+- (void)appendRuleSetsMatchingStyleable:(id<STKPXStyleable>)styleable toScratch:(STKPXRuleSetScratch *)scratch;
+
 @end
@@ -24,6 +24,66 @@
 //
 
 #import "STKPXMediaGroup.h"
+#import "STKPXAttributeSelector.h"
+#import "STKPXAttributeSelectorOperator.h"
+#import "STKPXPseudoClassPredicate.h"
+#import "STKPXPseudoClassFunction.h"
+#import "STKPXRuleSetScratch.h"
+
+/**
+ *  A STKPXRuleSetProbe groups uncategorized rule sets that share a cheap necessary condition: the presence of an
+ *  attribute or a structural pseudo-class. The condition is tested once per styleable instead of matching every rule
+ *  set in the group.
+ */
+@interface STKPXRuleSetProbe : NSObject
+
+@property (nonatomic, strong) NSString *attributeName;
+@property (nonatomic, strong) NSString *namespaceURI;
+@property (nonatomic, strong) id<STKPXSelector> pseudoClass;
+@property (nonatomic, readonly) NSMutableData *ordinals;
+
+- (BOOL)matches:(id<STKPXStyleable>)styleable;
+
+@end
+
+@implementation STKPXRuleSetProbe
+
+- (instancetype)init
+{
+    if (self = [super init])
+    {
+        _ordinals = [[NSMutableData alloc] init];
+    }
+
+    return self;
+}
+
+- (BOOL)matches:(id<STKPXStyleable>)styleable
+{
+    if (_attributeName != nil)
+    {
+        // NOTE: every attribute operator fails on a nil value, so existence is a safe test for all of them
+        return [styleable respondsToSelector:@selector(attributeValueForName:withNamespace:)]
+            && [styleable attributeValueForName:_attributeName withNamespace:_namespaceURI] != nil;
+    }
+
+    return [_pseudoClass matches:styleable];
+}
+
+@end
+
+static inline void STKPXAppendOrdinal(NSMutableData *data, NSUInteger ordinal)
+{
+    [data appendBytes:&ordinal length:sizeof(NSUInteger)];
+}
+
+static inline void STKPXAddPartition(STKPXRuleSetScratch *scratch, NSData *data)
+{
+    if (data.length > 0)
+    {
+        STKPXRuleSetScratchAddOrdinals(scratch, data.bytes, data.length / sizeof(NSUInteger));
+    }
+}
 
 @implementation STKPXMediaGroup
 {
@@ -31,7 +91,10 @@
     NSMutableDictionary *ruleSetsByElementName_;
     NSMutableDictionary *ruleSetsById_;
     NSMutableDictionary *ruleSetsByClass_;
-    NSMutableArray *uncategorizedRuleSets_;
+    NSMutableDictionary *probesByKey_;
+    NSMutableArray *attributeProbes_;
+    NSMutableArray *pseudoClassProbes_;
+    NSMutableData *universalRuleSets_;
 }
 
 #pragma mark - Initializers
@@ -56,90 +119,177 @@
 
 - (NSArray *)ruleSetsForStyleable:(id<STKPXStyleable>)styleable
 {
+    STKPXRuleSetScratch *scratch = STKPXRuleSetScratchAcquire();
+
+    [self collectCandidatesForStyleable:styleable scratch:scratch];
+
+    NSMutableArray *result = [NSMutableArray arrayWithCapacity:scratch->ordinalCount];
+
+    for (NSUInteger i = 0; i < scratch->ordinalCount; i++)
+    {
+        [result addObject:ruleSets_[scratch->ordinals[i]]];
+    }
+
+    STKPXRuleSetScratchRelinquish(scratch);
+
+    return result;
+}
+
+#pragma mark - Methods
+
+- (void)collectCandidatesForStyleable:(id<STKPXStyleable>)styleable scratch:(STKPXRuleSetScratch *)scratch
+{
+    STKPXRuleSetScratchBeginGroup(scratch, ruleSets_.count);
+
     // gather keys
     NSString *elementName = styleable.pxStyleElementName;
     NSString *styleId = styleable.styleId;
-    NSSet *styleClasses = styleable.styleClasses;
 
-    NSArray *ruleSetsForElement = ruleSetsByElementName_[elementName];
-    NSArray *ruleSetsForStyle = ruleSetsById_[styleId];
+    // add every partition that applies to this styleable. A rule set listed in several partitions is marked the first
+    // time it is seen and skipped afterwards
+    if (elementName.length > 0)
+    {
+        STKPXAddPartition(scratch, ruleSetsByElementName_[elementName]);
+    }
 
-    const NSUInteger capacity = [ruleSetsForElement count]
-        + [ruleSetsForStyle count]
-        + ruleSetsByClass_.count * styleClasses.count;
+    if (styleId.length > 0)
+    {
+        STKPXAddPartition(scratch, ruleSetsById_[styleId]);
+    }
 
-    NSMutableArray *result = [NSMutableArray arrayWithCapacity:capacity];
-    NSMutableSet *items = [NSMutableSet setWithCapacity:capacity];
+    if (ruleSetsByClass_.count > 0)
+    {
+        for (NSString *aClass in styleable.styleClasses)
+        {
+            STKPXAddPartition(scratch, ruleSetsByClass_[aClass]);
+        }
+    }
 
-    // find relevant ruleSets by element name
-    if (elementName.length > 0)
+    for (STKPXRuleSetProbe *probe in attributeProbes_)
     {
-        for (STKPXRuleSet *ruleSet in ruleSetsForElement)
+        if ([probe matches:styleable])
         {
-            if (![items containsObject:ruleSet])
-            {
-                [result addObject:ruleSet];
-                [items addObject:ruleSet];
-            }
+            STKPXAddPartition(scratch, probe.ordinals);
         }
     }
 
-    // find relevant ruleSets by id
-    if (styleId.length > 0)
+    for (STKPXRuleSetProbe *probe in pseudoClassProbes_)
     {
-        for (STKPXRuleSet *ruleSet in ruleSetsForStyle)
+        if ([probe matches:styleable])
         {
-            if (![items containsObject:ruleSet])
-            {
-                [result addObject:ruleSet];
-                [items addObject:ruleSet];
-            }
+            STKPXAddPartition(scratch, probe.ordinals);
         }
     }
 
-    // find relevant ruleSets by class
-    for (NSString *aClass in styleClasses)
+    STKPXAddPartition(scratch, universalRuleSets_);
+
+    // partitions are each in source order, but their union is not
+    STKPXRuleSetScratchSortOrdinals(scratch);
+}
+
+- (void)appendRuleSetsMatchingStyleable:(id<STKPXStyleable>)styleable toScratch:(STKPXRuleSetScratch *)scratch
+{
+    [self collectCandidatesForStyleable:styleable scratch:scratch];
+
+    for (NSUInteger i = 0; i < scratch->ordinalCount; i++)
     {
-        for (STKPXRuleSet *ruleSet in ruleSetsByClass_[aClass])
+        STKPXRuleSet *ruleSet = ruleSets_[scratch->ordinals[i]];
+
+        if ([ruleSet matches:styleable])
         {
-            if (![items containsObject:ruleSet])
-            {
-                [result addObject:ruleSet];
-                [items addObject:ruleSet];
-            }
+            STKPXRuleSetScratchAppendRuleSet(scratch, ruleSet);
         }
     }
+}
 
-    // fallback to all uncategorized ruleSets. Note that these are already included in the element name, id, and class
-    // lists above, so we only need to add these if we didn't find any of those
-    if (result.count == 0)
+- (void)addOrdinal:(NSUInteger)ordinal toPartition:(NSMutableDictionary *)partition withKey:(NSString *)key
+{
+    NSMutableData *ordinals = partition[key];
+
+    // create ordinal list if we don't have one already
+    if (ordinals == nil)
     {
-        result = uncategorizedRuleSets_;
+        ordinals = [[NSMutableData alloc] init];
+
+        // save the ordinal list back to the partition dictionary
+        partition[key] = ordinals;
     }
 
-    return result;
+    STKPXAppendOrdinal(ordinals, ordinal);
 }
 
-#pragma mark - Methods
-
-- (void)addRuleSet:(STKPXRuleSet *)ruleSet toPartition:(NSMutableDictionary *)partition withKey:(NSString *)key
+- (void)addUncategorizedOrdinal:(NSUInteger)ordinal typeSelector:(STKPXTypeSelector *)typeSelector
 {
-    NSMutableArray *ruleSets = partition[key];
+    STKPXAttributeSelector *attributeSelector = nil;
+    id<STKPXSelector> pseudoClass = nil;
 
-    // create ruleset array if we don't have one already
-    if (ruleSets == nil)
+    // prefer attributes since testing one is cheaper than computing sibling positions
+    for (id<STKPXSelector> expression in typeSelector.attributeExpressions)
     {
-        ruleSets = [NSMutableArray array];
+        if ([expression isKindOfClass:[STKPXAttributeSelector class]])
+        {
+            attributeSelector = (STKPXAttributeSelector *)expression;
+            break;
+        }
+        else if ([expression isKindOfClass:[STKPXAttributeSelectorOperator class]])
+        {
+            attributeSelector = ((STKPXAttributeSelectorOperator *)expression).attributeSelector;
+            break;
+        }
+        else if (pseudoClass == nil
+                 && ([expression isKindOfClass:[STKPXPseudoClassPredicate class]]
+                     || [expression isKindOfClass:[STKPXPseudoClassFunction class]]))
+        {
+            pseudoClass = expression;
+        }
+    }
 
-        // be sure to include in this array all uncategorized ruleSets that came before this one
-        [ruleSets addObjectsFromArray:uncategorizedRuleSets_];
+    if (attributeSelector.attributeName.length > 0)
+    {
+        NSString *key = (attributeSelector.namespaceURI != nil)
+            ? [NSString stringWithFormat:@"[%@|%@]", attributeSelector.namespaceURI, attributeSelector.attributeName]
+            : [NSString stringWithFormat:@"[%@]", attributeSelector.attributeName];
 
-        // save the ruleSet array back to the partition dictionary
-        partition[key] = ruleSets;
+        STKPXRuleSetProbe *probe = probesByKey_[key];
+
+        if (probe == nil)
+        {
+            probe = [[STKPXRuleSetProbe alloc] init];
+            probe.attributeName = attributeSelector.attributeName;
+            probe.namespaceURI = attributeSelector.namespaceURI;
+
+            if (probesByKey_ == nil) probesByKey_ = [NSMutableDictionary dictionary];
+            if (attributeProbes_ == nil) attributeProbes_ = [NSMutableArray array];
+            probesByKey_[key] = probe;
+            [attributeProbes_ addObject:probe];
+        }
+
+        STKPXAppendOrdinal(probe.ordinals, ordinal);
     }
+    else if (pseudoClass != nil)
+    {
+        NSString *key = pseudoClass.description;
+        STKPXRuleSetProbe *probe = probesByKey_[key];
+
+        if (probe == nil)
+        {
+            probe = [[STKPXRuleSetProbe alloc] init];
+            probe.pseudoClass = pseudoClass;
 
-    // add this ruleSet to the ruleSet array associated with the given key
-    [ruleSets addObject:ruleSet];
+            if (probesByKey_ == nil) probesByKey_ = [NSMutableDictionary dictionary];
+            if (pseudoClassProbes_ == nil) pseudoClassProbes_ = [NSMutableArray array];
+            probesByKey_[key] = probe;
+            [pseudoClassProbes_ addObject:probe];
+        }
+
+        STKPXAppendOrdinal(probe.ordinals, ordinal);
+    }
+    else
+    {
+        // universal selectors, dynamic pseudo-classes, negations, etc. are candidates for every styleable
+        if (universalRuleSets_ == nil) universalRuleSets_ = [[NSMutableData alloc] init];
+        STKPXAppendOrdinal(universalRuleSets_, ordinal);
+    }
 }
 
 - (void)addRuleSet:(STKPXRuleSet *)ruleSet
@@ -151,11 +301,17 @@
             ruleSets_ = [NSMutableArray array];
         }
 
+        // the rule set's position in this group is used to merge partitions back into source order
+        NSUInteger ordinal = ruleSets_.count;
+
         [ruleSets_ addObject:ruleSet];
 
         // set origin specificity
         [ruleSet.specificity setSpecificity:kSpecificityTypeOrigin toValue:_origin];
 
+        // precompute the states this rule set applies to so the cascade doesn't have to compare pseudo-class names
+        [ruleSet updateStateMask];
+
         // setup lookup by element type
         STKPXTypeSelector *typeSelector = ruleSet.targetTypeSelector;
         // NOTE: we have to check for nil since hasUniversalType returns false with a nil typeSelector, but we need
@@ -169,14 +325,14 @@
         if (elementName != nil && ![@"*" isEqualToString:elementName])
         {
             if (ruleSetsByElementName_ == nil) ruleSetsByElementName_ = [NSMutableDictionary dictionary];
-            [self addRuleSet:ruleSet toPartition:ruleSetsByElementName_ withKey:elementName];
+            [self addOrdinal:ordinal toPartition:ruleSetsByElementName_ withKey:elementName];
             added = YES;
         }
 
         if (styleId.length > 0)
         {
             if (ruleSetsById_ == nil) ruleSetsById_ = [NSMutableDictionary dictionary];
-            [self addRuleSet:ruleSet toPartition:ruleSetsById_ withKey:styleId];
+            [self addOrdinal:ordinal toPartition:ruleSetsById_ withKey:styleId];
             added = YES;
         }
 
@@ -186,40 +342,17 @@
 
             for (NSString *styleClass in styleClasses)
             {
-                [self addRuleSet:ruleSet toPartition:ruleSetsByClass_ withKey:styleClass];
+                [self addOrdinal:ordinal toPartition:ruleSetsByClass_ withKey:styleClass];
             }
 
             added = YES;
         }
 
-        // if this wasn't added to any of our partitions, then we need to collect it into the uncategorized partition
-        // and add it to all other partitions to preserve rule set order in those sets as well
+        // if this wasn't added to any of our partitions, then index it by attribute name or structural pseudo-class,
+        // falling back to the universal partition
         if (!added)
         {
-            if (uncategorizedRuleSets_ == nil) uncategorizedRuleSets_ = [NSMutableArray array];
-            [uncategorizedRuleSets_ addObject:ruleSet];
-
-            // add uncategorized ruleSets to all partitions
-            for (NSString *key in ruleSetsByElementName_.allKeys)
-            {
-                NSMutableArray *items = ruleSetsByElementName_[key];
-
-                [items addObject:ruleSet];
-            }
-
-            for (NSString *key in ruleSetsById_.allKeys)
-            {
-                NSMutableArray *items = ruleSetsById_[key];
-
-                [items addObject:ruleSet];
-            }
-
-            for (NSString *key in ruleSetsByClass_.allKeys)
-            {
-                NSMutableArray *items = ruleSetsByClass_[key];
-
-                [items addObject:ruleSet];
-            }
+            [self addUncategorizedOrdinal:ordinal typeSelector:typeSelector];
         }
     }
 }
@@ -244,7 +377,10 @@
     ruleSetsByElementName_ = nil;
     ruleSetsById_ = nil;
     ruleSetsByClass_ = nil;
-    uncategorizedRuleSets_ = nil;
+    probesByKey_ = nil;
+    attributeProbes_ = nil;
+    pseudoClassProbes_ = nil;
+    universalRuleSets_ = nil;
     _query = nil;
 }
 
@@ -0,0 +1,86 @@
+/****************************************************************************
+ *
+ * Copyright 2015-present StylingKit Development Team. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ****************************************************************************/
+//
+//  STKPXRuleSetScratch.h
+//  StylingKit
+//
+
+#import <Foundation/Foundation.h>
+
+@class STKPXRuleSet;
+
+/**
+ *  Scratch storage used while collecting the rule sets that match a styleable. A scratch holds the candidate ordinals
+ *  of the media group being visited, a generation-stamped mark per ordinal used to drop duplicates, and the span of
+ *  matching rule sets collected so far across groups and stylesheets.
+ *
+ *  Rule sets in the span are retained until the scratch is relinquished, so they stay valid even if a stylesheet is
+ *  swapped out while matches are still being collected.
+ */
+typedef struct
+{
+    NSUInteger *ordinals;
+    NSUInteger ordinalCount;
+    NSUInteger ordinalCapacity;
+
+    uint32_t *stamps;
+    NSUInteger stampCapacity;
+    uint32_t generation;
+
+    // retained STKPXRuleSet instances, typed as id so the span can be passed to NSArray initializers directly. The
+    // retains are balanced by hand, as ARC does not manage object pointers in C structs
+    __unsafe_unretained id *ruleSets;
+    NSUInteger ruleSetCount;
+    NSUInteger ruleSetCapacity;
+
+    BOOL inUse;
+}
+STKPXRuleSetScratch;
+
+/**
+ *  Return the calling thread's scratch, emptied and ready for use. If it is already in use further up the stack, a
+ *  temporary scratch is returned instead. Every call must be balanced by STKPXRuleSetScratchRelinquish
+ */
+STKPXRuleSetScratch *STKPXRuleSetScratchAcquire(void);
+
+/**
+ *  Hand a scratch returned by STKPXRuleSetScratchAcquire back, releasing the rule sets in its span. The thread's scratch
+ *  keeps its buffers for the next styling call, temporary ones are freed
+ */
+void STKPXRuleSetScratchRelinquish(STKPXRuleSetScratch *scratch);
+
+/**
+ *  Start collecting candidates for a media group holding the specified number of rule sets. Clears the ordinal list
+ *  and invalidates all marks by moving to a new generation
+ */
+void STKPXRuleSetScratchBeginGroup(STKPXRuleSetScratch *scratch, NSUInteger ruleSetCount);
+
+/**
+ *  Add the candidate ordinals of a partition. Ordinals already added for the current group are skipped
+ */
+void STKPXRuleSetScratchAddOrdinals(STKPXRuleSetScratch *scratch, const NSUInteger *ordinals, NSUInteger count);
+
+/**
+ *  Sort the candidate ordinals of the current group into source order
+ */
+void STKPXRuleSetScratchSortOrdinals(STKPXRuleSetScratch *scratch);
+
+/**
+ *  Append a rule set to the span of matching rule sets, retaining it until the scratch is relinquished
+ */
+void STKPXRuleSetScratchAppendRuleSet(STKPXRuleSetScratch *scratch, STKPXRuleSet *ruleSet);
@@ -0,0 +1,215 @@
+/****************************************************************************
+ *
+ * Copyright 2015-present StylingKit Development Team. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ****************************************************************************/
+//
+//  STKPXRuleSetScratch.m
+//  StylingKit
+//
+
+#import "STKPXRuleSetScratch.h"
+#import <pthread.h>
+
+// Below this many candidates an insertion sort beats qsort
+#define STKPX_INSERTION_SORT_LIMIT 16
+
+static pthread_key_t scratchKey;
+static pthread_once_t scratchKeyOnce = PTHREAD_ONCE_INIT;
+
+static void STKPXRuleSetScratchReleaseRuleSets(STKPXRuleSetScratch *scratch)
+{
+    for (NSUInteger i = 0; i < scratch->ruleSetCount; i++)
+    {
+        CFRelease((__bridge CFTypeRef)scratch->ruleSets[i]);
+    }
+
+    scratch->ruleSetCount = 0;
+}
+
+static void STKPXRuleSetScratchFree(void *value)
+{
+    STKPXRuleSetScratch *scratch = value;
+
+    if (scratch != NULL)
+    {
+        STKPXRuleSetScratchReleaseRuleSets(scratch);
+        free(scratch->ordinals);
+        free(scratch->stamps);
+        free(scratch->ruleSets);
+        free(scratch);
+    }
+}
+
+static void STKPXRuleSetScratchCreateKey(void)
+{
+    pthread_key_create(&scratchKey, STKPXRuleSetScratchFree);
+}
+
+static int STKPXCompareOrdinals(const void *a, const void *b)
+{
+    NSUInteger left = *(const NSUInteger *)a;
+    NSUInteger right = *(const NSUInteger *)b;
+
+    return (left < right) ? -1 : (left > right) ? 1 : 0;
+}
+
+static NSUInteger STKPXGrowCapacity(NSUInteger capacity, NSUInteger required)
+{
+    NSUInteger result = (capacity > 0) ? capacity : 64;
+
+    while (result < required)
+    {
+        result *= 2;
+    }
+
+    return result;
+}
+
+#pragma mark - Acquisition
+
+STKPXRuleSetScratch *STKPXRuleSetScratchAcquire(void)
+{
+    pthread_once(&scratchKeyOnce, STKPXRuleSetScratchCreateKey);
+
+    STKPXRuleSetScratch *scratch = pthread_getspecific(scratchKey);
+
+    if (scratch == NULL)
+    {
+        scratch = calloc(1, sizeof(STKPXRuleSetScratch));
+        pthread_setspecific(scratchKey, scratch);
+    }
+    else if (scratch->inUse)
+    {
+        // a nested styling call (a styleable styling another one while being matched); don't clobber the outer span
+        scratch = calloc(1, sizeof(STKPXRuleSetScratch));
+    }
+
+    scratch->inUse = YES;
+    scratch->ordinalCount = 0;
+    scratch->ruleSetCount = 0;
+
+    return scratch;
+}
+
+void STKPXRuleSetScratchRelinquish(STKPXRuleSetScratch *scratch)
+{
+    if (scratch == NULL)
+    {
+        return;
+    }
+
+    if (scratch == pthread_getspecific(scratchKey))
+    {
+        STKPXRuleSetScratchReleaseRuleSets(scratch);
+        scratch->inUse = NO;
+    }
+    else
+    {
+        STKPXRuleSetScratchFree(scratch);
+    }
+}
+
+#pragma mark - Candidates
+
+void STKPXRuleSetScratchBeginGroup(STKPXRuleSetScratch *scratch, NSUInteger ruleSetCount)
+{
+    scratch->ordinalCount = 0;
+
+    if (ruleSetCount > scratch->stampCapacity)
+    {
+        NSUInteger capacity = STKPXGrowCapacity(scratch->stampCapacity, ruleSetCount);
+
+        scratch->stamps = realloc(scratch->stamps, capacity * sizeof(uint32_t));
+        memset(scratch->stamps + scratch->stampCapacity, 0, (capacity - scratch->stampCapacity) * sizeof(uint32_t));
+        scratch->stampCapacity = capacity;
+    }
+
+    // moving to a new generation invalidates all marks at once. Clear them for real when the counter wraps
+    scratch->generation++;
+
+    if (scratch->generation == 0)
+    {
+        memset(scratch->stamps, 0, scratch->stampCapacity * sizeof(uint32_t));
+        scratch->generation = 1;
+    }
+}
+
+void STKPXRuleSetScratchAddOrdinals(STKPXRuleSetScratch *scratch, const NSUInteger *ordinals, NSUInteger count)
+{
+    if (scratch->ordinalCount + count > scratch->ordinalCapacity)
+    {
+        scratch->ordinalCapacity = STKPXGrowCapacity(scratch->ordinalCapacity, scratch->ordinalCount + count);
+        scratch->ordinals = realloc(scratch->ordinals, scratch->ordinalCapacity * sizeof(NSUInteger));
+    }
+
+    uint32_t generation = scratch->generation;
+    uint32_t *stamps = scratch->stamps;
+    NSUInteger *output = scratch->ordinals + scratch->ordinalCount;
+
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        NSUInteger ordinal = ordinals[i];
+
+        if (stamps[ordinal] != generation)
+        {
+            stamps[ordinal] = generation;
+            *output++ = ordinal;
+        }
+    }
+
+    scratch->ordinalCount = output - scratch->ordinals;
+}
+
+void STKPXRuleSetScratchSortOrdinals(STKPXRuleSetScratch *scratch)
+{
+    NSUInteger *ordinals = scratch->ordinals;
+    NSUInteger count = scratch->ordinalCount;
+
+    if (count > STKPX_INSERTION_SORT_LIMIT)
+    {
+        qsort(ordinals, count, sizeof(NSUInteger), STKPXCompareOrdinals);
+    }
+    else
+    {
+        for (NSUInteger i = 1; i < count; i++)
+        {
+            NSUInteger value = ordinals[i];
+            NSUInteger j = i;
+
+            while (j > 0 && ordinals[j - 1] > value)
+            {
+                ordinals[j] = ordinals[j - 1];
+                j--;
+            }
+
+            ordinals[j] = value;
+        }
+    }
+}
+
+#pragma mark - Matches
+
+void STKPXRuleSetScratchAppendRuleSet(STKPXRuleSetScratch *scratch, STKPXRuleSet *ruleSet)
+{
+    if (scratch->ruleSetCount == scratch->ruleSetCapacity)
+    {
+        scratch->ruleSetCapacity = STKPXGrowCapacity(scratch->ruleSetCapacity, scratch->ruleSetCount + 1);
+        scratch->ruleSets = (__unsafe_unretained id *)realloc(scratch->ruleSets, scratch->ruleSetCapacity * sizeof(id));
+    }
+
+    CFRetain((__bridge CFTypeRef)ruleSet);
+    scratch->ruleSets[scratch->ruleSetCount++] = ruleSet;
+}
@@ -0,0 +1,132 @@
+/****************************************************************************
+ *
+ * Copyright 2015-present StylingKit Development Team. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ****************************************************************************/
+
+//
+//  STKPXStylesheetFragment.h
+//  StylingKit
+//
+
+#import <Foundation/Foundation.h>
+
+@class STKPXStylesheetFragment;
+
+/**
+ *  A block waiting for a fragment that is being loaded in the background, see
+ *  [STKPXStylesheetFragment loadFragmentForPath:importChain:]
+ */
+typedef STKPXStylesheetFragment *(^STKPXStylesheetFragmentFuture)(void);
+
+/**
+ *  A STKPXStylesheetFragment holds the parsed content of a stylesheet file that is pulled in by @import. The file's
+ *  own imports are already merged into it, in source order. Fragments are not modified once parsed, so a fragment is
+ *  shared by every stylesheet importing its file. Importing stylesheets add copies of the fragment's rule sets, since
+ *  adding a rule set to a stylesheet assigns it the stylesheet's origin.
+ *
+ *  Fragments are cached by path. A cached fragment is reused for as long as the modification date and size of its
+ *  file, and of every file it imports, are unchanged.
+ */
+@interface STKPXStylesheetFragment : NSObject
+
+/**
+ *  The path of the file this fragment was parsed from
+ */
+@property (readonly, nonatomic, copy) NSString *path;
+
+/**
+ *  A nonmutable array of STKPXMediaGroup instances, in source order. A group's query is nil for rule sets outside of
+ *  any @media block
+ */
+@property (readonly, nonatomic, strong) NSArray *mediaGroups;
+
+/**
+ *  A nonmutable array of the STKPXKeyframe instances defined in this fragment
+ */
+@property (readonly, nonatomic, strong) NSArray *keyframes;
+
+/**
+ *  A nonmutable dictionary of namespace URIs, keyed by prefix
+ */
+@property (readonly, nonatomic, strong) NSDictionary *namespaces;
+
+/**
+ *  A nonmutable array of the src declarations of @font-face rules. Fonts are loaded when the fragment is merged into
+ *  a stylesheet, not while it is parsed in the background
+ */
+@property (readonly, nonatomic, strong) NSArray *fontSources;
+
+/**
+ *  A nonmutable array of the errors encountered while parsing this fragment and its imports
+ */
+@property (readonly, nonatomic, strong) NSArray *errors;
+
+/**
+ *  The files this fragment was built from, this fragment's own file included. Each path maps to the modification date
+ *  and size the file had when it was read
+ */
+@property (readonly, nonatomic, strong) NSDictionary *dependencies;
+
+/**
+ *  A flag indicating that an @import cycle was cut while parsing this fragment. What such a fragment contains depends
+ *  on the files that imported it, so it is never cached
+ */
+@property (readonly, nonatomic) BOOL hasImportCycle;
+
+/**
+ *  Return the fragment for the specified file, from the cache when it is still current
+ *
+ *  @param path The absolute path of the file to import
+ *  @param importChain The paths of the files importing this one, outermost first, used to detect @import cycles
+ */
++ (STKPXStylesheetFragment *)fragmentForPath:(NSString *)path importChain:(NSArray *)importChain;
+
+/**
+ *  Start loading the fragment for the specified file on a background queue. Call the returned block to wait for the
+ *  fragment
+ *
+ *  @param path The absolute path of the file to import
+ *  @param importChain The paths of the files importing this one, outermost first, used to detect @import cycles
+ */
++ (STKPXStylesheetFragmentFuture)loadFragmentForPath:(NSString *)path importChain:(NSArray *)importChain;
+
+/**
+ *  Return the modification date and size of a file as stored in dependencies, or nil if the file does not exist
+ *
+ *  @param path The path of the file
+ */
++ (NSArray *)versionOfFileAtPath:(NSString *)path;
+
+/**
+ *  Remove all fragments from the cache
+ */
++ (void)clearCache;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ *  Initialize a new fragment. This is used by STKPXStylesheetParser
+ */
+- (instancetype)initWithPath:(NSString *)path
+                 mediaGroups:(NSArray *)mediaGroups
+                   keyframes:(NSArray *)keyframes
+                  namespaces:(NSDictionary *)namespaces
+                 fontSources:(NSArray *)fontSources
+                      errors:(NSArray *)errors
+                dependencies:(NSDictionary *)dependencies
+              hasImportCycle:(BOOL)hasImportCycle NS_DESIGNATED_INITIALIZER;
+
+@end
@@ -0,0 +1,181 @@
+/****************************************************************************
+ *
+ * Copyright 2015-present StylingKit Development Team. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ****************************************************************************/
+
+//
+//  STKPXStylesheetFragment.m
+//  StylingKit
+//
+
+#import "STKPXStylesheetFragment.h"
+#import "STKPXStylesheetParser.h"
+#import "STKPXFileUtils.h"
+
+static NSMutableDictionary *FRAGMENT_CACHE;
+static dispatch_queue_t IMPORT_QUEUE;
+
+@implementation STKPXStylesheetFragment
+
+#pragma mark - Static initializers
+
++ (void)initialize
+{
+    if (FRAGMENT_CACHE == nil)
+    {
+        FRAGMENT_CACHE = [[NSMutableDictionary alloc] init];
+    }
+
+    if (IMPORT_QUEUE == nil)
+    {
+        IMPORT_QUEUE = dispatch_queue_create("com.stylingkit.imports", DISPATCH_QUEUE_CONCURRENT);
+    }
+}
+
++ (STKPXStylesheetFragment *)fragmentForPath:(NSString *)path importChain:(NSArray *)importChain
+{
+    STKPXStylesheetFragment *result = [self cachedFragmentForPath:path importChain:importChain];
+
+    if (result == nil)
+    {
+        // read the version first, so a file changing while it is read is parsed again next time
+        NSArray *version = [self versionOfFileAtPath:path];
+        NSString *source = [STKPXFileUtils sourceFromPath:path];
+
+        result = [[[STKPXStylesheetParser alloc] init] parseFragment:source
+                                                                path:path
+                                                             version:version
+                                                         importChain:importChain];
+
+        if (version != nil && !result.hasImportCycle)
+        {
+            @synchronized(FRAGMENT_CACHE)
+            {
+                FRAGMENT_CACHE[path] = result;
+            }
+        }
+    }
+
+    return result;
+}
+
++ (STKPXStylesheetFragmentFuture)loadFragmentForPath:(NSString *)path importChain:(NSArray *)importChain
+{
+    dispatch_group_t group = dispatch_group_create();
+    __block STKPXStylesheetFragment *result = nil;
+
+    dispatch_group_async(group, IMPORT_QUEUE, ^{
+        result = [self fragmentForPath:path importChain:importChain];
+    });
+
+    return ^STKPXStylesheetFragment *{
+        dispatch_group_wait(group, DISPATCH_TIME_FOREVER);
+
+        return result;
+    };
+}
+
++ (NSArray *)versionOfFileAtPath:(NSString *)path
+{
+    NSDictionary *attributes = (path.length > 0) ? [[NSFileManager defaultManager] attributesOfItemAtPath:path error:NULL] : nil;
+
+    return (attributes != nil) ? @[ attributes.fileModificationDate ?: [NSDate distantPast], @(attributes.fileSize) ] : nil;
+}
+
++ (void)clearCache
+{
+    @synchronized(FRAGMENT_CACHE)
+    {
+        [FRAGMENT_CACHE removeAllObjects];
+    }
+}
+
++ (STKPXStylesheetFragment *)cachedFragmentForPath:(NSString *)path importChain:(NSArray *)importChain
+{
+    STKPXStylesheetFragment *result;
+
+    @synchronized(FRAGMENT_CACHE)
+    {
+        result = FRAGMENT_CACHE[path];
+    }
+
+    if (result != nil)
+    {
+        __block BOOL current = YES;
+
+        [result.dependencies enumerateKeysAndObjectsUsingBlock:^(NSString *dependency, NSArray *version, BOOL *stop) {
+            // a fragment built from a file that is importing it now has to be parsed again to report the cycle
+            if ([importChain containsObject:dependency] || ![[self versionOfFileAtPath:dependency] isEqualToArray:version])
+            {
+                current = NO;
+                *stop = YES;
+            }
+        }];
+
+        if (!current)
+        {
+            @synchronized(FRAGMENT_CACHE)
+            {
+                if (FRAGMENT_CACHE[path] == result)
+                {
+                    [FRAGMENT_CACHE removeObjectForKey:path];
+                }
+            }
+
+            result = nil;
+        }
+    }
+
+    return result;
+}
+
+#pragma mark - Initializers
+
+- (instancetype)initWithPath:(NSString *)path
+                 mediaGroups:(NSArray *)mediaGroups
+                   keyframes:(NSArray *)keyframes
+                  namespaces:(NSDictionary *)namespaces
+                 fontSources:(NSArray *)fontSources
+                      errors:(NSArray *)errors
+                dependencies:(NSDictionary *)dependencies
+              hasImportCycle:(BOOL)hasImportCycle
+{
+    if (self = [super init])
+    {
+        _path = [path copy];
+        _mediaGroups = [mediaGroups copy] ?: @[];
+        _keyframes = [keyframes copy] ?: @[];
+        _namespaces = [namespaces copy] ?: @{};
+        _fontSources = [fontSources copy] ?: @[];
+        _errors = [errors copy] ?: @[];
+        _dependencies = [dependencies copy] ?: @{};
+        _hasImportCycle = hasImportCycle;
+    }
+
+    return self;
+}
+
+#pragma mark - Overrides
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<STKPXStylesheetFragment path='%@' groups=%lu dependencies=%lu>",
+                                      _path.lastPathComponent,
+                                      (unsigned long) _mediaGroups.count,
+                                      (unsigned long) _dependencies.count];
+}
+
+@end
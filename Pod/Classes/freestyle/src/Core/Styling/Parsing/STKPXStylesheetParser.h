@@ -28,6 +28,8 @@
 #import "STKPXStylesheetLexer.h"
 #import "STKPXSelector.h"
 
+@class STKPXStylesheetFragment;
+
 /**
  *  STKPXStylesheetParser is responsible for making the first pass on CSS source. This pass generates expression trees for
  *  selectors. However, rule set bodies are mostly scanned only. The parser recognizes a declaration's name (property
@@ -56,6 +58,21 @@
  */
 - (STKPXStylesheet *)parse:(NSString *)source withOrigin:(STKPXStylesheetOrigin)origin filename:(NSString *)name;
 
+/**
+ *  Parse the source of an imported file into a fragment, see STKPXStylesheetFragment. Imports of the file are merged
+ *  into the fragment. A parser creates no stylesheet that becomes current while parsing fragments, so fragments can be
+ *  parsed off the main thread, each with its own parser.
+ *
+ *  @param source The CSS to parse
+ *  @param path The path of the file being imported
+ *  @param version The modification date and size of the file, see [STKPXStylesheetFragment versionOfFileAtPath:]
+ *  @param importChain The paths of the files importing this one, outermost first
+ */
+- (STKPXStylesheetFragment *)parseFragment:(NSString *)source
+                                      path:(NSString *)path
+                                   version:(NSArray *)version
+                               importChain:(NSArray *)importChain;
+
 /**
  *  Treat the specified source as inline CSS, as if it were coming from a style attribute.
  *
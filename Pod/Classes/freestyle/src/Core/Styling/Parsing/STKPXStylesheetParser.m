@@ -46,13 +46,19 @@
 #import "PixateFreestyle.h"
 #import "STKPXKeyframeBlock.h"
 #import "STKPXFontRegistry.h"
+#import "STKPXStylesheetFragment.h"
+#import "STKPXMediaGroup.h"
 
 @implementation STKPXStylesheetParser
 {
     STKPXStylesheetLexer *lexer_;
     STKPXStylesheet *currentStyleSheet_;
     STKPXTypeSelector *currentSelector_;
-    NSMutableArray *activeImports_;
+    NSArray *importChain_;
+    NSMutableDictionary *pendingImports_;
+    NSMutableArray *fontSources_;
+    NSMutableDictionary *dependencies_;
+    BOOL hasImportCycle_;
 }
 
 STK_DEFINE_CLASS_LOG_LEVEL
@@ -234,8 +240,8 @@ static NSIndexSet *ARCHAIC_PSEUDO_ELEMENTS_SET;
 
 - (STKPXStylesheet *)parse:(NSString *)source withOrigin:(STKPXStylesheetOrigin)origin filename:(NSString *)name
 {
-    // add the source file name to prevent @imports from importing it as well
-    [self addImportName:name];
+    // start the import chain with the source file name to prevent @imports from importing it as well
+    importChain_ = (name.length > 0) ? @[ name.stringByStandardizingPath ] : nil;
 
     // parse
     STKPXStylesheet *result = [self parse:source withOrigin:origin];
@@ -254,6 +260,9 @@ static NSIndexSet *ARCHAIC_PSEUDO_ELEMENTS_SET;
     // create stylesheet
     currentStyleSheet_ = [[STKPXStylesheet alloc] initWithOrigin:origin];
 
+    // start loading the leading @imports while this source is parsed
+    [self prefetchImportsOfSource:source];
+
     // setup lexer and prime it
     lexer_.source = source;
     [self advance];
@@ -297,11 +306,48 @@ static NSIndexSet *ARCHAIC_PSEUDO_ELEMENTS_SET;
     }
 
     // clear out any import refs
-    activeImports_ = nil;
+    importChain_ = nil;
+    pendingImports_ = nil;
 
     return currentStyleSheet_;
 }
 
+- (STKPXStylesheetFragment *)parseFragment:(NSString *)source
+                                      path:(NSString *)path
+                                   version:(NSArray *)version
+                               importChain:(NSArray *)importChain
+{
+    importChain_ = (importChain.count > 0) ? [importChain arrayByAddingObject:path] : @[ path ];
+    fontSources_ = [[NSMutableArray alloc] init];
+    dependencies_ = [[NSMutableDictionary alloc] init];
+    hasImportCycle_ = NO;
+
+    if (version != nil)
+    {
+        dependencies_[path] = version;
+    }
+
+    // inline stylesheets are never made current, so parsing one has no effect on styling
+    STKPXStylesheet *stylesheet = (source.length > 0)
+        ? [self parse:source withOrigin:STKPXStylesheetOriginInline]
+        : nil;
+
+    STKPXStylesheetFragment *result = [[STKPXStylesheetFragment alloc] initWithPath:path
+                                                                        mediaGroups:stylesheet.mediaGroups
+                                                                          keyframes:stylesheet.keyframesByName.allValues
+                                                                         namespaces:stylesheet.namespacePrefixMap
+                                                                        fontSources:fontSources_
+                                                                             errors:self.errors
+                                                                       dependencies:dependencies_
+                                                                     hasImportCycle:hasImportCycle_];
+
+    importChain_ = nil;
+    fontSources_ = nil;
+    dependencies_ = nil;
+
+    return result;
+}
+
 - (STKPXStylesheet *)parseInlineCSS:(NSString *)css
 {
     // clear errors
@@ -378,7 +424,7 @@ static NSIndexSet *ARCHAIC_PSEUDO_ELEMENTS_SET;
         {
             if ([@"src" isEqualToString:declaration.name])
             {
-                [STKPXFontRegistry loadFontFromURL:declaration.URLValue];
+                [self addFontSource:declaration];
             }
         }
     }
@@ -389,64 +435,33 @@ static NSIndexSet *ARCHAIC_PSEUDO_ELEMENTS_SET;
     [self assertTypeAndAdvance:STKPXSS_IMPORT];
     [self assertTypeInSet:IMPORT_SET];
 
-    NSString *path = nil;
-
-    switch (currentLexeme.type)
-    {
-        case STKPXSS_STRING:
-        {
-            NSString *string = currentLexeme.value;
-
-            if (string.length > 2)
-            {
-                path = [string substringWithRange:NSMakeRange(1, string.length - 2)];
-            }
-
-            break;
-        }
-
-        case STKPXSS_URL:
-            path = currentLexeme.value;
-            break;
-    }
+    NSString *path = [self importPathFromLexeme:(STKPXStylesheetLexeme *) currentLexeme];
 
     if (path)
     {
-        // advance over @import argument
+        // advance over @import argument and the trailing semicolon
+        [self advance];
         [self advance];
 
-        // calculate resource name and file extension
-        NSString *pathMinusExtension = path.stringByDeletingPathExtension;
-        NSString *extension = path.pathExtension.lowercaseString;
-        NSString *bundlePath = [[NSBundle mainBundle] pathForResource:pathMinusExtension ofType:extension];
+        NSString *resolvedPath = [self resolveImportPath:path];
 
-        if (![activeImports_ containsObject:bundlePath])
+        if ([importChain_ containsObject:resolvedPath])
         {
-            // we need to go ahead and process the trailing semicolon so we have the corrent lexeme in case we push it
-            // below
-            [self advance];
-
-            [self addImportName:bundlePath];
+            NSString *message
+                = [NSString stringWithFormat:@"@import cycle detected trying to import '%@':\n%@ ->\n%@", path, [importChain_ componentsJoinedByString:@" ->\n"], resolvedPath];
 
-            NSString *source = [STKPXFileUtils sourceFromResource:pathMinusExtension ofType:extension];
+            [self addError:message];
 
-            if (source.length > 0)
-            {
-                [lexer_ pushLexeme:currentLexeme];
-                [lexer_ pushSource:source];
-                [self advance];
-            }
+            hasImportCycle_ = YES;
         }
-        else
+        else if (resolvedPath != nil)
         {
-            NSString *message
-                = [NSString stringWithFormat:@"@import cycle detected trying to import '%@':\n%@ ->\n%@", path, [activeImports_ componentsJoinedByString:@" ->\n"], bundlePath];
+            STKPXStylesheetFragmentFuture pending = pendingImports_[resolvedPath];
+            STKPXStylesheetFragment *fragment = (pending != nil)
+                ? pending()
+                : [STKPXStylesheetFragment fragmentForPath:resolvedPath importChain:importChain_];
 
-            [self addError:message];
-
-            // NOTE: we do this here so we'll still have the current file on the active imports stack. This handles the
-            // case of a file ending with an @import statement, causing advance to pop it from the active imports stack
-            [self advance];
+            [self mergeFragment:fragment];
         }
     }
 }
@@ -1647,14 +1662,7 @@ static NSIndexSet *ARCHAIC_PSEUDO_ELEMENTS_SET;
 
 - (void)lexerDidPopSource
 {
-    if (activeImports_.count > 0)
-    {
-        [activeImports_ pop];
-    }
-    else
-    {
-        DDLogError(@"Tried to pop an empty activeImports array");
-    }
+    // imports are parsed into fragments, so sources are never pushed
 }
 
 #pragma mark - Overrides
@@ -1676,21 +1684,182 @@ static NSIndexSet *ARCHAIC_PSEUDO_ELEMENTS_SET;
     lexer_ = nil;
     currentStyleSheet_ = nil;
     currentSelector_ = nil;
-    activeImports_ = nil;
+    importChain_ = nil;
+    pendingImports_ = nil;
 }
 
 #pragma mark - Helpers
 
-- (void)addImportName:(NSString *)name
+- (NSString *)importPathFromLexeme:(STKPXStylesheetLexeme *)lexeme
 {
-    if (name.length > 0)
+    NSString *path = nil;
+
+    switch (lexeme.type)
     {
-        if (activeImports_ == nil)
+        case STKPXSS_STRING:
         {
-            activeImports_ = [[NSMutableArray alloc] init];
+            NSString *string = lexeme.value;
+
+            if (string.length > 2)
+            {
+                path = [string substringWithRange:NSMakeRange(1, string.length - 2)];
+            }
+
+            break;
         }
 
-        [activeImports_ push:name];
+        case STKPXSS_URL:
+            path = lexeme.value;
+            break;
+    }
+
+    return path;
+}
+
+- (NSString *)resolveImportPath:(NSString *)path
+{
+    if (path.length == 0)
+    {
+        return nil;
+    }
+
+    // paths are standardized so that different spellings of a path can't hide a cycle
+    if (path.isAbsolutePath)
+    {
+        return path.stringByStandardizingPath;
+    }
+
+    // look next to the importing file first
+    NSString *importer = importChain_.lastObject;
+
+    if (importer.isAbsolutePath)
+    {
+        NSString *sibling = [importer.stringByDeletingLastPathComponent stringByAppendingPathComponent:path].stringByStandardizingPath;
+
+        if ([[NSFileManager defaultManager] fileExistsAtPath:sibling])
+        {
+            return sibling;
+        }
+    }
+
+    // calculate resource name and file extension
+    NSString *pathMinusExtension = path.stringByDeletingPathExtension;
+    NSString *extension = path.pathExtension.lowercaseString;
+
+    return [[NSBundle mainBundle] pathForResource:pathMinusExtension ofType:extension].stringByStandardizingPath;
+}
+
+- (void)prefetchImportsOfSource:(NSString *)source
+{
+    pendingImports_ = nil;
+
+    if ([source rangeOfString:@"@import"].location == NSNotFound)
+    {
+        return;
+    }
+
+    NSMutableArray *paths = [NSMutableArray array];
+    STKPXStylesheetLexer *lexer = [[STKPXStylesheetLexer alloc] initWithString:source];
+    STKPXStylesheetLexeme *lexeme = lexer.nextLexeme;
+
+    // CSS requires @imports to come first, so only that leading run is loaded ahead. Later ones load when reached
+    while (lexeme != nil && lexeme.type == STKPXSS_IMPORT)
+    {
+        NSString *path = [self resolveImportPath:[self importPathFromLexeme:lexer.nextLexeme]];
+
+        if (path != nil && ![importChain_ containsObject:path] && ![paths containsObject:path])
+        {
+            [paths addObject:path];
+        }
+
+        lexeme = lexer.nextLexeme;
+
+        if (lexeme.type == STKPXSS_SEMICOLON)
+        {
+            lexeme = lexer.nextLexeme;
+        }
+    }
+
+    // a single import gains nothing from being loaded on another thread
+    if (paths.count > 1)
+    {
+        pendingImports_ = [[NSMutableDictionary alloc] init];
+
+        for (NSString *path in paths)
+        {
+            pendingImports_[path] = [STKPXStylesheetFragment loadFragmentForPath:path importChain:importChain_];
+        }
+    }
+}
+
+- (void)mergeFragment:(STKPXStylesheetFragment *)fragment
+{
+    for (NSString *error in fragment.errors)
+    {
+        // errors of imported files already name their file and offset
+        [super addError:error];
+    }
+
+    [fragment.namespaces enumerateKeysAndObjectsUsingBlock:^(NSString *prefix, NSString *uri, BOOL *stop) {
+        [currentStyleSheet_ setURI:uri forNamespacePrefix:prefix];
+    }];
+
+    for (STKPXKeyframe *keyframe in fragment.keyframes)
+    {
+        [currentStyleSheet_ addKeyframe:keyframe];
+    }
+
+    for (STKPXDeclaration *declaration in fragment.fontSources)
+    {
+        [self addFontSource:declaration];
+    }
+
+    // adding a rule set to a stylesheet sets its origin, so the fragment's rule sets are copied
+    for (STKPXMediaGroup *group in fragment.mediaGroups)
+    {
+        currentStyleSheet_.activeMediaQuery = group.query;
+
+        for (STKPXRuleSet *ruleSet in group.ruleSets)
+        {
+            STKPXRuleSet *copy = [[STKPXRuleSet alloc] init];
+
+            for (id<STKPXSelector> selector in ruleSet.selectors)
+            {
+                [copy addSelector:selector];
+            }
+
+            for (STKPXDeclaration *declaration in ruleSet.declarations)
+            {
+                [copy addDeclaration:declaration];
+            }
+
+            [currentStyleSheet_ addRuleSet:copy];
+        }
+    }
+
+    currentStyleSheet_.activeMediaQuery = nil;
+
+    if (dependencies_ != nil)
+    {
+        [dependencies_ addEntriesFromDictionary:fragment.dependencies];
+    }
+
+    if (fragment.hasImportCycle)
+    {
+        hasImportCycle_ = YES;
+    }
+}
+
+- (void)addFontSource:(STKPXDeclaration *)declaration
+{
+    if (fontSources_ != nil)
+    {
+        // fragments are parsed in the background, where the shared value parser can't be used
+        [fontSources_ addObject:declaration];
+    }
+    else
+    {
+        [STKPXFontRegistry loadFontFromURL:declaration.URLValue];
     }
 }
 
@@ -1711,7 +1880,7 @@ static NSIndexSet *ARCHAIC_PSEUDO_ELEMENTS_SET;
 
 - (NSString *)currentFilename
 {
-    return (activeImports_.count > 0) ? [activeImports_.lastObject lastPathComponent] : nil;
+    return (importChain_.count > 0) ? [importChain_.lastObject lastPathComponent] : nil;
 }
 
 - (void)addError:(NSString *)error
@@ -39,6 +39,7 @@
 #import "STKPXAnimationInfo.h"
 #import "STKPXValue.h"
 #import "STKPXImagePaint.h"
+#import "STKPXPaintPool.h"
 
 @implementation STKPXValueParser
 {
@@ -1276,6 +1277,12 @@ static NSString *ASSET_SCHEME = @"asset://";
 
             [self advance];
         }
+
+        // gradients are complete once their blend mode is known, so share one instance (and one CGGradient) per value
+        if ([result isKindOfClass:[STKPXGradient class]])
+        {
+            result = [[STKPXPaintPool sharedInstance] internGradient:(STKPXGradient *) result];
+        }
     }
     else
     {
@@ -1479,69 +1486,77 @@ static NSString *ASSET_SCHEME = @"asset://";
     return result;
 }
 
-- (UIColor *)color
+// read a value from [0,255] or a percentage and return in range [0,1]
+- (CGFloat)readByteOrPercentWithDivisor:(CGFloat)divisor
 {
-    UIColor *result = nil;
-
-    // read a value from [0,255] or a percentage and return in range [0,1]
-    CGFloat (^readByteOrPercent)(CGFloat) = ^CGFloat(CGFloat divisor) {
-        CGFloat result = 0.0f;
-
-        if ([self isType:STKPXSS_NUMBER])
-        {
-            NSNumber *number = (NSNumber *)currentLexeme.value;
-
-            result = number.floatValue / divisor;
-
-            [self advance];
-        }
-        else if ([self isType:STKPXSS_PERCENTAGE])
-        {
-            CGFloat percent = ((STKPXDimension *)currentLexeme.value).number;
+    CGFloat result = 0.0f;
+    STKPXStylesheetLexeme *lexeme = currentLexeme;
 
-            result = percent / 100.0f;
+    switch (lexeme.type)
+    {
+        case STKPXSS_NUMBER:
+            result = ((NSNumber *) lexeme.value).floatValue / divisor;
+            lexeme = [self advance];
+            break;
 
-            [self advance];
-        }
+        case STKPXSS_PERCENTAGE:
+            result = ((STKPXDimension *) lexeme.value).number / 100.0f;
+            lexeme = [self advance];
+            break;
 
-        [self advanceIfIsType:STKPXSS_COMMA];
+        default:
+            break;
+    }
 
-        return result;
-    };
+    if (lexeme.type == STKPXSS_COMMA)
+    {
+        [self advance];
+    }
 
-    // read a value from [0,360] or an angle and return in range [0,1]
-    CGFloat (^readAngle)() = ^CGFloat() {
-        CGFloat result = 0.0f;
+    return result;
+}
 
-        if ([self isType:STKPXSS_NUMBER])
-        {
-            NSNumber *number = (NSNumber *)currentLexeme.value;
+// read a value from [0,360] or an angle and return in range [0,1]
+- (CGFloat)readAngle
+{
+    CGFloat result = 0.0f;
+    STKPXStylesheetLexeme *lexeme = currentLexeme;
 
-            result = number.floatValue / 360.0f;
+    switch (lexeme.type)
+    {
+        case STKPXSS_NUMBER:
+            result = ((NSNumber *) lexeme.value).floatValue / 360.0f;
+            lexeme = [self advance];
+            break;
 
-            [self advance];
-        }
-        else if ([self isType:STKPXSS_ANGLE])
-        {
-            STKPXDimension *degrees = ((STKPXDimension *)currentLexeme.value).degrees;
+        case STKPXSS_ANGLE:
+            result = ((STKPXDimension *) lexeme.value).degrees.number / 360.0f;
+            lexeme = [self advance];
+            break;
 
-            result = degrees.number / 360.0f;
+        default:
+            break;
+    }
 
-            [self advance];
-        }
+    if (lexeme.type == STKPXSS_COMMA)
+    {
+        [self advance];
+    }
 
-        [self advanceIfIsType:STKPXSS_COMMA];
+    return result;
+}
 
-        return result;
-    };
+- (UIColor *)color
+{
+    UIColor *result = nil;
 
     switch (currentLexeme.type)
     {
         case STKPXSS_RGB:
             [self advance];
-            result = [UIColor colorWithRed:readByteOrPercent(255.0f)
-                                     green:readByteOrPercent(255.0f)
-                                      blue:readByteOrPercent(255.0f)
+            result = [UIColor colorWithRed:[self readByteOrPercentWithDivisor:255.0f]
+                                     green:[self readByteOrPercentWithDivisor:255.0f]
+                                      blue:[self readByteOrPercentWithDivisor:255.0f]
                                      alpha:1.0f];
             [self assertTypeAndAdvance:STKPXSS_RPAREN];
             break;
@@ -1570,12 +1585,12 @@ static NSString *ASSET_SCHEME = @"asset://";
             }
             else
             {
-                r = readByteOrPercent(255.0f);
-                g = readByteOrPercent(255.0f);
-                b = readByteOrPercent(255.0f);
+                r = [self readByteOrPercentWithDivisor:255.0f];
+                g = [self readByteOrPercentWithDivisor:255.0f];
+                b = [self readByteOrPercentWithDivisor:255.0f];
             }
 
-            a = readByteOrPercent(1.0f);
+            a = [self readByteOrPercentWithDivisor:1.0f];
             result = [UIColor colorWithRed:r green:g blue:b alpha:a];
 
             [self assertTypeAndAdvance:STKPXSS_RPAREN];
@@ -1584,37 +1599,37 @@ static NSString *ASSET_SCHEME = @"asset://";
 
         case STKPXSS_HSL:
             [self advance];
-            result = [UIColor colorWithHue:readAngle()
-                                saturation:readByteOrPercent(255.0f)
-                                 lightness:readByteOrPercent(255.0f)
+            result = [UIColor colorWithHue:[self readAngle]
+                                saturation:[self readByteOrPercentWithDivisor:255.0f]
+                                 lightness:[self readByteOrPercentWithDivisor:255.0f]
                                      alpha:1.0f];
             [self assertTypeAndAdvance:STKPXSS_RPAREN];
             break;
 
         case STKPXSS_HSLA:
             [self advance];
-            result = [UIColor colorWithHue:readAngle()
-                                saturation:readByteOrPercent(255.0f)
-                                 lightness:readByteOrPercent(255.0f)
-                                     alpha:readByteOrPercent(1.0f)];
+            result = [UIColor colorWithHue:[self readAngle]
+                                saturation:[self readByteOrPercentWithDivisor:255.0f]
+                                 lightness:[self readByteOrPercentWithDivisor:255.0f]
+                                     alpha:[self readByteOrPercentWithDivisor:1.0f]];
             [self assertTypeAndAdvance:STKPXSS_RPAREN];
             break;
 
         case STKPXSS_HSB:
             [self advance];
-            result = [UIColor colorWithHue:readAngle()
-                                saturation:readByteOrPercent(255.0f)
-                                brightness:readByteOrPercent(255.0f)
+            result = [UIColor colorWithHue:[self readAngle]
+                                saturation:[self readByteOrPercentWithDivisor:255.0f]
+                                brightness:[self readByteOrPercentWithDivisor:255.0f]
                                      alpha:1.0f];
             [self assertTypeAndAdvance:STKPXSS_RPAREN];
             break;
 
         case STKPXSS_HSBA:
             [self advance];
-            result = [UIColor colorWithHue:readAngle()
-                                saturation:readByteOrPercent(255.0f)
-                                brightness:readByteOrPercent(255.0f)
-                                     alpha:readByteOrPercent(1.0f)];
+            result = [UIColor colorWithHue:[self readAngle]
+                                saturation:[self readByteOrPercentWithDivisor:255.0f]
+                                brightness:[self readByteOrPercentWithDivisor:255.0f]
+                                     alpha:[self readByteOrPercentWithDivisor:1.0f]];
             [self assertTypeAndAdvance:STKPXSS_RPAREN];
             break;
 
@@ -1632,7 +1647,8 @@ static NSString *ASSET_SCHEME = @"asset://";
             [self errorWithMessage:@"Expected RGB, RGBA, HSB, HSBA, HSL, HSLA, COLOR (hex color), or IDENTIFIER (named color)"];
     }
 
-    return result;
+    // share one instance per color value across all declarations
+    return [[STKPXPaintPool sharedInstance] internColor:result];
 }
 
 #pragma mark - Overrides
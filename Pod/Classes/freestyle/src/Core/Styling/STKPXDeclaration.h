@@ -43,6 +43,11 @@
 @property (readonly, nonatomic, strong) NSArray *lexemes;
 @property (nonatomic) BOOL important;
 
+/**
+ *  The source text of this declaration's value, as it appeared in the stylesheet
+ */
+@property (readonly, nonatomic, strong) NSString *source;
+
 /**
  *  Initializes a newly allocated STKPXDeclaration using the specified property name
  *
@@ -31,11 +31,51 @@
 #import "STKPXValue.h"
 #import "STKPXStylerContext.h"
 
-#define IsNotCachedType(T) ![cache_ isKindOfClass:[STKPXValue class]] || ((STKPXValue *)cache_).type != STKPXValueType_##T
+/**
+ *  The kinds of typed values a declaration can produce. Each kind is parsed at most once per source
+ */
+typedef NS_ENUM(NSUInteger, STKPXDeclarationValueKind) {
+    STKPXDeclarationValueKind_AffineTransform,
+    STKPXDeclarationValueKind_AnimationInfoList,
+    STKPXDeclarationValueKind_TransitionInfoList,
+    STKPXDeclarationValueKind_AnimationDirectionList,
+    STKPXDeclarationValueKind_AnimationFillModeList,
+    STKPXDeclarationValueKind_AnimationPlayStateList,
+    STKPXDeclarationValueKind_AnimationTimingFunctionList,
+    STKPXDeclarationValueKind_Boolean,
+    STKPXDeclarationValueKind_Border,
+    STKPXDeclarationValueKind_BorderRadiiList,
+    STKPXDeclarationValueKind_BorderStyle,
+    STKPXDeclarationValueKind_BorderStyleList,
+    STKPXDeclarationValueKind_CacheStylesType,
+    STKPXDeclarationValueKind_Color,
+    STKPXDeclarationValueKind_Float,
+    STKPXDeclarationValueKind_FloatList,
+    STKPXDeclarationValueKind_Insets,
+    STKPXDeclarationValueKind_Length,
+    STKPXDeclarationValueKind_LetterSpacing,
+    STKPXDeclarationValueKind_LineBreakMode,
+    STKPXDeclarationValueKind_NameList,
+    STKPXDeclarationValueKind_Offsets,
+    STKPXDeclarationValueKind_PaintList,
+    STKPXDeclarationValueKind_Paint,
+    STKPXDeclarationValueKind_ParseErrorDestination,
+    STKPXDeclarationValueKind_Seconds,
+    STKPXDeclarationValueKind_SecondsList,
+    STKPXDeclarationValueKind_Size,
+    STKPXDeclarationValueKind_Shadow,
+    STKPXDeclarationValueKind_String,
+    STKPXDeclarationValueKind_TextAlignment,
+    STKPXDeclarationValueKind_TextBorderStyle,
+};
+
+// the number of transformed strings remembered by transformString:
+static const NSUInteger kMaxTransformedStrings = 16;
 
 @implementation STKPXDeclaration
 {
-    id cache_;
+    NSMutableDictionary *values_;
+    NSMutableDictionary *transformedStrings_;
     NSUInteger hash_;
     NSString *source_;
     NSString *filename_;
@@ -90,7 +130,6 @@ static NSDictionary *ESCAPE_SEQUENCE_MAP;
     if (self = [super init])
     {
         _name = name;
-        cache_ = nil;
 
         [self setSource:value filename:nil lexemes:[STKPXValueParser lexemesForSource:value]];
     }
@@ -98,6 +137,13 @@ static NSDictionary *ESCAPE_SEQUENCE_MAP;
     return self;
 }
 
+#pragma mark - Getters
+
+- (NSString *)source
+{
+    return source_;
+}
+
 #pragma mark - Setters
 
 - (void)setSource:(NSString *)source filename:(NSString *)filename lexemes:(NSArray *)lexemes
@@ -106,6 +152,10 @@ static NSDictionary *ESCAPE_SEQUENCE_MAP;
     source_ = source;
     filename_ = filename;
 
+    // values parsed from the previous source no longer apply
+    values_ = nil;
+    transformedStrings_ = nil;
+
     hash_ = _name.hash;
 
     if (lexemes.count > 0)
@@ -126,104 +176,111 @@ static NSDictionary *ESCAPE_SEQUENCE_MAP;
 
 - (CGAffineTransform)affineTransformValue
 {
-    if (IsNotCachedType(CGAffineTransform))
-    {
+    STKPXValue *value = [self valueOfKind:STKPXDeclarationValueKind_AffineTransform parsedWith:^id {
         STKPXTransformParser *transformParser = [[STKPXTransformParser alloc] init];
         CGAffineTransform result = [transformParser parse:self.stringValue];
 
-        cache_ = [[STKPXValue alloc] initWithBytes:&result type:STKPXValueType_CGAffineTransform];
-    }
+        return [[STKPXValue alloc] initWithBytes:&result type:STKPXValueType_CGAffineTransform];
+    }];
 
-    return ((STKPXValue *)cache_).CGAffineTransformValue;
+    return value.CGAffineTransformValue;
 }
 
 - (NSArray *)animationInfoList
 {
-    // TODO: cache
-    return [self.parser parseAnimationInfos:_lexemes];
+    NSArray *infos = [self valueOfKind:STKPXDeclarationValueKind_AnimationInfoList parsedWith:^id {
+        return [self.parser parseAnimationInfos:_lexemes];
+    }];
+
+    // stylers fill in the infos they are given, so hand out copies
+    return [[NSArray alloc] initWithArray:infos copyItems:YES];
 }
 
 - (NSArray *)transitionInfoList
 {
-    // TODO: cache
-    return [self.parser parseTransitionInfos:_lexemes];
+    NSArray *infos = [self valueOfKind:STKPXDeclarationValueKind_TransitionInfoList parsedWith:^id {
+        return [self.parser parseTransitionInfos:_lexemes];
+    }];
+
+    // stylers fill in the infos they are given, so hand out copies
+    return [[NSArray alloc] initWithArray:infos copyItems:YES];
 }
 
 - (NSArray *)animationDirectionList
 {
-    // TODO: cache
-    return [self.parser parseAnimationDirectionList:_lexemes];
+    return [self valueOfKind:STKPXDeclarationValueKind_AnimationDirectionList parsedWith:^id {
+        return [self.parser parseAnimationDirectionList:_lexemes];
+    }];
 }
 
 - (NSArray *)animationFillModeList
 {
-    // TODO: cache
-    return [self.parser parseAnimationFillModeList:_lexemes];
+    return [self valueOfKind:STKPXDeclarationValueKind_AnimationFillModeList parsedWith:^id {
+        return [self.parser parseAnimationFillModeList:_lexemes];
+    }];
 }
 
 - (NSArray *)animationPlayStateList
 {
-    // TODO: cache
-    return [self.parser parseAnimationPlayStateList:_lexemes];
+    return [self valueOfKind:STKPXDeclarationValueKind_AnimationPlayStateList parsedWith:^id {
+        return [self.parser parseAnimationPlayStateList:_lexemes];
+    }];
 }
 
 - (NSArray *)animationTimingFunctionList
 {
-    // TODO: cache
-    return [self.parser parseAnimationTimingFunctionList:_lexemes];
+    return [self valueOfKind:STKPXDeclarationValueKind_AnimationTimingFunctionList parsedWith:^id {
+        return [self.parser parseAnimationTimingFunctionList:_lexemes];
+    }];
 }
 
 - (BOOL)booleanValue
 {
-    if (IsNotCachedType(Boolean))
-    {
+    STKPXValue *value = [self valueOfKind:STKPXDeclarationValueKind_Boolean parsedWith:^id {
         NSString *text = self.firstWord;
         BOOL result = ([@"yes" isEqualToString:text] || [@"true" isEqualToString:text]);
 
-        cache_ = [[STKPXValue alloc] initWithBytes:&result type:STKPXValueType_Boolean];
-    }
+        return [[STKPXValue alloc] initWithBytes:&result type:STKPXValueType_Boolean];
+    }];
 
-    return ((STKPXValue *) cache_).BooleanValue;
+    return value.BooleanValue;
 }
 
 - (STKPXBorderInfo *)borderValue
 {
-    if (cache_ != [NSNull null] && ![cache_ isKindOfClass:[STKPXBorderInfo class]])
-    {
-        cache_ = [self.parser parseBorder:_lexemes];
-    }
-
-    return (cache_ != [NSNull null]) ? cache_ : nil;
+    return [self valueOfKind:STKPXDeclarationValueKind_Border parsedWith:^id {
+        return [self.parser parseBorder:_lexemes];
+    }];
 }
 
 - (NSArray *)borderRadiiList
 {
-    // TODO: cache
-    return [self.parser parseBorderRadiusList:_lexemes];
+    return [self valueOfKind:STKPXDeclarationValueKind_BorderRadiiList parsedWith:^id {
+        return [self.parser parseBorderRadiusList:_lexemes];
+    }];
 }
 
 - (STKPXBorderStyle)borderStyleValue
 {
-    if (IsNotCachedType(STKPXBorderStyle))
-    {
+    STKPXValue *value = [self valueOfKind:STKPXDeclarationValueKind_BorderStyle parsedWith:^id {
         STKPXBorderStyle style = [self.parser parseBorderStyle:_lexemes];
 
-        cache_ = [[STKPXValue alloc] initWithBytes:&style type:STKPXValueType_STKPXBorderStyle];
-    }
+        return [[STKPXValue alloc] initWithBytes:&style type:STKPXValueType_STKPXBorderStyle];
+    }];
 
-    return ((STKPXValue *) cache_).STKPXBorderStyleValue;
+    return value.STKPXBorderStyleValue;
 }
 
 - (NSArray *)borderStyleList
 {
-    // TODO: cache
-    return [self.parser parseBorderStyleList:_lexemes];
+    return [self valueOfKind:STKPXDeclarationValueKind_BorderStyleList parsedWith:^id {
+        return [self.parser parseBorderStyleList:_lexemes];
+    }];
 }
 
 - (STKPXCacheStylesType)cacheStylesTypeValue
 {
-    if (IsNotCachedType(STKPXCacheStylesType))
-    {
+    STKPXValue *value = [self valueOfKind:STKPXDeclarationValueKind_CacheStylesType parsedWith:^id {
         STKPXCacheStylesType type = STKPXCacheStylesTypeNone;
         NSArray *words = self.nameListValue;
 
@@ -255,25 +312,17 @@ static NSDictionary *ESCAPE_SEQUENCE_MAP;
             }
         }
 
-        cache_ = [[STKPXValue alloc] initWithBytes:&type type:STKPXValueType_STKPXCacheStylesType];
-    }
+        return [[STKPXValue alloc] initWithBytes:&type type:STKPXValueType_STKPXCacheStylesType];
+    }];
 
-    return ((STKPXValue *) cache_).STKPXCacheStylesTypeValue;
+    return value.STKPXCacheStylesTypeValue;
 }
 
 - (UIColor *)colorValue
 {
-    if (cache_ != [NSNull null] && ![cache_ isKindOfClass:[UIColor class]])
-    {
-        cache_ = [self.parser parseColor:_lexemes];
-
-        if (cache_ == nil)
-        {
-            cache_ = [NSNull null];
-        }
-    }
-
-    return (cache_ != [NSNull null]) ? cache_ : nil;
+    return [self valueOfKind:STKPXDeclarationValueKind_Color parsedWith:^id {
+        return [self.parser parseColor:_lexemes];
+    }];
 }
 
 - (NSString *)firstWord
@@ -296,57 +345,57 @@ static NSDictionary *ESCAPE_SEQUENCE_MAP;
 
 - (CGFloat)floatValue
 {
-    if (IsNotCachedType(CGFloat))
-    {
+    STKPXValue *value = [self valueOfKind:STKPXDeclarationValueKind_Float parsedWith:^id {
         CGFloat result = [self.parser parseFloat:_lexemes];
 
-        cache_ = [[STKPXValue alloc] initWithBytes:&result type:STKPXValueType_CGFloat];
-    }
+        return [[STKPXValue alloc] initWithBytes:&result type:STKPXValueType_CGFloat];
+    }];
 
-    return ((STKPXValue *) cache_).CGFloatValue;
+    return value.CGFloatValue;
 }
 
 - (NSArray *)floatListValue
 {
-    // TODO: cache
-    return [self.parser parseFloatList:_lexemes];
+    return [self valueOfKind:STKPXDeclarationValueKind_FloatList parsedWith:^id {
+        return [self.parser parseFloatList:_lexemes];
+    }];
 }
 
 - (UIEdgeInsets)insetsValue
 {
-    if (IsNotCachedType(UIEdgeInsets))
-    {
+    STKPXValue *value = [self valueOfKind:STKPXDeclarationValueKind_Insets parsedWith:^id {
         UIEdgeInsets insets = [self.parser parseInsets:_lexemes];
 
-        cache_ = [[STKPXValue alloc] initWithBytes:&insets type:STKPXValueType_UIEdgeInsets];
-    }
+        return [[STKPXValue alloc] initWithBytes:&insets type:STKPXValueType_UIEdgeInsets];
+    }];
 
-    return ((STKPXValue *)cache_).UIEdgeInsetsValue;
+    return value.UIEdgeInsetsValue;
 }
 
 - (STKPXDimension *)lengthValue
 {
-    if (![cache_ isKindOfClass:[STKPXDimension class]])
-    {
+    return [self valueOfKind:STKPXDeclarationValueKind_Length parsedWith:^id {
+        STKPXDimension *result = nil;
+
         if (_lexemes.count > 0)
         {
             STKPXStylesheetLexeme *lexeme = _lexemes[0];
 
             if (lexeme.type == STKPXSS_LENGTH)
             {
-                cache_ = lexeme.value;
+                result = lexeme.value;
             }
             else if (lexeme.type == STKPXSS_NUMBER)
             {
                 NSNumber *number = lexeme.value;
 
-                cache_ = [[STKPXDimension alloc] initWithNumber:number.floatValue withDimension:@"STKPX"];
+                result = [[STKPXDimension alloc] initWithNumber:number.floatValue withDimension:@"STKPX"];
             }
             // error
         }
-    }
 
-    return cache_;
+        return result;
+    }];
 }
 
 // TODO: The return type if diff, but the enum order is the same...
@@ -366,69 +415,53 @@ static NSDictionary *ESCAPE_SEQUENCE_MAP;
         };
     });
 
-    if (IsNotCachedType(NSLineBreakMode))
-    {
+    STKPXValue *value = [self valueOfKind:STKPXDeclarationValueKind_LineBreakMode parsedWith:^id {
         NSLineBreakMode mode = NSLineBreakByTruncatingMiddle;
         NSString *text = self.firstWord;
-        NSNumber *value = [MAP valueForKey:text];
+        NSNumber *number = [MAP valueForKey:text];
 
-        if (value)
+        if (number)
         {
-            mode = (NSLineBreakMode) value.intValue;
+            mode = (NSLineBreakMode) number.intValue;
         }
 
-        cache_ = [[STKPXValue alloc] initWithBytes:&mode type:STKPXValueType_NSLineBreakMode];
-    }
+        return [[STKPXValue alloc] initWithBytes:&mode type:STKPXValueType_NSLineBreakMode];
+    }];
 
-    return ((STKPXValue *) cache_).NSLineBreakModeValue;
+    return value.NSLineBreakModeValue;
 }
 
 - (NSArray *)nameListValue
 {
-    // TODO: cache
-    return [self.parser parseNameList:_lexemes];
+    return [self valueOfKind:STKPXDeclarationValueKind_NameList parsedWith:^id {
+        return [self.parser parseNameList:_lexemes];
+    }];
 }
 
 - (STKPXOffsets *)offsetsValue
 {
-    if (cache_ != [NSNull null] && ![cache_ isKindOfClass:[STKPXOffsets class]])
-    {
-        cache_ = [self.parser parseOffsets:_lexemes];
-
-        if (cache_ == nil)
-        {
-            cache_ = [NSNull null];
-        }
-    }
-
-    return (cache_ != [NSNull null]) ? cache_ : nil;
+    return [self valueOfKind:STKPXDeclarationValueKind_Offsets parsedWith:^id {
+        return [self.parser parseOffsets:_lexemes];
+    }];
 }
 
 - (NSArray *)paintList
 {
-    // TODO: cache
-    return [self.parser parsePaints:_lexemes];
+    return [self valueOfKind:STKPXDeclarationValueKind_PaintList parsedWith:^id {
+        return [self.parser parsePaints:_lexemes];
+    }];
 }
 
 - (id<STKPXPaint>)paintValue
 {
-    if (cache_ != [NSNull null] && ![cache_ conformsToProtocol:@protocol(STKPXPaint)])
-    {
-        cache_ = [self.parser parsePaint:_lexemes];
-
-        if (cache_ == nil)
-        {
-            cache_ = [NSNull null];
-        }
-    }
-
-    return (cache_ != [NSNull null]) ? cache_ : nil;
+    return [self valueOfKind:STKPXDeclarationValueKind_Paint parsedWith:^id {
+        return [self.parser parsePaint:_lexemes];
+    }];
 }
 
 - (STKPXParseErrorDestination)parseErrorDestinationValue
 {
-    if (IsNotCachedType(STKPXParseErrorDestination))
-    {
+    STKPXValue *value = [self valueOfKind:STKPXDeclarationValueKind_ParseErrorDestination parsedWith:^id {
         STKPXParseErrorDestination destination = STKPXParseErrorDestinationNone;
         NSString *text = self.firstWord;
 
@@ -443,55 +476,51 @@ static NSDictionary *ESCAPE_SEQUENCE_MAP;
         }
 #endif
 
-        cache_ = [[STKPXValue alloc] initWithBytes:&destination type:STKPXValueType_STKPXParseErrorDestination];
-    }
+        return [[STKPXValue alloc] initWithBytes:&destination type:STKPXValueType_STKPXParseErrorDestination];
+    }];
 
-    return ((STKPXValue *) cache_).STKPXParseErrorDestinationValue;
+    return value.STKPXParseErrorDestinationValue;
 }
 
 - (CGFloat)secondsValue
 {
-    // TODO: cache
-    return [self.parser parseSeconds:_lexemes];
+    STKPXValue *value = [self valueOfKind:STKPXDeclarationValueKind_Seconds parsedWith:^id {
+        CGFloat result = [self.parser parseSeconds:_lexemes];
+
+        return [[STKPXValue alloc] initWithBytes:&result type:STKPXValueType_CGFloat];
+    }];
+
+    return value.CGFloatValue;
 }
 
 - (NSArray *)secondsListValue
 {
-    // TODO: cache
-    return [self.parser parseSecondsList:_lexemes];
+    return [self valueOfKind:STKPXDeclarationValueKind_SecondsList parsedWith:^id {
+        return [self.parser parseSecondsList:_lexemes];
+    }];
 }
 
 - (CGSize)sizeValue
 {
-    if (IsNotCachedType(CGSize))
-    {
+    STKPXValue *value = [self valueOfKind:STKPXDeclarationValueKind_Size parsedWith:^id {
         CGSize result = [self.parser parseSize:_lexemes];
 
-        cache_ = [[STKPXValue alloc] initWithBytes:&result type:STKPXValueType_CGSize];
-    }
+        return [[STKPXValue alloc] initWithBytes:&result type:STKPXValueType_CGSize];
+    }];
 
-    return ((STKPXValue *)cache_).CGSizeValue;
+    return value.CGSizeValue;
 }
 
 - (id<STKPXShadowPaint>)shadowValue
 {
-    if (cache_ != [NSNull null] && ![cache_ conformsToProtocol:@protocol(STKPXShadowPaint)])
-    {
-        cache_ = [self.parser parseShadow:_lexemes];
-
-        if (cache_ == nil)
-        {
-            cache_ = [NSNull null];
-        }
-    }
-
-    return (cache_ != [NSNull null]) ? cache_ : nil;
+    return [self valueOfKind:STKPXDeclarationValueKind_Shadow parsedWith:^id {
+        return [self.parser parseShadow:_lexemes];
+    }];
 }
 
 - (NSString *)stringValue
 {
-    if (![cache_ isKindOfClass:[NSString class]])
-    {
+    return [self valueOfKind:STKPXDeclarationValueKind_String parsedWith:^id {
         NSMutableArray *parts = [NSMutableArray arrayWithCapacity:_lexemes.count];
 
         for (STKPXStylesheetLexeme *lexeme in _lexemes)
@@ -530,10 +559,8 @@ static NSDictionary *ESCAPE_SEQUENCE_MAP;
         }
 
         // TODO: create another method to allow join string to be defined?
-        cache_ = [parts componentsJoinedByString:@" "];
-    }
-
-    return cache_;
+        return [parts componentsJoinedByString:@" "];
+    }];
 }
 
 - (NSTextAlignment)textAlignmentValue
@@ -548,21 +575,20 @@ static NSDictionary *ESCAPE_SEQUENCE_MAP;
         };
     });
 
-    if (IsNotCachedType(NSTextAlignment))
-    {
+    STKPXValue *value = [self valueOfKind:STKPXDeclarationValueKind_TextAlignment parsedWith:^id {
         NSTextAlignment alignment = NSTextAlignmentCenter;
         NSString *text = self.firstWord;
-        NSNumber *value = MAP[text];
+        NSNumber *number = MAP[text];
 
-        if (value)
+        if (number)
         {
-            alignment = (NSTextAlignment) value.intValue;
+            alignment = (NSTextAlignment) number.intValue;
         }
 
-        cache_ = [[STKPXValue alloc] initWithBytes:&alignment type:STKPXValueType_NSTextAlignment];
-    }
+        return [[STKPXValue alloc] initWithBytes:&alignment type:STKPXValueType_NSTextAlignment];
+    }];
 
-    return ((STKPXValue *) cache_).NSTextAlignmentValue;
+    return value.NSTextAlignmentValue;
 }
 
 - (UITextBorderStyle)textBorderStyleValue
@@ -577,50 +603,72 @@ static NSDictionary *ESCAPE_SEQUENCE_MAP;
         };
     });
 
-    if (IsNotCachedType(UITextBorderStyle))
-    {
+    STKPXValue *value = [self valueOfKind:STKPXDeclarationValueKind_TextBorderStyle parsedWith:^id {
         UITextBorderStyle style = UITextBorderStyleNone;
         NSString *text = self.firstWord;
-        NSNumber *value = MAP[text];
+        NSNumber *number = MAP[text];
 
-        if (value)
+        if (number)
         {
-            style = (UITextBorderStyle) value.intValue;
+            style = (UITextBorderStyle) number.intValue;
         }
 
-        cache_ = [[STKPXValue alloc] initWithBytes:&style type:STKPXValueType_UITextBorderStyle];
-    }
+        return [[STKPXValue alloc] initWithBytes:&style type:STKPXValueType_UITextBorderStyle];
+    }];
 
-    return ((STKPXValue *) cache_).UITextBorderStyleValue;
+    return value.UITextBorderStyleValue;
 }
 
 - (NSString *)transformString:(NSString *)value
 {
-    NSString *text = self.firstWord;
-    return [STKPXStylerContext transformString:value usingAttribute:text];
-}
+    if (value == nil)
+    {
+        return [STKPXStylerContext transformString:value usingAttribute:self.firstWord];
+    }
 
-- (STKPXDimension *)letterSpacingValue
-{
-    STKPXDimension *result = nil;
-    if (_lexemes.count > 0)
+    // the result depends on the input, so remember the last few inputs rather than a single value
+    NSString *result = transformedStrings_[value];
+
+    if (result == nil)
     {
-        STKPXStylesheetLexeme *lexeme = _lexemes[0];
-        
-        if (lexeme.type == STKPXSS_LENGTH || lexeme.type == STKPXSS_EMS || lexeme.type == STKPXSS_PERCENTAGE)
-        {
-            result = lexeme.value;
-        }
-        else if (lexeme.type == STKPXSS_NUMBER)
+        result = [STKPXStylerContext transformString:value usingAttribute:self.firstWord];
+
+        if (transformedStrings_ == nil || transformedStrings_.count >= kMaxTransformedStrings)
         {
-            NSNumber *number = lexeme.value;
-            result = [[STKPXDimension alloc] initWithNumber:number.floatValue withDimension:@"STKPX"];
+            transformedStrings_ = [[NSMutableDictionary alloc] initWithCapacity:kMaxTransformedStrings];
         }
-        // error
+
+        transformedStrings_[value] = result;
     }
+
     return result;
 }
 
+- (STKPXDimension *)letterSpacingValue
+{
+    return [self valueOfKind:STKPXDeclarationValueKind_LetterSpacing parsedWith:^id {
+        STKPXDimension *result = nil;
+
+        if (_lexemes.count > 0)
+        {
+            STKPXStylesheetLexeme *lexeme = _lexemes[0];
+
+            if (lexeme.type == STKPXSS_LENGTH || lexeme.type == STKPXSS_EMS || lexeme.type == STKPXSS_PERCENTAGE)
+            {
+                result = lexeme.value;
+            }
+            else if (lexeme.type == STKPXSS_NUMBER)
+            {
+                NSNumber *number = lexeme.value;
+                result = [[STKPXDimension alloc] initWithNumber:number.floatValue withDimension:@"STKPX"];
+            }
+            // error
+        }
+
+        return result;
+    }];
+}
+
 - (NSURL *)URLValue
 {
     // NOTE: When we generate URLs during the parse, we sometimes look for other files based on the specified file. It's
@@ -631,6 +679,38 @@ static NSDictionary *ESCAPE_SEQUENCE_MAP;
 
 #pragma mark - Helpers
 
+/**
+ *  Return the value of the specified kind, parsing it on first use. Every kind has its own slot, so reading one kind
+ *  never discards another. Nil results are remembered as well
+ *
+ *  @param kind The kind of value to return
+ *  @param parse The block producing the value when it has not been parsed yet
+ */
+- (id)valueOfKind:(STKPXDeclarationValueKind)kind parsedWith:(id (^)(void))parse
+{
+    NSNumber *key = @(kind);
+    id value = values_[key];
+
+    if (value == nil)
+    {
+        value = parse();
+
+        if (value == nil)
+        {
+            value = [NSNull null];
+        }
+
+        if (values_ == nil)
+        {
+            values_ = [[NSMutableDictionary alloc] initWithCapacity:1];
+        }
+
+        values_[key] = value;
+    }
+
+    return (value != [NSNull null]) ? value : nil;
+}
+
 - (STKPXValueParser *)parser
 {
     // TODO: pull from parser pool?
@@ -643,7 +723,8 @@ static NSDictionary *ESCAPE_SEQUENCE_MAP;
 
 - (void)dealloc
 {
-    cache_ = nil;
+    values_ = nil;
+    transformedStrings_ = nil;
     source_ = nil;
     _name = nil;
     _lexemes = nil;
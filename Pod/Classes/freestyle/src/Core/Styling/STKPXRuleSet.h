@@ -53,6 +53,12 @@
  */
 @property (readonly, nonatomic) STKPXTypeSelector *targetTypeSelector;
 
+/**
+ *  The state bits of the pseudo-classes on the target type selector. Zero means the rule set applies to the default
+ *  state only. The mask is computed when the rule set is added to a media group, or on first use otherwise
+ */
+@property (readonly, nonatomic) uint64_t stateMask;
+
 /**
  *  A class method used to merge multiple rule sets into a single rule set, taking specificity of each rule set into
  *  account. The resulting rule set's selectors and specificity properties are undefined.
@@ -61,6 +67,22 @@
  */
 + (instancetype)ruleSetWithMergedRuleSets:(NSArray *)ruleSets;
 
+/**
+ *  Merge rule sets that are already sorted by ascending specificity, see sortRuleSetsBySpecificity:. This allows one
+ *  sort to be shared by several merges over subsets of the same list.
+ *
+ *  @param sortedRuleSets An array of rule sets to merge
+ */
++ (instancetype)ruleSetWithMergedSortedRuleSets:(NSArray *)sortedRuleSets;
+
+/**
+ *  Return rule sets ordered by ascending specificity. Rule sets of equal specificity keep their relative order, so
+ *  later ones win when merged
+ *
+ *  @param ruleSets An array of rule sets to sort
+ */
++ (NSArray *)sortRuleSetsBySpecificity:(NSArray *)ruleSets;
+
 /**
  *  Add a selector to the list of selectors associated with this rule set
  *
@@ -75,4 +97,9 @@
  */
 - (BOOL)matches:(id<STKPXStyleable>)element;
 
+/**
+ *  Recompute stateMask from the current selectors
+ */
+- (void)updateStateMask;
+
 @end
@@ -32,23 +32,38 @@
 @implementation STKPXRuleSet
 {
     NSMutableArray *selectors;
+    uint64_t stateMask_;
+    BOOL stateMaskValid_;
 }
 
 #pragma mark - Static initializers
 
 + (instancetype)ruleSetWithMergedRuleSets:(NSArray *)ruleSets
 {
-    STKPXRuleSet *result = [[STKPXRuleSet alloc] init];
+    // order rules by specificity
+    return [self ruleSetWithMergedSortedRuleSets:[self sortRuleSetsBySpecificity:ruleSets]];
+}
 
-    if (ruleSets.count > 0)
++ (NSArray *)sortRuleSetsBySpecificity:(NSArray *)ruleSets
+{
+    if (ruleSets.count < 2)
     {
-        // order rules by specificity
-        NSArray *sortedRuleSets =
-            [ruleSets sortedArrayUsingComparator:^NSComparisonResult(STKPXRuleSet *a, STKPXRuleSet *b)
-             {
-                 return [a.specificity compareSpecificity:b.specificity];
-             }];
+        return ruleSets;
+    }
+
+    return [ruleSets sortedArrayWithOptions:NSSortStable
+                            usingComparator:^NSComparisonResult(STKPXRuleSet *a, STKPXRuleSet *b)
+            {
+                return [a.specificity compareSpecificity:b.specificity];
+            }];
+}
+
++ (instancetype)ruleSetWithMergedSortedRuleSets:(NSArray *)sortedRuleSets
+{
+    STKPXRuleSet *result = [[STKPXRuleSet alloc] init];
 
+    if (sortedRuleSets.count > 0)
+    {
         for (STKPXRuleSet *ruleSet in [sortedRuleSets reverseObjectEnumerator])
         {
             // add selectors
@@ -132,8 +147,24 @@
     return result;
 }
 
+- (uint64_t)stateMask
+{
+    if (!stateMaskValid_)
+    {
+        [self updateStateMask];
+    }
+
+    return stateMask_;
+}
+
 #pragma mark - Methods
 
+- (void)updateStateMask
+{
+    stateMask_ = self.targetTypeSelector.pseudoClassStateMask;
+    stateMaskValid_ = YES;
+}
+
 - (void)addSelector:(id<STKPXSelector>)selector
 {
     if (selector)
@@ -144,6 +175,7 @@
         }
 
         [selectors addObject:selector];
+        stateMaskValid_ = NO;
 
         [selector incrementSpecificity:_specificity];
     }
@@ -115,12 +115,13 @@ typedef NS_ENUM(unsigned int, STKPXStylingMode)
 - (void)updateStylesNonRecursively;
 
 /**
- *  Update styles for this styleable and all of its descendant styleables asynchronously
+ *  Update styles for this styleable and all of its descendant styleables asynchronously. Requests are coalesced by
+ *  STKPXRestyleScheduler and styled together on the next turn of the main run loop
  */
 - (void)updateStylesAsync;
 
 /**
- *  Update styles for this styleable only asynchronously
+ *  Update styles for this styleable only asynchronously. Requests are coalesced by STKPXRestyleScheduler
  */
 - (void)updateStylesNonRecursivelyAsync;
 
@@ -129,6 +130,11 @@ typedef NS_ENUM(unsigned int, STKPXStylingMode)
  */
 @property (nonatomic, copy) NSString *styleCSS;
 
+/**
+ *  Inline styles as an already parsed rule set. When implemented, this is used instead of parsing styleCSS on every
+ *  styling pass
+ */
+@property (readonly, nonatomic) STKPXRuleSet *inlineRuleSet;
 
 /**
  *  Return the namespace URI associated with this object
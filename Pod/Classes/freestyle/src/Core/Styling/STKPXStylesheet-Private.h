@@ -25,8 +25,10 @@
 #import "STKPXRuleSet.h"
 #import "STKPXStyleable.h"
 #import "STKPXKeyframe.h"
+#import "STKPXRuleSetScratch.h"
 
 @class STKPXMediaGroup;
+@class STKPXStylesheetDiff;
 @protocol STKPXMediaExpression;
 
 /**
@@ -45,6 +47,16 @@
  */
 @property (readonly, nonatomic, strong) NSArray *mediaGroups;
 
+/**
+ *  A nonmutable dictionary of the keyframes defined in this stylesheet, keyed by name
+ */
+@property (readonly, nonatomic, strong) NSDictionary *keyframesByName;
+
+/**
+ *  A nonmutable dictionary of the namespace URIs registered in this stylesheet, keyed by prefix
+ */
+@property (readonly, nonatomic, strong) NSDictionary *namespacePrefixMap;
+
 /**
  *  The current media query that applies to any rule sets added to this stylesheet
  */
@@ -66,6 +78,16 @@
  */
 + (id)styleSheetFromFilePath:(NSString *)filePath withOrigin:(STKPXStylesheetOrigin)origin;
 
+/**
+ *  Parse the stylesheet file again, make it current for the specified origin, and restyle only the styleables matched
+ *  by rule sets that changed since the previous stylesheet of that origin. Everything is restyled when the change
+ *  cannot be narrowed down, see STKPXStylesheetDiff
+ *
+ *  @param filePath The string path to the stylesheet file
+ *  @param origin The specificity origin for this stylesheet
+ */
++ (STKPXStylesheetDiff *)reloadStyleSheetFromFilePath:(NSString *)filePath withOrigin:(STKPXStylesheetOrigin)origin;
+
 /**
  *  A class-level getter returning the current application-level stylesheet. This value may be nil
  */
@@ -119,6 +141,15 @@
  */
 - (NSArray *)ruleSetsMatchingStyleable:(id<STKPXStyleable>)element;
 
+/**
+ *  Append the rule sets whose selectors match against a specified element to the span of a scratch. Matches are in
+ *  media group order, and in source order within each group
+ *
+ *  @param element The element to match against
+ *  @param scratch The scratch collecting matches, see STKPXRuleSetScratchAcquire
+ */
+- (void)appendRuleSetsMatchingStyleable:(id<STKPXStyleable>)element toScratch:(STKPXRuleSetScratch *)scratch;
+
 /**
  *  Add a keyframe animation to this stylesheet
  *
@@ -27,6 +27,7 @@
 #import "STKPXStylesheet-Private.h"
 #import "STKPXSpecificity.h"
 #import "STKPXStylesheetParser.h"
+#import "STKPXStylesheetDiff.h"
 #import "STKPXFileWatcher.h"
 #import "STKPXStyleUtils.h"
 #import "STKPXMediaExpression.h"
@@ -70,22 +71,10 @@ STK_DEFINE_CLASS_LOG_LEVEL
 
 + (instancetype)styleSheetFromSource:(NSString *)source withOrigin:(STKPXStylesheetOrigin)origin filename:(NSString *)name
 {
-    STKPXStylesheet *result = nil;
-
-    // TODO: maybe the following can be more intelligent and only remove cache entries that reference the stylesheet being replaced
-
     // clear style cache
     [PixateFreestyle clearStyleCache];
 
-    if (source.length > 0)
-    {
-        result = [PARSER parse:source withOrigin:origin filename:name];
-        result->_errors = PARSER.errors;
-    }
-    else
-    {
-        result = [[STKPXStylesheet alloc] initWithOrigin:origin];
-    }
+    STKPXStylesheet *result = [self parseSource:source withOrigin:origin filename:name];
 
     // update configuration - !!! This needs to be done some other way, just don't know how yet
     [STKPXStyleUtils updateStyleForStyleable:PixateFreestyle.configuration];
@@ -100,6 +89,48 @@ STK_DEFINE_CLASS_LOG_LEVEL
     return [self styleSheetFromSource:source withOrigin:origin filename:aFilePath];
 }
 
++ (STKPXStylesheetDiff *)reloadStyleSheetFromFilePath:(NSString *)aFilePath withOrigin:(STKPXStylesheetOrigin)origin
+{
+    STKPXStylesheet *previous = [self currentStylesheetForOrigin:origin];
+    NSString* source = [NSString stringWithContentsOfFile:aFilePath encoding:NSUTF8StringEncoding error:NULL];
+
+    // parsing makes the new stylesheet current, but leaves the style cache to be cleared below
+    STKPXStylesheet *result = [self parseSource:source withOrigin:origin filename:aFilePath];
+    STKPXStylesheetDiff *diff = [[STKPXStylesheetDiff alloc] initWithStylesheet:previous stylesheet:result];
+
+    if (diff.requiresFullRestyle)
+    {
+        [PixateFreestyle clearStyleCache];
+        [STKPXStyleUtils updateStyleForStyleable:PixateFreestyle.configuration];
+        [PixateFreestyle updateStylesForAllViews];
+    }
+    else if (!diff.isEmpty)
+    {
+        // cached style trees of cells that aren't on screen, such as those in reuse queues, may hold declarations of
+        // changed rule sets too. Dropping them is cheap; only the restyle is limited to the affected styleables
+        [PixateFreestyle clearStyleCache];
+
+        if ([diff affectsStyleable:PixateFreestyle.configuration])
+        {
+            [STKPXStyleUtils updateStyleForStyleable:PixateFreestyle.configuration];
+        }
+
+        for (UIWindow *window in [UIApplication sharedApplication].windows)
+        {
+            [diff restyleAffectedStyleablesInStyleable:window];
+        }
+    }
+
+    DDLogInfo(@"Reloaded %@: %lu removed, %lu added, %lu unchanged rule sets%@",
+              aFilePath.lastPathComponent,
+              (unsigned long) diff.removedRuleSets.count,
+              (unsigned long) diff.addedRuleSets.count,
+              (unsigned long) diff.unchangedCount,
+              (diff.requiresFullRestyle) ? @", restyled all views" : @"");
+
+    return diff;
+}
+
 + (void)clearCache
 {
     [[self currentApplicationStylesheet] clearCache];
@@ -179,6 +210,16 @@ STK_DEFINE_CLASS_LOG_LEVEL
     return mediaGroups_;
 }
 
+- (NSDictionary *)keyframesByName
+{
+    return keyframesByName_;
+}
+
+- (NSDictionary *)namespacePrefixMap
+{
+    return namespacePrefixMap_;
+}
+
 + (STKPXStylesheet *)currentApplicationStylesheet
 {
 	return currentApplicationStylesheet;
@@ -210,12 +251,8 @@ STK_DEFINE_CLASS_LOG_LEVEL
         if(state)
         {
             [[STKPXFileWatcher sharedInstance] watchFile:self.filePath handler:^{
-                // reload file
-                [STKPXStylesheet styleSheetFromFilePath:self.filePath withOrigin:self.origin];
-
-                // update all views
-                [PixateFreestyle updateStylesForAllViews];
-
+                // reload file, restyling only what the changed rule sets match
+                [STKPXStylesheet reloadStyleSheetFromFilePath:self.filePath withOrigin:self.origin];
             }];
         }
         else
@@ -257,25 +294,45 @@ STK_DEFINE_CLASS_LOG_LEVEL
 
 - (NSArray *)ruleSetsMatchingStyleable:(id<STKPXStyleable>)element
 {
-    NSMutableArray *result = [NSMutableArray array];
+    NSMutableArray *result;
+
+    if (element)
+    {
+        STKPXRuleSetScratch *scratch = STKPXRuleSetScratchAcquire();
+
+        [self appendRuleSetsMatchingStyleable:element toScratch:scratch];
+
+        result = [[NSMutableArray alloc] initWithObjects:scratch->ruleSets count:scratch->ruleSetCount];
+
+        STKPXRuleSetScratchRelinquish(scratch);
+    }
+    else
+    {
+        result = [NSMutableArray array];
+    }
 
+    return result;
+}
+
+- (void)appendRuleSetsMatchingStyleable:(id<STKPXStyleable>)element toScratch:(STKPXRuleSetScratch *)scratch
+{
     if (element)
     {
-        NSArray *candidateRuleSets = [self ruleSetsForStyleable:element];
-        DDLogDebug(@"%@ = %lu", [STKPXStyleUtils descriptionForStyleable:element], (unsigned long)candidateRuleSets.count);
+        NSUInteger start = scratch->ruleSetCount;
 
-        for (STKPXRuleSet *ruleSet in candidateRuleSets)
+        for (STKPXMediaGroup *group in mediaGroups_)
         {
-            if ([ruleSet matches:element])
+            if ([group matches])
             {
-                DDLogInfo(@"%@ matched\n%@", [STKPXStyleUtils descriptionForStyleable:element], ruleSet.description);
-
-                [result addObject:ruleSet];
+                [group appendRuleSetsMatchingStyleable:element toScratch:scratch];
             }
         }
-    }
 
-    return result;
+        for (NSUInteger i = start; i < scratch->ruleSetCount; i++)
+        {
+            DDLogInfo(@"%@ matched\n%@", [STKPXStyleUtils descriptionForStyleable:element], [scratch->ruleSets[i] description]);
+        }
+    }
 }
 
 - (void)setURI:(NSString *)uri forNamespacePrefix:(NSString *)prefix
@@ -337,6 +394,43 @@ STK_DEFINE_CLASS_LOG_LEVEL
 
 #pragma mark - Static private methods
 
++ (instancetype)parseSource:(NSString *)source withOrigin:(STKPXStylesheetOrigin)origin filename:(NSString *)name
+{
+    STKPXStylesheet *result = nil;
+
+    if (source.length > 0)
+    {
+        result = [PARSER parse:source withOrigin:origin filename:name];
+        result->_errors = PARSER.errors;
+    }
+    else
+    {
+        result = [[STKPXStylesheet alloc] initWithOrigin:origin];
+    }
+
+    return result;
+}
+
++ (STKPXStylesheet *)currentStylesheetForOrigin:(STKPXStylesheetOrigin)anOrigin
+{
+    switch (anOrigin)
+    {
+        case STKPXStylesheetOriginApplication:
+            return currentApplicationStylesheet;
+
+        case STKPXStylesheetOriginUser:
+            return currentUserStylesheet;
+
+        case STKPXStylesheetOriginView:
+            return currentViewStylesheet;
+
+        case STKPXStylesheetOriginInline:
+            return nil;
+    }
+
+    return nil;
+}
+
 + (void)assignCurrentStylesheet:(STKPXStylesheet *)sheet withOrigin:(STKPXStylesheetOrigin)anOrigin
 {
     switch (anOrigin)
@@ -0,0 +1,96 @@
+/****************************************************************************
+ *
+ * Copyright 2015-present StylingKit Development Team. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ****************************************************************************/
+
+//
+//  STKPXStylesheetDiff.h
+//  StylingKit
+//
+
+#import <Foundation/Foundation.h>
+#import "STKPXStylesheet.h"
+#import "STKPXStyleable.h"
+
+/**
+ *  STKPXStylesheetDiff compares two versions of a stylesheet rule set by rule set. A rule set is identified by its
+ *  media query, selectors, and declarations, so rule sets that survive an edit untouched are not reported. Styleables
+ *  only need to be restyled when one of the removed or added rule sets matches them
+ */
+@interface STKPXStylesheetDiff : NSObject
+
+/**
+ *  The rule sets of the old stylesheet that have no counterpart in the new stylesheet
+ */
+@property (readonly, nonatomic, strong) NSArray *removedRuleSets;
+
+/**
+ *  The rule sets of the new stylesheet that have no counterpart in the old stylesheet
+ */
+@property (readonly, nonatomic, strong) NSArray *addedRuleSets;
+
+/**
+ *  The number of rule sets present in both stylesheets
+ */
+@property (readonly, nonatomic) NSUInteger unchangedCount;
+
+/**
+ *  A flag indicating that the change cannot be limited to the styleables matched by the changed rule sets. This is
+ *  the case when there was no old stylesheet, when keyframes or namespaces changed, or when unchanged rule sets were
+ *  reordered, which may change the cascade of any styleable
+ */
+@property (readonly, nonatomic) BOOL requiresFullRestyle;
+
+/**
+ *  A flag indicating that both stylesheets define the same rules
+ */
+@property (readonly, nonatomic, getter=isEmpty) BOOL empty;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ *  Compare two stylesheets
+ *
+ *  @param oldStylesheet The stylesheet being replaced. This may be nil
+ *  @param newStylesheet The replacement stylesheet
+ */
+- (instancetype)initWithStylesheet:(STKPXStylesheet *)oldStylesheet
+                        stylesheet:(STKPXStylesheet *)newStylesheet NS_DESIGNATED_INITIALIZER;
+
+/**
+ *  Determine if any of the changed rule sets match the specified styleable
+ *
+ *  @param styleable The styleable to test
+ */
+- (BOOL)affectsStyleable:(id<STKPXStyleable>)styleable;
+
+/**
+ *  Return the styleables within a tree that need to be restyled. A styleable inside a table or collection view cell
+ *  is replaced by that cell, since cells are styled from the style cache as a whole
+ *
+ *  @param styleable The root of the tree to search
+ */
+- (NSArray *)styleablesToRestyleInStyleable:(id<STKPXStyleable>)styleable;
+
+/**
+ *  Restyle the affected styleables within a tree. The style cache has to be cleared first, since cached cells that are
+ *  not in the tree share their style trees with the cells that are
+ *
+ *  @param styleable The root of the tree to restyle
+ */
+- (void)restyleAffectedStyleablesInStyleable:(id<STKPXStyleable>)styleable;
+
+@end
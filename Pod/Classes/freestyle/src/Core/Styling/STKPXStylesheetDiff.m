@@ -0,0 +1,249 @@
+/****************************************************************************
+ *
+ * Copyright 2015-present StylingKit Development Team. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ****************************************************************************/
+
+//
+//  STKPXStylesheetDiff.m
+//  StylingKit
+//
+
+#import "STKPXStylesheetDiff.h"
+#import "STKPXStylesheet-Private.h"
+#import "STKPXMediaGroup.h"
+#import "STKPXRuleSet.h"
+#import "STKPXDeclaration.h"
+#import "STKPXKeyframe.h"
+#import "STKPXStyleUtils.h"
+#import "PixateFreestyle.h"
+
+@implementation STKPXStylesheetDiff
+{
+    NSArray *changedRuleSets_;
+}
+
+#pragma mark - Initializers
+
+- (instancetype)initWithStylesheet:(STKPXStylesheet *)oldStylesheet stylesheet:(STKPXStylesheet *)newStylesheet
+{
+    if (self = [super init])
+    {
+        NSMutableArray *oldRuleSets = [NSMutableArray array];
+        NSMutableArray *oldSignatures = [NSMutableArray array];
+        NSMutableArray *newRuleSets = [NSMutableArray array];
+        NSMutableArray *newSignatures = [NSMutableArray array];
+
+        [STKPXStylesheetDiff collectRuleSetsOfStylesheet:oldStylesheet into:oldRuleSets signatures:oldSignatures];
+        [STKPXStylesheetDiff collectRuleSetsOfStylesheet:newStylesheet into:newRuleSets signatures:newSignatures];
+
+        // rule sets are matched up by signature, so a rule set that is repeated verbatim is treated as a multiset member
+        NSCountedSet *remaining = [[NSCountedSet alloc] initWithArray:newSignatures];
+        NSMutableArray *removed = [NSMutableArray array];
+        NSMutableArray *oldKept = [NSMutableArray array];
+
+        [oldSignatures enumerateObjectsUsingBlock:^(NSString *signature, NSUInteger idx, BOOL *stop) {
+            if ([remaining countForObject:signature] > 0)
+            {
+                [remaining removeObject:signature];
+                [oldKept addObject:signature];
+            }
+            else
+            {
+                [removed addObject:oldRuleSets[idx]];
+            }
+        }];
+
+        NSCountedSet *kept = [[NSCountedSet alloc] initWithArray:oldKept];
+        NSMutableArray *added = [NSMutableArray array];
+        NSMutableArray *newKept = [NSMutableArray array];
+
+        [newSignatures enumerateObjectsUsingBlock:^(NSString *signature, NSUInteger idx, BOOL *stop) {
+            if ([kept countForObject:signature] > 0)
+            {
+                [kept removeObject:signature];
+                [newKept addObject:signature];
+            }
+            else
+            {
+                [added addObject:newRuleSets[idx]];
+            }
+        }];
+
+        _removedRuleSets = removed;
+        _addedRuleSets = added;
+        _unchangedCount = oldKept.count;
+
+        // source order breaks specificity ties, so moving unchanged rule sets around can change any cascade
+        _requiresFullRestyle = (oldStylesheet == nil)
+            || ![oldKept isEqualToArray:newKept]
+            || ![STKPXStylesheetDiff dictionary:oldStylesheet.namespacePrefixMap isEqualToDictionary:newStylesheet.namespacePrefixMap]
+            || ![STKPXStylesheetDiff keyframesOfStylesheet:oldStylesheet matchKeyframesOfStylesheet:newStylesheet];
+
+        changedRuleSets_ = [removed arrayByAddingObjectsFromArray:added];
+    }
+
+    return self;
+}
+
+#pragma mark - Getters
+
+- (BOOL)isEmpty
+{
+    return !_requiresFullRestyle && changedRuleSets_.count == 0;
+}
+
+#pragma mark - Methods
+
+- (BOOL)affectsStyleable:(id<STKPXStyleable>)styleable
+{
+    if (_requiresFullRestyle)
+    {
+        return YES;
+    }
+
+    for (STKPXRuleSet *ruleSet in changedRuleSets_)
+    {
+        if ([ruleSet matches:styleable])
+        {
+            return YES;
+        }
+    }
+
+    return NO;
+}
+
+- (NSArray *)styleablesToRestyleInStyleable:(id<STKPXStyleable>)styleable
+{
+    NSMutableOrderedSet *result = [NSMutableOrderedSet orderedSet];
+
+    if (styleable != nil && !self.isEmpty)
+    {
+        BOOL cacheStyles = PixateFreestyle.configuration.cacheStyles;
+
+        [STKPXStyleUtils enumerateStyleableAndDescendants:styleable
+                                            usingBlock:^(id<STKPXStyleable> obj, BOOL *stop, BOOL *stopDescending)
+        {
+            if ([self affectsStyleable:obj])
+            {
+                id<STKPXStyleable> target = (cacheStyles) ? [STKPXStylesheetDiff cachedCellOfStyleable:obj] : nil;
+
+                [result addObject:(target != nil) ? target : obj];
+
+                // a cached cell is styled as a whole, so there is nothing left to find below it
+                *stopDescending = (target == obj);
+            }
+        }];
+    }
+
+    return result.array;
+}
+
+- (void)restyleAffectedStyleablesInStyleable:(id<STKPXStyleable>)styleable
+{
+    for (id<STKPXStyleable> target in [self styleablesToRestyleInStyleable:styleable])
+    {
+        [STKPXStyleUtils updateStyleForStyleable:target];
+    }
+}
+
+#pragma mark - Helpers
+
++ (void)collectRuleSetsOfStylesheet:(STKPXStylesheet *)stylesheet
+                               into:(NSMutableArray *)ruleSets
+                         signatures:(NSMutableArray *)signatures
+{
+    // all media groups are compared, not only the ones matching right now, since the device may rotate later
+    for (STKPXMediaGroup *group in stylesheet.mediaGroups)
+    {
+        NSString *query = (group.query) ? group.query.description : @"";
+
+        for (STKPXRuleSet *ruleSet in group.ruleSets)
+        {
+            [ruleSets addObject:ruleSet];
+            [signatures addObject:[self signatureForRuleSet:ruleSet query:query]];
+        }
+    }
+}
+
++ (NSString *)signatureForRuleSet:(STKPXRuleSet *)ruleSet query:(NSString *)query
+{
+    NSMutableString *signature = [NSMutableString stringWithString:query];
+
+    [signature appendString:@"\n"];
+
+    for (id selector in ruleSet.selectors)
+    {
+        [signature appendFormat:@"%@ ", selector];
+    }
+
+    [signature appendString:@"{"];
+
+    for (STKPXDeclaration *declaration in ruleSet.declarations)
+    {
+        [signature appendFormat:@"%@:%@%@;", declaration.name, declaration.source, (declaration.important) ? @"!" : @""];
+    }
+
+    [signature appendString:@"}"];
+
+    return signature;
+}
+
++ (BOOL)dictionary:(NSDictionary *)a isEqualToDictionary:(NSDictionary *)b
+{
+    return (a.count == 0 && b.count == 0) || [a isEqualToDictionary:b];
+}
+
++ (BOOL)keyframesOfStylesheet:(STKPXStylesheet *)a matchKeyframesOfStylesheet:(STKPXStylesheet *)b
+{
+    NSDictionary *aKeyframes = a.keyframesByName;
+    NSDictionary *bKeyframes = b.keyframesByName;
+
+    if (aKeyframes.count != bKeyframes.count)
+    {
+        return NO;
+    }
+
+    for (NSString *name in aKeyframes)
+    {
+        STKPXKeyframe *bKeyframe = bKeyframes[name];
+
+        if (bKeyframe == nil || ![[aKeyframes[name] description] isEqualToString:bKeyframe.description])
+        {
+            return NO;
+        }
+    }
+
+    return YES;
+}
+
++ (id<STKPXStyleable>)cachedCellOfStyleable:(id<STKPXStyleable>)styleable
+{
+    id current = styleable;
+
+    while (current != nil)
+    {
+        if ([current isKindOfClass:[UITableViewCell class]] || [current isKindOfClass:[UICollectionViewCell class]])
+        {
+            return current;
+        }
+
+        current = ([current respondsToSelector:@selector(pxStyleParent)]) ? [current pxStyleParent] : nil;
+    }
+
+    return nil;
+}
+
+@end
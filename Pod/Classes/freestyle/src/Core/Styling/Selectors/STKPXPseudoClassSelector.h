@@ -25,6 +25,12 @@
 #import <Foundation/Foundation.h>
 #import "STKPXSelector.h"
 
+/**
+ *  The state bit shared by all pseudo-class names seen after every other bit was handed out. A mask containing it has
+ *  to be confirmed by comparing names
+ */
+extern const uint64_t STKPXPseudoClassStateOverflow;
+
 /**
  *  A STKPXPseudoClassExpression is used to represent a specific state of an element, for purposes of styling.
  */
@@ -35,6 +41,19 @@
  */
 @property (readonly, nonatomic, strong) NSString *className;
 
+/**
+ *  The state bit of this pseudo-class name, see stateBitForClassName:
+ */
+@property (readonly, nonatomic) uint64_t stateBit;
+
+/**
+ *  Return a process-wide bit identifying the specified pseudo-class name, assigning one the first time a name is seen.
+ *  Masks of these bits let rule sets be sorted into states without comparing strings
+ *
+ *  @param name The pseudo-class name
+ */
++ (uint64_t)stateBitForClassName:(NSString *)name;
+
 /**
  *  Initializer a new instance with the specified pseudo-class name
  *
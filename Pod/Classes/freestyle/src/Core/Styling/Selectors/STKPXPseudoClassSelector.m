@@ -28,6 +28,10 @@
 #import "STKPXStyleable.h"
 #import "STKPXStyleUtils.h"
 
+const uint64_t STKPXPseudoClassStateOverflow = 1ULL << 63;
+
+static NSMutableDictionary *STATE_BITS;
+
 @implementation STKPXPseudoClassSelector
 {
     NSString *className;
@@ -37,6 +41,37 @@
 
 STK_DEFINE_CLASS_LOG_LEVEL
 
+#pragma mark - Static methods
+
++ (uint64_t)stateBitForClassName:(NSString *)name
+{
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        STATE_BITS = [[NSMutableDictionary alloc] init];
+    });
+
+    if (name == nil)
+    {
+        return STKPXPseudoClassStateOverflow;
+    }
+
+    // stylesheets may be parsed off the main thread
+    @synchronized(STATE_BITS)
+    {
+        NSNumber *bit = STATE_BITS[name];
+
+        if (bit == nil)
+        {
+            NSUInteger index = STATE_BITS.count;
+
+            bit = @((index < 63) ? (1ULL << index) : STKPXPseudoClassStateOverflow);
+            STATE_BITS[name] = bit;
+        }
+
+        return bit.unsignedLongLongValue;
+    }
+}
+
 #pragma mark - Initializers
 
 - (instancetype)initWithClassName:(NSString *)name
@@ -44,6 +79,7 @@ STK_DEFINE_CLASS_LOG_LEVEL
     if (self = [super init])
     {
         self->className = name;
+        self->_stateBit = [STKPXPseudoClassSelector stateBitForClassName:name];
     }
 
     return self;
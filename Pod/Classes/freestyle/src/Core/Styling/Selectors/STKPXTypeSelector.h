@@ -63,6 +63,11 @@
  */
 @property (readonly, nonatomic) BOOL hasPseudoClasses;
 
+/**
+ *  The state bits of all pseudo-classes in this selector, or zero if it has none
+ */
+@property (readonly, nonatomic) uint64_t pseudoClassStateMask;
+
 /**
  *  The pseudo-element associated with this selector. This value may be nil
  */
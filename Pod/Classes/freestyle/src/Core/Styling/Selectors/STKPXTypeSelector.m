@@ -92,6 +92,21 @@ STK_DEFINE_CLASS_LOG_LEVEL
     return result;
 }
 
+- (uint64_t)pseudoClassStateMask
+{
+    uint64_t result = 0;
+
+    for (id selector in attributeExpressions)
+    {
+        if ([selector isKindOfClass:[STKPXPseudoClassSelector class]])
+        {
+            result |= ((STKPXPseudoClassSelector *)selector).stateBit;
+        }
+    }
+
+    return result;
+}
+
 - (NSString *)styleId
 {
     NSString *result = nil;
@@ -641,12 +641,12 @@
     return @[@(width), @(spacing)];
 }
 
-- (void)renderChildren:(CGContextRef)context
+- (void)renderChildrenWithBackend:(id<STKPXRenderBackend>)backend
 {
-    [borderPathTop_ render:context];
-    [borderPathRight_ render:context];
-    [borderPathBottom_ render:context];
-    [borderPathLeft_ render:context];
+    [borderPathTop_ renderWithBackend:backend];
+    [borderPathRight_ renderWithBackend:backend];
+    [borderPathBottom_ renderWithBackend:backend];
+    [borderPathLeft_ renderWithBackend:backend];
 }
 
 @end
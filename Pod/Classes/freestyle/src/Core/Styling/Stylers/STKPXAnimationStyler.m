@@ -26,7 +26,8 @@
 #import "STKPXAnimationStyler.h"
 #import "STKPXAnimationInfo.h"
 #import "STKPXAnimationPropertyHandler.h"
-#import "STKPXKeyframeAnimation.h"
+#import "STKPXKeyframeTemplate.h"
+#import "STKPXAnimationSpec.h"
 
 @implementation STKPXAnimationStyler
 
@@ -199,14 +200,13 @@
     else
     {
         NSArray *animationInfos = context.animationInfos;
-        NSArray *keyframes = [self keyframeAnimationsFromInfos:animationInfos styleable:context.styleable];
+        NSArray *specs = [self animationSpecsFromInfos:animationInfos styleable:context.styleable];
 
         // TODO: Can this be something else than UIView?
         UIView *view = (UIView *)context.styleable;
 
-        [keyframes enumerateObjectsUsingBlock:^(CAKeyframeAnimation *keyframe, NSUInteger idx, BOOL *stop) {
-            [view.layer addAnimation:keyframe forKey:nil];
-        }];
+        // animations that are already running as specified are left alone, so a restyle doesn't restart them
+        [STKPXAnimationSpec applySpecs:specs toLayer:view.layer];
 
 
         /*
@@ -242,66 +242,38 @@
     return KEY_PATH_FROM_PROPERTY;
 }
 
-- (NSArray *)keyframeAnimationsFromInfos:(NSArray *)infos styleable:(id<STKPXStyleable>)styleable
+- (NSArray *)animationSpecsFromInfos:(NSArray *)infos styleable:(id<STKPXStyleable>)styleable
 {
     NSMutableArray *result = [[NSMutableArray alloc] init];
-    NSMutableDictionary *propertyHandlers = [[NSMutableDictionary alloc] initWithDictionary:[self defaultAnimationPropertyHandlers]];
+    NSDictionary *propertyHandlers = [self defaultAnimationPropertyHandlers];
 
     // Add any additional user-provided property handlers
     if ([styleable respondsToSelector:@selector(animationPropertyHandlers)])
     {
-        [propertyHandlers addEntriesFromDictionary:styleable.animationPropertyHandlers];
+        NSDictionary *additionalHandlers = styleable.animationPropertyHandlers;
+
+        if (additionalHandlers.count > 0)
+        {
+            NSMutableDictionary *handlers = [[NSMutableDictionary alloc] initWithDictionary:propertyHandlers];
+
+            [handlers addEntriesFromDictionary:additionalHandlers];
+            propertyHandlers = handlers;
+        }
     }
-    
-    NSMutableDictionary *keyframes = [[NSMutableDictionary alloc] init];
 
-    [infos enumerateObjectsUsingBlock:^(STKPXAnimationInfo *info, NSUInteger idx, BOOL *stop) {
+    for (STKPXAnimationInfo *info in infos)
+    {
         if (info.isValid)
         {
-            STKPXKeyframe *keyframe = info.keyframe;
+            STKPXKeyframeTemplate *template = [STKPXKeyframeTemplate templateForKeyframe:info.keyframe
+                                                                        propertyHandlers:propertyHandlers];
 
-            if (keyframe)
+            for (STKPXKeyframeTrack *track in template.tracks)
             {
-                [keyframe.blocks enumerateObjectsUsingBlock:^(STKPXKeyframeBlock *block, NSUInteger idx, BOOL *stop) {
-                    [block.declarations enumerateObjectsUsingBlock:^(STKPXDeclaration *declaration, NSUInteger idx, BOOL *stop) {
-                        STKPXAnimationPropertyHandler *propertyHandler = propertyHandlers[declaration.name];
-
-                        if (propertyHandler != nil)
-                        {
-                            NSString *keyPath = propertyHandler.keyPath;
-                            STKPXKeyframeAnimation *animation = keyframes[keyPath];
-
-                            if (animation == nil)
-                            {
-                                animation = [[STKPXKeyframeAnimation alloc] init];
-                                animation.keyPath = keyPath;
-                                animation.duration = info.animationDuration;
-                                animation.fillMode = info.animationFillMode;
-                                animation.repeatCount = info.animationIterationCount;
-                                animation.beginTime = info.animationDelay;
-
-                                keyframes[keyPath] = animation;
-                            }
-
-                            // TODO: need to grab value type as is appropriate for the property being animated (via blocks?)
-                            [animation addValue:[propertyHandler getValueFromDeclaration:declaration]];
-                            [animation addKeyTime:block.offset];
-                            [animation addTimingFunction:info.animationTimingFunction];
-                        }
-                    }];
-                }];
+                [result addObject:[[STKPXAnimationSpec alloc] initWithTrack:track info:info]];
             }
         }
-    }];
-
-    [keyframes enumerateKeysAndObjectsUsingBlock:^(NSString *key, STKPXKeyframeAnimation *animation, BOOL *stop) {
-        CAKeyframeAnimation *keyframe = animation.caKeyframeAnimation;
-
-        if (keyframe != nil)
-        {
-            [result addObject:keyframe];
-        }
-    }];
+    }
 
     return result;
 }
@@ -0,0 +1,95 @@
+/****************************************************************************
+ *
+ * Copyright 2015-present StylingKit Development Team. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ****************************************************************************/
+//
+//  STKPXBackgroundImageDescription.h
+//  StylingKit
+//
+
+#import <UIKit/UIKit.h>
+#import "STKPXShape.h"
+#import "STKPXPaint.h"
+#import "STKPXShadowGroup.h"
+
+@class STKPXBoxModel;
+@class STKPXOffsets;
+
+/**
+ *  An immutable snapshot of everything needed to draw a styler context's background image. Background images rendered
+ *  off the main thread are drawn from a description, so the context can keep changing (or be reused) while they render.
+ */
+@interface STKPXBackgroundImageDescription : NSObject
+
+/**
+ *  A private copy of the context's shape, with its bounds, fill, border stroke, corner radii and inner shadows applied
+ */
+@property (nonatomic, readonly) STKPXShape *shape;
+
+/**
+ *  Determine if the shape could not be copied and is the context's own. Such a description may only be rendered on the
+ *  thread that created it
+ */
+@property (nonatomic, readonly) BOOL sharesShape;
+
+/**
+ *  The bounds of the image
+ */
+@property (nonatomic, readonly) CGRect bounds;
+
+/**
+ *  The padding around the shape within the bounds
+ */
+@property (nonatomic, readonly) UIEdgeInsets padding;
+
+/**
+ *  The cap insets of the resulting image
+ */
+@property (nonatomic, readonly) UIEdgeInsets insets;
+
+/**
+ *  Determine if the image has no transparent pixels
+ */
+@property (nonatomic, readonly, getter=isOpaque) BOOL opaque;
+
+/**
+ *  Capture a background image. The box model, padding and inner shadows are read now rather than kept, and the shape
+ *  is copied when it implements NSCopying
+ *
+ *  @param shape The shape to draw, or nil for a rectangle
+ *  @param bounds The bounds of the image
+ *  @param fill The combined fill of the background
+ *  @param boxModel The box model providing the border and corner radii, or nil
+ *  @param innerShadows The inner shadows to draw, or nil
+ *  @param padding The padding around the shape, or nil
+ *  @param insets The cap insets of the resulting image
+ *  @param opaque Whether the image has no transparent pixels
+ */
+- (instancetype)initWithShape:(STKPXShape *)shape
+                       bounds:(CGRect)bounds
+                         fill:(id<STKPXPaint>)fill
+                     boxModel:(STKPXBoxModel *)boxModel
+                 innerShadows:(STKPXShadowGroup *)innerShadows
+                      padding:(STKPXOffsets *)padding
+                       insets:(UIEdgeInsets)insets
+                       opaque:(BOOL)opaque;
+
+/**
+ *  Render the background image this instance describes. Unless the shape is shared, this may be called from any thread
+ */
+- (UIImage *)renderImage;
+
+@end
@@ -0,0 +1,169 @@
+/****************************************************************************
+ *
+ * Copyright 2015-present StylingKit Development Team. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ****************************************************************************/
+//
+//  STKPXBackgroundImageDescription.m
+//  StylingKit
+//
+
+#import "STKPXBackgroundImageDescription.h"
+#import "STKPXRectangle.h"
+#import "STKPXStroke.h"
+#import "STKPXBoxModel.h"
+#import "STKPXOffsets.h"
+
+@implementation STKPXBackgroundImageDescription
+
+#pragma mark - Initializers
+
+- (instancetype)initWithShape:(STKPXShape *)shape
+                       bounds:(CGRect)bounds
+                         fill:(id<STKPXPaint>)fill
+                     boxModel:(STKPXBoxModel *)boxModel
+                 innerShadows:(STKPXShadowGroup *)innerShadows
+                      padding:(STKPXOffsets *)padding
+                       insets:(UIEdgeInsets)insets
+                       opaque:(BOOL)opaque
+{
+    if (self = [super init])
+    {
+        if (shape == nil)
+        {
+            _shape = [[STKPXRectangle alloc] init];
+        }
+        else if ([shape conformsToProtocol:@protocol(NSCopying)])
+        {
+            _shape = [(id<NSCopying>) shape copyWithZone:nil];
+        }
+        else
+        {
+            _shape = shape;
+            _sharesShape = YES;
+        }
+
+        _bounds = bounds;
+        _padding = (padding.hasOffset)
+            ? UIEdgeInsetsMake(padding.top, padding.left, padding.bottom, padding.right)
+            : UIEdgeInsetsZero;
+        _insets = insets;
+        _opaque = opaque;
+
+        [self configureShapeWithFill:fill boxModel:boxModel innerShadows:innerShadows];
+    }
+
+    return self;
+}
+
+#pragma mark - Methods
+
+- (UIImage *)renderImage
+{
+    UIImage *result = [_shape renderToImageWithBounds:_bounds withOpacity:_opaque];
+
+    if (!UIEdgeInsetsEqualToEdgeInsets(_padding, UIEdgeInsetsZero))
+    {
+        CGFloat x = _bounds.origin.x + _padding.left;
+        CGFloat y = _bounds.origin.y + _padding.top;
+        CGFloat width = _bounds.size.width - _padding.left - _padding.right;
+        CGFloat height = _bounds.size.height - _padding.top - _padding.bottom;
+
+        UIGraphicsBeginImageContextWithOptions(_bounds.size, _opaque, 0.0);
+        [result drawInRect:CGRectMake(x, y, width, height)];
+        result = UIGraphicsGetImageFromCurrentImageContext();
+        UIGraphicsEndImageContext();
+    }
+
+    // apply insets, if we have any
+    if (!UIEdgeInsetsEqualToEdgeInsets(_insets, UIEdgeInsetsZero))
+    {
+        result = [result resizableImageWithCapInsets:_insets];
+    }
+
+    return result;
+}
+
+#pragma mark - Private Methods
+
+- (void)configureShapeWithFill:(id<STKPXPaint>)fill
+                      boxModel:(STKPXBoxModel *)boxModel
+                  innerShadows:(STKPXShadowGroup *)innerShadows
+{
+    STKPXShape *shape = _shape;
+
+    // apply bounds
+    // NOTE: this updates the bounds of the underlying geometry used to draw the background image. This does not resize
+    // the styleable.
+    if ([shape conformsToProtocol:@protocol(STKPXBoundable)])
+    {
+        id<STKPXBoundable> boundable = (id<STKPXBoundable>)shape;
+
+        boundable.bounds = _bounds;
+    }
+
+    // apply fill
+    shape.fill = fill;
+
+    // apply stroke, and possible modify geometry bounds
+    if (boxModel.hasBorder)
+    {
+        // NOTE: we're using top border since we set all borders the same right now
+        CGFloat strokeWidth = boxModel.borderTopWidth;
+        id<STKPXPaint>strokeColor = boxModel.borderTopPaint;
+        STKPXStroke *stroke = [[STKPXStroke alloc] initWithStrokeWidth:strokeWidth];
+
+        if (strokeColor)
+        {
+            stroke.color = strokeColor;
+        }
+
+        shape.stroke = stroke;
+
+        // shrink bounds by half of the stroke width
+        if ([shape conformsToProtocol:@protocol(STKPXBoundable)])
+        {
+            id<STKPXBoundable> boundable = (id<STKPXBoundable>)shape;
+
+            boundable.bounds = CGRectInset(boundable.bounds, 0.5f * strokeWidth, 0.5f * strokeWidth);
+        }
+    }
+
+    // set corner radius
+    if ([shape isKindOfClass:[STKPXRectangle class]])
+    {
+        STKPXRectangle *rect = (STKPXRectangle *)shape;
+
+        rect.radiusTopLeft = boxModel.radiusTopLeft;
+        rect.radiusTopRight = boxModel.radiusTopRight;
+        rect.radiusBottomRight = boxModel.radiusBottomRight;
+        rect.radiusBottomLeft = boxModel.radiusBottomLeft;
+    }
+
+    // apply inner shadows. Shadow groups can still be added to, so the shape gets a group of its own
+    if (innerShadows.shadows.count > 0)
+    {
+        STKPXShadowGroup *shadows = [[STKPXShadowGroup alloc] init];
+
+        for (id<STKPXShadowPaint> shadow in innerShadows.shadows)
+        {
+            [shadows addShadowPaint:shadow];
+        }
+
+        shape.shadow = shadows;
+    }
+}
+
+@end
@@ -32,6 +32,7 @@
 #import "STKPXDimension.h"
 #import "STKPXAnimationInfo.h"
 #import "STKPXBoxModel.h"
+#import "STKPXBackgroundImageDescription.h"
 
 @protocol STKPXStyler;
 
@@ -110,6 +111,25 @@
  */
 @property (nonatomic, readonly) BOOL usesImage;
 
+/*
+ *  Return a context from the current thread's pool of reusable contexts, or a new context when the pool is empty. Hand
+ *  the context back with recycleContext: once styling is done
+ */
++ (STKPXStylerContext *)dequeueReusableContext;
+
+/*
+ *  Reset the specified context and return it to the current thread's pool. Asynchronous background renders work from a
+ *  snapshot, so a context may be recycled while its background is still rendering
+ *
+ *  @param context The context to recycle
+ */
++ (void)recycleContext:(STKPXStylerContext *)context;
+
+/*
+ *  Restore this context to the state of a newly created context, releasing everything it references
+ */
+- (void)reset;
+
 /*
  *  Return the property value for the specifified property name
  *
@@ -146,6 +166,40 @@
  */
 - (UIImage *)backgroundImageWithBounds:(CGRect) bounds;
 
+/*
+ * Return a snapshot of the background this context currently describes, which can be rendered later and on another
+ * thread
+ *
+ * @param bounds The bounds of the image
+ */
+- (STKPXBackgroundImageDescription *)backgroundImageDescriptionWithBounds:(CGRect)bounds;
+
+/*
+ * Return a cap-inset background image when the background only needs its corners and a single stretchable row and
+ * column (see PixateFreestyleConfiguration.resizableBackgroundImages). The image is shared by every view with the same
+ * box model and fill, whatever their size. Falls back to backgroundImage otherwise. Only use this where the consumer
+ * honors capInsets
+ */
+@property (nonatomic, readonly, strong) UIImage *resizableBackgroundImage;
+
+/*
+ *  Deliver the background image to the specified block. Cached and nine-slice images are delivered right away. When
+ *  PixateFreestyleConfiguration.asyncBackgroundImages is on, other images are rendered by STKPXRenderPipeline and
+ *  delivered on the main queue, unless this is the first background of the styleable's active state, which is rendered
+ *  synchronously. Results that were superseded by a newer request for the same styleable and state are dropped
+ *
+ *  @param block The block applying the image
+ */
+- (void)requestBackgroundImage:(void (^)(UIImage *image))block;
+
+/*
+ *  Apply the background image to the specified layer, setting contentsCenter so that cap-inset images stretch
+ *  correctly
+ *
+ *  @param layer The CALayer
+ */
+- (void)applyBackgroundImageToLayer:(CALayer *)layer;
+
 /**
  * Transform a string to uppercase, lowercase, or capitalize based on the css selector value.
  * @param value String value to transform
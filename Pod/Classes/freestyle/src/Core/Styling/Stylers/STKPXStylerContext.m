@@ -32,53 +32,174 @@
 #import "STKPXStroke.h"
 #import "STKPXShapeView.h"
 #import "STKPXSolidPaint.h"
+#import "STKPXLinearGradient.h"
 #import "STKPXFontRegistry.h"
 #import "STKPXImagePaint.h"
 #import "STKPXPaintGroup.h"
 #import "PixateFreestyle.h"
 #import "STKPXCacheManager.h"
+#import "STKPXRenderPipeline.h"
+#import "STKPXDiskImageCache.h"
 #import "STKPXDeclaration.h"
 #import <CoreText/CoreText.h>
+#import <objc/runtime.h>
 
 static NSString *DEFAULT_FONT_NAME = @"DEFAULT";
 static NSString *DEFAULT_FONT = @"Helvetica";
 
+// state name to the image cache key of the last background requested for that state, per styleable
+static const char BACKGROUND_REQUESTS;
+
+// the key of the per-thread pool of reusable contexts in the thread dictionary
+static NSString *const CONTEXT_POOL_KEY = @"STKPXStylerContextPool";
+static const NSUInteger kMaxPooledContexts = 8;
+
+/**
+ *  The property names stylers are known to use, each of which gets a fixed slot. Other names fall back to a dictionary
+ */
+typedef NS_ENUM(NSUInteger, STKPXStylerContextSlot) {
+    STKPXStylerContextSlot_Color,
+    STKPXStylerContextSlot_Paint,
+    STKPXStylerContextSlot_RenderingMode,
+    STKPXStylerContextSlot_TextAttributes,
+    STKPXStylerContextSlot_TextValue,
+    STKPXStylerContextSlot_Transform,
+    STKPXStylerContextSlot_TintColor,
+    STKPXStylerContextSlot_BackgroundPosition,
+    STKPXStylerContextSlot_Frame,
+    STKPXStylerContextSlotCount
+};
+
+static NSUInteger STKHashFromCGSize(CGSize size)
+{
+    return @(size.width).hash * 31 + @(size.height).hash;
+}
+
+static BOOL STKPaintsAreEqual(id<STKPXPaint> a, id<STKPXPaint> b)
+{
+    return a == b || [(NSObject *) a isEqual:b];
+}
+
+static void STKCollectAssetURLs(id<STKPXPaint> paint, NSMutableArray *URLs)
+{
+    if ([paint isKindOfClass:[STKPXImagePaint class]])
+    {
+        NSURL *URL = ((STKPXImagePaint *)paint).imageURL;
+
+        if (URL)
+        {
+            [URLs addObject:URL];
+        }
+    }
+    else if ([paint isKindOfClass:[STKPXPaintGroup class]])
+    {
+        for (id<STKPXPaint> child in ((STKPXPaintGroup *)paint).paints)
+        {
+            STKCollectAssetURLs(child, URLs);
+        }
+    }
+}
+
+static STKPXDiskImageCache *STKConfiguredDiskImageCache(void)
+{
+    PixateFreestyleConfiguration *configuration = PixateFreestyle.configuration;
+
+    // disk entries are keyed by the declaration hash, which is only computed when redundant styling is prevented
+    if (!configuration.diskImageCache || !configuration.preventRedundantStyling)
+    {
+        return nil;
+    }
+
+    STKPXDiskImageCache *cache = [STKPXDiskImageCache sharedInstance];
+
+    cache.themeVersion = configuration.diskImageCacheVersion;
+    cache.byteLimit = configuration.diskImageCacheSize;
+
+    return cache;
+}
+
 @implementation STKPXStylerContext
 {
+    id slots_[STKPXStylerContextSlotCount];
     NSMutableDictionary *properties_;
 }
 
+static NSDictionary *SLOTS_BY_NAME;
+static STKPXDimension *DEFAULT_LETTER_SPACING;
+
+#pragma mark - Static initializers
+
++ (void)initialize
+{
+    if (self == [STKPXStylerContext class])
+    {
+        SLOTS_BY_NAME = @{
+            @"color" : @(STKPXStylerContextSlot_Color),
+            @"paint" : @(STKPXStylerContextSlot_Paint),
+            @"rendering-mode" : @(STKPXStylerContextSlot_RenderingMode),
+            @"text-attributes" : @(STKPXStylerContextSlot_TextAttributes),
+            @"text-value" : @(STKPXStylerContextSlot_TextValue),
+            @"transform" : @(STKPXStylerContextSlot_Transform),
+            @"-ios-tint-color" : @(STKPXStylerContextSlot_TintColor),
+            @"background-position" : @(STKPXStylerContextSlot_BackgroundPosition),
+            @"frame" : @(STKPXStylerContextSlot_Frame),
+        };
+
+        // dimensions are immutable, so every context can start out with the same one
+        DEFAULT_LETTER_SPACING = [[STKPXDimension alloc] initWithNumber:0 withDimension:@"STKPX"];
+    }
+}
+
+#pragma mark - Static Methods
+
++ (STKPXStylerContext *)dequeueReusableContext
+{
+    NSMutableArray *pool = [NSThread currentThread].threadDictionary[CONTEXT_POOL_KEY];
+    STKPXStylerContext *context = pool.lastObject;
+
+    if (context)
+    {
+        [pool removeLastObject];
+    }
+    else
+    {
+        context = [[STKPXStylerContext alloc] init];
+    }
+
+    return context;
+}
+
++ (void)recycleContext:(STKPXStylerContext *)context
+{
+    if (context == nil)
+    {
+        return;
+    }
+
+    [context reset];
+
+    NSMutableDictionary *threadDictionary = [NSThread currentThread].threadDictionary;
+    NSMutableArray *pool = threadDictionary[CONTEXT_POOL_KEY];
+
+    if (pool == nil)
+    {
+        pool = [[NSMutableArray alloc] initWithCapacity:kMaxPooledContexts];
+        threadDictionary[CONTEXT_POOL_KEY] = pool;
+    }
+
+    if (pool.count < kMaxPooledContexts)
+    {
+        [pool addObject:context];
+    }
+}
+
 #pragma mark - Initializers
 
 - (instancetype)init
 {
     if (self = [super init])
     {
-        _shape = [[STKPXRectangle alloc] init];
-
-        _top = MAXFLOAT;
-        _left = MAXFLOAT;
-        _width = 0.0f;
-        _height = 0.0f;
-
-        _boxModel = [[STKPXBoxModel alloc] init];
-        /*
-        _borderRadius = nil;
-        _strokeWidth = 0.0f;
-        _strokeColor = nil;
-         */
-
-        _imageSize = CGSizeZero;
-        _transform = CGAffineTransformIdentity;
-        _opacity = 1.0f;
-
-        _fontName = DEFAULT_FONT_NAME;
-        _fontStyle = @"normal";
-        _fontWeight = @"normal";
-        _fontStretch = @"normal";
-        _fontSize = 16.0f;
-        
-        _letterSpacing = [[STKPXDimension alloc] initWithNumber:0 withDimension:@"STKPX"];
+        [self reset];
     }
 
     return self;
@@ -86,21 +207,94 @@ static NSString *DEFAULT_FONT = @"Helvetica";
 
 #pragma mark - Methods
 
+- (void)reset
+{
+    _styleable = nil;
+    _activeStateName = nil;
+    _styleHash = 0;
+
+    // the shape and box model are created on first use. A missing box model reads like an empty one
+    _shape = nil;
+
+    _top = MAXFLOAT;
+    _left = MAXFLOAT;
+    _width = 0.0f;
+    _height = 0.0f;
+    _bounds = CGRectZero;
+
+    _padding = nil;
+    _transform = CGAffineTransformIdentity;
+
+    _boxModel = nil;
+
+    _fill = nil;
+    _imageFill = nil;
+
+    _shadow = nil;
+    _textShadow = nil;
+    _innerShadow = nil;
+    _outerShadow = nil;
+    _opacity = 1.0f;
+
+    _imageSize = CGSizeZero;
+    _insets = UIEdgeInsetsZero;
+
+    _barMetricsVerticalOffset = nil;
+
+    _fontName = DEFAULT_FONT_NAME;
+    _fontStyle = @"normal";
+    _fontWeight = @"normal";
+    _fontStretch = @"normal";
+    _fontSize = 16.0f;
+    _text = nil;
+    _transformedText = nil;
+    _letterSpacing = DEFAULT_LETTER_SPACING;
+    _textTransform = nil;
+    _textDecoration = nil;
+
+    _shadowBounds = CGRectZero;
+    _shadowUrl = nil;
+    _shadowImage = nil;
+    _shadowInsets = UIEdgeInsetsZero;
+    _shadowPadding = 0.0f;
+
+    _animationInfos = nil;
+    _transitionInfos = nil;
+
+    for (NSUInteger i = 0; i < STKPXStylerContextSlotCount; i++)
+    {
+        slots_[i] = nil;
+    }
+
+    properties_ = nil;
+}
+
 - (id)propertyValueForName:(NSString *)name
 {
-    return properties_[name];
+    NSNumber *slot = (name) ? SLOTS_BY_NAME[name] : nil;
+
+    return (slot) ? slots_[slot.unsignedIntegerValue] : properties_[name];
 }
 
 - (void)setPropertyValue:(id)value forName:(NSString *)name
 {
     if (value && name)
     {
-        if (properties_ == nil)
+        NSNumber *slot = SLOTS_BY_NAME[name];
+
+        if (slot)
         {
-            properties_ = [[NSMutableDictionary alloc] init];
+            slots_[slot.unsignedIntegerValue] = value;
         }
+        else
+        {
+            if (properties_ == nil)
+            {
+                properties_ = [[NSMutableDictionary alloc] init];
+            }
 
-        properties_[name] = value;
+            properties_[name] = value;
+        }
     }
 }
 
@@ -111,6 +305,26 @@ static NSString *DEFAULT_FONT = @"Helvetica";
 
 #pragma mark - Getters
 
+- (STKPXShape *)shape
+{
+    if (_shape == nil)
+    {
+        _shape = [[STKPXRectangle alloc] init];
+    }
+
+    return _shape;
+}
+
+- (STKPXBoxModel *)boxModel
+{
+    if (_boxModel == nil)
+    {
+        _boxModel = [[STKPXBoxModel alloc] init];
+    }
+
+    return _boxModel;
+}
+
 //- (NSString *)fontName
 //{
 //    return [DEFAULT_FONT_NAME isEqualToString:_fontName] ? DEFAULT_FONT: _fontName;
@@ -146,103 +360,303 @@ static NSString *DEFAULT_FONT = @"Helvetica";
 
     if (result == nil)
     {
-        // update bounds
-        if (CGSizeEqualToSize(_imageSize, CGSizeZero) == NO)
+        [self resolveBackgroundBounds];
+
+        STKPXDiskImageCache *diskCache = STKConfiguredDiskImageCache();
+        uint64_t digest = [self diskImageDigestWithBounds:_bounds];
+
+        result = [diskCache imageForDigest:digest];
+
+        if (result == nil)
         {
-            _bounds = CGRectMake(0.0f, 0.0f, _imageSize.width, _imageSize.height);
+            result = [self renderBackgroundImageWithBounds:_bounds];
+
+            [diskCache setImage:result forDigest:digest];
         }
-        else if (CGRectEqualToRect(_bounds, CGRectZero))
+
+        if (PixateFreestyle.configuration.cacheImages)
         {
-            _bounds = self.styleable.bounds;
+            // estimate cost as number of pixels times 4 bytes per pixel. This is probably lower than actual
+            NSUInteger cost = result.size.width * result.size.height * 4;
 
-            if (CGSizeEqualToSize(_bounds.size, CGSizeZero) == YES)
-            {
-                // Set default size to 32,32 if its zero
-                _bounds = CGRectMake(0.0f, 0.0f, 32.0f, 32.0f);
-            }
+            [STKPXCacheManager setImage:result forKey:hashKey cost:cost];
         }
+    }
+
+    return result;
+}
+
+- (UIImage *)resizableBackgroundImage
+{
+    UIImage *result = [self nineSliceBackgroundImage];
 
-        // apply bounds
-        // NOTE: this updates the bounds of the underlying geometry used to draw the background image. This does not resize
-        // the styleable.
-        if ([_shape conformsToProtocol:@protocol(STKPXBoundable)])
+    return (result) ? result : self.backgroundImage;
+}
+
+- (void)requestBackgroundImage:(void (^)(UIImage *image))block
+{
+    UIImage *result = [self nineSliceBackgroundImage];
+    NSNumber *hashKey = @(self.styleHash);
+
+    if (result == nil)
+    {
+        result = [STKPXCacheManager imageForKey:hashKey];
+    }
+
+    STKPXDiskImageCache *diskCache = STKConfiguredDiskImageCache();
+
+    // a mapped disk image is cheap enough to hand out synchronously
+    if (result == nil && diskCache)
+    {
+        [self resolveBackgroundBounds];
+
+        result = [diskCache imageForDigest:[self diskImageDigestWithBounds:_bounds]];
+
+        if (result && PixateFreestyle.configuration.cacheImages)
         {
-            id<STKPXBoundable> boundable = (id<STKPXBoundable>)_shape;
+            NSUInteger cost = result.size.width * result.size.height * 4;
 
-            boundable.bounds = _bounds;
+            [STKPXCacheManager setImage:result forKey:hashKey cost:cost];
         }
+    }
 
-        // apply fill
-        _shape.fill = [self getCombinedPaints];
+    id styleable = self.styleable;
+    NSString *stateKey = (self.activeStateName) ? self.activeStateName : @"";
+    NSMutableDictionary *requests = (styleable) ? objc_getAssociatedObject(styleable, &BACKGROUND_REQUESTS) : nil;
 
-        // apply stroke, and possible modify geometry bounds
-        if (_boxModel.hasBorder)
+    // render synchronously when there's nothing to wait for, or nothing on screen to show in the meantime
+    if (result != nil || !PixateFreestyle.configuration.asyncBackgroundImages || requests[stateKey] == nil)
+    {
+        if (styleable && requests == nil)
         {
-            // NOTE: we're using top border since we set all borders the same right now
-            CGFloat strokeWidth = _boxModel.borderTopWidth;
-            id<STKPXPaint>strokeColor = _boxModel.borderTopPaint;
-            STKPXStroke *stroke = [[STKPXStroke alloc] initWithStrokeWidth:strokeWidth];
+            requests = [[NSMutableDictionary alloc] init];
+            objc_setAssociatedObject(styleable, &BACKGROUND_REQUESTS, requests, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+        }
 
-            if (strokeColor)
-            {
-                stroke.color = strokeColor;
-            }
+        requests[stateKey] = hashKey;
+        block((result) ? result : self.backgroundImage);
 
-            self.shape.stroke = stroke;
+        return;
+    }
 
-            // shrink bounds by half of the stroke width
-            if ([_shape conformsToProtocol:@protocol(STKPXBoundable)])
-            {
-                id<STKPXBoundable> boundable = (id<STKPXBoundable>)_shape;
+    // resolve bounds while we can still safely read the styleable
+    [self resolveBackgroundBounds];
 
-                boundable.bounds = CGRectInset(boundable.bounds, 0.5f * strokeWidth, 0.5f * strokeWidth);
-            }
-        }
+    // the render queue only sees this snapshot, leaving the context free to change or be reused while it renders
+    STKPXBackgroundImageDescription *description = [self backgroundImageDescriptionWithBounds:_bounds];
 
-        // set corner radius
-        if ([self.shape isKindOfClass:[STKPXRectangle class]])
-        {
-            STKPXRectangle *rect = (STKPXRectangle *)self.shape;
+    requests[stateKey] = hashKey;
 
-            rect.radiusTopLeft = _boxModel.radiusTopLeft;
-            rect.radiusTopRight = _boxModel.radiusTopRight;
-            rect.radiusBottomRight = _boxModel.radiusBottomRight;
-            rect.radiusBottomLeft = _boxModel.radiusBottomLeft;
-        }
+    if (description.sharesShape)
+    {
+        block(self.backgroundImage);
+
+        return;
+    }
+
+    uint64_t digest = [self diskImageDigestWithBounds:_bounds];
+
+    // NOTE: the completion block keeps the styleable alive until it runs on the main queue, so the styleable is never
+    // released from the render queue
+    [[STKPXRenderPipeline sharedInstance] renderImageForKey:hashKey withBlock:^UIImage *{
+        UIImage *image = [description renderImage];
+
+        [diskCache setImage:image forDigest:digest];
 
-        // apply inner shadows
-        if (_innerShadow.shadows.count > 0)
+        return image;
+    } completion:^(UIImage *image) {
+        NSMutableDictionary *currentRequests = objc_getAssociatedObject(styleable, &BACKGROUND_REQUESTS);
+
+        // drop the image if the styleable was restyled while it was rendering
+        if ([currentRequests[stateKey] isEqual:hashKey])
         {
-            _shape.shadow = _innerShadow;
+            block(image);
         }
+    }];
+}
+
+- (uint64_t)diskImageDigestWithBounds:(CGRect)bounds
+{
+    NSMutableArray *assetURLs = [[NSMutableArray alloc] init];
+
+    STKCollectAssetURLs(_fill, assetURLs);
+    STKCollectAssetURLs(_imageFill, assetURLs);
+
+    // background images are rendered at the main screen's scale
+    return [STKPXDiskImageCache digestForStyleHash:self.styleHash
+                                              size:bounds.size
+                                             scale:[UIScreen mainScreen].scale
+                                         assetURLs:assetURLs];
+}
 
-        // generate image
-        BOOL isOpaque = [self isOpaque];
-        result = [_shape renderToImageWithBounds:_bounds withOpacity:isOpaque];
+- (void)resolveBackgroundBounds
+{
+    if (CGSizeEqualToSize(_imageSize, CGSizeZero) == NO)
+    {
+        _bounds = CGRectMake(0.0f, 0.0f, _imageSize.width, _imageSize.height);
+    }
+    else if (CGRectEqualToRect(_bounds, CGRectZero))
+    {
+        _bounds = self.styleable.bounds;
 
-        if (_padding.hasOffset)
+        if (CGSizeEqualToSize(_bounds.size, CGSizeZero) == YES)
         {
-            CGFloat x = _bounds.origin.x + _padding.left;
-            CGFloat y = _bounds.origin.y + _padding.top;
-            CGFloat width = _bounds.size.width - _padding.left - _padding.right;
-            CGFloat height = _bounds.size.height - _padding.top - _padding.bottom;
-
-            UIGraphicsBeginImageContextWithOptions(_bounds.size, isOpaque, 0.0);
-            [result drawInRect:CGRectMake(x, y, width, height)];
-            result = UIGraphicsGetImageFromCurrentImageContext();
-            UIGraphicsEndImageContext();
+            // Set default size to 32,32 if its zero
+            _bounds = CGRectMake(0.0f, 0.0f, 32.0f, 32.0f);
         }
+    }
+}
 
-        // apply insets, if we have any
-        if (!UIEdgeInsetsEqualToEdgeInsets(_insets, UIEdgeInsetsZero))
+- (STKPXBackgroundImageDescription *)backgroundImageDescriptionWithBounds:(CGRect)bounds
+{
+    return [[STKPXBackgroundImageDescription alloc] initWithShape:_shape
+                                                           bounds:bounds
+                                                             fill:[self getCombinedPaints]
+                                                         boxModel:_boxModel
+                                                     innerShadows:_innerShadow
+                                                          padding:_padding
+                                                           insets:_insets
+                                                           opaque:[self isOpaque]];
+}
+
+- (UIImage *)renderBackgroundImageWithBounds:(CGRect)bounds
+{
+    return [[self backgroundImageDescriptionWithBounds:bounds] renderImage];
+}
+
+#pragma mark - Nine-slice Backgrounds
+
+- (BOOL)hasStretchableBackground
+{
+    // anything drawn across the middle of the background (images, inner shadows, padding, user insets) would be
+    // smeared by stretching
+    if ((_shape != nil && [_shape class] != [STKPXRectangle class])
+    ||  _imageFill != nil
+    ||  _innerShadow.shadows.count > 0
+    ||  _padding.hasOffset
+    ||  !UIEdgeInsetsEqualToEdgeInsets(_insets, UIEdgeInsetsZero)
+    ||  !CGSizeEqualToSize(_imageSize, CGSizeZero))
+    {
+        return NO;
+    }
+
+    if (_fill != nil && ![_fill isKindOfClass:[STKPXSolidPaint class]])
+    {
+        if (![_fill isKindOfClass:[STKPXLinearGradient class]]
+        ||  ((STKPXLinearGradient *)_fill).axis == STKPXLinearGradientAxisNone)
         {
-            result = [result resizableImageWithCapInsets:_insets];
+            return NO;
         }
+    }
+
+    if (!_boxModel.hasBorder)
+    {
+        return YES;
+    }
+
+    // each side is drawn on its own, with dashes and dots laid out along the full edge. Only four identical solid
+    // sides survive being stretched
+    STKPXBorderStyle borderStyle = _boxModel.borderTopStyle;
+    CGFloat borderWidth = _boxModel.borderTopWidth;
+    id<STKPXPaint> borderPaint = _boxModel.borderTopPaint;
+
+    if ((borderStyle != STKPXBorderStyleSolid && borderStyle != STKPXBorderStyleNone)
+    ||  _boxModel.borderRightStyle != borderStyle
+    ||  _boxModel.borderBottomStyle != borderStyle
+    ||  _boxModel.borderLeftStyle != borderStyle
+    ||  _boxModel.borderRightWidth != borderWidth
+    ||  _boxModel.borderBottomWidth != borderWidth
+    ||  _boxModel.borderLeftWidth != borderWidth
+    ||  !STKPaintsAreEqual(_boxModel.borderRightPaint, borderPaint)
+    ||  !STKPaintsAreEqual(_boxModel.borderBottomPaint, borderPaint)
+    ||  !STKPaintsAreEqual(_boxModel.borderLeftPaint, borderPaint))
+    {
+        return NO;
+    }
+
+    return (borderPaint == nil || [borderPaint isKindOfClass:[STKPXSolidPaint class]]);
+}
+
+- (UIEdgeInsets)backgroundCapInsets
+{
+    // each cap covers its own side's border along with the corners next to it
+    UIEdgeInsets border = (_boxModel.hasBorder)
+        ? UIEdgeInsetsMake(_boxModel.borderTopWidth, _boxModel.borderLeftWidth,
+                           _boxModel.borderBottomWidth, _boxModel.borderRightWidth)
+        : UIEdgeInsetsZero;
+
+    return UIEdgeInsetsMake(
+        ceil(MAX(_boxModel.radiusTopLeft.height, _boxModel.radiusTopRight.height) + border.top),
+        ceil(MAX(_boxModel.radiusTopLeft.width, _boxModel.radiusBottomLeft.width) + border.left),
+        ceil(MAX(_boxModel.radiusBottomLeft.height, _boxModel.radiusBottomRight.height) + border.bottom),
+        ceil(MAX(_boxModel.radiusTopRight.width, _boxModel.radiusBottomRight.width) + border.right)
+    );
+}
+
+- (UIImage *)nineSliceBackgroundImage
+{
+    if (!PixateFreestyle.configuration.resizableBackgroundImages || ![self hasStretchableBackground])
+    {
+        return nil;
+    }
+
+    [self resolveBackgroundBounds];
+
+    CGSize targetSize = _bounds.size;
+    UIEdgeInsets caps = [self backgroundCapInsets];
+
+    // not worth it when the caps cover (nearly) the whole background
+    if (targetSize.width <= caps.left + caps.right + 1.0f || targetSize.height <= caps.top + caps.bottom + 1.0f)
+    {
+        return nil;
+    }
+
+    // a gradient can only be stretched across its axis, so keep the full length along it
+    STKPXLinearGradientAxis axis = ([_fill isKindOfClass:[STKPXLinearGradient class]])
+        ? ((STKPXLinearGradient *)_fill).axis
+        : STKPXLinearGradientAxisNone;
+    CGSize sliceSize = CGSizeMake(caps.left + 1.0f + caps.right, caps.top + 1.0f + caps.bottom);
+    CGFloat axisLength = 0.0f;
+
+    if (axis == STKPXLinearGradientAxisHorizontal)
+    {
+        sliceSize.width = axisLength = targetSize.width;
+    }
+    else if (axis == STKPXLinearGradientAxisVertical)
+    {
+        sliceSize.height = axisLength = targetSize.height;
+    }
+
+    // the key leaves out the view size so every view sharing this box model and fill shares the image. All four border
+    // sides are the same here, so the top one stands for them
+    BOOL hasBorder = _boxModel.hasBorder;
+    CGFloat borderWidth = (hasBorder) ? _boxModel.borderTopWidth : 0.0f;
+    NSUInteger hash = 0x9E3779B9;
+
+    hash = hash * 31 + _fill.hash;
+    hash = hash * 31 + axis;
+    hash = hash * 31 + @(axisLength).hash;
+    hash = hash * 31 + @(borderWidth).hash;
+    hash = hash * 31 + ((hasBorder) ? _boxModel.borderTopStyle : STKPXBorderStyleNone);
+    hash = hash * 31 + _boxModel.borderTopPaint.hash;
+    hash = hash * 31 + STKHashFromCGSize(_boxModel.radiusTopLeft);
+    hash = hash * 31 + STKHashFromCGSize(_boxModel.radiusTopRight);
+    hash = hash * 31 + STKHashFromCGSize(_boxModel.radiusBottomRight);
+    hash = hash * 31 + STKHashFromCGSize(_boxModel.radiusBottomLeft);
+    hash = hash * 31 + [self isOpaque];
+
+    NSNumber *hashKey = @(hash);
+    UIImage *result = [STKPXCacheManager imageForKey:hashKey];
+
+    if (result == nil)
+    {
+        UIImage *image = [self renderBackgroundImageWithBounds:CGRectMake(0.0f, 0.0f, sliceSize.width, sliceSize.height)];
+
+        result = [image resizableImageWithCapInsets:caps resizingMode:UIImageResizingModeStretch];
 
         if (PixateFreestyle.configuration.cacheImages)
         {
-            // estimate cost as number of pixels times 4 bytes per pixel. This is probably lower than actual
-            NSUInteger cost = result.size.width * result.size.height * 4;
+            NSUInteger cost = sliceSize.width * sliceSize.height * 4;
 
             [STKPXCacheManager setImage:result forKey:hashKey cost:cost];
         }
@@ -257,7 +671,7 @@ static NSString *DEFAULT_FONT = @"Helvetica";
 
     return
         (_opacity == 1.0f)
-    &&  _boxModel.isOpaque
+    &&  (_boxModel == nil || _boxModel.isOpaque)
     &&  (_fill != nil && _fill.isOpaque)
     &&  (_imageFill != nil && _imageFill.isOpaque);
 }
@@ -283,6 +697,9 @@ static NSString *DEFAULT_FONT = @"Helvetica";
         // a closest match variant of that family
         if (!result)
         {
+            // the family may be an @font-face that is still loading; come back once it is there
+            [STKPXFontRegistry restyleStyleable:self.styleable whenFamilyLoads:self.fontName];
+
             result = [UIFont systemFontOfSize:self.fontSize];
         }
     }
@@ -344,6 +761,32 @@ static NSString *DEFAULT_FONT = @"Helvetica";
     }
 }
 
+- (void)applyBackgroundImageToLayer:(CALayer *)layer
+{
+    [self requestBackgroundImage:^(UIImage *image) {
+        UIEdgeInsets caps = image.capInsets;
+        CGSize size = image.size;
+
+        layer.contents = (__bridge id)(image.CGImage);
+
+        if (!UIEdgeInsetsEqualToEdgeInsets(caps, UIEdgeInsetsZero) && size.width > 0.0f && size.height > 0.0f)
+        {
+            // contentsCenter is in unit coordinates of the image
+            layer.contentsCenter = CGRectMake(
+                caps.left / size.width,
+                caps.top / size.height,
+                (size.width - caps.left - caps.right) / size.width,
+                (size.height - caps.top - caps.bottom) / size.height
+            );
+            layer.contentsScale = image.scale;
+        }
+        else
+        {
+            layer.contentsCenter = CGRectMake(0.0f, 0.0f, 1.0f, 1.0f);
+        }
+    }];
+}
+
 #pragma mark - Setters
 
 - (void)setShadow:(id<STKPXShadowPaint>)shadow
@@ -0,0 +1,99 @@
+/****************************************************************************
+ *
+ * Copyright 2015-present StylingKit Development Team. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ****************************************************************************/
+//
+//  STKPXStylerDispatchTable.h
+//  StylingKit
+//
+
+#import <Foundation/Foundation.h>
+#import "STKPXStyler.h"
+#import "STKPXStyleable.h"
+
+/**
+ *  The declarations a single styler processes for one state, in declaration order. Buckets are built along with a
+ *  style info and replayed when the style info is applied.
+ */
+@interface STKPXStylerBucket : NSObject
+
+/**
+ *  Position of the styler in the styleable's viewStylers list
+ */
+@property (nonatomic, readonly) NSUInteger slot;
+
+/**
+ *  The class of the styler the bucket was built for. Used to confirm the styler found at slot is the expected one
+ */
+@property (nonatomic, readonly) Class stylerClass;
+
+/**
+ *  The declarations to process. This may be empty for stylers that only need their completion block called
+ */
+@property (nonatomic, readonly) NSArray *declarations;
+
+@end
+
+/**
+ *  A STKPXStylerDispatchTable maps property names to styler slots for one list of view stylers. Lists are shared by
+ *  all instances of a styleable class, so tables are built once per class and cached with the list.
+ */
+@interface STKPXStylerDispatchTable : NSObject
+
+/**
+ *  The stylers of this table, in slot order
+ */
+@property (nonatomic, readonly) NSArray *stylers;
+
+/**
+ *  Return the dispatch table for the given styleable's viewStylers list, building it on first use. Returns nil for
+ *  styleables without stylers
+ *
+ *  @param styleable The styleable
+ */
++ (instancetype)dispatchTableForStyleable:(id<STKPXStyleable>)styleable;
+
+/**
+ *  Return the dispatch table for a list of stylers, building it on first use
+ *
+ *  @param stylers The list of stylers
+ */
++ (instancetype)dispatchTableForStylers:(NSArray *)stylers;
+
+/**
+ *  Return the slot of the styler handling the specified property, or NSNotFound if none does. When several stylers
+ *  support a property, the last one wins
+ *
+ *  @param property The property name
+ */
+- (NSUInteger)slotForProperty:(NSString *)property;
+
+/**
+ *  Bucket declarations by styler. The result is in slot order and contains a bucket for every styler whose class
+ *  handles at least one of the declarations. Declarations no styler supports are skipped
+ *
+ *  @param declarations The declarations to bucket
+ */
+- (NSArray *)bucketsForDeclarations:(NSArray *)declarations;
+
+/**
+ *  Return the styler a bucket was built for, or nil if this table's stylers differ from the ones used to build it
+ *
+ *  @param bucket The bucket
+ */
+- (id<STKPXStyler>)stylerForBucket:(STKPXStylerBucket *)bucket;
+
+@end
@@ -0,0 +1,207 @@
+/****************************************************************************
+ *
+ * Copyright 2015-present StylingKit Development Team. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ****************************************************************************/
+//
+//  STKPXStylerDispatchTable.m
+//  StylingKit
+//
+
+#import "STKPXStylerDispatchTable.h"
+#import "NSObject+STKPXStyling.h"
+#import <objc/runtime.h>
+
+static const char DISPATCH_TABLE_KEY;
+
+@implementation STKPXStylerBucket
+
+- (instancetype)initWithSlot:(NSUInteger)slot stylerClass:(Class)stylerClass declarations:(NSArray *)declarations
+{
+    if (self = [super init])
+    {
+        _slot = slot;
+        _stylerClass = stylerClass;
+        _declarations = declarations;
+    }
+
+    return self;
+}
+
+@end
+
+@implementation STKPXStylerDispatchTable
+{
+    NSDictionary *slotsByProperty_;
+    NSUInteger *groupBySlot_;
+    NSUInteger groupCount_;
+}
+
+#pragma mark - Static methods
+
++ (instancetype)dispatchTableForStyleable:(id<STKPXStyleable>)styleable
+{
+    NSArray *stylers = ([styleable respondsToSelector:@selector(viewStylers)])
+        ? ((NSObject *)styleable).viewStylers
+        : nil;
+
+    return [self dispatchTableForStylers:stylers];
+}
+
++ (instancetype)dispatchTableForStylers:(NSArray *)stylers
+{
+    if (stylers == nil)
+    {
+        return nil;
+    }
+
+    // the table lives as long as the stylers list it describes
+    STKPXStylerDispatchTable *result = objc_getAssociatedObject(stylers, &DISPATCH_TABLE_KEY);
+
+    if (result == nil)
+    {
+        result = [[STKPXStylerDispatchTable alloc] initWithStylers:stylers];
+
+        objc_setAssociatedObject(stylers, &DISPATCH_TABLE_KEY, result, OBJC_ASSOCIATION_RETAIN);
+    }
+
+    return result;
+}
+
+#pragma mark - Initializers
+
+- (instancetype)initWithStylers:(NSArray *)stylers
+{
+    if (self = [super init])
+    {
+        NSUInteger count = stylers.count;
+        NSMutableDictionary *slotsByProperty = [[NSMutableDictionary alloc] init];
+        NSMutableArray *groupClasses = [[NSMutableArray alloc] init];
+
+        _stylers = [stylers copy];
+        groupBySlot_ = calloc(MAX(count, 1), sizeof(NSUInteger));
+
+        for (NSUInteger slot = 0; slot < count; slot++)
+        {
+            id<STKPXStyler> styler = stylers[slot];
+
+            // stylers of the same class form a group, a group is activated as a whole
+            NSUInteger group = [groupClasses indexOfObjectIdenticalTo:styler.class];
+
+            if (group == NSNotFound)
+            {
+                group = groupClasses.count;
+                [groupClasses addObject:styler.class];
+            }
+
+            groupBySlot_[slot] = group;
+
+            for (NSString *property in styler.supportedProperties)
+            {
+                slotsByProperty[property] = @(slot);
+            }
+        }
+
+        slotsByProperty_ = slotsByProperty;
+        groupCount_ = groupClasses.count;
+    }
+
+    return self;
+}
+
+#pragma mark - Methods
+
+- (NSUInteger)slotForProperty:(NSString *)property
+{
+    NSNumber *slot = (property != nil) ? slotsByProperty_[property] : nil;
+
+    return (slot != nil) ? slot.unsignedIntegerValue : NSNotFound;
+}
+
+- (NSArray *)bucketsForDeclarations:(NSArray *)declarations
+{
+    NSUInteger count = _stylers.count;
+    NSMutableArray *result = [[NSMutableArray alloc] init];
+
+    if (count == 0 || declarations.count == 0)
+    {
+        return result;
+    }
+
+    NSMutableArray *__strong *declarationsBySlot = (NSMutableArray *__strong *)calloc(count, sizeof(NSMutableArray *));
+    BOOL *activeGroups = calloc(groupCount_, sizeof(BOOL));
+
+    for (STKPXDeclaration *declaration in declarations)
+    {
+        NSUInteger slot = [self slotForProperty:declaration.name];
+
+        if (slot != NSNotFound)
+        {
+            if (declarationsBySlot[slot] == nil)
+            {
+                declarationsBySlot[slot] = [[NSMutableArray alloc] init];
+            }
+
+            [declarationsBySlot[slot] addObject:declaration];
+            activeGroups[groupBySlot_[slot]] = YES;
+        }
+    }
+
+    // stylers are activated by class, so a styler sharing its class with one that has declarations is run too
+    for (NSUInteger slot = 0; slot < count; slot++)
+    {
+        if (activeGroups[groupBySlot_[slot]])
+        {
+            NSArray *slotDeclarations = (declarationsBySlot[slot] != nil) ? declarationsBySlot[slot] : @[];
+
+            [result addObject:[[STKPXStylerBucket alloc] initWithSlot:slot
+                                                          stylerClass:[_stylers[slot] class]
+                                                         declarations:slotDeclarations]];
+        }
+
+        declarationsBySlot[slot] = nil;
+    }
+
+    free(declarationsBySlot);
+    free(activeGroups);
+
+    return result;
+}
+
+- (id<STKPXStyler>)stylerForBucket:(STKPXStylerBucket *)bucket
+{
+    id<STKPXStyler> result = nil;
+
+    if (bucket.slot < _stylers.count)
+    {
+        result = _stylers[bucket.slot];
+
+        if ([result class] != bucket.stylerClass)
+        {
+            result = nil;
+        }
+    }
+
+    return result;
+}
+
+#pragma mark - Overrides
+
+- (void)dealloc
+{
+    free(groupBySlot_);
+}
+
+@end
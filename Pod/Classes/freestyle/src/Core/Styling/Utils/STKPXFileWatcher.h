@@ -35,7 +35,9 @@
 + (STKPXFileWatcher *)sharedInstance;
 
 /**
- *  Turn on file monitoring and report changes to the specified handler
+ *  Turn on file monitoring and report changes to the specified handler. Bursts of changes are coalesced, so the
+ *  handler is invoked once on the main queue after the file has been quiet for a moment. Files replaced by an atomic
+ *  save continue to be monitored
  *
  *  @param filePath The local file to monitor
  *  @param handler The callback to invoke when changes are detected
@@ -25,7 +25,21 @@
 
 #import "STKPXFileWatcher.h"
 
+/**
+ *  The time a file has to stay quiet after an event before its handler is invoked
+ */
+static const NSTimeInterval kQuietInterval = 0.2;
+
+/**
+ *  Editors often save by replacing a file, so reopening it is retried a few times before giving up
+ */
+static const NSTimeInterval kReopenInterval = 0.05;
+static const NSUInteger kReopenAttempts = 20;
+
 @implementation STKPXFileWatcher
+{
+    NSMutableDictionary *generationsByPath_;
+}
 
 // Singleton getter
 + (STKPXFileWatcher *)sharedInstance
@@ -38,66 +52,82 @@
 	return sharedInstance;
 }
 
+- (instancetype)init
+{
+    if (self = [super init])
+    {
+        generationsByPath_ = [[NSMutableDictionary alloc] init];
+    }
+
+    return self;
+}
+
 - (void) watchFile:(NSString *) filePath handler:(dispatch_block_t) handler
+{
+    [self watchFile:filePath handler:handler attempt:0];
+}
+
+- (void)watchFile:(NSString *)filePath handler:(dispatch_block_t)handler attempt:(NSUInteger)attempt
 {
     int fildes = open(filePath.fileSystemRepresentation, O_EVTONLY);
-    
-    if(fildes > 0)
+
+    if (fildes < 0)
     {
-        // Set up a new watch
-        dispatch_queue_t queue = dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0);
-        
-        dispatch_source_t source = dispatch_source_create(DISPATCH_SOURCE_TYPE_VNODE,fildes,
-                                                          DISPATCH_VNODE_DELETE
-                                                          | DISPATCH_VNODE_WRITE
-                                                          | DISPATCH_VNODE_EXTEND
-//                                                          | DISPATCH_VNODE_ATTRIB
-//                                                          | DISPATCH_VNODE_LINK
-//                                                          | DISPATCH_VNODE_RENAME
-//                                                          | DISPATCH_VNODE_REVOKE
-                                                          ,
-                                                          queue);
-
-        __block BOOL pending = NO;
-
-        dispatch_source_set_event_handler(source, ^
+        if (attempt < kReopenAttempts)
         {
-            unsigned long flags = dispatch_source_get_data(source);
+            dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t) (kReopenInterval * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+                [self watchFile:filePath handler:handler attempt:attempt + 1];
+            });
+        }
 
-            if(flags)
-            {
-                // Send out the cancel msg
-                dispatch_source_cancel(source);
+        return;
+    }
 
-                // If call to handler is not pending, then queue it up.
-                // We do this to only fire handler once when getting lots of events.
-                if(!pending)
-                {
-                    pending = YES;
-                    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, 0.2 * NSEC_PER_SEC),
-                                   dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
-
-                            dispatch_async(dispatch_get_main_queue(), ^
-                            {
-                                handler();
-                                pending = NO;
-
-                                [[STKPXFileWatcher sharedInstance] watchFile:filePath handler:handler];
-                            });
-                    });
-                }
+    // Set up a new watch. Events are handled on the main queue, which also owns generationsByPath_
+    dispatch_source_t source = dispatch_source_create(DISPATCH_SOURCE_TYPE_VNODE,fildes,
+                                                      DISPATCH_VNODE_DELETE
+                                                      | DISPATCH_VNODE_WRITE
+                                                      | DISPATCH_VNODE_EXTEND
+//                                                      | DISPATCH_VNODE_ATTRIB
+//                                                      | DISPATCH_VNODE_LINK
+//                                                      | DISPATCH_VNODE_RENAME
+//                                                      | DISPATCH_VNODE_REVOKE
+                                                      ,
+                                                      dispatch_get_main_queue());
 
-            }
+    dispatch_source_set_event_handler(source, ^
+    {
+        unsigned long flags = dispatch_source_get_data(source);
 
-        });
-        
-        dispatch_source_set_cancel_handler(source, ^
+        if(flags)
         {
-            close(fildes);
-        });
+            // The descriptor may now refer to a deleted or replaced file, so watch the path again
+            dispatch_source_cancel(source);
 
-        dispatch_resume(source);
-    }
+            // Every event pushes the handler back, so a burst of writes results in a single call
+            NSUInteger generation = [generationsByPath_[filePath] unsignedIntegerValue] + 1;
+
+            generationsByPath_[filePath] = @(generation);
+
+            dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t) (kReopenInterval * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+                [self watchFile:filePath handler:handler attempt:0];
+            });
+
+            dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t) (kQuietInterval * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+                if ([generationsByPath_[filePath] unsignedIntegerValue] == generation)
+                {
+                    handler();
+                }
+            });
+        }
+    });
+
+    dispatch_source_set_cancel_handler(source, ^
+    {
+        close(fildes);
+    });
+
+    dispatch_resume(source);
 }
 
 @end
@@ -0,0 +1,104 @@
+/****************************************************************************
+ *
+ * Copyright 2015-present StylingKit Development Team. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ****************************************************************************/
+
+//
+//  STKPXRestyleScheduler.h
+//  StylingKit
+//
+
+#import <Foundation/Foundation.h>
+#import "STKPXStyleable.h"
+
+/**
+ *  A block returning the current time in seconds
+ */
+typedef NSTimeInterval (^STKPXRestyleSchedulerClock)(void);
+
+/**
+ *  A block arranging for the specified pass to run on a later turn of the main run loop
+ */
+typedef void (^STKPXRestyleSchedulerTurn)(dispatch_block_t pass);
+
+/**
+ *  A block applying styles to a styleable and, optionally, its descendants
+ */
+typedef void (^STKPXRestyleSchedulerStyler)(id<STKPXStyleable> styleable, BOOL recursive);
+
+/**
+ *  STKPXRestyleScheduler collects styleables that need to be restyled and styles them together on the next turn of the
+ *  main run loop. A styleable is styled at most once per pass and a styleable is dropped when one of its ancestors is
+ *  restyled recursively in the same pass. Work is ordered top-down so parents are styled before their children. When a
+ *  time budget is set, styleables that do not fit in a pass are carried over to the next turn
+ *
+ *  The scheduler must be used from the main thread. Requests made on other threads are forwarded to the main queue
+ */
+@interface STKPXRestyleScheduler : NSObject
+
+/**
+ *  The maximum amount of time, in seconds, a single pass may spend styling. At least one styleable is styled per pass.
+ *  A value of zero, the default, disables the budget
+ */
+@property (nonatomic) NSTimeInterval timeBudget;
+
+/**
+ *  The clock used to enforce the time budget. Defaults to CACurrentMediaTime
+ */
+@property (nonatomic, copy) STKPXRestyleSchedulerClock clock;
+
+/**
+ *  The block used to schedule a pass. Defaults to dispatching the pass asynchronously onto the main queue
+ */
+@property (nonatomic, copy) STKPXRestyleSchedulerTurn turn;
+
+/**
+ *  The block used to style each scheduled styleable. Defaults to UIView's updateStyles:recursively:
+ */
+@property (nonatomic, copy) STKPXRestyleSchedulerStyler styler;
+
+/**
+ *  The number of styleables waiting for a pass
+ */
+@property (readonly, nonatomic) NSUInteger pendingCount;
+
+/**
+ *  The scheduler used by the asynchronous styling methods
+ */
++ (STKPXRestyleScheduler *)sharedScheduler;
+
+/**
+ *  Request that the specified styleable be restyled on the next pass. Requesting a styleable that is already pending
+ *  only upgrades the request to recursive when needed
+ *
+ *  @param styleable The styleable to restyle
+ *  @param recursive A flag indicating if the styleable's descendants should be restyled as well
+ */
+- (void)scheduleStyleable:(id<STKPXStyleable>)styleable recursive:(BOOL)recursive;
+
+/**
+ *  Determine if the specified styleable is waiting for a pass
+ *
+ *  @param styleable The styleable to test
+ */
+- (BOOL)isStyleableScheduled:(id<STKPXStyleable>)styleable;
+
+/**
+ *  Style all pending styleables immediately, ignoring the time budget
+ */
+- (void)flush;
+
+@end
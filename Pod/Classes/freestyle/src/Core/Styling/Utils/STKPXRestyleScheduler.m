@@ -0,0 +1,263 @@
+/****************************************************************************
+ *
+ * Copyright 2015-present StylingKit Development Team. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ****************************************************************************/
+
+//
+//  STKPXRestyleScheduler.m
+//  StylingKit
+//
+
+#import "STKPXRestyleScheduler.h"
+#import "UIView+STKPXStyling.h"
+
+#import <QuartzCore/QuartzCore.h>
+
+@interface STKPXRestyleRequest : NSObject
+@property (nonatomic, strong) id<STKPXStyleable> styleable;
+@property (nonatomic) BOOL recursive;
+@property (nonatomic) NSUInteger sequence;
+@property (nonatomic) NSUInteger depth;
+@end
+
+@implementation STKPXRestyleRequest
+@end
+
+@implementation STKPXRestyleScheduler
+{
+    NSMapTable *pending_;
+    NSUInteger sequence_;
+    BOOL passScheduled_;
+}
+
+#pragma mark - Static Methods
+
++ (STKPXRestyleScheduler *)sharedScheduler
+{
+    static STKPXRestyleScheduler *sharedScheduler;
+    static dispatch_once_t onceToken;
+
+    dispatch_once(&onceToken, ^{
+        sharedScheduler = [[STKPXRestyleScheduler alloc] init];
+    });
+
+    return sharedScheduler;
+}
+
+#pragma mark - Initializers
+
+- (instancetype)init
+{
+    if (self = [super init])
+    {
+        pending_ = [[NSMapTable alloc] initWithKeyOptions:NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPointerPersonality
+                                             valueOptions:NSPointerFunctionsStrongMemory
+                                                 capacity:0];
+
+        _clock = ^NSTimeInterval {
+            return CACurrentMediaTime();
+        };
+
+        _turn = ^(dispatch_block_t pass) {
+            dispatch_async(dispatch_get_main_queue(), pass);
+        };
+
+        _styler = ^(id<STKPXStyleable> styleable, BOOL recursive) {
+            [UIView updateStyles:styleable recursively:recursive];
+        };
+    }
+
+    return self;
+}
+
+#pragma mark - Getters
+
+- (NSUInteger)pendingCount
+{
+    return pending_.count;
+}
+
+#pragma mark - Methods
+
+- (void)scheduleStyleable:(id<STKPXStyleable>)styleable recursive:(BOOL)recursive
+{
+    if (styleable == nil)
+    {
+        return;
+    }
+
+    if (![NSThread isMainThread])
+    {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self scheduleStyleable:styleable recursive:recursive];
+        });
+
+        return;
+    }
+
+    STKPXRestyleRequest *request = [pending_ objectForKey:styleable];
+
+    if (request)
+    {
+        request.recursive = request.recursive || recursive;
+    }
+    else
+    {
+        request = [[STKPXRestyleRequest alloc] init];
+        request.styleable = styleable;
+        request.recursive = recursive;
+        request.sequence = sequence_++;
+
+        [pending_ setObject:request forKey:styleable];
+    }
+
+    [self schedulePass];
+}
+
+- (BOOL)isStyleableScheduled:(id<STKPXStyleable>)styleable
+{
+    return styleable != nil && [pending_ objectForKey:styleable] != nil;
+}
+
+- (void)flush
+{
+    [self stylePendingWithBudget:0];
+}
+
+#pragma mark - Helpers
+
+- (void)schedulePass
+{
+    if (!passScheduled_)
+    {
+        passScheduled_ = YES;
+
+        __weak STKPXRestyleScheduler *weakSelf = self;
+
+        self.turn(^{
+            STKPXRestyleScheduler *scheduler = weakSelf;
+
+            if (scheduler)
+            {
+                scheduler->passScheduled_ = NO;
+                [scheduler stylePendingWithBudget:scheduler.timeBudget];
+            }
+        });
+    }
+}
+
+- (NSArray *)takeBatch
+{
+    NSMutableArray *requests = [NSMutableArray arrayWithCapacity:pending_.count];
+    NSHashTable *recursiveStyleables = [NSHashTable hashTableWithOptions:NSPointerFunctionsObjectPointerPersonality];
+
+    for (STKPXRestyleRequest *request in pending_.objectEnumerator)
+    {
+        [requests addObject:request];
+
+        if (request.recursive)
+        {
+            [recursiveStyleables addObject:request.styleable];
+        }
+    }
+
+    [pending_ removeAllObjects];
+
+    // drop requests covered by a recursive ancestor and measure the depth of the others
+    NSMutableArray *batch = [NSMutableArray arrayWithCapacity:requests.count];
+
+    for (STKPXRestyleRequest *request in requests)
+    {
+        BOOL covered = NO;
+        NSUInteger depth = 0;
+        id<STKPXStyleable> ancestor = request.styleable.pxStyleParent;
+
+        while (ancestor)
+        {
+            if ([recursiveStyleables containsObject:ancestor])
+            {
+                covered = YES;
+                break;
+            }
+
+            depth++;
+            ancestor = ancestor.pxStyleParent;
+        }
+
+        if (!covered)
+        {
+            request.depth = depth;
+            [batch addObject:request];
+        }
+    }
+
+    // style parents before their children, and siblings in the order they were requested
+    [batch sortUsingComparator:^NSComparisonResult(STKPXRestyleRequest *a, STKPXRestyleRequest *b) {
+        if (a.depth != b.depth)
+        {
+            return (a.depth < b.depth) ? NSOrderedAscending : NSOrderedDescending;
+        }
+
+        return (a.sequence < b.sequence) ? NSOrderedAscending : NSOrderedDescending;
+    }];
+
+    return batch;
+}
+
+- (void)stylePendingWithBudget:(NSTimeInterval)budget
+{
+    if (pending_.count == 0)
+    {
+        return;
+    }
+
+    NSArray *batch = [self takeBatch];
+    NSTimeInterval start = self.clock();
+    NSUInteger index = 0;
+
+    for (; index < batch.count; index++)
+    {
+        if (index > 0 && budget > 0 && self.clock() - start >= budget)
+        {
+            break;
+        }
+
+        STKPXRestyleRequest *request = batch[index];
+
+        self.styler(request.styleable, request.recursive);
+    }
+
+    if (index < batch.count)
+    {
+        // carry the remaining work over, merging it with anything requested while styling
+        for (; index < batch.count; index++)
+        {
+            STKPXRestyleRequest *request = batch[index];
+            STKPXRestyleRequest *existing = [pending_ objectForKey:request.styleable];
+
+            if (existing)
+            {
+                request.recursive = request.recursive || existing.recursive;
+            }
+
+            [pending_ setObject:request forKey:request.styleable];
+        }
+
+        [self schedulePass];
+    }
+}
+
+@end
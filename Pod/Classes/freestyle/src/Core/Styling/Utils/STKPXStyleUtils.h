@@ -43,6 +43,27 @@ typedef struct {
 + (NSString *)selectorFromStyleable:(id<STKPXStyleable>)styleable;
 + (NSString *)styleKeyFromStyleable:(id<STKPXStyleable>)styleable;
 
+/**
+ *  Return the style key of a styleable, building it only when the styleable changed class or was invalidated since
+ *  the key was last built. Equal keys share one string instance. Styleables answering styleKey through this method must
+ *  call invalidateStyleKeyForStyleable: whenever their style id, style classes or element name change
+ *
+ *  @param styleable The styleable whose key to return
+ */
++ (NSString *)cachedStyleKeyForStyleable:(id<STKPXStyleable>)styleable;
+
+/**
+ *  Drop the cached style key of a styleable
+ *
+ *  @param styleable The styleable whose key changed
+ */
++ (void)invalidateStyleKeyForStyleable:(id<STKPXStyleable>)styleable;
+
+/**
+ *  Drop every cached style key, e.g. after the element name of a class was changed
+ */
++ (void)invalidateStyleKeys;
+
 + (void)enumerateStyleableAndDescendants:(id<STKPXStyleable>)styleable usingBlock:(void (^)(id obj, BOOL *stop, BOOL *stopDescending))block;
 + (void)enumerateStyleableDescendants:(id<STKPXStyleable>)styleable usingBlock:(void (^)(id obj, BOOL *stop, BOOL *stopDescending))block;
 
@@ -50,6 +71,7 @@ typedef struct {
 + (NSMutableArray *)matchingRuleSetsForStyleable:(id<STKPXStyleable>)styleable;
 + (NSArray *)filterRuleSets:(NSArray *)ruleSets forStyleable:(id<STKPXStyleable>)styleable byState:(NSString *)stateName;
 + (NSArray *)filterRuleSets:(NSArray *)ruleSets byPseudoElement:(NSString *)pseudoElement;
++ (NSArray *)partitionRuleSets:(NSArray *)ruleSets forStyleable:(id<STKPXStyleable>)styleable byStates:(NSArray *)stateNames;
 
 + (BOOL)stylesOfStyleable:(id<STKPXStyleable>)styleable matchDeclarations:(NSArray *)declarations state:(NSString *)state;
 + (void)invalidateStyleable:(id<STKPXStyleable>)styleable;
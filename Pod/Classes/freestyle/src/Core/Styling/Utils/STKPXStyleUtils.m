@@ -37,6 +37,8 @@
 #import "NSObject+STKPXStyling.h"
 #import "STKPXStyler.h"
 #import "STKPXVirtualStyleableControl.h"
+#import "STKPXPseudoClassSelector.h"
+#import "STKPXRestyleScheduler.h"
 
 #import <QuartzCore/QuartzCore.h>
 
@@ -46,6 +48,28 @@
 static const char hash;
 static const char itemIndex;
 static const char viewDelegate;
+static const char styleKey;
+
+// bumped whenever every cached style key must be rebuilt
+static volatile NSUInteger STYLE_KEY_GENERATION = 0;
+
+// the most distinct style keys kept for sharing before the table starts over
+static const NSUInteger STYLE_KEY_INTERN_LIMIT = 4096;
+
+/**
+ *  The style key cached on a styleable, along with what it was built against
+ */
+@interface STKPXStyleKeyEntry : NSObject
+{
+@public
+    Class class_;
+    NSUInteger generation_;
+    NSString *key_;
+}
+@end
+
+@implementation STKPXStyleKeyEntry
+@end
 
 @implementation STKPXStyleUtils
 
@@ -239,6 +263,77 @@ STK_DEFINE_CLASS_LOG_LEVEL;
     return [[styleable.class description] stringByAppendingPathComponent:[STKPXStyleUtils selectorFromStyleable:styleable]];
 }
 
++ (NSString *)cachedStyleKeyForStyleable:(id<STKPXStyleable>)styleable
+{
+    STKPXStyleKeyEntry *entry = objc_getAssociatedObject(styleable, &styleKey);
+    Class class = object_getClass(styleable);
+    NSUInteger generation = STYLE_KEY_GENERATION;
+
+    // dynamic subclassing swaps the class without telling anyone, so the key also records the class it was built for
+    if (entry && entry->class_ == class && entry->generation_ == generation)
+    {
+        return entry->key_;
+    }
+
+    if (entry == nil)
+    {
+        entry = [[STKPXStyleKeyEntry alloc] init];
+        objc_setAssociatedObject(styleable, &styleKey, entry, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+    }
+
+    entry->class_ = class;
+    entry->generation_ = generation;
+    entry->key_ = [self internStyleKey:[self styleKeyFromStyleable:styleable]];
+
+    return entry->key_;
+}
+
++ (NSString *)internStyleKey:(NSString *)key
+{
+    static NSMutableSet *keys;
+    static dispatch_once_t onceToken;
+
+    dispatch_once(&onceToken, ^{
+        keys = [[NSMutableSet alloc] init];
+    });
+
+    @synchronized(keys)
+    {
+        NSString *result = [keys member:key];
+
+        if (result == nil)
+        {
+            if (keys.count >= STYLE_KEY_INTERN_LIMIT)
+            {
+                [keys removeAllObjects];
+            }
+
+            result = [key copy];
+            [keys addObject:result];
+        }
+
+        return result;
+    }
+}
+
++ (void)invalidateStyleKeyForStyleable:(id<STKPXStyleable>)styleable
+{
+    STKPXStyleKeyEntry *entry = objc_getAssociatedObject(styleable, &styleKey);
+
+    if (entry)
+    {
+        entry->class_ = Nil;
+    }
+}
+
++ (void)invalidateStyleKeys
+{
+    @synchronized(self)
+    {
+        STYLE_KEY_GENERATION++;
+    }
+}
+
 + (NSString *)selectorFromStyleable:(id<STKPXStyleable>)styleable
 {
     NSMutableArray *parts = [[NSMutableArray alloc] init];
@@ -340,15 +435,30 @@ STK_DEFINE_CLASS_LOG_LEVEL;
 
 + (NSMutableArray *)matchingRuleSetsForStyleable:(id<STKPXStyleable>)styleable
 {
-    // find matching rule sets, regardless of any supported or specified pseudo-classes
-    NSMutableArray *ruleSets = [[STKPXStylesheet currentApplicationStylesheet] ruleSetsMatchingStyleable:styleable].mutableCopy;
-    [ruleSets addObjectsFromArray:[[STKPXStylesheet currentUserStylesheet] ruleSetsMatchingStyleable:styleable]];
-    [ruleSets addObjectsFromArray:[[STKPXStylesheet currentViewStylesheet] ruleSetsMatchingStyleable:styleable]];
+    // find matching rule sets, regardless of any supported or specified pseudo-classes. All three origins append to
+    // the same scratch span, so the only container built is the result
+    STKPXRuleSetScratch *scratch = STKPXRuleSetScratchAcquire();
+
+    [[STKPXStylesheet currentApplicationStylesheet] appendRuleSetsMatchingStyleable:styleable toScratch:scratch];
+    [[STKPXStylesheet currentUserStylesheet] appendRuleSetsMatchingStyleable:styleable toScratch:scratch];
+    [[STKPXStylesheet currentViewStylesheet] appendRuleSetsMatchingStyleable:styleable toScratch:scratch];
+
+    NSMutableArray *ruleSets = [[NSMutableArray alloc] initWithObjects:scratch->ruleSets count:scratch->ruleSetCount];
+
+    STKPXRuleSetScratchRelinquish(scratch);
+
+    // include any inline styling, preferring the styleable's own parsed copy over reparsing its CSS
+    if ([styleable respondsToSelector:@selector(inlineRuleSet)])
+    {
+        STKPXRuleSet *inlineRuleSet = styleable.inlineRuleSet;
 
-    // include any inline styling
-    if ([styleable respondsToSelector:@selector(styleCSS)])
+        if (inlineRuleSet)
+        {
+            [ruleSets addObject:inlineRuleSet];
+        }
+    }
+    else if ([styleable respondsToSelector:@selector(styleCSS)])
     {
-        // TODO: store and use cached values
         NSString *source = styleable.styleCSS;
 
         if (source.length > 0)
@@ -366,17 +476,17 @@ STK_DEFINE_CLASS_LOG_LEVEL;
 + (NSArray *)filterRuleSets:(NSArray *)ruleSets forStyleable:(id<STKPXStyleable>)styleable byState:(NSString *)stateName
 {
     NSMutableArray *ruleSetsForState = [[NSMutableArray alloc] init];
+    uint64_t stateBit = [STKPXPseudoClassSelector stateBitForClassName:stateName];
 
     // process each rule set
     for (STKPXRuleSet *ruleSet in ruleSets)
     {
-        // grab the target type selector (the selector itself or a combinator's RHS)
-        STKPXTypeSelector *selector = ruleSet.targetTypeSelector;
+        uint64_t mask = ruleSet.stateMask;
 
         // assume we will not be adding this rule set into our results
         BOOL add = NO;
 
-        if (!selector.hasPseudoClasses)
+        if (mask == 0)
         {
             // the selector didn't specify a pseudo-class so assume the default psuedo-class was specified
 
@@ -392,10 +502,15 @@ STK_DEFINE_CLASS_LOG_LEVEL;
                 add = !stateName;
             }
         }
+        else if (stateBit != STKPXPseudoClassStateOverflow)
+        {
+            // add if the selector has the state's bit
+            add = (mask & stateBit) != 0;
+        }
         else
         {
-            // add if the styleable has the state name in its lists of supported pseudo-classes
-            add = [selector hasPseudoClass:stateName];
+            // state names without a bit of their own have to be compared
+            add = (mask & STKPXPseudoClassStateOverflow) != 0 && [ruleSet.targetTypeSelector hasPseudoClass:stateName];
         }
 
         if (add)
@@ -407,6 +522,65 @@ STK_DEFINE_CLASS_LOG_LEVEL;
     return ruleSetsForState;
 }
 
++ (NSArray *)partitionRuleSets:(NSArray *)ruleSets forStyleable:(id<STKPXStyleable>)styleable byStates:(NSArray *)stateNames
+{
+    NSUInteger stateCount = stateNames.count;
+    NSMutableArray *result = [[NSMutableArray alloc] initWithCapacity:stateCount];
+    uint64_t stateBits[stateCount > 0 ? stateCount : 1];
+    NSUInteger defaultIndex = NSNotFound;
+
+    // map each state name to its bit once, instead of comparing names for every rule set and state
+    NSString *defaultPseudoClass = ([styleable respondsToSelector:@selector(defaultPseudoClass)])
+        ? styleable.defaultPseudoClass
+        : nil;
+
+    for (NSUInteger i = 0; i < stateCount; i++)
+    {
+        NSString *stateName = stateNames[i];
+
+        stateBits[i] = [STKPXPseudoClassSelector stateBitForClassName:stateName];
+
+        if (defaultIndex == NSNotFound && [defaultPseudoClass isEqualToString:stateName])
+        {
+            defaultIndex = i;
+        }
+
+        [result addObject:[NSMutableArray array]];
+    }
+
+    // one pass over the rule sets, dropping each into the buckets of the states it applies to. Buckets keep the order
+    // of the incoming list
+    for (STKPXRuleSet *ruleSet in ruleSets)
+    {
+        uint64_t mask = ruleSet.stateMask;
+
+        if (mask == 0)
+        {
+            if (defaultIndex != NSNotFound)
+            {
+                [result[defaultIndex] addObject:ruleSet];
+            }
+
+            continue;
+        }
+
+        for (NSUInteger i = 0; i < stateCount; i++)
+        {
+            uint64_t stateBit = stateBits[i];
+            BOOL add = (stateBit != STKPXPseudoClassStateOverflow)
+                ? (mask & stateBit) != 0
+                : (mask & STKPXPseudoClassStateOverflow) != 0 && [ruleSet.targetTypeSelector hasPseudoClass:stateNames[i]];
+
+            if (add)
+            {
+                [result[i] addObject:ruleSet];
+            }
+        }
+    }
+
+    return result;
+}
+
 + (NSArray *)filterRuleSets:(NSArray *)ruleSets byPseudoElement:(NSString *)pseudoElement
 {
     NSMutableArray *ruleSetsForPseudoElement = nil;
@@ -663,14 +837,8 @@ NSUInteger STKHashFromCGRect(CGRect rect)
         }
         else
         {
-            if(recursive)
-            {
-                [view updateStyles];
-            }
-            else
-            {
-                [view updateStylesNonRecursively];
-            }
+            // join the current restyle pass so cells reloaded together are styled together
+            [[STKPXRestyleScheduler sharedScheduler] scheduleStyleable:view recursive:recursive];
         }
     }
 }
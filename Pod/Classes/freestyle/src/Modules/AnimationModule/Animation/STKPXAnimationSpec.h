@@ -0,0 +1,80 @@
+/****************************************************************************
+ *
+ * Copyright 2015-present StylingKit Development Team. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ****************************************************************************/
+
+//
+//  STKPXAnimationSpec.h
+//  StylingKit
+//
+
+#import <Foundation/Foundation.h>
+#import <QuartzCore/QuartzCore.h>
+#import "STKPXAnimationInfo.h"
+#import "STKPXKeyframeTemplate.h"
+
+/**
+ *  A description of one keyframe animation to attach to a layer: a compiled track paired with the timing settings of
+ *  an animation info. Specs compare by value, so a restyle that resolves to the same animations can leave the layer
+ *  alone instead of restarting them
+ */
+@interface STKPXAnimationSpec : NSObject
+
+@property (readonly, nonatomic, strong) STKPXKeyframeTrack *track;
+@property (readonly, nonatomic) CGFloat duration;
+@property (readonly, nonatomic) CGFloat delay;
+@property (readonly, nonatomic) NSUInteger repeatCount;
+@property (readonly, nonatomic) STKPXAnimationFillMode fillMode;
+@property (readonly, nonatomic) STKPXAnimationTimingFunction timingFunction;
+
+/**
+ *  The key the animation is attached to its layer under. There is at most one spec per animated key path
+ */
+@property (readonly, nonatomic, copy) NSString *key;
+
+@property (readonly, nonatomic, getter = isValid) BOOL valid;
+
+- (instancetype)init NS_UNAVAILABLE;
+- (instancetype)initWithTrack:(STKPXKeyframeTrack *)track info:(STKPXAnimationInfo *)info NS_DESIGNATED_INITIALIZER;
+
+/**
+ *  Build the Core Animation object for this spec. Its begin time is relative to the time of the call
+ */
+- (CAKeyframeAnimation *)caKeyframeAnimation;
+
+/**
+ *  Compare the specs attached to a layer with the specs a styling pass produced. Specs that are unchanged produce no
+ *  work. This does not touch Core Animation
+ *
+ *  @param attached The attached specs, keyed by spec key
+ *  @param specs The specs that should be attached
+ *  @param removedKeys Receives the keys of attached animations that have to go, including replaced ones
+ *  @param addedSpecs Receives the specs that have to be attached
+ */
++ (void)diffAttachedSpecs:(NSDictionary *)attached
+                withSpecs:(NSArray *)specs
+              removedKeys:(NSMutableArray *)removedKeys
+               addedSpecs:(NSMutableArray *)addedSpecs;
+
+/**
+ *  Bring the animations on a layer in line with specs, leaving animations that are already attached running
+ *
+ *  @param specs The specs that should be attached
+ *  @param layer The layer to update
+ */
++ (void)applySpecs:(NSArray *)specs toLayer:(CALayer *)layer;
+
+@end
@@ -0,0 +1,190 @@
+/****************************************************************************
+ *
+ * Copyright 2015-present StylingKit Development Team. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ****************************************************************************/
+
+//
+//  STKPXAnimationSpec.m
+//  StylingKit
+//
+
+#import "STKPXAnimationSpec.h"
+#import "STKPXKeyframeAnimation.h"
+#import <objc/runtime.h>
+
+static const char ATTACHED_SPECS_KEY;
+
+@implementation STKPXAnimationSpec
+
+#pragma mark - Static Methods
+
++ (void)diffAttachedSpecs:(NSDictionary *)attached
+                withSpecs:(NSArray *)specs
+              removedKeys:(NSMutableArray *)removedKeys
+               addedSpecs:(NSMutableArray *)addedSpecs
+{
+    NSMutableSet *keys = [[NSMutableSet alloc] initWithCapacity:specs.count];
+
+    for (STKPXAnimationSpec *spec in specs)
+    {
+        // the first animation to claim a key path wins
+        if (!spec.isValid || [keys containsObject:spec.key])
+        {
+            continue;
+        }
+
+        [keys addObject:spec.key];
+
+        STKPXAnimationSpec *current = attached[spec.key];
+
+        if (current == nil)
+        {
+            [addedSpecs addObject:spec];
+        }
+        else if (![current isEqual:spec])
+        {
+            [removedKeys addObject:spec.key];
+            [addedSpecs addObject:spec];
+        }
+    }
+
+    [attached enumerateKeysAndObjectsUsingBlock:^(NSString *key, STKPXAnimationSpec *spec, BOOL *stop) {
+        if (![keys containsObject:key])
+        {
+            [removedKeys addObject:key];
+        }
+    }];
+}
+
++ (void)applySpecs:(NSArray *)specs toLayer:(CALayer *)layer
+{
+    if (layer == nil)
+    {
+        return;
+    }
+
+    NSDictionary *attached = objc_getAssociatedObject(layer, &ATTACHED_SPECS_KEY);
+    NSMutableDictionary *live = [[NSMutableDictionary alloc] initWithCapacity:attached.count];
+
+    // forget animations that were removed behind our back so they get attached again
+    [attached enumerateKeysAndObjectsUsingBlock:^(NSString *key, STKPXAnimationSpec *spec, BOOL *stop) {
+        if ([layer animationForKey:key] != nil)
+        {
+            live[key] = spec;
+        }
+    }];
+
+    NSMutableArray *removedKeys = [[NSMutableArray alloc] init];
+    NSMutableArray *addedSpecs = [[NSMutableArray alloc] init];
+
+    [self diffAttachedSpecs:live withSpecs:specs removedKeys:removedKeys addedSpecs:addedSpecs];
+
+    for (NSString *key in removedKeys)
+    {
+        [layer removeAnimationForKey:key];
+        [live removeObjectForKey:key];
+    }
+
+    for (STKPXAnimationSpec *spec in addedSpecs)
+    {
+        CAKeyframeAnimation *animation = spec.caKeyframeAnimation;
+
+        if (animation != nil)
+        {
+            [layer addAnimation:animation forKey:spec.key];
+            live[spec.key] = spec;
+        }
+    }
+
+    objc_setAssociatedObject(layer, &ATTACHED_SPECS_KEY, (live.count) ? live : nil, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+}
+
+#pragma mark - Initializers
+
+- (instancetype)initWithTrack:(STKPXKeyframeTrack *)track info:(STKPXAnimationInfo *)info
+{
+    if (self = [super init])
+    {
+        _track = track;
+        _duration = info.animationDuration;
+        _delay = info.animationDelay;
+        _repeatCount = info.animationIterationCount;
+        _fillMode = info.animationFillMode;
+        _timingFunction = info.animationTimingFunction;
+        _key = [@"stk-animation:" stringByAppendingString:(track.keyPath) ?: @""];
+    }
+
+    return self;
+}
+
+#pragma mark - Getters
+
+- (BOOL)isValid
+{
+    return _track.keyPath.length > 0 && _track.values.count > 0 && _duration > 0.0f;
+}
+
+#pragma mark - Methods
+
+- (CAKeyframeAnimation *)caKeyframeAnimation
+{
+    STKPXKeyframeAnimation *animation = [[STKPXKeyframeAnimation alloc] init];
+
+    animation.keyPath = _track.keyPath;
+    animation.duration = _duration;
+    animation.fillMode = _fillMode;
+    animation.repeatCount = _repeatCount;
+    animation.beginTime = _delay;
+
+    [_track.values enumerateObjectsUsingBlock:^(id value, NSUInteger idx, BOOL *stop) {
+        [animation addValue:value];
+        [animation addKeyTime:((NSNumber *) _track.keyTimes[idx]).floatValue];
+        [animation addTimingFunction:_timingFunction];
+    }];
+
+    return animation.caKeyframeAnimation;
+}
+
+#pragma mark - Overrides
+
+- (BOOL)isEqual:(id)object
+{
+    if (self == object)
+    {
+        return YES;
+    }
+
+    if (![object isKindOfClass:[STKPXAnimationSpec class]])
+    {
+        return NO;
+    }
+
+    STKPXAnimationSpec *other = object;
+
+    return _duration == other->_duration
+        && _delay == other->_delay
+        && _repeatCount == other->_repeatCount
+        && _fillMode == other->_fillMode
+        && _timingFunction == other->_timingFunction
+        && (_track == other->_track || [_track isEqual:other->_track]);
+}
+
+- (NSUInteger)hash
+{
+    return _key.hash;
+}
+
+@end
@@ -39,6 +39,16 @@
 
 @property (nonatomic) CAKeyframeAnimation *caKeyframeAnimation;
 
+/**
+ *  Return the Core Animation fill mode used for the given CSS fill mode
+ */
++ (NSString *)caFillModeForFillMode:(STKPXAnimationFillMode)fillMode;
+
+/**
+ *  Return the Core Animation timing function used for the given CSS timing function
+ */
++ (CAMediaTimingFunction *)caTimingFunctionForTimingFunction:(STKPXAnimationTimingFunction)timingFunction;
+
 - (void)addValue:(id)value;
 - (void)addKeyTime:(CGFloat)keyTime;
 - (void)addTimingFunction:(STKPXAnimationTimingFunction)timingFunction;
@@ -33,27 +33,25 @@
     NSString *caFillMode_;
 }
 
-#pragma mark - Setters
+#pragma mark - Static Methods
 
-- (void)setFillMode:(STKPXAnimationFillMode)fillMode
++ (NSString *)caFillModeForFillMode:(STKPXAnimationFillMode)fillMode
 {
-    _fillMode = fillMode;
-
     // TODO: This is the CA default. What should it be for CSS?
-    caFillMode_ = kCAFillModeRemoved;
+    NSString *result = kCAFillModeRemoved;
 
-    switch (_fillMode)
+    switch (fillMode)
     {
         case STKPXAnimationFillModeBackwards:
-            caFillMode_ = kCAFillModeBackwards;
+            result = kCAFillModeBackwards;
             break;
 
         case STKPXAnimationFillModeBoth:
-            caFillMode_ = kCAFillModeBoth;
+            result = kCAFillModeBoth;
             break;
 
         case STKPXAnimationFillModeForwards:
-            caFillMode_ = kCAFillModeForwards;
+            result = kCAFillModeForwards;
             break;
 
         case STKPXAnimationFillModeNone:
@@ -61,6 +59,52 @@
         default:
             break;
     }
+
+    return result;
+}
+
++ (CAMediaTimingFunction *)caTimingFunctionForTimingFunction:(STKPXAnimationTimingFunction)timingFunction
+{
+    // TODO: default to linear?
+    NSString *name = kCAMediaTimingFunctionDefault;
+
+    switch (timingFunction)
+    {
+        case STKPXAnimationTimingFunctionEase:
+            break;
+
+        case STKPXAnimationTimingFunctionEaseIn:
+            name = kCAMediaTimingFunctionEaseIn;
+            break;
+
+        case STKPXAnimationTimingFunctionEaseInOut:
+            name = kCAMediaTimingFunctionEaseInEaseOut;
+            break;
+
+        case STKPXAnimationTimingFunctionEaseOut:
+            name = kCAMediaTimingFunctionEaseOut;
+            break;
+
+        case STKPXAnimationTimingFunctionLinear:
+            name = kCAMediaTimingFunctionLinear;
+            break;
+
+        case STKPXAnimationTimingFunctionStepEnd:
+        case STKPXAnimationTimingFunctionStepStart:
+        case STKPXAnimationTimingFunctionUndefined:
+        default:
+            break;
+    }
+
+    return [CAMediaTimingFunction functionWithName:name];
+}
+
+#pragma mark - Setters
+
+- (void)setFillMode:(STKPXAnimationFillMode)fillMode
+{
+    _fillMode = fillMode;
+    caFillMode_ = [STKPXKeyframeAnimation caFillModeForFillMode:fillMode];
 }
 
 #pragma mark - Methods
@@ -92,38 +136,7 @@
         _timingFunctions = [[NSMutableArray alloc] init];
     }
 
-    // TODO: default to linear?
-    CAMediaTimingFunction *tf = [CAMediaTimingFunction functionWithName:kCAMediaTimingFunctionDefault];
-
-    switch (timingFunction)
-    {
-        case STKPXAnimationTimingFunctionEase:
-            break;
-
-        case STKPXAnimationTimingFunctionEaseIn:
-            tf = [CAMediaTimingFunction functionWithName:kCAMediaTimingFunctionEaseIn];
-            break;
-
-        case STKPXAnimationTimingFunctionEaseInOut:
-            tf = [CAMediaTimingFunction functionWithName:kCAMediaTimingFunctionEaseInEaseOut];
-            break;
-
-        case STKPXAnimationTimingFunctionEaseOut:
-            tf = [CAMediaTimingFunction functionWithName:kCAMediaTimingFunctionEaseOut];
-            break;
-
-        case STKPXAnimationTimingFunctionLinear:
-            tf = [CAMediaTimingFunction functionWithName:kCAMediaTimingFunctionLinear];
-            break;
-
-        case STKPXAnimationTimingFunctionStepEnd:
-        case STKPXAnimationTimingFunctionStepStart:
-        case STKPXAnimationTimingFunctionUndefined:
-        default:
-            break;
-    }
-
-    [_timingFunctions addObject:tf];
+    [_timingFunctions addObject:[STKPXKeyframeAnimation caTimingFunctionForTimingFunction:timingFunction]];
 }
 
 - (CAKeyframeAnimation *)caKeyframeAnimation
@@ -0,0 +1,88 @@
+/****************************************************************************
+ *
+ * Copyright 2015-present StylingKit Development Team. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ****************************************************************************/
+
+//
+//  STKPXKeyframeTemplate.h
+//  StylingKit
+//
+
+#import <Foundation/Foundation.h>
+#import "STKPXKeyframe.h"
+
+/**
+ *  The key times and values a single key path moves through in a compiled @keyframes block
+ */
+@interface STKPXKeyframeTrack : NSObject
+
+@property (readonly, nonatomic, copy) NSString *keyPath;
+
+/**
+ *  Key times in ascending order, as NSNumbers between 0 and 1
+ */
+@property (readonly, nonatomic, copy) NSArray *keyTimes;
+
+/**
+ *  The value for each entry in keyTimes
+ */
+@property (readonly, nonatomic, copy) NSArray *values;
+
+- (instancetype)init NS_UNAVAILABLE;
+- (instancetype)initWithKeyPath:(NSString *)keyPath keyTimes:(NSArray *)keyTimes values:(NSArray *)values NS_DESIGNATED_INITIALIZER;
+
+@end
+
+/**
+ *  An immutable, compiled form of a @keyframes block. Blocks are sorted by offset and every declaration is resolved
+ *  to a value through its property handler once, so styling a view only has to pair the tracks with timing settings
+ */
+@interface STKPXKeyframeTemplate : NSObject
+
+@property (readonly, nonatomic, copy) NSString *name;
+
+/**
+ *  One track per animated key path, in order of first appearance
+ */
+@property (readonly, nonatomic, copy) NSArray *tracks;
+
+/**
+ *  Return the template for a keyframe, compiling it on first use. Templates are remembered per keyframe and property
+ *  handler dictionary, so a stylesheet's keyframes compile once for as long as the stylesheet is alive
+ *
+ *  @param keyframe The keyframe to compile
+ *  @param propertyHandlers A dictionary of STKPXAnimationPropertyHandlers keyed by property name
+ */
++ (instancetype)templateForKeyframe:(STKPXKeyframe *)keyframe propertyHandlers:(NSDictionary *)propertyHandlers;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ *  Compile a keyframe without consulting the cache
+ *
+ *  @param keyframe The keyframe to compile
+ *  @param propertyHandlers A dictionary of STKPXAnimationPropertyHandlers keyed by property name
+ */
+- (instancetype)initWithKeyframe:(STKPXKeyframe *)keyframe propertyHandlers:(NSDictionary *)propertyHandlers NS_DESIGNATED_INITIALIZER;
+
+/**
+ *  Return the track for the specified key path, or nil if it is not animated
+ *
+ *  @param keyPath The key path to look up
+ */
+- (STKPXKeyframeTrack *)trackForKeyPath:(NSString *)keyPath;
+
+@end
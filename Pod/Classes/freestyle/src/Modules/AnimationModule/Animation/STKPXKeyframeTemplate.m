@@ -0,0 +1,194 @@
+/****************************************************************************
+ *
+ * Copyright 2015-present StylingKit Development Team. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ****************************************************************************/
+
+//
+//  STKPXKeyframeTemplate.m
+//  StylingKit
+//
+
+#import "STKPXKeyframeTemplate.h"
+#import "STKPXAnimationPropertyHandler.h"
+#import <objc/runtime.h>
+
+static const char TEMPLATES_KEY;
+
+@implementation STKPXKeyframeTrack
+
+#pragma mark - Initializers
+
+- (instancetype)initWithKeyPath:(NSString *)keyPath keyTimes:(NSArray *)keyTimes values:(NSArray *)values
+{
+    if (self = [super init])
+    {
+        _keyPath = [keyPath copy];
+        _keyTimes = [keyTimes copy];
+        _values = [values copy];
+    }
+
+    return self;
+}
+
+#pragma mark - Overrides
+
+- (BOOL)isEqual:(id)object
+{
+    if (self == object)
+    {
+        return YES;
+    }
+
+    if (![object isKindOfClass:[STKPXKeyframeTrack class]])
+    {
+        return NO;
+    }
+
+    STKPXKeyframeTrack *other = object;
+
+    return [_keyPath isEqualToString:other->_keyPath]
+        && [_keyTimes isEqualToArray:other->_keyTimes]
+        && [_values isEqualToArray:other->_values];
+}
+
+- (NSUInteger)hash
+{
+    return _keyPath.hash ^ _keyTimes.count;
+}
+
+@end
+
+@implementation STKPXKeyframeTemplate
+{
+    NSDictionary *tracksByKeyPath_;
+}
+
+#pragma mark - Static Methods
+
++ (instancetype)templateForKeyframe:(STKPXKeyframe *)keyframe propertyHandlers:(NSDictionary *)propertyHandlers
+{
+    if (keyframe == nil)
+    {
+        return nil;
+    }
+
+    STKPXKeyframeTemplate *result;
+
+    @synchronized(keyframe)
+    {
+        // handler dictionaries are compared by identity; the styler passes the same shared dictionary for every view
+        // that doesn't bring its own handlers
+        NSMapTable *templates = objc_getAssociatedObject(keyframe, &TEMPLATES_KEY);
+
+        if (templates == nil)
+        {
+            templates = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality
+                                              valueOptions:NSPointerFunctionsStrongMemory];
+            objc_setAssociatedObject(keyframe, &TEMPLATES_KEY, templates, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+        }
+
+        result = [templates objectForKey:propertyHandlers];
+
+        if (result == nil)
+        {
+            result = [[STKPXKeyframeTemplate alloc] initWithKeyframe:keyframe propertyHandlers:propertyHandlers];
+
+            if (propertyHandlers)
+            {
+                [templates setObject:result forKey:propertyHandlers];
+            }
+        }
+    }
+
+    return result;
+}
+
+#pragma mark - Initializers
+
+- (instancetype)initWithKeyframe:(STKPXKeyframe *)keyframe propertyHandlers:(NSDictionary *)propertyHandlers
+{
+    if (self = [super init])
+    {
+        _name = [keyframe.name copy];
+
+        // a stable sort keeps blocks with equal offsets in source order
+        NSArray *blocks = [keyframe.blocks sortedArrayWithOptions:NSSortStable
+                                                  usingComparator:^NSComparisonResult(STKPXKeyframeBlock *a, STKPXKeyframeBlock *b) {
+                                                      if (a.offset < b.offset)
+                                                      {
+                                                          return NSOrderedAscending;
+                                                      }
+
+                                                      return (a.offset > b.offset) ? NSOrderedDescending : NSOrderedSame;
+                                                  }];
+
+        NSMutableArray *keyPaths = [[NSMutableArray alloc] init];
+        NSMutableDictionary *keyTimes = [[NSMutableDictionary alloc] init];
+        NSMutableDictionary *values = [[NSMutableDictionary alloc] init];
+
+        for (STKPXKeyframeBlock *block in blocks)
+        {
+            for (STKPXDeclaration *declaration in block.declarations)
+            {
+                STKPXAnimationPropertyHandler *propertyHandler = propertyHandlers[declaration.name];
+                NSString *keyPath = propertyHandler.keyPath;
+                id value = [propertyHandler getValueFromDeclaration:declaration];
+
+                if (keyPath.length == 0 || value == nil)
+                {
+                    continue;
+                }
+
+                if (keyTimes[keyPath] == nil)
+                {
+                    [keyPaths addObject:keyPath];
+                    keyTimes[keyPath] = [[NSMutableArray alloc] init];
+                    values[keyPath] = [[NSMutableArray alloc] init];
+                }
+
+                [keyTimes[keyPath] addObject:@(block.offset)];
+                [values[keyPath] addObject:value];
+            }
+        }
+
+        NSMutableArray *tracks = [[NSMutableArray alloc] initWithCapacity:keyPaths.count];
+        NSMutableDictionary *tracksByKeyPath = [[NSMutableDictionary alloc] initWithCapacity:keyPaths.count];
+
+        for (NSString *keyPath in keyPaths)
+        {
+            STKPXKeyframeTrack *track = [[STKPXKeyframeTrack alloc] initWithKeyPath:keyPath
+                                                                           keyTimes:keyTimes[keyPath]
+                                                                             values:values[keyPath]];
+
+            [tracks addObject:track];
+            tracksByKeyPath[keyPath] = track;
+        }
+
+        _tracks = [tracks copy];
+        tracksByKeyPath_ = [tracksByKeyPath copy];
+    }
+
+    return self;
+}
+
+#pragma mark - Methods
+
+- (STKPXKeyframeTrack *)trackForKeyPath:(NSString *)keyPath
+{
+    return (keyPath) ? tracksByKeyPath_[keyPath] : nil;
+}
+
+@end
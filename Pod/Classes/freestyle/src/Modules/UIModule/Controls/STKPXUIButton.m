@@ -276,7 +276,7 @@ static const char STYLE_CHILDREN;
         else
         {
             //[self px_setBackgroundColor:[UIColor clearColor]];
-            [self px_setBackgroundImage:context.backgroundImage
+            [self px_setBackgroundImage:context.resizableBackgroundImage
                                forState:[context stateFromStateNameMap:PSEUDOCLASS_MAP]];
 
         }
@@ -284,8 +284,12 @@ static const char STYLE_CHILDREN;
     else if (context.usesImage)
     {
         //[self px_setBackgroundColor:[UIColor clearColor]];
-        [self px_setBackgroundImage:context.backgroundImage
-                           forState:[context stateFromStateNameMap:PSEUDOCLASS_MAP]];
+        __weak STKPXUIButton *weakSelf = self;
+        UIControlState state = [context stateFromStateNameMap:PSEUDOCLASS_MAP];
+
+        [context requestBackgroundImage:^(UIImage *image) {
+            [weakSelf px_setBackgroundImage:image forState:state];
+        }];
     }
 }
 
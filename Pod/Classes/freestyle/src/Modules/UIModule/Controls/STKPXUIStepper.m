@@ -201,7 +201,7 @@ static char const STYLE_CHILDREN;
         if(context.usesColorOnly || context.usesImage)
         {
             [self px_setTintColor: nil];
-            [self px_setBackgroundImage:context.backgroundImage
+            [self px_setBackgroundImage:context.resizableBackgroundImage
                             forState:[context stateFromStateNameMap:PSEUDOCLASS_MAP]];
         }
     }
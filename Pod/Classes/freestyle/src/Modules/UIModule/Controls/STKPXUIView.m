@@ -74,7 +74,7 @@ static const char STYLE_CHILDREN;
             }
             else if (context.usesImage)
             {
-                weakSelf.px_layer.contents = (__bridge id)(context.backgroundImage.CGImage);
+                [context applyBackgroundImageToLayer:weakSelf.px_layer];
             }
         }];
 
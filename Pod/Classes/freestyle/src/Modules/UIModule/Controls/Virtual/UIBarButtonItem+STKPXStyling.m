@@ -245,7 +245,7 @@ void STKPXForceLoadUIBarButtonItemPXStyling() {}
     
     if(context.usesImage && context.backgroundImage)
     {
-        [target setBackgroundImage:context.backgroundImage
+        [target setBackgroundImage:context.resizableBackgroundImage
                         forState:[context stateFromStateNameMap:BUTTONS_PSEUDOCLASS_MAP]
                       barMetrics:UIBarMetricsDefault];
     }
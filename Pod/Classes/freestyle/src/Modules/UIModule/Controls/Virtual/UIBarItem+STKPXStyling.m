@@ -28,6 +28,7 @@
 #import "STKPXStylingMacros.h"
 #import "STKPXStyleUtils.h"
 #import "STKPXUtils.h"
+#import "STKPXRestyleScheduler.h"
 #import "STKPXVirtualStyleableControl.h"
 
 static const char STYLE_CLASS_KEY;
@@ -98,6 +99,8 @@ void STKPXForceLoadUIBarItemPXStyling() {}
 - (void)setStyleElementName:(NSString *)elementName
 {
     objc_setAssociatedObject(self, &STYLE_ELEMENT_NAME, elementName, OBJC_ASSOCIATION_COPY_NONATOMIC);
+
+    [STKPXStyleUtils invalidateStyleKeyForStyleable:self];
 }
 
 - (NSString *)styleElementName
@@ -112,7 +115,7 @@ void STKPXForceLoadUIBarItemPXStyling() {}
 
 - (NSString *)styleKey
 {
-    return [STKPXStyleUtils styleKeyFromStyleable:self];
+    return [STKPXStyleUtils cachedStyleKeyForStyleable:self];
 }
 
 - (CGRect)bounds
@@ -148,6 +151,7 @@ void STKPXForceLoadUIBarItemPXStyling() {}
     NSArray *classes = [aClass componentsSeparatedByCharactersInSet:[NSCharacterSet whitespaceCharacterSet]];
     objc_setAssociatedObject(self, &STYLE_CLASSES_KEY, classes, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
 
+    [STKPXStyleUtils invalidateStyleKeyForStyleable:self];
     [self updateStylesNonRecursively];
 }
 
@@ -161,6 +165,7 @@ void STKPXForceLoadUIBarItemPXStyling() {}
     
     objc_setAssociatedObject(self, &STYLE_ID_KEY, anId, OBJC_ASSOCIATION_COPY_NONATOMIC);
     
+    [STKPXStyleUtils invalidateStyleKeyForStyleable:self];
     [self updateStylesNonRecursively];
 }
 
@@ -218,16 +223,12 @@ void STKPXForceLoadUIBarItemPXStyling() {}
 
 - (void)updateStylesAsync
 {
-    dispatch_async(dispatch_get_main_queue(), ^{
-        [self updateStyles];
-    });
+    [[STKPXRestyleScheduler sharedScheduler] scheduleStyleable:self recursive:YES];
 }
 
 -(void)updateStylesNonRecursivelyAsync
 {
-    dispatch_async(dispatch_get_main_queue(), ^{
-        [self updateStylesNonRecursively];
-    });
+    [[STKPXRestyleScheduler sharedScheduler] scheduleStyleable:self recursive:NO];
 }
 
 - (NSDictionary *)viewStylersByProperty
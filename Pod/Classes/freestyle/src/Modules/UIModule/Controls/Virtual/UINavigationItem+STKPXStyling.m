@@ -28,6 +28,7 @@
 #import "STKPXStylingMacros.h"
 #import "STKPXStyleUtils.h"
 #import "STKPXUtils.h"
+#import "STKPXRestyleScheduler.h"
 #import "STKPXVirtualStyleableControl.h"
 #import "STKPXGenericStyler.h"
 #import "STKPXTextContentStyler.h"
@@ -101,6 +102,8 @@ void STKPXForceLoadUINavigationItemPXStyling() {}
 - (void)setStyleElementName:(NSString *)elementName
 {
     objc_setAssociatedObject(self, &STYLE_ELEMENT_NAME, elementName, OBJC_ASSOCIATION_COPY_NONATOMIC);
+
+    [STKPXStyleUtils invalidateStyleKeyForStyleable:self];
 }
 
 - (NSString *)styleElementName
@@ -115,7 +118,7 @@ void STKPXForceLoadUINavigationItemPXStyling() {}
 
 - (NSString *)styleKey
 {
-    return [STKPXStyleUtils styleKeyFromStyleable:self];
+    return [STKPXStyleUtils cachedStyleKeyForStyleable:self];
 }
 
 - (CGRect)bounds
@@ -151,6 +154,7 @@ void STKPXForceLoadUINavigationItemPXStyling() {}
     NSArray *classes = [aClass componentsSeparatedByCharactersInSet:[NSCharacterSet whitespaceCharacterSet]];
     objc_setAssociatedObject(self, &STYLE_CLASSES_KEY, classes, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
     
+    [STKPXStyleUtils invalidateStyleKeyForStyleable:self];
     [self updateStylesNonRecursively];
 }
 
@@ -164,6 +168,7 @@ void STKPXForceLoadUINavigationItemPXStyling() {}
     
     objc_setAssociatedObject(self, &STYLE_ID_KEY, anId, OBJC_ASSOCIATION_COPY_NONATOMIC);
     
+    [STKPXStyleUtils invalidateStyleKeyForStyleable:self];
     [self updateStylesNonRecursively];
 }
 
@@ -221,16 +226,12 @@ void STKPXForceLoadUINavigationItemPXStyling() {}
 
 - (void)updateStylesAsync
 {
-    dispatch_async(dispatch_get_main_queue(), ^{
-        [self updateStyles];
-    });
+    [[STKPXRestyleScheduler sharedScheduler] scheduleStyleable:self recursive:YES];
 }
 
 -(void)updateStylesNonRecursivelyAsync
 {
-    dispatch_async(dispatch_get_main_queue(), ^{
-        [self updateStylesNonRecursively];
-    });
+    [[STKPXRestyleScheduler sharedScheduler] scheduleStyleable:self recursive:NO];
 }
 
 - (NSDictionary *)viewStylersByProperty